@@ -327,28 +327,35 @@ namespace PluginHost {
                 Observables()
                     : Core::JSON::Container()
                     , ProxyStubPath()
-                    , PluginConfigPath() {
+                    , PluginConfigPath()
+                    , Debounce(100) {
                     Add(_T("proxystubpath"), &ProxyStubPath);
                     Add(_T("configpath"), &PluginConfigPath);
+                    Add(_T("debounce"), &Debounce);
                 }
                 Observables(const Observables& copy)
                     : Core::JSON::Container()
                     , ProxyStubPath(copy.ProxyStubPath)
-                    , PluginConfigPath(copy.PluginConfigPath) {
+                    , PluginConfigPath(copy.PluginConfigPath)
+                    , Debounce(copy.Debounce) {
                     Add(_T("proxystubpath"), &ProxyStubPath);
                     Add(_T("configpath"), &PluginConfigPath);
+                    Add(_T("debounce"), &Debounce);
                 }
                 Observables(Observables&& move) noexcept
                     : Core::JSON::Container()
                     , ProxyStubPath(std::move(move.ProxyStubPath))
-                    , PluginConfigPath(std::move(move.PluginConfigPath)) {
+                    , PluginConfigPath(std::move(move.PluginConfigPath))
+                    , Debounce(std::move(move.Debounce)) {
                     Add(_T("proxystubpath"), &ProxyStubPath);
                     Add(_T("configpath"), &PluginConfigPath);
+                    Add(_T("debounce"), &Debounce);
                 }
                 ~Observables() override = default;
 
                 Core::JSON::String ProxyStubPath;
                 Core::JSON::String PluginConfigPath;
+                Core::JSON::DecUInt16 Debounce; // In milliseconds, changes within this time are handled together.
             };
 
 #ifdef HIBERNATE_SUPPORT_ENABLED
@@ -439,9 +446,14 @@ namespace PluginHost {
                 , Latitude(51832547) // Divider 1.000.000
                 , Longitude(5674899) // Divider 1.000.000
                 , DelegatedReleases(true)
+                , SharedMemory(false)
                 , Throttle((Process.ThreadPoolCount.Value() > 1) ? (Process.ThreadPoolCount.Value() / 2) : 1)
                 , ChannelThrottle(((Process.ThreadPoolCount.Value() > 1) ? (Process.ThreadPoolCount.Value() / 2) : 1))
+                , ChannelQueue(0)
+                , ChannelShedding(false)
+                , ThrottleLatency(0)
                 , MetadataDiscovery(true)
+                , LibraryPrefetch(false)
 #ifdef PROCESSCONTAINERS_ENABLED
                 , ProcessContainers()
 #endif
@@ -493,9 +505,14 @@ namespace PluginHost {
                 Add(_T("latitude"), &Latitude);
                 Add(_T("longitude"), &Longitude);
                 Add(_T("ccdr"), &DelegatedReleases); /* COMRPC channel delegated releases */
+                Add(_T("ccshm"), &SharedMemory); /* COMRPC channels of out of process hosts over shared memory */
                 Add(_T("throttle"), &Throttle);
                 Add(_T("channel_throttle"), &ChannelThrottle);
+                Add(_T("channel_queue"), &ChannelQueue);
+                Add(_T("channel_shed"), &ChannelShedding);
+                Add(_T("throttle_latency"), &ThrottleLatency);
                 Add(_T("discovery"), &MetadataDiscovery);
+                Add(_T("prefetch"), &LibraryPrefetch);
 #ifdef PROCESSCONTAINERS_ENABLED
                 Add(_T("processcontainers"), &ProcessContainers);
 #endif
@@ -551,9 +568,14 @@ namespace PluginHost {
             Core::JSON::DecSInt32 Latitude;
             Core::JSON::DecSInt32 Longitude;
             Core::JSON::Boolean DelegatedReleases;
+            Core::JSON::Boolean SharedMemory;
             Core::JSON::DecUInt8 Throttle;
             Core::JSON::DecUInt8 ChannelThrottle;
+            Core::JSON::DecUInt16 ChannelQueue;
+            Core::JSON::Boolean ChannelShedding;
+            Core::JSON::DecUInt16 ThrottleLatency;
             Core::JSON::Boolean MetadataDiscovery;
+            Core::JSON::Boolean LibraryPrefetch;
 #ifdef PROCESSCONTAINERS_ENABLED
             Core::JSON::String ProcessContainers;
 #endif
@@ -710,6 +732,7 @@ namespace PluginHost {
             , _workerPoolSink(static_cast<PostMortemDataSink>(THUNDER_POSTMORTEM_WORKERPOOL_SINK_DEFAULT))
             , _callstackSink(static_cast<PostMortemDataSink>(THUNDER_POSTMORTEM_CALLSTACK_SINK_DEFAULT))
             , _pluginConfigPath()
+            , _observeDebounce(0)
             , _accessor()
             , _communicator()
             , _binder()
@@ -741,9 +764,14 @@ namespace PluginHost {
             , _substituter(*this)
             , _configLock()
             , _delegatedReleases(true)
+            , _sharedMemory(false)
             , _throttle((_threadPoolCount > 1) ? (_threadPoolCount / 2) : 1)
             , _channelThrottle((_threadPoolCount > 1) ? (_threadPoolCount / 2) : 1)
+            , _channelQueue(0)
+            , _channelShedding(false)
+            , _throttleLatency(0)
             , _metadataDiscovery(true)
+            , _libraryPrefetch(false)
 #ifdef PROCESSCONTAINERS_ENABLED
             , _processContainersConfig()
 #endif
@@ -820,6 +848,7 @@ namespace PluginHost {
                 if (config.Observe.IsSet() == true) {
                     _observableProxyStubPath = Core::Directory::Normalize(config.Observe.ProxyStubPath.Value());
                     _pluginConfigPath = Core::Directory::Normalize(config.Observe.PluginConfigPath.Value());
+                    _observeDebounce = config.Observe.Debounce.Value();
                 }
                 _postMortemPath = Core::Directory::Normalize(config.PostMortemPath.Value());
                 _workerPoolSink = config.PostMortemWorkerPoolSink.IsSet()
@@ -850,9 +879,14 @@ namespace PluginHost {
                 _processInfo.Set(config.Process);
                 _ethernetCard = config.EthernetCard.Value();
                 _delegatedReleases = config.DelegatedReleases.Value();
+                _sharedMemory = config.SharedMemory.Value();
                 _throttle = config.Throttle.Value();
                 _channelThrottle = config.ChannelThrottle.Value();
+                _channelQueue = config.ChannelQueue.Value();
+                _channelShedding = config.ChannelShedding.Value();
+                _throttleLatency = config.ThrottleLatency.Value();
                 _metadataDiscovery = config.MetadataDiscovery.Value();
+                _libraryPrefetch = config.LibraryPrefetch.Value();
                 if( config.Latitude.IsSet() || config.Longitude.IsSet() ) {
                     SYSLOG(Logging::Error, (_T("Support for Latitude and Longitude moved from Thunder configuration to plugin providing ILocation support")));
                 }
@@ -1055,6 +1089,10 @@ namespace PluginHost {
         {
             return (_observableProxyStubPath);
         }
+        inline uint16_t ObserveDebounce() const
+        {
+            return (_observeDebounce);
+        }
         inline const string& PostMortemPath() const
         {
             return (_postMortemPath);
@@ -1133,15 +1171,30 @@ namespace PluginHost {
         inline bool DelegatedReleases() const {
             return(_delegatedReleases);
         }
+        inline bool SharedMemory() const {
+            return(_sharedMemory);
+        }
         inline uint8_t Throttle() const {
             return(_throttle);
         }
         inline uint8_t ChannelThrottle() const {
             return(_channelThrottle);
         }
+        inline uint16_t ChannelQueue() const {
+            return(_channelQueue);
+        }
+        inline bool ChannelShedding() const {
+            return(_channelShedding);
+        }
+        inline uint16_t ThrottleLatency() const {
+            return(_throttleLatency);
+        }
         inline bool MetadataDiscovery() const {
             return (_metadataDiscovery);
         }
+        inline bool LibraryPrefetch() const {
+            return (_libraryPrefetch);
+        }
         inline const InputInfo& Input() const {
             return(_inputInfo);
         }
@@ -1365,6 +1418,7 @@ namespace PluginHost {
         PostMortemDataSink _workerPoolSink;
         PostMortemDataSink _callstackSink;
         string _pluginConfigPath;
+        uint16_t _observeDebounce;
         Core::NodeId _accessor;
         Core::NodeId _communicator;
         Core::NodeId _binder;
@@ -1396,9 +1450,14 @@ namespace PluginHost {
         Substituter _substituter;
         mutable Core::CriticalSection _configLock;
         bool _delegatedReleases;
+        bool _sharedMemory;
         uint8_t _throttle;
         uint8_t _channelThrottle;
+        uint16_t _channelQueue;
+        bool _channelShedding;
+        uint16_t _throttleLatency;
         bool _metadataDiscovery;
+        bool _libraryPrefetch;
 
 #ifdef PROCESSCONTAINERS_ENABLED
         string _processContainersConfig;
@@ -56,6 +56,27 @@ namespace Thunder {
                 return (LT::UNKNOWN);
             }
         }
+
+        // The waits are reported as a histogram, bucket N holds the requests that waited less than 16us * 4^N.
+        uint32_t WaitPercentile(const Core::JSON::ArrayType<Core::JSON::DecUInt32>& waits, const uint8_t percentage)
+        {
+            uint64_t total = 0;
+            uint64_t count = 0;
+            uint8_t index = 0;
+
+            auto it = waits.Elements();
+            while (it.Next() == true) {
+                total += it.Current().Value();
+            }
+
+            it.Reset();
+            while ((it.Next() == true) && ((count + it.Current().Value()) * 100 < (total * percentage))) {
+                count += it.Current().Value();
+                index++;
+            }
+
+            return (total == 0 ? 0 : (16 << (2 * std::min(index, static_cast<uint8_t>(waits.Length() - 1)))));
+        }
     }
 
 namespace Plugin {
@@ -1333,6 +1354,46 @@ namespace Plugin {
         return (Core::ERROR_NONE);
     }
 
+    Core::hresult Controller::Queues(IMetadata::Data::IQueuesIterator*& outQueues) const
+    {
+        Core::JSON::ArrayType<PluginHost::Metadata::Channel> meta;
+        std::vector<IMetadata::Data::Queue> queues;
+
+        ASSERT(_pluginServer != nullptr);
+
+        _pluginServer->Metadata(meta);
+
+        auto it = meta.Elements();
+
+        while (it.Next() == true) {
+            auto const& entry = it.Current();
+
+            if (entry.Queued.IsSet() == true) {
+                IMetadata::Data::Queue queue;
+                queue.Id = entry.ID;
+                queue.Queued = entry.Queued.Value();
+                queue.Shed = entry.Shed.Value();
+                queue.WaitMedian = WaitPercentile(entry.Waits, 50);
+                queue.WaitTail = WaitPercentile(entry.Waits, 99);
+
+                queues.push_back(std::move(queue));
+            }
+        }
+
+        if (queues.empty() == false) {
+            using Iterator = IMetadata::Data::IQueuesIterator;
+            using IteratorImpl = RPC::IteratorType<Iterator, decltype(queues)>;
+
+            outQueues = Core::ServiceType<IteratorImpl>::Create<Iterator>(std::move(queues));
+            ASSERT(outQueues != nullptr);
+        }
+        else {
+            outQueues = nullptr;
+        }
+
+        return (Core::ERROR_NONE);
+    }
+
     Core::hresult Controller::Proxies(const Core::OptionalType<string>& linkId, IMetadata::Data::IProxiesIterator*& outProxies) const
     {
         Core::hresult result = Core::ERROR_UNKNOWN_KEY;
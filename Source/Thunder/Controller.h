@@ -362,6 +362,7 @@ namespace Plugin {
         Core::hresult PendingRequests(IMetadata::Data::IPendingRequestsIterator*& requests) const override;
         Core::hresult Framework(IMetadata::Data::Version& version) const override;
         Core::hresult BuildInfo(IMetadata::Data::BuildInfo& buildInfo) const override;
+        Core::hresult Queues(IMetadata::Data::IQueuesIterator*& queues) const override;
 
         // IShells overrides
         Core::hresult Register(Exchange::Controller::IShells::INotification* sink) override;
@@ -35,7 +35,9 @@ set(MESSAGECONTROL_PATH "MessageDispatcher" CACHE STRING "MessageControl base pa
 set(MESSAGING_PORT 0 CACHE STRING "The port for the messaging")
 set(MESSAGING_STDOUT false CACHE STRING "Enable message rederict from stdout")
 set(MESSAGING_STDERR false CACHE STRING "Enable message rederict from stderr")
-set(MESSAGING_DATASIZE 20480 CACHE STRING "Size of the data buffer in bytes [max 63KB]")
+set(MESSAGING_DATASIZE 20480 CACHE STRING "Size of the data buffer in bytes [max 16MB]")
+set(MESSAGING_DATARINGS 1 CACHE STRING "Number of rings the data buffer is split in, modules are spread over them [max 16]")
+set(MESSAGING_HUGEPAGES false CACHE STRING "Size the data buffer rings to whole huge pages and advise huge page backing")
 set(CONFIG_INSTALL_PATH "${CMAKE_INSTALL_FULL_SYSCONFDIR}/${NAMESPACE}" CACHE PATH "Install location of the configuration")
 set(IPV6_SUPPORT false CACHE STRING "Controls if should application supports ipv6")
 set(LEGACY_INITIALZE false CACHE STRING "Enables legacy Plugin Initialize behaviour (Deinit not called on failed Init)")
@@ -229,6 +231,8 @@ map()
     kv(stout ${MESSAGING_STDOUT})
     kv(stderr ${MESSAGING_STDERR})
     kv(datasize ${MESSAGING_DATASIZE})
+    kv(datarings ${MESSAGING_DATARINGS})
+    kv(hugepages ${MESSAGING_HUGEPAGES})
     key(logging)
     key(tracing)
     key(reporting)
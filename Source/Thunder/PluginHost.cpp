@@ -808,6 +808,9 @@ int main(int argc, char** argv)
         {
             char keyPress;
 
+            // Only created on the first request for the resource usage, it keeps /proc files open.
+            std::unique_ptr<Core::ProcessSampler> usage;
+
             do {
                 keyPress = toupper(getchar());
 
@@ -1064,6 +1067,43 @@ int main(int argc, char** argv)
                     }
                     break;
                 }
+                case 'U': {
+                    if (usage == nullptr) {
+                        usage.reset(new Core::ProcessSampler());
+                    }
+
+                    const pid_t self = Core::ProcessInfo().Id();
+                    Core::ProcessInfo::Iterator children(self);
+
+                    usage->Add(self);
+                    usage->Add(children);
+                    usage->Sample();
+
+                    Core::ProcessSampler::System system;
+                    usage->Get(system);
+
+                    printf("\nResource usage:\n");
+                    printf("============================================================\n");
+                    printf("Memory:      %" PRIu64 " kB total, %" PRIu64 " kB available, %" PRIu64 " kB free\n", system.Total / 1024, system.Available / 1024, system.Free / 1024);
+                    printf("Swap:        %" PRIu64 " kB total, %" PRIu64 " kB free\n", system.SwapTotal / 1024, system.SwapFree / 1024);
+                    printf("CPU load:    %d%%\n", system.CpuLoad);
+                    printf("------------------------------------------------------------\n");
+                    printf("%8s %8s %12s %12s %12s %12s\n", "PID", "Threads", "User [ms]", "System [ms]", "Resident", "Allocated");
+
+                    Core::ProcessSampler::Process process;
+
+                    if (usage->Get(self, process) == true) {
+                        printf("%8d %8u %12" PRIu64 " %12" PRIu64 " %9" PRIu64 " kB %9" PRIu64 " kB\n", process.Id, process.Threads, process.UserTime / 1000, process.SystemTime / 1000, process.Resident / 1024, process.Allocated / 1024);
+                    }
+
+                    children.Reset();
+                    while (children.Next() == true) {
+                        if (usage->Get(children.Current().Id(), process) == true) {
+                            printf("%8d %8u %12" PRIu64 " %12" PRIu64 " %9" PRIu64 " kB %9" PRIu64 " kB\n", process.Id, process.Threads, process.UserTime / 1000, process.SystemTime / 1000, process.Resident / 1024, process.Allocated / 1024);
+                        }
+                    }
+                    break;
+                }
                 case 'Q':
                     break;
                 case 'R': {
@@ -1127,6 +1167,7 @@ int main(int argc, char** argv)
                     printf("  [T]rigger resource monitor\n");
                     printf("  [M]etadata resource monitor\n");
                     printf("  [R]esource monitor stack\n");
+                    printf("  [U]sage of memory and CPU\n");
                     printf("  [0..%d] Threadpool stacks\n", _config->ThreadPoolCount() + 1);
                     printf("  [Q]uit\n\n");
                     break;
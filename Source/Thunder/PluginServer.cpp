@@ -21,6 +21,7 @@
 #include "Controller.h"
 
 #ifndef __WINDOWS__
+#include <fcntl.h>
 #include <syslog.h>
 #endif
 
@@ -74,6 +75,8 @@ namespace PluginHost {
 
     /* static */ Core::ProxyPoolType<Server::Channel::WebRequestJob> Server::Channel::_webJobs(2);
     /* static */ Core::ProxyPoolType<Server::Channel::JSONElementJob> Server::Channel::_jsonJobs(2);
+    /* static */ Core::ProxyPoolType<Core::JSONRPC::Batch> Server::Channel::_batches(1);
+    /* static */ Core::ProxyPoolType<Server::Channel::BatchResponse> Server::Channel::_responses(1);
     /* static */ Core::ProxyPoolType<Server::Channel::TextJob> Server::Channel::_textJobs(2);
 
 #ifdef __WINDOWS__
@@ -83,6 +86,7 @@ namespace PluginHost {
 #endif
     /* static */ const TCHAR* Server::ExtensionsConfigDirectory = _T("extensions/");
     /* static */ const TCHAR* Server::PluginConfigDirectory = _T("plugins/");
+    /* static */ const TCHAR* Server::LibraryIndex = _T(EXPAND_AND_QUOTE(NAMESPACE) "/libraries.json");
     /* static */ const TCHAR* Server::PluginOverrideDirectory = _T(EXPAND_AND_QUOTE(NAMESPACE) "/services/");
     /* static */ const TCHAR* Server::CommunicatorConnector = _T("COMMUNICATOR_CONNECTOR");
 
@@ -231,6 +235,18 @@ namespace PluginHost {
                 newInfo.Name = name;
             }
 
+            Channel::Jobs::Statistics statistics;
+            client->Statistics(statistics);
+
+            // Only channels that have requests waiting or executing, or had requests shed, report their queue.
+            if ((statistics.Queued > 0) || (statistics.Used > 0) || (statistics.Shed > 0)) {
+                newInfo.Queued = statistics.Queued;
+                newInfo.Shed = statistics.Shed;
+                for (uint8_t bucket = 0; bucket < Channel::Jobs::Buckets; bucket++) {
+                    newInfo.Waits.Add() = statistics.Waits[bucket];
+                }
+            }
+
             metaData.Add(newInfo);
         }
     }
@@ -264,6 +280,7 @@ namespace PluginHost {
             }
 
             _services.erase(index);
+            Reindex();
         }
 
         _adminLock.Unlock();
@@ -680,6 +697,11 @@ namespace PluginHost {
 
             // We have no need for his module anymore..
             ReleaseInterfaces();
+
+#ifdef HIBERNATE_SUPPORT_ENABLED
+            // The processes are gone, so is anything kept to wake them up.
+            ReleaseStorage(&_hibernateStorage);
+#endif
             Unlock();
 
             if ((currentState == IShell::ACTIVATION) || (currentState == IShell::ACTIVATED)) {
@@ -801,7 +823,7 @@ namespace PluginHost {
                     Unlock();
 
                     TRACE(Activity, (_T("Hibernation of plugin [%s] process [%u]"), Callsign().c_str(), parentPID));
-                    result = HibernateProcess(timeout, parentPID, _administrator.Configuration().HibernateLocator().c_str(), _T(""), &_hibernateStorage);
+                    result = HibernateProcess(timeout, parentPID, _administrator.Configuration().HibernateLocator().c_str(), VolatilePath().c_str(), &_hibernateStorage);
                     Lock();
                     if (State() != IShell::HIBERNATED) {
                         SYSLOG(Logging::Startup, (_T("Hibernation aborted of plugin [%s] process [%u]"), Callsign().c_str(), parentPID));
@@ -816,7 +838,7 @@ namespace PluginHost {
                     if (result != Core::ERROR_NONE && result != Core::ERROR_ABORTED) {
                         // try to wakeup Parent process to revert Hibernation and recover
                         TRACE(Activity, (_T("Wakeup plugin [%s] process [%u] on Hibernate error [%d]"), Callsign().c_str(), parentPID, result));
-                        WakeupProcess(timeout, parentPID, _administrator.Configuration().HibernateLocator().c_str(), _T(""), &_hibernateStorage);
+                        WakeupProcess(timeout, parentPID, _administrator.Configuration().HibernateLocator().c_str(), VolatilePath().c_str(), &_hibernateStorage);
                     }
 
                     Lock();
@@ -877,7 +899,7 @@ namespace PluginHost {
                 WakeupChildren(parentPID, timeout);
 
                 TRACE(Activity, (_T("Wakeup of plugin [%s] process [%u]"), Callsign().c_str(), parentPID));
-                result = WakeupProcess(timeout, parentPID, _administrator.Configuration().HibernateLocator().c_str(), _T(""), &_hibernateStorage);
+                result = WakeupProcess(timeout, parentPID, _administrator.Configuration().HibernateLocator().c_str(), VolatilePath().c_str(), &_hibernateStorage);
 #else
                 result = Core::ERROR_NONE;
 #endif
@@ -915,7 +937,7 @@ namespace PluginHost {
                     break;
                 }
                 Unlock();
-                result = HibernateProcess(timeout, *iter, _administrator.Configuration().HibernateLocator().c_str(), _T(""), &_hibernateStorage);
+                result = HibernateProcess(timeout, *iter, _administrator.Configuration().HibernateLocator().c_str(), VolatilePath().c_str(), &_hibernateStorage);
                 if (result == HIBERNATE_ERROR_NONE) {
                     // Hibernate Children of this process
                     result = HibernateChildren(*iter, timeout);
@@ -927,13 +949,13 @@ namespace PluginHost {
                 if (result != HIBERNATE_ERROR_NONE) {
                     // try to recover by reverting current Hibernations
                     TRACE(Activity, (_T("Wakeup plugin [%s] process [%u] on Hibernate error [%d]"), Callsign().c_str(), *iter, result));
-                    WakeupProcess(timeout, *iter, _administrator.Configuration().HibernateLocator().c_str(), _T(""), &_hibernateStorage);
+                    WakeupProcess(timeout, *iter, _administrator.Configuration().HibernateLocator().c_str(), VolatilePath().c_str(), &_hibernateStorage);
                     // revert previous Hibernations and break
                     while (iter != childrenPIDs.begin()) {
                         --iter;
                         WakeupChildren(*iter, timeout);
                         TRACE(Activity, (_T("Wakeup plugin [%s] process [%u] on Hibernate error [%d]"), Callsign().c_str(), *iter, result));
-                        WakeupProcess(timeout, *iter, _administrator.Configuration().HibernateLocator().c_str(), _T(""), &_hibernateStorage);
+                        WakeupProcess(timeout, *iter, _administrator.Configuration().HibernateLocator().c_str(), VolatilePath().c_str(), &_hibernateStorage);
                     }
                     break;
                 }
@@ -957,7 +979,7 @@ namespace PluginHost {
                 // There is no recovery path while doing Wakeup, don't care about errors
                 WakeupChildren(children.Current().Id(), timeout);
                 TRACE(Activity, (_T("Wakeup of plugin [%s] child process [%u]"), Callsign().c_str(), children.Current().Id()));
-                result = WakeupProcess(timeout, children.Current().Id(), _administrator.Configuration().HibernateLocator().c_str(), _T(""), &_hibernateStorage);
+                result = WakeupProcess(timeout, children.Current().Id(), _administrator.Configuration().HibernateLocator().c_str(), VolatilePath().c_str(), &_hibernateStorage);
             }
         }
 
@@ -991,6 +1013,10 @@ namespace PluginHost {
     // -----------------------------------------------------------------------------------------------------------------------------------
     void Server::ServiceMap::Open(std::vector<PluginHost::ISubSystem::subsystem>& externallyControlled) {
         _processAdministrator.Open();
+
+        // Before anything gets loaded, the metadata discovery included.
+        _prefetch.Start();
+
         // Load the metadata for the subsystem information..
         if (Configuration().MetadataDiscovery() == false) {
             SYSLOG(Logging::Startup, (_T("Automatic metadata discovery and plugin versioning is DISABLED!!!")));
@@ -1043,6 +1069,7 @@ namespace PluginHost {
                 _adminLock.Lock();
 
                 index = _services.erase(index);
+                Reindex();
             } else {
                 ++index;
             }
@@ -1066,6 +1093,7 @@ namespace PluginHost {
                 _adminLock.Lock();
 
                 index = _services.erase(index);
+                Reindex();
             } else {
                 ++index;
             }
@@ -1080,12 +1108,14 @@ namespace PluginHost {
                 index->second->Deactivate(PluginHost::IShell::SHUTDOWN);
                 _adminLock.Lock();
                 _services.erase(index);
+                Reindex();
             } 
         }
 
         // and now only the controller is left...
         ASSERT((_services.size() == 1) && (_services.begin()->first == controller->Callsign()));
         _services.clear();
+        _index.Clear();
 
         _adminLock.Unlock();
 
@@ -1121,18 +1151,10 @@ namespace PluginHost {
                 service = _server.Controller();
                 result = Core::ERROR_NONE;
             } else {
-                Core::ProxyType<IShell> actualService;
-                size_t length;
-                uint32_t offset = static_cast<uint32_t>(serviceHeader.length()) + 1; /* skip the slash after */
-
-                const string callSign(identifier.substr(offset, ((length = identifier.find_first_of('/', offset)) == string::npos ? string::npos : length - offset)));
+                const size_t offset = serviceHeader.length() + 1; /* skip the slash after */
+                const size_t end = identifier.find_first_of('/', offset);
 
-                if ( (result = FromIdentifier(callSign, actualService)) == Core::ERROR_NONE) {
-                    service = Core::ProxyType<Service>(actualService);
-                    if (service.IsValid() == false) {
-                        result = Core::ERROR_BAD_REQUEST;
-                    }
-                }
+                result = FromIdentifier(&(identifier[offset]), static_cast<uint32_t>((end == string::npos ? identifier.length() : end) - offset), service);
             }
         } else if (identifier.compare(0, JSONRPCHeader.length(), JSONRPCHeader.c_str()) == 0) {
 
@@ -1142,18 +1164,10 @@ namespace PluginHost {
                 service = _server.Controller();
                 result = Core::ERROR_NONE;
             } else {
-                Core::ProxyType<IShell> actualService;
-                size_t length;
-                uint32_t offset = static_cast<uint32_t>(JSONRPCHeader.length()) + 1; /* skip the slash after */
+                const size_t offset = JSONRPCHeader.length() + 1; /* skip the slash after */
+                const size_t end = identifier.find_first_of('/', offset);
 
-                const string callSign(identifier.substr(offset, ((length = identifier.find_first_of('/', offset)) == string::npos ? string::npos : length - offset)));
-
-                if ((result = FromIdentifier(callSign, actualService)) == Core::ERROR_NONE) {
-                    service = Core::ProxyType<Service>(actualService);
-                    if (service.IsValid() == false) {
-                        result = Core::ERROR_BAD_REQUEST;
-                    }
-                }
+                result = FromIdentifier(&(identifier[offset]), static_cast<uint32_t>((end == string::npos ? identifier.length() : end) - offset), service);
             }
         }
         else {
@@ -1186,12 +1200,25 @@ namespace PluginHost {
 
     void Server::ServiceMap::Startup() {
 
+        // The libraries resolved by the activations below, in that order, prefetched on the next startup.
+        LibraryPrefetch::Libraries libraries;
+        auto activate = [this, &libraries](Core::ProxyType<Service>& service) {
+            ActivateService(service);
+
+            if (service->StartMode() == PluginHost::IShell::startmode::ACTIVATED) {
+                const string library(service->LibraryLocation());
+                if ((library.empty() == false) && (std::find(libraries.begin(), libraries.end(), library) == libraries.end())) {
+                    libraries.push_back(library);
+                }
+            }
+        };
+
         //first we start the priority start plugins in the requested order (if any)
         for (const string& prioservice : _prioritystartorder) {
             if (prioservice != PluginHost::Config::AllExtensionsAuthorized()) {
                 Plugins::iterator index = _services.find(prioservice);
                 if ((index != _services.end()) && (AutoActivateAllowed(index->second) == true)) {
-                    ActivateService(index->second);
+                    activate(index->second);
                 } 
             }
         }
@@ -1204,7 +1231,7 @@ namespace PluginHost {
         for (auto& service : _services) {  
             if (service.second->PriorityStart() == true) {
                 if ((AutoActivateAllowed(service.second) == true) && (std::find(_prioritystartorder.begin(), _prioritystartorder.end(), service.second->Callsign()) == _prioritystartorder.end())) {
-                    ActivateService(service.second);
+                    activate(service.second);
                 }
             } else if (AutoActivateAllowed(service.second) == true) {
                 configured_services.emplace_back(service.second);
@@ -1222,8 +1249,25 @@ namespace PluginHost {
         }
 
         for (auto& service : configured_services) {
-            ActivateService(service);
+            activate(service);
         }
+
+        _prefetch.Record(libraries);
+    }
+
+    /* static */ void Server::ServiceMap::LibraryPrefetch::Prefetch(const string& library VARIABLE_IS_NOT_USED)
+    {
+#ifndef __WINDOWS__
+        // Only pull the file into the page cache, a dlopen from here could run static initializers of the
+        // library outside of the ServiceAdministrator lock that the activation takes for them.
+        int fd = ::open(library.c_str(), O_RDONLY | O_CLOEXEC);
+
+        if (fd != -1) {
+            TRACE_L1("prefetching library %s", library.c_str());
+            ::posix_fadvise(fd, 0, 0, POSIX_FADV_WILLNEED);
+            ::close(fd);
+        }
+#endif
     }
 
     //
@@ -1236,11 +1280,18 @@ namespace PluginHost {
         , _service()
         , _requestClose(false)
         , _jobs()
+        , _shedding(_parent.Configuration().ChannelShedding())
         , _serviceCleanedUp(false)
+        , _deferredLock()
+        , _deferred()
     {
         TRACE(Activity, (_T("Construct a link with ID: [%d] to [%s]"), Id(), remoteId.QualifiedName().c_str()));
 
         _jobs.Slots(static_cast<ChannelMap&>(*parent).MaxRequests());
+        _jobs.Limit(_parent.Configuration().ChannelQueue());
+
+        // Requests of one connection can run concurrently, keep the HTTP answers in request order.
+        Pipelined(true);
     }
 
     /* virtual */ Server::Channel::~Channel()
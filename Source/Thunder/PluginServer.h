@@ -36,10 +36,40 @@
 namespace Thunder {
 
 namespace Core {
+    // Limits the number of jobs that are in flight (slots) and queues the rest. Queued jobs are kept
+    // per source (e.g. the channel they came in on) and released round robin over those sources, so
+    // one busy source can not starve the others. The queue can be bounded, and the number of slots
+    // can follow the measured execution time of the jobs (adaptive), never exceeding the configured
+    // number of slots.
     template<typename CONTENT, typename FORWARDER> 
     class ThrottleQueueType {
+    public:
+        // Wait time histogram, bucket N counts the jobs that waited less than 16us * 4^N.
+        static constexpr uint8_t Buckets = 10;
+
+        struct Statistics {
+            uint32_t Slots;
+            uint32_t Used;
+            uint32_t Queued;
+            uint32_t Shed;
+            uint32_t Waits[Buckets];
+        };
+
     private:
-        using Queue = std::queue<CONTENT>;
+        struct Entry {
+            Entry(CONTENT&& content)
+                : Content(std::move(content))
+                , Queued(Core::MonotonicTime::Now())
+            {
+            }
+
+            CONTENT Content;
+            uint64_t Queued;
+        };
+
+        using Queue = std::deque<Entry>;
+        using Sources = std::unordered_map<uint32_t, Queue>;
+        using Ring = std::deque<uint32_t>;
 
     public:
         ThrottleQueueType(ThrottleQueueType<CONTENT, FORWARDER>&&) = delete;
@@ -52,8 +82,17 @@ namespace Core {
             : _adminLock()
             , _forwarder(std::forward<Args>(args)...)
             , _slots(1)
+            , _ceiling(1)
             , _used(0)
-            , _queue()
+            , _queued(0)
+            , _limit(0)
+            , _sources()
+            , _ring()
+            , _target(0)
+            , _latency(0)
+            , _completed(0)
+            , _shed(0)
+            , _waits()
 #ifdef __CORE_WARNING_REPORTING__
             , _lastPop(0)
 #endif
@@ -63,7 +102,10 @@ namespace Core {
 
     public:
         inline void Slots(const uint32_t slots) {
+            _adminLock.Lock();
             _slots = slots;
+            _ceiling = slots;
+            _adminLock.Unlock();
         }
         inline uint32_t Slots() const {
             return (_slots);
@@ -71,46 +113,200 @@ namespace Core {
         inline uint32_t Used() const {
             return (_used);
         }
-        inline void Push(CONTENT&& object) {
+        inline uint32_t Queued() const {
+            return (_queued);
+        }
+        // Maximum number of jobs waiting for a slot, 0 is unbounded.
+        inline void Limit(const uint32_t limit) {
+            _limit = limit;
+        }
+        // Execution time (in microseconds) above which the number of slots is reduced, 0 keeps it fixed.
+        inline void Adaptive(const uint32_t target) {
+            _adminLock.Lock();
+            _target = target;
+            _latency = 0;
+            _completed = 0;
+            _slots = _ceiling;
+            _adminLock.Unlock();
+        }
+        // Returns false if the queue is full, the object is than untouched and still owned by the caller,
+        // who can drop it, or Shed() an older one to make room. Either way one job is lost, so it is
+        // counted as shed here.
+        inline bool Push(CONTENT&& object, const uint32_t source = 0) {
+            bool result = true;
+
             _adminLock.Lock();
             if ((_used < _slots) || (_slots == 0)) {
                 _used++;
-                _forwarder.Submit(std::move(object));
+                Account(0);
+                Forward(std::move(object));
+            }
+            else if ((_limit != 0) && (_queued >= _limit)) {
+                _shed++;
+                result = false;
             }
             else {
-                _queue.emplace(object);
+                Queue& queue(_sources[source]);
+
+                if (queue.empty() == true) {
+                    _ring.push_back(source);
+                }
+
+                queue.emplace_back(std::move(object));
+                _queued++;
+
+                REPORT_OUTOFBOUNDS_WARNING(WarningReporting::FlowControlQueueSize, _queued);
+            }
+            _adminLock.Unlock();
 
-                REPORT_OUTOFBOUNDS_WARNING(WarningReporting::FlowControlQueueSize, _queue.size());
+            return (result);
+        }
+        // Takes the oldest job of the source with the most jobs waiting out of the queue.
+        inline bool Shed(CONTENT& object) {
+            bool result = false;
+
+            _adminLock.Lock();
+            typename Sources::iterator longest(_sources.end());
+
+            for (typename Sources::iterator index(_sources.begin()); index != _sources.end(); index++) {
+                if ((longest == _sources.end()) || (index->second.size() > longest->second.size())) {
+                    longest = index;
+                }
+            }
+
+            if (longest != _sources.end()) {
+                object = std::move(longest->second.front().Content);
+                Remove(longest);
+                result = true;
             }
             _adminLock.Unlock();
+
+            return (result);
         }
-        inline void Pop() {
+        // A job released its slot, executed holds the time (in microseconds) it took to execute.
+        inline void Pop(const uint64_t executed = 0) {
             _adminLock.Lock();
             ASSERT(_used > 0);
-            if (_queue.empty() == false) {
-                _forwarder.Submit(std::forward<CONTENT>(_queue.front()));
-                _queue.pop();
 
-                REPORT_OUTOFBOUNDS_WARNING(WarningReporting::FlowControlJobTime, ((_lastPop != 0) ? ((Core::Time::Now().Ticks() - _lastPop) / 1000) : 0 ));
+            if ((_target != 0) && (_ceiling != 0)) {
+                Adapt(executed);
+            }
+
+            if ((_queued > 0) && ((_used <= _slots) || (_slots == 0))) {
+                Next();
+
+                REPORT_OUTOFBOUNDS_WARNING(WarningReporting::FlowControlJobTime, ((_lastPop != 0) ? ((Core::MonotonicTime::Now() - _lastPop) / 1000) : 0 ));
 
 #ifdef __CORE_WARNING_REPORTING__
-                _lastPop = Core::Time::Now().Ticks();
+                _lastPop = Core::MonotonicTime::Now();
 #endif
             }
             else {
                 _used--;
             }
+
+            // The slots might have grown, fill them up..
+            while ((_queued > 0) && (_used < _slots)) {
+                _used++;
+                Next();
+            }
+            _adminLock.Unlock();
+        }
+        void Snapshot(Statistics& info) const {
+            _adminLock.Lock();
+            info.Slots = _slots;
+            info.Used = _used;
+            info.Queued = _queued;
+            info.Shed = _shed;
+            for (uint8_t index = 0; index < Buckets; index++) {
+                info.Waits[index] = _waits[index];
+            }
             _adminLock.Unlock();
         }
 
     private:
-        Core::CriticalSection _adminLock;
+        void Forward(CONTENT&& object) {
+            _forwarder.Submit(std::move(object));
+        }
+        void Next() {
+            ASSERT(_ring.empty() == false);
+
+            typename Sources::iterator index(_sources.find(_ring.front()));
+            ASSERT(index != _sources.end());
+
+            _ring.pop_front();
+
+            Entry& entry(index->second.front());
+            CONTENT object(std::move(entry.Content));
+
+            Account(Core::MonotonicTime::Now() - entry.Queued);
+
+            index->second.pop_front();
+            _queued--;
+
+            if (index->second.empty() == true) {
+                _sources.erase(index);
+            }
+            else {
+                _ring.push_back(index->first);
+            }
+
+            Forward(std::move(object));
+        }
+        void Remove(typename Sources::iterator& index) {
+            index->second.pop_front();
+            _queued--;
+
+            if (index->second.empty() == true) {
+                _ring.erase(std::find(_ring.begin(), _ring.end(), index->first));
+                _sources.erase(index);
+            }
+        }
+        void Account(const uint64_t waited) {
+            uint8_t bucket = 0;
+            uint64_t bound = 16;
+
+            while ((bucket < (Buckets - 1)) && (waited >= bound)) {
+                bound <<= 2;
+                bucket++;
+            }
+
+            _waits[bucket]++;
+        }
+        // Additive increase as long as the jobs execute within the target time and there is work waiting,
+        // multiplicative decrease as soon as they do not.
+        void Adapt(const uint64_t executed) {
+            _latency = (_latency == 0 ? executed : ((_latency * 7) + executed) / 8);
+
+            if (++_completed >= _slots) {
+                _completed = 0;
+
+                if (_latency > _target) {
+                    _slots = std::max(static_cast<uint32_t>(1), (_slots * 3) / 4);
+                }
+                else if ((_queued > 0) && (_slots < _ceiling)) {
+                    _slots++;
+                }
+            }
+        }
+
+    private:
+        mutable Core::CriticalSection _adminLock;
         FORWARDER _forwarder;
         uint32_t _slots;
+        uint32_t _ceiling;
         uint32_t _used;
-        Queue _queue;
+        uint32_t _queued;
+        uint32_t _limit;
+        Sources _sources;
+        Ring _ring;
+        uint32_t _target;
+        uint64_t _latency;
+        uint32_t _completed;
+        uint32_t _shed;
+        uint32_t _waits[Buckets];
 #ifdef __CORE_WARNING_REPORTING__
-        Core::Time::microsecondsfromepoch _lastPop;
+        uint64_t _lastPop;
 #endif
     };
 }
@@ -127,6 +323,7 @@ namespace PluginHost {
         static const TCHAR* PluginOverrideDirectory;
         static const TCHAR* ExtensionsConfigDirectory;
         static const TCHAR* PluginConfigDirectory;
+        static const TCHAR* LibraryIndex;
         static const TCHAR* CommunicatorConnector;
 
         using Shells = std::unordered_map<string, PluginHost::IShell*>;
@@ -795,6 +992,61 @@ namespace PluginHost {
                 std::vector<PluginHost::ISubSystem::subsystem> _control;
                 string _versionHash;
             };
+            // Where the library of this service was found the last time, identified by its size and
+            // modification time. As long as the file is unchanged, loading it again skips the probing
+            // of all the search paths.
+            class ResolvedLibrary {
+            public:
+                ResolvedLibrary(ResolvedLibrary&&) = delete;
+                ResolvedLibrary(const ResolvedLibrary&) = delete;
+                ResolvedLibrary& operator=(ResolvedLibrary&&) = delete;
+                ResolvedLibrary& operator=(const ResolvedLibrary&) = delete;
+
+                ResolvedLibrary()
+                    : _locator()
+                    , _path()
+                    , _modified(0)
+                    , _size(0) {
+                }
+                ~ResolvedLibrary() = default;
+
+            public:
+                const string& Path() const {
+                    return (_path);
+                }
+                bool Lookup(const string& locator, string& path) const {
+                    bool result = false;
+
+                    if ((_path.empty() == false) && (_locator == locator)) {
+                        Core::File file(_path);
+
+                        if ((file.Exists() == true) && (file.ModificationTime().Ticks() == _modified) && (file.Size() == _size)) {
+                            path = _path;
+                            result = true;
+                        }
+                    }
+
+                    return (result);
+                }
+                void Set(const string& locator, const Core::File& file) {
+                    _locator = locator;
+                    _path = file.Name();
+                    _modified = file.ModificationTime().Ticks();
+                    _size = file.Size();
+                }
+                void Clear() {
+                    _locator.clear();
+                    _path.clear();
+                    _modified = 0;
+                    _size = 0;
+                }
+
+            private:
+                string _locator;
+                string _path;
+                Core::Time::microsecondsfromepoch _modified;
+                uint64_t _size;
+            };
 
             static Core::NodeId PluginNodeId(const PluginHost::Config& config, const Plugin::Config& plugin) {
                 Core::NodeId result;
@@ -856,6 +1108,10 @@ namespace PluginHost {
                 , _lastId(0)
                 , _metadata(plugin.Throttle.IsSet() ? plugin.Throttle.Value() : server.Throttle())
                 , _library()
+                , _resolved()
+#ifdef HIBERNATE_SUPPORT_ENABLED
+                , _hibernateStorage(nullptr)
+#endif
                 , _external(PluginNodeId(server, plugin), server.ProxyStubPath(), handler, '/' + Callsign())
                 , _administrator(administrator)
                 , _composit(*this)
@@ -863,6 +1119,7 @@ namespace PluginHost {
                 , _type(type)
             {
                 _jobs.Slots(_metadata.MaxRequests());
+                _jobs.Adaptive(server.ThrottleLatency() * 1000);
             }
             ~Service() override
             {
@@ -898,8 +1155,10 @@ namespace PluginHost {
             inline const RPC::Communicator& COMServer() const {
                 return (_external);
             }
-            inline void Submit(Core::ProxyType<Core::IDispatch>&& job) {
-                _jobs.Push(std::move(job));
+            // Jobs are queued per channel they came in on, so the channels take turns on the slots of this service.
+            inline void Submit(Core::ProxyType<Core::IDispatch>&& job, const uint32_t channelId = 0) {
+                VARIABLE_IS_NOT_USED bool queued = _jobs.Push(std::move(job), channelId);
+                ASSERT(queued == true);
             }
             inline const std::vector<PluginHost::ISubSystem::subsystem>& SubSystemControl() const {
                 return (_metadata.Control());
@@ -1264,8 +1523,8 @@ namespace PluginHost {
             inline bool PostMortemAllowed(PluginHost::IShell::reason why) const {
                 return (_administrator.Configuration().PostMortemAllowed(why));
             }
-            inline void Pop(){
-                _jobs.Pop();
+            inline void Pop(const uint64_t executed) {
+                _jobs.Pop(executed);
             }
  
             uint32_t Submit(const uint32_t id, const Core::ProxyType<Core::JSON::IElement>& response) override;
@@ -1397,6 +1656,13 @@ namespace PluginHost {
                 return (_reason);
             }
 
+            string LibraryLocation() const {
+                Lock();
+                string result(_resolved.Path());
+                Unlock();
+
+                return (result);
+            }
             void LoadMetadata() {
                 const string locator(PluginHost::Service::Configuration().Locator.Value());
                 if (locator.empty() == false) {
@@ -1498,48 +1764,41 @@ namespace PluginHost {
 
         private:
             const Core::IService* LoadLibrary(const string& name, Core::Library& library) {
-                Core::IService* result(nullptr);
+                const Core::IService* result(nullptr);
                 string lastError;
                 string lastPath;
 
-                RPC::IStringIterator* all_paths = GetLibrarySearchPaths(name);
-                ASSERT(all_paths != nullptr);
+                if (_resolved.Lookup(name, lastPath) == true) {
+                    TRACE_L1("loading resolved library %s", lastPath.c_str());
+
+                    result = LoadLibrary(lastPath, library, lastError);
+                }
 
-                string element;
-                while((all_paths->Next(element) == true) && (result == nullptr)) {
+                if (result == nullptr) {
+                    RPC::IStringIterator* all_paths = GetLibrarySearchPaths(name);
+                    ASSERT(all_paths != nullptr);
 
-                    TRACE_L1("attempting to load library %s", element.c_str());
+                    _resolved.Clear();
 
-                    Core::File libraryToLoad(element);
+                    string element;
+                    while((all_paths->Next(element) == true) && (result == nullptr)) {
 
-                    if (libraryToLoad.Exists() == true) {
-                        lastPath = element;
+                        TRACE_L1("attempting to load library %s", element.c_str());
 
-                        // Loading a library, in the static initializers, might register Service::Metadata structures. As
-                        // the dlopen has a process wide system lock, make sure that the, during open used lock of the
-                        // ServiceAdministrator, is already taken before entering the dlopen. This can only be achieved
-                        // by forwarding this call to the ServiceAdministrator, so please so...
-                        Core::Library newLib(element.c_str());
+                        Core::File libraryToLoad(element);
 
-                        if (newLib.IsLoaded() == true) {
+                        if (libraryToLoad.Exists() == true) {
+                            lastPath = element;
 
-                            Core::System::GetModuleServicesImpl moduleServiceMetadata = reinterpret_cast<Core::System::GetModuleServicesImpl>(newLib.LoadFunction(_T("GetModuleServices")));
-                            if (moduleServiceMetadata != nullptr) {
-                                result = moduleServiceMetadata();
-                                if (result != nullptr) {
-                                    library = std::move(newLib);
-                                } else {
-                                    lastError = _T("GetModuleServices returned no service metadata");
-                                }
-                            } else {
-                                lastError = newLib.Error().empty() == false ? newLib.Error() : _T("GetModuleServices symbol missing");
+                            result = LoadLibrary(element, library, lastError);
+
+                            if (result != nullptr) {
+                                _resolved.Set(name, libraryToLoad);
                             }
-                        } else {
-                            lastError = newLib.Error().empty() == false ? newLib.Error() : _T("Library load failed");
                         }
                     }
+                    all_paths->Release();
                 }
-                all_paths->Release();
 
                 if (result == nullptr) {
                     if (lastPath.empty() == false) {
@@ -1553,6 +1812,34 @@ namespace PluginHost {
 
                 return (result);
             }
+            const Core::IService* LoadLibrary(const string& path, Core::Library& library, string& lastError) {
+                Core::IService* result(nullptr);
+
+                // Loading a library, in the static initializers, might register Service::Metadata structures. As
+                // the dlopen has a process wide system lock, make sure that the, during open used lock of the
+                // ServiceAdministrator, is already taken before entering the dlopen. This can only be achieved
+                // by forwarding this call to the ServiceAdministrator, so please so...
+                Core::Library newLib(path.c_str());
+
+                if (newLib.IsLoaded() == true) {
+
+                    Core::System::GetModuleServicesImpl moduleServiceMetadata = reinterpret_cast<Core::System::GetModuleServicesImpl>(newLib.LoadFunction(_T("GetModuleServices")));
+                    if (moduleServiceMetadata != nullptr) {
+                        result = moduleServiceMetadata();
+                        if (result != nullptr) {
+                            library = std::move(newLib);
+                        } else {
+                            lastError = _T("GetModuleServices returned no service metadata");
+                        }
+                    } else {
+                        lastError = newLib.Error().empty() == false ? newLib.Error() : _T("GetModuleServices symbol missing");
+                    }
+                } else {
+                    lastError = newLib.Error().empty() == false ? newLib.Error() : _T("Library load failed");
+                }
+
+                return (result);
+            }
 
             void AcquireInterfaces()
             {
@@ -1744,6 +2031,7 @@ namespace PluginHost {
             uint32_t _lastId;
             ControlData _metadata;
             Core::Library _library;
+            ResolvedLibrary _resolved;
 #ifdef HIBERNATE_SUPPORT_ENABLED
             void* _hibernateStorage;
 #endif
@@ -3178,8 +3466,8 @@ namespace PluginHost {
                     bool IsValid() const {
                         return (_observerPath.empty() == false);
                     }
-                    void Updated() override {
-                        _parent.Reload(_observerPath);
+                    void Changed(const std::vector<string>& files) override {
+                        _parent.Reload(files);
                     }
 
                 private:
@@ -3209,6 +3497,7 @@ namespace PluginHost {
                     const uint8_t softKillCheckWaitTime,
                     const uint8_t hardKillCheckWaitTime,
                     const bool delegatedReleases,
+                    const bool sharedMemory,
                     const Core::ProxyType<RPC::InvokeServer>& handler)
                     : RPC::Communicator(node, ProxyStubPathCreator(proxyStubPath, observableProxyStubPath), Core::ProxyType<Core::IIPCServer>(handler), _T("/"))
                     , _parent(parent)
@@ -3239,6 +3528,7 @@ namespace PluginHost {
                     RPC::Administrator::Instance().DelegatedReleases(delegatedReleases);
 
                     RPC::Communicator::ForcedDestructionTimes(softKillCheckWaitTime, hardKillCheckWaitTime);
+                    RPC::Communicator::SharedMemory(sharedMemory);
 
                     if (observableProxyStubPath.empty() == true) {
                         SYSLOG(Logging::Startup, (_T("Dynamic COMRPC disabled.")));
@@ -3270,7 +3560,7 @@ namespace PluginHost {
             public:
                 void* Create(uint32_t& connectionId, const RPC::Object& instance, const uint32_t waitTime, const string& dataPath, const string& persistentPath, const string& volatilePath, const string& extensionPath, const std::vector<string>& linkerPaths)
                 {
-                    return (RPC::Communicator::Create(connectionId, instance, RPC::Config(RPC::Communicator::Connector(), _application, persistentPath, _systemPath, extensionPath, dataPath, volatilePath, _appPath, RPC::Communicator::ProxyStubPath(), _postMortemPath, linkerPaths), waitTime));
+                    return (RPC::Communicator::Create(connectionId, instance, RPC::Config(RPC::Communicator::HostConnector(), _application, persistentPath, _systemPath, extensionPath, dataPath, volatilePath, _appPath, RPC::Communicator::ProxyStubPath(), _postMortemPath, linkerPaths), waitTime));
                 }
                 const string& PersistentPath() const
                 {
@@ -3407,9 +3697,9 @@ namespace PluginHost {
                 }
             }
             private:
-                void Reload(const string& path) {
-                    TRACE(Activity, (Core::Format(_T("Reloading ProxyStubs from %s."), path.c_str())));
-                    RPC::Communicator::LoadProxyStubs(path);
+                void Reload(const std::vector<string>& files) {
+                    TRACE(Activity, (Core::Format(_T("Reloading %u ProxyStub(s)."), static_cast<uint32_t>(files.size()))));
+                    RPC::Communicator::LoadProxyStubs(files);
                 }
                 string ProxyStubPathCreator(const string& proxyStubPath, const string& observableProxyStubPath) {
                     string concatenatedPath;
@@ -3696,7 +3986,8 @@ namespace PluginHost {
                 bool IsValid() const {
                     return (_observerPath.empty() == false);
                 }
-                void Updated() override {
+                void Changed(const std::vector<string>& /* files */) override {
+                    // One pass over all configs for all changes in this window.
                     _parent.ConfigReload(_observerPath);
                 }
 
@@ -3704,6 +3995,138 @@ namespace PluginHost {
                 ServiceMap& _parent;
                 string _observerPath;
             };
+            // Reads ahead, on a worker thread, the libraries the services resolved during the previous
+            // startup, in the order they were activated. The list is persisted, so the read ahead can start
+            // before any plugin (or its metadata) is loaded and the I/O for the library of a service overlaps
+            // with loading the ones before it.
+            class LibraryPrefetch {
+            public:
+                using Libraries = std::list<string>;
+
+            private:
+
+                class Index : public Core::JSON::Container {
+                public:
+                    Index(Index&&) = delete;
+                    Index(const Index&) = delete;
+                    Index& operator=(Index&&) = delete;
+                    Index& operator=(const Index&) = delete;
+
+                    Index()
+                        : Core::JSON::Container()
+                        , Libraries()
+                    {
+                        Add(_T("libraries"), &Libraries);
+                    }
+                    ~Index() override = default;
+
+                public:
+                    Core::JSON::ArrayType<Core::JSON::String> Libraries;
+                };
+
+            public:
+                LibraryPrefetch() = delete;
+                LibraryPrefetch(LibraryPrefetch&&) = delete;
+                LibraryPrefetch(const LibraryPrefetch&) = delete;
+                LibraryPrefetch& operator=(LibraryPrefetch&&) = delete;
+                LibraryPrefetch& operator=(const LibraryPrefetch&) = delete;
+
+                LibraryPrefetch(const bool enabled, const string& indexFile)
+                    : _adminLock()
+                    , _libraries()
+                    , _previous()
+                    , _indexFile(indexFile)
+                    , _enabled(enabled)
+                    , _job(*this) {
+                }
+                ~LibraryPrefetch() {
+                    _job.Revoke();
+                }
+
+            public:
+                // Starts reading ahead the libraries recorded by the previous startup.
+                void Start() {
+                    if ((_enabled == true) && (_indexFile.empty() == false)) {
+                        Core::File storage(_indexFile);
+
+                        if ((storage.Exists() == true) && (storage.Open(true) == true)) {
+                            Index index;
+                            Core::OptionalType<Core::JSON::Error> error;
+
+                            index.IElement::FromFile(storage, error);
+                            storage.Close();
+
+                            if (error.IsSet() == false) {
+                                Core::JSON::ArrayType<Core::JSON::String>::Iterator entry(index.Libraries.Elements());
+
+                                _adminLock.Lock();
+                                while (entry.Next() == true) {
+                                    _previous.push_back(entry.Current().Value());
+                                    _libraries.push_back(entry.Current().Value());
+                                }
+                                _adminLock.Unlock();
+
+                                _job.Submit();
+                            }
+                        }
+                    }
+                }
+                // Records the libraries resolved during this startup, in activation order, for the next one.
+                void Record(const Libraries& libraries) {
+                    if ((_enabled == true) && (_indexFile.empty() == false) && (libraries != _previous)) {
+                        Core::File storage(_indexFile);
+                        Index index;
+
+                        for (const string& library : libraries) {
+                            index.Libraries.Add() = library;
+                        }
+
+                        Core::Directory(storage.PathName().c_str()).CreatePath();
+
+                        if (storage.Create() == true) {
+                            index.IElement::ToFile(storage);
+                            storage.Close();
+                        }
+                        else {
+                            SYSLOG(Logging::Startup, (_T("Library index [%s] could not be written."), _indexFile.c_str()));
+                        }
+
+                        _previous = libraries;
+                    }
+                }
+
+            private:
+                friend class Core::ThreadPool::JobType<LibraryPrefetch&>;
+
+                string JobIdentifier() const {
+                    return(_T("Thunder::PluginHost::Server::ServiceMap::LibraryPrefetch"));
+                }
+                void Dispatch() {
+                    _adminLock.Lock();
+
+                    while (_libraries.empty() == false) {
+                        const string library(_libraries.front());
+                        _libraries.pop_front();
+
+                        _adminLock.Unlock();
+
+                        Prefetch(library);
+
+                        _adminLock.Lock();
+                    }
+
+                    _adminLock.Unlock();
+                }
+                static void Prefetch(const string& library);
+
+            private:
+                Core::CriticalSection _adminLock;
+                Libraries _libraries;
+                Libraries _previous;
+                const string _indexFile;
+                const bool _enabled;
+                Core::WorkerPool::JobType<LibraryPrefetch&> _job;
+            };
 
             using Channels = std::vector<uint32_t>;
 
@@ -3720,6 +4143,7 @@ namespace PluginHost {
                 , _adminLock()
                 , _notificationLock()
                 , _services()
+                , _index()
                 , _notifiers()
                 , _extendedNotifiers()
                 , _engine(Core::ProxyType<RPC::InvokeServer>::Create(&(server._dispatcher)))
@@ -3738,6 +4162,7 @@ namespace PluginHost {
                       server._config.SoftKillCheckWaitTime(),
                       server._config.HardKillCheckWaitTime(),
                       server._config.DelegatedReleases(),
+                      server._config.SharedMemory(),
                       _engine)
                 , _subSystems(this)
                 , _authenticationHandler(nullptr)
@@ -3747,9 +4172,13 @@ namespace PluginHost {
                 , _opened()
                 , _closed()
                 , _job(*this)
+                , _prefetch(server._config.LibraryPrefetch(), (server._config.PersistentPath().empty() == true ? string() : server._config.PersistentPath() + LibraryIndex))
                 , _disablePluginAutoActivation(server._config.DisablePluginAutoActivation())
                 , _prioritystartorder(server._config.AuthorizedExtensions())
             {
+                if ((server._config.PluginConfigPath().empty() == false) || (server._config.ObservableProxyStubPath().empty() == false)) {
+                    Core::FileSystemMonitor::Instance().Debounce(server._config.ObserveDebounce());
+                }
                 if (server._config.PluginConfigPath().empty() == true) {
                     SYSLOG(Logging::Startup, (_T("Dynamic configs disabled.")));
                 } else if (_configObserver.IsValid() == false) {
@@ -4078,6 +4507,7 @@ namespace PluginHost {
                     if (_services.find(configuration.Callsign.Value()) == _services.end()) {
                         // Fire up the interface. Let it handle the messages.
                         _services.insert(std::pair<const string, Core::ProxyType<Service>>(configuration.Callsign.Value(), newService));
+                        Reindex();
                         _adminLock.Unlock();
                     }
                     else {
@@ -4110,6 +4540,7 @@ namespace PluginHost {
                             std::piecewise_construct,
                             std::forward_as_tuple(newConfiguration.Callsign.Value()),
                             std::forward_as_tuple(clone));
+                        Reindex();
 
                         clone->Evaluate();
                         newService = Core::ProxyType<IShell>(clone);
@@ -4142,6 +4573,7 @@ namespace PluginHost {
 
                         index->second->Destroy();
                         _services.erase(index);
+                        Reindex();
                         _adminLock.Unlock();
                     } else {
                         _adminLock.Unlock();
@@ -4289,33 +4721,36 @@ namespace PluginHost {
 
             uint32_t FromIdentifier(const string& callsign, Core::ProxyType<IShell>& service)
             {
-                uint32_t result = Core::ERROR_NOT_EXIST;
+                Core::ProxyType<Service> entry;
 
-                _adminLock.Lock();
+                uint32_t result = FromIdentifier(callsign.c_str(), static_cast<uint32_t>(callsign.length()), entry);
 
-                Plugins::const_iterator it;
+                if (result == Core::ERROR_NONE) {
+                    service = Core::ProxyType<IShell>(entry);
+                }
+
+                return (result);
+            }
+            // Routing hot path, does not take the admin lock nor allocate.
+            uint32_t FromIdentifier(const TCHAR callsign[], const uint32_t length, Core::ProxyType<Service>& service) const
+            {
+                uint32_t result = Core::ERROR_NOT_EXIST;
+                uint32_t size = length;
 
 #ifdef __ACCEPT_VERSION_IN_CALLSIGN__
                 // JSON-RPC version number has no meaning here, but such syntax was previously accidentally allowed.
-                const uint16_t length = static_cast<uint16_t>(callsign.length());
                 if ((length > 2) && (callsign[length - 2] == TCHAR('.')) && (::isdigit(callsign[length - 1])) != 0) {
-                    TRACE_L1("Ignoring version number in callsign '%s'", callsign.c_str());
-                    SYSLOG(Logging::Notification, (_T("Version number not expected in a callsign ('%s'), ignored!"), callsign.c_str()));
-                    it = _services.find(string(callsign.data(), (length - 2)));
-                } else
+                    TRACE_L1("Ignoring version number in callsign '%s'", string(callsign, length).c_str());
+                    SYSLOG(Logging::Notification, (_T("Version number not expected in a callsign ('%s'), ignored!"), string(callsign, length).c_str()));
+                    size = length - 2;
+                }
 #endif // __ACCEPT_VERSION_IN_CALLSIGN__
 
-                it = _services.find(callsign);
-
-                if (it != _services.end()) {
-                    ASSERT(it->second != nullptr);
-
-                    service = Core::ProxyType<IShell>(it->second);
+                if (_index.Find(callsign, size, service) == true) {
+                    ASSERT(service.IsValid() == true);
                     result = Core::ERROR_NONE;
                 }
 
-                _adminLock.Unlock();
-
                 return (result);
             }
             inline const PluginHost::Config& Configuration() const
@@ -4468,6 +4903,11 @@ namespace PluginHost {
 
                 return (result);
             }
+            void Reindex()
+            {
+                // Called with the admin lock taken, after every change to _services.
+                _index.Publish(_services.cbegin(), _services.cend());
+            }
             void RecursiveNotification(Plugins::iterator& index)
             {
                 if (index != _services.end()) {
@@ -4519,6 +4959,7 @@ namespace PluginHost {
             mutable Core::CriticalSection _adminLock;
             Core::CriticalSection _notificationLock;
             Plugins _services;
+            Core::ReadMostlyMapType<Core::ProxyType<Service>> _index;
             mutable RemoteInstantiators _instantiators;
             Notifiers<PluginHost::IPlugin::INotification> _notifiers;
             Notifiers<PluginHost::IPlugin::INotificationExtended> _extendedNotifiers;
@@ -4532,6 +4973,7 @@ namespace PluginHost {
             Channels _opened;
             Channels _closed;
             Core::WorkerPool::JobType<ServiceMap&> _job;
+            LibraryPrefetch _prefetch;
             bool _disablePluginAutoActivation;
             std::vector<string> _prioritystartorder;
         };
@@ -4553,6 +4995,7 @@ namespace PluginHost {
                     : _ID(~0)
                     , _server(nullptr)
                     , _service()
+                    , _started(0)
                 {
                 }
                 ~Job() override
@@ -4562,6 +5005,15 @@ namespace PluginHost {
                 }
 
             public:
+                uint32_t ChannelId() const
+                {
+                    return (_ID);
+                }
+                // The channel could not queue this job, let the other side know (if possible) and release it.
+                virtual void Rejected()
+                {
+                    Clear();
+                }
                 void Close()
                 {
                     TRACE(Activity, (_T("HTTP Request with direct close on [%d]"), _ID));
@@ -4660,6 +5112,33 @@ namespace PluginHost {
                         channel->Submit(package);
                     }
                 }
+                void Submit(const Core::ProxyType<Web::Request>& request, const Core::ProxyType<Web::Response>& response)
+                {
+                    ASSERT(_server != nullptr);
+
+                    Core::ProxyType<Channel> channel(_server->Connection(_ID));
+                    if (channel.IsValid() == true) {
+                        channel->Submit(Core::ProxyType<Request>(request), response);
+                    }
+                }
+                void Defer(const Core::ProxyType<Web::Request>& request, const uint32_t id)
+                {
+                    ASSERT(_server != nullptr);
+
+                    Core::ProxyType<Channel> channel(_server->Connection(_ID));
+                    if (channel.IsValid() == true) {
+                        channel->Defer(Core::ProxyType<Request>(request), id);
+                    }
+                }
+                void Resolve(const Core::ProxyType<Web::Request>& request)
+                {
+                    ASSERT(_server != nullptr);
+
+                    Core::ProxyType<Channel> channel(_server->Connection(_ID));
+                    if (channel.IsValid() == true) {
+                        channel->Resolve(Core::ProxyType<Request>(request));
+                    }
+                }
                 void RequestClose() {
                     ASSERT(_server != nullptr);
                     Core::ProxyType<Channel> channel (_server->Connection(_ID));
@@ -4671,6 +5150,10 @@ namespace PluginHost {
                     ASSERT(_service.IsValid() == true);
                     return _service->Callsign();
                 }
+                // The job got its slot on the service and starts executing, the service measures how long it takes.
+                void Started() {
+                    _started = Core::MonotonicTime::Now();
+                }
                 void Completed() {
                     ASSERT(_ID != static_cast<uint32_t>(~0));
                     ASSERT(_server != nullptr);
@@ -4678,7 +5161,7 @@ namespace PluginHost {
 
                     // Oke, Job is completed, maybe time for a new one ?
                     // Let the Service (aka Plugin) know a request has been handled..
-                    _service->Pop();
+                    _service->Pop(Core::MonotonicTime::Now() - _started);
 
                     // Let the channel now a request for this channel has been handled...
                     Core::ProxyType<Channel> channel(_server->Connection(_ID));
@@ -4693,6 +5176,59 @@ namespace PluginHost {
                 uint32_t _ID;
                 Server* _server;
                 Core::ProxyType<Service> _service;
+                uint64_t _started;
+            };
+
+            // Collects the responses to the members of an inbound JSON-RPC batch. The
+            // member that completes last sends them out as a single array.
+            class BatchResponse : public Core::JSONRPC::Batch {
+            public:
+                BatchResponse(BatchResponse&&) = delete;
+                BatchResponse(const BatchResponse&) = delete;
+                BatchResponse& operator=(BatchResponse&&) = delete;
+                BatchResponse& operator=(const BatchResponse&) = delete;
+
+                BatchResponse()
+                    : Core::JSONRPC::Batch()
+                    , _adminLock()
+                    , _pending(1)
+                {
+                }
+                ~BatchResponse() override = default;
+
+            public:
+                void Clear() override
+                {
+                    Core::JSONRPC::Batch::Clear();
+                    _pending = 1;
+                }
+                void Expect()
+                {
+                    _adminLock.Lock();
+                    _pending++;
+                    _adminLock.Unlock();
+                }
+                // Returns true if this was the last outstanding member and there is
+                // something to report. Notifications (no response) only count down.
+                bool Completed(const Core::ProxyType<Core::JSONRPC::Message>& response)
+                {
+                    _adminLock.Lock();
+
+                    if (response.IsValid() == true) {
+                        Add().Assign(*response);
+                    }
+
+                    ASSERT(_pending > 0);
+                    bool result = ((--_pending == 0) && (Length() > 0));
+
+                    _adminLock.Unlock();
+
+                    return (result);
+                }
+
+            private:
+                Core::CriticalSection _adminLock;
+                uint32_t _pending;
             };
 
         private:
@@ -4793,6 +5329,8 @@ namespace PluginHost {
                     ASSERT(_request.IsValid());
                     ASSERT(Job::HasService() == true);
 
+                    Job::Started();
+
                     Core::ProxyType<Web::Response> response;
 
                     if (_jsonrpc == false) {
@@ -4803,6 +5341,13 @@ namespace PluginHost {
                     }
                     else {
                         Core::ProxyType<Core::JSONRPC::Message> message(_request->Body< Core::JSONRPC::Message>());
+
+                        // The answer might come in asynchronously, even before Process() returns. Until
+                        // it does, the request keeps its place in the order of the answers on the channel.
+                        if (message->Id.IsSet() == true) {
+                            Job::Defer(_request, message->Id.Value());
+                        }
+
                         Core::ProxyType<Core::JSONRPC::Message> body = Job::Process(_token, message);
 
                         // If we have no response body, it looks like an async-call...
@@ -4817,6 +5362,10 @@ namespace PluginHost {
                             }
                         }
                         else {
+                            if (message->Id.IsSet() == true) {
+                                Job::Resolve(_request);
+                            }
+
                             response = IFactories::Instance().Response();
                             response->Body(body);
                             // although there is no definitive approved RFC for this consensus is also on failure we should return a status OK (200)
@@ -4848,7 +5397,7 @@ namespace PluginHost {
                         if (response->CacheControl.IsSet() == false)
                             response->CacheControl = _T("no-cache, private, no-store, must-revalidate, max-stale=0, post-check=0, pre-check=0");
 
-                        Job::Submit(response);
+                        Job::Submit(_request, response);
 
                         if (_request->Connection.Value() == Web::Request::CONNECTION_CLOSE) {
                             Job::Close();
@@ -4860,6 +5409,19 @@ namespace PluginHost {
 
                     Job::Completed();
                 }
+                void Rejected() override
+                {
+                    Core::ProxyType<Web::Response> response(IFactories::Instance().Response());
+
+                    response->ErrorCode = Web::STATUS_SERVICE_UNAVAILABLE;
+                    response->Message = _T("Too many requests pending on this connection.");
+
+                    Job::Submit(_request, response);
+
+                    _request.Release();
+
+                    Job::Clear();
+                }
                 string Identifier() const override {
                     string identifier;
                     if (_jsonrpc == false) {
@@ -4890,12 +5452,14 @@ namespace PluginHost {
                 JSONElementJob()
                     : Job()
                     , _element()
+                    , _batch()
                     , _jsonrpc(false)
                 {
                 }
                 ~JSONElementJob() override
                 {
                     ASSERT(_element.IsValid() == false);
+                    ASSERT(_batch.IsValid() == false);
                 }
 
             public:
@@ -4942,13 +5506,21 @@ namespace PluginHost {
                     ASSERT(Job::HasService() == true);
                     ASSERT(_element.IsValid() == true);
 
+                    Job::Started();
+
                     if (_jsonrpc == true) {
                         _element = Core::ProxyType<Core::JSON::IElement>(Job::Process(_token, Core::ProxyType<Core::JSONRPC::Message>(_element)));
                     } else {
                         _element = Job::Process(_element);
                     }
 
-                    if (_element.IsValid()) {
+                    if (_batch.IsValid() == true) {
+                        if (_batch->Completed(Core::ProxyType<Core::JSONRPC::Message>(_element)) == true) {
+                            Job::Submit(Core::ProxyType<Core::JSON::IElement>(_batch));
+                        }
+                        _batch.Release();
+                    }
+                    else if (_element.IsValid()) {
                         Job::Submit(_element);
                     }
 
@@ -4958,6 +5530,45 @@ namespace PluginHost {
                         _element.Release();
                     }
                 }
+                void Rejected() override
+                {
+                    Core::ProxyType<Core::JSONRPC::Message> message;
+
+                    if (_jsonrpc == true) {
+                        message = Core::ProxyType<Core::JSONRPC::Message>(_element);
+
+                        // Notifications expect no answer, not even this one.
+                        if ((message.IsValid() == true) && (message->Id.IsSet() == true)) {
+                            message->Error.SetError(Core::ERROR_UNAVAILABLE);
+                            message->Error.Text = _T("Too many requests pending on this connection");
+                        }
+                        else {
+                            message.Release();
+                        }
+                    }
+
+                    if (_batch.IsValid() == true) {
+                        // A rejected member still counts down, the batch answers with its error in place.
+                        if (_batch->Completed(message) == true) {
+                            Job::Submit(Core::ProxyType<Core::JSON::IElement>(_batch));
+                        }
+                        _batch.Release();
+                    }
+                    else if (message.IsValid() == true) {
+                        Job::Submit(Core::ProxyType<Core::JSON::IElement>(message));
+                    }
+
+                    _element.Release();
+
+                    Job::Clear();
+                }
+                void Batch(const Core::ProxyType<BatchResponse>& batch)
+                {
+                    ASSERT(_batch.IsValid() == false);
+
+                    batch->Expect();
+                    _batch = batch;
+                }
                 string Identifier() const override {
                     if (_jsonrpc == true) {
                         Core::ProxyType<Core::JSONRPC::Message> message(_element);
@@ -4972,6 +5583,7 @@ namespace PluginHost {
 
             private:
                 Core::ProxyType<Core::JSON::IElement> _element;
+                Core::ProxyType<BatchResponse> _batch;
                 string _token;
                 bool _jsonrpc;
             };
@@ -4995,6 +5607,8 @@ namespace PluginHost {
                 {
                     ASSERT(HasService() == true);
 
+                    Job::Started();
+
                     _text = Job::Process(_text);
 
                     if (_text.empty() == false) {
@@ -5005,6 +5619,12 @@ namespace PluginHost {
 
                     Job::Completed();
                 }
+                void Rejected() override
+                {
+                    _text.clear();
+
+                    Job::Clear();
+                }
                 string Identifier() const override {
                     return(_T("PluginServer::Channel::TextJob::") + Callsign());
                 }
@@ -5024,12 +5644,14 @@ namespace PluginHost {
 
             public:
                 inline void Submit(Core::ProxyType<Job>&& job) {
-                    job->GetService().Submit(Core::ProxyType<Core::IDispatch>(job));
+                    const uint32_t channelId(job->ChannelId());
+                    job->GetService().Submit(Core::ProxyType<Core::IDispatch>(job), channelId);
                 }
             };
-            using Jobs = Core::ThrottleQueueType<Core::ProxyType<Job>, JobForwarder>;
 
         public:
+            using Jobs = Core::ThrottleQueueType<Core::ProxyType<Job>, JobForwarder>;
+
             Channel() = delete;
             Channel(Channel&& copy) = delete;
             Channel(const Channel& copy) = delete;
@@ -5079,6 +5701,10 @@ namespace PluginHost {
             {
                 PluginHost::Channel::Submit(entry);
             }
+            inline void Submit(const Core::ProxyType<Request>& request, const Core::ProxyType<Web::Response>& entry)
+            {
+                PluginHost::Channel::Submit(request, entry);
+            }
             void Submit(const Core::ProxyType<Core::JSON::IElement>& entry)
             {
                 if (State() == Channel::ChannelState::WEB) {
@@ -5092,20 +5718,71 @@ namespace PluginHost {
 
                     response->Body(entry);
 
-                    PluginHost::Channel::Submit(response);
+                    // The asynchronous answer to a JSON-RPC request over HTTP takes the place of that request.
+                    Core::ProxyType<Request> request(Deferred(entry));
+
+                    if (request.IsValid() == true) {
+                        PluginHost::Channel::Submit(request, response);
+                    }
+                    else {
+                        PluginHost::Channel::Submit(response);
+                    }
                 }
                 else {
                     PluginHost::Channel::Submit(entry);
                 }
             }
+            // A JSON-RPC request over HTTP that might be answered asynchronously, by Submit(IElement).
+            void Defer(const Core::ProxyType<Request>& request, const uint32_t id)
+            {
+                _deferredLock.Lock();
+                _deferred.emplace_back(id, request);
+                _deferredLock.Unlock();
+            }
+            // It was answered synchronously after all.
+            void Resolve(const Core::ProxyType<Request>& request)
+            {
+                _deferredLock.Lock();
+                Deferrals::iterator index(std::find_if(_deferred.begin(), _deferred.end(), [&request](const Deferral& entry) { return (entry.second == request); }));
+                if (index != _deferred.end()) {
+                    _deferred.erase(index);
+                }
+                _deferredLock.Unlock();
+            }
             inline void Pop() {
                 _jobs.Pop();
             }
+            inline void Statistics(Jobs::Statistics& info) const {
+                _jobs.Snapshot(info);
+            }
             inline void RequestClose() {
                 _requestClose = true;
             }
 
         private:
+            using Deferral = std::pair<uint32_t, Core::ProxyType<Request>>;
+            using Deferrals = std::list<Deferral>;
+
+            // The deferred request the answer belongs to, matched on the JSON-RPC id.
+            Core::ProxyType<Request> Deferred(const Core::ProxyType<Core::JSON::IElement>& answer)
+            {
+                Core::ProxyType<Request> result;
+                const Core::JSONRPC::Message* message = dynamic_cast<const Core::JSONRPC::Message*>(&(*answer));
+
+                if ((message != nullptr) && (message->Id.IsSet() == true)) {
+                    const uint32_t id = message->Id.Value();
+
+                    _deferredLock.Lock();
+                    Deferrals::iterator index(std::find_if(_deferred.begin(), _deferred.end(), [id](const Deferral& entry) { return (entry.first == id); }));
+                    if (index != _deferred.end()) {
+                        result = index->second;
+                        _deferred.erase(index);
+                    }
+                    _deferredLock.Unlock();
+                }
+
+                return (result);
+            }
             bool Allowed(const string& pathParameter, const string& queryParameters)
             {
                 Core::URL::KeyValue options(queryParameters);
@@ -5235,23 +5912,23 @@ namespace PluginHost {
                         result->Message = "Not Found";
                     }
 
-                    Submit(result);
+                    Submit(request, result);
 
                     break;
                 }
                 case Request::MISSING_CALLSIGN: {
                     // Report that we, at least, need a call sign.
-                    Submit(_missingCallsign);
+                    Submit(request, _missingCallsign);
                     break;
                 }
                 case Request::INVALID_VERSION: {
                     // Report that we, at least, need a call sign.
-                    Submit(_incorrectVersion);
+                    Submit(request, _incorrectVersion);
                     break;
                 }
                 case Request::UNAUTHORIZED: {
                     // Report that we, at least, need a call sign.
-                    Submit(_unauthorizedRequest);
+                    Submit(request, _unauthorizedRequest);
                     break;
                 }
                 case Request::COMPLETE: {
@@ -5267,7 +5944,7 @@ namespace PluginHost {
 
                     if (response.IsValid() == true) {
                         // Report that the calls sign could not be found !!
-                        Submit(response);
+                        Submit(request, response);
                     } else {
                         // Send the Request object out to be handled.
                         // By definition, we can issue it on a rental thread..
@@ -5280,12 +5957,20 @@ namespace PluginHost {
                             Core::ProxyType<Web::Response> response = job->Set(Id(), &_parent, service, baseRequest, _security->Token(), !request->RestfulCall());
 
                             if (response.IsValid() == false) {
-                                _jobs.Push(Core::ProxyType<Job>(job));
+                                Push(Core::ProxyType<Job>(job));
                             }
                             else {
-                                Submit(response);
+                                Submit(request, response);
                             }
                         }
+                        else {
+                            // Still answer it, the answers to the requests after this one wait for it.
+                            Core::ProxyType<Web::Response> failure(IFactories::Instance().Response());
+                            failure->ErrorCode = Web::STATUS_SERVICE_UNAVAILABLE;
+                            failure->Message = _T("No resources available to handle the request.");
+
+                            Submit(request, failure);
+                        }
                     }
                     break;
                 }
@@ -5296,7 +5981,7 @@ namespace PluginHost {
                     response->ErrorCode = Web::STATUS_INTERNAL_SERVER_ERROR;
                     response->Message = _T("Request routing did not complete.");
 
-                    Submit(response);
+                    Submit(request, response);
                     break;
                 }
                 default: {
@@ -5330,18 +6015,62 @@ namespace PluginHost {
 
                 return (result);
             }
+            Core::ProxyType<Core::JSON::IElement> Batch() override
+            {
+                Core::ProxyType<Core::JSON::IElement> result;
+
+                if (_service.IsValid() == true) {
+                    result = Core::ProxyType<Core::JSON::IElement>(_batches.Element());
+                }
+
+                return (result);
+            }
             void Send(const Core::ProxyType<Core::JSON::IElement>& element VARIABLE_IS_NOT_USED) override
             {
                 TRACE(SocketFlow, (element));
             }
             void Received(Core::ProxyType<Core::JSON::IElement>& element) override
             {
-                bool securityClearance = ((State() & Channel::JSONRPC) == 0);
-
                 ASSERT(_service.IsValid() == true);
 
                 TRACE(SocketFlow, (element));
 
+                Core::ProxyType<Core::JSONRPC::Batch> batch(element);
+
+                if (batch.IsValid() == false) {
+                    Dispatch(element, Core::ProxyType<BatchResponse>());
+                }
+                else if (batch->Length() == 0) {
+                    // An empty batch is an invalid request, answered with a single error object.
+                    Core::ProxyType<Core::JSONRPC::Message> message(IFactories::Instance().JSONRPC());
+                    message->Id.Null(true);
+                    message->Error.SetError(Core::ERROR_INVALID_ENVELOPPE);
+                    Submit(Core::ProxyType<Core::JSON::IElement>(message));
+                }
+                else {
+                    // Every member is dispatched as a job of its own, so they run concurrently
+                    // (within the limits of the service). The responses are gathered in one array.
+                    Core::ProxyType<BatchResponse> response(_responses.Element());
+                    Core::JSONRPC::Batch::Iterator index(batch->Elements());
+
+                    while (index.Next() == true) {
+                        Core::ProxyType<Core::JSONRPC::Message> message(IFactories::Instance().JSONRPC());
+                        message->Assign(index.Current());
+
+                        Core::ProxyType<Core::JSON::IElement> member(message);
+                        Dispatch(member, response);
+                    }
+
+                    // Drop the guard reference taken at creation, whoever completes last reports.
+                    if (response->Completed(Core::ProxyType<Core::JSONRPC::Message>()) == true) {
+                        Submit(Core::ProxyType<Core::JSON::IElement>(response));
+                    }
+                }
+            }
+            void Dispatch(Core::ProxyType<Core::JSON::IElement>& element, const Core::ProxyType<BatchResponse>& batch)
+            {
+                bool securityClearance = ((State() & Channel::JSONRPC) == 0);
+
                 if (securityClearance == false) {
                     Core::ProxyType<Core::JSONRPC::Message> message(element);
                     if (message.IsValid()) {
@@ -5356,7 +6085,7 @@ namespace PluginHost {
                             // Oopsie daisy we are not allowed to handle this request.
                             // TODO: How shall we report back on this?
                             message->Error.SetError(Core::ERROR_PRIVILIGED_REQUEST);
-                            Submit(Core::ProxyType<Core::JSON::IElement>(message));
+                            Respond(Core::ProxyType<Core::JSON::IElement>(message), batch);
                         }
                     }
                 }
@@ -5370,15 +6099,31 @@ namespace PluginHost {
 
                     if ((_service.IsValid() == true) && (job.IsValid() == true)) {
                         Core::ProxyType<Core::JSON::IElement> response = job->Set(Id(), &_parent, _service, element, _security->Token(), ((State() & Channel::JSONRPC) != 0));
-                        if (response.IsValid() == false) {
-                            _jobs.Push(Core::ProxyType<Job>(job));
+                        if (response.IsValid() == true) {
+                            Respond(response, batch);
                         }
                         else {
-                            Submit(response);
+                            // Batch members take a slot on the channel like any other request.
+                            if (batch.IsValid() == true) {
+                                job->Batch(batch);
+                            }
+                            Push(Core::ProxyType<Job>(job));
                         }
                     }
                 }
             }
+            void Respond(const Core::ProxyType<Core::JSON::IElement>& response, const Core::ProxyType<BatchResponse>& batch)
+            {
+                if (batch.IsValid() == false) {
+                    Submit(response);
+                }
+                else {
+                    batch->Expect();
+                    if (batch->Completed(Core::ProxyType<Core::JSONRPC::Message>(response)) == true) {
+                        Submit(Core::ProxyType<Core::JSON::IElement>(batch));
+                    }
+                }
+            }
             void Received(const string& value) override
             {
                 ASSERT(_service.IsValid() == true);
@@ -5393,7 +6138,7 @@ namespace PluginHost {
 
                 if ((_service.IsValid() == true) && (job.IsValid() == true)) {
                     job->Set(Id(), &_parent, _service, value);
-                    _jobs.Push(Core::ProxyType<Job>(job));
+                    Push(Core::ProxyType<Job>(job));
                 }
             }
 
@@ -5434,6 +6179,10 @@ namespace PluginHost {
 
                     CleanupService();
 
+                    _deferredLock.Lock();
+                    _deferred.clear();
+                    _deferredLock.Unlock();
+
                     State(CLOSED, false);
 
                     _parent.Operational(Id(), false);
@@ -5502,6 +6251,25 @@ namespace PluginHost {
                 SetId(id);
             }
 
+            // If the queue of this channel is full, either the oldest waiting job is shed to make room, or the
+            // new one is rejected. Either way the dropped job is answered with an error, where possible.
+            void Push(Core::ProxyType<Job>&& job)
+            {
+                if (_jobs.Push(std::move(job)) == false) {
+                    Core::ProxyType<Job> dropped;
+
+                    if ((_shedding == true) && (_jobs.Shed(dropped) == true)) {
+                        dropped->Rejected();
+
+                        if (_jobs.Push(std::move(job)) == false) {
+                            job->Rejected();
+                        }
+                    }
+                    else {
+                        job->Rejected();
+                    }
+                }
+            }
             void CleanupService()
             {
                 bool expected = false;
@@ -5519,11 +6287,16 @@ namespace PluginHost {
             Core::ProxyType<Service> _service;
             bool _requestClose;
             Jobs _jobs;
+            bool _shedding;
             std::atomic<bool> _serviceCleanedUp;
+            Core::CriticalSection _deferredLock;
+            Deferrals _deferred;
 
             // Factories for creating jobs that can be placed on the PluginHost Worker pool.
             static Core::ProxyPoolType<WebRequestJob> _webJobs;
             static Core::ProxyPoolType<JSONElementJob> _jsonJobs;
+            static Core::ProxyPoolType<Core::JSONRPC::Batch> _batches;
+            static Core::ProxyPoolType<BatchResponse> _responses;
             static Core::ProxyPoolType<TextJob> _textJobs;
 
             // If there is no call sign or the associated handler does not exist,
@@ -503,7 +503,7 @@ public:
 
         _lock.Unlock();
     }
-    void Startup(const uint8_t threadCount, const Core::NodeId& remoteNode, const string& callsign)
+    void Startup(const uint8_t threadCount, const Core::NodeId& remoteNode, const uint32_t sharedRingSize, const string& callsign)
     {
         // Seems like we have enough information, open up the Process communcication Channel.
         _engine = Core::ProxyType<Process::WorkerPoolImplementation>::Create(threadCount, Core::Thread::DefaultStackSize(), 16, callsign);
@@ -515,6 +515,7 @@ public:
         PluginHost::IFactories::Assign(&_factories);
 
         _server = (Core::ProxyType<RPC::CommunicatorClient>::Create(remoteNode, Core::ProxyType<Core::IIPCServer>(_engine)));
+        _server->SharedMemory(sharedRingSize);
     }
     void Run(const string& pathName, const uint32_t interfaceId, void* base, const uint32_t sequenceId)
     {
@@ -610,7 +611,7 @@ int main(int argc, char** argv)
         printf("         -l <locator>\n");
         printf("         -c <classname>\n");
         printf("         -C <callsign>\n");
-        printf("         -r <communication channel>\n");
+        printf("         -r <communication channel, prefix with shared: to move the traffic to shared memory>\n");
         printf("         -x <eXchange identifier>\n");
         printf("        [-i <interface ID>]\n");
         printf("        [-t <thread count>\n");
@@ -688,7 +689,9 @@ int main(int argc, char** argv)
 
         Process::ProcessFlow process;
 
-        Core::NodeId remoteNode(options.RemoteChannel);
+        string remoteChannel;
+        const uint32_t sharedRingSize = RPC::CommunicatorClient::Transport(options.RemoteChannel, remoteChannel);
+        Core::NodeId remoteNode(remoteChannel.c_str());
 
         TRACE_L1("Opening a message file with ID: [%d].", options.Exchange);
 
@@ -711,7 +714,7 @@ int main(int argc, char** argv)
                 Core::ProcessCurrent().User(string(options.User));
             }
 
-            process.Startup(options.Threads, remoteNode, callsign);
+            process.Startup(options.Threads, remoteNode, sharedRingSize, callsign);
 
             // Register an interface to handle incoming requests for interfaces.
             if ((base = Process::AcquireInterfaces(options)) != nullptr) {
@@ -56,3 +56,11 @@ uint32_t WakeupProcess(const uint32_t timeout, const pid_t pid, const char data_
 
     return HIBERNATE_ERROR_NONE;
 }
+
+void ReleaseStorage(void** storage)
+{
+    assert(storage != NULL);
+
+    free(*storage);
+    *storage = NULL;
+}
@@ -195,3 +195,7 @@ uint32_t WakeupProcess(const uint32_t timeout, const pid_t pid, const char data_
     LOGERR("Error Wakeup process PID %d ret %d", pid, resp.respCode);
     return HIBERNATE_ERROR_GENERAL;
 }
+
+void ReleaseStorage(void** storage __attribute__((unused)))
+{
+}
@@ -32,6 +32,8 @@ extern "C" {
 
 uint32_t HibernateProcess(const uint32_t timeout, const pid_t pid, const char data_dir[], const char volatile_dir[], void** storage);
 uint32_t WakeupProcess(const uint32_t timeout, const pid_t pid, const char data_dir[], const char volatile_dir[], void** storage);
+// Frees whatever HibernateProcess/WakeupProcess kept in storage, called once the processes are gone.
+void ReleaseStorage(void** storage);
 
 #ifdef __cplusplus
 } 
@@ -0,0 +1,1278 @@
+/*
+ * If not stated otherwise in this file or this component's LICENSE file the
+ * following copyright and licenses apply:
+ *
+ * Copyright 2020 Metrological
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#define MODULE "PageStore"
+
+#ifndef _GNU_SOURCE
+#define _GNU_SOURCE
+#endif
+
+#include "../common/Log.h"
+#include "../hibernate.h"
+
+#include <assert.h>
+#include <dirent.h>
+#include <elf.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <limits.h>
+#include <signal.h>
+#include <stdbool.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/ptrace.h>
+#include <sys/stat.h>
+#include <sys/syscall.h>
+#include <sys/uio.h>
+#include <sys/user.h>
+#include <sys/wait.h>
+#include <time.h>
+#include <unistd.h>
+
+#ifdef HIBERNATE_LZ4
+#include <lz4.h>
+#endif
+
+// In-tree checkpoint engine. On hibernate the process is frozen, all private
+// writable pages are written to a page store under the volatile path and then
+// dropped from the process with an injected madvise(MADV_DONTNEED). On wakeup
+// the stored pages are written back and the process is continued.
+//
+// The store is kept between cycles: pages the kernel reports as clean (soft-dirty
+// bit cleared since the last wakeup) are not even read, pages that are read but
+// hash to the same content keep their slot, so only changed pages are written.
+//
+// Files, per process:
+//   <volatile>/hibernate.<pid>.index  IndexHeader followed by PageEntry[count]
+//   <volatile>/hibernate.<pid>.pages  page slots, raw or LZ4 compressed
+
+#define PAGEMAP_SOFT_DIRTY      (1ULL << 55)
+#define PAGEMAP_FILE            (1ULL << 61)
+#define PAGEMAP_SWAPPED         (1ULL << 62)
+#define PAGEMAP_PRESENT         (1ULL << 63)
+
+#define INDEX_MAGIC             0x53475048 /* "HPGS" */
+#define INDEX_VERSION           1
+#define INDEX_COMPRESSED        0x0001
+
+#define BATCH_PAGES             256
+#define PAGEMAP_ENTRIES         512
+#define SLOT_ALIGNMENT          64
+#define SLOT_SEARCH             32
+
+#define ERESTARTSYS             512
+#define ERESTARTNOINTR          513
+#define ERESTARTNOHAND          514
+#define ERESTART_RESTARTBLOCK   516
+
+typedef struct {
+    uint32_t magic;
+    uint16_t version;
+    uint16_t flags;
+    uint32_t pageSize;
+    uint32_t count;
+    uint32_t generation;
+    int32_t pid;
+} __attribute__((packed)) IndexHeader;
+
+typedef struct {
+    uint64_t address;
+    uint64_t offset;
+    uint64_t checksum;
+    uint32_t length; // 0: zero page, pageSize: raw, otherwise compressed
+    uint32_t capacity;
+} PageEntry;
+
+typedef struct {
+    uint64_t offset;
+    uint32_t capacity;
+} Slot;
+
+typedef struct {
+    uint64_t start;
+    uint64_t end;
+    bool anonymous;
+    bool complete;
+    bool stored;
+} Region;
+
+typedef struct {
+    pid_t* tids;
+    uint32_t count;
+    uint32_t size;
+} Tracee;
+
+typedef struct {
+    uint32_t pages;
+    uint32_t clean;
+    uint32_t unchanged;
+    uint32_t written;
+    uint32_t dropped;
+} Statistics;
+
+typedef struct PageStore {
+    struct PageStore* next;
+    pid_t pid;
+    bool hibernated;
+    bool tracking;
+    uint32_t generation;
+    PageEntry* entries;
+    uint32_t count;
+    Slot* slots;
+    uint32_t slotCount;
+    uint32_t slotSize;
+    uint64_t end;
+    char indexFile[PATH_MAX];
+    char pageFile[PATH_MAX];
+} PageStore;
+
+static bool Grow(void** array, uint32_t* size, const uint32_t needed, const size_t element)
+{
+    bool result = true;
+
+    if (needed > *size) {
+        uint32_t newSize = (*size == 0 ? 64 : *size);
+        while (newSize < needed) {
+            newSize *= 2;
+        }
+        void* grown = realloc(*array, newSize * element);
+        if (grown == NULL) {
+            result = false;
+        } else {
+            *array = grown;
+            *size = newSize;
+        }
+    }
+
+    return (result);
+}
+
+static bool Expired(const struct timespec* deadline)
+{
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return ((now.tv_sec > deadline->tv_sec) || ((now.tv_sec == deadline->tv_sec) && (now.tv_nsec >= deadline->tv_nsec)));
+}
+
+static uint64_t Checksum(const uint8_t* page, const uint32_t pageSize, bool* zero)
+{
+    // FNV-1a over 64 bit words, good enough to detect a changed page.
+    const uint64_t* words = (const uint64_t*)page;
+    uint64_t hash = 0xcbf29ce484222325ULL;
+    uint64_t any = 0;
+
+    for (uint32_t index = 0; index < (pageSize / sizeof(uint64_t)); index++) {
+        any |= words[index];
+        hash = (hash ^ words[index]) * 0x100000001b3ULL;
+    }
+
+    *zero = (any == 0);
+    return (hash);
+}
+
+static bool SoftDirtySupported(void)
+{
+    static int supported = -1;
+
+    if (supported < 0) {
+        const long pageSize = sysconf(_SC_PAGESIZE);
+        volatile uint8_t* probe = (volatile uint8_t*)mmap(NULL, pageSize, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+        uint64_t entry = 0;
+
+        supported = 0;
+
+        if (probe != MAP_FAILED) {
+            int fd = open("/proc/self/pagemap", O_RDONLY | O_CLOEXEC);
+            probe[0] = 1;
+            if (fd >= 0) {
+                if (pread(fd, &entry, sizeof(entry), ((uintptr_t)probe / pageSize) * sizeof(entry)) == sizeof(entry)) {
+                    supported = ((entry & PAGEMAP_SOFT_DIRTY) != 0 ? 1 : 0);
+                }
+                close(fd);
+            }
+            munmap((void*)probe, pageSize);
+        }
+
+        LOGINFO("Soft-dirty page tracking %s", (supported == 1 ? "available" : "unavailable, comparing page checksums"));
+    }
+
+    return (supported == 1);
+}
+
+static bool ClearSoftDirty(const pid_t pid)
+{
+    bool result = false;
+    char path[64];
+
+    snprintf(path, sizeof(path), "/proc/%d/clear_refs", pid);
+
+    int fd = open(path, O_WRONLY | O_CLOEXEC);
+    if (fd >= 0) {
+        result = (write(fd, "4", 1) == 1);
+        close(fd);
+    }
+
+    return (result);
+}
+
+// ---------------------------------------------------------------------------
+// Freezing the process and calling madvise on its behalf
+// ---------------------------------------------------------------------------
+
+#if defined(__x86_64__)
+
+typedef struct user_regs_struct Registers;
+
+static bool GetRegisters(const pid_t tid, Registers* regs)
+{
+    return (ptrace(PTRACE_GETREGS, tid, NULL, regs) == 0);
+}
+static bool SetRegisters(const pid_t tid, const Registers* regs)
+{
+    return (ptrace(PTRACE_SETREGS, tid, NULL, regs) == 0);
+}
+static unsigned long ProgramCounter(const Registers* regs)
+{
+    return (regs->rip);
+}
+static unsigned long Instruction(const Registers* regs __attribute__((unused)), const unsigned long original)
+{
+    return ((original & ~0xFFFFUL) | 0x050FUL); // syscall
+}
+static void Restartable(Registers* regs)
+{
+    // x86 applies the syscall restart on the way out of the stop, so when the
+    // thread was frozen inside a syscall, do it here before it is overwritten.
+    if ((long)regs->orig_rax >= 0) {
+        const long error = -(long)regs->rax;
+        if ((error == ERESTARTSYS) || (error == ERESTARTNOINTR) || (error == ERESTARTNOHAND)) {
+            regs->rax = regs->orig_rax;
+            regs->rip -= 2;
+        } else if (error == ERESTART_RESTARTBLOCK) {
+            regs->rax = __NR_restart_syscall;
+            regs->rip -= 2;
+        }
+    }
+    regs->orig_rax = (unsigned long)-1;
+}
+static void Prepare(Registers* regs, const long nr, const long args[6])
+{
+    regs->rax = nr;
+    regs->rdi = args[0];
+    regs->rsi = args[1];
+    regs->rdx = args[2];
+    regs->r10 = args[3];
+    regs->r8 = args[4];
+    regs->r9 = args[5];
+}
+static long Result(const Registers* regs)
+{
+    return ((long)regs->rax);
+}
+
+#elif defined(__aarch64__)
+
+typedef struct user_regs_struct Registers;
+
+static bool GetRegisters(const pid_t tid, Registers* regs)
+{
+    struct iovec iov = { regs, sizeof(*regs) };
+    return (ptrace(PTRACE_GETREGSET, tid, (void*)NT_PRSTATUS, &iov) == 0);
+}
+static bool SetRegisters(const pid_t tid, const Registers* regs)
+{
+    struct iovec iov = { (void*)regs, sizeof(*regs) };
+    return (ptrace(PTRACE_SETREGSET, tid, (void*)NT_PRSTATUS, &iov) == 0);
+}
+static unsigned long ProgramCounter(const Registers* regs)
+{
+    return (regs->pc);
+}
+static unsigned long Instruction(const Registers* regs __attribute__((unused)), const unsigned long original)
+{
+    return ((original & ~0xFFFFFFFFUL) | 0xD4000001UL); // svc #0
+}
+static void Restartable(Registers* regs __attribute__((unused)))
+{
+    // arm64 rewinds an interrupted syscall before entering the stop.
+}
+static void Prepare(Registers* regs, const long nr, const long args[6])
+{
+    regs->regs[8] = nr;
+    for (uint8_t index = 0; index < 6; index++) {
+        regs->regs[index] = args[index];
+    }
+}
+static long Result(const Registers* regs)
+{
+    return ((long)regs->regs[0]);
+}
+
+#elif defined(__arm__)
+
+typedef struct user_regs Registers;
+
+static bool GetRegisters(const pid_t tid, Registers* regs)
+{
+    return (ptrace(PTRACE_GETREGS, tid, NULL, regs) == 0);
+}
+static bool SetRegisters(const pid_t tid, const Registers* regs)
+{
+    return (ptrace(PTRACE_SETREGS, tid, NULL, regs) == 0);
+}
+static unsigned long ProgramCounter(const Registers* regs)
+{
+    return (regs->uregs[15]);
+}
+static unsigned long Instruction(const Registers* regs, const unsigned long original)
+{
+    // svc #0, Thumb or ARM encoding depending on the current state.
+    return ((regs->uregs[16] & 0x20) != 0 ? ((original & ~0xFFFFUL) | 0xDF00UL) : 0xEF000000UL);
+}
+static void Restartable(Registers* regs __attribute__((unused)))
+{
+    // arm rewinds an interrupted syscall before entering the stop.
+}
+static void Prepare(Registers* regs, const long nr, const long args[6])
+{
+    regs->uregs[7] = nr;
+    for (uint8_t index = 0; index < 6; index++) {
+        regs->uregs[index] = args[index];
+    }
+}
+static long Result(const Registers* regs)
+{
+    return ((long)regs->uregs[0]);
+}
+
+#endif
+
+#if defined(__x86_64__) || defined(__aarch64__) || defined(__arm__)
+#define REMOTE_SYSCALL_SUPPORTED 1
+#endif
+
+static uint32_t WaitStop(Tracee* tracee, const uint32_t index, const struct timespec* deadline)
+{
+    uint32_t result = HIBERNATE_ERROR_GENERAL;
+    const pid_t tid = tracee->tids[index];
+    const struct timespec interval = { 0, 1000000 };
+    bool waiting = true;
+    int status = 0;
+
+    while (waiting == true) {
+        pid_t ret = waitpid(tid, &status, __WALL | WNOHANG);
+
+        if (ret == tid) {
+            if (WIFSTOPPED(status) == false) {
+                // Thread left while we were freezing it.
+                tracee->tids[index] = 0;
+                result = HIBERNATE_ERROR_NONE;
+                waiting = false;
+            } else if ((status >> 16) == PTRACE_EVENT_STOP) {
+                result = HIBERNATE_ERROR_NONE;
+                waiting = false;
+            } else {
+                // Signal delivery stop, hand the signal over, the interrupt is still pending.
+                ptrace(PTRACE_CONT, tid, NULL, (void*)(long)WSTOPSIG(status));
+            }
+        } else if ((ret < 0) && (errno != EINTR)) {
+            LOGERR("Waiting for thread %d failed, errno %d", tid, errno);
+            waiting = false;
+        } else if (Expired(deadline) == true) {
+            result = HIBERNATE_ERROR_TIMEOUT;
+            waiting = false;
+        } else if (ret == 0) {
+            nanosleep(&interval, NULL);
+        }
+    }
+
+    return (result);
+}
+
+static bool Listed(const Tracee* tracee, const pid_t tid)
+{
+    uint32_t index = 0;
+    while ((index < tracee->count) && (tracee->tids[index] != tid)) {
+        index++;
+    }
+    return (index < tracee->count);
+}
+
+static uint32_t Freeze(Tracee* tracee, const pid_t pid, const struct timespec* deadline)
+{
+    uint32_t result = HIBERNATE_ERROR_NONE;
+    bool added = true;
+    char path[64];
+
+    snprintf(path, sizeof(path), "/proc/%d/task", pid);
+
+    // Threads can be created until all are stopped, so rescan until nothing new shows up.
+    while ((added == true) && (result == HIBERNATE_ERROR_NONE)) {
+        DIR* dir = opendir(path);
+        struct dirent* entry;
+
+        added = false;
+
+        if (dir == NULL) {
+            LOGERR("Unable to list threads of PID %d, errno %d", pid, errno);
+            result = HIBERNATE_ERROR_GENERAL;
+        } else {
+            while ((result == HIBERNATE_ERROR_NONE) && ((entry = readdir(dir)) != NULL)) {
+                const pid_t tid = (pid_t)atoi(entry->d_name);
+
+                if ((tid > 0) && (Listed(tracee, tid) == false)) {
+                    if (ptrace(PTRACE_SEIZE, tid, NULL, (void*)PTRACE_O_TRACESYSGOOD) != 0) {
+                        if (errno != ESRCH) {
+                            LOGERR("Unable to attach to thread %d, errno %d", tid, errno);
+                            result = HIBERNATE_ERROR_GENERAL;
+                        }
+                    } else if (Grow((void**)&tracee->tids, &tracee->size, tracee->count + 1, sizeof(pid_t)) == false) {
+                        ptrace(PTRACE_DETACH, tid, NULL, NULL);
+                        result = HIBERNATE_ERROR_GENERAL;
+                    } else {
+                        tracee->tids[tracee->count++] = tid;
+                        ptrace(PTRACE_INTERRUPT, tid, NULL, NULL);
+                        result = WaitStop(tracee, tracee->count - 1, deadline);
+                        added = true;
+                    }
+                }
+            }
+            closedir(dir);
+        }
+    }
+
+    if ((result == HIBERNATE_ERROR_NONE) && ((tracee->count == 0) || (tracee->tids[0] != pid))) {
+        LOGERR("Main thread of PID %d not frozen", pid);
+        result = HIBERNATE_ERROR_GENERAL;
+    }
+
+    return (result);
+}
+
+static void Thaw(Tracee* tracee, const pid_t pid, const bool stopped)
+{
+    if (stopped == true) {
+        // Queued while all threads are in the ptrace stop, so after the detach
+        // they go straight into the group stop without running user code.
+        kill(pid, SIGSTOP);
+    }
+
+    for (uint32_t index = 0; index < tracee->count; index++) {
+        if (tracee->tids[index] != 0) {
+            ptrace(PTRACE_DETACH, tracee->tids[index], NULL, NULL);
+        }
+    }
+
+    free(tracee->tids);
+    tracee->tids = NULL;
+    tracee->count = 0;
+    tracee->size = 0;
+}
+
+#ifdef REMOTE_SYSCALL_SUPPORTED
+static bool SyscallStop(const pid_t tid, int* signal)
+{
+    bool result = false;
+    bool waiting = (ptrace(PTRACE_SYSCALL, tid, NULL, NULL) == 0);
+    int status = 0;
+
+    while (waiting == true) {
+        if (waitpid(tid, &status, __WALL) != tid) {
+            waiting = (errno == EINTR);
+        } else if (WIFSTOPPED(status) == false) {
+            waiting = false;
+        } else if (WSTOPSIG(status) == (SIGTRAP | 0x80)) {
+            result = true;
+            waiting = false;
+        } else {
+            // A signal for the process picked this thread, requeue it once we are done.
+            *signal = WSTOPSIG(status);
+            waiting = (ptrace(PTRACE_SYSCALL, tid, NULL, NULL) == 0);
+        }
+    }
+
+    return (result);
+}
+#endif
+
+static bool RemoteSyscall(const pid_t pid, const long nr, const long args[6], long* result)
+{
+    bool succeeded = false;
+
+#ifdef REMOTE_SYSCALL_SUPPORTED
+    Registers saved, call;
+
+    if (GetRegisters(pid, &saved) == true) {
+        const unsigned long pc = ProgramCounter(&saved);
+        int signal = 0;
+
+        errno = 0;
+        const long original = ptrace(PTRACE_PEEKTEXT, pid, (void*)pc, NULL);
+
+        if ((errno == 0) && (ptrace(PTRACE_POKETEXT, pid, (void*)pc, (void*)Instruction(&saved, (unsigned long)original)) == 0)) {
+            Restartable(&saved);
+            call = saved;
+            Prepare(&call, nr, args);
+
+            if ((SetRegisters(pid, &call) == true) && (SyscallStop(pid, &signal) == true) && (SyscallStop(pid, &signal) == true) && (GetRegisters(pid, &call) == true)) {
+                *result = Result(&call);
+                succeeded = true;
+            }
+
+            ptrace(PTRACE_POKETEXT, pid, (void*)pc, (void*)original);
+            SetRegisters(pid, &saved);
+
+            if (signal != 0) {
+                syscall(SYS_tgkill, pid, pid, signal);
+            }
+        }
+    }
+#else
+    (void)pid;
+    (void)nr;
+    (void)args;
+    (void)result;
+#endif
+
+    return (succeeded);
+}
+
+// ---------------------------------------------------------------------------
+// Page store
+// ---------------------------------------------------------------------------
+
+static Region* Regions(const pid_t pid, uint32_t* count)
+{
+    Region* regions = NULL;
+    uint32_t size = 0;
+    char path[64];
+    char line[PATH_MAX + 128];
+
+    snprintf(path, sizeof(path), "/proc/%d/maps", pid);
+
+    FILE* maps = fopen(path, "re");
+
+    *count = 0;
+
+    if (maps != NULL) {
+        bool failed = false;
+
+        while ((failed == false) && (fgets(line, sizeof(line), maps) != NULL)) {
+            unsigned long long start, end, inode;
+            char permissions[5];
+            int name = 0;
+
+            if ((sscanf(line, "%llx-%llx %4s %*s %*s %llu %n", &start, &end, permissions, &inode, &name) >= 4) && (permissions[1] == 'w') && (permissions[3] == 'p') && (strncmp(&line[name], "[v", 2) != 0)) {
+                if (Grow((void**)&regions, &size, *count + 1, sizeof(Region)) == false) {
+                    failed = true;
+                } else {
+                    regions[*count].start = start;
+                    regions[*count].end = end;
+                    regions[*count].anonymous = (inode == 0);
+                    regions[*count].complete = true;
+                    regions[*count].stored = false;
+                    (*count)++;
+                }
+            }
+        }
+        fclose(maps);
+
+        if ((failed == true) || (regions == NULL)) {
+            free(regions);
+            regions = NULL;
+        }
+    }
+
+    return (regions);
+}
+
+static bool Allocate(PageStore* store, const uint32_t length, uint64_t* offset, uint32_t* capacity)
+{
+    bool append = true;
+
+    if (length != 0) {
+        // Recent slots first, with raw pages any free slot fits.
+        uint32_t searched = 0;
+        uint32_t index = store->slotCount;
+
+        while ((append == true) && (index > 0) && (searched < SLOT_SEARCH)) {
+            index--;
+            searched++;
+            if (store->slots[index].capacity >= length) {
+                *offset = store->slots[index].offset;
+                *capacity = store->slots[index].capacity;
+                store->slots[index] = store->slots[--store->slotCount];
+                append = false;
+            }
+        }
+    } else {
+        *offset = 0;
+        *capacity = 0;
+        append = false;
+    }
+
+    return (append);
+}
+
+static void Release(PageStore* store, const PageEntry* entry)
+{
+    if ((entry->capacity != 0) && (Grow((void**)&store->slots, &store->slotSize, store->slotCount + 1, sizeof(Slot)) == true)) {
+        store->slots[store->slotCount].offset = entry->offset;
+        store->slots[store->slotCount].capacity = entry->capacity;
+        store->slotCount++;
+    }
+}
+
+typedef struct {
+    PageStore* store;
+    int pages;
+    uint32_t pageSize;
+    PageEntry* entries;
+    uint32_t count;
+    uint32_t size;
+    uint32_t cursor;
+    uint8_t* staging;
+    uint32_t staged;
+    uint64_t stagingOffset;
+#ifdef HIBERNATE_LZ4
+    char* packed;
+#endif
+} Checkpoint;
+
+static const PageEntry* Previous(Checkpoint* cp, const uint64_t address)
+{
+    const PageEntry* result = NULL;
+    PageStore* store = cp->store;
+
+    // Both the old index and the walk are in address order, anything skipped is gone.
+    while ((cp->cursor < store->count) && (store->entries[cp->cursor].address < address)) {
+        Release(store, &store->entries[cp->cursor]);
+        cp->cursor++;
+    }
+    if ((cp->cursor < store->count) && (store->entries[cp->cursor].address == address)) {
+        result = &store->entries[cp->cursor];
+        cp->cursor++;
+    }
+
+    return (result);
+}
+
+static bool Flush(Checkpoint* cp)
+{
+    bool result = true;
+
+    if (cp->staged > 0) {
+        result = (pwrite(cp->pages, cp->staging, cp->staged, cp->stagingOffset) == (ssize_t)cp->staged);
+        cp->staged = 0;
+    }
+
+    return (result);
+}
+
+static bool Keep(Checkpoint* cp, const PageEntry* entry)
+{
+    bool result = Grow((void**)&cp->entries, &cp->size, cp->count + 1, sizeof(PageEntry));
+    if (result == true) {
+        cp->entries[cp->count++] = *entry;
+    }
+    return (result);
+}
+
+static bool Store(Checkpoint* cp, const Region* region, const uint64_t address, const PageEntry* previous, const uint8_t* page, Statistics* stats)
+{
+    PageStore* store = cp->store;
+    bool zero = false;
+    PageEntry entry;
+    bool result = true;
+
+    entry.address = address;
+    entry.checksum = Checksum(page, cp->pageSize, &zero);
+
+    if ((zero == true) && (region->anonymous == true)) {
+        // Dropped anonymous memory reads back as zero, nothing to store or restore.
+        if (previous != NULL) {
+            Release(store, previous);
+        }
+        stats->unchanged++;
+    } else if ((previous != NULL) && (previous->checksum == entry.checksum)) {
+        stats->unchanged++;
+        result = Keep(cp, previous);
+    } else {
+        const uint8_t* data = page;
+
+        entry.length = (zero == true ? 0 : cp->pageSize);
+
+#ifdef HIBERNATE_LZ4
+        if (zero == false) {
+            const int packed = LZ4_compress_default((const char*)page, cp->packed, (int)cp->pageSize, LZ4_compressBound((int)cp->pageSize));
+            if ((packed > 0) && ((uint32_t)packed < cp->pageSize)) {
+                entry.length = (uint32_t)packed;
+                data = (const uint8_t*)cp->packed;
+            }
+        }
+#endif
+
+        if ((previous != NULL) && (entry.length <= previous->capacity)) {
+            entry.offset = previous->offset;
+            entry.capacity = previous->capacity;
+        } else {
+            if (previous != NULL) {
+                Release(store, previous);
+            }
+            if (Allocate(store, entry.length, &entry.offset, &entry.capacity) == true) {
+                entry.capacity = (entry.length + (SLOT_ALIGNMENT - 1)) & ~(SLOT_ALIGNMENT - 1);
+                if (entry.capacity > cp->pageSize) {
+                    entry.capacity = cp->pageSize;
+                }
+                if ((cp->staged + entry.capacity) > (BATCH_PAGES * cp->pageSize)) {
+                    result = Flush(cp);
+                }
+                if (cp->staged == 0) {
+                    cp->stagingOffset = store->end;
+                }
+                entry.offset = store->end;
+                store->end += entry.capacity;
+                memcpy(&cp->staging[cp->staged], data, entry.length);
+                cp->staged += entry.capacity;
+                data = NULL;
+            }
+        }
+
+        if ((data != NULL) && (entry.length > 0)) {
+            result = (pwrite(cp->pages, data, entry.length, entry.offset) == (ssize_t)entry.length);
+        }
+
+        if (result == true) {
+            stats->written++;
+            result = Keep(cp, &entry);
+        }
+    }
+
+    return (result);
+}
+
+static uint32_t Collect(Checkpoint* cp, const pid_t pid, Region* region, const uint64_t* addresses, const PageEntry* const* previous, const uint32_t count, uint8_t* buffer, Statistics* stats)
+{
+    uint32_t result = HIBERNATE_ERROR_NONE;
+    struct iovec local = { buffer, count * cp->pageSize };
+    struct iovec remote[BATCH_PAGES] = { { NULL, 0 } };
+    uint32_t ranges = 0;
+
+    for (uint32_t index = 0; index < count; index++) {
+        if ((ranges > 0) && (((uint64_t)(uintptr_t)remote[ranges - 1].iov_base + remote[ranges - 1].iov_len) == addresses[index])) {
+            remote[ranges - 1].iov_len += cp->pageSize;
+        } else {
+            remote[ranges].iov_base = (void*)(uintptr_t)addresses[index];
+            remote[ranges].iov_len = cp->pageSize;
+            ranges++;
+        }
+    }
+
+    ssize_t loaded = process_vm_readv(pid, &local, 1, remote, ranges, 0);
+    uint32_t available = (loaded > 0 ? (uint32_t)(loaded / cp->pageSize) : 0);
+
+    if (available < count) {
+        // Whatever could not be read stays in the process, it must not be dropped.
+        region->complete = false;
+    }
+
+    for (uint32_t index = 0; (index < available) && (result == HIBERNATE_ERROR_NONE); index++) {
+        if (Store(cp, region, addresses[index], previous[index], &buffer[index * cp->pageSize], stats) == false) {
+            LOGERR("Writing page store %s failed, errno %d", cp->store->pageFile, errno);
+            result = HIBERNATE_ERROR_GENERAL;
+        }
+    }
+    for (uint32_t index = available; index < count; index++) {
+        if (previous[index] != NULL) {
+            Release(cp->store, previous[index]);
+        }
+    }
+
+    return (result);
+}
+
+static uint32_t Capture(PageStore* store, const pid_t pid, Region* regions, const uint32_t regionCount, const struct timespec* deadline, Statistics* stats)
+{
+    uint32_t result = HIBERNATE_ERROR_NONE;
+    const bool softDirty = ((store->tracking == true) && (SoftDirtySupported() == true));
+    Checkpoint cp;
+    char path[64];
+
+    memset(&cp, 0, sizeof(cp));
+    cp.store = store;
+    cp.pageSize = (uint32_t)sysconf(_SC_PAGESIZE);
+
+    snprintf(path, sizeof(path), "/proc/%d/pagemap", pid);
+
+    int pagemap = open(path, O_RDONLY | O_CLOEXEC);
+    cp.pages = open(store->pageFile, O_RDWR | O_CREAT | O_CLOEXEC, 0600);
+    cp.staging = (uint8_t*)malloc(BATCH_PAGES * cp.pageSize);
+    uint8_t* buffer = (uint8_t*)malloc(BATCH_PAGES * cp.pageSize);
+    uint64_t* map = (uint64_t*)malloc(PAGEMAP_ENTRIES * sizeof(uint64_t));
+#ifdef HIBERNATE_LZ4
+    cp.packed = (char*)malloc(LZ4_compressBound((int)cp.pageSize));
+#endif
+
+    if ((pagemap < 0) || (cp.pages < 0) || (cp.staging == NULL) || (buffer == NULL) || (map == NULL)
+#ifdef HIBERNATE_LZ4
+        || (cp.packed == NULL)
+#endif
+    ) {
+        LOGERR("Unable to set up checkpoint of PID %d, errno %d", pid, errno);
+        result = HIBERNATE_ERROR_GENERAL;
+    }
+
+    for (uint32_t r = 0; (r < regionCount) && (result == HIBERNATE_ERROR_NONE); r++) {
+        Region* region = &regions[r];
+        const uint32_t first = cp.count;
+        uint64_t addresses[BATCH_PAGES];
+        const PageEntry* previous[BATCH_PAGES];
+        uint32_t pending = 0;
+        uint64_t address = region->start;
+
+        while ((address < region->end) && (result == HIBERNATE_ERROR_NONE)) {
+            uint64_t pages = (region->end - address) / cp.pageSize;
+            if (pages > PAGEMAP_ENTRIES) {
+                pages = PAGEMAP_ENTRIES;
+            }
+
+            ssize_t loaded = pread(pagemap, map, pages * sizeof(uint64_t), (address / cp.pageSize) * sizeof(uint64_t));
+            if (loaded != (ssize_t)(pages * sizeof(uint64_t))) {
+                LOGERR("Reading pagemap of PID %d failed, errno %d", pid, errno);
+                result = HIBERNATE_ERROR_GENERAL;
+            }
+
+            for (uint64_t index = 0; (index < pages) && (result == HIBERNATE_ERROR_NONE); index++, address += cp.pageSize) {
+                const uint64_t entry = map[index];
+
+                // Only anonymous content needs saving, clean file pages come back from their file.
+                if (((entry & (PAGEMAP_PRESENT | PAGEMAP_SWAPPED)) != 0) && ((entry & PAGEMAP_FILE) == 0)) {
+                    const PageEntry* old = Previous(&cp, address);
+
+                    stats->pages++;
+
+                    if ((softDirty == true) && (old != NULL) && ((entry & PAGEMAP_SOFT_DIRTY) == 0)) {
+                        stats->clean++;
+                        if (Keep(&cp, old) == false) {
+                            result = HIBERNATE_ERROR_GENERAL;
+                        }
+                    } else {
+                        addresses[pending] = address;
+                        previous[pending] = old;
+                        if (++pending == BATCH_PAGES) {
+                            result = Collect(&cp, pid, region, addresses, previous, pending, buffer, stats);
+                            pending = 0;
+                        }
+                    }
+                }
+            }
+
+            if ((result == HIBERNATE_ERROR_NONE) && (Expired(deadline) == true)) {
+                result = HIBERNATE_ERROR_TIMEOUT;
+            }
+        }
+
+        if ((pending > 0) && (result == HIBERNATE_ERROR_NONE)) {
+            result = Collect(&cp, pid, region, addresses, previous, pending, buffer, stats);
+        }
+
+        region->stored = (cp.count > first);
+    }
+
+    if (result == HIBERNATE_ERROR_NONE) {
+        // Whatever is left in the old index is no longer mapped.
+        Previous(&cp, UINT64_MAX);
+
+        if ((Flush(&cp) == false) || (fdatasync(cp.pages) != 0)) {
+            LOGERR("Writing page store %s failed, errno %d", store->pageFile, errno);
+            result = HIBERNATE_ERROR_GENERAL;
+        }
+    }
+
+    if (result == HIBERNATE_ERROR_NONE) {
+        free(store->entries);
+        store->entries = cp.entries;
+        store->count = cp.count;
+    } else {
+        // The on-disk slots can no longer be trusted, start over next time.
+        free(cp.entries);
+        free(store->entries);
+        store->entries = NULL;
+        store->count = 0;
+        store->slotCount = 0;
+        store->end = 0;
+        store->tracking = false;
+        if ((cp.pages >= 0) && (ftruncate(cp.pages, 0) != 0)) {
+            LOGERR("Unable to reset page store %s, errno %d", store->pageFile, errno);
+        }
+    }
+
+#ifdef HIBERNATE_LZ4
+    free(cp.packed);
+#endif
+    free(map);
+    free(buffer);
+    free(cp.staging);
+    if (cp.pages >= 0) {
+        close(cp.pages);
+    }
+    if (pagemap >= 0) {
+        close(pagemap);
+    }
+
+    return (result);
+}
+
+static bool WriteIndex(const PageStore* store)
+{
+    bool result = false;
+    char path[PATH_MAX + 4];
+    IndexHeader header;
+
+    header.magic = INDEX_MAGIC;
+    header.version = INDEX_VERSION;
+#ifdef HIBERNATE_LZ4
+    header.flags = INDEX_COMPRESSED;
+#else
+    header.flags = 0;
+#endif
+    header.pageSize = (uint32_t)sysconf(_SC_PAGESIZE);
+    header.count = store->count;
+    header.generation = store->generation;
+    header.pid = store->pid;
+
+    snprintf(path, sizeof(path), "%s.tmp", store->indexFile);
+
+    int fd = open(path, O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0600);
+    if (fd >= 0) {
+        const ssize_t size = (ssize_t)(store->count * sizeof(PageEntry));
+        result = ((write(fd, &header, sizeof(header)) == sizeof(header)) && (write(fd, store->entries, size) == size));
+        close(fd);
+        result = (result == true) && (rename(path, store->indexFile) == 0);
+    }
+
+    return (result);
+}
+
+static uint32_t Drop(const pid_t pid, const Region* regions, const uint32_t count, Statistics* stats)
+{
+    for (uint32_t index = 0; index < count; index++) {
+        if ((regions[index].complete == true) && (regions[index].stored == true)) {
+            const long args[6] = { (long)regions[index].start, (long)(regions[index].end - regions[index].start), MADV_DONTNEED, 0, 0, 0 };
+            long result = -1;
+
+            if (RemoteSyscall(pid, __NR_madvise, args, &result) == false) {
+                LOGERR("Unable to release memory of PID %d", pid);
+                break;
+            } else if (result == 0) {
+                stats->dropped += (uint32_t)((regions[index].end - regions[index].start) / sysconf(_SC_PAGESIZE));
+            }
+        }
+    }
+
+    // Pages that were not dropped are simply rewritten with identical content on wakeup.
+    return (HIBERNATE_ERROR_NONE);
+}
+
+static bool Push(const pid_t pid, struct iovec* local, struct iovec* remote, uint32_t* count)
+{
+    bool result = true;
+
+    if (*count > 0) {
+        size_t total = 0;
+        for (uint32_t index = 0; index < *count; index++) {
+            total += remote[index].iov_len;
+        }
+        result = (process_vm_writev(pid, local, *count, remote, *count, 0) == (ssize_t)total);
+        *count = 0;
+    }
+
+    return (result);
+}
+
+static uint32_t Restore(const PageStore* store, const pid_t pid)
+{
+    uint32_t result = HIBERNATE_ERROR_NONE;
+    const uint32_t pageSize = (uint32_t)sysconf(_SC_PAGESIZE);
+    struct iovec local[BATCH_PAGES];
+    struct iovec remote[BATCH_PAGES];
+    uint32_t count = 0;
+    uint32_t unpacked = 0;
+    uint8_t* mapped = MAP_FAILED;
+
+    int fd = open(store->pageFile, O_RDONLY | O_CLOEXEC);
+    uint8_t* zero = (uint8_t*)calloc(1, pageSize);
+    uint8_t* scratch = (uint8_t*)malloc(BATCH_PAGES * pageSize);
+
+    if ((fd >= 0) && (store->end > 0)) {
+        mapped = (uint8_t*)mmap(NULL, store->end, PROT_READ, MAP_PRIVATE, fd, 0);
+    }
+
+    if ((zero == NULL) || (scratch == NULL) || ((store->end > 0) && (mapped == MAP_FAILED))) {
+        LOGERR("Unable to open page store %s, errno %d", store->pageFile, errno);
+        result = HIBERNATE_ERROR_GENERAL;
+    } else {
+        madvise(mapped, store->end, MADV_SEQUENTIAL);
+    }
+
+    for (uint32_t index = 0; (index < store->count) && (result == HIBERNATE_ERROR_NONE); index++) {
+        const PageEntry* entry = &store->entries[index];
+        uint8_t* source;
+
+        if (entry->length == 0) {
+            source = zero;
+        } else if (entry->length == pageSize) {
+            source = &mapped[entry->offset];
+        } else {
+#ifdef HIBERNATE_LZ4
+            source = &scratch[unpacked * pageSize];
+            if (LZ4_decompress_safe((const char*)&mapped[entry->offset], (char*)source, (int)entry->length, (int)pageSize) != (int)pageSize) {
+                LOGERR("Corrupt page at %llx in %s", (unsigned long long)entry->address, store->pageFile);
+                result = HIBERNATE_ERROR_GENERAL;
+                break;
+            }
+            unpacked++;
+#else
+            LOGERR("Page store %s holds compressed pages", store->pageFile);
+            result = HIBERNATE_ERROR_GENERAL;
+            break;
+#endif
+        }
+
+        if ((count > 0) && (((uint8_t*)remote[count - 1].iov_base + remote[count - 1].iov_len) == (uint8_t*)(uintptr_t)entry->address) && (((uint8_t*)local[count - 1].iov_base + local[count - 1].iov_len) == source) && (source != zero)) {
+            local[count - 1].iov_len += pageSize;
+            remote[count - 1].iov_len += pageSize;
+        } else {
+            local[count].iov_base = source;
+            local[count].iov_len = pageSize;
+            remote[count].iov_base = (void*)(uintptr_t)entry->address;
+            remote[count].iov_len = pageSize;
+            count++;
+        }
+
+        if ((count == BATCH_PAGES) || (unpacked == BATCH_PAGES)) {
+            if (Push(pid, local, remote, &count) == false) {
+                LOGERR("Restoring memory of PID %d failed, errno %d", pid, errno);
+                result = HIBERNATE_ERROR_GENERAL;
+            }
+            unpacked = 0;
+        }
+    }
+
+    if ((result == HIBERNATE_ERROR_NONE) && (Push(pid, local, remote, &count) == false)) {
+        LOGERR("Restoring memory of PID %d failed, errno %d", pid, errno);
+        result = HIBERNATE_ERROR_GENERAL;
+    }
+
+    if (mapped != MAP_FAILED) {
+        munmap(mapped, store->end);
+    }
+    if (fd >= 0) {
+        close(fd);
+    }
+    free(scratch);
+    free(zero);
+
+    return (result);
+}
+
+// ---------------------------------------------------------------------------
+// Bookkeeping per process, all processes of a service share one storage
+// ---------------------------------------------------------------------------
+
+static PageStore* Find(void* storage, const pid_t pid)
+{
+    PageStore* store = (PageStore*)storage;
+    while ((store != NULL) && (store->pid != pid)) {
+        store = store->next;
+    }
+    return (store);
+}
+
+static void Destroy(PageStore* store)
+{
+    unlink(store->indexFile);
+    unlink(store->pageFile);
+    free(store->entries);
+    free(store->slots);
+    free(store);
+}
+
+static void Prune(void** storage)
+{
+    PageStore** link = (PageStore**)storage;
+
+    while (*link != NULL) {
+        PageStore* store = *link;
+        if ((kill(store->pid, 0) != 0) && (errno == ESRCH)) {
+            *link = store->next;
+            Destroy(store);
+        } else {
+            link = &store->next;
+        }
+    }
+}
+
+static PageStore* Create(void** storage, const pid_t pid, const char volatile_dir[])
+{
+    const char* directory = ((volatile_dir != NULL) && (volatile_dir[0] != '\0') ? volatile_dir : P_tmpdir);
+    const size_t length = strlen(directory);
+    const char* separator = ((length > 0) && (directory[length - 1] == '/') ? "" : "/");
+    PageStore* store = (PageStore*)calloc(1, sizeof(PageStore));
+
+    if (store != NULL) {
+        mkdir(directory, 0700);
+
+        store->pid = pid;
+        snprintf(store->indexFile, sizeof(store->indexFile), "%s%shibernate.%d.index", directory, separator, pid);
+        snprintf(store->pageFile, sizeof(store->pageFile), "%s%shibernate.%d.pages", directory, separator, pid);
+
+        // A store left behind by an earlier process with the same PID is useless.
+        unlink(store->indexFile);
+        unlink(store->pageFile);
+
+        store->next = (PageStore*)(*storage);
+        *storage = store;
+    }
+
+    return (store);
+}
+
+uint32_t HibernateProcess(const uint32_t timeout, const pid_t pid, const char data_dir[] __attribute__((unused)), const char volatile_dir[], void** storage)
+{
+    uint32_t result = HIBERNATE_ERROR_NONE;
+    Statistics stats;
+    struct timespec deadline;
+    Tracee tracee;
+
+    assert(storage != NULL);
+
+    memset(&stats, 0, sizeof(stats));
+    memset(&tracee, 0, sizeof(tracee));
+
+    clock_gettime(CLOCK_MONOTONIC, &deadline);
+    deadline.tv_sec += timeout / 1000;
+    deadline.tv_nsec += (timeout % 1000) * 1000000L;
+    if (deadline.tv_nsec >= 1000000000L) {
+        deadline.tv_sec++;
+        deadline.tv_nsec -= 1000000000L;
+    }
+
+    Prune(storage);
+
+    PageStore* store = Find(*storage, pid);
+
+    if (store == NULL) {
+        store = Create(storage, pid, volatile_dir);
+    }
+
+    if (store == NULL) {
+        LOGERR("Error Hibernate process PID %d, out of memory", pid);
+        result = HIBERNATE_ERROR_GENERAL;
+    } else if (store->hibernated == true) {
+        LOGINFO("Hibernate process PID %d, already hibernated", pid);
+    } else {
+        uint32_t regionCount = 0;
+        Region* regions = NULL;
+
+        result = Freeze(&tracee, pid, &deadline);
+
+        if (result == HIBERNATE_ERROR_NONE) {
+            regions = Regions(pid, &regionCount);
+            if (regions == NULL) {
+                LOGERR("Unable to read memory map of PID %d", pid);
+                result = HIBERNATE_ERROR_GENERAL;
+            }
+        }
+
+        if (result == HIBERNATE_ERROR_NONE) {
+            result = Capture(store, pid, regions, regionCount, &deadline, &stats);
+        }
+
+        if (result == HIBERNATE_ERROR_NONE) {
+            store->generation++;
+            if (WriteIndex(store) == false) {
+                LOGERR("Unable to write index %s, errno %d", store->indexFile, errno);
+                result = HIBERNATE_ERROR_GENERAL;
+            }
+        }
+
+        if (result == HIBERNATE_ERROR_NONE) {
+            result = Drop(pid, regions, regionCount, &stats);
+            store->hibernated = true;
+        }
+
+        Thaw(&tracee, pid, store->hibernated);
+        free(regions);
+
+        if (result == HIBERNATE_ERROR_NONE) {
+            LOGINFO("Hibernate process PID %d success, generation %u: %u pages, %u clean, %u unchanged, %u written, %u released",
+                pid, store->generation, stats.pages, stats.clean, stats.unchanged, stats.written, stats.dropped);
+        } else {
+            LOGERR("Error Hibernate process PID %d ret %u", pid, result);
+        }
+    }
+
+    return (result);
+}
+
+uint32_t WakeupProcess(const uint32_t timeout __attribute__((unused)), const pid_t pid, const char data_dir[] __attribute__((unused)), const char volatile_dir[] __attribute__((unused)), void** storage)
+{
+    uint32_t result = HIBERNATE_ERROR_NONE;
+
+    assert(storage != NULL);
+
+    Prune(storage);
+
+    PageStore* store = Find(*storage, pid);
+
+    if ((store == NULL) || (store->hibernated == false)) {
+        LOGINFO("Wakeup process PID %d, nothing to wakeup", pid);
+    } else {
+        // The process sits in a group stop, so its memory can be written without attaching.
+        result = Restore(store, pid);
+
+        if (result == HIBERNATE_ERROR_NONE) {
+            // Everything the process writes from here on shows up as soft-dirty.
+            store->tracking = ClearSoftDirty(pid);
+            store->hibernated = false;
+            kill(pid, SIGCONT);
+            LOGINFO("Wakeup process PID %d success, %u pages restored", pid, store->count);
+        } else {
+            LOGERR("Error Wakeup process PID %d ret %u", pid, result);
+        }
+    }
+
+    return (result);
+}
+
+void ReleaseStorage(void** storage)
+{
+    assert(storage != NULL);
+
+    PageStore* store = (PageStore*)(*storage);
+
+    while (store != NULL) {
+        PageStore* next = store->next;
+        Destroy(store);
+        store = next;
+    }
+
+    *storage = NULL;
+}
@@ -106,8 +106,12 @@ namespace ProcessContainers {
         uint64_t _totalUsage;
     };
 
-    // Helper Class to collect CGroup related metrics.
+    // Helper Class to collect CGroup related metrics, from either the legacy (v1) hierarchy or
+    // the unified (v2) hierarchy, whichever the system has mounted.
     class CGroupMetrics {
+    private:
+        static constexpr uint16_t StatSize = 4096;
+
     public:
         CGroupMetrics(const string& name)
             : _name(name)
@@ -117,58 +121,34 @@ namespace ProcessContainers {
         IMemoryInfo* Memory() const
         {
             CGroupMemoryInfo* result = new CGroupMemoryInfo;
+            const bool unified = IsUnified();
+            const string path = (unified == true ? "/sys/fs/cgroup/" : "/sys/fs/cgroup/memory/") + _name;
 
             // Load total allocated memory
-            string _memoryInfoPath = "/sys/fs/cgroup/memory/" + _name + "/memory.usage_in_bytes";
-
-            char buffer[2048];
-            auto fd = open(_memoryInfoPath.c_str(), O_RDONLY);
-
-            if (fd >= 0) {
-                size_t bytesRead = read(fd, buffer, sizeof(buffer));
-
-                if (bytesRead > 0) {
-                    result->Allocated(std::stoll(buffer));
-                }
+            Core::KernelFileType<32> usage(path + (unified == true ? "/memory.current" : "/memory.usage_in_bytes"));
 
-                close(fd);
+            if ((usage.Load() == true) && (usage.Length() > 0)) {
+                result->Allocated(usage.Content().Number());
             } else {
                 TRACE_L1("Cannot get memory information for container. Is device booted with memory cgroup enabled?");
             }
 
-            // Load details about memory
-            string memoryFullInfoPath = "/sys/fs/cgroup/memory/" + _name + "/memory.stat";
-
-            fd = open(memoryFullInfoPath.c_str(), O_RDONLY);
-            if (fd >= 0) {
-                size_t bytesRead = read(fd, buffer, sizeof(buffer));
-
-                if (bytesRead > 0) {
-                    char* tmp;
-                    char* token = strtok_r(buffer, " \n", &tmp);
-
-                    while (token != nullptr) {
-                        if (token == nullptr)
-                            break;
-
-                        char* label = token;
-
-                        token = strtok_r(NULL, " \n", &tmp);
-                        if (token == nullptr)
-                            break;
+            // Load details about memory, "<label> <value>" lines
+            const char* residentLabel = (unified == true ? "anon " : "rss ");
+            const char* sharedLabel = (unified == true ? "file_mapped " : "mapped_file ");
+            Core::KernelFileType<StatSize> details(path + "/memory.stat");
 
-                        uint64_t value = std::stoll(token);
+            if (details.Load() == true) {
+                Core::TextScanner scanner(details.Content());
 
-                        if (strcmp(label, "rss") == 0)
-                            result->Resident(value);
-                        else if (strcmp(label, "mapped_file") == 0)
-                            result->Shared(value);
-
-                        token = strtok_r(NULL, " \n", &tmp);
+                while (scanner.AtEnd() == false) {
+                    if (scanner.Match(residentLabel) == true) {
+                        result->Resident(scanner.Number());
+                    } else if (scanner.Match(sharedLabel) == true) {
+                        result->Shared(scanner.Number());
                     }
+                    scanner.SkipLine();
                 }
-
-                close(fd);
             } else {
                 TRACE_L1("Cannot get memory information for container. Is device booted with memory cgroup enabled?");
             }
@@ -180,40 +160,50 @@ namespace ProcessContainers {
         {
             std::vector<uint64_t> coresUsage;
 
-            // Load per-core cpu time
-            string cpuPerCoreUsagePath = "/sys/fs/cgroup/cpuacct/" + _name + "/cpuacct.usage_percpu";
-            auto fd = open(cpuPerCoreUsagePath.c_str(), O_RDONLY);
-            char buffer[2048];
+            if (IsUnified() == true) {
+                // The unified hierarchy does not account per core, report the total as a single
+                // core, converted to the nanoseconds cpuacct reports in.
+                Core::KernelFileType<StatSize> stat("/sys/fs/cgroup/" + _name + "/cpu.stat");
 
-            if (fd >= 0) {
-                uint32_t bytesRead = read(fd, buffer, sizeof(buffer));
+                if (stat.Load() == true) {
+                    Core::TextScanner scanner(stat.Content());
 
-                // In about 30% of cases we got additional number information after new line
-                for(uint32_t i = 0; buffer[i] != '\0'; i++) {
-                    if (buffer[i] == '\n') {
-                        buffer[i] = '\0';
+                    if (scanner.Line("usage_usec ") == true) {
+                        coresUsage.push_back(scanner.Number() * 1000);
                     }
                 }
+            } else {
+                // Load per-core cpu time
+                Core::KernelFileType<StatSize> usage("/sys/fs/cgroup/cpuacct/" + _name + "/cpuacct.usage_percpu");
 
-                if (bytesRead > 0) {
-                    char* tmp;
-                    char* token = strtok_r((char*)buffer, " ", &tmp);
+                if (usage.Load() == true) {
+                    Core::TextScanner scanner(usage.Content());
 
-                    while (token != nullptr) {
-                        // Sometimes (but not always for some reason?) a nonprintable character is caught as a separate token.
-                        if (isdigit(token[0])) {
-                            coresUsage.push_back(atoi(token));
+                    scanner.SkipSpaces();
+
+                    // One line with the usage per core, ignore anything that is not a number.
+                    while ((scanner.Peek() != '\0') && (scanner.Peek() != '\n')) {
+                        if (::isdigit(static_cast<unsigned char>(scanner.Peek())) != 0) {
+                            coresUsage.push_back(scanner.Number());
+                        } else {
+                            scanner.Character();
                         }
-                        token = strtok_r(NULL, " ", &tmp);
+                        scanner.SkipSpaces();
                     }
                 }
-
-                close(fd);
             }
 
             return new CGroupProcessorInfo(std::move(coresUsage));
         }
 
+    private:
+        static bool IsUnified()
+        {
+            static const bool unified = Core::File(string(_T("/sys/fs/cgroup/cgroup.controllers"))).Exists();
+
+            return (unified);
+        }
+
     private:
         string _name;
     };
@@ -26,12 +26,159 @@ namespace RPC {
 
     /* static */ const string Administrator::DanglingId("/Dangling");
 
+    static uint32_t Mix(uint32_t value)
+    {
+        value ^= (value >> 16);
+        value *= 0x45D9F3Bu;
+        value ^= (value >> 16);
+        return (value);
+    }
+
+    Administrator::InterfaceTable::InterfaceTable(const uint32_t capacity)
+        : _mask(capacity - 1)
+        , _count(0)
+        , _slots(new std::atomic<Interface*>[capacity])
+    {
+        ASSERT((capacity & _mask) == 0);
+
+        for (uint32_t index = 0; index < capacity; index++) {
+            _slots[index].store(nullptr, std::memory_order_relaxed);
+        }
+    }
+
+    Administrator::InterfaceTable::~InterfaceTable()
+    {
+        // The entries are owned by the Administrator, they move along to the next table.
+        delete[] _slots;
+    }
+
+    /* static */ uint32_t Administrator::InterfaceTable::Hash(const uint32_t id)
+    {
+        return (Mix(id));
+    }
+
+    Administrator::Interface* Administrator::InterfaceTable::Find(const uint32_t id) const
+    {
+        uint32_t slot = Hash(id) & _mask;
+        Interface* entry;
+
+        while (((entry = _slots[slot].load(std::memory_order_acquire)) != nullptr) && (entry->Id() != id)) {
+            slot = (slot + 1) & _mask;
+        }
+
+        return (entry);
+    }
+
+    void Administrator::InterfaceTable::Insert(Interface* entry)
+    {
+        ASSERT(entry != nullptr);
+        ASSERT(IsFull() == false);
+        ASSERT(Find(entry->Id()) == nullptr);
+
+        uint32_t slot = Hash(entry->Id()) & _mask;
+
+        while (_slots[slot].load(std::memory_order_relaxed) != nullptr) {
+            slot = (slot + 1) & _mask;
+        }
+
+        _count++;
+        _slots[slot].store(entry, std::memory_order_release);
+    }
+
+    Administrator::ProxyIndex::ProxyIndex()
+        : _count(0)
+        , _slots(64, Entry { 0, 0, 0, nullptr })
+    {
+    }
+
+    /* static */ uint32_t Administrator::ProxyIndex::Hash(const uint32_t channel, const Core::instance_id& implementation, const uint32_t id)
+    {
+        const uint64_t instance = static_cast<uint64_t>(implementation);
+
+        return (Mix(Mix(Mix(static_cast<uint32_t>(instance) ^ static_cast<uint32_t>(instance >> 32)) ^ id) ^ channel));
+    }
+
+    // The slot holding the key, or the empty slot where it belongs.
+    uint32_t Administrator::ProxyIndex::Slot(const uint32_t channel, const Core::instance_id& implementation, const uint32_t id) const
+    {
+        const uint32_t mask = static_cast<uint32_t>(_slots.size() - 1);
+        uint32_t slot = Hash(channel, implementation, id) & mask;
+
+        while ((_slots[slot].Proxy != nullptr) && ((_slots[slot].Channel != channel) || (_slots[slot].Implementation != implementation) || (_slots[slot].Id != id))) {
+            slot = (slot + 1) & mask;
+        }
+
+        return (slot);
+    }
+
+    ProxyStub::UnknownProxy* Administrator::ProxyIndex::Find(const uint32_t channel, const Core::instance_id& implementation, const uint32_t id) const
+    {
+        return (_slots[Slot(channel, implementation, id)].Proxy);
+    }
+
+    void Administrator::ProxyIndex::Insert(const uint32_t channel, ProxyStub::UnknownProxy* proxy)
+    {
+        ASSERT(proxy != nullptr);
+
+        if (((_count + 1) * 2) > _slots.size()) {
+            Grow();
+        }
+
+        Entry& entry(_slots[Slot(channel, proxy->Implementation(), proxy->InterfaceId())]);
+
+        if (entry.Proxy == nullptr) {
+            _count++;
+        }
+
+        // A proxy that is on its way out can still be registered for the same key, the latest one wins.
+        entry = Entry { channel, proxy->InterfaceId(), proxy->Implementation(), proxy };
+    }
+
+    void Administrator::ProxyIndex::Remove(const uint32_t channel, const ProxyStub::UnknownProxy* proxy)
+    {
+        ASSERT(proxy != nullptr);
+
+        const uint32_t mask = static_cast<uint32_t>(_slots.size() - 1);
+        uint32_t slot = Slot(channel, proxy->Implementation(), proxy->InterfaceId());
+
+        if (_slots[slot].Proxy == proxy) {
+            // Backward shift deletion, move up the entries that would no longer be found past the gap.
+            uint32_t next = slot;
+
+            while (_slots[(next = ((next + 1) & mask))].Proxy != nullptr) {
+                const uint32_t home = Hash(_slots[next].Channel, _slots[next].Implementation, _slots[next].Id) & mask;
+
+                if (((next - home) & mask) >= ((next - slot) & mask)) {
+                    _slots[slot] = _slots[next];
+                    slot = next;
+                }
+            }
+
+            _slots[slot] = Entry { 0, 0, 0, nullptr };
+            _count--;
+        }
+    }
+
+    void Administrator::ProxyIndex::Grow()
+    {
+        std::vector<Entry> previous(_slots.size() * 2, Entry { 0, 0, 0, nullptr });
+
+        previous.swap(_slots);
+
+        for (const Entry& entry : previous) {
+            if (entry.Proxy != nullptr) {
+                _slots[Slot(entry.Channel, entry.Implementation, entry.Id)] = entry;
+            }
+        }
+    }
+
     Administrator::Administrator()
         : _adminLock()
-        , _stubs()
-        , _proxy()
+        , _interfaces(new InterfaceTable(64))
+        , _retired()
         , _factory(8)
         , _channelProxyMap()
+        , _proxyIndex()
         , _channelReferenceMap()
         , _danglingProxies()
         , _securitySettingProxyStubs(SecureProxyStubType::PROXYSTUBS_SECURITY_NONE)
@@ -41,16 +188,23 @@ namespace RPC {
 
     /* virtual */ Administrator::~Administrator()
     {
-        for (auto& proxy : _proxy) {
-            delete proxy.second;
-        }
+        InterfaceTable* table = _interfaces.exchange(nullptr);
+
+        table->Visit([](Interface& entry) {
+            delete entry.Factory(nullptr);
+            PUSH_WARNING(DISABLE_WARNING_DELETE_INCOMPLETE)
+            delete entry.Stub(nullptr);
+            POP_WARNING()
+            delete &entry;
+        });
+
+        delete table;
 
-        for (auto& stub : _stubs) {
-            delete stub.second;
+        for (InterfaceTable* retired : _retired) {
+            delete retired;
         }
 
-        _proxy.clear();
-        _stubs.clear();
+        _retired.clear();
     }
 
     /* static */ Administrator& Administrator::Instance()
@@ -65,11 +219,12 @@ namespace RPC {
 
     void Administrator::AddRef(const Core::ProxyType<Core::IPCChannel>& channel, void* impl, const uint32_t interfaceId)
     {
-        // stub are loaded before any action is taken and destructed if the process closes down, so no need to lock..
-        Stubs::iterator index(_stubs.find(interfaceId));
+        // Lock free, the stub is announced before any action is taken on its interface.
+        const Interface* entry = Lookup(interfaceId);
+        ProxyStub::UnknownStub* stub = (entry != nullptr ? entry->Stub() : nullptr);
 
-        if (index != _stubs.end()) {
-            Core::IUnknown* implementation(index->second->Convert(impl));
+        if (stub != nullptr) {
+            Core::IUnknown* implementation(stub->Convert(impl));
 
             ASSERT(implementation != nullptr);
 
@@ -89,11 +244,12 @@ namespace RPC {
 
     void Administrator::Release(const Core::ProxyType<Core::IPCChannel>& channel, void* impl, const uint32_t interfaceId, const uint32_t dropCount)
     {
-        // stub are loaded before any action is taken and destructed if the process closes down, so no need to lock..
-        Stubs::iterator index(_stubs.find(interfaceId));
+        // Lock free, the stub is announced before any action is taken on its interface.
+        const Interface* entry = Lookup(interfaceId);
+        ProxyStub::UnknownStub* stub = (entry != nullptr ? entry->Stub() : nullptr);
 
-        if (index != _stubs.end()) {
-            Core::IUnknown* implementation(index->second->Convert(impl));
+        if (stub != nullptr) {
+            Core::IUnknown* implementation(stub->Convert(impl));
 
             ASSERT(implementation != nullptr);
 
@@ -135,6 +291,7 @@ namespace RPC {
 
             if (entry != index->second.second.end()) {
                 index->second.second.erase(entry);
+                _proxyIndex.Remove(channelId, &proxy);
                 removed = true;
                 if (index->second.second.size() == 0) {
                     _channelProxyMap.erase(index);
@@ -161,13 +318,10 @@ namespace RPC {
 
     ProxyStub::UnknownStub* Administrator::ExtractStub(const uint32_t interfaceId) const
     {
-        ProxyStub::UnknownStub* result = nullptr;
+        const Interface* entry = Lookup(interfaceId);
+        ProxyStub::UnknownStub* result = (entry != nullptr ? entry->Stub() : nullptr);
 
-        // stub are loaded before any action is taken and destructed if the process closes down, so no need to lock..
-        Stubs::const_iterator index(_stubs.find(interfaceId));
-        if (index != _stubs.end()) {
-            result = index->second;
-        } else {
+        if (result == nullptr) {
             // Oops this is an unknown interface, 
             SYSLOG(Logging::Error, (_T("Unknown interface received, either the received COMRPC Invoke message had an invalid interface ID or the interface was not registered, interface ID [%u]"), interfaceId));
         }
@@ -266,18 +420,12 @@ namespace RPC {
 
         _adminLock.Lock();
 
-        ChannelMap::iterator index(_channelProxyMap.find(channel->Id()));
+        ProxyStub::UnknownProxy* entry = _proxyIndex.Find(channel->Id(), impl, id);
 
-        if (index != _channelProxyMap.end()) {
-            Proxies::iterator entry(index->second.second.begin());
-            while ((entry != index->second.second.end()) && (((*entry)->InterfaceId() != id) || ((*entry)->Implementation() != impl))) {
-                entry++;
-            }
-            if (entry != index->second.second.end()) {
-                interface = (*entry)->QueryInterface(id);
-                if (interface != nullptr) {
-                    result = (*entry);
-                }
+        if (entry != nullptr) {
+            interface = entry->QueryInterface(id);
+            if (interface != nullptr) {
+                result = entry;
             }
         }
 
@@ -299,31 +447,26 @@ namespace RPC {
             if (channel.IsValid() == true) {
 
                 uint32_t channelId(channel->Id());
-                ChannelMap::iterator index(_channelProxyMap.find(channelId));
+                ProxyStub::UnknownProxy* entry = _proxyIndex.Find(channelId, impl, id);
 
-                if (index != _channelProxyMap.end()) {
-                    Proxies::iterator entry(index->second.second.begin());
-                    while ((entry != index->second.second.end()) && (((*entry)->InterfaceId() != id) || ((*entry)->Implementation() != impl))) {
-                        entry++;
-                    }
-                    if (entry != index->second.second.end()) {
-                        interface = (*entry)->Acquire(outbound, id);
-
-                        // The implementation could be found, but the current implemented proxy is not
-                        // for the given interface. If that cae, the interface == nullptr and we still
-                        // need to create a proxy for this specific interface.
-                        if (interface != nullptr) {
-                            result = (*entry);
-                        }
+                if (entry != nullptr) {
+                    interface = entry->Acquire(outbound, id);
+
+                    // The implementation could be found, but the current implemented proxy is not
+                    // for the given interface. If that cae, the interface == nullptr and we still
+                    // need to create a proxy for this specific interface.
+                    if (interface != nullptr) {
+                        result = entry;
                     }
                 }
 
                 if (result == nullptr) {
-                    Factories::iterator factory(_proxy.find(id));
+                    const Interface* metadata = Lookup(id);
+                    IMetadata* factory = (metadata != nullptr ? metadata->Factory() : nullptr);
 
-                    if (factory != _proxy.end()) {
+                    if (factory != nullptr) {
 
-                        result = factory->second->CreateProxy(channel, impl, outbound);
+                        result = factory->CreateProxy(channel, impl, outbound);
 
                         ASSERT(result != nullptr);
 
@@ -341,6 +484,8 @@ namespace RPC {
                                 std::forward_as_tuple(std::pair<string, Proxies>(channel->Origin(), baseList)));
                         }
 
+                        _proxyIndex.Insert(channelId, result);
+
                         // This will increment the reference count to 2 (one in the ChannelProxyMap and one in the QueryInterface ).
                         interface = result->QueryInterface(id);
                         ASSERT(interface != nullptr);
@@ -457,18 +602,41 @@ namespace RPC {
 
             _adminLock.Lock();
 
-#ifdef __DEBUG__
-            if (_stubs.find(interfaceID) != _stubs.end()) {
-                TRACE_L1("Interface (stub) %d, gets registered multiple times !!!", interfaceID);
-            } else if (_proxy.find(interfaceID) != _proxy.end()) {
-                TRACE_L1("Interface (proxy) %d, gets registered multiple times !!!", interfaceID);
+            InterfaceTable* table = _interfaces.load(std::memory_order_relaxed);
+            Interface* entry = table->Find(interfaceID);
+
+            if (entry == nullptr) {
+                if (table->IsFull() == true) {
+                    // Readers might still be looking in the current table, it is kept until we are destructed.
+                    InterfaceTable* larger = new InterfaceTable(table->Capacity() * 2);
+
+                    table->Visit([larger](Interface& existing) { larger->Insert(&existing); });
+
+                    _retired.push_back(table);
+                    table = larger;
+                }
+
+                table->Insert(new Interface(interfaceID, stub, proxy));
+                _interfaces.store(table, std::memory_order_release);
+                stub = nullptr;
+                proxy = nullptr;
+            } else if ((entry->Stub() == nullptr) && (entry->Factory() == nullptr)) {
+                // Announced again after a recall.
+                entry->Factory(proxy);
+                entry->Stub(stub);
+                stub = nullptr;
+                proxy = nullptr;
+            } else {
+                TRACE_L1("Interface %d, gets registered multiple times !!!", interfaceID);
             }
-#endif
-            _stubs.insert(std::pair<uint32_t, ProxyStub::UnknownStub*>(interfaceID, stub));
-            stub = nullptr;
-            _proxy.insert(std::pair<uint32_t, IMetadata*>(interfaceID, proxy));
-            proxy = nullptr;
+
             _adminLock.Unlock();
+
+            // Only the first announcement is used.
+            delete proxy;
+            PUSH_WARNING(DISABLE_WARNING_DELETE_INCOMPLETE)
+            delete stub;
+            POP_WARNING()
         } else {
 
             SYSLOG(Logging::Error, (_T("Proxy and Stubs for interface %U were generated with a different proxystub security setting than the other Proxy and Stubs, it will be ignored (so expect errors due to this)")));
@@ -479,20 +647,21 @@ namespace RPC {
     {
         _adminLock.Lock();
 
-        Stubs::iterator stub(_stubs.find(interfaceID));
-        if (stub != _stubs.end()) {
+        Interface* entry = _interfaces.load(std::memory_order_relaxed)->Find(interfaceID);
+
+        // Lookups do not hold the lock, so this relies on the interface no longer being used, see Recall().
+        ProxyStub::UnknownStub* stub = (entry != nullptr ? entry->Stub(nullptr) : nullptr);
+        if (stub != nullptr) {
             PUSH_WARNING(DISABLE_WARNING_DELETE_INCOMPLETE)
-            delete stub->second;
+            delete stub;
             POP_WARNING()
-            _stubs.erase(interfaceID);
         } else {
             TRACE_L1("Failed to find a Stub for %d.", interfaceID);
         }
 
-        Factories::iterator proxy(_proxy.find(interfaceID));
-        if (proxy != _proxy.end()) {
-            delete proxy->second;
-            _proxy.erase(interfaceID);
+        IMetadata* proxy = (entry != nullptr ? entry->Factory(nullptr) : nullptr);
+        if (proxy != nullptr) {
+            delete proxy;
         } else {
             TRACE_L1("Failed to find a Proxy for %d.", interfaceID);
         }
@@ -502,14 +671,16 @@ namespace RPC {
 
     Core::IUnknown* Administrator::Convert(void* rawImplementation, const uint32_t id)
     {
-        Stubs::const_iterator index (_stubs.find(id));
-        return(index != _stubs.end() ? index->second->Convert(rawImplementation) : nullptr);
+        const Interface* entry = Lookup(id);
+        ProxyStub::UnknownStub* stub = (entry != nullptr ? entry->Stub() : nullptr);
+        return(stub != nullptr ? stub->Convert(rawImplementation) : nullptr);
     }
 
     const Core::IUnknown* Administrator::Convert(void* rawImplementation, const uint32_t id) const
     {
-        Stubs::const_iterator index (_stubs.find(id));
-        return(index != _stubs.end() ? index->second->Convert(rawImplementation) : nullptr);
+        const Interface* entry = Lookup(id);
+        const ProxyStub::UnknownStub* stub = (entry != nullptr ? entry->Stub() : nullptr);
+        return(stub != nullptr ? stub->Convert(rawImplementation) : nullptr);
     }
 
     void Administrator::DeleteChannel(const Core::ProxyType<Core::IPCChannel>& channel, Danglings& pendingProxies)
@@ -546,6 +717,8 @@ namespace RPC {
 
         if (index != _channelProxyMap.end()) {
             for (auto entry : index->second.second) {
+                _proxyIndex.Remove(channelId, entry);
+
                 if (entry->Invalidate() == true) {
                     // This is actually for the pendingProxies to be reported
                     // dangling!!
@@ -39,6 +39,7 @@ namespace RPC {
     enum { CommunicationTimeOut = 3000 }; // Time in ms. 3 Seconds
 #endif
     enum { CommunicationBufferSize = 8120 }; // 8K :-)
+    enum { SharedRingSize = 64 * 1024 }; // Per direction, if a connection moves over to shared memory
 
     enum class SecureProxyStubType : uint8_t {
         PROXYSTUBS_SECURITY_NONE = 0,
@@ -114,6 +115,146 @@ namespace RPC {
             virtual ProxyStub::UnknownProxy* CreateProxy(const Core::ProxyType<Core::IPCChannel>& channel, const Core::instance_id& implementation, const bool remoteRefCounted) = 0;
         };
 
+    public:
+        // The stub and proxy factory of an interface, resolved on every invoke. Entries are never removed,
+        // a Recall clears them, so readers can hold on to an entry without a lock. The stub and factory
+        // themselves are not kept alive for a reader, see Recall.
+        class Interface {
+        public:
+            Interface() = delete;
+            Interface(Interface&&) = delete;
+            Interface(const Interface&) = delete;
+            Interface& operator=(Interface&&) = delete;
+            Interface& operator=(const Interface&) = delete;
+
+            Interface(const uint32_t id, ProxyStub::UnknownStub* stub, IMetadata* factory)
+                : _id(id)
+                , _stub(stub)
+                , _factory(factory)
+            {
+            }
+            ~Interface() = default;
+
+        public:
+            uint32_t Id() const
+            {
+                return (_id);
+            }
+            ProxyStub::UnknownStub* Stub() const
+            {
+                return (_stub.load(std::memory_order_acquire));
+            }
+            IMetadata* Factory() const
+            {
+                return (_factory.load(std::memory_order_acquire));
+            }
+            ProxyStub::UnknownStub* Stub(ProxyStub::UnknownStub* stub)
+            {
+                return (_stub.exchange(stub, std::memory_order_acq_rel));
+            }
+            IMetadata* Factory(IMetadata* factory)
+            {
+                return (_factory.exchange(factory, std::memory_order_acq_rel));
+            }
+
+        private:
+            const uint32_t _id;
+            std::atomic<ProxyStub::UnknownStub*> _stub;
+            std::atomic<IMetadata*> _factory;
+        };
+
+        // Open addressing, linear probing. Slots only go from empty to an entry, so lookups need no lock,
+        // inserts are done under the admin lock. A full table is replaced by a larger copy.
+        class EXTERNAL InterfaceTable {
+        public:
+            InterfaceTable() = delete;
+            InterfaceTable(InterfaceTable&&) = delete;
+            InterfaceTable(const InterfaceTable&) = delete;
+            InterfaceTable& operator=(InterfaceTable&&) = delete;
+            InterfaceTable& operator=(const InterfaceTable&) = delete;
+
+            explicit InterfaceTable(const uint32_t capacity);
+            ~InterfaceTable();
+
+        public:
+            bool IsFull() const
+            {
+                // Keep the load factor below one half, probes stay short.
+                return (((_count + 1) * 2) > (_mask + 1));
+            }
+            uint32_t Capacity() const
+            {
+                return (_mask + 1);
+            }
+            Interface* Find(const uint32_t id) const;
+            void Insert(Interface* entry);
+
+            // The slot an interface starts probing from is Hash(id) & (Capacity() - 1).
+            static uint32_t Hash(const uint32_t id);
+
+            template <typename ACTION>
+            void Visit(ACTION&& action) const
+            {
+                for (uint32_t index = 0; index <= _mask; index++) {
+                    Interface* entry = _slots[index].load(std::memory_order_acquire);
+                    if (entry != nullptr) {
+                        action(*entry);
+                    }
+                }
+            }
+
+        private:
+            const uint32_t _mask;
+            uint32_t _count;
+            std::atomic<Interface*>* _slots;
+        };
+
+        // Live proxies by (channel, implementation, interface), guarded by the admin lock. Replaces the
+        // scan over all proxies of a channel for every interface that is handed over.
+        class EXTERNAL ProxyIndex {
+        private:
+            struct Entry {
+                uint32_t Channel;
+                uint32_t Id;
+                Core::instance_id Implementation;
+                ProxyStub::UnknownProxy* Proxy;
+            };
+
+        public:
+            ProxyIndex(ProxyIndex&&) = delete;
+            ProxyIndex(const ProxyIndex&) = delete;
+            ProxyIndex& operator=(ProxyIndex&&) = delete;
+            ProxyIndex& operator=(const ProxyIndex&) = delete;
+
+            ProxyIndex();
+            ~ProxyIndex() = default;
+
+        public:
+            uint32_t Count() const
+            {
+                return (_count);
+            }
+            uint32_t Capacity() const
+            {
+                return (static_cast<uint32_t>(_slots.size()));
+            }
+            ProxyStub::UnknownProxy* Find(const uint32_t channel, const Core::instance_id& implementation, const uint32_t id) const;
+            void Insert(const uint32_t channel, ProxyStub::UnknownProxy* proxy);
+            void Remove(const uint32_t channel, const ProxyStub::UnknownProxy* proxy);
+
+            // The slot a proxy starts probing from is Hash(...) & (Capacity() - 1).
+            static uint32_t Hash(const uint32_t channel, const Core::instance_id& implementation, const uint32_t id);
+
+        private:
+            uint32_t Slot(const uint32_t channel, const Core::instance_id& implementation, const uint32_t id) const;
+            void Grow();
+
+        private:
+            uint32_t _count;
+            std::vector<Entry> _slots;
+        };
+
+    private:
         template <typename PROXY>
         class ProxyType : public IMetadata {
         public:
@@ -139,8 +280,6 @@ namespace RPC {
         using Proxies = std::vector<ProxyStub::UnknownProxy*>;
         using ChannelMap = std::unordered_map<uint32_t, std::pair<string, Proxies > >;
         using ReferenceMap = std::unordered_map<uint32_t, std::list< RecoverySet > >;
-        using Stubs = std::unordered_map<uint32_t, ProxyStub::UnknownStub*>;
-        using Factories = std::unordered_map<uint32_t, IMetadata*>;
         using Danglings = std::vector<std::pair<uint32_t, Core::IUnknown*>>;
 
     public:
@@ -210,6 +349,9 @@ namespace RPC {
             Announce(ACTUALINTERFACE::ID, new STUB(), new ProxyType<PROXY>(), secure);
         }
 
+        // The stub and proxy factory are deleted right away, while an invoke or a proxy creation could
+        // still be using them without a lock. Only recall an interface when it can no longer be used,
+        // as the proxy stub library that announced it does when it is unloaded.
         template <typename ACTUALINTERFACE>
         void Recall()
         {
@@ -307,6 +449,10 @@ namespace RPC {
         void Recall(uint32_t interfaceID);
         Core::IUnknown* Convert(void* rawImplementation, const uint32_t id);
         const Core::IUnknown* Convert(void* rawImplementation, const uint32_t id) const;
+        Interface* Lookup(const uint32_t id) const
+        {
+            return (_interfaces.load(std::memory_order_acquire)->Find(id));
+        }
         void RegisterUnknown(const Core::ProxyType<Core::IPCChannel>& channel, Core::IUnknown* source, const uint32_t id);
         void UnregisterUnknown(const Core::ProxyType<Core::IPCChannel>& channel, const Core::IUnknown* source, const uint32_t interfaceId, const uint32_t dropCount);
         Core::IUnknown* ExtractIUnknown(Core::ProxyType<Core::IPCChannel>& channel, Core::ProxyType<InvokeMessage>& message) const;
@@ -318,10 +464,11 @@ namespace RPC {
     private:
         // Seems like we have enough information, open up the Process communcication Channel.
         mutable Core::CriticalSection _adminLock;
-        Stubs _stubs;
-        Factories _proxy;
+        std::atomic<InterfaceTable*> _interfaces;
+        std::list<InterfaceTable*> _retired;
         Core::ProxyPoolType<InvokeMessage> _factory;
         ChannelMap _channelProxyMap;
+        ProxyIndex _proxyIndex;
         ReferenceMap _channelReferenceMap;
         Proxies _danglingProxies;
         SecureProxyStubType _securitySettingProxyStubs;
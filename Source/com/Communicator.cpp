@@ -29,6 +29,9 @@ namespace RPC {
 
     static Core::ProxyPoolType<RPC::AnnounceMessage> AnnounceMessageFactory(2);
 
+    // Connector prefix that asks a COM-RPC client to move its channel over to shared memory.
+    static constexpr TCHAR SharedTransport[] = _T("shared:");
+
     class DynamicLoaderPaths {
     private:
         static constexpr TCHAR LoaderConfig[] = _T("/etc/ld.so.conf");
@@ -275,43 +278,64 @@ namespace RPC {
 
     /* static */ std::atomic<uint32_t> Communicator::RemoteConnection::_sequenceId(1);
 
-    static void LoadProxyStubs(const string& pathName)
-    {
-        static std::list<Core::Library> processProxyStubs;
-
-        Core::TextSegmentIterator places(Core::TextFragment(pathName), false, '|');
-
 #ifdef __APPLE__
 #ifdef VERSIONED_LIBRARY_LOADING
-    static const std::string suffixFilter = "*." + std::to_string(THUNDER_VERSION)+ ".dylib";
+    static const std::string ProxyStubSuffix = "." + std::to_string(THUNDER_VERSION) + ".dylib";
 #else
-    static const std::string suffixFilter = "*.dylib";
+    static const std::string ProxyStubSuffix = ".dylib";
 #endif
 #else
 #ifdef VERSIONED_LIBRARY_LOADING
-    static const std::string suffixFilter = "*.so." + std::to_string(THUNDER_VERSION);
+    static const std::string ProxyStubSuffix = ".so." + std::to_string(THUNDER_VERSION);
 #else
-    static const std::string suffixFilter = "*.so";
+    static const std::string ProxyStubSuffix = ".so";
 #endif
 #endif
 
+    static void LoadProxyStub(const string& fileName)
+    {
+        static std::list<Core::Library> processProxyStubs;
+
+        // Check if this ProxySTub file is already loaded in this process space..
+        std::list<Core::Library>::const_iterator loop(processProxyStubs.begin());
+        while ((loop != processProxyStubs.end()) && (loop->Name() != fileName)) {
+            loop++;
+        }
+
+        if (loop == processProxyStubs.end()) {
+            Core::Library library(fileName.c_str());
+
+            if (library.IsLoaded() == true) {
+                processProxyStubs.push_back(library);
+            }
+        }
+    }
+
+    static void LoadProxyStubs(const string& pathName)
+    {
+        static const std::string suffixFilter = "*" + ProxyStubSuffix;
+
+        Core::TextSegmentIterator places(Core::TextFragment(pathName), false, '|');
+
         while (places.Next() == true) {
             Core::Directory index(places.Current().Text().c_str(), _T(suffixFilter.c_str()));
 
             while (index.Next() == true) {
-                // Check if this ProxySTub file is already loaded in this process space..
-                std::list<Core::Library>::const_iterator loop(processProxyStubs.begin());
-                while ((loop != processProxyStubs.end()) && (loop->Name() != index.Current())) {
-                    loop++;
-                }
-
-                if (loop == processProxyStubs.end()) {
-                    Core::Library library(index.Current().c_str());
+                LoadProxyStub(index.Current());
+            }
+        }
+    }
 
-                    if (library.IsLoaded() == true) {
-                        processProxyStubs.push_back(library);
-                    }
-                }
+    static void LoadProxyStubs(const std::vector<string>& fileNames)
+    {
+        for (const string& fileName : fileNames) {
+            Core::File file(fileName);
+
+            if (file.IsDirectory() == true) {
+                // Not known what changed in there, check all of it.
+                LoadProxyStubs(fileName);
+            } else if ((fileName.length() > ProxyStubSuffix.length()) && (fileName.compare(fileName.length() - ProxyStubSuffix.length(), ProxyStubSuffix.length(), ProxyStubSuffix) == 0) && (file.Exists() == true)) {
+                LoadProxyStub(fileName);
             }
         }
     }
@@ -407,7 +431,8 @@ namespace RPC {
     Communicator::Communicator(const Core::NodeId& node, const string& proxyStubPath, const TCHAR* sourceName)
         : _source(sourceName == nullptr ? _T("UnknownServer") : sourceName)
         , _connectionMap(*this)
-        , _ipcServer(node, _connectionMap, proxyStubPath) {
+        , _ipcServer(node, _connectionMap, proxyStubPath)
+        , _sharedMemory(false) {
         if (proxyStubPath.empty() == false) {
             RPC::LoadProxyStubs(proxyStubPath);
         }
@@ -423,7 +448,8 @@ namespace RPC {
         const TCHAR* sourceName)
         : _source(sourceName == nullptr ? _T("UnknownServer") : sourceName)
         , _connectionMap(*this)
-        , _ipcServer(node, _connectionMap, proxyStubPath, handler) {
+        , _ipcServer(node, _connectionMap, proxyStubPath, handler)
+        , _sharedMemory(false) {
         if (proxyStubPath.empty() == false) {
             RPC::LoadProxyStubs(proxyStubPath);
         }
@@ -433,6 +459,17 @@ namespace RPC {
     }
     POP_WARNING()
 
+    void Communicator::SharedMemory(const bool enabled)
+    {
+        _ipcServer.Shareable(enabled);
+        _sharedMemory = enabled;
+    }
+
+    string Communicator::HostConnector() const
+    {
+        return (_sharedMemory == true ? (string(SharedTransport) + Connector()) : Connector());
+    }
+
     /* virtual */ Communicator::~Communicator()
     {
         // Make sure any closed channel is cleared before we start validating the end result :-)
@@ -457,6 +494,9 @@ namespace RPC {
     void Communicator::LoadProxyStubs(const string& pathName) {
         RPC::LoadProxyStubs(pathName);
     }
+    void Communicator::LoadProxyStubs(const std::vector<string>& fileNames) {
+        RPC::LoadProxyStubs(fileNames);
+    }
     const std::vector<string>& Communicator::Process::DynamicLoaderPaths() const {
         return _LoaderPaths.Paths();
     }
@@ -468,6 +508,8 @@ namespace RPC {
         , _announceMessage()
         , _announceEvent(false, true)
         , _connectionId(~0)
+        , _sharedSize(0)
+        , _upgradeSink(*this)
     {
         _announceMessage.AddRef();
 
@@ -484,6 +526,8 @@ namespace RPC {
         , _announceMessage()
         , _announceEvent(false, true)
         , _connectionId(~0)
+        , _sharedSize(0)
+        , _upgradeSink(*this)
     {
         _announceMessage.AddRef();
 
@@ -567,29 +611,53 @@ namespace RPC {
         return (BaseClass::Close(waitTime));
     }
 
+    /* static */ uint32_t CommunicatorClient::Transport(const string& connector, string& socket)
+    {
+        constexpr uint32_t SharedLength = (sizeof(SharedTransport) / sizeof(TCHAR)) - 1;
+
+        uint32_t result = 0;
+
+        if (connector.compare(0, SharedLength, SharedTransport) == 0) {
+            socket = connector.substr(SharedLength);
+            result = RPC::SharedRingSize;
+        } else {
+            socket = connector;
+        }
+
+        return (result);
+    }
+
     void CommunicatorClient::StateChange() /* override */ {
         BaseClass::StateChange();
 
         if (BaseClass::Source().IsOpen()) {
-            TRACE_L1("Invoking the Announce message to the server. %d", __LINE__);
-            uint32_t result = Invoke<RPC::AnnounceMessage>(Core::ProxyType<RPC::AnnounceMessage>(_announceMessage), this);
+            // If we move over to shared memory, the announce follows once that is settled.
+            if ((_sharedSize == 0) || (BaseClass::Upgrade(_sharedSize, &_upgradeSink) != Core::ERROR_NONE)) {
+                Announce();
+            }
+        } else {
+            TRACE_L1("Connection to the server is down");
+        }
+    }
 
-            if (result != Core::ERROR_NONE) {
-                TRACE_L1("Error during invoke of AnnounceMessage: %d", result);
-            } else {
-                RPC::Data::Init& setupFrame(_announceMessage.Parameters());
+    void CommunicatorClient::Announce()
+    {
+        TRACE_L1("Invoking the Announce message to the server. %d", __LINE__);
+        uint32_t result = Invoke<RPC::AnnounceMessage>(Core::ProxyType<RPC::AnnounceMessage>(_announceMessage), this);
 
-                if (setupFrame.IsRequested() == true) {
-                    Core::ProxyType<Core::IPCChannel> refChannel(*this);
+        if (result != Core::ERROR_NONE) {
+            TRACE_L1("Error during invoke of AnnounceMessage: %d", result);
+        } else {
+            RPC::Data::Init& setupFrame(_announceMessage.Parameters());
 
-                    ASSERT(refChannel.IsValid());
+            if (setupFrame.IsRequested() == true) {
+                Core::ProxyType<Core::IPCChannel> refChannel(*this);
 
-                    // Register the interface we are passing to the otherside:
-                    RPC::Administrator::Instance().RegisterInterface(refChannel, reinterpret_cast<void*>(setupFrame.Implementation()), setupFrame.InterfaceId());
-                }
+                ASSERT(refChannel.IsValid());
+
+                // Register the interface we are passing to the otherside:
+                RPC::Administrator::Instance().RegisterInterface(refChannel, reinterpret_cast<void*>(setupFrame.Implementation()), setupFrame.InterfaceId());
             }
-        } else {
-            TRACE_L1("Connection to the server is down");
         }
     }
 
@@ -1665,6 +1665,7 @@ POP_WARNING()
             return result;
         }
         void LoadProxyStubs(const string& pathName);
+        void LoadProxyStubs(const std::vector<string>& fileNames);
 
     public:
         using Danglings = Administrator::Danglings;
@@ -1721,6 +1722,10 @@ POP_WARNING()
         {
             return (_ipcServer.ProxyStubPath());
         }
+        // Off by default. If enabled, clients may move their channel over to shared memory rings
+        // and the out of process hosts are asked to do so, through the HostConnector.
+        void SharedMemory(const bool enabled);
+        string HostConnector() const;
         void ForcedDestructionTimes(const uint8_t softKillCheckWaitTime, const uint8_t hardKillCheckWaitTime)
         {
             _softKillCheckWaitTime = softKillCheckWaitTime;
@@ -1791,6 +1796,7 @@ POP_WARNING()
         const string _source;
         RemoteConnectionMap _connectionMap;
         ChannelServer _ipcServer;
+        bool _sharedMemory;
         static uint8_t _softKillCheckWaitTime;
         static uint8_t _hardKillCheckWaitTime;
     };
@@ -1863,6 +1869,29 @@ POP_WARNING()
         private:
             CommunicatorClient& _parent;
         };
+        class UpgradeSink : public Core::IDispatchType<Core::IIPC> {
+        public:
+            UpgradeSink() = delete;
+            UpgradeSink(UpgradeSink&&) = delete;
+            UpgradeSink(const UpgradeSink&) = delete;
+            UpgradeSink& operator=(UpgradeSink&&) = delete;
+            UpgradeSink& operator=(const UpgradeSink&) = delete;
+
+            UpgradeSink(CommunicatorClient& parent)
+                : _parent(parent) {
+            }
+            ~UpgradeSink() override = default;
+
+        public:
+            void Dispatch(Core::IIPC& /* element */) override
+            {
+                // Whether it moved over to the shared memory or not, now we can announce ourselves.
+                _parent.Announce();
+            }
+
+        private:
+            CommunicatorClient& _parent;
+        };
 
     public:
         CommunicatorClient() = delete;
@@ -1879,9 +1908,18 @@ POP_WARNING()
         ~CommunicatorClient();
 
     public:
+        // A connector of the form "shared:<socket>" keeps the socket to set up the connection and to
+        // notice the other side is gone, but moves all COM-RPC traffic over to shared memory rings.
+        // Returns the ring size the connector asks for (0 for none) and the socket part of it.
+        static uint32_t Transport(const string& connector, string& socket);
+
         inline uint32_t ConnectionId() const {
             return _connectionId;
         }
+        // Size of the shared memory rings to move to once connected, 0 keeps it on the socket.
+        inline void SharedMemory(const uint32_t ringSize) {
+            _sharedSize = ringSize;
+        }
 
         // Open a communication channel with this process, no need for an initial exchange
         uint32_t Open(const uint32_t waitTime);
@@ -2056,6 +2094,7 @@ POP_WARNING()
             return (_announceEvent.Lock(waitTime) == Core::ERROR_NONE);
         }
         void Dispatch(Core::IIPC& element) override;
+        void Announce();
 
     protected:
         void StateChange() override;
@@ -2064,6 +2103,8 @@ POP_WARNING()
         Core::ProxyObject<RPC::AnnounceMessage> _announceMessage;
         Core::Event _announceEvent;
         uint32_t _connectionId;
+        uint32_t _sharedSize;
+        UpgradeSink _upgradeSink;
     };
 
     using EnvironmentIterator = IteratorType<IEnvironmentIterator>;
@@ -51,6 +51,7 @@ namespace RPC {
         ID_CONTROLLER_METADATA_SERVICES_ITERATOR   = (ID_OFFSET_INTERNAL + 0x001C),
         ID_CONTROLLER_METADATA_LINKS_ITERATOR      = (ID_OFFSET_INTERNAL + 0x001D),
         ID_CONTROLLER_METADATA_PROXIES_ITERATOR    = (ID_OFFSET_INTERNAL + 0x001E),
+        ID_CONTROLLER_METADATA_QUEUES_ITERATOR     = (ID_OFFSET_INTERNAL + 0x001F),
         ID_CONTROLLER_METADATA_THREADS_ITERATOR    = (ID_OFFSET_INTERNAL + 0x0020),
         ID_CONTROLLER_METADATA_CALLSTACK_ITERATOR  = (ID_OFFSET_INTERNAL + 0x0021),
         ID_CONTROLLER_EVENTS                       = (ID_OFFSET_INTERNAL + 0x0022),
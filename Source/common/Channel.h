@@ -159,7 +159,12 @@ namespace PluginHost {
 
                 if (_current.IsValid() == false) {
                     if (_parent.IsOpen() == true) {
-                        _current = _parent.Element(EMPTY_STRING);
+                        if ((_parent.State() == Channel::JSONRPC) && (Core::JSONRPC::Batch::IsBatch(reinterpret_cast<const uint8_t*>(stream), length) == true)) {
+                            _current = _parent.Batch();
+                        }
+                        else {
+                            _current = _parent.Element(EMPTY_STRING);
+                        }
                         _offset = 0;
                     }
                 } 
@@ -167,14 +172,15 @@ namespace PluginHost {
                     loaded = _current->Deserialize(stream, length, _offset);
 #if THUNDER_PERFORMANCE
 		    Core::ProxyType<TrackingJSONRPC> tracking (_current);
-                    ASSERT (tracking.IsValid() == true);
-                    if(loaded > 0) {
+                    if((loaded > 0) && (tracking.IsValid() == true)) {
                         tracking->In(loaded);
                     }
 #endif
                     if ( (_offset == 0) || (loaded != length)) {
 #if THUNDER_PERFORMANCE
-                        tracking->In(0);
+                        if (tracking.IsValid() == true) {
+                            tracking->In(0);
+                        }
 #endif
                         _parent.Received(_current);
                         _current.Release();
@@ -265,6 +271,10 @@ namespace PluginHost {
         {
             BaseClass::Submit(entry);
         }
+        void Submit(const Core::ProxyType<Request>& request, const Core::ProxyType<Web::Response>& entry)
+        {
+            BaseClass::Submit(request, entry);
+        }
         void RequestOutbound()
         {
             BaseClass::Trigger();
@@ -418,6 +428,7 @@ PUSH_WARNING(DISABLE_WARNING_INCONSISTENT_MISSING_OVERRIDE)
         // [OUTBOUND] Completed serialized JSON objects that are send out, will trigger the Send.
         virtual void Send(const Core::ProxyType<Core::JSON::IElement>& element) = 0;
         virtual Core::ProxyType<Core::JSON::IElement> Element(const string& identifier) = 0;
+        virtual Core::ProxyType<Core::JSON::IElement> Batch() = 0;
         virtual void Received(Core::ProxyType<Core::JSON::IElement>& element) = 0;
 
         // We are in an upgraded mode, we are a websocket. Time to "deserialize and serialize
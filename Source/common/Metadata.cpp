@@ -160,6 +160,9 @@ namespace PluginHost
         Core::JSON::Container::Add(_T("activity"), &Activity);
         Core::JSON::Container::Add(_T("id"), &ID);
         Core::JSON::Container::Add(_T("name"), &Name);
+        Core::JSON::Container::Add(_T("queued"), &Queued);
+        Core::JSON::Container::Add(_T("shed"), &Shed);
+        Core::JSON::Container::Add(_T("waits"), &Waits);
     }
     Metadata::Channel::Channel(Metadata::Channel&& move)
         : Core::JSON::Container()
@@ -168,12 +171,18 @@ namespace PluginHost
         , Activity(std::move(move.Activity))
         , ID(std::move(move.ID))
         , Name(std::move(move.Name))
+        , Queued(std::move(move.Queued))
+        , Shed(std::move(move.Shed))
+        , Waits(std::move(move.Waits))
     {
         Core::JSON::Container::Add(_T("remote"), &Remote);
         Core::JSON::Container::Add(_T("state"), &State);
         Core::JSON::Container::Add(_T("activity"), &Activity);
         Core::JSON::Container::Add(_T("id"), &ID);
         Core::JSON::Container::Add(_T("name"), &Name);
+        Core::JSON::Container::Add(_T("queued"), &Queued);
+        Core::JSON::Container::Add(_T("shed"), &Shed);
+        Core::JSON::Container::Add(_T("waits"), &Waits);
     }
     Metadata::Channel::Channel(const Metadata::Channel& copy)
         : Core::JSON::Container()
@@ -182,12 +191,18 @@ namespace PluginHost
         , Activity(copy.Activity)
         , ID(copy.ID)
         , Name(copy.Name)
+        , Queued(copy.Queued)
+        , Shed(copy.Shed)
+        , Waits(copy.Waits)
     {
         Core::JSON::Container::Add(_T("remote"), &Remote);
         Core::JSON::Container::Add(_T("state"), &State);
         Core::JSON::Container::Add(_T("activity"), &Activity);
         Core::JSON::Container::Add(_T("id"), &ID);
         Core::JSON::Container::Add(_T("name"), &Name);
+        Core::JSON::Container::Add(_T("queued"), &Queued);
+        Core::JSON::Container::Add(_T("shed"), &Shed);
+        Core::JSON::Container::Add(_T("waits"), &Waits);
     }
 
     Metadata::Channel& Metadata::Channel::operator=(Metadata::Channel&& move)
@@ -198,6 +213,9 @@ namespace PluginHost
             Activity = std::move(move.Activity);
             ID = std::move(move.ID);
             Name = std::move(move.Name);
+            Queued = std::move(move.Queued);
+            Shed = std::move(move.Shed);
+            Waits = std::move(move.Waits);
         }
 
         return (*this);
@@ -209,6 +227,9 @@ namespace PluginHost
         Activity = RHS.Activity;
         ID = RHS.ID;
         Name = RHS.Name;
+        Queued = RHS.Queued;
+        Shed = RHS.Shed;
+        Waits = RHS.Waits;
 
         return (*this);
     }
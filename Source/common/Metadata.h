@@ -123,6 +123,9 @@ namespace PluginHost {
             Core::JSON::Boolean Activity;
             Core::JSON::DecUInt32 ID;
             Core::JSON::String Name;
+            Core::JSON::DecUInt32 Queued;
+            Core::JSON::DecUInt32 Shed;
+            Core::JSON::ArrayType<Core::JSON::DecUInt32> Waits;
         };
         class EXTERNAL Server : public Core::JSON::Container {
         public:
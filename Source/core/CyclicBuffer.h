@@ -213,6 +213,10 @@ namespace Core {
         {
             return (_administration->_size);
         }        
+        inline bool HugePages()
+        {
+            return (_buffer.HugePages());
+        }
         bool Open();
         void Close();
       
@@ -61,8 +61,10 @@ namespace Core {
         ASSERT(m_Flags != 0);
 
         if ((type & File::CREATE) != 0) {
-            m_File.Create(type);
-            m_File.Permission(type & 0xFFFF);
+            // Exclusive fails if the file (or a link by that name) is already there.
+            if (m_File.Create(type, ((type & File::EXCLUSIVE) != 0)) == true) {
+                m_File.Permission(type & 0xFFFF);
+            }
         } else {
             m_File.Open((type & File::USER_WRITE) == 0);
         }
@@ -198,6 +200,12 @@ namespace Core {
         }
     }
 
+    bool DataElementFile::HugePages()
+    {
+        // Large pages on Windows require SEC_LARGE_PAGES on an anonymous section.
+        return (false);
+    }
+
 #endif
 
 #ifdef __POSIX__
@@ -283,6 +291,21 @@ namespace Core {
         }
     }
 
+    bool DataElementFile::HugePages()
+    {
+        bool result = false;
+
+#ifdef MADV_HUGEPAGE
+        // Files on a hugetlbfs mount are huge page backed by definition; for tmpfs/shmem
+        // backed files this enables THP if the system is configured in "advise" mode.
+        if ((IsValid() == true) && (m_MemoryMappedFile != INVALID_HANDLE_VALUE)) {
+            result = (::madvise(m_MemoryMappedFile, static_cast<size_t>(AllocatedSize()), MADV_HUGEPAGE) == 0);
+        }
+#endif
+
+        return (result);
+    }
+
 #endif
 }
 } // namespace Core
@@ -110,6 +110,10 @@ namespace Core {
         bool Load();
         void Sync();
 
+        // Ask the kernel to back the current mapping with (transparent) huge pages. This
+        // is advisory only: returns false if the platform or filesystem can not honour it.
+        bool HugePages();
+
     protected:
         void Close();
         void Reallocation(const uint64_t size) override;
@@ -24,6 +24,14 @@
 #include "Sync.h"
 #include "Thread.h"
 #include "FileSystem.h"
+#include "Time.h"
+
+#include <set>
+#include <vector>
+
+#ifdef __LINUX__
+#include <sys/timerfd.h>
+#endif
 
 namespace Thunder {
 namespace Core {
@@ -44,14 +52,31 @@ public:
     struct ICallback
     {
         virtual ~ICallback() = default;
-        virtual void Updated() = 0;
+        virtual void Updated() {}
+
+        // Once per coalescing window, with the files that changed. Holds the observed path itself if
+        // it is not known which files changed. Unless overridden, this is reported as Updated().
+        virtual void Changed(const std::vector<string>& /* files */)
+        {
+            Updated();
+        }
     };
 
 private:
     class Observer {
     public:
-        Observer(ICallback *callback)
-            : _callbacks()
+        Observer() = delete;
+        Observer(Observer&&) = delete;
+        Observer(const Observer&) = delete;
+        Observer& operator=(Observer&&) = delete;
+        Observer& operator=(const Observer&) = delete;
+
+        Observer(const string& path, ICallback *callback)
+            : _path(path)
+            , _callbacks()
+            , _changes()
+            , _opened(0)
+            , _deadline(0)
         {
             _callbacks.emplace_back(callback);
         }
@@ -60,10 +85,22 @@ private:
         }
 
     public:
+        const string& Path() const
+        {
+            return (_path);
+        }
         bool HasCallbacks() const
         {
             return (_callbacks.size() > 0);
         }
+        bool IsPending() const
+        {
+            return (_changes.empty() == false);
+        }
+        uint64_t Deadline() const
+        {
+            return (_deadline);
+        }
         void Register(ICallback *callback)
         {
             std::list<ICallback *>::iterator index = std::find(_callbacks.begin(),_callbacks.end(), callback);
@@ -82,17 +119,104 @@ private:
                 _callbacks.erase(index);
             }
         }
+        // Every change moves the end of the window, but it never stays open longer than MaxWindows times
+        // the debounce time, so a steady stream of changes is still reported.
+        void Changed(const string& file, const uint64_t now, const uint64_t debounce)
+        {
+            if (_changes.empty() == true) {
+                _opened = now;
+            }
+
+            _changes.insert(file);
+            _deadline = std::min(now + debounce, _opened + (MaxWindows * debounce));
+        }
         void Notify()
         {
+            const std::vector<string> files(_changes.begin(), _changes.end());
+
+            _changes.clear();
+
             std::list<ICallback *>::iterator index(_callbacks.begin());
             while (index != _callbacks.end()) {
-                (*index)->Updated();
+                (*index)->Changed(files);
                 index++;
             }
         }
+
     private:
+        static constexpr uint8_t MaxWindows = 4;
+
+        const string _path;
         std::list<ICallback *> _callbacks;
+        std::set<string> _changes;
+        uint64_t _opened;
+        uint64_t _deadline;
+    };
+
+#ifndef __APPLE__
+    // Closes the coalescing windows that are still open once no more changes come in.
+    class Window : public Core::IResource {
+    public:
+        Window() = delete;
+        Window(Window&&) = delete;
+        Window(const Window&) = delete;
+        Window& operator=(Window&&) = delete;
+        Window& operator=(const Window&) = delete;
+
+        Window(FileSystemMonitor& parent)
+            : _parent(parent)
+            , _timerFd(::timerfd_create(CLOCK_MONOTONIC, TFD_NONBLOCK | TFD_CLOEXEC))
+        {
+        }
+        ~Window() override
+        {
+            if (_timerFd != -1) {
+                ::close(_timerFd);
+            }
+        }
+
+    public:
+        bool IsValid() const
+        {
+            return (_timerFd != -1);
+        }
+        // Relative to now, in microseconds, 0 disarms.
+        void Arm(const uint64_t delay)
+        {
+            struct itimerspec setting;
+
+            ::memset(&setting, 0, sizeof(setting));
+            setting.it_value.tv_sec = static_cast<time_t>(delay / Time::MicroSecondsPerSecond);
+            setting.it_value.tv_nsec = static_cast<long>((delay % Time::MicroSecondsPerSecond) * Time::NanoSecondsPerMicroSecond);
+
+            ::timerfd_settime(_timerFd, 0, &setting, nullptr);
+        }
+
+    private:
+        Core::IResource::handle Descriptor() const override
+        {
+            return (_timerFd);
+        }
+        uint16_t Events() override
+        {
+            return (POLLIN);
+        }
+        void Handle(const uint16_t events) override
+        {
+            if ((events & POLLIN) != 0) {
+                uint64_t expirations;
+
+                if (::read(_timerFd, &expirations, sizeof(expirations)) == sizeof(expirations)) {
+                    _parent.Expired();
+                }
+            }
+        }
+
+    private:
+        FileSystemMonitor& _parent;
+        int _timerFd;
     };
+#endif
 
     typedef std::unordered_map<int, Observer> Observers;
     typedef std::unordered_map<string, int> Files;
@@ -103,9 +227,11 @@ private:
         , _notifyFd(kqueue())
 #else
         , _notifyFd(inotify_init1(IN_NONBLOCK|IN_CLOEXEC))
-        , _files()
+        , _window(*this)
 #endif
+        , _files()
         , _observers()
+        , _debounce(0)
     {
     }
 
@@ -130,6 +256,14 @@ public:
     {
         return (_notifyFd != -1);
     }
+    // Changes to the same observed path that follow each other within this time (in milliseconds) are
+    // reported in one go. 0 reports every batch of changes as soon as it is read.
+    void Debounce(const uint16_t milliseconds)
+    {
+        _adminLock.Lock();
+        _debounce = static_cast<uint64_t>(milliseconds) * Time::MicroSecondsPerMilliSecond;
+        _adminLock.Unlock();
+    }
     bool Register(ICallback *callback, const string &filename)
     {
         ASSERT(_notifyFd != -1);
@@ -175,7 +309,7 @@ public:
                     std::forward_as_tuple(fileFd));
                      _observers.emplace(std::piecewise_construct,
                     std::forward_as_tuple(fileFd),
-                    std::forward_as_tuple(callback));
+                    std::forward_as_tuple(path, callback));
 
                     if (_files.size() == 1) {
                         // This is the first entry, lets start monitoring
@@ -194,11 +328,15 @@ public:
                     std::forward_as_tuple(fileFd));
                 _observers.emplace(std::piecewise_construct,
                     std::forward_as_tuple(fileFd),
-                    std::forward_as_tuple(callback));
+                    std::forward_as_tuple(path, callback));
 
                 if (_files.size() == 1) {
                     // This is the first entry, lets start monitoring
                     Core::ResourceMonitor::Instance().Register(*this);
+
+                    if (_window.IsValid() == true) {
+                        Core::ResourceMonitor::Instance().Register(_window);
+                    }
                 }
             }
 #endif
@@ -241,6 +379,11 @@ public:
                         // This is the first entry, lets start monitoring
                         _adminLock.Unlock();
                         Core::ResourceMonitor::Instance().Unregister(*this);
+#ifndef __APPLE__
+                        if (_window.IsValid() == true) {
+                            Core::ResourceMonitor::Instance().Unregister(_window);
+                        }
+#endif
                     }
                     else {
                          _adminLock.Unlock();
@@ -281,6 +424,8 @@ private:
                     _adminLock.Lock();
                     Observers::iterator loop = _observers.find(static_cast<int>(event.ident));
                     if (loop != _observers.end()) {
+                        // The vnode events do not tell which file in a directory changed.
+                        loop->second.Changed(loop->second.Path(), 0, 0);
                         loop->second.Notify();
                     }
                     _adminLock.Unlock();
@@ -292,43 +437,78 @@ private:
     void Handle(const uint16_t events) override
     {
         if ((events & POLLIN) != 0) {
-            uint8_t eventBuffer[(sizeof(struct inotify_event) + NAME_MAX + 1)];
+            // Copying a set of files queues a lot of events, take as many as possible per read.
+            alignas(struct inotify_event) uint8_t eventBuffer[16 * (sizeof(struct inotify_event) + NAME_MAX + 1)];
+            const uint64_t now = MonotonicTime::Now();
             int length;
-            do {
-                length = ::read(_notifyFd, eventBuffer, sizeof(eventBuffer));
-                eventBuffer[sizeof(eventBuffer)-1] = '\0';
-
-                if (length >= static_cast<int>(sizeof(struct inotify_event))) {
-                    const struct inotify_event *event = reinterpret_cast<const struct inotify_event *>(eventBuffer);
-
-                    auto Evaluate = [this](const struct inotify_event* event) -> bool {
-                        // In case of IN_CREATE notify only if the created file is a link
-                        if ((event->mask & (IN_CREATE | IN_ISDIR)) == IN_CREATE) {
-                            ASSERT(event->len != 0);
-                            const int& wd = event->wd;
-                            auto const it = std::find_if(_files.cbegin(), _files.cend(), [wd](const std::pair<string, int>& elem) {
-                                return (elem.second == wd);
-                            });
-
-                            ASSERT(it != _files.cend());
-                            return (Core::File((*it).first + Core::ToString(event->name)).IsLink());
-                        }
-                        return (true);
-                    };
 
-                    _adminLock.Lock();
+            _adminLock.Lock();
 
-                    if (Evaluate(event) == true) {
-                        // Check if we have this entry..
-                        Observers::iterator loop = _observers.find(event->wd);
-                        if (loop != _observers.end()) {
-                            loop->second.Notify();
-                        }
-                    }
+            while ((length = ::read(_notifyFd, eventBuffer, sizeof(eventBuffer))) >= static_cast<int>(sizeof(struct inotify_event))) {
+                int offset = 0;
 
-                    _adminLock.Unlock();
+                while ((offset + static_cast<int>(sizeof(struct inotify_event))) <= length) {
+                    const struct inotify_event* event = reinterpret_cast<const struct inotify_event*>(&eventBuffer[offset]);
+
+                    Evaluate(*event, now);
+
+                    offset += static_cast<int>(sizeof(struct inotify_event) + event->len);
+                }
+            }
+
+            Flush(now);
+
+            _adminLock.Unlock();
+        }
+    }
+    void Evaluate(const struct inotify_event& event, const uint64_t now)
+    {
+        const uint64_t debounce = (_window.IsValid() == true ? _debounce : 0);
+
+        if ((event.mask & IN_Q_OVERFLOW) != 0) {
+            // Changes got lost, all that is known is that anything might have changed.
+            for (std::pair<const int, Observer>& entry : _observers) {
+                entry.second.Changed(entry.second.Path(), now, debounce);
+            }
+        }
+        else {
+            // Check if we have this entry..
+            Observers::iterator loop = _observers.find(event.wd);
+
+            if (loop != _observers.end()) {
+                const string file = (event.len != 0 ? loop->second.Path() + Core::ToString(event.name) : loop->second.Path());
+
+                // In case of IN_CREATE notify only if the created file is a link
+                if (((event.mask & (IN_CREATE | IN_ISDIR)) != IN_CREATE) || (Core::File(file).IsLink() == true)) {
+                    loop->second.Changed(file, now, debounce);
+                }
+            }
+        }
+    }
+    void Expired()
+    {
+        _adminLock.Lock();
+        Flush(MonotonicTime::Now());
+        _adminLock.Unlock();
+    }
+    // Reports the windows that are closed and rearms the timer for the first one still open.
+    void Flush(const uint64_t now)
+    {
+        uint64_t next = ~0;
+
+        for (std::pair<const int, Observer>& entry : _observers) {
+            if (entry.second.IsPending() == true) {
+                if (entry.second.Deadline() <= now) {
+                    entry.second.Notify();
                 }
-            } while (length > 0);
+                else if (entry.second.Deadline() < next) {
+                    next = entry.second.Deadline();
+                }
+            }
+        }
+
+        if (_window.IsValid() == true) {
+            _window.Arm(next == static_cast<uint64_t>(~0) ? 0 : (next - now));
         }
     }
 #endif
@@ -336,8 +516,12 @@ private:
 private:
     Core::CriticalSection _adminLock;
     int _notifyFd;
+#ifndef __APPLE__
+    Window _window;
+#endif
     Files _files;
     Observers _observers;
+    uint64_t _debounce;
 };
 
 #endif
@@ -352,7 +536,13 @@ public:
     struct ICallback
     {
         virtual ~ICallback() = default;
-        virtual void Updated() = 0;
+        virtual void Updated() {}
+
+        // Changes are not coalesced here, files holds the observed directory.
+        virtual void Changed(const std::vector<string>& /* files */)
+        {
+            Updated();
+        }
     };
 
 private:
@@ -454,8 +644,10 @@ private:
                     TRACE_L1("Could not start observing: %s", _filename.c_str());
                 }
 
+                const std::vector<string> files({ _filename });
+
                 for (auto& client : _clients) {
-                    client->Updated();
+                    client->Changed(files);
                 }
             }
         }
@@ -525,6 +717,10 @@ public:
     {
         return (_trigger != INVALID_HANDLE_VALUE);
     }
+    void Debounce(const uint16_t /* milliseconds */)
+    {
+        // Every change is reported as it is signalled.
+    }
     bool Register(ICallback *callback, const string &filename)
     {
         bool subscribed = false;
@@ -87,7 +87,8 @@ namespace Core {
             OTHERS_WRITE   = 0x00000080,
             OTHERS_EXECUTE = 0x00000100,
             SHAREABLE      = 0x10000000,
-            CREATE         = 0x20000000
+            CREATE         = 0x20000000,
+            EXCLUSIVE      = 0x40000000
        } Mode;
 
 #endif
@@ -123,7 +124,8 @@ namespace Core {
             OTHERS_WRITE   = S_IWOTH,
             OTHERS_EXECUTE = S_IXOTH,
             SHAREABLE      = 0x10000000,
-            CREATE         = 0x20000000
+            CREATE         = 0x20000000,
+            EXCLUSIVE      = 0x40000000
        } Mode;
 
 
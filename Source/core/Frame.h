@@ -40,6 +40,43 @@ namespace Core {
             return (length);
         }
 
+        // Copies a number of SIZE bytes while reversing the byte order. The common sizes end up
+        // as a single byte swap instruction, the rest is done byte by byte.
+        template <const uint8_t SIZE>
+        inline void ReverseCopy(uint8_t destination[], const uint8_t source[])
+        {
+            for (uint8_t index = 0; index < SIZE; index++) {
+                destination[SIZE - 1 - index] = source[index];
+            }
+        }
+
+#if defined(__GNUC__) || defined(__clang__)
+        template <>
+        inline void ReverseCopy<2>(uint8_t destination[], const uint8_t source[])
+        {
+            uint16_t value;
+            ::memcpy(&value, source, sizeof(value));
+            value = __builtin_bswap16(value);
+            ::memcpy(destination, &value, sizeof(value));
+        }
+        template <>
+        inline void ReverseCopy<4>(uint8_t destination[], const uint8_t source[])
+        {
+            uint32_t value;
+            ::memcpy(&value, source, sizeof(value));
+            value = __builtin_bswap32(value);
+            ::memcpy(destination, &value, sizeof(value));
+        }
+        template <>
+        inline void ReverseCopy<8>(uint8_t destination[], const uint8_t source[])
+        {
+            uint64_t value;
+            ::memcpy(&value, source, sizeof(value));
+            value = __builtin_bswap64(value);
+            ::memcpy(destination, &value, sizeof(value));
+        }
+#endif
+
     }
 
     template <const uint32_t BLOCKSIZE, const bool BIG_ENDIAN_ORDERING = true, typename SIZE_CONTEXT = uint16_t>
@@ -138,6 +175,10 @@ namespace Core {
                 ASSERT(index < _bufferSize);
                 return (_data[index]);
             }
+            inline SIZETYPE Capacity() const
+            {
+                return (_bufferSize);
+            }
             inline void Allocate(SIZETYPE requiredSize)
             {
                 RealAllocate(requiredSize, TemplateIntToType<STARTSIZE == 0 ? false : true>());
@@ -152,14 +193,23 @@ namespace Core {
             {
                 if (requiredSize > _bufferSize) {
 
-                    SIZETYPE bufferSize = static_cast<uint32_t>(((requiredSize / (STARTSIZE ? STARTSIZE : 1)) + 1) * STARTSIZE);
+                    // Grow at least twofold, so a frame that is filled up piece by piece (e.g. a large
+                    // parameter block coming in over the socket) does not realloc for every block.
+                    const uint64_t block = ((STARTSIZE == static_cast<uint32_t>(~0)) ? 1 : STARTSIZE);
+                    uint64_t bufferSize = std::max(static_cast<uint64_t>(requiredSize), static_cast<uint64_t>(_bufferSize) * 2);
+
+                    bufferSize = ((bufferSize + block - 1) / block) * block;
+
+                    if (bufferSize > static_cast<uint64_t>(std::numeric_limits<SIZETYPE>::max())) {
+                        bufferSize = std::numeric_limits<SIZETYPE>::max();
+                    }
 
                     // oops we need to "reallocate".
-                    uint8_t* data = reinterpret_cast<uint8_t*>(::realloc(_data, bufferSize));
+                    uint8_t* data = reinterpret_cast<uint8_t*>(::realloc(_data, static_cast<size_t>(bufferSize)));
 
                     if (data != nullptr) {
                         _data = data;
-                        _bufferSize = bufferSize;
+                        _bufferSize = static_cast<SIZETYPE>(bufferSize);
                     }
                 }
             }
@@ -276,6 +326,13 @@ namespace Core {
 
                 _offset += _container->GetVariableNumber<TYPENAME>(_offset, result);
             }
+            template <typename TYPENAME>
+            void Numbers(TYPENAME values[], const SIZE_CONTEXT count) const
+            {
+                ASSERT(_container != nullptr);
+
+                _offset += _container->GetNumbers<TYPENAME>(_offset, values, count);
+            }
             bool Boolean() const
             {
                 bool result;
@@ -376,6 +433,13 @@ namespace Core {
             {
                 return (_offset);
             }
+            // Makes sure the next <length> bytes can be written without growing the frame in between.
+            void Reserve(const SIZE_CONTEXT length)
+            {
+                ASSERT(_container != nullptr);
+
+                _container->Reserve(_offset + length);
+            }
             template <typename TYPENAME>
             void Buffer(const TYPENAME length, const uint8_t buffer[])
             {
@@ -397,6 +461,13 @@ namespace Core {
                 _offset += _container->SetNumber<TYPENAME>(_offset, value);
             }
             template <typename TYPENAME>
+            void Numbers(const TYPENAME values[], const SIZE_CONTEXT count)
+            {
+                ASSERT(_container != nullptr);
+
+                _offset += _container->SetNumbers<TYPENAME>(_offset, values, count);
+            }
+            template <typename TYPENAME>
             void VariableNumber(const TYPENAME value)
             {
                 ASSERT(_container != nullptr);
@@ -512,6 +583,15 @@ namespace Core {
         inline const uint8_t* Data() const {
             return (&_data[0]);
         }
+        inline SIZE_CONTEXT Capacity() const
+        {
+            return (_data.Capacity());
+        }
+        // Capacity hint, allocates room for <capacity> bytes up front, the size is not changed.
+        void Reserve(const SIZE_CONTEXT capacity)
+        {
+            _data.Allocate(capacity);
+        }
         inline uint8_t& operator[](const SIZE_CONTEXT index)
         {
             return _data[index];
@@ -780,6 +860,69 @@ namespace Core {
             return (GetNumber(offset, number, TemplateIntToType<Core::RealSize<TYPENAME>() == 1>()));
         }
 
+        // Arrays of scalars are written back to back, without a length. The size is checked once for
+        // the whole array and, if the byte order matches, copied as a single block.
+        template <typename TYPENAME>
+        SIZE_CONTEXT SetNumbers(const SIZE_CONTEXT offset, const TYPENAME values[], const SIZE_CONTEXT count)
+        {
+            static_assert(std::is_scalar<TYPENAME>::value, "Only arrays of scalars can be written in one go");
+
+            const SIZE_CONTEXT length = static_cast<SIZE_CONTEXT>(count * sizeof(TYPENAME));
+
+            if (length > 0) {
+                if ((offset + length) >= _size) {
+                    Size(offset + length);
+                }
+
+                uint8_t* destination = &(_data[offset]);
+
+                if ((ReverseOrder == false) || (sizeof(TYPENAME) == 1)) {
+                    ::memcpy(destination, values, length);
+                }
+                else {
+                    const uint8_t* source = reinterpret_cast<const uint8_t*>(values);
+
+                    for (SIZE_CONTEXT index = 0; index < length; index += sizeof(TYPENAME)) {
+                        Frame::ReverseCopy<sizeof(TYPENAME)>(&(destination[index]), &(source[index]));
+                    }
+                }
+            }
+
+            return (length);
+        }
+
+        template <typename TYPENAME>
+        SIZE_CONTEXT GetNumbers(const SIZE_CONTEXT offset, TYPENAME values[], const SIZE_CONTEXT count) const
+        {
+            static_assert(std::is_scalar<TYPENAME>::value, "Only arrays of scalars can be read in one go");
+
+            const SIZE_CONTEXT length = static_cast<SIZE_CONTEXT>(count * sizeof(TYPENAME));
+            SIZE_CONTEXT available = ((offset + length) <= _size ? length : (offset < _size ? ((_size - offset) / sizeof(TYPENAME)) * sizeof(TYPENAME) : 0));
+
+            // Only on package level allowed to pass the boundaries!!!
+            ASSERT(available == length);
+
+            if (available > 0) {
+                const uint8_t* source = &(_data[offset]);
+
+                if ((ReverseOrder == false) || (sizeof(TYPENAME) == 1)) {
+                    ::memcpy(values, source, available);
+                }
+                else {
+                    uint8_t* destination = reinterpret_cast<uint8_t*>(values);
+
+                    for (SIZE_CONTEXT index = 0; index < available; index += sizeof(TYPENAME)) {
+                        Frame::ReverseCopy<sizeof(TYPENAME)>(&(destination[index]), &(source[index]));
+                    }
+                }
+            }
+            if (available < length) {
+                ::memset(&(reinterpret_cast<uint8_t*>(values)[available]), 0, length - available);
+            }
+
+            return (length);
+        }
+
 #ifdef __DEBUG__
         void Dump(const SIZE_CONTEXT offset) const
         {
@@ -814,22 +957,12 @@ namespace Core {
 
         template <typename TYPENAME>
         void SetNumberLittleEndianPlatform(const SIZE_CONTEXT offset, const TYPENAME number) {
-            const uint8_t* source = reinterpret_cast<const uint8_t*>(&number);
-            uint8_t* destination = &(_data[offset + Core::RealSize<TYPENAME>() - 1]);
-
-            for (uint8_t index = 0; index < Core::RealSize<TYPENAME>(); index++) {
-                *destination-- = *source++;
-            }
+            Frame::ReverseCopy<Core::RealSize<TYPENAME>()>(&(_data[offset]), reinterpret_cast<const uint8_t*>(&number));
         }
 
         template <typename TYPENAME>
         void SetNumberBigEndianPlatform(const SIZE_CONTEXT offset, const TYPENAME number) {
-            const uint8_t* source = reinterpret_cast<const uint8_t*>(&number);
-            uint8_t* destination = &(_data[offset]);
-
-            for (uint8_t index = 0; index < Core::RealSize<TYPENAME>(); index++) {
-                *destination++ = *source++;
-            }
+            ::memcpy(&(_data[offset]), &number, Core::RealSize<TYPENAME>());
         }
 
 
@@ -873,12 +1006,8 @@ namespace Core {
         inline TYPENAME GetNumberLittleEndianPlatform(const SIZE_CONTEXT offset) const
         {
             TYPENAME result = static_cast<TYPENAME>(0);
-            const uint8_t* source = &(_data[offset]);
-            uint8_t* destination = &(reinterpret_cast<uint8_t*>(&result)[Core::RealSize<TYPENAME>() - 1]);
 
-            for (uint8_t index = 0; index < Core::RealSize<TYPENAME>(); index++) {
-                *destination-- = *source++;
-            }
+            Frame::ReverseCopy<Core::RealSize<TYPENAME>()>(reinterpret_cast<uint8_t*>(&result), &(_data[offset]));
 
             return (result);
         }
@@ -889,12 +1018,7 @@ namespace Core {
             TYPENAME result = static_cast<TYPENAME>(0);
 
             // If the sizeof > 1, the alignment could be wrong. Assume the worst, always copy !!!
-            const uint8_t* source = &(_data[offset]);
-            uint8_t* destination = reinterpret_cast<uint8_t*>(&result);
-
-            for (uint8_t index = 0; index < Core::RealSize<TYPENAME>(); index++) {
-                *destination++ = *source++;
-            }
+            ::memcpy(&result, &(_data[offset]), Core::RealSize<TYPENAME>());
 
             return (result);
         }
@@ -924,6 +1048,12 @@ namespace Core {
         }
 
     private:
+#ifdef LITTLE_ENDIAN_PLATFORM
+        static constexpr bool ReverseOrder = BIG_ENDIAN_ORDERING;
+#else
+        static constexpr bool ReverseOrder = !BIG_ENDIAN_ORDERING;
+#endif
+
         mutable SIZE_CONTEXT _size;
         AllocatorType<BLOCKSIZE,SIZE_CONTEXT> _data;
     };
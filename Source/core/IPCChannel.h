@@ -193,6 +193,7 @@ namespace Core {
             , _clients()
             , _connector()
             , _bufferSize(bufferSize)
+            , _shareable(false)
         {
             static_assert(INTERNALFACTORY == true, "This constructor can only be called if you specify an INTERNAL factory");
 
@@ -214,6 +215,7 @@ namespace Core {
             , _clients()
             , _connector()
             , _bufferSize(bufferSize)
+            , _shareable(false)
         {
             static_assert(INTERNALFACTORY == false, "This constructor can only be called if you specify an EXTERNAL factory");
 
@@ -303,6 +305,13 @@ namespace Core {
         {
             return (_connector);
         }
+        // Allow the clients that connect from now on to move their channel over to shared memory.
+        void Shareable(const bool enabled)
+        {
+            _adminLock.Lock();
+            _shareable = enabled;
+            _adminLock.Unlock();
+        }
         void Register(const uint32_t id, const ProxyType<IIPCServer>& handler)
         {
             _adminLock.Lock();
@@ -481,6 +490,8 @@ namespace Core {
 
             ProxyType<Client> newLink(ProxyType<Client>::Create(remoteId, _bufferSize, _factory, newClient));
 
+            newLink->Shareable(_shareable);
+
             _clients.emplace(std::piecewise_construct, 
                                 std::forward_as_tuple(&(newLink->Extension())),
                                 std::forward_as_tuple(newLink));
@@ -531,6 +542,7 @@ namespace Core {
         Clients _clients;
         string _connector;
         const uint32_t _bufferSize;
+        bool _shareable;
     };
 }
 } // namespace Core
@@ -25,7 +25,9 @@
 #include "Link.h"
 #include "Module.h"
 #include "Portability.h"
+#include "SharedRing.h"
 #include "SocketPort.h"
+#include "Thread.h"
 #include "TypeTraits.h"
 
 namespace Thunder {
@@ -37,7 +39,22 @@ namespace Core {
     struct IMessage {
     public:
         typedef IMessage BaseElement;
-        typedef uint32_t Identifier;
+
+        // Every frame carries, next to the label of the message, the sequence number of the
+        // invocation it belongs to. A response echoes the sequence number of the request so
+        // multiple invocations can be outstanding on one channel.
+        struct Identifier {
+            uint32_t Label;
+            uint32_t Sequence;
+        };
+
+        static constexpr uint8_t HeaderSize = 12;
+
+        // Size of a value encoded in the 7 bits per byte header format (max 29 bits).
+        static constexpr uint8_t EncodedSize(const uint32_t value)
+        {
+            return (value > 0x1FFFFF ? 4 : (value > 0x3FFF ? 3 : (value > 0x7F ? 2 : 1)));
+        }
 
         class Serializer {
         public:
@@ -75,52 +92,34 @@ namespace Core {
                 return (true);
             }
 
+            // Drop whatever was in progress, the channel it was going out on is gone.
+            void Flush()
+            {
+                _length = 0;
+                _offset = 0;
+                _current = nullptr;
+            }
+
             // The Serialize and Deserialize methods allow the content to be serialized/deserialized.
             uint16_t Serialize(uint8_t stream[], const uint16_t maxLength)
             {
                 uint16_t result = 0;
 
                 while ((_current != nullptr) && (result < maxLength)) {
-                    if (_offset < 4) {
-                        uint32_t length = _length + CommandSize();
-
-                        // Write the length. Continue as long as the top bt is active..
-                        while ((_offset < 4) && (result < maxLength)) {
-                            uint32_t value = length >> (7 * _offset);
-                            stream[result] = ((value & 0x7F) | (value >= 0x80 ? 0x80 : 0x00));
-                            result++;
-
-                            if (value >= 0x80) {
-                                _offset++;
-                            } else {
-                                _offset = 4;
-                            }
-                        }
-                    }
-
-                    // Write the command, Same structure as length..
-                    while ((_offset < 8) && (result < maxLength)) {
-                        uint32_t value = _current->Label() >> (7 * (_offset - 4));
-                        stream[result] = ((value & 0x7F) | (value >= 0x80 ? 0x80 : 0x00));
-                        result++;
-
-                        if (value >= 0x80) {
-                            _offset++;
-                        } else {
-                            _offset = 8;
-                        }
-                    }
+                    // Write the length, the label and the sequence, all with the same structure..
+                    Encode(stream, result, maxLength, 0, _length + EncodedSize(_current->Label()) + EncodedSize(_current->Sequence()));
+                    Encode(stream, result, maxLength, 4, _current->Label());
+                    Encode(stream, result, maxLength, 8, _current->Sequence());
 
                     if (result < maxLength) {
-                        // Write the command, Same structure as length..
-                        uint16_t handled = _current->Serialize(&stream[result], maxLength - result, _offset - 8);
+                        uint16_t handled = _current->Serialize(&stream[result], maxLength - result, _offset - HeaderSize);
 
                         result += handled;
                         _offset += handled;
 
-                        ASSERT_VERBOSE((_offset - 8) <= _length, "%d <= %d", (_offset - 8), _length);
+                        ASSERT_VERBOSE((_offset - HeaderSize) <= _length, "%d <= %d", (_offset - HeaderSize), _length);
 
-                        if ((_offset - 8) == _length) {
+                        if ((_offset - HeaderSize) == _length) {
                             const IMessage* ready = _current;
                             _current = nullptr;
 
@@ -135,9 +134,21 @@ namespace Core {
             virtual void Serialized(const IMessage& element) = 0;
 
         private:
-            uint32_t CommandSize() const
+            // Write the header field that occupies the offsets [begin, begin + 4). Continue as long
+            // as the top bit is active..
+            void Encode(uint8_t stream[], uint16_t& result, const uint16_t maxLength, const uint8_t begin, const uint32_t field)
             {
-                return (_current->Label() > 0x1FFFFF ? 4 : (_current->Label() > 0xCFFF ? 3 : (_current->Label() > 0x7F ? 2 : 1)));
+                while ((_offset >= begin) && (_offset < static_cast<uint32_t>(begin + 4)) && (result < maxLength)) {
+                    uint32_t value = field >> (7 * (_offset - begin));
+                    stream[result] = ((value & 0x7F) | (value >= 0x80 ? 0x80 : 0x00));
+                    result++;
+
+                    if (value >= 0x80) {
+                        _offset++;
+                    } else {
+                        _offset = begin + 4;
+                    }
+                }
             }
 
         private:
@@ -155,6 +166,7 @@ namespace Core {
                 : _length(0)
                 , _offset(0)
                 , _label(0)
+                , _sequence(0)
                 , _current(nullptr)
             {
             }
@@ -162,63 +174,47 @@ namespace Core {
 
         public:
             virtual void Deserialized(IMessage& element) = 0;
-            virtual IMessage* Element(const uint32_t& label) = 0;
+            virtual IMessage* Element(const Identifier& identifier) = 0;
 
             uint16_t Deserialize(const uint8_t stream[], const uint16_t maxLength)
             {
                 uint16_t result = 0;
 
                 while (result < maxLength) {
-					if ((_current == nullptr) && (_offset < 8)) {
-                        // We have nothing, start by getting the length/command
-                        while ((_offset < 4) && (result < maxLength)) {
-                            _length |= ((stream[result] & (_offset == 3 ? 0xFF : 0x7F)) << (7 * _offset));
-
-                            if ((stream[result++] & 0x80) != 0) {
-                                _offset++;
-                            } else {
-                                _offset = 4;
-                            }
-                        }
-
-                        while ((_offset < 8) && (result < maxLength)) {
-                            _label |= ((stream[result] & (_offset == 7 ? 0xFF : 0x7F)) << (7 * (_offset - 4)));
-                            _length--;
-
-                            if ((stream[result++] & 0x80) != 0) {
-                                _offset++;
-                            } else {
-                                _offset = 8;
-                            }
-                        }
-
-                        if (_offset == 8) {
-                            _current = Element(_label);
+                    if ((_current == nullptr) && (_offset < HeaderSize)) {
+                        // We have nothing, start by getting the length/label/sequence
+                        Decode(stream, result, maxLength, 0, _length);
+                        Decode(stream, result, maxLength, 4, _label);
+                        Decode(stream, result, maxLength, 8, _sequence);
+
+                        if (_offset == HeaderSize) {
+                            _current = Element({ _label, _sequence });
                             _label = 0;
+                            _sequence = 0;
                         }
                     }
 
-                    if (_offset >= 8) {
+                    if (_offset >= HeaderSize) {
 
-                        ASSERT((_offset - 8) <= _length);
+                        ASSERT((_offset - HeaderSize) <= _length);
 
-                        if ((_offset - 8) < _length) {
+                        if ((_offset - HeaderSize) < _length) {
 
                             // There could be multiple packages in this frame, do not read/handle more than what fits in the frame.
-                            uint32_t tmp = _length - (_offset - 8);
+                            uint32_t tmp = _length - (_offset - HeaderSize);
                             uint16_t handled(static_cast<uint32_t>(maxLength - result) > tmp ? static_cast<uint16_t>(tmp) : (maxLength - result));
 
                             if (_current != nullptr) {
-                                handled = _current->Deserialize(&stream[result], handled, _offset - 8);
+                                handled = _current->Deserialize(&stream[result], handled, _offset - HeaderSize);
                             }
 
                             _offset += handled;
                             result += handled;
                         }
 
-                        ASSERT((_offset - 8) <= _length);
+                        ASSERT((_offset - HeaderSize) <= _length);
 
-                        if ((_offset - 8) == _length) {
+                        if ((_offset - HeaderSize) == _length) {
                             if (_current != nullptr) {
                                 IMessage* ready = _current;
                                 _current = nullptr;
@@ -232,10 +228,31 @@ namespace Core {
                 return (result);
             }
 
+        private:
+            // Read the header field that occupies the offsets [begin, begin + 4). The label and
+            // the sequence are part of the length, the length itself is not.
+            void Decode(const uint8_t stream[], uint16_t& result, const uint16_t maxLength, const uint8_t begin, uint32_t& field)
+            {
+                while ((_offset >= begin) && (_offset < static_cast<uint32_t>(begin + 4)) && (result < maxLength)) {
+                    field |= ((stream[result] & (_offset == static_cast<uint32_t>(begin + 3) ? 0xFF : 0x7F)) << (7 * (_offset - begin)));
+
+                    if (begin != 0) {
+                        _length--;
+                    }
+
+                    if ((stream[result++] & 0x80) != 0) {
+                        _offset++;
+                    } else {
+                        _offset = begin + 4;
+                    }
+                }
+            }
+
         private:
             uint32_t _length;
             uint32_t _offset;
             uint32_t _label;
+            uint32_t _sequence;
             IMessage* _current;
         };
 
@@ -243,6 +260,7 @@ namespace Core {
         virtual ~IMessage() = default;
 
         virtual uint32_t Label() const = 0;
+        virtual uint32_t Sequence() const = 0;
         virtual uint32_t Length() const = 0;
         virtual uint16_t Serialize(uint8_t[] /* stream*/, const uint16_t /* maxLength */, const uint32_t offset) const = 0;
         virtual uint16_t Deserialize(const uint8_t[] /* stream*/, const uint16_t /* maxLength */, const uint32_t offset) = 0;
@@ -252,6 +270,8 @@ namespace Core {
         virtual ~IIPC() = default;
 
         virtual uint32_t Label() const = 0;
+        virtual uint32_t Sequence() const = 0;
+        virtual void Sequence(const uint32_t sequence) = 0;
         virtual ProxyType<IMessage> IParameters() = 0;
         virtual ProxyType<IMessage> IResponse() = 0;
     };
@@ -307,6 +327,10 @@ namespace Core {
             {
                 return (REALIDENTIFIER);
             }
+            uint32_t Sequence() const override
+            {
+                return (_parent.Sequence());
+            }
             uint32_t Length() const override
             {
                 return (_Length());
@@ -419,11 +443,13 @@ PUSH_WARNING(DISABLE_WARNING_THIS_IN_MEMBER_INITIALIZER_LIST)
         IPCMessageType()
             : _parameters(*this)
             , _response(*this)
+            , _sequence(0)
         {
         }
         IPCMessageType(const PARAMETERS& info)
             : _parameters(*this, info)
             , _response(*this)
+            , _sequence(0)
         {
         }
 POP_WARNING()
@@ -453,6 +479,14 @@ POP_WARNING()
         {
             return (IDENTIFIER);
         }
+        uint32_t Sequence() const override
+        {
+            return (_sequence);
+        }
+        void Sequence(const uint32_t sequence) override
+        {
+            _sequence = sequence;
+        }
         ProxyType<IMessage> IParameters() override
         {
             return (ProxyType<IMessage>(_parameters, _parameters));
@@ -465,23 +499,61 @@ POP_WARNING()
     private:
         ParameterType _parameters;
         ResponseType _response;
+        uint32_t _sequence;
     };
 
     class EXTERNAL IPCChannel {
     public:
+        // A client can ask to move the rest of the conversation over to a pair of shared memory
+        // rings. The server creates the rings and answers with their name, or with an empty name
+        // if it can not. This request is handled by the channel itself, it never reaches the
+        // factory or the handlers of the user.
+        struct SharedRequest {
+            uint32_t Size;
+        };
+        struct SharedResponse {
+            uint32_t Size;
+            TCHAR Name[128];
+        };
+        using SharedUpgrade = IPCMessageType<0x0FFFFFFF, SharedRequest, SharedResponse>;
+
         class EXTERNAL IPCFactory {
+        public:
+            // Messages come in over the socket or over the shared memory rings, both can be in the
+            // middle of receiving an inbound message at the same time.
+            enum path : uint8_t {
+                LINK = 0,
+                RING = 1
+            };
+
         private:
             using Servers = std::map<uint32_t, ProxyType<IIPCServer>>;
+
+            // An invocation that is waiting for its response. Synchronous invocations are
+            // finalized by the thread that waits for them, asynchronous ones are done as soon
+            // as the callback has been dispatched.
+            struct Outbound {
+                ProxyType<IIPC> Message;
+                IDispatchType<IIPC>* Callback;
+                bool Synchronous;
+                bool Aborted;
+            };
+
+            using Pending = std::unordered_map<uint32_t, Outbound>;
+            using Callbacks = std::vector<std::pair<IDispatchType<IIPC>*, ProxyType<IIPC>>>;
+
             friend IPCChannel;
 
+            static constexpr uint32_t SequenceMask = 0x0FFFFFFF;
+
             inline IPCFactory()
                 : _lock()
                 , _inbound()
-                , _outbound()
-                , _callback(nullptr)
+                , _pending()
+                , _sequence(0)
                 , _factory()
                 , _handlers()
-                , _abort(false)
+                , _upgrade()
             {
             }
             inline void Factory(Core::ProxyType<FactoryType<IIPC, uint32_t>>& factory)
@@ -500,11 +572,11 @@ POP_WARNING()
             inline IPCFactory(Core::ProxyType<FactoryType<IIPC, uint32_t>>& factory)
                 : _lock()
                 , _inbound()
-                , _outbound()
-                , _callback(nullptr)
+                , _pending()
+                , _sequence(0)
                 , _factory(factory)
                 , _handlers()
-                , _abort(false)
+                , _upgrade()
             {
                 // Only creat the IPCFactory with a valid base factory
                 ASSERT(factory.IsValid());
@@ -556,32 +628,58 @@ POP_WARNING()
                 _lock.Unlock();
             }
 
+            // The channel its own handler for the SharedUpgrade request, if it offers the upgrade.
+            inline void Upgrade(const ProxyType<IIPCServer>& handler)
+            {
+                _lock.Lock();
+
+                _upgrade = handler;
+
+                _lock.Unlock();
+            }
+
             inline bool InProgress() const
             {
                 Core::SafeSyncType<Core::CriticalSection> lock(_lock);
-                return (_outbound.IsValid());
+                return (_pending.empty() == false);
+            }
+
+            inline uint32_t Outstanding() const
+            {
+                Core::SafeSyncType<Core::CriticalSection> lock(_lock);
+                return (static_cast<uint32_t>(_pending.size()));
             }
 
-            inline ProxyType<IMessage> Element(const uint32_t& identifier)
+            inline ProxyType<IMessage> Element(const IMessage::Identifier& identifier, const path source = LINK)
             {
                 ProxyType<IMessage> result;
-                uint32_t searchIdentifier(identifier >> 1);
+                uint32_t searchIdentifier(identifier.Label >> 1);
 
                 _lock.Lock();
 
-                if (identifier & 0x01) {
-                    if ((_outbound.IsValid() == true) && (_outbound->Label() == searchIdentifier)) {
-                        result = _outbound->IResponse();
+                if (identifier.Label & 0x01) {
+                    Pending::iterator index(_pending.find(identifier.Sequence));
+
+                    if ((index != _pending.end()) && (index->second.Aborted == false) && (index->second.Message->Label() == searchIdentifier)) {
+                        result = index->second.Message->IResponse();
                     } else {
-                        TRACE_L1("Unexpected response message for ID [%d].\n", searchIdentifier);
+                        // Most likely the invoker gave up waiting for this one.
+                        TRACE_L1("Unexpected response message for ID [%d], sequence [%d].\n", searchIdentifier, identifier.Sequence);
                     }
                 } else {
-                    ASSERT(_inbound.IsValid() == false);
+                    ASSERT(_inbound[source].IsValid() == false);
+
+                    ProxyType<IIPC> rpcCall;
 
-                    ProxyType<IIPC> rpcCall(_factory->Element(searchIdentifier));
+                    if (searchIdentifier != SharedUpgrade::Id()) {
+                        rpcCall = _factory->Element(searchIdentifier);
+                    } else if (_upgrade.IsValid() == true) {
+                        rpcCall = ProxyType<IIPC>(ProxyType<SharedUpgrade>::Create());
+                    }
 
                     if (rpcCall.IsValid() == true) {
-                        _inbound = rpcCall;
+                        rpcCall->Sequence(identifier.Sequence);
+                        _inbound[source] = rpcCall;
                         result = rpcCall->IParameters();
                     } else {
                         TRACE_L1("No RPC method definition for ID [%d].\n", searchIdentifier);
@@ -597,40 +695,40 @@ POP_WARNING()
             {
                 TRACE_L1("Flushing the IPC mechanims. %d", __LINE__);
 
-                _lock.Lock();
+                Abort();
 
-                _callback = nullptr;
-
-                if (_outbound.IsValid() == true) {
-                    _outbound.Release();
-                }
+                _lock.Lock();
 
-                if (_inbound.IsValid() == true) {
-                    _inbound.Release();
+                for (ProxyType<IIPC>& inbound : _inbound) {
+                    if (inbound.IsValid() == true) {
+                        inbound.Release();
+                    }
                 }
 
                 _lock.Unlock();
             }
 
-            inline uint32_t Finalize(const uint32_t status)
+            // Completes a synchronous invocation, the status is the result of the wait for it.
+            inline uint32_t Finalize(const uint32_t sequence, const uint32_t status)
             {
-                uint32_t result = status;
+                uint32_t result = Core::ERROR_NONE;
 
                 _lock.Lock();
 
-                if (_abort == true) {
-                    Flush();
-                    _abort = false;
-                    result = Core::ERROR_ASYNC_FAILED;
-                }
-                else if (_outbound.IsValid() == true) {
-                    ASSERT(status != Core::ERROR_NONE);
-                    ASSERT(_callback != nullptr);
-                    _callback = nullptr;
-                    _outbound.Release();
-                }
-                else {
-                    ASSERT(_callback == nullptr);
+                Pending::iterator index(_pending.find(sequence));
+
+                // If it is gone, the response came in, even if it was just too late for the waiter.
+                if (index != _pending.end()) {
+                    ASSERT(index->second.Synchronous == true);
+
+                    if (index->second.Aborted == true) {
+                        result = Core::ERROR_ASYNC_FAILED;
+                    } else {
+                        ASSERT(status != Core::ERROR_NONE);
+                        result = status;
+                    }
+
+                    _pending.erase(index);
                 }
 
                 _lock.Unlock();
@@ -638,80 +736,144 @@ POP_WARNING()
                 return (result);
             }
 
-            inline ProxyType<IIPCServer> ReceivedMessage(const Core::ProxyType<IMessage>& rhs, Core::ProxyType<IIPC>& inbound)
+            inline ProxyType<IIPCServer> ReceivedMessage(const Core::ProxyType<IMessage>& rhs, Core::ProxyType<IIPC>& inbound, const path source = LINK)
             {
                 ProxyType<IIPCServer> procedure;
+                IDispatchType<IIPC>* callback = nullptr;
+                ProxyType<IIPC> handledObject;
 
                 _lock.Lock();
 
-                if ((_outbound.IsValid() == true) && (_outbound->IResponse() == rhs)) {
+                Pending::iterator index((rhs->Label() & 0x01) != 0 ? _pending.find(rhs->Sequence()) : _pending.end());
 
-                    ASSERT(_callback != nullptr);
+                if ((index != _pending.end()) && (index->second.Message->IResponse() == rhs)) {
 
-                    ProxyType<IIPC> handledObject(_outbound);
+                    ASSERT(index->second.Callback != nullptr);
 
-                    _outbound.Release();
-                    _callback->Dispatch(*handledObject);
-                    _callback = nullptr;
+                    if (index->second.Synchronous == true) {
+                        // The callback lives on the stack of the waiter. Once the entry is gone, a waiter
+                        // that timed out in Finalize() returns, so it must be signalled under the lock.
+                        index->second.Callback->Dispatch(*(index->second.Message));
+                    } else {
+                        callback = index->second.Callback;
+                        handledObject = index->second.Message;
+                    }
+
+                    _pending.erase(index);
                 }
                 // If this is *NOT* the outbound call, it is inbound and thus it must have been registered
-                else if (_inbound.IsValid() == true) {
+                else if (_inbound[source].IsValid() == true) {
 
-                    Servers::iterator index(_handlers.find(_inbound->Label()));
+                    Servers::iterator entry(_handlers.find(_inbound[source]->Label()));
 
-					ASSERT(index != _handlers.end());
+                    ASSERT((entry != _handlers.end()) || (_inbound[source]->Label() == SharedUpgrade::Id()));
 
-                    if (index != _handlers.end()) {
-                        procedure = (*index).second;
-                        inbound = _inbound;
+                    if (entry != _handlers.end()) {
+                        procedure = (*entry).second;
+                        inbound = _inbound[source];
+                    } else if ((_inbound[source]->Label() == SharedUpgrade::Id()) && (_upgrade.IsValid() == true)) {
+                        procedure = _upgrade;
+                        inbound = _inbound[source];
                     } else {
-                        TRACE_L1("No handler defined to handle the incoming frames. [%d]", _inbound->Label());
+                        TRACE_L1("No handler defined to handle the incoming frames. [%d]", _inbound[source]->Label());
                     }
 
-                    _inbound.Release();
+                    _inbound[source].Release();
                 } else {
-                    ASSERT(false && "Received something that is neither an inbound nor on outbound!!!");
+                    // A response for an invocation that timed out while it was being received.
+                    TRACE_L1("Received something that is neither an inbound nor a pending outbound [%d]", rhs->Label());
                 }
 
                 _lock.Unlock();
 
+                if (callback != nullptr) {
+                    callback->Dispatch(*handledObject);
+                }
+
                 return (procedure);
             }
 
-            inline void SetOutbound(const Core::ProxyType<IIPC>& outbound, IDispatchType<IIPC>* callback)
+            // Registers an invocation and hands out the sequence number it should go out with.
+            // Returns 0 if this message is already on its way.
+            inline uint32_t SetOutbound(const Core::ProxyType<IIPC>& outbound, IDispatchType<IIPC>* callback, const bool synchronous)
             {
-                _lock.Lock();
+                uint32_t sequence = 0;
 
                 ASSERT((outbound.IsValid() == true) && (callback != nullptr));
-                ASSERT((_outbound.IsValid() == false) && (_callback == nullptr));
 
-                _outbound = outbound;
-                _callback = callback;
+                _lock.Lock();
+
+                Pending::const_iterator index(_pending.cbegin());
+
+                while ((index != _pending.cend()) && (index->second.Message != outbound)) {
+                    index++;
+                }
+
+                if (index == _pending.cend()) {
+                    do {
+                        _sequence = (_sequence + 1) & SequenceMask;
+                    } while ((_sequence == 0) || (_pending.find(_sequence) != _pending.end()));
+
+                    sequence = _sequence;
+                    outbound->Sequence(sequence);
+                    _pending.emplace(std::piecewise_construct,
+                        std::forward_as_tuple(sequence),
+                        std::forward_as_tuple(Outbound { outbound, callback, synchronous, false }));
+                }
+
+                _lock.Unlock();
+
+                return (sequence);
+            }
+
+            // Drops an invocation that never made it onto the channel.
+            inline void Revoke(const uint32_t sequence)
+            {
+                _lock.Lock();
+
+                _pending.erase(sequence);
 
                 _lock.Unlock();
             }
 
             inline void Abort()
             {
+                Callbacks callbacks;
+
                 _lock.Lock();
 
-                if (_callback != nullptr) {
-                    _abort = true;
-                    _callback->Dispatch(*_outbound);
-                    _callback = nullptr;
+                Pending::iterator index(_pending.begin());
+
+                while (index != _pending.end()) {
+                    if (index->second.Synchronous == true) {
+                        // The waiting thread cleans up, and learns from this it failed. Its callback
+                        // is only valid as long as the waiter did not finalize, so signal it here.
+                        if (index->second.Aborted == false) {
+                            index->second.Aborted = true;
+                            index->second.Callback->Dispatch(*(index->second.Message));
+                        }
+                        index++;
+                    } else {
+                        callbacks.emplace_back(index->second.Callback, index->second.Message);
+                        index = _pending.erase(index);
+                    }
                 }
 
                 _lock.Unlock();
+
+                for (auto& entry : callbacks) {
+                    entry.first->Dispatch(*(entry.second));
+                }
             }
 
         private:
             mutable CriticalSection _lock;
-            Core::ProxyType<IIPC> _inbound;
-            mutable Core::ProxyType<IIPC> _outbound;
-            IDispatchType<IIPC>* _callback;
+            Core::ProxyType<IIPC> _inbound[2];
+            Pending _pending;
+            uint32_t _sequence;
             Core::ProxyType<FactoryType<IIPC, uint32_t>> _factory;
             Servers _handlers;
-            bool _abort;
+            ProxyType<IIPCServer> _upgrade;
         };
 
     protected:
@@ -831,13 +993,7 @@ POP_WARNING()
             // Notification of a INBOUND element received.
             void Received(Core::ProxyType<IMessage>& message) override
             {
-
-                Core::ProxyType<IIPC> inbound;
-                ProxyType<IIPCServer> handler(_factory.ReceivedMessage(message, inbound));
-
-                if (handler.IsValid() == true) {
-                    _parent.CallProcedure(handler, inbound);
-                }
+                _parent.Received(message);
             }
 
             // Notification of a Response send.
@@ -851,7 +1007,9 @@ POP_WARNING()
             {
                 if (_parent.Source().IsOpen() == false) {
                     // Whatever s hapening, Flush what we were doing..
+                    _parent._shared.Close();
                     _factory.Abort();
+                    _parent._shared.Detach();
                 }
 
                 _parent.StateChange();
@@ -863,13 +1021,11 @@ POP_WARNING()
         };
         class IPCTrigger : public IDispatchType<IIPC> {
         public:
-            IPCTrigger() = delete;
             IPCTrigger(const IPCTrigger&) = delete;
             IPCTrigger& operator=(const IPCTrigger&) = delete;
 
-            IPCTrigger(IPCFactory& administration)
-                : _administration(administration)
-                , _signal(false, true)
+            IPCTrigger()
+                : _signal(false, true)
             {
             }
             ~IPCTrigger() override = default;
@@ -878,7 +1034,7 @@ POP_WARNING()
             uint32_t Wait(const uint32_t waitTime)
             {
                 // Now we wait for ever, to get a signal that we are done :-)
-                return (_administration.Finalize(_signal.Lock(waitTime)));
+                return (_signal.Lock(waitTime));
             }
             void Dispatch(IIPC& /* element */) override
             {
@@ -886,10 +1042,432 @@ POP_WARNING()
             }
 
         private:
-            IPCFactory& _administration;
             Event _signal;
         };
 
+        // Once a channel is upgraded, all messages travel over a pair of shared memory rings, each
+        // direction has its own ring and the receiving side has a thread reading it. The socket
+        // stays as it is, it is how we learn the other side went away.
+        class SharedPath : public IIPCServer, public IDispatchType<IIPC>, public IReferenceCounted {
+        private:
+            class Session : public Thread {
+            private:
+                class SerializerImpl : public IMessage::Serializer {
+                public:
+                    SerializerImpl(SerializerImpl&&) = delete;
+                    SerializerImpl(const SerializerImpl&) = delete;
+                    SerializerImpl& operator=(SerializerImpl&&) = delete;
+                    SerializerImpl& operator=(const SerializerImpl&) = delete;
+
+                    SerializerImpl()
+                        : IMessage::Serializer()
+                        , _done(true)
+                    {
+                    }
+                    ~SerializerImpl() override = default;
+
+                public:
+                    inline void Submit(const IMessage& element)
+                    {
+                        _done = false;
+                        IMessage::Serializer::Submit(element);
+                    }
+                    inline bool IsDone() const
+                    {
+                        return (_done);
+                    }
+
+                private:
+                    void Serialized(const IMessage& /* element */) override
+                    {
+                        _done = true;
+                    }
+
+                private:
+                    bool _done;
+                };
+                class DeserializerImpl : public IMessage::Deserializer {
+                public:
+                    DeserializerImpl() = delete;
+                    DeserializerImpl(DeserializerImpl&&) = delete;
+                    DeserializerImpl(const DeserializerImpl&) = delete;
+                    DeserializerImpl& operator=(DeserializerImpl&&) = delete;
+                    DeserializerImpl& operator=(const DeserializerImpl&) = delete;
+
+                    DeserializerImpl(IPCChannelType<ACTUALSOURCE, EXTENSION>& channel)
+                        : IMessage::Deserializer()
+                        , _channel(channel)
+                        , _current()
+                    {
+                    }
+                    ~DeserializerImpl() override = default;
+
+                public:
+                    void Deserialized(IMessage& element) override
+                    {
+                        DEBUG_VARIABLE(element);
+                        ASSERT(&element == &(*_current));
+
+                        _channel.Received(_current, IPCFactory::RING);
+
+                        _current.Release();
+                    }
+                    IMessage* Element(const IMessage::Identifier& identifier) override
+                    {
+                        _current = _channel._administration.Element(identifier, IPCFactory::RING);
+
+                        return (_current.IsValid() == true ? &(*_current) : nullptr);
+                    }
+
+                private:
+                    IPCChannelType<ACTUALSOURCE, EXTENSION>& _channel;
+                    ProxyType<IMessage> _current;
+                };
+
+                // Whatever we wait for, check if the rings got closed at least this often.
+                static constexpr uint32_t WaitSlice = 100;
+
+            public:
+                Session() = delete;
+                Session(Session&&) = delete;
+                Session(const Session&) = delete;
+                Session& operator=(Session&&) = delete;
+                Session& operator=(const Session&) = delete;
+
+                // The server creates the rings, it only starts using them once the client does.
+                Session(IPCChannelType<ACTUALSOURCE, EXTENSION>& channel, const string& name, const uint32_t size)
+                    : Thread(Thread::DefaultStackSize(), _T("IPCSharedRing"))
+                    , _inbound(name + _T(".0"), 0, size)
+                    , _outbound(name + _T(".1"), 0, size)
+                    , _writeLock()
+                    , _serializer()
+                    , _deserializer(channel)
+                    , _name(name)
+                    , _active(false)
+                {
+                }
+                // The client opens the rings the server created, and uses them right away.
+                Session(IPCChannelType<ACTUALSOURCE, EXTENSION>& channel, const string& name)
+                    : Thread(Thread::DefaultStackSize(), _T("IPCSharedRing"))
+                    , _inbound(name + _T(".1"))
+                    , _outbound(name + _T(".0"))
+                    , _writeLock()
+                    , _serializer()
+                    , _deserializer(channel)
+                    , _name()
+                    , _active(true)
+                {
+                }
+                ~Session() override
+                {
+                    Close();
+                    Wait();
+                    Remove();
+                }
+
+            public:
+                inline bool IsValid() const
+                {
+                    return ((_inbound.IsValid() == true) && (_outbound.IsValid() == true));
+                }
+                inline bool IsActive() const
+                {
+                    return (_active.load(std::memory_order_acquire));
+                }
+                inline uint32_t Capacity() const
+                {
+                    return (_outbound.Capacity());
+                }
+                bool Submit(const ProxyType<IMessage>& message)
+                {
+                    bool sent = false;
+
+                    _writeLock.Lock();
+
+                    if (_outbound.IsClosed() == false) {
+
+                        _serializer.Submit(*message);
+
+                        while ((_serializer.IsDone() == false) && (_outbound.IsClosed() == false)) {
+                            uint8_t* buffer;
+                            const uint32_t space = _outbound.Reserve(buffer);
+
+                            if (space == 0) {
+                                _outbound.WaitForSpace(WaitSlice);
+                            } else {
+                                _outbound.Produced(_serializer.Serialize(buffer, static_cast<uint16_t>(std::min(space, static_cast<uint32_t>(0xFFFF)))));
+                            }
+                        }
+
+                        sent = _serializer.IsDone();
+
+                        if (sent == false) {
+                            _serializer.Flush();
+                        }
+                    }
+
+                    _writeLock.Unlock();
+
+                    return (sent);
+                }
+                // Closing the rings wakes up all that wait on them, on both sides.
+                void Close()
+                {
+                    Thread::Stop();
+
+                    _inbound.Close();
+                    _outbound.Close();
+                }
+                void Wait()
+                {
+                    if (Thread::Id() != Thread::ThreadId()) {
+                        Thread::Wait(Thread::STOPPED, Core::infinite);
+                    }
+                }
+
+            private:
+                uint32_t Worker() override
+                {
+                    if (_inbound.WaitForData(WaitSlice) == true) {
+                        const uint8_t* buffer;
+                        const uint32_t length = std::min(_inbound.Peek(buffer), static_cast<uint32_t>(0xFFFF));
+
+                        if (_active.load(std::memory_order_relaxed) == false) {
+                            // The client is on the rings, from now on we answer over them as well.
+                            Remove();
+                            _active.store(true, std::memory_order_release);
+                        }
+
+                        _inbound.Consumed(_deserializer.Deserialize(buffer, static_cast<uint16_t>(length)));
+                    }
+
+                    return (_inbound.IsClosed() == true ? Core::infinite : 0);
+                }
+                // Both sides have the rings mapped (or the conversation is over), no need to keep the files.
+                void Remove()
+                {
+                    if (_name.empty() == false) {
+                        File(_inbound.Name()).Destroy();
+                        File(_outbound.Name()).Destroy();
+                        _name.clear();
+                    }
+                }
+
+            private:
+                SharedRing _inbound;
+                SharedRing _outbound;
+                CriticalSection _writeLock;
+                SerializerImpl _serializer;
+                DeserializerImpl _deserializer;
+                string _name;
+                std::atomic<bool> _active;
+            };
+
+        public:
+            SharedPath() = delete;
+            SharedPath(SharedPath&&) = delete;
+            SharedPath(const SharedPath&) = delete;
+            SharedPath& operator=(SharedPath&&) = delete;
+            SharedPath& operator=(const SharedPath&) = delete;
+
+            SharedPath(IPCChannelType<ACTUALSOURCE, EXTENSION>& channel)
+                : _channel(channel)
+                , _lock()
+                , _session()
+                , _shareable(false)
+                , _engaged(false)
+                , _request()
+                , _completed(nullptr)
+            {
+            }
+            ~SharedPath() override
+            {
+                Detach();
+            }
+
+        public:
+            uint32_t AddRef() const override
+            {
+                return (Core::ERROR_COMPOSIT_OBJECT);
+            }
+            uint32_t Release() const override
+            {
+                return (Core::ERROR_COMPOSIT_OBJECT);
+            }
+            inline void Shareable(const bool enabled)
+            {
+                _shareable.store(enabled, std::memory_order_relaxed);
+            }
+            inline bool IsActive() const
+            {
+                bool result = false;
+
+                if (_engaged.load(std::memory_order_acquire) == true) {
+                    _lock.Lock();
+                    result = ((_session.IsValid() == true) && (_session->IsActive() == true));
+                    _lock.Unlock();
+                }
+
+                return (result);
+            }
+            // Client side, ask for the upgrade and wait for it to be done.
+            uint32_t Upgrade(const uint32_t size, const uint32_t waitTime)
+            {
+                ProxyType<SharedUpgrade> request(ProxyType<SharedUpgrade>::Create());
+
+                request->Parameters().Size = size;
+
+                uint32_t result = _channel.Invoke(request, waitTime);
+
+                if (result == Core::ERROR_NONE) {
+                    result = Attach(request->Response());
+                }
+
+                return (result);
+            }
+            // Client side, ask for the upgrade and report through the callback once it is done.
+            uint32_t Upgrade(const uint32_t size, IDispatchType<IIPC>* completed)
+            {
+                ASSERT(completed != nullptr);
+
+                _request = ProxyType<SharedUpgrade>::Create();
+                _request->Parameters().Size = size;
+                _completed = completed;
+
+                return (_channel.Invoke(_request, this));
+            }
+            // Returns false if the message should go over the socket.
+            bool Submit(const ProxyType<IMessage>& message)
+            {
+                bool sent = false;
+
+                if (_engaged.load(std::memory_order_acquire) == true) {
+                    _lock.Lock();
+                    ProxyType<Session> session(_session);
+                    _lock.Unlock();
+
+                    if ((session.IsValid() == true) && (session->IsActive() == true)) {
+                        sent = session->Submit(message);
+                    }
+                }
+
+                return (sent);
+            }
+            // Stop using the rings, whoever still waits on them is woken up.
+            void Close()
+            {
+                _lock.Lock();
+
+                if (_session.IsValid() == true) {
+                    _session->Close();
+                }
+
+                _lock.Unlock();
+            }
+            void Detach()
+            {
+                _lock.Lock();
+
+                ProxyType<Session> session(std::move(_session));
+                _engaged.store(false, std::memory_order_release);
+
+                _lock.Unlock();
+
+                if (session.IsValid() == true) {
+                    session->Close();
+                    session->Wait();
+                }
+            }
+
+        private:
+            // Server side, the client asks for the upgrade.
+            void Procedure(IPCChannel& channel, ProxyType<IIPC>& data) override
+            {
+                ProxyType<SharedUpgrade> message(data);
+                SharedResponse& response(message->Response());
+
+                response.Size = 0;
+                response.Name[0] = '\0';
+
+                _lock.Lock();
+
+                // Unless this side opted in, the answer is an empty name and the client stays on the socket.
+                if ((_session.IsValid() == false) && (_shareable.load(std::memory_order_relaxed) == true)) {
+                    const string name(SharedRing::TemporaryName());
+                    ProxyType<Session> session(ProxyType<Session>::Create(_channel, name, message->Parameters().Size));
+
+                    if (session->IsValid() == true) {
+                        ASSERT(name.length() < (sizeof(response.Name) / sizeof(TCHAR)));
+
+                        response.Size = session->Capacity();
+                        _tcsncpy(response.Name, name.c_str(), (sizeof(response.Name) / sizeof(TCHAR)) - 1);
+                        response.Name[(sizeof(response.Name) / sizeof(TCHAR)) - 1] = '\0';
+
+                        session->Run();
+
+                        _session = session;
+                        _engaged.store(true, std::memory_order_release);
+                    }
+                }
+
+                _lock.Unlock();
+
+                // The session is not active until the client uses it, so this goes over the socket.
+                channel.ReportResponse(data);
+            }
+            // Client side, the answer to our asynchronous request came in (or the request failed).
+            void Dispatch(IIPC& element) override
+            {
+                IDispatchType<IIPC>* completed = _completed;
+
+                Attach(_request->Response());
+
+                _completed = nullptr;
+                _request.Release();
+
+                if (completed != nullptr) {
+                    completed->Dispatch(element);
+                }
+            }
+            uint32_t Attach(SharedResponse& response)
+            {
+                uint32_t result = Core::ERROR_UNAVAILABLE;
+
+                response.Name[(sizeof(response.Name) / sizeof(TCHAR)) - 1] = '\0';
+
+                if ((response.Size != 0) && (response.Name[0] != '\0')) {
+                    ProxyType<Session> session(ProxyType<Session>::Create(_channel, string(response.Name)));
+
+                    if ((session->IsValid() == false) || (session->Capacity() != response.Size)) {
+                        result = Core::ERROR_OPENING_FAILED;
+                    } else {
+                        _lock.Lock();
+
+                        ASSERT(_session.IsValid() == false);
+
+                        session->Run();
+                        _session = session;
+                        _engaged.store(true, std::memory_order_release);
+
+                        _lock.Unlock();
+
+                        result = Core::ERROR_NONE;
+                    }
+                }
+
+                return (result);
+            }
+
+        private:
+            IPCChannelType<ACTUALSOURCE, EXTENSION>& _channel;
+            mutable CriticalSection _lock;
+            ProxyType<Session> _session;
+            std::atomic<bool> _shareable;
+            std::atomic<bool> _engaged;
+            ProxyType<SharedUpgrade> _request;
+            IDispatchType<IIPC>* _completed;
+        };
+
     public:
         IPCChannelType(const IPCChannelType<ACTUALSOURCE, EXTENSION>&) = delete;
         IPCChannelType<ACTUALSOURCE, EXTENSION>& operator=(const IPCChannelType<ACTUALSOURCE, EXTENSION>&) = delete;
@@ -900,18 +1478,25 @@ PUSH_WARNING(DISABLE_WARNING_THIS_IN_MEMBER_INITIALIZER_LIST)
             : IPCChannel()
             , _link(this, &_administration, std::forward<Args>(args)...)
             , _extension(this)
+            , _shared(*this)
         {
+            _administration.Upgrade(ProxyType<IIPCServer>(static_cast<IReferenceCounted&>(_shared), static_cast<IIPCServer&>(_shared)));
         }
         template <typename... Args>
         IPCChannelType(Core::ProxyType<FactoryType<IIPC, uint32_t>>& factory, Args&&... args)
             : IPCChannel(factory)
             , _link(this, &_administration, std::forward<Args>(args)...)
             , _extension(this)
+            , _shared(*this)
         {
+            _administration.Upgrade(ProxyType<IIPCServer>(static_cast<IReferenceCounted&>(_shared), static_cast<IIPCServer&>(_shared)));
         }
 POP_WARNING()
 
-        ~IPCChannelType() override = default;
+        ~IPCChannelType() override
+        {
+            _administration.Upgrade(ProxyType<IIPCServer>());
+        }
 
     public:
         inline EXTENSION& Extension()
@@ -943,10 +1528,35 @@ POP_WARNING()
         inline uint32_t ReportResponse(Core::ProxyType<IIPC>& inbound) override
         {
             // We got the event, start the invoke, wait for the event to be set again..
-            _link.SendResponse(inbound);
+            if (_shared.Submit(inbound->IResponse()) == false) {
+                _link.SendResponse(inbound);
+            }
 
             return (Core::ERROR_NONE);
         }
+        // Move the traffic on this channel over to a pair of shared memory rings of (at least) the
+        // given size. Only makes sense if the other side runs on the same system. If the other side
+        // can not offer it, the channel simply stays on the socket.
+        inline uint32_t Upgrade(const uint32_t size, const uint32_t waitTime)
+        {
+            return (_shared.Upgrade(size, waitTime));
+        }
+        // Same as above, but the completion is reported through the callback, so this can be
+        // started from the thread that handles the socket.
+        inline uint32_t Upgrade(const uint32_t size, IDispatchType<IIPC>* completed)
+        {
+            return (_shared.Upgrade(size, completed));
+        }
+        inline bool IsShared() const
+        {
+            return (_shared.IsActive());
+        }
+        // Server side, only if enabled a client can move this channel over to shared memory. The
+        // rings are created by this process and accessible by its user only.
+        inline void Shareable(const bool enabled)
+        {
+            _shared.Shareable(enabled);
+        }
         bool IsOpen() const override
         {
             return _link.IsOpen();
@@ -1010,68 +1620,79 @@ POP_WARNING()
             return (unknown);
         }
 
+        // Any number of invocations can be outstanding on the channel, each waits for its own
+        // response, matched on the sequence number, so a slow one does not hold up the others.
         uint32_t Execute(const ProxyType<IIPC>& command, IDispatchType<IIPC>* completed) override
         {
             uint32_t success = Core::ERROR_NONE;
 
-            _serialize.Lock();
+            // We need to accept a CONST object to avoid an additional object creation
+            // proxy casted objects.
+            const uint32_t sequence = _administration.SetOutbound(command, completed, false);
 
-            if (_administration.InProgress() == true) {
+            if (sequence == 0) {
                 success = Core::ERROR_INPROGRESS;
             }
+            else if (_link.IsOpen() == true) {
+                Send(command->IParameters());
+            }
             else {
-                // We need to accept a CONST object to avoid an additional object creation
-                // proxy casted objects.
-                _administration.SetOutbound(command, completed);
-
-                if (_link.IsOpen() == true) {
-                    _link.Submit(command->IParameters());
-                }
-                else {
-                    _administration.Flush();
+                _administration.Revoke(sequence);
 
-                    success = Core::ERROR_CONNECTION_CLOSED;
-                }
+                success = Core::ERROR_CONNECTION_CLOSED;
             }
 
-            _serialize.Unlock();
-
             return (success);
         }
         uint32_t Execute(const ProxyType<IIPC>& command, const uint32_t waitTime) override
         {
             uint32_t success = Core::ERROR_CONNECTION_CLOSED;
 
-            _serialize.Lock();
-
-            IPCTrigger sink(_administration);
+            IPCTrigger sink;
 
             // We need to accept a CONST object to avoid an additional object creation
             // proxy casted objects.
-            _administration.SetOutbound(command, &sink);
+            const uint32_t sequence = _administration.SetOutbound(command, &sink, true);
 
-            if (_link.IsOpen() == true) {
-                _link.Submit(command->IParameters());
+            if (sequence == 0) {
+                success = Core::ERROR_INPROGRESS;
+            }
+            else if (_link.IsOpen() == true) {
+                Send(command->IParameters());
 
-                success = sink.Wait(waitTime);
+                success = _administration.Finalize(sequence, sink.Wait(waitTime));
             }
             else {
-                _administration.Flush();
+                _administration.Revoke(sequence);
             }
 
-            _serialize.Unlock();
-
             return (success);
         }
+        void Send(const ProxyType<IMessage>& message)
+        {
+            if (_shared.Submit(message) == false) {
+                _link.Submit(message);
+            }
+        }
+        // Whatever it came in over, socket or shared ring, this is where an inbound message lands.
+        void Received(ProxyType<IMessage>& message, const IPCFactory::path source = IPCFactory::LINK)
+        {
+            Core::ProxyType<IIPC> inbound;
+            ProxyType<IIPCServer> handler(_administration.ReceivedMessage(message, inbound, source));
+
+            if (handler.IsValid() == true) {
+                CallProcedure(handler, inbound);
+            }
+        }
         void CallProcedure(ProxyType<IIPCServer>& procedure, ProxyType<IIPC>& message)
         {
             procedure->Procedure(*this, message);
         }
 
     private:
-        CriticalSection _serialize;
         IPCLink _link;
         EXTENSION _extension;
+        SharedPath _shared;
     };
 }
 } // namespace Core
@@ -18,9 +18,18 @@
  */
 
 #include "JSON.h"
+#include <cfloat>
 #include <iomanip>
 #include <sstream>
 
+#if defined(__SSE2__) || defined(_M_X64)
+#include <emmintrin.h>
+#define __JSON_SCAN_SSE2__
+#elif defined(__aarch64__) && defined(__ARM_NEON)
+#include <arm_neon.h>
+#define __JSON_SCAN_NEON__
+#endif
+
 namespace Thunder {
 namespace Core {
     namespace JSON {
@@ -37,6 +46,670 @@ namespace Core {
         }
 
 
+        namespace {
+
+            // Per byte equivalents of the vector kernels below, also used for the tails.
+            inline bool IsVerbatimOut(const uint8_t character)
+            {
+                return ((character >= 0x20) && (character <= 0x7E) && (character != '\"') && (character != '\\')
+            #ifndef __DISABLE_USE_COMPLEMENTARY_CODE_SET__
+                    && (character != '/')
+            #endif
+                    );
+            }
+
+            inline bool IsVerbatimIn(const uint8_t character)
+            {
+                return ((character > 0x1F) && (character != '\"') && (character != '\\'));
+            }
+
+        #if defined(__JSON_SCAN_SSE2__)
+
+            inline uint32_t FirstSet(const uint32_t mask)
+            {
+            #ifdef _MSC_VER
+                unsigned long index;
+                _BitScanForward(&index, mask);
+                return (static_cast<uint32_t>(index));
+            #else
+                return (static_cast<uint32_t>(__builtin_ctz(mask)));
+            #endif
+            }
+
+            uint32_t ScanOut(const uint8_t text[], const uint32_t length)
+            {
+                const __m128i quote = _mm_set1_epi8('\"');
+                const __m128i backslash = _mm_set1_epi8('\\');
+            #ifndef __DISABLE_USE_COMPLEMENTARY_CODE_SET__
+                const __m128i slash = _mm_set1_epi8('/');
+            #endif
+                const __m128i low = _mm_set1_epi8(0x1F);
+                const __m128i high = _mm_set1_epi8(0x7F);
+                uint32_t index = 0;
+
+                while ((index + 16) <= length) {
+                    const __m128i chunk = _mm_loadu_si128(reinterpret_cast<const __m128i*>(&text[index]));
+
+                    // Signed compares: everything from 0x80 onwards is negative, so fails the first test.
+                    __m128i stop = _mm_andnot_si128(_mm_and_si128(_mm_cmpgt_epi8(chunk, low), _mm_cmplt_epi8(chunk, high)), _mm_set1_epi8(-1));
+                    stop = _mm_or_si128(stop, _mm_or_si128(_mm_cmpeq_epi8(chunk, quote), _mm_cmpeq_epi8(chunk, backslash)));
+            #ifndef __DISABLE_USE_COMPLEMENTARY_CODE_SET__
+                    stop = _mm_or_si128(stop, _mm_cmpeq_epi8(chunk, slash));
+            #endif
+                    const uint32_t mask = static_cast<uint32_t>(_mm_movemask_epi8(stop));
+
+                    if (mask != 0) {
+                        return (index + FirstSet(mask));
+                    }
+                    index += 16;
+                }
+
+                while ((index < length) && (IsVerbatimOut(text[index]) == true)) {
+                    index++;
+                }
+
+                return (index);
+            }
+
+            uint32_t ScanIn(const uint8_t text[], const uint32_t length)
+            {
+                const __m128i quote = _mm_set1_epi8('\"');
+                const __m128i backslash = _mm_set1_epi8('\\');
+                const __m128i control = _mm_set1_epi8(0x1F);
+                uint32_t index = 0;
+
+                while ((index + 16) <= length) {
+                    const __m128i chunk = _mm_loadu_si128(reinterpret_cast<const __m128i*>(&text[index]));
+
+                    // Unsigned (character <= 0x1F) is (min(character, 0x1F) == character)
+                    __m128i stop = _mm_cmpeq_epi8(_mm_min_epu8(chunk, control), chunk);
+                    stop = _mm_or_si128(stop, _mm_or_si128(_mm_cmpeq_epi8(chunk, quote), _mm_cmpeq_epi8(chunk, backslash)));
+
+                    const uint32_t mask = static_cast<uint32_t>(_mm_movemask_epi8(stop));
+
+                    if (mask != 0) {
+                        return (index + FirstSet(mask));
+                    }
+                    index += 16;
+                }
+
+                while ((index < length) && (IsVerbatimIn(text[index]) == true)) {
+                    index++;
+                }
+
+                return (index);
+            }
+
+        #elif defined(__JSON_SCAN_NEON__)
+
+            inline uint64_t StopMask(const uint8x16_t stop)
+            {
+                // Narrow every byte lane to a nibble, so the first set lane is found with a count of zeros.
+                return (vget_lane_u64(vreinterpret_u64_u8(vshrn_n_u16(vreinterpretq_u16_u8(stop), 4)), 0));
+            }
+
+            uint32_t ScanOut(const uint8_t text[], const uint32_t length)
+            {
+                uint32_t index = 0;
+
+                while ((index + 16) <= length) {
+                    const uint8x16_t chunk = vld1q_u8(&text[index]);
+
+                    uint8x16_t stop = vorrq_u8(vcltq_u8(chunk, vdupq_n_u8(0x20)), vcgtq_u8(chunk, vdupq_n_u8(0x7E)));
+                    stop = vorrq_u8(stop, vorrq_u8(vceqq_u8(chunk, vdupq_n_u8('\"')), vceqq_u8(chunk, vdupq_n_u8('\\'))));
+            #ifndef __DISABLE_USE_COMPLEMENTARY_CODE_SET__
+                    stop = vorrq_u8(stop, vceqq_u8(chunk, vdupq_n_u8('/')));
+            #endif
+                    const uint64_t mask = StopMask(stop);
+
+                    if (mask != 0) {
+                        return (index + static_cast<uint32_t>(__builtin_ctzll(mask) >> 2));
+                    }
+                    index += 16;
+                }
+
+                while ((index < length) && (IsVerbatimOut(text[index]) == true)) {
+                    index++;
+                }
+
+                return (index);
+            }
+
+            uint32_t ScanIn(const uint8_t text[], const uint32_t length)
+            {
+                uint32_t index = 0;
+
+                while ((index + 16) <= length) {
+                    const uint8x16_t chunk = vld1q_u8(&text[index]);
+
+                    uint8x16_t stop = vcleq_u8(chunk, vdupq_n_u8(0x1F));
+                    stop = vorrq_u8(stop, vorrq_u8(vceqq_u8(chunk, vdupq_n_u8('\"')), vceqq_u8(chunk, vdupq_n_u8('\\'))));
+
+                    const uint64_t mask = StopMask(stop);
+
+                    if (mask != 0) {
+                        return (index + static_cast<uint32_t>(__builtin_ctzll(mask) >> 2));
+                    }
+                    index += 16;
+                }
+
+                while ((index < length) && (IsVerbatimIn(text[index]) == true)) {
+                    index++;
+                }
+
+                return (index);
+            }
+
+        #else
+
+            uint32_t ScanOut(const uint8_t text[], const uint32_t length)
+            {
+                uint32_t index = 0;
+
+                while ((index < length) && (IsVerbatimOut(text[index]) == true)) {
+                    index++;
+                }
+
+                return (index);
+            }
+
+            uint32_t ScanIn(const uint8_t text[], const uint32_t length)
+            {
+                uint32_t index = 0;
+
+                while ((index < length) && (IsVerbatimIn(text[index]) == true)) {
+                    index++;
+                }
+
+                return (index);
+            }
+
+        #endif
+
+        }
+
+        /* static */ uint32_t String::VerbatimOut(const char text[], const uint32_t length)
+        {
+            return (ScanOut(reinterpret_cast<const uint8_t*>(text), length));
+        }
+
+        /* static */ uint32_t String::VerbatimIn(const char text[], const uint32_t length)
+        {
+            return (ScanIn(reinterpret_cast<const uint8_t*>(text), length));
+        }
+
+        namespace {
+
+            constexpr char DigitPairs[] =
+                "00010203040506070809"
+                "10111213141516171819"
+                "20212223242526272829"
+                "30313233343536373839"
+                "40414243444546474849"
+                "50515253545556575859"
+                "60616263646566676869"
+                "70717273747576777879"
+                "80818283848586878889"
+                "90919293949596979899";
+
+            constexpr uint64_t Powers10[] = {
+                1ULL, 10ULL, 100ULL, 1000ULL, 10000ULL, 100000ULL, 1000000ULL, 10000000ULL, 100000000ULL, 1000000000ULL,
+                10000000000ULL, 100000000000ULL, 1000000000000ULL, 10000000000000ULL, 100000000000000ULL,
+                1000000000000000ULL, 10000000000000000ULL, 100000000000000000ULL, 1000000000000000000ULL,
+                10000000000000000000ULL
+            };
+
+            // All exact, both as float (up to 1e10) and as double.
+            constexpr double FloatPowers10[] = {
+                1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11,
+                1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22
+            };
+
+            uint8_t DecimalDigits(const uint64_t value)
+            {
+                uint8_t digits = 1;
+
+                while ((digits < 20) && (value >= Powers10[digits])) {
+                    digits++;
+                }
+
+                return (digits);
+            }
+
+            // Grisu2 (Florian Loitsch, "Printing Floating-Point Numbers Quickly and Accurately
+            // with Integers"): the digits always read back to the same value and are the shortest
+            // such digits for all but a fraction of a percent of the values.
+            struct DiyFp {
+                uint64_t f;
+                int e;
+
+                DiyFp Normalize() const
+                {
+                    DiyFp result = *this;
+
+                    while ((result.f & (1ULL << 63)) == 0) {
+                        result.f <<= 1;
+                        result.e--;
+                    }
+
+                    return (result);
+                }
+
+                DiyFp operator-(const DiyFp& rhs) const
+                {
+                    return (DiyFp{ f - rhs.f, e });
+                }
+
+                DiyFp operator*(const DiyFp& rhs) const
+                {
+                    const uint64_t M32 = 0xFFFFFFFF;
+                    const uint64_t a = f >> 32;
+                    const uint64_t b = f & M32;
+                    const uint64_t c = rhs.f >> 32;
+                    const uint64_t d = rhs.f & M32;
+                    const uint64_t ac = a * c;
+                    const uint64_t bc = b * c;
+                    const uint64_t ad = a * d;
+                    const uint64_t bd = b * d;
+                    uint64_t tmp = (bd >> 32) + (ad & M32) + (bc & M32);
+                    tmp += 1U << 31; // Round
+
+                    return (DiyFp{ ac + (ad >> 32) + (bc >> 32) + (tmp >> 32), e + rhs.e + 64 });
+                }
+            };
+
+            // Normalized 10^k, for k = -348, -340, ..., 340.
+            constexpr DiyFp CachedPowers[] = {
+                { 0xFA8FD5A0081C0288, -1220 }, { 0xBAAEE17FA23EBF76, -1193 }, { 0x8B16FB203055AC76, -1166 }, { 0xCF42894A5DCE35EA, -1140 },
+                { 0x9A6BB0AA55653B2D, -1113 }, { 0xE61ACF033D1A45DF, -1087 }, { 0xAB70FE17C79AC6CA, -1060 }, { 0xFF77B1FCBEBCDC4F, -1034 },
+                { 0xBE5691EF416BD60C, -1007 }, { 0x8DD01FAD907FFC3C, -980 }, { 0xD3515C2831559A83, -954 }, { 0x9D71AC8FADA6C9B5, -927 },
+                { 0xEA9C227723EE8BCB, -901 }, { 0xAECC49914078536D, -874 }, { 0x823C12795DB6CE57, -847 }, { 0xC21094364DFB5637, -821 },
+                { 0x9096EA6F3848984F, -794 }, { 0xD77485CB25823AC7, -768 }, { 0xA086CFCD97BF97F4, -741 }, { 0xEF340A98172AACE5, -715 },
+                { 0xB23867FB2A35B28E, -688 }, { 0x84C8D4DFD2C63F3B, -661 }, { 0xC5DD44271AD3CDBA, -635 }, { 0x936B9FCEBB25C996, -608 },
+                { 0xDBAC6C247D62A584, -582 }, { 0xA3AB66580D5FDAF6, -555 }, { 0xF3E2F893DEC3F126, -529 }, { 0xB5B5ADA8AAFF80B8, -502 },
+                { 0x87625F056C7C4A8B, -475 }, { 0xC9BCFF6034C13053, -449 }, { 0x964E858C91BA2655, -422 }, { 0xDFF9772470297EBD, -396 },
+                { 0xA6DFBD9FB8E5B88F, -369 }, { 0xF8A95FCF88747D94, -343 }, { 0xB94470938FA89BCF, -316 }, { 0x8A08F0F8BF0F156B, -289 },
+                { 0xCDB02555653131B6, -263 }, { 0x993FE2C6D07B7FAC, -236 }, { 0xE45C10C42A2B3B06, -210 }, { 0xAA242499697392D3, -183 },
+                { 0xFD87B5F28300CA0E, -157 }, { 0xBCE5086492111AEB, -130 }, { 0x8CBCCC096F5088CC, -103 }, { 0xD1B71758E219652C, -77 },
+                { 0x9C40000000000000, -50 }, { 0xE8D4A51000000000, -24 }, { 0xAD78EBC5AC620000, 3 }, { 0x813F3978F8940984, 30 },
+                { 0xC097CE7BC90715B3, 56 }, { 0x8F7E32CE7BEA5C70, 83 }, { 0xD5D238A4ABE98068, 109 }, { 0x9F4F2726179A2245, 136 },
+                { 0xED63A231D4C4FB27, 162 }, { 0xB0DE65388CC8ADA8, 189 }, { 0x83C7088E1AAB65DB, 216 }, { 0xC45D1DF942711D9A, 242 },
+                { 0x924D692CA61BE758, 269 }, { 0xDA01EE641A708DEA, 295 }, { 0xA26DA3999AEF774A, 322 }, { 0xF209787BB47D6B85, 348 },
+                { 0xB454E4A179DD1877, 375 }, { 0x865B86925B9BC5C2, 402 }, { 0xC83553C5C8965D3D, 428 }, { 0x952AB45CFA97A0B3, 455 },
+                { 0xDE469FBD99A05FE3, 481 }, { 0xA59BC234DB398C25, 508 }, { 0xF6C69A72A3989F5C, 534 }, { 0xB7DCBF5354E9BECE, 561 },
+                { 0x88FCF317F22241E2, 588 }, { 0xCC20CE9BD35C78A5, 614 }, { 0x98165AF37B2153DF, 641 }, { 0xE2A0B5DC971F303A, 667 },
+                { 0xA8D9D1535CE3B396, 694 }, { 0xFB9B7CD9A4A7443C, 720 }, { 0xBB764C4CA7A44410, 747 }, { 0x8BAB8EEFB6409C1A, 774 },
+                { 0xD01FEF10A657842C, 800 }, { 0x9B10A4E5E9913129, 827 }, { 0xE7109BFBA19C0C9D, 853 }, { 0xAC2820D9623BF429, 880 },
+                { 0x80444B5E7AA7CF85, 907 }, { 0xBF21E44003ACDD2D, 933 }, { 0x8E679C2F5E44FF8F, 960 }, { 0xD433179D9C8CB841, 986 },
+                { 0x9E19DB92B4E31BA9, 1013 }, { 0xEB96BF6EBADF77D9, 1039 }, { 0xAF87023B9BF0EE6B, 1066 }
+            };
+
+            // Value and its boundaries (the halfway points to its neighbours), all sharing the exponent of the upper one.
+            template <typename TYPE, typename BITS, const uint8_t SIGNIFICAND, const int BIAS>
+            void Boundaries(const TYPE value, DiyFp& v, DiyFp& minus, DiyFp& plus)
+            {
+                constexpr uint64_t HiddenBit = (1ULL << SIGNIFICAND);
+
+                BITS bits;
+                ::memcpy(&bits, &value, sizeof(bits));
+
+                const uint64_t fraction = (bits & (HiddenBit - 1));
+                const int exponent = static_cast<int>((bits >> SIGNIFICAND) & ((1U << ((sizeof(BITS) * 8) - 1 - SIGNIFICAND)) - 1));
+
+                if (exponent != 0) {
+                    v = DiyFp{ fraction | HiddenBit, exponent - BIAS - SIGNIFICAND };
+                }
+                else {
+                    v = DiyFp{ fraction, 1 - BIAS - SIGNIFICAND };
+                }
+
+                plus = DiyFp{ (v.f << 1) + 1, v.e - 1 };
+                while ((plus.f & (HiddenBit << 1)) == 0) {
+                    plus.f <<= 1;
+                    plus.e--;
+                }
+                plus.f <<= (64 - SIGNIFICAND - 2);
+                plus.e -= (64 - SIGNIFICAND - 2);
+
+                minus = (v.f == HiddenBit ? DiyFp{ (v.f << 2) - 1, v.e - 2 } : DiyFp{ (v.f << 1) - 1, v.e - 1 });
+                minus.f <<= (minus.e - plus.e);
+                minus.e = plus.e;
+
+                v = v.Normalize();
+            }
+
+            void Round(char buffer[], const uint8_t length, const uint64_t delta, uint64_t rest, const uint64_t tenKappa, const uint64_t distance)
+            {
+                while ((rest < distance) && ((delta - rest) >= tenKappa) && (((rest + tenKappa) < distance) || ((distance - rest) > (rest + tenKappa - distance)))) {
+                    buffer[length - 1]--;
+                    rest += tenKappa;
+                }
+            }
+
+            // Digits of the value, the decimal exponent (value = digits * 10^K) is returned in K.
+            uint8_t Grisu2(const DiyFp& v, const DiyFp& minus, const DiyFp& plus, char buffer[], int& K)
+            {
+                // Pick the cached power that brings the upper boundary in the [-60, -32] binary exponent range.
+                const double dk = ((-61 - plus.e) * 0.30102999566398114) + 347;
+                int k = static_cast<int>(dk);
+                if ((dk - k) > 0.0) {
+                    k++;
+                }
+                const int index = (k >> 3) + 1;
+
+                K = -(-348 + (index << 3));
+
+                const DiyFp& power = CachedPowers[index];
+                const DiyFp W = v * power;
+                DiyFp upper = plus * power;
+                DiyFp lower = minus * power;
+                lower.f++;
+                upper.f--;
+
+                uint64_t delta = upper.f - lower.f;
+                const DiyFp one{ 1ULL << -upper.e, upper.e };
+                const DiyFp distance = upper - W;
+                uint32_t p1 = static_cast<uint32_t>(upper.f >> -one.e);
+                uint64_t p2 = upper.f & (one.f - 1);
+                int kappa = DecimalDigits(p1);
+                uint8_t length = 0;
+
+                while (kappa > 0) {
+                    const uint32_t divider = static_cast<uint32_t>(Powers10[kappa - 1]);
+                    const uint32_t digit = p1 / divider;
+                    p1 %= divider;
+
+                    if ((digit != 0) || (length != 0)) {
+                        buffer[length++] = static_cast<char>('0' + digit);
+                    }
+                    kappa--;
+
+                    const uint64_t rest = (static_cast<uint64_t>(p1) << -one.e) + p2;
+                    if (rest <= delta) {
+                        K += kappa;
+                        Round(buffer, length, delta, rest, Powers10[kappa] << -one.e, distance.f);
+                        return (length);
+                    }
+                }
+
+                for (;;) {
+                    p2 *= 10;
+                    delta *= 10;
+
+                    const char digit = static_cast<char>(p2 >> -one.e);
+                    if ((digit != 0) || (length != 0)) {
+                        buffer[length++] = static_cast<char>('0' + digit);
+                    }
+                    p2 &= one.f - 1;
+                    kappa--;
+
+                    if (p2 < delta) {
+                        K += kappa;
+                        Round(buffer, length, delta, p2, one.f, distance.f * (-kappa < 20 ? Powers10[-kappa] : 0));
+                        return (length);
+                    }
+                }
+            }
+
+            // Like JavaScript does: plain notation for 1e-6 <= |value| < 1e21, exponential otherwise.
+            uint8_t Layout(char buffer[], const uint8_t length, const int K)
+            {
+                const int point = length + K;
+                uint8_t result = length;
+
+                if ((length <= point) && (point <= 21)) {
+                    ::memset(&(buffer[length]), '0', point - length);
+                    result = static_cast<uint8_t>(point);
+                }
+                else if ((0 < point) && (point <= 21)) {
+                    ::memmove(&(buffer[point + 1]), &(buffer[point]), length - point);
+                    buffer[point] = '.';
+                    result = length + 1;
+                }
+                else if ((-6 < point) && (point <= 0)) {
+                    const uint8_t shift = static_cast<uint8_t>(2 - point);
+                    ::memmove(&(buffer[shift]), buffer, length);
+                    buffer[0] = '0';
+                    buffer[1] = '.';
+                    ::memset(&(buffer[2]), '0', shift - 2);
+                    result = length + shift;
+                }
+                else {
+                    int exponent = point - 1;
+
+                    if (length > 1) {
+                        ::memmove(&(buffer[2]), &(buffer[1]), length - 1);
+                        buffer[1] = '.';
+                        result++;
+                    }
+                    buffer[result++] = 'e';
+                    if (exponent < 0) {
+                        buffer[result++] = '-';
+                        exponent = -exponent;
+                    }
+                    else {
+                        buffer[result++] = '+';
+                    }
+                    result += Numbers::Format(&(buffer[result]), static_cast<uint64_t>(exponent), 10);
+                }
+
+                return (result);
+            }
+
+            template <typename TYPE, typename BITS, const uint8_t SIGNIFICAND, const int BIAS>
+            uint8_t FormatFloat(char buffer[], TYPE value)
+            {
+                uint8_t length = 0;
+
+                if (std::signbit(value) == true) {
+                    buffer[length++] = '-';
+                    value = -value;
+                }
+
+                if (value == 0) {
+                    buffer[length++] = '0';
+                }
+                else {
+                    DiyFp v, minus, plus;
+                    int K;
+
+                    Boundaries<TYPE, BITS, SIGNIFICAND, BIAS>(value, v, minus, plus);
+                    const uint8_t digits = Grisu2(v, minus, plus, &(buffer[length]), K);
+                    length += Layout(&(buffer[length]), digits, K);
+                }
+
+                return (length);
+            }
+
+            // Token of a plain number ([-]digits[.digits][(e|E)[+|-]digits]), as long as it is followed by a
+            // delimiter within the stream. The digits (at most 19 significant ones) and the decimal exponent are
+            // reported, for a token with more digits the digit count is set to TooManyDigits.
+            constexpr uint8_t TooManyDigits = 0xFF;
+
+            uint16_t Tokenize(const char stream[], const uint16_t length, bool& negative, uint64_t& mantissa, uint8_t& digits, int& exponent)
+            {
+                uint16_t index = 0;
+                bool any = false;
+                bool overflow = false;
+
+                negative = ((length > 0) && (stream[0] == '-'));
+                index = (negative == true ? 1 : 0);
+                mantissa = 0;
+                digits = 0;
+                exponent = 0;
+
+                for (bool fraction = false; index < length; index++) {
+                    const char character = stream[index];
+
+                    if ((character >= '0') && (character <= '9')) {
+                        any = true;
+                        if ((digits == 0) && (character == '0')) {
+                            // Leading zero, only the position of the point matters.
+                        }
+                        else if (digits < 19) {
+                            mantissa = (mantissa * 10) + (character - '0');
+                            digits++;
+                        }
+                        else {
+                            overflow = true;
+                        }
+                        exponent -= ((fraction == true) && (overflow == false) ? 1 : 0);
+                        exponent += ((fraction == false) && (overflow == true) ? 1 : 0);
+                    }
+                    else if ((character == '.') && (fraction == false)) {
+                        fraction = true;
+                    }
+                    else {
+                        break;
+                    }
+                }
+
+                if ((any == true) && (index < length) && ((stream[index] == 'e') || (stream[index] == 'E'))) {
+                    uint16_t position = index + 1;
+                    const bool minus = ((position < length) && (stream[position] == '-'));
+                    uint32_t value = 0;
+
+                    if ((position < length) && ((stream[position] == '-') || (stream[position] == '+'))) {
+                        position++;
+                    }
+
+                    const uint16_t start = position;
+                    while ((position < length) && (stream[position] >= '0') && (stream[position] <= '9')) {
+                        value = (value < 100000 ? (value * 10) + (stream[position] - '0') : value);
+                        position++;
+                    }
+
+                    any = (position > start);
+                    exponent += (minus == true ? -static_cast<int>(value) : static_cast<int>(value));
+                    index = position;
+                }
+
+                if ((any == false) || (index >= length) ||
+                    ((::isspace(static_cast<uint8_t>(stream[index])) == 0) && (stream[index] != '\0') && (stream[index] != ',') && (stream[index] != '}') && (stream[index] != ']'))) {
+                    index = 0;
+                }
+                else if (overflow == true) {
+                    digits = TooManyDigits;
+                }
+
+                return (index);
+            }
+
+            // Clinger's fast path: the mantissa and the power of ten are exact in TYPE, so a single
+            // (correctly rounded) multiplication or division gives the correctly rounded result.
+            template <typename TYPE, const uint64_t MAXMANTISSA, const int MAXEXPONENT>
+            uint16_t ParseFloat(const char stream[], const uint16_t length, TYPE& value)
+            {
+                bool negative;
+                uint64_t mantissa;
+                uint8_t digits;
+                int exponent;
+
+                uint16_t result = Tokenize(stream, length, negative, mantissa, digits, exponent);
+
+                if (result != 0) {
+#if defined(FLT_EVAL_METHOD) && (FLT_EVAL_METHOD == 0)
+                    const bool exact = (digits != TooManyDigits) && (mantissa <= MAXMANTISSA) && (exponent >= -MAXEXPONENT) && (exponent <= MAXEXPONENT);
+#else
+                    const bool exact = false;
+#endif
+                    if ((exact == true) && ((mantissa == 0) || (exponent == 0))) {
+                        value = static_cast<TYPE>(mantissa);
+                    }
+                    else if (exact == true) {
+                        const TYPE power = static_cast<TYPE>(FloatPowers10[exponent < 0 ? -exponent : exponent]);
+                        value = (exponent < 0 ? static_cast<TYPE>(mantissa) / power : static_cast<TYPE>(mantissa) * power);
+                    }
+                    else if (result < 64) {
+                        char token[64];
+                        char* end;
+
+                        ::memcpy(token, stream, result);
+                        token[result] = '\0';
+                        if (std::is_same<float, TYPE>::value) {
+                            value = std::strtof(token, &end);
+                        } else {
+                            value = static_cast<TYPE>(std::strtod(token, &end));
+                        }
+                        result = (end == token ? 0 : result);
+                        negative = false;
+                    }
+                    else {
+                        result = 0;
+                    }
+
+                    if (negative == true) {
+                        value = -value;
+                    }
+                }
+
+                return (result);
+            }
+        }
+
+        /* static */ uint8_t Numbers::Format(char buffer[], uint64_t value, const uint8_t base)
+        {
+            uint8_t length;
+
+            if (base == 10) {
+                length = DecimalDigits(value);
+                char* position = &(buffer[length]);
+
+                while (value >= 100) {
+                    const uint32_t pair = static_cast<uint32_t>(value % 100) * 2;
+                    value /= 100;
+                    *--position = DigitPairs[pair + 1];
+                    *--position = DigitPairs[pair];
+                }
+                if (value >= 10) {
+                    const uint32_t pair = static_cast<uint32_t>(value) * 2;
+                    *--position = DigitPairs[pair + 1];
+                    *--position = DigitPairs[pair];
+                }
+                else {
+                    *--position = static_cast<char>('0' + value);
+                }
+            }
+            else {
+                const uint8_t shift = (base == 16 ? 4 : 3);
+                uint64_t remainder = (value >> shift);
+
+                length = 1;
+                while (remainder != 0) {
+                    remainder >>= shift;
+                    length++;
+                }
+
+                for (uint8_t index = length; index > 0; index--) {
+                    const uint8_t digit = static_cast<uint8_t>(value & (base - 1));
+                    buffer[index - 1] = static_cast<char>(digit < 10 ? '0' + digit : 'A' - 10 + digit);
+                    value >>= shift;
+                }
+            }
+
+            return (length);
+        }
+
+        /* static */ uint8_t Numbers::Format(char buffer[], const float value)
+        {
+            return (FormatFloat<float, uint32_t, 23, 127>(buffer, value));
+        }
+
+        /* static */ uint8_t Numbers::Format(char buffer[], const double value)
+        {
+            return (FormatFloat<double, uint64_t, 52, 1023>(buffer, value));
+        }
+
+        /* static */ uint16_t Numbers::Parse(const char stream[], const uint16_t length, float& value)
+        {
+            return (ParseFloat<float, (1ULL << 24), 10>(stream, length, value));
+        }
+
+        /* static */ uint16_t Numbers::Parse(const char stream[], const uint16_t length, double& value)
+        {
+            return (ParseFloat<double, (1ULL << 53), 22>(stream, length, value));
+        }
+
         /* static */ char IElement::NullTag[5] = { 'n', 'u', 'l', 'l', '\0' };
         /* static */ char IElement::TrueTag[5] = { 't', 'r', 'u', 'e', '\0' };
         /* static */ char IElement::FalseTag[6] = { 'f', 'a', 'l', 's', 'e', '\0' };
@@ -82,6 +82,23 @@ namespace Core {
 
         string EXTERNAL ErrorDisplayMessage(const Error& err);
 
+        // One shot number conversions, for numbers that fit completely in the buffer at hand.
+        struct EXTERNAL Numbers {
+            // Room for any formatted number, including its sign, prefix and quotes.
+            static constexpr uint8_t MaxLength = 32;
+
+            // Digits only, hexadecimal ones in upper case.
+            static uint8_t Format(char buffer[], uint64_t value, const uint8_t base);
+
+            // Shortest digits that read back to the same value.
+            static uint8_t Format(char buffer[], const float value);
+            static uint8_t Format(char buffer[], const double value);
+
+            // Returns the length of the number, 0 if the stream does not hold a delimited plain number.
+            static uint16_t Parse(const char stream[], const uint16_t length, float& value);
+            static uint16_t Parse(const char stream[], const uint16_t length, double& value);
+        };
+
         struct EXTERNAL IElement {
 
             static TCHAR NullTag[5];
@@ -614,6 +631,32 @@ namespace Core {
 
                 ASSERT(maxLength > 0);
 
+                if ((offset == 0) && ((_set & UNDEFINED) == 0) && (maxLength >= Numbers::MaxLength)) {
+                    // It fits, no need to be able to resume.
+                    const bool negative = ((SIGNED == true) && (_value < 0));
+
+                    if (BASETYPE != BASE_DECIMAL) {
+                        stream[loaded++] = '\"';
+                    }
+                    if (negative == true) {
+                        stream[loaded++] = '-';
+                    }
+                    if (BASETYPE != BASE_DECIMAL) {
+                        stream[loaded++] = '0';
+                    }
+                    if (BASETYPE == BASE_HEXADECIMAL) {
+                        stream[loaded++] = 'x';
+                    }
+
+                    loaded += Numbers::Format(&(stream[loaded]), (negative == true ? (0 - static_cast<uint64_t>(_value)) : static_cast<uint64_t>(_value)), BASETYPE);
+
+                    if (BASETYPE != BASE_DECIMAL) {
+                        stream[loaded++] = '\"';
+                    }
+
+                    return (loaded);
+                }
+
                 while ((offset < 4) && (loaded < maxLength)) {
 
                     if ((_set & UNDEFINED) != 0) {
@@ -674,6 +717,12 @@ namespace Core {
             uint16_t Deserialize(const char stream[], const uint16_t maxLength, uint32_t& offset, Core::OptionalType<Error>& error) override
             {
                 uint16_t loaded = 0;
+                bool completed = false;
+
+                if (offset == 0) {
+                    loaded = Decimal(stream, maxLength, offset);
+                    completed = (loaded != 0);
+                }
 
                 // Peamble investigation, determine the right flags..
                 while ((offset < 4) && (loaded < maxLength)) {
@@ -766,7 +815,7 @@ namespace Core {
                     loaded++;
                 }
 
-                bool completed = ((_set & (ERROR|UNDEFINED)) != 0);
+                completed = ((completed == true) || ((_set & (ERROR|UNDEFINED)) != 0));
 
                 while ((loaded < maxLength) && (completed == false)) {
 #ifdef __WINDOWS__
@@ -883,12 +932,38 @@ namespace Core {
             }
 
         private:
-            uint16_t Convert(char stream[], const uint16_t maxLength, uint32_t& offset, const TYPE serialize) const
+            // An unquoted decimal that completely fits the stream, parsed in one go. Anything else (or
+            // anything that overflows) is left to the resumable path, that also reports the errors.
+            uint16_t Decimal(const char stream[], const uint16_t maxLength, uint32_t& offset)
+            {
+                const uint16_t first = ((maxLength > 0) && (stream[0] == '-') ? 1 : 0);
+                const uint16_t last = std::min(maxLength, static_cast<uint16_t>(first + 19));
+                uint16_t index = first;
+                uint64_t value = 0;
+
+                while ((index < last) && (stream[index] >= '0') && (stream[index] <= '9')) {
+                    value = (value * 10) + (stream[index] - '0');
+                    index++;
+                }
+
+                if ((index == first) || (index >= maxLength) || (value > static_cast<uint64_t>(std::numeric_limits<TYPE>::max())) ||
+                    ((::isspace(static_cast<uint8_t>(stream[index])) == 0) && (stream[index] != '\0') && (stream[index] != ',') && (stream[index] != '}') && (stream[index] != ']'))) {
+                    index = 0;
+                } else {
+                    _value = static_cast<TYPE>(value);
+                    _set = (first != 0 ? (NEGATIVE | DECIMAL) : DECIMAL);
+                    offset = 4;
+                }
+
+                return (index);
+            }
+
+            uint16_t Convert(char stream[], const uint16_t maxLength, uint32_t& offset, const uint64_t serialize) const
             {
                 uint8_t parsed = 4;
                 uint16_t loaded = 0;
-                TYPE divider = 1;
-                TYPE value = (serialize / BASETYPE);
+                uint64_t divider = 1;
+                uint64_t value = (serialize / BASETYPE);
 
                 while (divider <= value) {
                     divider *= BASETYPE;
@@ -920,12 +995,13 @@ namespace Core {
 
             uint16_t Convert(char stream[], const uint16_t maxLength, uint32_t& offset, const TemplateIntToType<false>& /* For compile time diffrentiation */) const
             {
-                return (Convert(stream, maxLength, offset, _value));
+                return (Convert(stream, maxLength, offset, static_cast<uint64_t>(_value)));
             }
 
             uint16_t Convert(char stream[], const uint16_t maxLength, uint32_t& offset, const TemplateIntToType<true>& /* For c ompile time diffrentiation */) const
             {
-                return (Convert(stream, maxLength, offset, ::abs(_value)));
+                // Magnitude in the unsigned domain, so the most negative value has one as well.
+                return (Convert(stream, maxLength, offset, (_value < 0 ? (0 - static_cast<uint64_t>(_value)) : static_cast<uint64_t>(_value))));
             }
 
             uint16_t Convert(uint8_t stream[], const uint16_t maxLength, uint32_t& offset, const TemplateIntToType<false>& /* For compile time diffrentiation */) const
@@ -1182,6 +1258,11 @@ namespace Core {
                     ::memcpy(stream, &(IElement::NullTag[offset]), loaded);
                     offset = (((offset + loaded) == (sizeof(IElement::NullTag) - 1)) ? 0 : offset + loaded);
                 }
+                else if ((offset == 0) && (maxLength >= Numbers::MaxLength))
+                {
+                    // It fits, no need to be able to resume.
+                    loaded = Numbers::Format(stream, _value);
+                }
                 else
                 {
                     loaded += Convert(stream, maxLength, offset);
@@ -1198,6 +1279,13 @@ namespace Core {
                     _value = 0;
                     _set = 0;
                     _strValue.clear();
+
+                    loaded = Numbers::Parse(stream, maxLength, _value);
+
+                    if (loaded != 0) {
+                        _set = SET;
+                        return (loaded);
+                    }
                 }
 
                 if ((stream[loaded] == '\"') && ((_set & QUOTED) == 0)) {
@@ -1332,9 +1420,8 @@ namespace Core {
                 uint16_t loaded = 0;
 
                 if (_strValue.empty() == true) {
-                    char str[16];
-                    std::snprintf(str, sizeof(str), "%g", _value);
-                    const_cast<FloatType*>(this)->_strValue = str;
+                    char str[Numbers::MaxLength];
+                    const_cast<FloatType*>(this)->_strValue.assign(str, Numbers::Format(str, _value));
                 }
 
                 while ((loaded < maxLength) && (offset < _strValue.size())) {
@@ -1859,6 +1946,23 @@ namespace Core {
                     uint32_t length = static_cast<uint32_t>(_value.length()) - (offset - 1);
 
                     while ((result < maxLength) && (length > 0)) {
+                        if ((_flagsAndCounters & SpecialSequenceBit) == 0) {
+                            // Move the run of characters that go out as is in one go.
+                            uint32_t run = std::min(length, static_cast<uint32_t>(maxLength - result));
+
+                            if (isQuoted == true) {
+                                run = VerbatimOut(&(_value[offset - 1]), run);
+                            }
+
+                            if (run > 0) {
+                                ::memcpy(&(stream[result]), &(_value[offset - 1]), run);
+                                result += static_cast<uint16_t>(run);
+                                length -= run;
+                                offset += run;
+                                continue;
+                            }
+                        }
+
                         const uint16_t current = static_cast<uint16_t>((_value[offset - 1]) & 0xFF);
 
                         // See if this is a printable character
@@ -2000,6 +2104,26 @@ namespace Core {
                 // Might be that the last character we added was a
                 while ((result < maxLength) && (finished == false)) {
 
+                    // Take the run of characters that need no attention in one go: plain characters
+                    // of a string, or everything up to the closing quote of a quoted area in an opaque object.
+                    uint16_t run = 0;
+
+                    if ((_flagsAndCounters & QuoteFoundBit) != 0) {
+                        if ((_flagsAndCounters & SpecialSequenceBit) == 0) {
+                            run = static_cast<uint16_t>(VerbatimIn(&(stream[result]), maxLength - result));
+                        }
+                    }
+                    else if ((_flagsAndCounters & QuotedAreaBit) != 0) {
+                        const char* quote = static_cast<const char*>(::memchr(&(stream[result]), '\"', maxLength - result));
+                        run = static_cast<uint16_t>(quote == nullptr ? (maxLength - result) : (quote - &(stream[result])));
+                    }
+
+                    if (run > 0) {
+                        _value.append(&(stream[result]), run);
+                        result += run;
+                        continue;
+                    }
+
                     TCHAR current = stream[result];
 
                     // What are we deserializing a string, or an opaque JSON object!!!
@@ -2251,6 +2375,10 @@ namespace Core {
             }
 
         private:
+            // Number of leading characters that can be serialized (quoted) or deserialized without any escaping.
+            static uint32_t VerbatimOut(const char text[], const uint32_t length);
+            static uint32_t VerbatimIn(const char text[], const uint32_t length);
+
             bool IsEscaped(const string& value) const {
                 bool escaped(false);
 
@@ -2913,6 +3041,323 @@ namespace Core {
             mutable NumberType<uint32_t, FALSE, BASE_HEXADECIMAL> _package;
         };
 
+        // Storage of the ArrayType. Elements are constructed in blocks that never move and the order
+        // is kept in a vector of pointers, so a reference to an element stays valid until that element
+        // is removed (as it did with the list this replaces), while building a large array takes a
+        // handful of allocations and indexing is direct.
+        template <typename ELEMENT>
+        class ArrayStorageType {
+        private:
+            using Pointers = std::vector<ELEMENT*>;
+
+            struct Block {
+                ELEMENT* Memory;
+                uint32_t Size;
+                uint32_t Used;
+            };
+
+            static constexpr uint32_t MinimumBlockSize = 8;
+
+        public:
+            template <typename POINTER, typename VALUE>
+            class IteratorType {
+            public:
+                IteratorType()
+                    : _index()
+                {
+                }
+                IteratorType(const POINTER& index)
+                    : _index(index)
+                {
+                }
+                template <typename OTHERPOINTER, typename OTHERVALUE>
+                IteratorType(const IteratorType<OTHERPOINTER, OTHERVALUE>& copy)
+                    : _index(copy.Index())
+                {
+                }
+                ~IteratorType() = default;
+
+            public:
+                VALUE& operator*() const
+                {
+                    return (**_index);
+                }
+                VALUE* operator->() const
+                {
+                    return (*_index);
+                }
+                IteratorType& operator++()
+                {
+                    ++_index;
+                    return (*this);
+                }
+                IteratorType operator++(int)
+                {
+                    IteratorType result(*this);
+                    ++_index;
+                    return (result);
+                }
+                IteratorType& operator--()
+                {
+                    --_index;
+                    return (*this);
+                }
+                IteratorType operator--(int)
+                {
+                    IteratorType result(*this);
+                    --_index;
+                    return (result);
+                }
+                IteratorType operator+(const size_t offset) const
+                {
+                    return (IteratorType(_index + offset));
+                }
+                template <typename OTHERPOINTER, typename OTHERVALUE>
+                bool operator==(const IteratorType<OTHERPOINTER, OTHERVALUE>& RHS) const
+                {
+                    return (_index == RHS.Index());
+                }
+                template <typename OTHERPOINTER, typename OTHERVALUE>
+                bool operator!=(const IteratorType<OTHERPOINTER, OTHERVALUE>& RHS) const
+                {
+                    return (_index != RHS.Index());
+                }
+                const POINTER& Index() const
+                {
+                    return (_index);
+                }
+
+            private:
+                POINTER _index;
+            };
+
+            using iterator = IteratorType<typename Pointers::iterator, ELEMENT>;
+            using const_iterator = IteratorType<typename Pointers::const_iterator, const ELEMENT>;
+
+        public:
+            ArrayStorageType()
+                : _elements()
+                , _blocks()
+                , _free()
+                , _hint(0)
+            {
+            }
+            ArrayStorageType(const ArrayStorageType<ELEMENT>& copy)
+                : _elements()
+                , _blocks()
+                , _free()
+                , _hint(0)
+            {
+                reserve(copy.size());
+                for (const ELEMENT* element : copy._elements) {
+                    push_back(*element);
+                }
+            }
+            ArrayStorageType(ArrayStorageType<ELEMENT>&& move) noexcept
+                : _elements(std::move(move._elements))
+                , _blocks(std::move(move._blocks))
+                , _free(std::move(move._free))
+                , _hint(move._hint)
+            {
+                move._elements.clear();
+                move._blocks.clear();
+                move._free.clear();
+            }
+            ~ArrayStorageType()
+            {
+                clear();
+                Release();
+            }
+
+            ArrayStorageType<ELEMENT>& operator=(const ArrayStorageType<ELEMENT>& RHS)
+            {
+                if (this != &RHS) {
+                    clear();
+                    reserve(RHS.size());
+                    for (const ELEMENT* element : RHS._elements) {
+                        push_back(*element);
+                    }
+                }
+                return (*this);
+            }
+            ArrayStorageType<ELEMENT>& operator=(ArrayStorageType<ELEMENT>&& move) noexcept
+            {
+                if (this != &move) {
+                    clear();
+                    Release();
+
+                    _elements = std::move(move._elements);
+                    _blocks = std::move(move._blocks);
+                    _free = std::move(move._free);
+                    _hint = move._hint;
+
+                    move._elements.clear();
+                    move._blocks.clear();
+                    move._free.clear();
+                }
+                return (*this);
+            }
+
+        public:
+            size_t size() const
+            {
+                return (_elements.size());
+            }
+            bool empty() const
+            {
+                return (_elements.empty());
+            }
+            iterator begin()
+            {
+                return (iterator(_elements.begin()));
+            }
+            iterator end()
+            {
+                return (iterator(_elements.end()));
+            }
+            const_iterator begin() const
+            {
+                return (const_iterator(_elements.begin()));
+            }
+            const_iterator end() const
+            {
+                return (const_iterator(_elements.end()));
+            }
+            ELEMENT& back()
+            {
+                return (*(_elements.back()));
+            }
+            const ELEMENT& back() const
+            {
+                return (*(_elements.back()));
+            }
+            ELEMENT& operator[](const size_t index)
+            {
+                return (*(_elements[index]));
+            }
+            const ELEMENT& operator[](const size_t index) const
+            {
+                return (*(_elements[index]));
+            }
+
+            // Makes room for <count> elements in total, in a single block.
+            void reserve(const size_t count)
+            {
+                _elements.reserve(count);
+
+                if (count > (_elements.size() + _free.size() + Available())) {
+                    _hint = static_cast<uint32_t>(count - (_elements.size() + _free.size() + Available()));
+                }
+            }
+            template <typename... ARGUMENTS>
+            ELEMENT& emplace_back(ARGUMENTS&&... arguments)
+            {
+                ELEMENT* element = new (Allocate()) ELEMENT(std::forward<ARGUMENTS>(arguments)...);
+                _elements.push_back(element);
+                return (*element);
+            }
+            void push_back(const ELEMENT& element)
+            {
+                emplace_back(element);
+            }
+            void push_back(ELEMENT&& element)
+            {
+                emplace_back(std::move(element));
+            }
+            template <typename... ARGUMENTS>
+            iterator emplace(const_iterator position, ARGUMENTS&&... arguments)
+            {
+                const size_t index = (position.Index() - _elements.cbegin());
+                ELEMENT* element = new (Allocate()) ELEMENT(std::forward<ARGUMENTS>(arguments)...);
+                return (iterator(_elements.insert(_elements.begin() + index, element)));
+            }
+            iterator insert(const_iterator position, const ELEMENT& element)
+            {
+                return (emplace(position, element));
+            }
+            iterator insert(const_iterator position, ELEMENT&& element)
+            {
+                return (emplace(position, std::move(element)));
+            }
+            iterator erase(const_iterator position)
+            {
+                const size_t index = (position.Index() - _elements.cbegin());
+                ELEMENT* element = _elements[index];
+
+                element->~ELEMENT();
+                _free.push_back(element);
+
+                return (iterator(_elements.erase(_elements.begin() + index)));
+            }
+            void clear()
+            {
+                for (ELEMENT* element : _elements) {
+                    element->~ELEMENT();
+                }
+                _elements.clear();
+                _free.clear();
+
+                // Keep the blocks, an array that is cleared is typically filled again.
+                for (Block& block : _blocks) {
+                    block.Used = 0;
+                }
+            }
+
+        private:
+            uint32_t Available() const
+            {
+                uint32_t result = 0;
+                for (const Block& block : _blocks) {
+                    result += (block.Size - block.Used);
+                }
+                return (result);
+            }
+            void* Allocate()
+            {
+                void* result = nullptr;
+
+                if (_free.empty() == false) {
+                    result = _free.back();
+                    _free.pop_back();
+                }
+                else {
+                    typename std::vector<Block>::iterator index = _blocks.begin();
+
+                    while ((index != _blocks.end()) && (index->Used == index->Size)) {
+                        ++index;
+                    }
+
+                    if (index == _blocks.end()) {
+                        // Every block is at least as large as all before it together, so the number of
+                        // blocks grows with the logarithm of the number of elements.
+                        const uint32_t size = std::max(std::max(MinimumBlockSize, _hint), static_cast<uint32_t>(_elements.size()));
+                        Block block{ static_cast<ELEMENT*>(::operator new(size * sizeof(ELEMENT))), size, 0 };
+
+                        _hint = 0;
+                        _blocks.push_back(block);
+                        index = _blocks.end() - 1;
+                    }
+
+                    result = &(index->Memory[index->Used++]);
+                }
+
+                return (result);
+            }
+            void Release()
+            {
+                for (Block& block : _blocks) {
+                    ::operator delete(block.Memory);
+                }
+                _blocks.clear();
+            }
+
+        private:
+            Pointers _elements;
+            std::vector<Block> _blocks;
+            Pointers _free;
+            uint32_t _hint;
+        };
+
         template <typename ELEMENT>
         class ArrayType : public IElement, public IMessagePack {
         private:
@@ -2934,7 +3379,7 @@ namespace Core {
             template <typename ARRAYELEMENT>
             class ConstIteratorType {
             private:
-                typedef std::list<ARRAYELEMENT> ArrayContainer;
+                typedef ArrayStorageType<ARRAYELEMENT> ArrayContainer;
                 enum State {
                     AT_BEGINNING,
                     AT_ELEMENT,
@@ -3065,7 +3510,7 @@ namespace Core {
             template <typename ARRAYELEMENT>
             class IteratorType {
             private:
-                typedef std::list<ARRAYELEMENT> ArrayContainer;
+                typedef ArrayStorageType<ARRAYELEMENT> ArrayContainer;
                 enum State {
                     AT_BEGINNING,
                     AT_ELEMENT,
@@ -3327,11 +3772,15 @@ namespace Core {
                 return static_cast<uint16_t>(_data.size());
             }
 
-            inline ELEMENT& Add()
+            // Capacity hint, room for <count> elements is allocated at once.
+            inline void Reserve(const uint16_t count)
             {
-                _data.push_back(ELEMENT());
+                _data.reserve(count);
+            }
 
-                return (_data.back());
+            inline ELEMENT& Add()
+            {
+                return (_data.emplace_back());
             }
 
             inline ELEMENT& Add(const ELEMENT& element)
@@ -3345,17 +3794,7 @@ namespace Core {
             {
                 ASSERT(index <= Length());
 
-                typename std::list<ELEMENT>::iterator locator = _data.begin();
-                uint32_t skip = index;
-
-                while (skip != 0) {
-                    ++locator;
-                    --skip;
-                }
-
-                locator = _data.insert(locator, ELEMENT());
-
-                return (*locator);
+                return (*(_data.emplace(_data.begin() + index)));
 
             }
 
@@ -3363,17 +3802,7 @@ namespace Core {
             {
                 ASSERT(index <= Length());
 
-                typename std::list<ELEMENT>::iterator locator = _data.begin();
-                uint32_t skip = index;
-
-                while (skip != 0) {
-                    ++locator;
-                    --skip;
-                }
-
-                locator = _data.insert(locator, element);
-
-                return (*locator);
+                return (*(_data.insert(_data.begin() + index, element)));
 
             }
 
@@ -3381,69 +3810,30 @@ namespace Core {
             {
                 ASSERT(index <= Length());
 
-                typename std::list<ELEMENT>::iterator locator = _data.begin();
-                uint32_t skip = index;
-
-                while (skip != 0) {
-                    ++locator;
-                    --skip;
-                }
-
-                locator = _data.insert(locator, std::move(element));
-
-                return (*locator);
+                return (*(_data.insert(_data.begin() + index, std::move(element))));
             }
 
             inline ELEMENT* Remove(const uint32_t index)
             {
                 ASSERT(index < Length());
 
-                typename std::list<ELEMENT>::iterator locator = _data.begin();
-                uint32_t skip = index;
-
-                while (skip != 0) {
-                    ++locator;
-                    --skip;
-                }
-
-                ASSERT(locator != _data.end());
-                typename std::list<ELEMENT>::iterator next = _data.erase(locator);
+                typename ArrayStorageType<ELEMENT>::iterator next = _data.erase(_data.begin() + index);
 
                 return ((next != _data.end()) ? &(*next) : nullptr);
             }
 
             ELEMENT& operator[](const uint32_t index)
             {
-                uint32_t skip = index;
                 ASSERT(index < Length());
 
-                typename std::list<ELEMENT>::iterator locator = _data.begin();
-
-                while (skip != 0) {
-                    locator++;
-                    skip--;
-                }
-
-                ASSERT(locator != _data.end());
-
-                return (*locator);
+                return (_data[index]);
             }
 
             const ELEMENT& operator[](const uint32_t index) const
             {
-                uint32_t skip = index;
                 ASSERT(index < Length());
 
-                typename std::list<ELEMENT>::const_iterator locator = _data.begin();
-
-                while (skip != 0) {
-                    locator++;
-                    skip--;
-                }
-
-                ASSERT(locator != _data.end());
-
-                return (*locator);
+                return (_data[index]);
             }
 
             const ELEMENT& Get(const uint32_t index) const
@@ -3635,7 +4025,7 @@ namespace Core {
                                     ++loaded;
                                 } else {
                                     offset = PARSE;
-                                    _data.push_back(ELEMENT());
+                                    _data.emplace_back();
                                 }
                                 break;
                             }
@@ -3725,6 +4115,7 @@ namespace Core {
                     } else if (offset == 2) {
                         _count = (_count << 8) | stream[loaded++];
                         offset = PARSE;
+                        _data.reserve(_data.size() + _count);
                     }
                 }
 
@@ -3733,7 +4124,7 @@ namespace Core {
                     if (offset == PARSE) {
                         if (_count > 0) {
                             _count--;
-                            _data.emplace_back(ELEMENT());
+                            _data.emplace_back();
                         } else {
                             offset = 0;
                         }
@@ -3751,7 +4142,7 @@ namespace Core {
         private:
             uint8_t _state;
             uint16_t _count;
-            std::list<ELEMENT> _data;
+            ArrayStorageType<ELEMENT> _data;
             mutable IteratorType<ELEMENT> _iterator;
         };
 
@@ -3774,7 +4165,58 @@ namespace Core {
             static constexpr uint16_t PARSE = 7;
 
             typedef std::pair<const TCHAR*, IElement*> JSONLabelValue;
-            typedef std::list<JSONLabelValue> JSONElementList;
+            typedef std::vector<JSONLabelValue> JSONElementList;
+
+        public:
+            // Members of which the label is known at compile time can be described in a constant
+            // table (see JSON_FIELD) instead of being registered one by one with Add() on every
+            // construction. The label length and hash are calculated by the compiler, looking up
+            // a label compares hashes before comparing any text.
+            struct Field {
+                constexpr Field(const TCHAR label[], IElement* (*element)(Container&))
+                    : Label(label)
+                    , Length(LabelLength(label))
+                    , Hash(LabelHash(label))
+                    , Element(element)
+                {
+                }
+
+                const TCHAR* Label;
+                uint16_t Length;
+                uint32_t Hash;
+                IElement* (*Element)(Container&);
+            };
+
+            struct FieldTable {
+                template <const uint16_t COUNT>
+                constexpr FieldTable(const Field (&fields)[COUNT])
+                    : Fields(fields)
+                    , Count(COUNT)
+                {
+                }
+
+                const Field* Fields;
+                uint16_t Count;
+            };
+
+            template <typename CLASS, typename TYPE, TYPE CLASS::*MEMBER>
+            static IElement* Member(Container& parent)
+            {
+                return (&(static_cast<CLASS&>(parent).*MEMBER));
+            }
+
+            static constexpr uint16_t LabelLength(const TCHAR label[], const uint16_t length = 0)
+            {
+                return (label[length] == '\0' ? length : LabelLength(label, length + 1));
+            }
+
+            // FNV-1a
+            static constexpr uint32_t LabelHash(const TCHAR label[], const uint32_t hash = 0x811C9DC5)
+            {
+                return (*label == '\0' ? hash : LabelHash(label + 1, (hash ^ static_cast<uint8_t>(*label)) * 0x01000193));
+            }
+
+        private:
 
             class Iterator {
             private:
@@ -3852,8 +4294,21 @@ namespace Core {
             Container()
                 : _state(0)
                 , _count(0)
+                , _fields(nullptr)
+                , _fieldCount(0)
                 , _data()
-                , _iterator()
+                , _index(0)
+                , _fieldName(true)
+            {
+                ::memset(&_current, 0, sizeof(_current));
+            }
+            Container(const FieldTable& table)
+                : _state(0)
+                , _count(0)
+                , _fields(table.Fields)
+                , _fieldCount(table.Count)
+                , _data()
+                , _index(0)
                 , _fieldName(true)
             {
                 ::memset(&_current, 0, sizeof(_current));
@@ -3866,13 +4321,13 @@ namespace Core {
             }
             bool HasLabel(const string& label) const
             {
-                JSONElementList::const_iterator index(_data.begin());
+                uint16_t index = 0;
 
-                while ((index != _data.end()) && (index->first != label)) {
+                while ((index < FieldCount()) && (label != FieldLabel(index))) {
                     index++;
                 }
 
-                return (index != _data.end());
+                return (index < FieldCount());
             }
 
             // IElement and IMessagePack iface:
@@ -3881,13 +4336,13 @@ namespace Core {
                 bool set = ((_state & SET) != 0);
 
                 if (set == false) {
-                    JSONElementList::const_iterator index = _data.begin();
+                    uint16_t index = 0;
                     // As long as we did not find a set element, continue..
-                    while ((index != _data.end()) && (index->second->IsSet() == false)) {
+                    while ((index < FieldCount()) && (FieldElement(index)->IsSet() == false)) {
                         index++;
                     }
 
-                    set = (index != _data.end());
+                    set = (index < FieldCount());
                 }
 
                 return (set);
@@ -3920,12 +4375,8 @@ namespace Core {
 
             void Clear() override
             {
-                JSONElementList::const_iterator index = _data.begin();
-
-                // As long as we did not find a set element, continue..
-                while (index != _data.end()) {
-                    index->second->Clear();
-                    index++;
+                for (uint16_t index = 0; index < FieldCount(); index++) {
+                    FieldElement(index)->Clear();
                 }
                 _state = 0;
             }
@@ -3976,12 +4427,12 @@ namespace Core {
                 }
                 else {
                     if (offset == FIND_MARKER) {
-                        _iterator = _data.begin();
+                        _index = 0;
                         stream[loaded++] = '{';
 
-                        offset = (_iterator == _data.end() ? ~0 : ((_iterator->second->IsSet() == false) && (FindNext() == false)) ? ~0 : BEGIN_MARKER);
+                        offset = (_index == FieldCount() ? ~0 : ((FieldElement(_index)->IsSet() == false) && (FindNext() == false)) ? ~0 : BEGIN_MARKER);
                         if (offset == BEGIN_MARKER) {
-                            _fieldName = string(_iterator->first);
+                            _fieldName = string(FieldLabel(_index));
                             _current.json = &_fieldName;
                             offset = PARSE;
                         }
@@ -3997,12 +4448,12 @@ namespace Core {
                         } else if (offset == BEGIN_MARKER) {
                             if (_current.json == &_fieldName) {
                                 stream[loaded++] = ':';
-                                _current.json = _iterator->second;
+                                _current.json = FieldElement(_index);
                                 offset = PARSE;
                             } else {
                                 if (FindNext() != false) {
                                     stream[loaded++] = ',';
-                                    _fieldName = string(_iterator->first);
+                                    _fieldName = string(FieldLabel(_index));
                                     _current.json = &_fieldName;
                                     offset = PARSE;
                                 } else {
@@ -4069,7 +4520,7 @@ namespace Core {
                         if (loaded < maxLength) {
                             switch (stream[loaded]) {
                             case '}':
-                                if (offset == SKIP_BEFORE && !_data.empty()) {
+                                if (offset == SKIP_BEFORE && (FieldCount() > 0)) {
                                     _state = ERROR;
                                     error = Error{ "Expected new element, \"}\" found." };
                                 } else if (offset == SKIP_BEFORE_VALUE || offset == SKIP_AFTER_KEY) {
@@ -4196,10 +4647,10 @@ namespace Core {
                 else {
                     uint16_t elementSize = Size();
                     if (offset == 0) {
-                        _iterator = _data.begin();
+                        _index = 0;
                         if (elementSize <= 15) {
                             stream[loaded++] = (0x80 | static_cast<uint8_t>(Size()));
-                            if (_iterator != _data.end()) {
+                            if (_index < FieldCount()) {
                                 offset = PARSE;
                             }
                         } else {
@@ -4207,10 +4658,10 @@ namespace Core {
                             offset = 1;
                         }
                         if (offset != 0) {
-                            if ((_iterator->second->IsSet() == false) && (FindNext() == false)) {
+                            if ((FieldElement(_index)->IsSet() == false) && (FindNext() == false)) {
                                 offset = 0;
                             } else {
-                                _fieldName = string(_iterator->first);
+                                _fieldName = string(FieldLabel(_index));
                             }
                         }
                     }
@@ -4232,7 +4683,7 @@ namespace Core {
                             }
                             offset += PARSE;
                         } else {
-                            const IMessagePack* element = dynamic_cast<const IMessagePack*>(_iterator->second);
+                            const IMessagePack* element = dynamic_cast<const IMessagePack*>(FieldElement(_index));
                             if (element != nullptr) {
                                 loaded += element->Serialize(&(stream[loaded]), maxLength - loaded, offset);
                                 if (offset == 0) {
@@ -4244,7 +4695,7 @@ namespace Core {
                             offset += PARSE;
                             if (offset == PARSE) {
                                 if (FindNext() != false) {
-                                    _fieldName = string(_iterator->first);
+                                    _fieldName = string(FieldLabel(_index));
                                 } else {
                                 offset = 0;
                                 _fieldName.Clear();
@@ -4325,6 +4776,20 @@ namespace Core {
             {
                 IElement* result = nullptr;
 
+                if (_fieldCount > 0) {
+                    const uint16_t length = static_cast<uint16_t>(strlen(label));
+                    const uint32_t hash = LabelHash(label);
+                    uint16_t field = 0;
+
+                    while ((field < _fieldCount) && ((_fields[field].Hash != hash) || (_fields[field].Length != length) || (::memcmp(_fields[field].Label, label, length) != 0))) {
+                        field++;
+                    }
+
+                    if (field < _fieldCount) {
+                        return (_fields[field].Element(*this));
+                    }
+                }
+
                 JSONElementList::iterator index = _data.begin();
 
                 while ((index != _data.end()) && (strcmp(label, index->first) != 0)) {
@@ -4349,23 +4814,19 @@ namespace Core {
 
             bool FindNext() const
             {
-                _iterator++;
-                while ((_iterator != _data.end()) && (_iterator->second->IsSet() == false)) {
-                    _iterator++;
+                _index++;
+                while ((_index < FieldCount()) && (FieldElement(_index)->IsSet() == false)) {
+                    _index++;
                 }
-                return (_iterator != _data.end());
+                return (_index < FieldCount());
             }
 
             uint16_t Size() const
             {
                 uint16_t count = 0;
-                if (_data.size() > 0) {
-                    JSONElementList::const_iterator iterator = _data.begin();
-                    while (iterator != _data.end()) {
-                        if (iterator->second->IsSet() != false) {
-                            count++;
-                        }
-                        iterator++;
+                for (uint16_t index = 0; index < FieldCount(); index++) {
+                    if (FieldElement(index)->IsSet() != false) {
+                        count++;
                     }
                 }
                 return count;
@@ -4376,6 +4837,21 @@ namespace Core {
                 return (false);
             }
 
+        private:
+            // The compile time fields come first, followed by the ones registered with Add().
+            inline uint16_t FieldCount() const
+            {
+                return (_fieldCount + static_cast<uint16_t>(_data.size()));
+            }
+            inline const TCHAR* FieldLabel(const uint16_t index) const
+            {
+                return (index < _fieldCount ? _fields[index].Label : _data[index - _fieldCount].first);
+            }
+            inline IElement* FieldElement(const uint16_t index) const
+            {
+                return (index < _fieldCount ? _fields[index].Element(const_cast<Container&>(*this)) : _data[index - _fieldCount].second);
+            }
+
         private:
             uint8_t _state;
             uint16_t _count;
@@ -4383,8 +4859,10 @@ namespace Core {
                 mutable IElement* json;
                 mutable IMessagePack* pack;
             } _current;
+            const Field* _fields;
+            uint16_t _fieldCount;
             JSONElementList _data;
-            mutable JSONElementList::const_iterator _iterator;
+            mutable uint16_t _index;
             mutable String _fieldName;
         };
 
@@ -5383,4 +5861,19 @@ using JsonArray = Thunder::Core::JSON::ArrayType<JsonValue>;
 
 #endif // __DISABLE_USE_COMPLEMENTARY_CODE_SET__
 
+// Entry in the compile time field table of a JSON::Container, e.g.:
+//
+//   Config() : Core::JSON::Container(Fields()) {}
+//   ...
+//   static const Core::JSON::Container::FieldTable& Fields() {
+//       static constexpr Core::JSON::Container::Field fields[] = {
+//           JSON_FIELD(Config, _T("callsign"), Callsign),
+//           JSON_FIELD(Config, _T("locator"), Locator)
+//       };
+//       static constexpr Core::JSON::Container::FieldTable table(fields);
+//       return (table);
+//   }
+#define JSON_FIELD(CLASS, LABEL, MEMBER) \
+    Thunder::Core::JSON::Container::Field(LABEL, &Thunder::Core::JSON::Container::Member<CLASS, decltype(CLASS::MEMBER), &CLASS::MEMBER>)
+
 #endif // __JSON_H
@@ -59,34 +59,25 @@ namespace Core {
             class Info : public Core::JSON::Container {
             public:
                 Info()
-                    : Core::JSON::Container()
+                    : Core::JSON::Container(Fields())
                     , Code(0)
                     , Text()
                     , Data(false)
                 {
-                    Add(_T("code"), &Code);
-                    Add(_T("message"), &Text);
-                    Add(_T("data"), &Data);
                 }
                 Info(const Info& copy)
-                    : Core::JSON::Container()
+                    : Core::JSON::Container(Fields())
                     , Code(copy.Code)
                     , Text(copy.Text)
                     , Data(copy.Data)
                 {
-                    Add(_T("code"), &Code);
-                    Add(_T("message"), &Text);
-                    Add(_T("data"), &Data);
                 }
                 Info(Info&& move) noexcept
-                    : Core::JSON::Container()
+                    : Core::JSON::Container(Fields())
                     , Code(std::move(move.Code))
                     , Text(std::move(move.Text))
                     , Data(std::move(move.Data))
                 {
-                    Add(_T("code"), &Code);
-                    Add(_T("message"), &Text);
-                    Add(_T("data"), &Data);
                 }
                 ~Info() override = default;
 
@@ -108,6 +99,18 @@ namespace Core {
                     return (*this);
                 }
 
+            private:
+                static const Core::JSON::Container::FieldTable& Fields()
+                {
+                    static constexpr Core::JSON::Container::Field fields[] = {
+                        JSON_FIELD(Info, _T("code"), Code),
+                        JSON_FIELD(Info, _T("message"), Text),
+                        JSON_FIELD(Info, _T("data"), Data)
+                    };
+                    static constexpr Core::JSON::Container::FieldTable table(fields);
+                    return (table);
+                }
+
             public:
                 void Clear() override
                 {
@@ -225,7 +228,7 @@ namespace Core {
             Message& operator=(const Message&) = delete;
 
             Message()
-                : Core::JSON::Container()
+                : Core::JSON::Container(Fields())
                 , JSONRPC(DefaultVersion)
                 , Id(~0)
                 , Designator()
@@ -234,17 +237,10 @@ namespace Core {
                 , Error()
                 , _implicitCallsign()
             {
-                Add(_T("jsonrpc"), &JSONRPC);
-                Add(KeyId, &Id);
-                Add(KeyMethod, &Designator);
-                Add(KeyParameters, &Parameters);
-                Add(KeyResult, &Result);
-                Add(KeyError, &Error);
-
                 Clear();
             }
             Message(const Message& copy)
-                : Core::JSON::Container()
+                : Core::JSON::Container(Fields())
                 , JSONRPC(copy.JSONRPC)
                 , Id(copy.Id)
                 , Designator(copy.Designator)
@@ -253,15 +249,9 @@ namespace Core {
                 , Error(copy.Error)
                 , _implicitCallsign(copy._implicitCallsign)
             {
-                Add(_T("jsonrpc"), &JSONRPC);
-                Add(KeyId, &Id);
-                Add(KeyMethod, &Designator);
-                Add(KeyParameters, &Parameters);
-                Add(KeyResult, &Result);
-                Add(KeyError, &Error);
             }
             Message(Message&& move) noexcept
-                : Core::JSON::Container()
+                : Core::JSON::Container(Fields())
                 , JSONRPC(std::move(move.JSONRPC))
                 , Id(std::move(move.Id))
                 , Designator(std::move(move.Designator))
@@ -270,12 +260,6 @@ namespace Core {
                 , Error(std::move(move.Error))
                 , _implicitCallsign(std::move(move._implicitCallsign))
             {
-                Add(_T("jsonrpc"), &JSONRPC);
-                Add(KeyId, &Id);
-                Add(KeyMethod, &Designator);
-                Add(KeyParameters, &Parameters);
-                Add(KeyResult, &Result);
-                Add(KeyError, &Error);
             }
             ~Message() override = default;
 
@@ -614,6 +598,18 @@ POP_WARNING()
             {
                 _implicitCallsign = implicitCallsign;
             }
+            // Field-wise copy into an existing (typically pooled) message, as the
+            // assignment operators are not available on a Container.
+            void Assign(const Message& source)
+            {
+                JSONRPC = source.JSONRPC;
+                Id = source.Id;
+                Designator = source.Designator;
+                Parameters = source.Parameters;
+                Result = source.Result;
+                Error = source.Error;
+                _implicitCallsign = source._implicitCallsign;
+            }
 
             Core::JSON::String JSONRPC;
             Core::JSON::DecUInt32 Id;
@@ -646,10 +642,56 @@ POP_WARNING()
                 }
             }
 
+            static const Core::JSON::Container::FieldTable& Fields()
+            {
+                static constexpr Core::JSON::Container::Field fields[] = {
+                    JSON_FIELD(Message, _T("jsonrpc"), JSONRPC),
+                    JSON_FIELD(Message, KeyId, Id),
+                    JSON_FIELD(Message, KeyMethod, Designator),
+                    JSON_FIELD(Message, KeyParameters, Parameters),
+                    JSON_FIELD(Message, KeyResult, Result),
+                    JSON_FIELD(Message, KeyError, Error)
+                };
+                static constexpr Core::JSON::Container::FieldTable table(fields);
+                return (table);
+            }
+
         private:
             string _implicitCallsign;
         };
 
+        // JSON-RPC 2.0 batch: a set of requests (or their responses) that
+        // travels as a single JSON array. Responses may come back in any
+        // order, they are matched on their id.
+        class EXTERNAL Batch : public Core::JSON::ArrayType<Message> {
+        public:
+            Batch(Batch&&) = delete;
+            Batch(const Batch&) = delete;
+            Batch& operator=(Batch&&) = delete;
+            Batch& operator=(const Batch&) = delete;
+
+            Batch() = default;
+            ~Batch() override = default;
+
+        public:
+            // A JSON text frame carries a batch if it opens with an array.
+            static bool IsBatch(const uint8_t stream[], const uint16_t length)
+            {
+                uint16_t index = 0;
+
+                while ((index < length) && ((stream[index] == ' ') || (stream[index] == '\t') || (stream[index] == '\r') || (stream[index] == '\n'))) {
+                    index++;
+                }
+
+                return ((index < length) && (stream[index] == '['));
+            }
+            // A MessagePack frame carries a batch if it opens with an array (fixarray, array16 or array32).
+            static bool IsPackedBatch(const uint8_t stream[], const uint16_t length)
+            {
+                return ((length > 0) && (((stream[0] & 0xF0) == 0x90) || (stream[0] == 0xDC) || (stream[0] == 0xDD)));
+            }
+        };
+
         class EXTERNAL Context {
         public:
             Context& operator=(const Context& rhs) = delete;
@@ -0,0 +1,292 @@
+/*
+ * If not stated otherwise in this file or this component's LICENSE file the
+ * following copyright and licenses apply:
+ *
+ * Copyright 2020 Metrological
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include "Module.h"
+#include "Portability.h"
+
+#ifndef __WINDOWS__
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+namespace Thunder {
+namespace Core {
+
+    // Zero allocation scanner over the text the kernel produces in procfs, sysfs and cgroupfs
+    // files: numbers separated by white space and "key value" or "key: value" lines.
+    class TextScanner {
+    public:
+        TextScanner() = delete;
+        TextScanner& operator=(const TextScanner&) = delete;
+
+        TextScanner(const char data[], const uint32_t length)
+            : _begin(data)
+            , _current(data)
+            , _end(data + length)
+        {
+        }
+        TextScanner(const TextScanner&) = default;
+        ~TextScanner() = default;
+
+    public:
+        inline bool AtEnd() const
+        {
+            return (_current >= _end);
+        }
+        inline char Peek() const
+        {
+            return (_current < _end ? *_current : '\0');
+        }
+        inline void SkipSpaces()
+        {
+            while ((_current < _end) && ((*_current == ' ') || (*_current == '\t'))) {
+                _current++;
+            }
+        }
+        inline void SkipWhitespace()
+        {
+            while ((_current < _end) && (::isspace(static_cast<unsigned char>(*_current)) != 0)) {
+                _current++;
+            }
+        }
+        // Skip the current field and the white space that follows it.
+        inline void SkipField(uint16_t count = 1)
+        {
+            while (count-- > 0) {
+                SkipWhitespace();
+                while ((_current < _end) && (::isspace(static_cast<unsigned char>(*_current)) == 0)) {
+                    _current++;
+                }
+            }
+            SkipWhitespace();
+        }
+        inline void SkipLine()
+        {
+            while ((_current < _end) && (*_current != '\n')) {
+                _current++;
+            }
+            if (_current < _end) {
+                _current++;
+            }
+        }
+        // Continue after the last occurence of the given character, e.g. the ')' closing the
+        // process name in /proc/<pid>/stat that might contain spaces and ')' itself.
+        inline bool SkipPastLast(const char marker)
+        {
+            const char* index = _end;
+
+            while ((index > _current) && (*(index - 1) != marker)) {
+                index--;
+            }
+
+            const bool found = (index > _current);
+
+            if (found == true) {
+                _current = index;
+            }
+
+            return (found);
+        }
+        // Consumes the keyword if the text at the current position starts with it.
+        inline bool Match(const char keyword[])
+        {
+            const char* index = _current;
+
+            while ((*keyword != '\0') && (index < _end) && (*index == *keyword)) {
+                index++;
+                keyword++;
+            }
+
+            const bool matched = (*keyword == '\0');
+
+            if (matched == true) {
+                _current = index;
+            }
+
+            return (matched);
+        }
+        // Positions after <key> at the start of a line. The search starts at the current position
+        // and wraps around to the beginning, so keys can be looked up in any order and a key that
+        // is absent (e.g. MemAvailable on older kernels) does not lose the ones that follow it.
+        // If the key is not found, the position is left untouched.
+        inline bool Line(const char key[])
+        {
+            const char* start = _current;
+            bool found = Find(key, _end);
+
+            if (found == false) {
+                _current = _begin;
+
+                found = Find(key, start);
+
+                if (found == false) {
+                    _current = start;
+                }
+            }
+
+            return (found);
+        }
+        inline uint64_t Number()
+        {
+            uint64_t result = 0;
+
+            SkipWhitespace();
+
+            while ((_current < _end) && (*_current >= '0') && (*_current <= '9')) {
+                result = (result * 10) + static_cast<uint64_t>(*_current - '0');
+                _current++;
+            }
+
+            return (result);
+        }
+        inline int64_t Signed()
+        {
+            SkipWhitespace();
+
+            const bool negative = ((_current < _end) && (*_current == '-'));
+
+            if (negative == true) {
+                _current++;
+            }
+
+            const int64_t value = static_cast<int64_t>(Number());
+
+            return (negative == true ? -value : value);
+        }
+        inline char Character()
+        {
+            SkipWhitespace();
+
+            return (_current < _end ? *_current++ : '\0');
+        }
+
+    private:
+        inline bool Find(const char key[], const char* end)
+        {
+            bool found = false;
+
+            while ((found == false) && (_current < end)) {
+                found = Match(key);
+
+                if (found == false) {
+                    SkipLine();
+                }
+            }
+
+            return (found);
+        }
+
+    private:
+        const char* _begin;
+        const char* _current;
+        const char* _end;
+    };
+
+    // A kernel generated file that is opened once and re-read from the start with a single
+    // pread() into a fixed buffer for every sample. Only the first SIZE bytes are read, which
+    // is all that is needed for files like /proc/stat where the interesting data comes first.
+    template <const uint16_t SIZE>
+    class KernelFileType {
+    public:
+        KernelFileType(KernelFileType<SIZE>&&) = delete;
+        KernelFileType(const KernelFileType<SIZE>&) = delete;
+        KernelFileType<SIZE>& operator=(KernelFileType<SIZE>&&) = delete;
+        KernelFileType<SIZE>& operator=(const KernelFileType<SIZE>&) = delete;
+
+        KernelFileType()
+            : _handle(-1)
+            , _length(0)
+        {
+        }
+        explicit KernelFileType(const string& path)
+            : _handle(-1)
+            , _length(0)
+        {
+            Open(path);
+        }
+        ~KernelFileType()
+        {
+            Close();
+        }
+
+    public:
+        inline bool IsOpen() const
+        {
+            return (_handle != -1);
+        }
+        bool Open(const string& path)
+        {
+            Close();
+
+#ifndef __WINDOWS__
+            _handle = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+#endif
+
+            return (IsOpen());
+        }
+        void Close()
+        {
+#ifndef __WINDOWS__
+            if (_handle != -1) {
+                ::close(_handle);
+            }
+#endif
+            _handle = -1;
+            _length = 0;
+        }
+        // Fetch the current content. Fails if the file is not open or is gone, e.g. the file of a
+        // process that has exited.
+        bool Load()
+        {
+            bool result = false;
+
+            _length = 0;
+
+#ifndef __WINDOWS__
+            if (_handle != -1) {
+                const ssize_t size = ::pread(_handle, _buffer, sizeof(_buffer), 0);
+
+                if (size >= 0) {
+                    _length = static_cast<uint16_t>(size);
+                    result = true;
+                }
+            }
+#endif
+
+            return (result);
+        }
+        inline TextScanner Content() const
+        {
+            return (TextScanner(_buffer, _length));
+        }
+        inline uint16_t Length() const
+        {
+            return (_length);
+        }
+
+    private:
+        int _handle;
+        uint16_t _length;
+        char _buffer[SIZE];
+    };
+
+} // namespace Core
+} // namespace Thunder
@@ -22,6 +22,7 @@
 #include "Netlink.h"
 #include "Number.h"
 #include "Proxy.h"
+#include "ReadMostlyMap.h"
 #include "Serialization.h"
 #include "Sync.h"
 #include "Trace.h"
@@ -952,6 +953,14 @@ namespace Core {
                     case RTM_DELADDR:
                         result = Update(false, reinterpret_cast<const struct ifaddrmsg*>(stream), length);
                         break;
+                    case RTM_NEWROUTE:
+                    case RTM_DELROUTE:
+                        if (length >= sizeof(struct rtmsg)) {
+                            _ipnetworks.Route((Type() == RTM_NEWROUTE), ((Flags() & NLM_F_REPLACE) != 0), stream, length);
+                        } else {
+                            TRACE_L1("NetworkInfo: Truncated route information received via Netlink");
+                        }
+                        break;
                     default:
                         TRACE_L1("NetworkInfo: unhandled Netlink notification type [%i]", Type());
                         break;
@@ -967,7 +976,7 @@ namespace Core {
                         if (added == true) {
                             const struct rtattr* rta = reinterpret_cast<const struct rtattr*>(IFLA_RTA(ifi));
                             const uint16_t size = (length - sizeof(struct ifinfomsg));
-                            _ipnetworks.Add(ifi->ifi_index, rta, size);
+                            _ipnetworks.Add(ifi->ifi_index, ifi->ifi_flags, rta, size);
                         } else {
                             _ipnetworks.Remove(ifi->ifi_index);
                         }
@@ -1103,6 +1112,31 @@ namespace Core {
                 private:
                     uint32_t _interface;
                 };
+
+                class GetRoute : public Command {
+                public:
+                    GetRoute(const GetRoute&) = delete;
+                    GetRoute& operator=(const GetRoute&) = delete;
+                    ~GetRoute() = default;
+
+                    GetRoute()
+                        : Command(RTM_GETROUTE)
+                    {
+                    }
+
+                private:
+                    uint16_t Write(uint8_t stream[], const uint16_t maxLength VARIABLE_IS_NOT_USED) const override
+                    {
+                        const uint16_t length = sizeof(struct rtmsg);
+                        ASSERT(length <= maxLength);
+
+                        struct rtmsg* message(reinterpret_cast<struct rtmsg*>(stream));
+                        ::memset(message, 0, sizeof(struct rtmsg));
+                        message->rtm_family = AF_UNSPEC;
+
+                        return (length);
+                    }
+                };
             }; // struct Message
 
         public:
@@ -1113,7 +1147,7 @@ namespace Core {
             LinkSocket(IPNetworks& parent, bool listener)
                 : SocketNetlink(NodeId(NETLINK_ROUTE,
                                        0 /* kernel takes care of assigining a unique socket ID */,
-                                       (listener? (RTMGRP_LINK | RTMGRP_IPV4_IFADDR | RTMGRP_IPV6_IFADDR) : 0)))
+                                       (listener? (RTMGRP_LINK | RTMGRP_IPV4_IFADDR | RTMGRP_IPV6_IFADDR | RTMGRP_IPV4_ROUTE | RTMGRP_IPV6_ROUTE) : 0)))
                 , _messageSink(parent)
             {
             }
@@ -1136,6 +1170,14 @@ namespace Core {
                 SocketDatagram::Close(Core::infinite);
             }
 
+#ifdef BUILD_TESTS
+            static uint16_t Inject(IPNetworks& parent, const uint8_t stream[], const uint16_t length)
+            {
+                Sink sink(parent);
+                return (sink.Deserialize(stream, length));
+            }
+#endif
+
         public:
             void RequestStatus()
             {
@@ -1143,10 +1185,10 @@ namespace Core {
 
                 if (Exchange(Message::GetLink(), _messageSink, 2000) != ERROR_NONE) {
                     TRACE_L1("NetworkInfo: Failed to retrieve interface information");
-                } else {
-                    if (Exchange(Message::GetAddress(), _messageSink, 2000) != ERROR_NONE) {
-                        TRACE_L1("NetworkInfo: Failed to retrieve interface address information");
-                    }
+                } else if (Exchange(Message::GetAddress(), _messageSink, 2000) != ERROR_NONE) {
+                    TRACE_L1("NetworkInfo: Failed to retrieve interface address information");
+                } else if (Exchange(Message::GetRoute(), _messageSink, 2000) != ERROR_NONE) {
+                    TRACE_L1("NetworkInfo: Failed to retrieve routing information");
                 }
             }
 
@@ -1237,6 +1279,8 @@ namespace Core {
             : _adminLock()
             , _channel(ProxyType<Channel>::Create())
             , _networks()
+            , _index()
+            , _routes()
             , _linkSocket(*this, true)
             , _observers()
         {
@@ -1261,13 +1305,14 @@ namespace Core {
         ~IPNetworks()
         {
             _linkSocket.Close();
+            _index.Clear();
             _networks.clear();
         }
 
         static IPNetworks& Instance()
         {
-            static IPNetworks& _instance = SingletonType<IPNetworks>::Instance();
-            return (_instance);
+            // Not cached in a local static, the singleton is recreated after a Singleton::Dispose().
+            return (SingletonType<IPNetworks>::Instance());
         }
 
     public:
@@ -1275,11 +1320,22 @@ namespace Core {
         {
             return ((_channel.IsValid()) && (_channel->IsValid() == true));
         }
-        void Load(std::list<Core::ProxyType<Network>>& list) {
+        // As long as the netlink listener runs, the cached state follows the kernel.
+        inline bool IsListening() const
+        {
+            return (_linkSocket.IsOpen());
+        }
+        void Load(std::list<Core::ProxyType<Network>>& list) const {
+            _index.Visit([&list](const string&, const Core::ProxyType<Network>& network) {
+                list.push_back(network);
+            });
+        }
+        bool Find(const string& name, Core::ProxyType<Network>& network) const {
+            return (_index.Find(name, network));
+        }
+        void Routes(const bool ipv4, std::list<RoutingTable::Route>& list) const {
             _adminLock.Lock();
-            for (const Element& element : _networks) {
-                list.push_back(element.second);
-            }
+            list = _routes[ipv4 == true ? 0 : 1];
             _adminLock.Unlock();
         }
         void Register(AdapterObserver::INotification* client) {
@@ -1306,21 +1362,34 @@ namespace Core {
         inline uint32_t Exchange(const Netlink& outbound, Netlink& inbound) {
             return(_channel->Exchange(outbound, inbound));
         }
+#ifdef BUILD_TESTS
+        uint16_t Inject(const uint8_t stream[], const uint16_t length) {
+            return (LinkSocket::Inject(*this, stream, length));
+        }
+#endif
 
     private:
-        void Add(const uint32_t id, const struct rtattr* data, const uint16_t length) {
+        void Add(const uint32_t id, const uint32_t flags, const struct rtattr* data, const uint16_t length) {
             _adminLock.Lock();
             Map::iterator index (_networks.find(id));
             if (index == _networks.end()) {
-                Core::ProxyType<Network> newNetwork (Core::ProxyType<Network>::Create(id, data, length));
+                Core::ProxyType<Network> newNetwork (Core::ProxyType<Network>::Create(id, flags, data, length));
                 _networks.emplace(std::piecewise_construct,
                     std::forward_as_tuple(id),
                     std::forward_as_tuple(newNetwork));
-                Notify(newNetwork->Name());
+                Publish();
+                Notify(newNetwork->Name(), AdapterObserver::CREATED);
             }
             else {
-                index->second->Update(data, length);
-                Notify(index->second->Name());
+                // The kernel repeats the full link state on every change, only report what differs.
+                const uint8_t changes = index->second->Update(flags, data, length);
+
+                if (changes != 0) {
+                    if ((changes & AdapterObserver::RENAMED) != 0) {
+                        Publish();
+                    }
+                    Notify(index->second->Name(), changes);
+                }
             }
             _adminLock.Unlock();
         }
@@ -1330,13 +1399,74 @@ namespace Core {
             if (index != _networks.end()) {
                 string interfaceName(index->second->Name());
                 _networks.erase(index);
-                Notify(interfaceName);
+                Publish();
+                Notify(interfaceName, AdapterObserver::DESTROYED);
             }
             _adminLock.Unlock();
         }
-        void Notify(const string& name) {
+        void Route(const bool added, const bool replace, const uint8_t stream[], const uint16_t length) {
+            const struct rtmsg* message = reinterpret_cast<const struct rtmsg*>(stream);
+
+            // Only the main table is of interest, as it was when the table was requested on demand.
+            if (((message->rtm_family == AF_INET) || (message->rtm_family == AF_INET6)) && (message->rtm_table == RT_TABLE_MAIN)) {
+                RoutingTable::Route route(stream, length);
+                std::list<RoutingTable::Route>& routes(_routes[message->rtm_family == AF_INET ? 0 : 1]);
+
+                _adminLock.Lock();
+
+                std::list<RoutingTable::Route>::iterator index(std::find(routes.begin(), routes.end(), route));
+
+                if (added == false) {
+                    if (index != routes.end()) {
+                        routes.erase(index);
+                        NotifyRouteUpdate(route, false);
+                    }
+                } else if (index != routes.end()) {
+                    // Same route, e.g. a changed metric or preferred source, nothing to report.
+                    *index = std::move(route);
+                } else {
+                    if (replace == true) {
+                        index = std::find_if(routes.begin(), routes.end(), [&route](const RoutingTable::Route& entry) { return (route.Replaces(entry)); });
+
+                        if (index != routes.end()) {
+                            RoutingTable::Route replaced(std::move(*index));
+                            routes.erase(index);
+                            NotifyRouteUpdate(replaced, false);
+                        }
+                    }
+
+                    routes.push_back(route);
+                    NotifyRouteUpdate(route, true);
+                }
+
+                _adminLock.Unlock();
+            }
+        }
+        void Publish() {
+            std::vector<std::pair<string, Core::ProxyType<Network>>> entries;
+
+            entries.reserve(_networks.size());
+
+            for (const Element& element : _networks) {
+                string name(element.second->Name());
+
+                // A rename can briefly leave two links with the same name, the lowest index wins.
+                if (std::find_if(entries.begin(), entries.end(), [&name](const std::pair<string, Core::ProxyType<Network>>& entry) { return (entry.first == name); }) == entries.end()) {
+                    entries.emplace_back(std::move(name), element.second);
+                }
+            }
+
+            _index.Publish(entries.begin(), entries.end());
+        }
+        void Notify(const string& name, const uint8_t changes) {
             for (AdapterObserver::INotification* callback : _observers) {
                 callback->Event(name);
+                callback->Link(name, changes);
+            }
+        }
+        void NotifyRouteUpdate(const RoutingTable::Route& route, const bool added) {
+            for (AdapterObserver::INotification* callback : _observers) {
+                callback->Route(route, added);
             }
         }
         void NotifyAddressUpdate(const string& name, const Core::IPNode& address, const bool added) {
@@ -1370,9 +1500,11 @@ namespace Core {
         }
 
     private:
-        CriticalSection _adminLock;
+        mutable CriticalSection _adminLock;
         ProxyType<Channel> _channel;
         Map _networks;
+        ReadMostlyMapType<ProxyType<Network>> _index;
+        std::list<RoutingTable::Route> _routes[2];
         LinkSocket _linkSocket;
         std::list<AdapterObserver::INotification*> _observers;
     };
@@ -1521,53 +1653,54 @@ namespace Core {
             std::list<Route>& _table;
         } collector (_table, ipv4);
 
-        IPNetworks::Instance().Exchange(collector, collector);
+        IPNetworks& networks(IPNetworks::Instance());
+
+        if (networks.IsListening() == true) {
+            networks.Routes(ipv4, _table);
+        } else {
+            networks.Exchange(collector, collector);
+        }
     }
 
 
-    Network::Network(const uint32_t index, const struct rtattr* iface, const uint32_t length)
+    Network::Network(const uint32_t index, const uint32_t flags, const struct rtattr* iface, const uint32_t length)
         : _adminLock()
         , _index(index)
+        , _flags(flags)
         , _name()
         , _ipv4Nodes()
         , _ipv6Nodes()
     {
-        Update(iface, length);
+        ::memset(_MAC, 0, sizeof(_MAC));
+
+        Update(flags, iface, length);
     }
 
     bool Network::IsUp() const {
+        return ((State() & IFF_UP) == IFF_UP);
+    }
 
-        bool result = false;
-        int sockfd;
-
-        sockfd = ::socket(AF_INET, SOCK_DGRAM|SOCK_CLOEXEC, 0);
-
-        if (sockfd >= 0) {
-
-            struct ifreq ifr;
-
-            result = Core::ERROR_NONE;
+    bool Network::IsRunning() const {
+        return ((State() & (IFF_UP | IFF_RUNNING)) == (IFF_UP | IFF_RUNNING));
+    }
 
-            ::memset(&ifr, 0, sizeof ifr);
+    uint32_t Network::State() const {
+        uint32_t result;
 
+        if (IPNetworks::Instance().IsListening() == true) {
             _adminLock.Lock();
-
-            ::strncpy(ifr.ifr_name, _name.c_str(), IFNAMSIZ - 1);
-
+            result = _flags;
             _adminLock.Unlock();
-
-            ::ioctl(sockfd, SIOCGIFFLAGS, &ifr);
-
-            result = ((ifr.ifr_flags & IFF_UP) == IFF_UP);
-            ::close(sockfd);
+        } else {
+            result = Flags();
         }
 
         return (result);
     }
 
-    bool Network::IsRunning() const {
+    uint32_t Network::Flags() const {
 
-        bool result = false;
+        uint32_t result = 0;
         int sockfd;
 
         sockfd = ::socket(AF_INET, SOCK_DGRAM|SOCK_CLOEXEC, 0);
@@ -1576,8 +1709,6 @@ namespace Core {
 
             struct ifreq ifr;
 
-            result = Core::ERROR_NONE;
-
             ::memset(&ifr, 0, sizeof ifr);
 
             _adminLock.Lock();
@@ -1586,9 +1717,10 @@ namespace Core {
 
             _adminLock.Unlock();
 
-            ::ioctl(sockfd, SIOCGIFFLAGS, &ifr);
+            if (::ioctl(sockfd, SIOCGIFFLAGS, &ifr) >= 0) {
+                result = static_cast<uint16_t>(ifr.ifr_flags);
+            }
 
-            result = ((ifr.ifr_flags & (IFF_UP | IFF_RUNNING)) == (IFF_UP | IFF_RUNNING));
             ::close(sockfd);
         }
 
@@ -1686,10 +1818,20 @@ namespace Core {
         return (IPNetworks::Instance().Exchange(modifier, modifier));
     }
 
-    void Network::Update(const struct rtattr* rtatp, const uint16_t length)
+    uint8_t Network::Update(const uint32_t flags, const struct rtattr* rtatp, const uint16_t length)
     {
+        uint8_t changes = 0;
         uint16_t rtattrlen = length;
 
+        _adminLock.Lock();
+
+        if (flags != _flags) {
+            _flags = flags;
+            changes |= AdapterObserver::STATE;
+        }
+
+        _adminLock.Unlock();
+
         for (; (rtattrlen <= length) && RTA_OK(rtatp, rtattrlen); rtatp = RTA_NEXT(rtatp, rtattrlen)) {
 
             /* Here we hit the fist chunk of the message. Time to validate the    *
@@ -1710,7 +1852,10 @@ namespace Core {
             switch (rtatp->rta_type) {
             case IFLA_ADDRESS: {
                 _adminLock.Lock();
-                ::memcpy(_MAC, RTA_DATA(rtatp), sizeof(_MAC));
+                if (::memcmp(_MAC, RTA_DATA(rtatp), sizeof(_MAC)) != 0) {
+                    ::memcpy(_MAC, RTA_DATA(rtatp), sizeof(_MAC));
+                    changes |= AdapterObserver::MAC;
+                }
                 _adminLock.Unlock();
                 break;
             }
@@ -1719,6 +1864,7 @@ namespace Core {
                 string newName(reinterpret_cast<const char*>(RTA_DATA(rtatp)), (RTA_PAYLOAD(rtatp) - 1));
                 if (newName != _name) {
                     _name = newName;
+                    changes |= AdapterObserver::RENAMED;
                 }
                 _adminLock.Unlock();
                 break;
@@ -1773,10 +1919,13 @@ namespace Core {
                 break;
             }
         }
+
+        return (changes);
     }
 
     uint32_t Network::MAC(const uint8_t buffer[6]) {
-        uint32_t result = (IsUp() == false ? Core::ERROR_NONE : Core::ERROR_ILLEGAL_STATE);
+        // Ask the kernel, the cached state may not yet reflect a preceding Up(false).
+        uint32_t result = ((Flags() & IFF_UP) == 0 ? Core::ERROR_NONE : Core::ERROR_ILLEGAL_STATE);
 
         if (result == Core::ERROR_NONE) {
             struct ifreq ifr;
@@ -1815,36 +1964,58 @@ namespace Core {
         while ( (Next() == true) && (Index() != index) ) { /* Intentionally left empty */ }
     }
 
-    AdapterIterator::AdapterIterator(const string& name) 
+    AdapterIterator::AdapterIterator(const string& name)
         : AdapterIterator() {
-        while ( (Next() == true) && (Name() != name) ) { /* Intentionally left empty */ }
+        Core::ProxyType<Network> network;
+
+        if (IPNetworks::Instance().Find(name, network) == true) {
+            while ( (Next() == true) && (*_index != network) ) { /* Intentionally left empty */ }
+        } else {
+            _index = _list.end();
+            _reset = false;
+        }
     }
 
     AdapterIterator::AdapterIterator(const AdapterIterator& copy)
-        : AdapterIterator() {
-        if (copy.IsValid() == true) {
-            const string name (copy.Name());
-            while ( (Next() == true) && (Name() != name) ) { /* Intentionally left empty */ }
+        : _reset(copy._reset)
+        , _list(copy._list)
+        , _index(_list.begin()) {
+        std::list<Core::ProxyType<Network>>::const_iterator position(copy._list.begin());
+
+        while (position != copy._index) {
+            ++position;
+            ++_index;
         }
     }
     AdapterIterator::AdapterIterator(AdapterIterator&& move)
-        : AdapterIterator() {
-        _reset = move._reset;
-        _list = std::move(move._list);
-        _index = std::move(move._index);
+        : _reset(move._reset)
+        , _list()
+        , _index() {
+        // Splicing keeps the position valid, the moved from list becomes empty.
+        const bool atEnd = (move._index == move._list.end());
+        _index = move._index;
+        _list.splice(_list.begin(), move._list);
+        if (atEnd == true) {
+            _index = _list.end();
+        }
 
-         move._reset = 0;
+        move._reset = true;
+        move._index = move._list.end();
     }
 
     AdapterIterator& AdapterIterator::operator=(const AdapterIterator& RHS)
     {
-        _reset = true;
-        _list = RHS._list;
-        _index = _list.begin();
+        if (this != &RHS) {
+            std::list<Core::ProxyType<Network>>::const_iterator position(RHS._list.begin());
 
-        if (RHS.IsValid()) {
-            string name (RHS.Name());
-            while ( (Next() == true) && (Name() != name) ) { /* Intentionally left empty */ }
+            _reset = RHS._reset;
+            _list = RHS._list;
+            _index = _list.begin();
+
+            while (position != RHS._index) {
+                ++position;
+                ++_index;
+            }
         }
 
         return (*this);
@@ -1910,6 +2081,12 @@ namespace Core {
         return (Core::ERROR_NONE);
     }
 
+#if defined(BUILD_TESTS) && !defined(__WINDOWS__) && !defined(__APPLE__)
+    /* static */ uint16_t AdapterObserver::Inject(const uint8_t stream[], const uint16_t length) {
+        return (IPNetworks::Instance().Inject(stream, length));
+    }
+#endif
+
     bool AdapterIterator::HasMAC() const
     {
         uint8_t index = 0;
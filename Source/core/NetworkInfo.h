@@ -151,6 +151,23 @@ namespace Core {
             }
             inline string Interface() const;
 
+            // The same route, as netlink identifies it when it is removed.
+            bool operator==(const Route& rhs) const {
+                return ((Replaces(rhs) == true) && (_interface == rhs._interface) && (Same(_gateway, rhs._gateway) == true));
+            }
+            bool operator!=(const Route& rhs) const {
+                return (!operator==(rhs));
+            }
+            // Takes the place of the given route when it is announced as a replacement.
+            bool Replaces(const Route& rhs) const {
+                return ((_table == rhs._table) && (_mask == rhs._mask) && (_priority == rhs._priority) && (Same(_destination, rhs._destination) == true));
+            }
+
+        private:
+            static bool Same(const NodeId& lhs, const NodeId& rhs) {
+                return (((lhs.IsValid() == false) && (rhs.IsValid() == false)) || (lhs == rhs));
+            }
+
         private:
             NodeId _source;
             NodeId _destination;
@@ -176,6 +193,9 @@ namespace Core {
         ~RoutingTable() = default;
 
     public:
+        inline const std::list<Route>& Routes() const {
+            return (_table);
+        }
 
     private:
         std::list<Route> _table;
@@ -184,12 +204,23 @@ namespace Core {
 
     class EXTERNAL AdapterObserver {
     public:
+        enum change : uint8_t {
+            CREATED = 0x01,
+            DESTROYED = 0x02,
+            RENAMED = 0x04,
+            MAC = 0x08,
+            STATE = 0x10
+        };
+
         struct EXTERNAL INotification {
             virtual ~INotification() = default;
 
+            // Something changed on the adapter, the other methods tell what exactly.
             virtual void Event(const string&) = 0;
             virtual void Added(const string&, const Core::IPNode&) {}
             virtual void Removed(const string&, const Core::IPNode&) {}
+            virtual void Link(const string& /* interface */, const uint8_t /* changes, see change */) {}
+            virtual void Route(const RoutingTable::Route& /* route */, const bool /* added */) {}
         };
 
     public:
@@ -204,6 +235,11 @@ namespace Core {
         uint32_t Open();
         uint32_t Close();
 
+#if defined(BUILD_TESTS) && !defined(__WINDOWS__) && !defined(__APPLE__)
+        // Handles a netlink stream as if the kernel sent it, to test the notifications.
+        static uint16_t Inject(const uint8_t stream[], const uint16_t length);
+#endif
+
     private:
 #if !defined(__WINDOWS__) && !defined(__APPLE__)
         INotification* _callback;
@@ -620,7 +656,7 @@ namespace Core {
         Network(const Network&) = delete;
         Network& operator=(const Network&) = delete;
 
-        Network(const uint32_t index, const struct rtattr* iface, const uint32_t length);
+        Network(const uint32_t index, const uint32_t flags, const struct rtattr* iface, const uint32_t length);
         ~Network() = default;
 
     public:
@@ -725,13 +761,18 @@ namespace Core {
         uint32_t Add(const IPNode& address);
         uint32_t Delete(const IPNode& address);
         uint32_t Gateway(const IPNode& network, const NodeId& gateway);
-        void Update(const struct rtattr* rtatp, const uint16_t length);
+        uint8_t Update(const uint32_t flags, const struct rtattr* rtatp, const uint16_t length);
         void Addresses();
         uint32_t MAC(const uint8_t buffer[6]);
 
+    private:
+        uint32_t State() const;
+        uint32_t Flags() const;
+
     private:
         mutable Core::CriticalSection _adminLock;
         const uint32_t _index;
+        uint32_t _flags;
         uint8_t _MAC[6];
         string _name;
         std::list<IPNode> _ipv4Nodes;
@@ -20,6 +20,7 @@
 #include "Errors.h"
 #include "ProcessInfo.h"
 #include "FileSystem.h"
+#include "KernelFile.h"
 #include "SystemInfo.h"
 
 #ifdef __WINDOWS__
@@ -47,6 +48,26 @@ namespace Thunder {
 namespace Core {
 #ifndef __WINDOWS__
     const uint32_t PageSize = getpagesize();
+
+    // Field <index> of /proc/<pid>/statm (size resident shared ...), converted to bytes.
+    static uint64_t StatmField(const pid_t pid, const uint16_t index)
+    {
+        uint64_t result = 0;
+        char path[48];
+
+        snprintf(path, sizeof(path), "/proc/%d/statm", pid);
+
+        KernelFileType<128> statm(path);
+
+        if (statm.Load() == true) {
+            TextScanner scanner(statm.Content());
+
+            scanner.SkipField(index);
+            result = scanner.Number() * PageSize;
+        }
+
+        return (result);
+    }
 #endif
 
 #ifdef __WINDOWS__
@@ -421,21 +442,7 @@ namespace Core {
             }
         }
 #else
-        int fd;
-        TCHAR buffer[128];
-        int VmSize = 0;
-
-        snprintf(buffer, sizeof(buffer), "/proc/%d/statm", _pid);
-        if ((fd = open(buffer, O_RDONLY)) != -1) {
-            ssize_t readAmount = 0;
-            if ((readAmount = read(fd, buffer, sizeof(buffer))) > 0) {
-                ssize_t nulIndex = std::min(readAmount, static_cast<ssize_t>(sizeof(buffer) - 1));
-                buffer[nulIndex] = '\0';
-                sscanf(buffer, "%d", &VmSize);
-                result = VmSize * PageSize;
-            }
-            close(fd);
-        }
+        result = StatmField(_pid, 0);
 #endif
 
         return (result);
@@ -452,21 +459,7 @@ namespace Core {
             }
         }
 #else
-        int fd;
-        TCHAR buffer[128];
-        int VmRSS = 0;
-
-        snprintf(buffer, sizeof(buffer), "/proc/%d/statm", _pid);
-        if ((fd = open(buffer, O_RDONLY)) != -1) {
-            ssize_t readAmount = 0;
-            if ((readAmount = read(fd, buffer, sizeof(buffer))) > 0) {
-                ssize_t nulIndex = std::min(readAmount, static_cast<ssize_t>(sizeof(buffer) - 1));
-                buffer[nulIndex] = '\0';
-                sscanf(buffer, "%*d %d", &VmRSS);
-                result = VmRSS * PageSize;
-            }
-            close(fd);
-        }
+        result = StatmField(_pid, 1);
 #endif
 
         return (result);
@@ -483,21 +476,7 @@ namespace Core {
             }
         }
 #else
-        int fd;
-        TCHAR buffer[128];
-        int Share = 0;
-
-        snprintf(buffer, sizeof(buffer), "/proc/%d/statm", _pid);
-        if ((fd = open(buffer, O_RDONLY)) != -1) {
-            ssize_t readAmount = 0;
-            if ((readAmount = read(fd, buffer, sizeof(buffer))) > 0) {
-                ssize_t nulIndex = std::min(readAmount, static_cast<ssize_t>(sizeof(buffer) - 1));
-                buffer[nulIndex] = '\0';
-                sscanf(buffer, "%*d %*d %d", &Share);
-                result = Share * PageSize;
-            }
-            close(fd);
-        }
+        result = StatmField(_pid, 2);
 #endif
 
         return (result);
@@ -790,50 +769,84 @@ POP_WARNING()
         _rss = 0;
         _vss = 0;
         _shared = 0;
-        
-        string path = "/proc/";
-        path += std::to_string(_pid);
-        path += "/smaps";
-        
-        std::ifstream smaps(path);
-        if (!smaps.is_open()) {
-            TRACE_L1(_T("Could not open /proc/%d/smaps. Memory monitoring of this process is unavailable!"), _pid);
+
+        bool summed = false;
+
+#ifndef __WINDOWS__
+        // Since Linux 4.14 the kernel does the summing over all mappings for us, which is a lot
+        // cheaper than walking (and parsing) the full smaps file. It has no "Size:" though.
+        char rollup[48];
+        snprintf(rollup, sizeof(rollup), "/proc/%d/smaps_rollup", _pid);
+
+        KernelFileType<2048> totals(rollup);
+
+        if ((totals.Load() == true) && (totals.Length() > 0)) {
+            TextScanner scanner(totals.Content());
+
+            while (scanner.AtEnd() == false) {
+                if (scanner.Match("Rss:") == true) {
+                    _rss += scanner.Number();
+                } else if (scanner.Match("Pss:") == true) {
+                    _pss += scanner.Number();
+                } else if ((scanner.Match("Private_Clean:") == true) || (scanner.Match("Private_Dirty:") == true)) {
+                    _uss += scanner.Number();
+                } else if ((scanner.Match("Shared_Clean:") == true) || (scanner.Match("Shared_Dirty:") == true)) {
+                    _shared += scanner.Number();
+                }
+                scanner.SkipLine();
+            }
+
+            _vss = StatmField(_pid, 0) / 1024;
+
+            summed = true;
         }
+#endif
+
+        if (summed == false) {
+            string path = "/proc/";
+            path += std::to_string(_pid);
+            path += "/smaps";
 
-        std::string line;
-        std::string key;
-        uint64_t value;
-        std::istringstream iss("");
-
-        while (std::getline(smaps, line)) {
-
-            iss.str(line);
-            iss >> key;
-
-            if (key == _T("Size:")) {
-                iss >> value;
-                _vss += value;
-            } else if (key == _T("Rss:")) {
-                iss >> value;
-                _rss += value;
-            } else if (key == _T("Pss:")) {
-                iss >> value;
-                _pss += value;
-            } else if (key == _T("Private_Clean:")) {
-                iss >> value;
-                _uss += value;
-            } else if (key == _T("Private_Dirty:")) {
-                iss >> value;
-                _uss += value;
-            } else if (key == _T("Shared_Dirty:")) {
-                iss >> value;
-                _shared += value;
-            } else if (key == _T("Shared_Clean:")) {
-                iss >> value;
-                _shared += value;
+            std::ifstream smaps(path);
+            if (!smaps.is_open()) {
+                TRACE_L1(_T("Could not open /proc/%d/smaps. Memory monitoring of this process is unavailable!"), _pid);
             }
 
-            iss.clear();
+            std::string line;
+            std::string key;
+            uint64_t value;
+            std::istringstream iss("");
+
+            while (std::getline(smaps, line)) {
+
+                iss.str(line);
+                iss >> key;
+
+                if (key == _T("Size:")) {
+                    iss >> value;
+                    _vss += value;
+                } else if (key == _T("Rss:")) {
+                    iss >> value;
+                    _rss += value;
+                } else if (key == _T("Pss:")) {
+                    iss >> value;
+                    _pss += value;
+                } else if (key == _T("Private_Clean:")) {
+                    iss >> value;
+                    _uss += value;
+                } else if (key == _T("Private_Dirty:")) {
+                    iss >> value;
+                    _uss += value;
+                } else if (key == _T("Shared_Dirty:")) {
+                    iss >> value;
+                    _shared += value;
+                } else if (key == _T("Shared_Clean:")) {
+                    iss >> value;
+                    _shared += value;
+                }
+
+                iss.clear();
+            }
         }
     }
 }
@@ -0,0 +1,553 @@
+/*
+ * If not stated otherwise in this file or this component's LICENSE file the
+ * following copyright and licenses apply:
+ *
+ * Copyright 2020 Metrological
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "ProcessSampler.h"
+#include "Time.h"
+
+#ifdef __LINUX__
+#include <linux/genetlink.h>
+#include <linux/netlink.h>
+#include <linux/taskstats.h>
+#include <sys/socket.h>
+#endif
+
+namespace Thunder {
+namespace Core {
+
+    namespace {
+
+        uint64_t PageSize()
+        {
+#ifdef __WINDOWS__
+            return (4096);
+#else
+            static const uint64_t pageSize = static_cast<uint64_t>(::getpagesize());
+            return (pageSize);
+#endif
+        }
+
+        uint64_t MicroSecondsPerClockTick()
+        {
+#ifdef __WINDOWS__
+            return (Time::MicroSecondsPerMilliSecond);
+#else
+            static const uint64_t microSeconds = (Time::MicroSecondsPerSecond / static_cast<uint64_t>(::sysconf(_SC_CLK_TCK)));
+            return (microSeconds);
+#endif
+        }
+
+    }
+
+    class ProcessSampler::Entry {
+    public:
+        Entry() = delete;
+        Entry(Entry&&) = delete;
+        Entry(const Entry&) = delete;
+        Entry& operator=(Entry&&) = delete;
+        Entry& operator=(const Entry&) = delete;
+
+        explicit Entry(const pid_t id)
+            : _valid(false)
+            , _info()
+            , _stat()
+            , _statm()
+            , _io()
+        {
+            char path[48];
+
+            ::memset(&_info, 0, sizeof(_info));
+            _info.Id = id;
+
+            snprintf(path, sizeof(path), "/proc/%d/stat", id);
+            _stat.Open(path);
+            snprintf(path, sizeof(path), "/proc/%d/statm", id);
+            _statm.Open(path);
+            snprintf(path, sizeof(path), "/proc/%d/io", id);
+            _io.Open(path);
+        }
+        ~Entry() = default;
+
+    public:
+        inline bool IsValid() const
+        {
+            return (_valid);
+        }
+        inline const Process& Info() const
+        {
+            return (_info);
+        }
+        inline Process& Info()
+        {
+            return (_info);
+        }
+        void Sample(const uint64_t microSecondsPerTick)
+        {
+            _valid = ((_stat.Load() == true) && (_stat.Length() > 0));
+
+            if (_valid == true) {
+                // pid (comm) state ppid pgrp session tty_nr tpgid flags minflt cminflt majflt cmajflt utime stime cutime cstime priority nice num_threads
+                TextScanner scanner(_stat.Content());
+
+                if (scanner.SkipPastLast(')') == true) {
+                    _info.State = scanner.Character();
+                    _info.Parent = static_cast<pid_t>(scanner.Signed());
+                    scanner.SkipField(9);
+                    _info.UserTime = scanner.Number() * microSecondsPerTick;
+                    _info.SystemTime = scanner.Number() * microSecondsPerTick;
+                    scanner.SkipField(4);
+                    _info.Threads = static_cast<uint32_t>(scanner.Number());
+                }
+
+                if (_statm.Load() == true) {
+                    // size resident shared text lib data dt, in pages
+                    TextScanner statm(_statm.Content());
+                    const uint64_t pageSize = PageSize();
+
+                    _info.Allocated = statm.Number() * pageSize;
+                    _info.Resident = statm.Number() * pageSize;
+                    _info.Shared = statm.Number() * pageSize;
+                }
+
+                if (_io.Load() == true) {
+                    TextScanner io(_io.Content());
+
+                    if (io.Line("read_bytes:") == true) {
+                        _info.ReadBytes = io.Number();
+                    }
+                    if (io.Line("write_bytes:") == true) {
+                        _info.WriteBytes = io.Number();
+                    }
+                }
+            }
+        }
+
+    private:
+        bool _valid;
+        Process _info;
+        KernelFileType<512> _stat;
+        KernelFileType<128> _statm;
+        KernelFileType<256> _io;
+    };
+
+#ifdef __LINUX__
+    // Minimal synchronous generic netlink client for the TASKSTATS family. Unprivileged callers
+    // are refused by most kernels, in that case the sampler sticks to procfs.
+    class ProcessSampler::TaskStats {
+    private:
+        static constexpr uint16_t BufferSize = 1024;
+
+    public:
+        TaskStats(TaskStats&&) = delete;
+        TaskStats(const TaskStats&) = delete;
+        TaskStats& operator=(TaskStats&&) = delete;
+        TaskStats& operator=(const TaskStats&) = delete;
+
+        TaskStats()
+            : _socket(::socket(AF_NETLINK, SOCK_RAW | SOCK_CLOEXEC, NETLINK_GENERIC))
+            , _family(0)
+            , _sequence(0)
+        {
+            if (_socket != -1) {
+                struct sockaddr_nl address;
+                struct timeval timeout = { 0, 100000 };
+
+                ::memset(&address, 0, sizeof(address));
+                address.nl_family = AF_NETLINK;
+
+                ::setsockopt(_socket, SOL_SOCKET, SO_RCVTIMEO, &timeout, sizeof(timeout));
+
+                if (::bind(_socket, reinterpret_cast<struct sockaddr*>(&address), sizeof(address)) == 0) {
+                    _family = Resolve();
+                }
+
+                if (_family == 0) {
+                    Close();
+                } else {
+                    // See if we are allowed to use it at all.
+                    Process probe;
+                    ::memset(&probe, 0, sizeof(probe));
+
+                    if (Get(::getpid(), probe) == false) {
+                        Close();
+                    }
+                }
+            }
+        }
+        ~TaskStats()
+        {
+            Close();
+        }
+
+    public:
+        inline bool IsValid() const
+        {
+            return (_family != 0);
+        }
+        bool Get(const pid_t id, Process& info)
+        {
+            bool result = false;
+            const uint32_t tgid = static_cast<uint32_t>(id);
+
+            if (Send(_family, TASKSTATS_CMD_GET, TASKSTATS_VERSION, TASKSTATS_CMD_ATTR_TGID, &tgid, sizeof(tgid)) == true) {
+                uint8_t buffer[BufferSize];
+                const struct nlattr* aggregate = Receive(buffer, sizeof(buffer), TASKSTATS_TYPE_AGGR_TGID);
+
+                if (aggregate != nullptr) {
+                    const struct nlattr* stats = Find(reinterpret_cast<const uint8_t*>(aggregate) + NLA_HDRLEN, aggregate->nla_len - NLA_HDRLEN, TASKSTATS_TYPE_STATS);
+
+                    if (stats != nullptr) {
+                        struct taskstats data;
+                        ::memset(&data, 0, sizeof(data));
+                        ::memcpy(&data, reinterpret_cast<const uint8_t*>(stats) + NLA_HDRLEN, std::min(sizeof(data), static_cast<size_t>(stats->nla_len - NLA_HDRLEN)));
+
+                        info.UserTime = data.ac_utime;
+                        info.SystemTime = data.ac_stime;
+                        result = true;
+                    }
+                }
+            }
+
+            return (result);
+        }
+
+    private:
+        void Close()
+        {
+            if (_socket != -1) {
+                ::close(_socket);
+                _socket = -1;
+            }
+            _family = 0;
+        }
+        uint16_t Resolve()
+        {
+            uint16_t result = 0;
+
+            if (Send(GENL_ID_CTRL, CTRL_CMD_GETFAMILY, 1, CTRL_ATTR_FAMILY_NAME, TASKSTATS_GENL_NAME, sizeof(TASKSTATS_GENL_NAME)) == true) {
+                uint8_t buffer[BufferSize];
+                const struct nlattr* family = Receive(buffer, sizeof(buffer), CTRL_ATTR_FAMILY_ID);
+
+                if (family != nullptr) {
+                    result = *reinterpret_cast<const uint16_t*>(reinterpret_cast<const uint8_t*>(family) + NLA_HDRLEN);
+                }
+            }
+
+            return (result);
+        }
+        bool Send(const uint16_t type, const uint8_t command, const uint8_t version, const uint16_t attribute, const void* data, const uint16_t length)
+        {
+            uint8_t buffer[NLMSG_HDRLEN + GENL_HDRLEN + NLA_HDRLEN + 64];
+
+            ASSERT(NLA_ALIGN(length) <= 64);
+
+            ::memset(buffer, 0, sizeof(buffer));
+
+            struct nlmsghdr* header = reinterpret_cast<struct nlmsghdr*>(buffer);
+            struct genlmsghdr* generic = reinterpret_cast<struct genlmsghdr*>(&buffer[NLMSG_HDRLEN]);
+            struct nlattr* parameter = reinterpret_cast<struct nlattr*>(&buffer[NLMSG_HDRLEN + GENL_HDRLEN]);
+
+            header->nlmsg_len = NLMSG_HDRLEN + GENL_HDRLEN + NLA_HDRLEN + NLA_ALIGN(length);
+            header->nlmsg_type = type;
+            header->nlmsg_flags = NLM_F_REQUEST;
+            header->nlmsg_seq = ++_sequence;
+            header->nlmsg_pid = 0;
+            generic->cmd = command;
+            generic->version = version;
+            parameter->nla_type = attribute;
+            parameter->nla_len = NLA_HDRLEN + length;
+            ::memcpy(&buffer[NLMSG_HDRLEN + GENL_HDRLEN + NLA_HDRLEN], data, length);
+
+            struct sockaddr_nl kernel;
+            ::memset(&kernel, 0, sizeof(kernel));
+            kernel.nl_family = AF_NETLINK;
+
+            return (::sendto(_socket, buffer, header->nlmsg_len, 0, reinterpret_cast<struct sockaddr*>(&kernel), sizeof(kernel)) == static_cast<ssize_t>(header->nlmsg_len));
+        }
+        // Waits for the answer on the last request and returns the requested top level attribute.
+        const struct nlattr* Receive(uint8_t buffer[], const uint16_t size, const uint16_t attribute)
+        {
+            const struct nlattr* result = nullptr;
+            bool answered = false;
+
+            while (answered == false) {
+                const ssize_t length = ::recv(_socket, buffer, size, 0);
+
+                if (length < static_cast<ssize_t>(NLMSG_HDRLEN)) {
+                    answered = true;
+                } else {
+                    const struct nlmsghdr* header = reinterpret_cast<const struct nlmsghdr*>(buffer);
+
+                    if ((NLMSG_OK(header, static_cast<uint32_t>(length)) != 0) && (header->nlmsg_seq == _sequence)) {
+                        answered = true;
+
+                        if ((header->nlmsg_type != NLMSG_ERROR) && (header->nlmsg_len >= (NLMSG_HDRLEN + GENL_HDRLEN))) {
+                            result = Find(&buffer[NLMSG_HDRLEN + GENL_HDRLEN], header->nlmsg_len - NLMSG_HDRLEN - GENL_HDRLEN, attribute);
+                        }
+                    }
+                }
+            }
+
+            return (result);
+        }
+        static const struct nlattr* Find(const uint8_t data[], uint32_t length, const uint16_t attribute)
+        {
+            const struct nlattr* result = nullptr;
+
+            while ((result == nullptr) && (length >= NLA_HDRLEN)) {
+                const struct nlattr* entry = reinterpret_cast<const struct nlattr*>(data);
+
+                if ((entry->nla_len < NLA_HDRLEN) || (entry->nla_len > length)) {
+                    length = 0;
+                } else if ((entry->nla_type & NLA_TYPE_MASK) == attribute) {
+                    result = entry;
+                } else {
+                    const uint32_t step = std::min(static_cast<uint32_t>(NLA_ALIGN(entry->nla_len)), length);
+                    data += step;
+                    length -= step;
+                }
+            }
+
+            return (result);
+        }
+
+    private:
+        int _socket;
+        uint16_t _family;
+        uint32_t _sequence;
+    };
+#else
+    class ProcessSampler::TaskStats {
+    public:
+        inline bool IsValid() const
+        {
+            return (false);
+        }
+        inline bool Get(const pid_t, Process&)
+        {
+            return (false);
+        }
+    };
+#endif
+
+    ProcessSampler::ProcessSampler(const uint32_t interval, const bool taskStats)
+        : _interval(interval)
+        , _adminLock()
+        , _entries()
+        , _taskStats(nullptr)
+        , _lastSample(0)
+        , _system()
+        , _meminfo(_T("/proc/meminfo"))
+        , _stat(_T("/proc/stat"))
+    {
+        ::memset(&_system, 0, sizeof(_system));
+
+        if (taskStats == true) {
+            _taskStats = new TaskStats();
+
+            if (_taskStats->IsValid() == false) {
+                delete _taskStats;
+                _taskStats = nullptr;
+            }
+        }
+    }
+
+    ProcessSampler::~ProcessSampler()
+    {
+        for (auto& entry : _entries) {
+            delete entry.second;
+        }
+        _entries.clear();
+
+        if (_taskStats != nullptr) {
+            delete _taskStats;
+        }
+    }
+
+    bool ProcessSampler::HasTaskStats() const
+    {
+        return (_taskStats != nullptr);
+    }
+
+    void ProcessSampler::Add(const pid_t id)
+    {
+        _adminLock.Lock();
+
+        if (_entries.find(id) == _entries.end()) {
+            _entries.emplace(id, new Entry(id));
+
+            // Make sure the next query takes this one along.
+            _lastSample = 0;
+        }
+
+        _adminLock.Unlock();
+    }
+
+    void ProcessSampler::Add(const ProcessInfo::Iterator& processes)
+    {
+        ProcessInfo::Iterator index(processes);
+
+        index.Reset();
+
+        while (index.Next() == true) {
+            Add(index.Current().Id());
+        }
+    }
+
+    void ProcessSampler::Remove(const pid_t id)
+    {
+        _adminLock.Lock();
+
+        Entries::iterator index = _entries.find(id);
+
+        if (index != _entries.end()) {
+            delete index->second;
+            _entries.erase(index);
+        }
+
+        _adminLock.Unlock();
+    }
+
+    uint32_t ProcessSampler::Count() const
+    {
+        _adminLock.Lock();
+
+        const uint32_t result = static_cast<uint32_t>(_entries.size());
+
+        _adminLock.Unlock();
+
+        return (result);
+    }
+
+    void ProcessSampler::Sample()
+    {
+        _adminLock.Lock();
+
+        _lastSample = 0;
+        Refresh();
+
+        _adminLock.Unlock();
+    }
+
+    bool ProcessSampler::Get(const pid_t id, Process& info)
+    {
+        bool result = false;
+
+        _adminLock.Lock();
+
+        Refresh();
+
+        Entries::const_iterator index = _entries.find(id);
+
+        if ((index != _entries.end()) && (index->second->IsValid() == true)) {
+            info = index->second->Info();
+            result = true;
+        }
+
+        _adminLock.Unlock();
+
+        return (result);
+    }
+
+    void ProcessSampler::Get(System& info)
+    {
+        _adminLock.Lock();
+
+        Refresh();
+
+        info = _system;
+
+        _adminLock.Unlock();
+    }
+
+    void ProcessSampler::Refresh()
+    {
+        const uint64_t now = Time::Now().Ticks();
+
+        if ((_lastSample == 0) || ((now - _lastSample) >= (static_cast<uint64_t>(_interval) * Time::MicroSecondsPerMilliSecond))) {
+            const uint64_t microSecondsPerTick = MicroSecondsPerClockTick();
+
+            _lastSample = now;
+
+            SampleSystem();
+
+            for (auto& entry : _entries) {
+                entry.second->Sample(microSecondsPerTick);
+
+                if ((entry.second->IsValid() == true) && (_taskStats != nullptr)) {
+                    // Microsecond accurate accounting, i.s.o. clock ticks.
+                    _taskStats->Get(entry.first, entry.second->Info());
+                }
+            }
+        }
+    }
+
+    void ProcessSampler::SampleSystem()
+    {
+        if (_meminfo.Load() == true) {
+            TextScanner scanner(_meminfo.Content());
+
+            if (scanner.Line("MemTotal:") == true) {
+                _system.Total = scanner.Number() * 1024;
+            }
+            if (scanner.Line("MemFree:") == true) {
+                _system.Free = scanner.Number() * 1024;
+            }
+            if (scanner.Line("MemAvailable:") == true) {
+                _system.Available = scanner.Number() * 1024;
+            }
+            if (scanner.Line("Cached:") == true) {
+                _system.Cached = scanner.Number() * 1024;
+            }
+            if (scanner.Line("SwapCached:") == true) {
+                _system.SwapCached = scanner.Number() * 1024;
+            }
+            if (scanner.Line("SwapTotal:") == true) {
+                _system.SwapTotal = scanner.Number() * 1024;
+            }
+            if (scanner.Line("SwapFree:") == true) {
+                _system.SwapFree = scanner.Number() * 1024;
+            }
+        }
+
+        if (_stat.Load() == true) {
+            // cpu user nice system idle iowait irq softirq steal
+            TextScanner scanner(_stat.Content());
+
+            if (scanner.Match("cpu ") == true) {
+                uint64_t fields[8];
+
+                for (uint8_t index = 0; index < (sizeof(fields) / sizeof(fields[0])); index++) {
+                    fields[index] = scanner.Number();
+                }
+
+                const uint64_t total = fields[0] + fields[1] + fields[2] + fields[3] + fields[4] + fields[5] + fields[6] + fields[7];
+                const uint64_t busy = total - fields[3] - fields[4];
+
+                if ((_system.CpuTotal != 0) && (total > _system.CpuTotal)) {
+                    _system.CpuLoad = static_cast<uint8_t>(((busy - _system.CpuBusy) * 100) / (total - _system.CpuTotal));
+                }
+
+                _system.CpuBusy = busy;
+                _system.CpuTotal = total;
+            }
+        }
+    }
+
+} // namespace Core
+} // namespace Thunder
@@ -0,0 +1,118 @@
+/*
+ * If not stated otherwise in this file or this component's LICENSE file the
+ * following copyright and licenses apply:
+ *
+ * Copyright 2020 Metrological
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include "Module.h"
+#include "KernelFile.h"
+#include "Portability.h"
+#include "ProcessInfo.h"
+#include "Sync.h"
+
+namespace Thunder {
+namespace Core {
+
+    // Samples the resource usage of a set of processes and of the system as a whole, all in one
+    // go per tick. The kernel files involved stay open and are re-read with pread(), results are
+    // cached for the duration of the interval so any number of consumers within the same tick
+    // share one sample. Where the kernel offers it (and we are allowed to use it), the CPU time of
+    // a process is fetched with microsecond accuracy through the taskstats netlink interface.
+    class EXTERNAL ProcessSampler {
+    public:
+        struct Process {
+            pid_t Id;
+            pid_t Parent;
+            char State;
+            uint32_t Threads;
+            uint64_t UserTime; // microseconds
+            uint64_t SystemTime; // microseconds
+            uint64_t Allocated; // bytes
+            uint64_t Resident; // bytes
+            uint64_t Shared; // bytes
+            uint64_t ReadBytes; // storage I/O, if /proc/<pid>/io is accessible
+            uint64_t WriteBytes; // storage I/O, if /proc/<pid>/io is accessible
+        };
+
+        struct System {
+            uint64_t Total; // bytes
+            uint64_t Free; // bytes
+            uint64_t Available; // bytes
+            uint64_t Cached; // bytes
+            uint64_t SwapTotal; // bytes
+            uint64_t SwapFree; // bytes
+            uint64_t SwapCached; // bytes
+            uint64_t CpuBusy; // clock ticks since boot
+            uint64_t CpuTotal; // clock ticks since boot
+            uint8_t CpuLoad; // percentage, over the last interval
+        };
+
+    private:
+        class Entry;
+        class TaskStats;
+
+        using Entries = std::unordered_map<pid_t, Entry*>;
+
+    public:
+        ProcessSampler(ProcessSampler&&) = delete;
+        ProcessSampler(const ProcessSampler&) = delete;
+        ProcessSampler& operator=(ProcessSampler&&) = delete;
+        ProcessSampler& operator=(const ProcessSampler&) = delete;
+
+        // Interval, in milliseconds, a sample remains valid.
+        explicit ProcessSampler(const uint32_t interval = 1000, const bool taskStats = true);
+        ~ProcessSampler();
+
+    public:
+        inline uint32_t Interval() const
+        {
+            return (_interval);
+        }
+        bool HasTaskStats() const;
+
+        // Adding a process forces a new sample on the next query.
+        void Add(const pid_t id);
+        void Add(const ProcessInfo::Iterator& processes);
+        void Remove(const pid_t id);
+        uint32_t Count() const;
+
+        // Sample everything now, regardless of the age of the current sample.
+        void Sample();
+
+        // Results of the current tick, a new tick is sampled if the current one is too old.
+        // Returns false if the process is not tracked or no longer exists.
+        bool Get(const pid_t id, Process& info);
+        void Get(System& info);
+
+    private:
+        void Refresh();
+        void SampleSystem();
+
+    private:
+        const uint32_t _interval;
+        mutable CriticalSection _adminLock;
+        Entries _entries;
+        TaskStats* _taskStats;
+        uint64_t _lastSample;
+        System _system;
+        KernelFileType<2048> _meminfo;
+        KernelFileType<256> _stat;
+    };
+
+} // namespace Core
+} // namespace Thunder
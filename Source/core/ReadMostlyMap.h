@@ -0,0 +1,299 @@
+/*
+ * If not stated otherwise in this file or this component's LICENSE file the
+ * following copyright and licenses apply:
+ *
+ * Copyright 2020 Metrological
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef __READ_MOSTLY_MAP_H
+#define __READ_MOSTLY_MAP_H
+
+#include <atomic>
+#include <thread>
+
+// ---- Include local include files ----
+#include "Module.h"
+#include "Sync.h"
+
+// ---- Referenced classes and types ----
+
+// ---- Helper types and constants ----
+
+namespace Thunder {
+
+namespace Core {
+    // Rationale:
+    // Some maps are looked up on every request but only change when the system is reconfigured,
+    // e.g. callsign to plugin. Taking a lock for every lookup serialises all readers on one
+    // cache line. This map publishes an immutable, hash indexed snapshot instead: readers find
+    // their element without a lock or an allocation, writers build a new snapshot and free the
+    // old one once every reader that could still see it has left.
+    // Readers announce themselves in a counter per epoch parity, spread over SHARDS cache lines
+    // so concurrent readers on different threads do not contend with each other. The element is
+    // copied out under that announcement, so ELEMENT is typically a ProxyType.
+    template <typename ELEMENT, const uint8_t SHARDS = 8>
+    class ReadMostlyMapType {
+    private:
+        class Table {
+        private:
+            struct Entry {
+                Entry(const uint32_t hash, const string& key, const ELEMENT& element)
+                    : Hash(hash)
+                    , Key(key)
+                    , Element(element)
+                {
+                }
+
+                uint32_t Hash;
+                string Key;
+                ELEMENT Element;
+            };
+
+        public:
+            Table() = delete;
+            Table(Table&&) = delete;
+            Table(const Table&) = delete;
+            Table& operator=(Table&&) = delete;
+            Table& operator=(const Table&) = delete;
+
+            explicit Table(const uint32_t count)
+                : _mask(Capacity(count) - 1)
+                , _slots(_mask + 1, 0)
+                , _entries()
+            {
+                _entries.reserve(count);
+            }
+            ~Table() = default;
+
+        public:
+            uint32_t Count() const
+            {
+                return (static_cast<uint32_t>(_entries.size()));
+            }
+            void Add(const string& key, const ELEMENT& element)
+            {
+                const uint32_t hash = Hash(key.c_str(), static_cast<uint32_t>(key.length()));
+                uint32_t slot = hash & _mask;
+
+                ASSERT(_entries.size() < _entries.capacity());
+                ASSERT(Find(key.c_str(), static_cast<uint32_t>(key.length()), hash) == nullptr);
+
+                while (_slots[slot] != 0) {
+                    slot = (slot + 1) & _mask;
+                }
+
+                _entries.emplace_back(hash, key, element);
+                _slots[slot] = static_cast<uint32_t>(_entries.size());
+            }
+            const ELEMENT* Find(const TCHAR key[], const uint32_t length, const uint32_t hash) const
+            {
+                const ELEMENT* result = nullptr;
+                uint32_t slot = hash & _mask;
+
+                while ((result == nullptr) && (_slots[slot] != 0)) {
+                    const Entry& entry(_entries[_slots[slot] - 1]);
+
+                    if ((entry.Hash == hash) && (entry.Key.length() == length) && (::memcmp(entry.Key.c_str(), key, length * sizeof(TCHAR)) == 0)) {
+                        result = &(entry.Element);
+                    } else {
+                        slot = (slot + 1) & _mask;
+                    }
+                }
+
+                return (result);
+            }
+            template <typename ACTION>
+            void Visit(ACTION&& action) const
+            {
+                for (const Entry& entry : _entries) {
+                    action(entry.Key, entry.Element);
+                }
+            }
+
+        private:
+            static uint32_t Capacity(const uint32_t count)
+            {
+                // Keep the load factor below one half, probes stay short.
+                uint32_t result = 8;
+                while (result < (count * 2)) {
+                    result <<= 1;
+                }
+                return (result);
+            }
+
+        private:
+            const uint32_t _mask;
+            std::vector<uint32_t> _slots;
+            std::vector<Entry> _entries;
+        };
+
+        struct alignas(64) Shard {
+            std::atomic<uint32_t> Readers[2];
+        };
+
+    public:
+        ReadMostlyMapType(ReadMostlyMapType<ELEMENT, SHARDS>&&) = delete;
+        ReadMostlyMapType(const ReadMostlyMapType<ELEMENT, SHARDS>&) = delete;
+        ReadMostlyMapType<ELEMENT, SHARDS>& operator=(ReadMostlyMapType<ELEMENT, SHARDS>&&) = delete;
+        ReadMostlyMapType<ELEMENT, SHARDS>& operator=(const ReadMostlyMapType<ELEMENT, SHARDS>&) = delete;
+
+        ReadMostlyMapType()
+            : _writerLock()
+            , _epoch(0)
+            , _table(new Table(0))
+        {
+            for (uint8_t index = 0; index < SHARDS; index++) {
+                _shards[index].Readers[0] = 0;
+                _shards[index].Readers[1] = 0;
+            }
+        }
+        ~ReadMostlyMapType()
+        {
+            delete _table.load();
+        }
+
+    public:
+        static uint32_t Hash(const TCHAR key[], const uint32_t length)
+        {
+            // FNV-1a
+            uint32_t hash = 2166136261u;
+            for (uint32_t index = 0; index < length; index++) {
+                hash = (hash ^ static_cast<uint32_t>(key[index])) * 16777619u;
+            }
+            return (hash);
+        }
+
+        uint32_t Count() const
+        {
+            Reader reader(*this);
+            return (reader->Count());
+        }
+
+        // Lock free, copies the element out while the snapshot it lives in is guaranteed alive.
+        bool Find(const TCHAR key[], const uint32_t length, ELEMENT& element) const
+        {
+            Reader reader(*this);
+            const ELEMENT* entry = reader->Find(key, length, Hash(key, length));
+
+            if (entry != nullptr) {
+                element = *entry;
+            }
+
+            return (entry != nullptr);
+        }
+        bool Find(const string& key, ELEMENT& element) const
+        {
+            return (Find(key.c_str(), static_cast<uint32_t>(key.length()), element));
+        }
+
+        // Lock free, hands out every key and element in the order they were published.
+        template <typename ACTION>
+        void Visit(ACTION&& action) const
+        {
+            Reader reader(*this);
+            reader->Visit(action);
+        }
+
+        // Replaces the content with the [begin, end) range of key/element pairs. Returns once
+        // no reader can see the previous content anymore.
+        template <typename ITERATOR>
+        void Publish(ITERATOR begin, ITERATOR end)
+        {
+            Table* table = new Table(static_cast<uint32_t>(std::distance(begin, end)));
+
+            while (begin != end) {
+                table->Add(begin->first, begin->second);
+                ++begin;
+            }
+
+            Exchange(table);
+        }
+        void Clear()
+        {
+            Exchange(new Table(0));
+        }
+
+    private:
+        class Reader {
+        public:
+            Reader() = delete;
+            Reader(Reader&&) = delete;
+            Reader(const Reader&) = delete;
+            Reader& operator=(Reader&&) = delete;
+            Reader& operator=(const Reader&) = delete;
+
+            explicit Reader(const ReadMostlyMapType<ELEMENT, SHARDS>& parent)
+                : _counter(parent._shards[Slot()].Readers[parent._epoch.load() & 1])
+            {
+                // Announce before looking, a writer that misses the announcement has already swapped the table.
+                _counter.fetch_add(1);
+                _table = parent._table.load();
+            }
+            ~Reader()
+            {
+                _counter.fetch_sub(1);
+            }
+
+        public:
+            const Table* operator->() const
+            {
+                return (_table);
+            }
+
+        private:
+            std::atomic<uint32_t>& _counter;
+            const Table* _table;
+        };
+
+        static uint8_t Slot()
+        {
+            static std::atomic<uint32_t> sequence(0);
+            static thread_local uint8_t slot = static_cast<uint8_t>(sequence.fetch_add(1, std::memory_order_relaxed) % SHARDS);
+            return (slot);
+        }
+        void Exchange(Table* table)
+        {
+            _writerLock.Lock();
+
+            Table* previous = _table.exchange(table);
+
+            // A reader holding the previous table is counted under either parity, so drain both.
+            // Flipping the epoch first steers new readers away from the parity being drained.
+            for (uint8_t phase = 0; phase < 2; phase++) {
+                const uint8_t parity = (_epoch.fetch_add(1) & 1);
+
+                for (uint8_t index = 0; index < SHARDS; index++) {
+                    while (_shards[index].Readers[parity].load() != 0) {
+                        std::this_thread::yield();
+                    }
+                }
+            }
+
+            _writerLock.Unlock();
+
+            delete previous;
+        }
+
+    private:
+        Core::CriticalSection _writerLock;
+        mutable Shard _shards[SHARDS];
+        std::atomic<uint32_t> _epoch;
+        std::atomic<Table*> _table;
+    };
+
+} // namespace Core
+} // namespace Thunder
+
+#endif // __READ_MOSTLY_MAP_H
@@ -163,11 +163,11 @@ namespace Core {
         uint32_t WaitReleased(const uint32_t timeout = Core::infinite)
         {
             uint32_t result = Core::ERROR_NONE;
-            uint64_t now = Core::Time::Now().Ticks() / Core::Time::TicksPerMillisecond;
+            uint64_t now = Core::MonotonicTime::Coarse() / Core::Time::TicksPerMillisecond;
             uint8_t count = 0;
             while (_referenceCount.load(std::memory_order_relaxed) > 0) {
                     Core::Thread::Yield(count, 100);
-                    if (( timeout != Core::infinite ) && ( (Core::Time::Now().Ticks() / Core::Time::TicksPerMillisecond) - now > timeout )) {
+                    if (( timeout != Core::infinite ) && ( (Core::MonotonicTime::Coarse() / Core::Time::TicksPerMillisecond) - now > timeout )) {
                         result = Core::ERROR_TIMEDOUT;
                         break;
                     }
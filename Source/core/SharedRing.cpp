@@ -0,0 +1,327 @@
+/*
+ * If not stated otherwise in this file or this component's LICENSE file the
+ * following copyright and licenses apply:
+ *
+ * Copyright 2020 Metrological
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "SharedRing.h"
+#include "Number.h"
+#include "ProcessInfo.h"
+#include "SystemInfo.h"
+#include "Time.h"
+
+#include <thread>
+
+#ifdef __LINUX__
+#include <linux/futex.h>
+#include <sys/random.h>
+#include <sys/syscall.h>
+#include <climits>
+#endif
+
+namespace Thunder {
+
+namespace Core {
+
+namespace {
+
+    // Whatever we wait for, check if the ring got closed at least this often.
+    constexpr uint32_t SleepSlice = 100;
+    // Sleeping shorter than this (in microseconds) means the other side was about to deliver anyway.
+    constexpr uint64_t ShortNap = 50;
+
+    inline void Relax()
+    {
+#if defined(__x86_64__) || defined(__i386__)
+        __builtin_ia32_pause();
+#elif defined(__aarch64__) || defined(__arm__)
+        __asm__ __volatile__("yield");
+#elif defined(__WINDOWS__)
+        YieldProcessor();
+#endif
+    }
+
+    // Spinning only makes sense if the other side can make progress while we spin.
+    uint16_t SpinLimit(const uint16_t spins)
+    {
+        static const bool multiCore = (std::thread::hardware_concurrency() > 1);
+
+        return (multiCore == true ? spins : 0);
+    }
+
+    uint32_t RingSize(const uint32_t requested)
+    {
+        uint32_t size = SharedRing::MinimumSize;
+
+        while ((size < requested) && (size < SharedRing::MaximumSize)) {
+            size <<= 1;
+        }
+
+        return (size);
+    }
+
+#ifdef __LINUX__
+    // The ring is shared between processes, so no FUTEX_PRIVATE_FLAG here.
+    void Sleep(std::atomic<uint32_t>& counter, const uint32_t value, const uint32_t waitTime)
+    {
+        struct timespec timeout;
+        timeout.tv_sec = (waitTime / 1000);
+        timeout.tv_nsec = (waitTime % 1000) * 1000000;
+
+        ::syscall(SYS_futex, reinterpret_cast<uint32_t*>(&counter), FUTEX_WAIT, value, &timeout, nullptr, 0);
+    }
+    void Signal(std::atomic<uint32_t>& counter, const int count)
+    {
+        ::syscall(SYS_futex, reinterpret_cast<uint32_t*>(&counter), FUTEX_WAKE, count, nullptr, nullptr, 0);
+    }
+#else
+    // No cross process address wait available, poll with a short sleep.
+    void Sleep(std::atomic<uint32_t>& counter, const uint32_t value, const uint32_t waitTime)
+    {
+        if ((counter.load(std::memory_order_acquire) == value) && (waitTime > 0)) {
+            SleepMs(1);
+        }
+    }
+    void Signal(std::atomic<uint32_t>&, const int)
+    {
+    }
+#endif
+
+}
+
+    /* static */ string SharedRing::TemporaryName()
+    {
+        static std::atomic<uint32_t> sequence(0);
+
+        // Whoever wants to be there first (or link it elsewhere) should not be able to guess it.
+        uint64_t salt = 0;
+
+#ifdef __LINUX__
+        const bool random = (::getrandom(&salt, sizeof(salt), GRND_NONBLOCK) == static_cast<ssize_t>(sizeof(salt)));
+#else
+        const bool random = false;
+#endif
+
+        if (random == false) {
+            salt = Time::Now().Ticks() ^ (static_cast<uint64_t>(reinterpret_cast<uintptr_t>(&salt)) << 16);
+        }
+
+        salt ^= (static_cast<uint64_t>(ProcessInfo().Id()) << 32) ^ sequence.fetch_add(1);
+
+#ifdef __LINUX__
+        string result(::access(_T("/dev/shm"), W_OK) == 0 ? _T("/dev/shm/") : _T("/tmp/"));
+#elif defined(__WINDOWS__)
+        string result;
+        SystemInfo::GetEnvironment(_T("TEMP"), result);
+        result = Directory::Normalize(result);
+#else
+        string result(_T("/tmp/"));
+#endif
+
+        TCHAR name[32];
+        _stprintf(name, _T("thunder.ipc.%016" PRIx64), salt);
+
+        result += name;
+
+        return (result);
+    }
+
+    SharedRing::SharedRing(const string& name, const uint32_t mode, const uint32_t size)
+        : DataElementFile(name, mode | File::USER_READ | File::USER_WRITE | File::SHAREABLE | File::CREATE | File::EXCLUSIVE, AdministrationSize + RingSize(size))
+        , _administration(nullptr)
+        , _data(nullptr)
+        , _mask(0)
+        , _producerSpins(SpinLimit(MinimumSpins))
+        , _consumerSpins(SpinLimit(MinimumSpins))
+    {
+        const uint32_t ringSize = RingSize(size);
+
+        if ((DataElementFile::IsValid() == true) && (DataElementFile::Size() >= (AdministrationSize + ringSize))) {
+            Administration* administration = new (DataElementFile::Buffer()) Administration();
+
+            administration->Size = ringSize;
+            administration->Closed.store(0, std::memory_order_relaxed);
+            administration->Head.store(0, std::memory_order_relaxed);
+            administration->ConsumerSleeping.store(0, std::memory_order_relaxed);
+            administration->Tail.store(0, std::memory_order_relaxed);
+            administration->ProducerSleeping.store(0, std::memory_order_relaxed);
+
+            std::atomic_thread_fence(std::memory_order_release);
+            administration->Magic = Magic;
+
+            _administration = administration;
+            _data = &(DataElementFile::Buffer()[AdministrationSize]);
+            _mask = ringSize - 1;
+        }
+    }
+
+    SharedRing::SharedRing(const string& name)
+        : DataElementFile(name, File::USER_READ | File::USER_WRITE | File::SHAREABLE, 0)
+        , _administration(nullptr)
+        , _data(nullptr)
+        , _mask(0)
+        , _producerSpins(SpinLimit(MinimumSpins))
+        , _consumerSpins(SpinLimit(MinimumSpins))
+    {
+        if ((DataElementFile::IsValid() == true) && (DataElementFile::Size() >= AdministrationSize)) {
+            Administration* administration = reinterpret_cast<Administration*>(DataElementFile::Buffer());
+            const uint32_t ringSize = administration->Size;
+
+            std::atomic_thread_fence(std::memory_order_acquire);
+
+            // Only trust what we found if the creator did set it up completely and it makes sense.
+            if ((administration->Magic == Magic) && (ringSize >= MinimumSize) && (ringSize <= MaximumSize) && ((ringSize & (ringSize - 1)) == 0) && (DataElementFile::Size() >= (AdministrationSize + ringSize))) {
+                _administration = administration;
+                _data = &(DataElementFile::Buffer()[AdministrationSize]);
+                _mask = ringSize - 1;
+            }
+        }
+    }
+
+    uint32_t SharedRing::Reserve(uint8_t*& buffer)
+    {
+        ASSERT(IsValid() == true);
+
+        const uint32_t head = _administration->Head.load(std::memory_order_relaxed);
+        const uint32_t space = Capacity() - (head - _administration->Tail.load(std::memory_order_acquire));
+        const uint32_t offset = (head & _mask);
+
+        buffer = &(_data[offset]);
+
+        return (std::min(space, Capacity() - offset));
+    }
+
+    void SharedRing::Produced(const uint32_t length)
+    {
+        ASSERT(IsValid() == true);
+
+        if (length > 0) {
+            _administration->Head.fetch_add(length, std::memory_order_seq_cst);
+
+            Wake(_administration->Head, _administration->ConsumerSleeping);
+        }
+    }
+
+    bool SharedRing::WaitForSpace(const uint32_t waitTime)
+    {
+        ASSERT(IsValid() == true);
+
+        // The ring is full as long as the tail is a full ring behind our head.
+        const uint32_t full = _administration->Head.load(std::memory_order_relaxed) - Capacity();
+
+        return (Wait(_administration->Tail, full, _administration->ProducerSleeping, _producerSpins, waitTime));
+    }
+
+    uint32_t SharedRing::Peek(const uint8_t*& buffer)
+    {
+        ASSERT(IsValid() == true);
+
+        const uint32_t tail = _administration->Tail.load(std::memory_order_relaxed);
+        const uint32_t available = _administration->Head.load(std::memory_order_acquire) - tail;
+        const uint32_t offset = (tail & _mask);
+
+        buffer = &(_data[offset]);
+
+        return (std::min(available, Capacity() - offset));
+    }
+
+    void SharedRing::Consumed(const uint32_t length)
+    {
+        ASSERT(IsValid() == true);
+
+        if (length > 0) {
+            _administration->Tail.fetch_add(length, std::memory_order_seq_cst);
+
+            Wake(_administration->Tail, _administration->ProducerSleeping);
+        }
+    }
+
+    bool SharedRing::WaitForData(const uint32_t waitTime)
+    {
+        ASSERT(IsValid() == true);
+
+        // The ring is empty as long as the head is where our tail is.
+        const uint32_t empty = _administration->Tail.load(std::memory_order_relaxed);
+
+        return (Wait(_administration->Head, empty, _administration->ConsumerSleeping, _consumerSpins, waitTime));
+    }
+
+    void SharedRing::Close()
+    {
+        if (_administration != nullptr) {
+            _administration->Closed.store(1, std::memory_order_seq_cst);
+
+            Signal(_administration->Head, INT_MAX);
+            Signal(_administration->Tail, INT_MAX);
+        }
+    }
+
+    bool SharedRing::Wait(std::atomic<uint32_t>& counter, const uint32_t value, std::atomic<uint32_t>& sleeping, uint16_t& spins, const uint32_t waitTime)
+    {
+        bool moved = (counter.load(std::memory_order_acquire) != value);
+        uint16_t loop = 0;
+
+        while ((moved == false) && (loop < spins) && (IsClosed() == false)) {
+            Relax();
+            moved = (counter.load(std::memory_order_acquire) != value);
+            loop++;
+        }
+
+        if (moved == true) {
+            // Spinning paid off (or was not needed), allow a bit more of it next time.
+            spins = SpinLimit(std::min(static_cast<uint16_t>((spins << 1) | 1), MaximumSpins));
+        }
+        else if (waitTime > 0) {
+            const uint64_t start = MonotonicTime::Now();
+            const uint64_t deadline = (waitTime == Core::infinite ? ~0 : start + (static_cast<uint64_t>(waitTime) * Time::TicksPerMillisecond));
+            uint64_t now = start;
+
+            // Announce we are going to sleep before the final check, the other side checks the
+            // announcement after it moved the counter, so one of the two will notice.
+            sleeping.store(1, std::memory_order_seq_cst);
+
+            while ((counter.load(std::memory_order_seq_cst) == value) && (IsClosed() == false) && (now < deadline)) {
+                const uint64_t remaining = ((deadline - now) / Time::TicksPerMillisecond) + 1;
+
+                Sleep(counter, value, static_cast<uint32_t>(std::min(remaining, static_cast<uint64_t>(SleepSlice))));
+
+                now = MonotonicTime::Now();
+            }
+
+            sleeping.store(0, std::memory_order_relaxed);
+
+            moved = (counter.load(std::memory_order_acquire) != value);
+
+            // If it was only a short nap, a bit more spinning would have avoided it.
+            if ((moved == true) && ((now - start) < ShortNap)) {
+                spins = SpinLimit(std::min(static_cast<uint16_t>((spins << 1) | 1), MaximumSpins));
+            } else {
+                spins = SpinLimit(std::max(static_cast<uint16_t>(spins >> 1), MinimumSpins));
+            }
+        }
+
+        return (moved);
+    }
+
+    void SharedRing::Wake(std::atomic<uint32_t>& counter, std::atomic<uint32_t>& sleeping)
+    {
+        if (sleeping.load(std::memory_order_seq_cst) != 0) {
+            Signal(counter, 1);
+        }
+    }
+
+}
+} // namespace Core
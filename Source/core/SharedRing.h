@@ -0,0 +1,134 @@
+/*
+ * If not stated otherwise in this file or this component's LICENSE file the
+ * following copyright and licenses apply:
+ *
+ * Copyright 2020 Metrological
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef __SHARED_RING_H
+#define __SHARED_RING_H
+
+#include <algorithm>
+#include <atomic>
+
+// ---- Include local include files ----
+#include "DataElementFile.h"
+#include "Module.h"
+
+// ---- Referenced classes and types ----
+
+// ---- Helper types and constants ----
+
+namespace Thunder {
+
+namespace Core {
+    // Rationale:
+    // The CyclicBuffer is made for a producer that may overwrite what the consumer did not pick
+    // up in time, and it guards its administration with a process shared mutex. A transport can
+    // not lose data, and should not need a system call for every message. This ring is a lossless,
+    // single producer, single consumer byte ring in a memory mapped file. The producer owns the
+    // head, the consumer owns the tail, both are free running counters, so the administration
+    // needs no lock at all.
+    // A side that has to wait, spins for a while and only then goes to sleep on a futex. The other
+    // side only issues the wake up if it sees the waiter went to sleep. The number of spins adapts
+    // to how often spinning was worth it, so an idle ring does not burn CPU and a busy ring does
+    // not make system calls.
+    // The creator chooses the size (a power of 2), the other side opens the ring by name.
+    class EXTERNAL SharedRing : public DataElementFile {
+    private:
+        struct Administration {
+            uint32_t Magic;
+            uint32_t Size;
+            std::atomic<uint32_t> Closed;
+            alignas(64) std::atomic<uint32_t> Head;
+            std::atomic<uint32_t> ConsumerSleeping;
+            alignas(64) std::atomic<uint32_t> Tail;
+            std::atomic<uint32_t> ProducerSleeping;
+        };
+
+        static constexpr uint32_t Magic = 0x52494E47; // RING
+        static constexpr uint32_t AdministrationSize = ((sizeof(Administration) + 63) & ~63);
+        static constexpr uint16_t MinimumSpins = 16;
+        static constexpr uint16_t MaximumSpins = 4096;
+
+    public:
+        static constexpr uint32_t MinimumSize = 4 * 1024;
+        static constexpr uint32_t MaximumSize = 4 * 1024 * 1024;
+
+        SharedRing() = delete;
+        SharedRing(SharedRing&&) = delete;
+        SharedRing(const SharedRing&) = delete;
+        SharedRing& operator=(SharedRing&&) = delete;
+        SharedRing& operator=(const SharedRing&) = delete;
+
+        // The creator, the size is rounded up to a power of 2 within [MinimumSize, MaximumSize].
+        // The file is created exclusively, it is not valid if something by that name already exists.
+        // It is only accessible by the owner, unless the mode grants more.
+        SharedRing(const string& name, const uint32_t mode, const uint32_t size);
+        // The other side, it finds the size in the administration the creator left behind.
+        SharedRing(const string& name);
+        ~SharedRing() override = default;
+
+    public:
+        // A random name for a ring in a memory backed location if there is one.
+        static string TemporaryName();
+
+        inline bool IsValid() const
+        {
+            return (_administration != nullptr);
+        }
+        inline bool IsClosed() const
+        {
+            return ((_administration == nullptr) || (_administration->Closed.load(std::memory_order_acquire) != 0));
+        }
+        inline uint32_t Capacity() const
+        {
+            return (_mask + 1);
+        }
+        inline uint32_t Used() const
+        {
+            return (_administration->Head.load(std::memory_order_acquire) - _administration->Tail.load(std::memory_order_acquire));
+        }
+
+        // Producer side, get the contiguous space that can be filled and publish what was filled.
+        uint32_t Reserve(uint8_t*& buffer);
+        void Produced(const uint32_t length);
+        // Wait until there is space, returns false on a timeout or if the ring got closed.
+        bool WaitForSpace(const uint32_t waitTime);
+
+        // Consumer side, get the contiguous data that can be read and release what was read.
+        uint32_t Peek(const uint8_t*& buffer);
+        void Consumed(const uint32_t length);
+        // Wait until there is data, returns false on a timeout or if the ring got closed.
+        bool WaitForData(const uint32_t waitTime);
+
+        // Either side can close the ring, it wakes up anyone waiting on it.
+        void Close();
+
+    private:
+        bool Wait(std::atomic<uint32_t>& counter, const uint32_t value, std::atomic<uint32_t>& sleeping, uint16_t& spins, const uint32_t waitTime);
+        void Wake(std::atomic<uint32_t>& counter, std::atomic<uint32_t>& sleeping);
+
+    private:
+        Administration* _administration;
+        uint8_t* _data;
+        uint32_t _mask;
+        uint16_t _producerSpins;
+        uint16_t _consumerSpins;
+    };
+}
+} // namespace Core
+
+#endif // __SHARED_RING_H
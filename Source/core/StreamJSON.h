@@ -138,7 +138,7 @@ namespace Core {
                 uint16_t loaded = 0;
 
                 if (_current.IsValid() == false) {
-                    _current = Core::ProxyType<INTERFACE>(_factory.Element(EMPTY_STRING));
+                    _current = Element(stream, length);
                     _offset = 0;
                 }
                 if (_current.IsValid() == true) {
@@ -172,6 +172,22 @@ namespace Core {
             }
 
         private:
+            IS_MEMBER_AVAILABLE(Element, hasElement);
+
+            // A factory that can tell from the first bytes what is coming in (e.g. a
+            // JSON-RPC batch array rather than a single object) gets to see them.
+            template <typename FACTORY = typename std::remove_reference<ALLOCATOR>::type>
+            inline typename Core::TypeTraits::enable_if<hasElement<FACTORY, Core::ProxyType<INTERFACE>, const uint8_t*, const uint16_t>::value, Core::ProxyType<INTERFACE>>::type
+            Element(const uint8_t* stream, const uint16_t length)
+            {
+                return (_factory.Element(stream, length));
+            }
+            template <typename FACTORY = typename std::remove_reference<ALLOCATOR>::type>
+            inline typename Core::TypeTraits::enable_if<!hasElement<FACTORY, Core::ProxyType<INTERFACE>, const uint8_t*, const uint16_t>::value, Core::ProxyType<INTERFACE>>::type
+            Element(const uint8_t*, const uint16_t)
+            {
+                return (Core::ProxyType<INTERFACE>(_factory.Element(EMPTY_STRING)));
+            }
             inline uint16_t Deserialize(const Core::ProxyType<Core::JSON::IElement>& source, const uint8_t* stream, const uint16_t length, Core::OptionalType<Core::JSON::Error>& error) {
                 return(source->Deserialize(reinterpret_cast<const char*>(stream), length, _offset, error));
             }
@@ -20,6 +20,7 @@
 #include "Portability.h"
 #include "SystemInfo.h"
 #include "FileSystem.h"
+#include "KernelFile.h"
 #include "NetworkInfo.h"
 #include "NodeId.h"
 #include "Number.h"
@@ -184,29 +185,40 @@ namespace Core {
     }
 
     SystemInfo::MemorySnapshot::MemorySnapshot() {
-        std::ifstream file("/proc/meminfo", std::ifstream::in);
-        std::string line;
-        while( std::getline(file, line).eof() == false && file.good() == true ) {
-            std::stringstream stream(line);
-            std::string key;
-            stream >> key;
-            if( key == "MemTotal:" ) {
-                stream >> _total; 
-            } else if( key == "MemFree:" ) {
-                stream >> _free; 
-            } else if( key == "MemAvailable:" ) {
-                stream >> _available; 
-            } else if( key == "Cached:" ) {
-                stream >> _cached; 
-            } else if( key == "SwapTotal:" ) {
-                stream >> _swapTotal; 
-            } else if( key == "SwapFree:" ) {
-                stream >> _swapFree; 
-            } else if( key == "SwapCached:" ) {
-                stream >> _swapCached; 
-            } 
+        // The file stays open, every snapshot is a single pread() and a scan without any
+        // allocations.
+        static CriticalSection lock;
+        static KernelFileType<2048> meminfo(_T("/proc/meminfo"));
+
+        lock.Lock();
+
+        if (meminfo.Load() == true) {
+            TextScanner scanner(meminfo.Content());
+
+            if (scanner.Line("MemTotal:") == true) {
+                _total = scanner.Number();
+            }
+            if (scanner.Line("MemFree:") == true) {
+                _free = scanner.Number();
+            }
+            if (scanner.Line("MemAvailable:") == true) {
+                _available = scanner.Number();
+            }
+            if (scanner.Line("Cached:") == true) {
+                _cached = scanner.Number();
+            }
+            if (scanner.Line("SwapCached:") == true) {
+                _swapCached = scanner.Number();
+            }
+            if (scanner.Line("SwapTotal:") == true) {
+                _swapTotal = scanner.Number();
+            }
+            if (scanner.Line("SwapFree:") == true) {
+                _swapFree = scanner.Number();
+            }
         }
-        file.close();
+
+        lock.Unlock();
     }
 
     void SystemInfo::UpdateCpuStats() const
@@ -244,29 +256,26 @@ namespace Core {
 
         // Update once a second to limit file system reads.
         if (difftime(time(nullptr), m_lastUpdateCpuStats) >= RefreshInterval) {
-            FILE* input = fopen(_T("/proc/stat"), _T("r"));
+            static KernelFileType<256> stat(_T("/proc/stat"));
 
-            ASSERT(input && "ERROR: Unable to open /proc/stat");
+            ASSERT(stat.IsOpen() && "ERROR: Unable to open /proc/stat");
 
             // First line of /proc/stat contains the overall CPU information
-            uint64_t CpuFields[4];
-
-            int numFields = fscanf(input, _T("cpu %" PRIu64 " %" PRIu64 " %" PRIu64 " %" PRIu64),
-                &CpuFields[0], &CpuFields[1],
-                &CpuFields[2], &CpuFields[3]);
+            uint64_t CpuFields[4] = { 0, 0, 0, 0 };
 
-            fclose(input);
+            if (stat.Load() == true) {
+                TextScanner scanner(stat.Content());
 
-            ASSERT((numFields >= 4) && "ERROR: Read invalid CPU information.");
+                if (scanner.Match("cpu ") == true) {
+                    for (uint8_t i = 0; i < (sizeof(CpuFields) / sizeof(CpuFields[0])); ++i) {
+                        CpuFields[i] = scanner.Number();
+                    }
+                }
+            }
 
             uint64_t CurrentIdleTime = CpuFields[3]; // 3 is index of idle ticks time
-            uint64_t CurrentTickCount = 0L;
+            uint64_t CurrentTickCount = CpuFields[0] + CpuFields[1] + CpuFields[2] + CpuFields[3];
 
-            // coverity[OVERRUN] - Intentional: fscanf fills at most 4 fields (matching the 4 format specifiers),
-            // so numFields <= 4 and i < numFields always clamps the loop within CpuFields[0..3].
-            for (int i = 0; i < numFields && i < 10; ++i) {
-                CurrentTickCount += CpuFields[i];
-            }
             uint64_t DeltaTickCount = CurrentTickCount - previousTickCount;
             uint64_t DeltaIdleTime = CurrentIdleTime - previousIdleTime;
 
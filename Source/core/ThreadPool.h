@@ -113,7 +113,7 @@ namespace Core {
             }
             MeasurableJob(const ProxyType<IDispatch>& job)
                 : _job(job)
-                , _time(Time::Now().Ticks())
+                , _time(MonotonicTime::Coarse())
             {
             }
             MeasurableJob(const MeasurableJob&) = default;
@@ -141,7 +141,7 @@ namespace Core {
 
                 IDispatch* request = &(*_job);
 
-                REPORT_OUTOFBOUNDS_WARNING(WarningReporting::JobTooLongWaitingInQueue, static_cast<uint32_t>((Time::Now().Ticks() - _time) / Time::TicksPerMillisecond));
+                REPORT_OUTOFBOUNDS_WARNING(WarningReporting::JobTooLongWaitingInQueue, static_cast<uint32_t>((MonotonicTime::Coarse() - _time) / Time::TicksPerMillisecond));
                 REPORT_DURATION_WARNING({ dispatcher->Dispatch(request); }, WarningReporting::JobTooLongToFinish);
             }
             bool IsValid() const
@@ -483,7 +483,7 @@ namespace Core {
                     // Add an entry into the JobMonitor list
                     DispatchedJobMetaData data{Thread::ThreadId(),
                         string(Thunder::Core::CallsignTLS::CallsignAccess<&Thunder::Core::System::MODULE_NAME>::Callsign()),
-                        Time::Now().Ticks(), 0};
+                        MonotonicTime::Now(), 0};
 
                     _parent.SaveDispatchedJobContext(data);
 
@@ -1203,5 +1203,70 @@ PUSH_WARNING(DISABLE_WARNING_DEPRECATED_USE)
         }
         return (((day > 0) && (day <= totalDays)) ? true : false);
     }
+
+#ifdef __WINDOWS__
+
+    /* static */ uint64_t MonotonicTime::Now()
+    {
+        static const uint64_t frequency = []() {
+            LARGE_INTEGER value;
+            ::QueryPerformanceFrequency(&value);
+            return (static_cast<uint64_t>(value.QuadPart));
+        }();
+
+        LARGE_INTEGER counter;
+        ::QueryPerformanceCounter(&counter);
+
+        const uint64_t ticks = static_cast<uint64_t>(counter.QuadPart);
+
+        return (((ticks / frequency) * Time::MicroSecondsPerSecond) + (((ticks % frequency) * Time::MicroSecondsPerSecond) / frequency));
+    }
+
+    /* static */ uint64_t MonotonicTime::Coarse()
+    {
+        return (static_cast<uint64_t>(::GetTickCount64()) * Time::MicroSecondsPerMilliSecond);
+    }
+
+#else
+
+    /* static */ uint64_t MonotonicTime::Now()
+    {
+        struct timespec currentTime{};
+        clock_gettime(CLOCK_MONOTONIC, &currentTime);
+
+        return ((static_cast<uint64_t>(currentTime.tv_sec) * Time::MicroSecondsPerSecond) + (static_cast<uint64_t>(currentTime.tv_nsec) / Time::NanoSecondsPerMicroSecond));
+    }
+
+    /* static */ uint64_t MonotonicTime::Coarse()
+    {
+#ifdef CLOCK_MONOTONIC_COARSE
+        struct timespec currentTime{};
+        clock_gettime(CLOCK_MONOTONIC_COARSE, &currentTime);
+
+        return ((static_cast<uint64_t>(currentTime.tv_sec) * Time::MicroSecondsPerSecond) + (static_cast<uint64_t>(currentTime.tv_nsec) / Time::NanoSecondsPerMicroSecond));
+#else
+        return (Now());
+#endif
+    }
+
+#endif
+
+    /* static */ uint64_t MonotonicTime::FromTime(const Time::microsecondsfromepoch ticks)
+    {
+        const Time::microsecondsfromepoch wallClock = Time::Now().Ticks();
+        const uint64_t now = Now();
+        uint64_t result;
+
+        if (ticks >= wallClock) {
+            const uint64_t delta = ticks - wallClock;
+            result = (delta < (NUMBER_MAX_UNSIGNED(uint64_t) - now) ? now + delta : NUMBER_MAX_UNSIGNED(uint64_t));
+        }
+        else {
+            const uint64_t delta = wallClock - ticks;
+            result = (delta < now ? now - delta : 0);
+        }
+
+        return (result);
+    }
 }
 } // namespace Core
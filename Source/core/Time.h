@@ -394,6 +394,28 @@ public:
 
     };
 
+    // Microseconds since an unspecified moment (typically boot). Unlike Time it does not follow changes of
+    // the wall clock, so it is the one to use for deadlines and durations, never to present a moment in time.
+    class EXTERNAL MonotonicTime {
+    public:
+        MonotonicTime() = delete;
+        MonotonicTime(MonotonicTime&&) = delete;
+        MonotonicTime(const MonotonicTime&) = delete;
+        MonotonicTime& operator=(MonotonicTime&&) = delete;
+        MonotonicTime& operator=(const MonotonicTime&) = delete;
+
+    public:
+        // Read without a system call where the platform allows it (vDSO on Linux).
+        static uint64_t Now();
+
+        // Only updated on every system tick (a few milliseconds), but even cheaper to read. Good enough
+        // for timeouts and the (milliseconds) durations of the warning reporting.
+        static uint64_t Coarse();
+
+        // Moment the wall clock reaches the given time (Time::Ticks()), assuming it does not jump meanwhile.
+        static uint64_t FromTime(const Time::microsecondsfromepoch ticks);
+    };
+
     class EXTERNAL TimeAsLocal {
     public:
 
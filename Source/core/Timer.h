@@ -53,30 +53,35 @@ namespace Core {
         public:
             inline TimedInfo()
                 : m_ScheduleTime(0)
+                , m_Deadline(0)
                 , m_Info()
             {
             }
 
             inline TimedInfo(const uint64_t time, const ACTIVECONTENT& contents)
                 : m_ScheduleTime(time)
+                , m_Deadline(MonotonicTime::FromTime(time))
                 , m_Info(contents)
             {
             }
 
             inline TimedInfo(const uint64_t time, ACTIVECONTENT&& contents)
                 : m_ScheduleTime(time)
+                , m_Deadline(MonotonicTime::FromTime(time))
                 , m_Info(std::move(contents))
             {
             }
 
             inline TimedInfo(const TimedInfo& copy)
                 : m_ScheduleTime(copy.m_ScheduleTime)
+                , m_Deadline(copy.m_Deadline)
                 , m_Info(copy.m_Info)
             {
             }
 
             inline TimedInfo(TimedInfo&& move) noexcept
                 : m_ScheduleTime(move.m_ScheduleTime)
+                , m_Deadline(move.m_Deadline)
                 , m_Info(std::move(move.m_Info))
             {
             }
@@ -97,6 +102,7 @@ namespace Core {
             inline TimedInfo& operator=(const TimedInfo& RHS)
             {
                 m_ScheduleTime = RHS.m_ScheduleTime;
+                m_Deadline = RHS.m_Deadline;
                 m_Info = RHS.m_Info;
 
                 return (*this);
@@ -106,6 +112,7 @@ namespace Core {
             {
                 if (this != &move) {
                     m_ScheduleTime = move.m_ScheduleTime;
+                    m_Deadline = move.m_Deadline;
                     m_Info = std::move(move.m_Info);
                 }
                 return (*this);
@@ -119,6 +126,20 @@ namespace Core {
             inline void ScheduleTime(const uint64_t scheduleTime)
             {
                 m_ScheduleTime = scheduleTime;
+                m_Deadline = MonotonicTime::FromTime(scheduleTime);
+            }
+
+            // As above, but the deadline is never before notBefore (monotonic clock).
+            inline void ScheduleTime(const uint64_t scheduleTime, const uint64_t notBefore)
+            {
+                m_ScheduleTime = scheduleTime;
+                m_Deadline = std::max(MonotonicTime::FromTime(scheduleTime), notBefore);
+            }
+
+            // The schedule time on the monotonic clock, so wall clock changes do not fire or stall the timer.
+            inline uint64_t Deadline() const
+            {
+                return (m_Deadline);
             }
 
             inline ACTIVECONTENT& Content()
@@ -128,6 +149,7 @@ namespace Core {
 
         private:
             uint64_t m_ScheduleTime;
+            uint64_t m_Deadline;
             ACTIVECONTENT m_Info;
         };
 
@@ -338,7 +360,7 @@ namespace Core {
         uint32_t Process()
         {
             uint32_t delayTime = Core::infinite;
-            uint64_t now = Time::Now().Ticks();
+            uint64_t now = MonotonicTime::Now();
 
             _adminLock.Lock();
 
@@ -346,7 +368,7 @@ namespace Core {
             // Ranging from 0-Core::infinite
             _timerThread.Block();
 
-            while ((_pendingQueue.empty() == false) && (_pendingQueue.front().ScheduleTime() <= now)) {
+            while ((_pendingQueue.empty() == false) && (_pendingQueue.front().Deadline() <= now)) {
                 TimedInfo<CONTENT> info(std::move(_pendingQueue.front()));
                 _executing = &(info.Content());
 
@@ -362,9 +384,10 @@ namespace Core {
                 _adminLock.Lock();
 
                 if ((_executing != nullptr) && (reschedule != 0)) {
-                    ASSERT(reschedule > now);
-
-                    info.ScheduleTime(reschedule);
+                    // Timed() answers in wall clock time, that might have been set back (or forward) since
+                    // this entry got scheduled. Compare on the monotonic clock only: whatever lands in the
+                    // past runs in the next round, not again in this one.
+                    info.ScheduleTime(reschedule, now + 1);
                     ScheduleEntry(std::move(info));
                 }
 
@@ -377,16 +400,14 @@ namespace Core {
                 _nextTrigger = NUMBER_MAX_UNSIGNED(uint64_t);
             } else {
                 // Refresh the time, just to be on the safe side...
-                uint64_t delta = Time::Now().Ticks();
+                uint64_t delta = MonotonicTime::Now();
+
+                _nextTrigger = _pendingQueue.front().ScheduleTime();
 
-                if (delta >= _pendingQueue.front().ScheduleTime()) {
-                    _nextTrigger = delta;
+                if (delta >= _pendingQueue.front().Deadline()) {
                     delayTime = 0;
                 } else {
-                    // The windows counter is in 100ns intervals dus we mmoeten even delen door  1000 (us) * 10 ns = 10.000
-                    // om de waarde in ms te krijgen.
-                    _nextTrigger = _pendingQueue.front().ScheduleTime();
-                    delayTime = static_cast<uint32_t>((_nextTrigger - delta) / Time::TicksPerMillisecond);
+                    delayTime = static_cast<uint32_t>((_pendingQueue.front().Deadline() - delta) / Time::TicksPerMillisecond);
                 }
             }
 
@@ -401,7 +422,7 @@ namespace Core {
             bool reevaluate = false;
             typename SubscriberList::iterator index = _pendingQueue.begin();
 
-            while ((index != _pendingQueue.end()) && (infoBlock.ScheduleTime() >= (*index).ScheduleTime())) {
+            while ((index != _pendingQueue.end()) && (infoBlock.Deadline() >= (*index).Deadline())) {
                 ++index;
             }
 
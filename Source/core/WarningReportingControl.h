@@ -121,9 +121,9 @@
 
 #define REPORT_DURATION_WARNING(CODE, CATEGORY, ...)                                                                                                           \
     if (Thunder::WarningReporting::WarningReportingType<Thunder::WarningReporting::WarningReportingBoundsCategory<CATEGORY>>::IsEnabled() == true) { \
-        uint64_t start = Thunder::Core::SystemInfo::Instance().Ticks();                                                                                   \
+        uint64_t start = Thunder::Core::MonotonicTime::Now();                                                                                        \
         CODE                                                                                                                                                   \
-        uint64_t duration = (Thunder::Core::SystemInfo::Instance().Ticks() - start) / Thunder::Core::Time::MicroSecondsPerMilliSecond;               \
+        uint64_t duration = (Thunder::Core::MonotonicTime::Now() - start) / Thunder::Core::Time::MicroSecondsPerMilliSecond;                         \
         Thunder::WarningReporting::WarningReportingType<Thunder::WarningReporting::WarningReportingBoundsCategory<CATEGORY>> __message__;            \
         if (__message__.Analyze(Thunder::Core::System::MODULE_NAME,                                                                                       \
                 Thunder::Core::CallsignTLS::CallsignAccess<&Thunder::Core::System::MODULE_NAME>::Callsign(),                                         \
@@ -279,7 +279,7 @@ namespace Core {
                     for (auto &job : _dispatchedJobList) {
                         ++job.ReportRunCount;
                         REPORT_OUTOFBOUNDS_WARNING_EX(WarningReporting::JobActiveForTooLong, job.CallSign.c_str(),
-                        static_cast<uint32_t>((Time::Now().Ticks() - job.DispatchedTime) / Time::TicksPerMillisecond));
+                        static_cast<uint32_t>((MonotonicTime::Now() - job.DispatchedTime) / Time::TicksPerMillisecond));
                     }
                 }
 
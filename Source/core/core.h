@@ -53,6 +53,7 @@
 #include "IWarningReportingControl.h"
 #include "JSON.h"
 #include "JSONRPC.h"
+#include "KernelFile.h"
 #include "KeyValue.h"
 #include "Library.h"
 #include "Link.h"
@@ -69,16 +70,19 @@
 #include "Parser.h"
 #include "Process.h"
 #include "ProcessInfo.h"
+#include "ProcessSampler.h"
 #include "Proxy.h"
 #include "Queue.h"
 #include "Range.h"
 #include "Rectangle.h"
+#include "ReadMostlyMap.h"
 #include "ReadWriteLock.h"
 #include "ResourceMonitor.h"
 #include "SerialPort.h"
 #include "Serialization.h"
 #include "Services.h"
 #include "SharedBuffer.h"
+#include "SharedRing.h"
 #include "Singleton.h"
 #include "SocketPort.h"
 #include "SocketServer.h"
@@ -26,6 +26,7 @@
 */
 
 #include "AESImplementation.h"
+#include "Acceleration.h"
 #include <stdio.h>
 #include <string.h>
 extern "C" {
@@ -734,6 +735,11 @@ int mbedtls_aes_crypt_ecb(mbedtls_aes_context* ctx,
     const unsigned char input[16],
     unsigned char output[16])
 {
+    // CPU crypto extensions (AES-NI, ARMv8 AES) work on the round keys as laid out
+    // by the key schedules above, if not available use the table based code.
+    if (Thunder::Crypto::Kernel::AES(reinterpret_cast<const uint8_t*>(ctx->rk), ctx->nr, (mode == MBEDTLS_AES_ENCRYPT), input, output) == true)
+        return (0);
+
 #if defined(MBEDTLS_AESNI_C) && defined(MBEDTLS_HAVE_X86_64)
     if (mbedtls_aesni_has_support(MBEDTLS_AESNI_AES))
         return (mbedtls_aesni_crypt_ecb(ctx, mode, input, output));
@@ -954,7 +960,7 @@ int mbedtls_aes_crypt_ofb(mbedtls_aes_context* ctx,
     }
 
     while ((cnt + 16) <= length) {
-        mbedtls_aes_encrypt(ctx, iv, iv);
+        mbedtls_aes_crypt_ecb(ctx, MBEDTLS_AES_ENCRYPT, iv, iv);
 
         for (unsigned char teller = 0; teller < 16; teller++) {
 
@@ -964,7 +970,7 @@ int mbedtls_aes_crypt_ofb(mbedtls_aes_context* ctx,
     }
 
     if (cnt < length) {
-        mbedtls_aes_encrypt(ctx, iv, iv);
+        mbedtls_aes_crypt_ecb(ctx, MBEDTLS_AES_ENCRYPT, iv, iv);
 
         while (cnt < length) {
             *output++ = iv[b_pos++] ^ *input++;
@@ -0,0 +1,429 @@
+/*
+ * If not stated otherwise in this file or this component's LICENSE file the
+ * following copyright and licenses apply:
+ *
+ * Copyright 2020 Metrological
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "Acceleration.h"
+
+#if defined(CRYPTALGO_HARDWARE_ACCELERATION) && defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define __CRYPTALGO_X86__
+#include <cpuid.h>
+#include <immintrin.h>
+#define TARGET_SHA __attribute__((target("sha,sse4.1,ssse3")))
+#define TARGET_AES __attribute__((target("aes,sse2")))
+#elif defined(CRYPTALGO_HARDWARE_ACCELERATION) && defined(__GNUC__) && defined(__aarch64__) && defined(__AARCH64EL__) && defined(__LINUX__)
+#define __CRYPTALGO_ARMV8__
+#include <sys/auxv.h>
+#include <asm/hwcap.h>
+#include <arm_neon.h>
+#if defined(__clang__)
+#define TARGET_SHA __attribute__((target("crypto")))
+#define TARGET_AES __attribute__((target("crypto")))
+#else
+#define TARGET_SHA __attribute__((target("+crypto")))
+#define TARGET_AES __attribute__((target("+crypto")))
+#endif
+#endif
+
+namespace Thunder {
+namespace Crypto {
+
+    namespace {
+
+#if defined(__CRYPTALGO_X86__) || defined(__CRYPTALGO_ARMV8__)
+        const uint32_t SHA256K[64] = {
+            0x428a2f98, 0x71374491, 0xb5c0fbcf, 0xe9b5dba5, 0x3956c25b, 0x59f111f1, 0x923f82a4, 0xab1c5ed5,
+            0xd807aa98, 0x12835b01, 0x243185be, 0x550c7dc3, 0x72be5d74, 0x80deb1fe, 0x9bdc06a7, 0xc19bf174,
+            0xe49b69c1, 0xefbe4786, 0x0fc19dc6, 0x240ca1cc, 0x2de92c6f, 0x4a7484aa, 0x5cb0a9dc, 0x76f988da,
+            0x983e5152, 0xa831c66d, 0xb00327c8, 0xbf597fc7, 0xc6e00bf3, 0xd5a79147, 0x06ca6351, 0x14292967,
+            0x27b70a85, 0x2e1b2138, 0x4d2c6dfc, 0x53380d13, 0x650a7354, 0x766a0abb, 0x81c2c92e, 0x92722c85,
+            0xa2bfe8a1, 0xa81a664b, 0xc24b8b70, 0xc76c51a3, 0xd192e819, 0xd6990624, 0xf40e3585, 0x106aa070,
+            0x19a4c116, 0x1e376c08, 0x2748774c, 0x34b0bcb5, 0x391c0cb3, 0x4ed8aa4a, 0x5b9cca4f, 0x682e6ff3,
+            0x748f82ee, 0x78a5636f, 0x84c87814, 0x8cc70208, 0x90befffa, 0xa4506ceb, 0xbef9a3f7, 0xc67178f2
+        };
+#endif
+
+#if defined(__CRYPTALGO_X86__)
+
+        uint8_t Detect()
+        {
+            uint8_t result = ACCELERATION_NONE;
+            unsigned int eax, ebx, ecx, edx;
+
+            if (__get_cpuid(1, &eax, &ebx, &ecx, &edx) != 0) {
+                const bool ssse3 = ((ecx & (1 << 9)) != 0);
+                const bool sse41 = ((ecx & (1 << 19)) != 0);
+
+                if ((ecx & (1 << 25)) != 0) {
+                    result |= ACCELERATION_AES;
+                }
+
+                if ((ssse3 == true) && (sse41 == true) && (__get_cpuid_count(7, 0, &eax, &ebx, &ecx, &edx) != 0) && ((ebx & (1 << 29)) != 0)) {
+                    result |= (ACCELERATION_SHA1 | ACCELERATION_SHA256);
+                }
+            }
+
+            return (result);
+        }
+
+        TARGET_SHA void SHA1Blocks(uint32_t state[5], const uint8_t data[], uint32_t blocks)
+        {
+            const __m128i mask = _mm_set_epi64x(0x0001020304050607ULL, 0x08090a0b0c0d0e0fULL);
+
+            __m128i abcd = _mm_shuffle_epi32(_mm_loadu_si128(reinterpret_cast<const __m128i*>(state)), 0x1B);
+            __m128i e[2] = { _mm_set_epi32(static_cast<int>(state[4]), 0, 0, 0), _mm_setzero_si128() };
+            __m128i msg[4];
+
+            while (blocks-- > 0) {
+                const __m128i abcdSave = abcd;
+                const __m128i eSave = e[0];
+
+                for (uint8_t index = 0; index < 4; index++) {
+                    msg[index] = _mm_shuffle_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i*>(&data[index * 16])), mask);
+                }
+
+                // 20 groups of 4 rounds, the message schedule runs 3 groups ahead.
+                for (uint8_t group = 0; group < 20; group++) {
+                    __m128i& current = e[group & 1];
+
+                    if (group == 0) {
+                        current = _mm_add_epi32(current, msg[0]);
+                    } else {
+                        current = _mm_sha1nexte_epu32(current, msg[group & 3]);
+                    }
+                    e[(group + 1) & 1] = abcd;
+
+                    if ((group >= 3) && (group <= 18)) {
+                        msg[(group + 1) & 3] = _mm_sha1msg2_epu32(msg[(group + 1) & 3], msg[group & 3]);
+                    }
+
+                    switch (group / 5) {
+                    case 0: abcd = _mm_sha1rnds4_epu32(abcd, current, 0); break;
+                    case 1: abcd = _mm_sha1rnds4_epu32(abcd, current, 1); break;
+                    case 2: abcd = _mm_sha1rnds4_epu32(abcd, current, 2); break;
+                    default: abcd = _mm_sha1rnds4_epu32(abcd, current, 3); break;
+                    }
+
+                    if ((group >= 1) && (group <= 16)) {
+                        msg[(group - 1) & 3] = _mm_sha1msg1_epu32(msg[(group - 1) & 3], msg[group & 3]);
+                    }
+                    if ((group >= 2) && (group <= 17)) {
+                        msg[(group - 2) & 3] = _mm_xor_si128(msg[(group - 2) & 3], msg[group & 3]);
+                    }
+                }
+
+                e[0] = _mm_sha1nexte_epu32(e[0], eSave);
+                abcd = _mm_add_epi32(abcd, abcdSave);
+
+                data += 64;
+            }
+
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(state), _mm_shuffle_epi32(abcd, 0x1B));
+            state[4] = static_cast<uint32_t>(_mm_extract_epi32(e[0], 3));
+        }
+
+        TARGET_SHA void SHA256Blocks(uint32_t state[8], const uint8_t data[], uint32_t blocks)
+        {
+            const __m128i mask = _mm_set_epi64x(0x0c0d0e0f08090a0bULL, 0x0405060700010203ULL);
+
+            __m128i tmp = _mm_shuffle_epi32(_mm_loadu_si128(reinterpret_cast<const __m128i*>(&state[0])), 0xB1); // CDAB
+            __m128i state1 = _mm_shuffle_epi32(_mm_loadu_si128(reinterpret_cast<const __m128i*>(&state[4])), 0x1B); // EFGH
+            __m128i state0 = _mm_alignr_epi8(tmp, state1, 8); // ABEF
+            state1 = _mm_blend_epi16(state1, tmp, 0xF0); // CDGH
+
+            __m128i msg[4];
+
+            while (blocks-- > 0) {
+                const __m128i abefSave = state0;
+                const __m128i cdghSave = state1;
+
+                for (uint8_t index = 0; index < 4; index++) {
+                    msg[index] = _mm_shuffle_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i*>(&data[index * 16])), mask);
+                }
+
+                // 16 groups of 4 rounds, the message schedule runs 3 groups ahead.
+                for (uint8_t group = 0; group < 16; group++) {
+                    __m128i words = _mm_add_epi32(msg[group & 3], _mm_loadu_si128(reinterpret_cast<const __m128i*>(&SHA256K[group * 4])));
+
+                    state1 = _mm_sha256rnds2_epu32(state1, state0, words);
+
+                    if ((group >= 3) && (group <= 14)) {
+                        __m128i& next = msg[(group + 1) & 3];
+                        next = _mm_add_epi32(next, _mm_alignr_epi8(msg[group & 3], msg[(group - 1) & 3], 4));
+                        next = _mm_sha256msg2_epu32(next, msg[group & 3]);
+                    }
+
+                    words = _mm_shuffle_epi32(words, 0x0E);
+                    state0 = _mm_sha256rnds2_epu32(state0, state1, words);
+
+                    if ((group >= 1) && (group <= 12)) {
+                        msg[(group - 1) & 3] = _mm_sha256msg1_epu32(msg[(group - 1) & 3], msg[group & 3]);
+                    }
+                }
+
+                state0 = _mm_add_epi32(state0, abefSave);
+                state1 = _mm_add_epi32(state1, cdghSave);
+
+                data += 64;
+            }
+
+            tmp = _mm_shuffle_epi32(state0, 0x1B); // FEBA
+            state1 = _mm_shuffle_epi32(state1, 0xB1); // DCHG
+            state0 = _mm_blend_epi16(tmp, state1, 0xF0); // DCBA
+            state1 = _mm_alignr_epi8(state1, tmp, 8); // ABEF
+
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(&state[0]), state0);
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(&state[4]), state1);
+        }
+
+        TARGET_AES void AESBlock(const uint8_t roundKeys[], const int rounds, const bool encrypt, const uint8_t input[16], uint8_t output[16])
+        {
+            const __m128i* keys = reinterpret_cast<const __m128i*>(roundKeys);
+            __m128i block = _mm_xor_si128(_mm_loadu_si128(reinterpret_cast<const __m128i*>(input)), _mm_loadu_si128(&keys[0]));
+
+            // The decryption key schedule of the portable implementation already is the
+            // "equivalent inverse cipher" schedule AESDEC expects.
+            if (encrypt == true) {
+                for (int index = 1; index < rounds; index++) {
+                    block = _mm_aesenc_si128(block, _mm_loadu_si128(&keys[index]));
+                }
+                block = _mm_aesenclast_si128(block, _mm_loadu_si128(&keys[rounds]));
+            } else {
+                for (int index = 1; index < rounds; index++) {
+                    block = _mm_aesdec_si128(block, _mm_loadu_si128(&keys[index]));
+                }
+                block = _mm_aesdeclast_si128(block, _mm_loadu_si128(&keys[rounds]));
+            }
+
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(output), block);
+        }
+
+#elif defined(__CRYPTALGO_ARMV8__)
+
+        uint8_t Detect()
+        {
+            uint8_t result = ACCELERATION_NONE;
+            const unsigned long capabilities = ::getauxval(AT_HWCAP);
+
+            if ((capabilities & HWCAP_AES) != 0) {
+                result |= ACCELERATION_AES;
+            }
+            if ((capabilities & HWCAP_SHA1) != 0) {
+                result |= ACCELERATION_SHA1;
+            }
+            if ((capabilities & HWCAP_SHA2) != 0) {
+                result |= ACCELERATION_SHA256;
+            }
+
+            return (result);
+        }
+
+        TARGET_SHA void SHA1Blocks(uint32_t state[5], const uint8_t data[], uint32_t blocks)
+        {
+            static const uint32_t K[4] = { 0x5A827999, 0x6ED9EBA1, 0x8F1BBCDC, 0xCA62C1D6 };
+
+            uint32x4_t abcd = vld1q_u32(&state[0]);
+            uint32_t e = state[4];
+            uint32x4_t msg[4];
+
+            while (blocks-- > 0) {
+                const uint32x4_t abcdSave = abcd;
+                const uint32_t eSave = e;
+
+                for (uint8_t index = 0; index < 4; index++) {
+                    msg[index] = vreinterpretq_u32_u8(vrev32q_u8(vld1q_u8(&data[index * 16])));
+                }
+
+                // 20 groups of 4 rounds, the message schedule runs 3 groups ahead.
+                for (uint8_t group = 0; group < 20; group++) {
+                    const uint32x4_t words = vaddq_u32(msg[group & 3], vdupq_n_u32(K[group / 5]));
+                    const uint32_t next = vsha1h_u32(vgetq_lane_u32(abcd, 0));
+
+                    switch (group / 5) {
+                    case 0: abcd = vsha1cq_u32(abcd, e, words); break;
+                    case 2: abcd = vsha1mq_u32(abcd, e, words); break;
+                    default: abcd = vsha1pq_u32(abcd, e, words); break;
+                    }
+
+                    e = next;
+
+                    if (group < 16) {
+                        uint32x4_t& current = msg[group & 3];
+                        current = vsha1su1q_u32(vsha1su0q_u32(current, msg[(group + 1) & 3], msg[(group + 2) & 3]), msg[(group + 3) & 3]);
+                    }
+                }
+
+                abcd = vaddq_u32(abcd, abcdSave);
+                e += eSave;
+
+                data += 64;
+            }
+
+            vst1q_u32(&state[0], abcd);
+            state[4] = e;
+        }
+
+        TARGET_SHA void SHA256Blocks(uint32_t state[8], const uint8_t data[], uint32_t blocks)
+        {
+            uint32x4_t state0 = vld1q_u32(&state[0]);
+            uint32x4_t state1 = vld1q_u32(&state[4]);
+            uint32x4_t msg[4];
+
+            while (blocks-- > 0) {
+                const uint32x4_t abcdSave = state0;
+                const uint32x4_t efghSave = state1;
+
+                for (uint8_t index = 0; index < 4; index++) {
+                    msg[index] = vreinterpretq_u32_u8(vrev32q_u8(vld1q_u8(&data[index * 16])));
+                }
+
+                // 16 groups of 4 rounds, the message schedule runs 3 groups ahead.
+                for (uint8_t group = 0; group < 16; group++) {
+                    const uint32x4_t words = vaddq_u32(msg[group & 3], vld1q_u32(&SHA256K[group * 4]));
+                    const uint32x4_t previous = state0;
+
+                    if (group < 12) {
+                        uint32x4_t& current = msg[group & 3];
+                        current = vsha256su1q_u32(vsha256su0q_u32(current, msg[(group + 1) & 3]), msg[(group + 2) & 3], msg[(group + 3) & 3]);
+                    }
+
+                    state0 = vsha256hq_u32(state0, state1, words);
+                    state1 = vsha256h2q_u32(state1, previous, words);
+                }
+
+                state0 = vaddq_u32(state0, abcdSave);
+                state1 = vaddq_u32(state1, efghSave);
+
+                data += 64;
+            }
+
+            vst1q_u32(&state[0], state0);
+            vst1q_u32(&state[4], state1);
+        }
+
+        TARGET_AES void AESBlock(const uint8_t roundKeys[], const int rounds, const bool encrypt, const uint8_t input[16], uint8_t output[16])
+        {
+            uint8x16_t block = vld1q_u8(input);
+
+            // AESE/AESD do the AddRoundKey first, so the last key is applied separately.
+            if (encrypt == true) {
+                for (int index = 0; index < (rounds - 1); index++) {
+                    block = vaesmcq_u8(vaeseq_u8(block, vld1q_u8(&roundKeys[index * 16])));
+                }
+                block = vaeseq_u8(block, vld1q_u8(&roundKeys[(rounds - 1) * 16]));
+            } else {
+                for (int index = 0; index < (rounds - 1); index++) {
+                    block = vaesimcq_u8(vaesdq_u8(block, vld1q_u8(&roundKeys[index * 16])));
+                }
+                block = vaesdq_u8(block, vld1q_u8(&roundKeys[(rounds - 1) * 16]));
+            }
+
+            vst1q_u8(output, veorq_u8(block, vld1q_u8(&roundKeys[rounds * 16])));
+        }
+
+#else
+
+        uint8_t Detect()
+        {
+            return (ACCELERATION_NONE);
+        }
+
+#endif
+
+        uint8_t Available()
+        {
+            static const uint8_t available = Detect();
+
+            return (available);
+        }
+
+        std::atomic<uint8_t>& Enabled()
+        {
+            static std::atomic<uint8_t> enabled(Available());
+
+            return (enabled);
+        }
+
+        inline bool IsEnabled(const acceleration feature)
+        {
+            return ((Enabled().load(std::memory_order_relaxed) & feature) != 0);
+        }
+
+    } // namespace
+
+    uint8_t Acceleration()
+    {
+        return (Available());
+    }
+
+    uint8_t Accelerated()
+    {
+        return (Enabled().load(std::memory_order_relaxed));
+    }
+
+    void Accelerate(const uint8_t features)
+    {
+        Enabled().store(features & Available(), std::memory_order_relaxed);
+    }
+
+    namespace Kernel {
+
+        bool SHA1(uint32_t state[5] VARIABLE_IS_NOT_USED, const uint8_t data[] VARIABLE_IS_NOT_USED, const uint32_t blocks VARIABLE_IS_NOT_USED)
+        {
+            bool result = false;
+
+#if defined(__CRYPTALGO_X86__) || defined(__CRYPTALGO_ARMV8__)
+            if (IsEnabled(ACCELERATION_SHA1) == true) {
+                SHA1Blocks(state, data, blocks);
+                result = true;
+            }
+#endif
+
+            return (result);
+        }
+
+        bool SHA256(uint32_t state[8] VARIABLE_IS_NOT_USED, const uint8_t data[] VARIABLE_IS_NOT_USED, const uint32_t blocks VARIABLE_IS_NOT_USED)
+        {
+            bool result = false;
+
+#if defined(__CRYPTALGO_X86__) || defined(__CRYPTALGO_ARMV8__)
+            if (IsEnabled(ACCELERATION_SHA256) == true) {
+                SHA256Blocks(state, data, blocks);
+                result = true;
+            }
+#endif
+
+            return (result);
+        }
+
+        bool AES(const uint8_t roundKeys[] VARIABLE_IS_NOT_USED, const int rounds VARIABLE_IS_NOT_USED, const bool encrypt VARIABLE_IS_NOT_USED, const uint8_t input[16] VARIABLE_IS_NOT_USED, uint8_t output[16] VARIABLE_IS_NOT_USED)
+        {
+            bool result = false;
+
+#if defined(__CRYPTALGO_X86__) || defined(__CRYPTALGO_ARMV8__)
+            if (IsEnabled(ACCELERATION_AES) == true) {
+                AESBlock(roundKeys, rounds, encrypt, input, output);
+                result = true;
+            }
+#endif
+
+            return (result);
+        }
+
+    } // namespace Kernel
+}
+}
@@ -0,0 +1,68 @@
+/*
+ * If not stated otherwise in this file or this component's LICENSE file the
+ * following copyright and licenses apply:
+ *
+ * Copyright 2020 Metrological
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef __ACCELERATION_H
+#define __ACCELERATION_H
+
+// ---- Include system wide include files ----
+
+// ---- Include local include files ----
+#include "Module.h"
+
+// ---- Referenced classes and types ----
+
+// ---- Helper types and constants ----
+
+// ---- Helper functions ----
+namespace Thunder {
+namespace Crypto {
+
+    enum acceleration : uint8_t {
+        ACCELERATION_NONE = 0x00,
+        ACCELERATION_SHA1 = 0x01,
+        ACCELERATION_SHA256 = 0x02,
+        ACCELERATION_AES = 0x04
+    };
+
+    // The CPU crypto extensions (SHA-NI/AES-NI on x86, ARMv8 crypto extensions on AArch64)
+    // that are present on this CPU and for which this build carries a kernel.
+    extern EXTERNAL uint8_t Acceleration();
+
+    // The subset of the above currently in use. By default all available extensions are used,
+    // the portable implementation remains the fallback for everything else.
+    extern EXTERNAL uint8_t Accelerated();
+
+    // Restrict the extensions used, e.g. Accelerate(ACCELERATION_NONE) to force the portable
+    // implementation. Extensions not offered by the CPU are ignored.
+    extern EXTERNAL void Accelerate(const uint8_t features);
+
+    // Block kernels used by the Hash and AES implementations of this library. Each returns false,
+    // without touching the output, if the extension is not in use so the caller can fall back
+    // to the portable implementation.
+    namespace Kernel {
+
+        bool SHA1(uint32_t state[5], const uint8_t data[], const uint32_t blocks);
+        bool SHA256(uint32_t state[8], const uint8_t data[], const uint32_t blocks);
+        bool AES(const uint8_t roundKeys[], const int rounds, const bool encrypt, const uint8_t input[16], uint8_t output[16]);
+
+    }
+}
+}
+
+#endif // __ACCELERATION_H
@@ -0,0 +1,192 @@
+/*
+ * If not stated otherwise in this file or this component's LICENSE file the
+ * following copyright and licenses apply:
+ *
+ * Copyright 2020 Metrological
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef __FILEHASH_H
+#define __FILEHASH_H
+
+// ---- Include system wide include files ----
+#include <atomic>
+#include <thread>
+#include <vector>
+
+// ---- Include local include files ----
+#include "Module.h"
+
+// ---- Referenced classes and types ----
+
+// ---- Helper types and constants ----
+
+// ---- Helper functions ----
+namespace Thunder {
+namespace Crypto {
+
+    // Hashing of complete files. The files are memory mapped (Core::DataElementFile) and fed to the
+    // hash straight from the mapping, so no read buffers or read system calls are involved.
+    //
+    // A single standard digest is inherently serial. Work is spread over multiple cores by:
+    // - Digest(list):  several independent files, each with its own standard digest, concurrently.
+    // - TreeDigest():  one file, split in leaves of LeafSize bytes that are hashed concurrently.
+    //                  The result is NOT the standard digest of the file, both sides of an exchange
+    //                  must use TreeDigest. Leaf = H(0x00 | leaf data), root = H(0x01 | leaf digests).
+    template <typename HASHALGORITHM>
+    class FileHashType {
+    public:
+        static constexpr uint8_t Length = HASHALGORITHM::Length;
+        static constexpr uint32_t LeafSize = (1024 * 1024);
+
+        struct Entry {
+            Entry()
+                : FileName()
+                , Valid(false)
+                , Digest()
+            {
+            }
+            Entry(const string& fileName)
+                : FileName(fileName)
+                , Valid(false)
+                , Digest()
+            {
+            }
+
+            string FileName;
+            bool Valid;
+            uint8_t Digest[Length];
+        };
+
+    private:
+        // The hash Input takes at most a 16 bits length, feed it in these slices.
+        static constexpr uint16_t SliceSize = 0x8000;
+
+    public:
+        FileHashType() = delete;
+        FileHashType(FileHashType<HASHALGORITHM>&&) = delete;
+        FileHashType(const FileHashType<HASHALGORITHM>&) = delete;
+        FileHashType<HASHALGORITHM>& operator=(FileHashType<HASHALGORITHM>&&) = delete;
+        FileHashType<HASHALGORITHM>& operator=(const FileHashType<HASHALGORITHM>&) = delete;
+
+    public:
+        static bool Digest(const string& fileName, uint8_t digest[Length])
+        {
+            Core::DataElementFile file(fileName, Core::File::USER_READ);
+            const bool result = file.IsValid();
+
+            if (result == true) {
+                HASHALGORITHM hash;
+                Feed(hash, file.Buffer(), file.Size());
+                ::memcpy(digest, hash.Result(), Length);
+            }
+
+            return (result);
+        }
+
+        // Calculates the standard digest of every entry, <workers> files at a time (0 is one per core).
+        // Returns the number of files that could be hashed, see Entry::Valid for the individual result.
+        static uint32_t Digest(std::vector<Entry>& entries, const uint8_t workers = 0)
+        {
+            std::atomic<uint32_t> succeeded(0);
+
+            Parallel(static_cast<uint32_t>(entries.size()), workers, [&entries, &succeeded](const uint32_t index) {
+                Entry& entry(entries[index]);
+
+                entry.Valid = Digest(entry.FileName, entry.Digest);
+
+                if (entry.Valid == true) {
+                    succeeded++;
+                }
+            });
+
+            return (succeeded.load());
+        }
+
+        static bool TreeDigest(const string& fileName, uint8_t digest[Length], const uint8_t workers = 0)
+        {
+            Core::DataElementFile file(fileName, Core::File::USER_READ);
+            const bool result = file.IsValid();
+
+            if (result == true) {
+                const uint8_t* data = file.Buffer();
+                const uint64_t size = file.Size();
+                const uint32_t leafs = (size == 0 ? 1 : static_cast<uint32_t>((size + LeafSize - 1) / LeafSize));
+
+                std::vector<uint8_t> nodes(static_cast<size_t>(leafs) * Length);
+
+                Parallel(leafs, workers, [data, size, &nodes](const uint32_t index) {
+                    const uint64_t offset = static_cast<uint64_t>(index) * LeafSize;
+                    const uint8_t marker = 0x00;
+
+                    HASHALGORITHM hash;
+                    hash.Input(&marker, 1);
+                    Feed(hash, (data == nullptr ? nullptr : &data[offset]), std::min(static_cast<uint64_t>(LeafSize), size - offset));
+                    ::memcpy(&nodes[static_cast<size_t>(index) * Length], hash.Result(), Length);
+                });
+
+                const uint8_t marker = 0x01;
+                HASHALGORITHM root;
+                root.Input(&marker, 1);
+                Feed(root, nodes.data(), nodes.size());
+                ::memcpy(digest, root.Result(), Length);
+            }
+
+            return (result);
+        }
+
+    private:
+        static void Feed(HASHALGORITHM& hash, const uint8_t data[], uint64_t length)
+        {
+            while (length > 0) {
+                const uint16_t slice = static_cast<uint16_t>(std::min(length, static_cast<uint64_t>(SliceSize)));
+                hash.Input(data, slice);
+                data += slice;
+                length -= slice;
+            }
+        }
+
+        // Runs job(index) for every index in [0, count), the calling thread takes part in the work.
+        template <typename JOB>
+        static void Parallel(const uint32_t count, const uint8_t workers, JOB&& job)
+        {
+            std::atomic<uint32_t> next(0);
+            std::vector<std::thread> threads;
+
+            const uint32_t cores = std::max(std::thread::hardware_concurrency(), 1u);
+            const uint32_t slots = std::min((workers == 0 ? cores : workers), count);
+
+            auto worker = [&next, &job, count]() {
+                uint32_t index;
+                while ((index = next++) < count) {
+                    job(index);
+                }
+            };
+
+            for (uint32_t index = 1; index < slots; index++) {
+                threads.emplace_back(worker);
+            }
+
+            worker();
+
+            for (std::thread& thread : threads) {
+                thread.join();
+            }
+        }
+    };
+
+}
+}
+
+#endif // __FILEHASH_H
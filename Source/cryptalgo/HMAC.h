@@ -35,6 +35,14 @@ namespace Thunder {
 namespace Crypto {
     template <typename HASHALGORITHM>
     class HMACType {
+    public:
+        // The key schedule: the hash states after absorbing the inner and the outer key pad.
+        // Computed once per key, every HMAC calculation starts from these states.
+        struct Schedule {
+            typename HASHALGORITHM::Context Inner;
+            typename HASHALGORITHM::Context Outer;
+        };
+
     public:
         HMACType(const HMACType&) = delete;
         HMACType& operator=(const HMACType&) = delete;
@@ -45,6 +53,9 @@ namespace Crypto {
         HMACType(const string& key) : _algorithm() {
             Key(key);
         }
+        HMACType(const Schedule& schedule) : _algorithm() {
+            Key(schedule);
+        }
        ~HMACType() = default;
 
     public:
@@ -55,8 +66,10 @@ namespace Crypto {
             uint8_t keyLength;
             const uint8_t* encryptionKey;
             HASHALGORITHM hashKey;
+            uint8_t innerKeyPad[BlockSize];
+            uint8_t outerKeyPad[BlockSize];
 
-            if (key.length() > sizeof(_innerKeyPad)) {
+            if (key.length() > sizeof(innerKeyPad)) {
                 keyLength = HASHALGORITHM::Length;
 
                 // Calculate the Hash over the key to use that i.s.o. the actual key.
@@ -70,29 +83,47 @@ namespace Crypto {
             }
 
             // We have a suitable key, move it to the inner and outer pads
-            // coverity[OVERRUN] - False positive (#754): keyLength is always <= sizeof(_innerKeyPad) (64);
+            // coverity[OVERRUN] - False positive (#754): keyLength is always <= sizeof(innerKeyPad) (64);
             //                     when keyLength == 64 the memset count is 0, so no bytes are written.
-            ::memset(&_innerKeyPad[keyLength], 0x36, sizeof(_innerKeyPad) - keyLength);
-            // coverity[OVERRUN] - False positive (#770): same reasoning as above for _outerKeyPad.
-            ::memset(&_outerKeyPad[keyLength], 0x5C, sizeof(_outerKeyPad) - keyLength);
+            ::memset(&innerKeyPad[keyLength], 0x36, sizeof(innerKeyPad) - keyLength);
+            // coverity[OVERRUN] - False positive (#770): same reasoning as above for outerKeyPad.
+            ::memset(&outerKeyPad[keyLength], 0x5C, sizeof(outerKeyPad) - keyLength);
 
             /* XOR key with inner keypad and outer key pad values */
             for (uint8_t index = 0; index < keyLength; index++) {
-                _innerKeyPad[index] = encryptionKey[index] ^ 0x36;
-                _outerKeyPad[index] = encryptionKey[index] ^ 0x5c;
+                innerKeyPad[index] = encryptionKey[index] ^ 0x36;
+                outerKeyPad[index] = encryptionKey[index] ^ 0x5c;
             }
 
+            // Absorb the pads once, from here on only the states are needed.
+            _algorithm.Reset();
+            _algorithm.Input(innerKeyPad, sizeof(innerKeyPad));
+            _schedule.Inner = _algorithm.CurrentContext();
+
+            _algorithm.Reset();
+            _algorithm.Input(outerKeyPad, sizeof(outerKeyPad));
+            _schedule.Outer = _algorithm.CurrentContext();
+
             // Reset the algorithm. We start from scratch..
             Reset();
         }
+        void Key(const Schedule& schedule) {
+            _schedule = schedule;
+
+            Reset();
+        }
+        inline const Schedule& KeySchedule() const
+        {
+            return (_schedule);
+        }
         inline static uint8_t BlockLength()
         {
-            return (sizeof(_innerKeyPad));
+            return (BlockSize);
         }
         void Reset()
         {
             _algorithm.Reset();
-            _algorithm.Input(_innerKeyPad, sizeof(_innerKeyPad));
+            _algorithm.Load(_schedule.Inner);
             _computed = false;
         }
         const uint8_t* Result()
@@ -106,7 +137,7 @@ namespace Crypto {
 
                 // Now use the newly generated key to calulate the outer value..
                 _algorithm.Reset();
-                _algorithm.Input(_outerKeyPad, sizeof(_outerKeyPad));
+                _algorithm.Load(_schedule.Outer);
                 _algorithm.Input(hashKey, sizeof(hashKey));
             }
 
@@ -142,9 +173,10 @@ namespace Crypto {
         }
 
     private:
+        static constexpr uint8_t BlockSize = 64;
+
         bool _computed;
-        uint8_t _innerKeyPad[64];
-        uint8_t _outerKeyPad[64];
+        Schedule _schedule;
         HASHALGORITHM _algorithm;
     };
 
@@ -49,6 +49,7 @@
         */
 
 #include "Hash.h"
+#include "Acceleration.h"
 
 #ifdef __LINUX__
 #include <arpa/inet.h>
@@ -533,24 +534,49 @@ namespace Crypto {
 
         ASSERT((_computed == false) || (_corrupted == false));
 
-        while (counter-- && !_corrupted) {
-            _context.block[_context.index++] = *current;
+        while ((counter > 0) && (_corrupted == false)) {
+            if ((_context.index == 0) && (counter >= 64)) {
+                /*
+                 * Block aligned, process all complete blocks straight from the input.
+                 * The length is a multiple of 64 here, so it wraps exactly on a block.
+                 */
+                const uint32_t blocks = (counter / 64);
+
+                for (uint32_t block = 0; block < blocks; block++) {
+                    lengthLow += 64;
+                    if (lengthLow == 0x20000000) {
+                        lengthLow = 0;
+                        lengthHigh++;
+                        if (lengthHigh == 0) {
+                            _corrupted = true; // Message is too long
+                        }
+                    }
+                }
+
+                ProcessMessageBlocks(current, blocks);
 
-            lengthLow++;
-            if (lengthLow == 0x20000000) {
-                lengthLow = 0;
-                lengthHigh++;
-                if (lengthHigh == 0) {
-                    _corrupted = true; // Message is too long
+                current += (blocks * 64);
+                counter -= static_cast<uint16_t>(blocks * 64);
+            } else {
+                _context.block[_context.index++] = *current;
+
+                lengthLow++;
+                if (lengthLow == 0x20000000) {
+                    lengthLow = 0;
+                    lengthHigh++;
+                    if (lengthHigh == 0) {
+                        _corrupted = true; // Message is too long
+                    }
                 }
-            }
 
-            if (_context.index == 64) {
-                ProcessMessageBlock();
-                _context.index = 0;
-            }
+                if (_context.index == 64) {
+                    ProcessMessageBlock();
+                    _context.index = 0;
+                }
 
-            current++;
+                current++;
+                counter--;
+            }
         }
 
         /*
@@ -633,6 +659,11 @@ namespace Crypto {
      *
      */
     void SHA1::ProcessMessageBlock()
+    {
+        ProcessMessageBlocks(_context.block, 1);
+    }
+
+    void SHA1::ProcessMessageBlocks(const uint8_t data[], const uint32_t blocks)
     {
         const unsigned K[] = { // Constants defined for SHA-1
             0x5A827999,
@@ -645,71 +676,94 @@ namespace Crypto {
         unsigned W[80]; // Word sequence
         unsigned A, B, C, D, E; // Word buffers
 
+        uint32_t state[5] = {
+            static_cast<uint32_t>(_context.h[0]),
+            static_cast<uint32_t>(_context.h[1]),
+            static_cast<uint32_t>(_context.h[2]),
+            static_cast<uint32_t>(_context.h[3]),
+            static_cast<uint32_t>(_context.h[4])
+        };
+
         /*
-         *  Initialize the first 16 words in the array W
+         *  Use the CPU crypto extensions if available, the code below is the fallback.
          */
-        for (t = 0; t < 16; t++) {
-            W[t] = ((unsigned)_context.block[t * 4]) << 24;
-            W[t] |= ((unsigned)_context.block[t * 4 + 1]) << 16;
-            W[t] |= ((unsigned)_context.block[t * 4 + 2]) << 8;
-            W[t] |= ((unsigned)_context.block[t * 4 + 3]);
-        }
+        const bool accelerated = Kernel::SHA1(state, data, blocks);
 
-        for (t = 16; t < 80; t++) {
-            W[t] = CircularShift(1, W[t - 3] ^ W[t - 8] ^ W[t - 14] ^ W[t - 16]);
+        if (accelerated == true) {
+            for (t = 0; t < 5; t++) {
+                _context.h[t] = state[t];
+            }
         }
 
-        A = static_cast<unsigned int>(_context.h[0]);
-        B = static_cast<unsigned int>(_context.h[1]);
-        C = static_cast<unsigned int>(_context.h[2]);
-        D = static_cast<unsigned int>(_context.h[3]);
-        E = static_cast<unsigned int>(_context.h[4]);
-
-        for (t = 0; t < 20; t++) {
-            temp = CircularShift(5, A) + ((B & C) | ((~B) & D)) + E + W[t] + K[0];
-            temp &= 0xFFFFFFFF;
-            E = D;
-            D = C;
-            C = CircularShift(30, B);
-            B = A;
-            A = temp;
-        }
+        for (uint32_t block = 0; (accelerated == false) && (block < blocks); block++) {
+            const uint8_t* message = &(data[block * 64]);
+
+            /*
+             *  Initialize the first 16 words in the array W
+             */
+            for (t = 0; t < 16; t++) {
+                W[t] = ((unsigned)message[t * 4]) << 24;
+                W[t] |= ((unsigned)message[t * 4 + 1]) << 16;
+                W[t] |= ((unsigned)message[t * 4 + 2]) << 8;
+                W[t] |= ((unsigned)message[t * 4 + 3]);
+            }
 
-        for (t = 20; t < 40; t++) {
-            temp = CircularShift(5, A) + (B ^ C ^ D) + E + W[t] + K[1];
-            temp &= 0xFFFFFFFF;
-            E = D;
-            D = C;
-            C = CircularShift(30, B);
-            B = A;
-            A = temp;
-        }
+            for (t = 16; t < 80; t++) {
+                W[t] = CircularShift(1, W[t - 3] ^ W[t - 8] ^ W[t - 14] ^ W[t - 16]);
+            }
 
-        for (t = 40; t < 60; t++) {
-            temp = CircularShift(5, A) + ((B & C) | (B & D) | (C & D)) + E + W[t] + K[2];
-            temp &= 0xFFFFFFFF;
-            E = D;
-            D = C;
-            C = CircularShift(30, B);
-            B = A;
-            A = temp;
-        }
+            A = static_cast<unsigned int>(_context.h[0]);
+            B = static_cast<unsigned int>(_context.h[1]);
+            C = static_cast<unsigned int>(_context.h[2]);
+            D = static_cast<unsigned int>(_context.h[3]);
+            E = static_cast<unsigned int>(_context.h[4]);
+
+            for (t = 0; t < 20; t++) {
+                temp = CircularShift(5, A) + ((B & C) | ((~B) & D)) + E + W[t] + K[0];
+                temp &= 0xFFFFFFFF;
+                E = D;
+                D = C;
+                C = CircularShift(30, B);
+                B = A;
+                A = temp;
+            }
 
-        for (t = 60; t < 80; t++) {
-            temp = CircularShift(5, A) + (B ^ C ^ D) + E + W[t] + K[3];
-            temp &= 0xFFFFFFFF;
-            E = D;
-            D = C;
-            C = CircularShift(30, B);
-            B = A;
-            A = temp;
-        }
+            for (t = 20; t < 40; t++) {
+                temp = CircularShift(5, A) + (B ^ C ^ D) + E + W[t] + K[1];
+                temp &= 0xFFFFFFFF;
+                E = D;
+                D = C;
+                C = CircularShift(30, B);
+                B = A;
+                A = temp;
+            }
+
+            for (t = 40; t < 60; t++) {
+                temp = CircularShift(5, A) + ((B & C) | (B & D) | (C & D)) + E + W[t] + K[2];
+                temp &= 0xFFFFFFFF;
+                E = D;
+                D = C;
+                C = CircularShift(30, B);
+                B = A;
+                A = temp;
+            }
 
-        _context.h[0] = (_context.h[0] + A) & 0xFFFFFFFF;
-        _context.h[1] = (_context.h[1] + B) & 0xFFFFFFFF;
-        _context.h[2] = (_context.h[2] + C) & 0xFFFFFFFF;
-        _context.h[3] = (_context.h[3] + D) & 0xFFFFFFFF;
-        _context.h[4] = (_context.h[4] + E) & 0xFFFFFFFF;
+            for (t = 60; t < 80; t++) {
+                temp = CircularShift(5, A) + (B ^ C ^ D) + E + W[t] + K[3];
+                temp &= 0xFFFFFFFF;
+                E = D;
+                D = C;
+                C = CircularShift(30, B);
+                B = A;
+                A = temp;
+            }
+
+            _context.h[0] = (_context.h[0] + A) & 0xFFFFFFFF;
+            _context.h[1] = (_context.h[1] + B) & 0xFFFFFFFF;
+            _context.h[2] = (_context.h[2] + C) & 0xFFFFFFFF;
+            _context.h[3] = (_context.h[3] + D) & 0xFFFFFFFF;
+            _context.h[4] = (_context.h[4] + E) & 0xFFFFFFFF;
+        }
     }
 
     /*
@@ -875,6 +929,25 @@ namespace Crypto {
     // --------------------------------------------------------------------------------------------
     // SHA256 functionality
     // --------------------------------------------------------------------------------------------
+    static bool sha256_accelerated(SHA256::Context* ctx, const unsigned char* message, const uint32_t blocks)
+    {
+        uint32_t state[8];
+
+        for (uint8_t index = 0; index < 8; index++) {
+            state[index] = static_cast<uint32_t>(ctx->h[index]);
+        }
+
+        const bool result = Kernel::SHA256(state, message, blocks);
+
+        if (result == true) {
+            for (uint8_t index = 0; index < 8; index++) {
+                ctx->h[index] = state[index];
+            }
+        }
+
+        return (result);
+    }
+
     static void sha256_trans_block(SHA256::Context* ctx, const unsigned char* message, unsigned int block_nb)
     {
         uint32_t w[64];
@@ -887,6 +960,11 @@ namespace Crypto {
         int j;
 #endif
 
+        // Use the CPU crypto extensions if available, the code below is the fallback.
+        if (sha256_accelerated(ctx, message, block_nb) == true) {
+            block_nb = 0;
+        }
+
         for (i = 0; i < (int)block_nb; i++) {
             sub_block = message + (i << 6);
 
@@ -1116,6 +1194,16 @@ namespace Crypto {
         ctx->h[7] += h;
     }
 
+    static void sha256_transform(SHA256::Context* ctx, const unsigned char* message, const uint32_t blocks)
+    {
+        // Use the CPU crypto extensions if available, the portable code is the fallback.
+        if (sha256_accelerated(ctx, message, blocks) == false) {
+            for (uint32_t index = 0; index < blocks; index++) {
+                sha256_trans(ctx, &message[index * SHA256_BLOCK_SIZE]);
+            }
+        }
+    }
+
     void SHA256::Reset()
     {
 #ifndef UNROLL_LOOPS
@@ -1141,15 +1229,25 @@ namespace Crypto {
 
     static void sha256_update(SHA256::Context* ctx, const unsigned char* message, unsigned int len)
     {
-        uint32_t i;
-
-        for (i = 0; i < len; ++i) {
-            ctx->block[ctx->index] = message[i];
-            ctx->index++;
-            if (ctx->index == 64) {
-                sha256_trans(ctx, ctx->block);
-                ctx->length += 512;
-                ctx->index = 0;
+        uint32_t i = 0;
+
+        while (i < len) {
+            if ((ctx->index == 0) && ((len - i) >= SHA256_BLOCK_SIZE)) {
+                // Block aligned, process all complete blocks straight from the input.
+                const uint32_t blocks = (len - i) / SHA256_BLOCK_SIZE;
+
+                sha256_transform(ctx, &message[i], blocks);
+                ctx->length += (512 * static_cast<uint64_t>(blocks));
+                i += (blocks * SHA256_BLOCK_SIZE);
+            } else {
+                ctx->block[ctx->index] = message[i];
+                ctx->index++;
+                if (ctx->index == 64) {
+                    sha256_transform(ctx, ctx->block, 1);
+                    ctx->length += 512;
+                    ctx->index = 0;
+                }
+                ++i;
             }
         }
     }
@@ -1169,7 +1267,7 @@ namespace Crypto {
             while (i < 64) {
                 _context.block[i++] = 0x00;
             }
-            sha256_trans(&_context, _context.block);
+            sha256_transform(&_context, _context.block, 1);
             memset(_context.block, 0, 56);
         }
 
@@ -1183,7 +1281,7 @@ namespace Crypto {
         _context.block[58] = static_cast<uint8_t>((_context.length >> 40) & 0xFF);
         _context.block[57] = static_cast<uint8_t>((_context.length >> 48) & 0xFF);
         _context.block[56] = static_cast<uint8_t>((_context.length >> 56) & 0xFF);
-        sha256_trans(&_context, _context.block);
+        sha256_transform(&_context, _context.block, 1);
 
         // Since this implementation uses little endian byte ordering and SHA uses big endian,
         // reverse all the bytes when copying the final h to the output hash.
@@ -1201,19 +1299,7 @@ namespace Crypto {
 
     void SHA256::Input(const uint8_t message_array[], const uint16_t length)
     {
-        uint16_t sizeToHandle = length;
-        const uint8_t* source = &message_array[0];
-
-        while (sizeToHandle > 0) {
-            if (sizeToHandle > SHA256_BLOCK_SIZE) {
-                sha256_update(&_context, source, SHA256_BLOCK_SIZE);
-                source += SHA256_BLOCK_SIZE;
-                sizeToHandle -= SHA256_BLOCK_SIZE;
-            } else {
-                sha256_update(&_context, source, sizeToHandle);
-                sizeToHandle = 0;
-            }
-        }
+        sha256_update(&_context, &message_array[0], length);
     }
 
     /*
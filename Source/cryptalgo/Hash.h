@@ -265,6 +265,11 @@ namespace Crypto {
          */
         void ProcessMessageBlock();
 
+        /*
+         *  Process a number of consecutive 512 bit blocks of the message
+         */
+        void ProcessMessageBlocks(const uint8_t data[], const uint32_t blocks);
+
         /*
          *  Pads the current message block to 512 bits
          */
@@ -24,6 +24,8 @@
 #endif
 
 #include "AES.h"
+#include "Acceleration.h"
+#include "FileHash.h"
 #include "HMAC.h"
 #include "Hash.h"
 #include "HashStream.h"
@@ -154,6 +154,20 @@ namespace Messaging {
         _adminLock.Unlock();
     }
 
+    /**
+     * @brief Get the overwrite and drop counters per module, summed over all instances
+     */
+    void MessageClient::Counters(MessageDataBuffer::Counters& counters) const
+    {
+        _adminLock.Lock();
+
+        for (auto& client : _clients) {
+            client.second.Counters(counters);
+        }
+
+        _adminLock.Unlock();
+    }
+
     /**
      * @brief Get list of currently announced message controls for a given module
      */
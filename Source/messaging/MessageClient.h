@@ -51,6 +51,7 @@ namespace Messaging {
         void Enable(const Core::Messaging::Metadata& metadata, const bool enable);
         void Modules(std::vector<string>& modules) const;
         void Controls(Messaging::MessageUnit::Iterator& controls, const string& module) const;
+        void Counters(MessageDataBuffer::Counters& counters) const;
 
         using MessageHandler = std::function<void(const Core::ProxyType<Core::Messaging::MessageInfo>&, const Core::ProxyType<Core::Messaging::IEvent>&)>;
         void PopMessagesAndCall(const MessageHandler& handler);
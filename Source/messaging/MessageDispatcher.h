@@ -65,58 +65,37 @@ namespace Messaging {
 
     class EXTERNAL MessageDataBuffer {
     private:
+        // Transparent huge pages come in 2MB units on all platforms we run on. A data buffer that
+        // should be huge page backed is rounded up, as a whole, to a multiple of this and every
+        // ring gets an equal number of whole pages (control included).
+        static constexpr uint32_t HugePageSize = 2 * 1024 * 1024;
+
         /**
-        * @brief Metdata Callback. First two arguments are for data in. Two later for data out (responded to the other side).
-        *        Third parameter is initially set to maximum length that can be written to the out buffer
+        * @brief One sub-ring of the data buffer, every entry is prefixed with its (16 bits) length.
+        *        Keeps track of the number of entries that got evicted to make room for new ones.
         */
         class DataBuffer : public Core::CyclicBuffer {
         public:
-            DataBuffer(const string& doorBell, const string& fileName, const uint32_t mode, const uint32_t bufferSize, const bool overwrite)
+            DataBuffer(const string& fileName, const uint32_t mode, const uint32_t bufferSize, const bool overwrite)
                 : CyclicBuffer(fileName, mode, bufferSize, overwrite)
-                , _doorBell(doorBell.c_str())
+                , _overwritten(0)
             {
             }
             ~DataBuffer() override = default;
 
             DataBuffer() = delete;
+            DataBuffer(DataBuffer&&) = delete;
             DataBuffer(const DataBuffer&) = delete;
+            DataBuffer& operator=(DataBuffer&&) = delete;
             DataBuffer& operator=(const DataBuffer&) = delete;
 
-            /**
-            * @brief Signal that data is available
-            */
-            void Ring() {
-                _doorBell.Ring();
-            }
-
-            /**
-            * @brief Wait for the doorbell and acknowledge if rang in given time
-            *
-            * @param waitTime how much should we wait for the doorbell
-            * @return uint32_t ERROR_UNAVAILABLE: doorbell is not connected to its counterpart
-            *                  ERROR_TIMEDOUT: ring not rang in given time
-            *                  ERROR_NONE: OK
-            */
-            uint32_t Wait(const uint32_t waitTime)
-            {
-                auto result = _doorBell.Wait(waitTime);
-                if (result != Core::ERROR_TIMEDOUT) {
-                    _doorBell.Acknowledge();
-                }
-
-                return (result);
-            }
-
-            void Relinquish() {
-                _doorBell.Relinquish();
-            }
-
             uint32_t GetOverwriteSize(Cursor& cursor) override
             {
                 while (cursor.Offset() < cursor.Size()) {
                     uint16_t chunkSize = 0;
                     cursor.Peek(chunkSize);
                     cursor.Forward(chunkSize);
+                    _overwritten++;
                 }
 
                 return (cursor.Offset());
@@ -132,15 +111,28 @@ namespace Messaging {
                 return (entrySize > sizeof(entrySize) ? entrySize - sizeof(entrySize) : 0);
             }
 
+            uint32_t Overwritten() const {
+                return (_overwritten);
+            }
+
             void Unlink() {
                 Core::CyclicBuffer::Unlink();
             }
 
         private:
-            Core::DoorBell _doorBell;
+            uint32_t _overwritten;
         };
 
+        using DataBuffers = std::vector< std::unique_ptr<DataBuffer> >;
+
     public:
+        struct Counter {
+            uint32_t Overwritten; // entries evicted from the modules ring to make room for its messages
+            uint32_t Dropped; // messages that did not fit in the modules ring at all
+        };
+
+        using Counters = std::map<string, Counter>;
+
         MessageDataBuffer(const MessageDataBuffer&) = delete;
         MessageDataBuffer& operator=(const MessageDataBuffer&) = delete;
 
@@ -150,48 +142,83 @@ namespace Messaging {
          * @param identifier name of the instance
          * @param instanceId number of the instance
          * @param baseDirectory where to place all the necessary files. This directory should exist before creating this class.
-         * @param dataSize size of the data buffer in bytes
+         * @param dataSize size of the data buffer in bytes, divided over all rings
          * @param socketPort triggers the use of using a IP socket in stead of a domain socket if the port value is not 0.
          * @param initialize true for the server side (creates the buffer), false for the client side (opens existing)
+         * @param rings number of sub-rings, modules are spread over them so a noisy one only evicts its neighbours
+         * @param hugePages size the rings to whole huge pages and advise the kernel to back them with huge pages,
+         *                  there are never more rings than pages in the rounded up data buffer
          */
-        MessageDataBuffer(const string& identifier, const uint32_t instanceId, const string& baseDirectory, const uint16_t dataSize, const uint16_t socketPort = 0, const bool initialize = false)
+        MessageDataBuffer(const string& identifier, const uint32_t instanceId, const string& baseDirectory, const uint32_t dataSize, const uint16_t socketPort = 0, const bool initialize = false, const uint8_t rings = 1, const bool hugePages = false)
             : _filenames(PrepareFilenames(baseDirectory, identifier, instanceId, socketPort))
             , _dataLock()
             , _initialize(initialize)
-            // clang-format off
-            , _dataBuffer(_filenames.doorBell, _filenames.data, Core::File::USER_READ    |
-                                                                Core::File::USER_WRITE   |
-                                                                Core::File::USER_EXECUTE |
-                                                                Core::File::GROUP_READ   |
-                                                                Core::File::GROUP_WRITE  |
-                                                                Core::File::OTHERS_READ  |
-                                                                Core::File::OTHERS_WRITE |
-                                                                Core::File::SHAREABLE,
-                                                                (initialize == true ? dataSize : 0), true)
-            // clang-format on
+            , _doorBell(_filenames.doorBell.c_str())
+            , _rings()
+            , _next(0)
+            , _counters()
         {
-            if (_dataBuffer.IsValid() == true) {
-                if ( (initialize == false) && (_dataBuffer.Used() > 0) ) {
-                    TRACE_L1("%d bytes already in the buffer instance %d", _dataBuffer.Used(), instanceId);
-                    _dataBuffer.Ring();
+            ASSERT(rings > 0);
+
+            uint8_t count = rings;
+            uint32_t ringSize = (initialize == true ? (dataSize / rings) : 0);
+
+            if (hugePages == true) {
+                // Both sides cap the rings the same way, the clients only open what the server created.
+                const uint32_t pages = std::max(static_cast<uint32_t>(1), (dataSize + HugePageSize - 1) / HugePageSize);
+
+                count = static_cast<uint8_t>(std::min(static_cast<uint32_t>(rings), pages));
+
+                if (ringSize != 0) {
+                    ringSize = ((pages / count) * HugePageSize) - sizeof(Core::CyclicBuffer::control);
                 }
             }
-            else {
-                if (initialize == false) {
-                    TRACE_L1("MessageDataBuffer instance %d (client) is not valid, probably because the server has not created a file yet", instanceId);
+
+            _rings.reserve(count);
+
+            for (uint8_t index = 0; index < count; index++) {
+                // clang-format off
+                _rings.emplace_back(new DataBuffer(RingName(index), Core::File::USER_READ    |
+                                                                    Core::File::USER_WRITE   |
+                                                                    Core::File::USER_EXECUTE |
+                                                                    Core::File::GROUP_READ   |
+                                                                    Core::File::GROUP_WRITE  |
+                                                                    Core::File::OTHERS_READ  |
+                                                                    Core::File::OTHERS_WRITE |
+                                                                    Core::File::SHAREABLE,
+                                                                    ringSize, true));
+                // clang-format on
+
+                DataBuffer& ring(*_rings.back());
+
+                if (ring.IsValid() == true) {
+                    if ((hugePages == true) && (ring.HugePages() == false)) {
+                        TRACE_L1("MessageDataBuffer instance %d ring %u can not be backed by huge pages", instanceId, index);
+                    }
+                    if ( (initialize == false) && (ring.Used() > 0) ) {
+                        TRACE_L1("%d bytes already in the buffer instance %d ring %u", ring.Used(), instanceId, index);
+                        _doorBell.Ring();
+                    }
                 }
                 else {
-                    TRACE_L1("MessageDataBuffer instance %d (server) is not valid, possible issues when creating a file", instanceId);
+                    if (initialize == false) {
+                        TRACE_L1("MessageDataBuffer instance %d (client) is not valid, probably because the server has not created a file yet", instanceId);
+                    }
+                    else {
+                        TRACE_L1("MessageDataBuffer instance %d (server) is not valid, possible issues when creating a file", instanceId);
+                    }
                 }
             }
         }
         ~MessageDataBuffer()
         {
-            _dataBuffer.Relinquish();
+            _doorBell.Relinquish();
 
             if (_initialize == true) {
                 _dataLock.Lock();
-                _dataBuffer.Unlink();
+                for (auto& ring : _rings) {
+                    ring->Unlink();
+                }
                 _dataLock.Unlock();
             }
         }
@@ -201,6 +228,10 @@ namespace Messaging {
             return (_filenames.data);
         }
 
+        inline uint8_t Rings() const {
+            return (static_cast<uint8_t>(_rings.size()));
+        }
+
         /**
         * @brief Writes data into cyclic buffer. After writing everything, this side should call Ring() to notify other side.
         *        To receive this data other side needs to wait for the doorbell ring and then use PopData
@@ -212,26 +243,48 @@ namespace Messaging {
         */
         uint32_t PushData(const uint16_t length, const uint8_t* value)
         {
-            uint32_t result = Core::ERROR_WRITE_ERROR;
-            const uint16_t fullLength = sizeof(length) + length; // headerLength + informationLength
+            _dataLock.Lock();
 
-            INTERNAL_ASSERT(length > 0);
-            INTERNAL_ASSERT(value != nullptr);
+            uint32_t result = Push(*_rings.front(), length, value);
 
+            _dataLock.Unlock();
+
+            return (result);
+        }
+
+        /**
+        * @brief Writes data of a module into the ring that module maps to and keeps track of the messages
+        *        lost (dropped or overwritten) on behalf of that module.
+        *
+        * @param module module the message originates from
+        * @param length length of message
+        * @param value buffer
+        * @return uint32_t ERROR_WRITE_ERROR: failed to reserve enough space - eg, value size is exceeding max cyclic buffer size
+        *                  ERROR_NONE: OK
+        */
+        uint32_t PushData(const string& module, const uint16_t length, const uint8_t* value)
+        {
             _dataLock.Lock();
 
-            if (_dataBuffer.IsValid() == true) {
-                const uint16_t reservedLength = _dataBuffer.Reserve(fullLength);
+            DataBuffer& ring(*_rings[_rings.size() == 1 ? 0 : (std::hash<string>()(module) % _rings.size())]);
+            const uint32_t overwritten = ring.Overwritten();
 
-                if (reservedLength >= fullLength) {
-                    //no need to serialize because we can write to CyclicBuffer step by step
-                    _dataBuffer.Write(reinterpret_cast<const uint8_t*>(&fullLength), sizeof(fullLength)); //fullLength
-                    _dataBuffer.Write(value, length); //value
-                    _dataBuffer.Ring();
-                    result = Core::ERROR_NONE;
+            uint32_t result = Push(ring, length, value);
+
+            if ((result != Core::ERROR_NONE) || (ring.Overwritten() != overwritten)) {
+                // Look up first, emplace allocates a node even if the module is already there.
+                Counters::iterator index(_counters.find(module));
+
+                if (index == _counters.end()) {
+                    index = _counters.emplace(std::piecewise_construct, std::forward_as_tuple(module), std::forward_as_tuple(Counter{ 0, 0 })).first;
                 }
-                else {
-                    TRACE_L1("Buffer to small to fit message!");
+
+                Counter& counter(index->second);
+
+                counter.Overwritten += (ring.Overwritten() - overwritten);
+
+                if (result != Core::ERROR_NONE) {
+                    counter.Dropped++;
                 }
             }
 
@@ -242,6 +295,7 @@ namespace Messaging {
 
         /**
          * @brief Read data after doorbell ringed. If buffer is too small to fit whole message it will be partially filled.
+         *        With multiple rings, the rings are visited round robin so a busy ring can not starve the others.
          *
          * @param outLength ERROR_NONE - read bytes.
          *                  ERROR_GENERAL - mimimal required bytes to fit whole message.
@@ -260,20 +314,30 @@ namespace Messaging {
 
             _dataLock.Lock();
 
-            if (_dataBuffer.IsValid() == true) {
-                const uint32_t length = _dataBuffer.Read(outValue, outLength, true);
+            for (uint8_t visited = 0; (visited < _rings.size()) && (result == Core::ERROR_READ_ERROR); visited++) {
+                DataBuffer& ring(*_rings[_next]);
 
-                if (length > 0) {
-                    if (length > outLength) {
-                        TRACE_L1("Lost part of the message");
-                        result = Core::ERROR_GENERAL;
-                    }
-                    else {
-                        result = Core::ERROR_NONE;
+                _next = static_cast<uint8_t>((_next + 1) % _rings.size());
+
+                if (ring.IsValid() == true) {
+                    const uint32_t length = ring.Read(outValue, outLength, true);
+
+                    if (length > 0) {
+                        if (length > outLength) {
+                            TRACE_L1("Lost part of the message");
+                            result = Core::ERROR_GENERAL;
+                        }
+                        else {
+                            result = Core::ERROR_NONE;
+                        }
+
+                        outLength = static_cast<uint16_t>(length);
                     }
                 }
+            }
 
-                outLength = length;
+            if ((result == Core::ERROR_READ_ERROR) && (IsValid() == true)) {
+                outLength = 0;
             }
 
             _dataLock.Unlock();
@@ -282,37 +346,109 @@ namespace Messaging {
         }
 
         void Ring() {
-            _dataBuffer.Ring();
+            _doorBell.Ring();
         }
 
         uint32_t Wait(const uint32_t waitTime) {
-            return (_dataBuffer.Wait(waitTime));
+            auto result = _doorBell.Wait(waitTime);
+            if (result != Core::ERROR_TIMEDOUT) {
+                _doorBell.Acknowledge();
+            }
+
+            return (result);
         }
 
         void FlushDataBuffer()
         {
             _dataLock.Lock();
             
-            if (_dataBuffer.IsValid() == true) {
-                _dataBuffer.Flush();
+            for (auto& ring : _rings) {
+                if (ring->IsValid() == true) {
+                    ring->Flush();
+                }
             }
 
             _dataLock.Unlock();
         }
 
         bool IsValid() const {
-            return (_dataBuffer.IsValid());
+            bool valid = true;
+
+            for (const auto& ring : _rings) {
+                valid = valid && ring->IsValid();
+            }
+
+            return (valid);
         }
 
         bool Validate() {
-            return (_dataBuffer.Open());
+            bool valid = true;
+
+            for (auto& ring : _rings) {
+                if (ring->IsValid() == false) {
+                    valid = ring->Open() && valid;
+                }
+            }
+
+            return (valid);
+        }
+
+        /**
+         * @brief Adds the overwrite and drop counters, per module, of everything pushed through this buffer.
+         */
+        void Statistics(Counters& counters) const
+        {
+            _dataLock.Lock();
+
+            for (const auto& entry : _counters) {
+                Counter& counter(counters.emplace(std::piecewise_construct, std::forward_as_tuple(entry.first), std::forward_as_tuple(Counter{ 0, 0 })).first->second);
+                counter.Overwritten += entry.second.Overwritten;
+                counter.Dropped += entry.second.Dropped;
+            }
+
+            _dataLock.Unlock();
+        }
+
+    private:
+        string RingName(const uint8_t index) const {
+            // The first ring keeps the name the (single) data buffer always had.
+            return (index == 0 ? _filenames.data : _filenames.data + '.' + Core::NumberType<uint8_t>(index).Text());
+        }
+
+        uint32_t Push(DataBuffer& ring, const uint16_t length, const uint8_t* value)
+        {
+            uint32_t result = Core::ERROR_WRITE_ERROR;
+            const uint16_t fullLength = sizeof(length) + length; // headerLength + informationLength
+
+            INTERNAL_ASSERT(length > 0);
+            INTERNAL_ASSERT(value != nullptr);
+
+            if (ring.IsValid() == true) {
+                const uint32_t reservedLength = ring.Reserve(fullLength);
+
+                if (reservedLength >= fullLength) {
+                    //no need to serialize because we can write to CyclicBuffer step by step
+                    ring.Write(reinterpret_cast<const uint8_t*>(&fullLength), sizeof(fullLength)); //fullLength
+                    ring.Write(value, length); //value
+                    _doorBell.Ring();
+                    result = Core::ERROR_NONE;
+                }
+                else {
+                    TRACE_L1("Buffer to small to fit message!");
+                }
+            }
+
+            return (result);
         }
 
     private:
         MessageFilenames _filenames;
         mutable Core::CriticalSection _dataLock;
         bool _initialize;
-        DataBuffer _dataBuffer;
+        Core::DoorBell _doorBell;
+        DataBuffers _rings;
+        uint8_t _next;
+        Counters _counters;
     };
 
 } // namespace Messaging 
@@ -0,0 +1,404 @@
+/*
+ * If not stated otherwise in this file or this component's LICENSE file the
+ * following copyright and licenses apply:
+ *
+ * Copyright 2020 Metrological
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "MessageSpool.h"
+
+#ifdef MESSAGING_LZ4
+#include <lz4.h>
+#endif
+
+namespace Thunder {
+
+namespace Messaging {
+
+    namespace {
+
+        constexpr uint32_t RecordRoom = MessageUnit::MaxMessageSize + sizeof(uint16_t);
+
+        constexpr uint32_t SegmentMode = Core::File::USER_READ | Core::File::USER_WRITE | Core::File::GROUP_READ | Core::File::SHAREABLE;
+
+#ifdef MESSAGING_LZ4
+        constexpr uint32_t CompressBound(const uint32_t size)
+        {
+            return (LZ4_COMPRESSBOUND(size));
+        }
+#else
+        constexpr uint32_t CompressBound(const uint32_t)
+        {
+            return (0);
+        }
+#endif
+
+    }
+
+    MessageSpool::MessageSpool(const string& path, const uint16_t segments, const uint32_t segmentSize, const uint16_t blockSize)
+        : _adminLock()
+        , _path(path)
+        , _segments(segments)
+        , _segmentSize(segmentSize)
+        , _blockSize(blockSize)
+        , _segment()
+        , _index(0)
+        , _sequence(0)
+        , _block(blockSize + RecordRoom)
+        , _compressed(CompressBound(blockSize + RecordRoom))
+        , _used(0)
+        , _header()
+    {
+        ASSERT(segments > 0);
+        ASSERT(segmentSize > (sizeof(SegmentHeader) + sizeof(BlockHeader)));
+    }
+
+    MessageSpool::~MessageSpool()
+    {
+        Close();
+    }
+
+    /* static */ uint64_t MessageSpool::Bit(const string& text)
+    {
+        // FNV-1a, it has to be stable between the writer and an (offline) reader.
+        uint32_t hash = 2166136261u;
+
+        for (const TCHAR character : text) {
+            hash = (hash ^ static_cast<uint8_t>(character)) * 16777619u;
+        }
+
+        return (static_cast<uint64_t>(1) << (hash & 0x3F));
+    }
+
+    /**
+     * @brief Continue after the most recently written segment of an earlier run, if any.
+     */
+    uint32_t MessageSpool::Open()
+    {
+        uint32_t result = Core::ERROR_NONE;
+
+        _adminLock.Lock();
+
+        if (_segment == nullptr) {
+            uint16_t index = 0;
+            uint32_t sequence = 0;
+            bool found = false;
+
+            Core::Directory(Core::File::PathName(_path).c_str()).CreatePath();
+
+            for (uint16_t segment = 0; segment < _segments; segment++) {
+                Core::DataElementFile file(SegmentName(segment), Core::File::USER_READ);
+
+                if ((file.IsValid() == true) && (file.Size() >= sizeof(SegmentHeader))) {
+                    const SegmentHeader* header = reinterpret_cast<const SegmentHeader*>(file.Buffer());
+
+                    if ((header->Magic == Magic) && ((found == false) || (header->Sequence > sequence))) {
+                        index = segment;
+                        sequence = header->Sequence;
+                        found = true;
+                    }
+                }
+            }
+
+            if (found == true) {
+                index = static_cast<uint16_t>((index + 1) % _segments);
+                sequence++;
+            }
+
+            result = Start(index, sequence);
+        }
+
+        _adminLock.Unlock();
+
+        return (result);
+    }
+
+    void MessageSpool::Close()
+    {
+        _adminLock.Lock();
+
+        if (_segment != nullptr) {
+            Commit();
+            _segment->Sync();
+            _segment.reset();
+        }
+
+        _adminLock.Unlock();
+    }
+
+    uint32_t MessageSpool::Append(const Core::Messaging::MessageInfo& info, const Core::Messaging::IEvent& message)
+    {
+        uint32_t result = Core::ERROR_ILLEGAL_STATE;
+
+        _adminLock.Lock();
+
+        if (_segment != nullptr) {
+            uint8_t* record = &(_block[_used + sizeof(uint16_t)]);
+            uint16_t length = info.Serialize(record, MessageUnit::MaxMessageSize);
+
+            if (length != 0) {
+                length += message.Serialize(&(record[length]), MessageUnit::MaxMessageSize - length);
+
+                ::memcpy(&(_block[_used]), &length, sizeof(length));
+                _used += sizeof(length) + length;
+
+                if (_header.Records == 0) {
+                    _header.First = info.TimeStamp();
+                    _header.Last = info.TimeStamp();
+                }
+                else {
+                    _header.First = std::min(_header.First, info.TimeStamp());
+                    _header.Last = std::max(_header.Last, info.TimeStamp());
+                }
+                _header.Modules |= Bit(info.Module());
+                _header.Categories |= Bit(info.Category());
+                _header.Records++;
+
+                result = Core::ERROR_NONE;
+
+                // Make sure the next record always fits.
+                if ((_used >= _blockSize) || ((_used + RecordRoom) > _block.size())) {
+                    result = Commit();
+                }
+            }
+            else {
+                result = Core::ERROR_WRITE_ERROR;
+            }
+        }
+
+        _adminLock.Unlock();
+
+        return (result);
+    }
+
+    uint32_t MessageSpool::Flush()
+    {
+        uint32_t result = Core::ERROR_ILLEGAL_STATE;
+
+        _adminLock.Lock();
+
+        if (_segment != nullptr) {
+            result = Commit();
+        }
+
+        _adminLock.Unlock();
+
+        return (result);
+    }
+
+    string MessageSpool::SegmentName(const uint16_t index) const
+    {
+        return (_path + '.' + Core::NumberType<uint16_t>(index).Text() + _T(".spool"));
+    }
+
+    uint32_t MessageSpool::Start(const uint16_t index, const uint32_t sequence)
+    {
+        uint32_t result = Core::ERROR_OPENING_FAILED;
+
+        _segment.reset(new Core::DataElementFile(SegmentName(index), SegmentMode | Core::File::CREATE, _segmentSize));
+
+        if ((_segment->IsValid() == true) && (_segment->Size() >= _segmentSize)) {
+            SegmentHeader* header = reinterpret_cast<SegmentHeader*>(_segment->Buffer());
+
+            header->Magic = Magic;
+            header->Version = Version;
+            header->Reserved = 0;
+            header->Sequence = sequence;
+            header->Used.store(sizeof(SegmentHeader), std::memory_order_release);
+
+            _index = index;
+            _sequence = sequence;
+            result = Core::ERROR_NONE;
+        }
+        else {
+            TRACE_L1("Could not create spool segment %s", SegmentName(index).c_str());
+            _segment.reset();
+        }
+
+        return (result);
+    }
+
+    uint32_t MessageSpool::Commit()
+    {
+        uint32_t result = Core::ERROR_NONE;
+
+        if (_header.Records > 0) {
+            const uint8_t* data = _block.data();
+
+            _header.Raw = _used;
+            _header.Compressed = _used;
+            _header.Codec = codec::STORED;
+
+#ifdef MESSAGING_LZ4
+            const int size = ::LZ4_compress_default(reinterpret_cast<const char*>(_block.data()), reinterpret_cast<char*>(_compressed.data()), static_cast<int>(_used), static_cast<int>(_compressed.size()));
+
+            if ((size > 0) && (static_cast<uint32_t>(size) < _used)) {
+                data = _compressed.data();
+                _header.Compressed = static_cast<uint32_t>(size);
+                _header.Codec = codec::LZ4;
+            }
+#endif
+
+            const uint32_t needed = sizeof(BlockHeader) + _header.Compressed;
+            SegmentHeader* segment = reinterpret_cast<SegmentHeader*>(_segment->Buffer());
+            uint32_t used = segment->Used.load(std::memory_order_relaxed);
+
+            if ((used + needed) > _segmentSize) {
+                // Full, move on to the next (and thus the oldest) segment.
+                _segment->Sync();
+
+                if (Start(static_cast<uint16_t>((_index + 1) % _segments), _sequence + 1) == Core::ERROR_NONE) {
+                    segment = reinterpret_cast<SegmentHeader*>(_segment->Buffer());
+                    used = segment->Used.load(std::memory_order_relaxed);
+                }
+                else {
+                    segment = nullptr;
+                }
+            }
+
+            if ((segment != nullptr) && ((used + needed) <= _segmentSize)) {
+                uint8_t* destination = &(_segment->Buffer()[used]);
+
+                ::memcpy(destination, &_header, sizeof(BlockHeader));
+                ::memcpy(&(destination[sizeof(BlockHeader)]), data, _header.Compressed);
+
+                // Only now the block becomes visible to readers, the release orders the copies above before it.
+                segment->Used.store(used + needed, std::memory_order_release);
+            }
+            else {
+                TRACE_L1("Spool block of %u bytes could not be stored", needed);
+                result = Core::ERROR_WRITE_ERROR;
+            }
+
+            _used = 0;
+            _header = BlockHeader();
+        }
+
+        return (result);
+    }
+
+    uint32_t MessageSpool::Reader::Read(const uint64_t from, const uint64_t to, const string& module, const string& category, const Handler& handler) const
+    {
+        using Segments = std::vector< std::pair<uint32_t, std::unique_ptr<Core::DataElementFile>> >;
+
+        const uint64_t moduleBit = (module.empty() == true ? 0 : MessageSpool::Bit(module));
+        const uint64_t categoryBit = (category.empty() == true ? 0 : MessageSpool::Bit(category));
+
+        Segments segments;
+        std::vector<uint8_t> inflated;
+        uint32_t count = 0;
+
+        // Segments get created in order, the first one missing ends the spool.
+        for (uint16_t index = 0; index < static_cast<uint16_t>(~0); index++) {
+            const string name(_path + '.' + Core::NumberType<uint16_t>(index).Text() + _T(".spool"));
+
+            if (Core::File(name).Exists() == false) {
+                break;
+            }
+
+            std::unique_ptr<Core::DataElementFile> file(new Core::DataElementFile(name, Core::File::USER_READ | Core::File::SHAREABLE));
+
+            if ((file->IsValid() == true) && (file->Size() >= sizeof(SegmentHeader))) {
+                const SegmentHeader* header = reinterpret_cast<const SegmentHeader*>(file->Buffer());
+
+                if ((header->Magic == Magic) && (header->Version == Version)) {
+                    segments.emplace_back(header->Sequence, std::move(file));
+                }
+            }
+        }
+
+        std::sort(segments.begin(), segments.end(), [](const Segments::value_type& lhs, const Segments::value_type& rhs) {
+            return (lhs.first < rhs.first);
+        });
+
+        for (const auto& entry : segments) {
+            const uint8_t* buffer = entry.second->Buffer();
+            const SegmentHeader* header = reinterpret_cast<const SegmentHeader*>(buffer);
+
+            // Pairs with the release in Commit(), every block counted is completely written.
+            const uint32_t used = static_cast<uint32_t>(std::min(static_cast<uint64_t>(header->Used.load(std::memory_order_acquire)), entry.second->Size()));
+            uint32_t offset = sizeof(SegmentHeader);
+
+            while ((offset + sizeof(BlockHeader)) <= used) {
+                BlockHeader block;
+                ::memcpy(&block, &(buffer[offset]), sizeof(block));
+
+                const uint8_t* data = &(buffer[offset + sizeof(BlockHeader)]);
+
+                if ((offset + sizeof(BlockHeader) + block.Compressed) > used) {
+                    break;
+                }
+
+                offset += sizeof(BlockHeader) + block.Compressed;
+
+                // The index: skip whatever can not hold anything we are looking for.
+                if ((block.Last < from) || (block.First > to) || ((block.Modules & moduleBit) != moduleBit) || ((block.Categories & categoryBit) != categoryBit)) {
+                    continue;
+                }
+
+                if (block.Codec == codec::STORED) {
+                    if (block.Compressed != block.Raw) {
+                        TRACE_L1("Corrupt spool block in segment %u", entry.first);
+                        continue;
+                    }
+                }
+                else {
+#ifdef MESSAGING_LZ4
+                    inflated.resize(block.Raw);
+
+                    if ((block.Codec != codec::LZ4) || (::LZ4_decompress_safe(reinterpret_cast<const char*>(data), reinterpret_cast<char*>(inflated.data()), static_cast<int>(block.Compressed), static_cast<int>(block.Raw)) != static_cast<int>(block.Raw))) {
+                        TRACE_L1("Corrupt spool block in segment %u", entry.first);
+                        continue;
+                    }
+
+                    data = inflated.data();
+#else
+                    TRACE_L1("Spool block in segment %u is compressed, this build can not decompress it", entry.first);
+                    continue;
+#endif
+                }
+
+                uint32_t position = 0;
+
+                while ((position + sizeof(uint16_t)) <= block.Raw) {
+                    uint16_t length;
+                    ::memcpy(&length, &(data[position]), sizeof(length));
+                    position += sizeof(length);
+
+                    if ((position + length) > block.Raw) {
+                        break;
+                    }
+
+                    const uint8_t* record = &(data[position]);
+                    Core::Messaging::MessageInfo info;
+
+                    if ((info.Deserialize(record, length) != 0) && (info.TimeStamp() >= from) && (info.TimeStamp() <= to) &&
+                        ((module.empty() == true) || (info.Module() == module)) &&
+                        ((category.empty() == true) || (info.Category() == category))) {
+
+                        handler(info, record, length);
+                        count++;
+                    }
+
+                    position += length;
+                }
+            }
+        }
+
+        return (count);
+    }
+
+} // namespace Messaging
+}
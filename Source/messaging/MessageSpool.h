@@ -0,0 +1,159 @@
+/*
+ * If not stated otherwise in this file or this component's LICENSE file the
+ * following copyright and licenses apply:
+ *
+ * Copyright 2020 Metrological
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include "Module.h"
+#include "MessageUnit.h"
+
+namespace Thunder {
+
+namespace Messaging {
+
+    /**
+     * @brief Persistent, compressed retention of messages as they leave the MessageClient.
+     *
+     *        Records are stored in their binary (MessageInfo + payload) form, exactly as they travel
+     *        through the data buffer, so nothing is formatted on the device. Records are gathered in
+     *        blocks, every block is compressed with LZ4 (if the build has it, otherwise it is stored as
+     *        is) and appended to one of a fixed number of memory mapped segment files
+     *        (<path>.<index>.spool). Once all segments are full, the oldest one is reused, so the flash
+     *        budget is (segments * segmentSize).
+     *
+     *        Every block is preceded by a header that holds its time range and a 64 bits filter of the
+     *        modules and categories in it. That is the (sparse) index: a Reader walks the headers and
+     *        only decompresses the blocks that can hold records of interest.
+     */
+    class EXTERNAL MessageSpool {
+    public:
+        static constexpr uint16_t DefaultSegments = 8;
+        static constexpr uint32_t DefaultSegmentSize = 1024 * 1024;
+        static constexpr uint16_t DefaultBlockSize = 16 * 1024;
+
+        enum codec : uint32_t {
+            STORED = 0,
+            LZ4 = 1
+        };
+
+        struct SegmentHeader {
+            uint32_t Magic;
+            uint16_t Version;
+            uint16_t Reserved;
+            uint32_t Sequence; // order in which the segments got written
+            std::atomic<uint32_t> Used; // bytes in use, this header included, a block is complete once it is counted here
+        };
+
+        struct BlockHeader {
+            uint32_t Compressed; // bytes that follow, equal to Raw if the block is stored as is
+            uint32_t Raw;
+            uint32_t Records;
+            uint32_t Codec;
+            uint64_t First; // timestamp of the oldest record
+            uint64_t Last; // timestamp of the youngest record
+            uint64_t Modules; // one bit per module hash
+            uint64_t Categories; // one bit per category hash
+        };
+
+        static constexpr uint32_t Magic = 0x4C4F5053; // "SPOL"
+        static constexpr uint16_t Version = 2;
+
+        /**
+         * @brief Offline (or concurrent) access to a spool, written by a MessageSpool on the same path.
+         */
+        class EXTERNAL Reader {
+        public:
+            // Record handler: the generic part of the record is decoded, the full record (the same bytes as
+            // PopMessagesAndCall deserializes through its factories) is passed along for the details.
+            using Handler = std::function<void(const Core::Messaging::MessageInfo& info, const uint8_t record[], const uint16_t length)>;
+
+            Reader() = delete;
+            Reader(Reader&&) = delete;
+            Reader(const Reader&) = delete;
+            Reader& operator=(Reader&&) = delete;
+            Reader& operator=(const Reader&) = delete;
+
+            explicit Reader(const string& path)
+                : _path(path)
+            {
+            }
+            ~Reader() = default;
+
+        public:
+            /**
+             * @brief Report all records in the range [from, to] (timestamps), oldest segment first.
+             *
+             * @param module only records of this module, all modules if empty
+             * @param category only records of this category, all categories if empty
+             * @return uint32_t number of records reported
+             */
+            uint32_t Read(const uint64_t from, const uint64_t to, const string& module, const string& category, const Handler& handler) const;
+
+        private:
+            const string _path;
+        };
+
+    public:
+        MessageSpool() = delete;
+        MessageSpool(MessageSpool&&) = delete;
+        MessageSpool(const MessageSpool&) = delete;
+        MessageSpool& operator=(MessageSpool&&) = delete;
+        MessageSpool& operator=(const MessageSpool&) = delete;
+
+        MessageSpool(const string& path, const uint16_t segments = DefaultSegments, const uint32_t segmentSize = DefaultSegmentSize, const uint16_t blockSize = DefaultBlockSize);
+        ~MessageSpool();
+
+    public:
+        bool IsOpen() const {
+            return (_segment != nullptr);
+        }
+
+        uint32_t Open();
+        void Close();
+
+        /**
+         * @brief Add a message, typically from the MessageClient::PopMessagesAndCall handler. The record is
+         *        buffered until its block is full, use Flush() to force it out.
+         */
+        uint32_t Append(const Core::Messaging::MessageInfo& info, const Core::Messaging::IEvent& message);
+        uint32_t Flush();
+
+        static uint64_t Bit(const string& text);
+
+    private:
+        string SegmentName(const uint16_t index) const;
+        uint32_t Start(const uint16_t index, const uint32_t sequence);
+        uint32_t Commit();
+
+    private:
+        mutable Core::CriticalSection _adminLock;
+        const string _path;
+        const uint16_t _segments;
+        const uint32_t _segmentSize;
+        const uint16_t _blockSize;
+        std::unique_ptr<Core::DataElementFile> _segment;
+        uint16_t _index;
+        uint32_t _sequence;
+        std::vector<uint8_t> _block;
+        std::vector<uint8_t> _compressed;
+        uint32_t _used;
+        BlockHeader _header;
+    };
+
+} // namespace Messaging
+}
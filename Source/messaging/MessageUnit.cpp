@@ -129,6 +129,46 @@ ENUM_CONVERSION_END(Thunder::Core::Messaging::OutputMode)
             return (writer.Offset());
         }
 
+        uint16_t MessageUnit::SerializeCounters(uint8_t* buffer, const uint16_t length) const
+        {
+            MessageDataBuffer::Counters counters;
+
+            _adminLock.Lock();
+            if (_dataBuffer != nullptr) {
+                _dataBuffer->Statistics(counters);
+            }
+            _adminLock.Unlock();
+
+            Core::FrameType<0> frame(buffer, length, length);
+            Core::FrameType<0>::Writer writer(frame, 0);
+
+            uint16_t count = 0;
+            uint16_t offset = sizeof(count);
+
+            // First determine how many entries fit, the count leads the list.
+            for (const auto& entry : counters) {
+                const uint16_t size = static_cast<uint16_t>(entry.first.length() + 1 + (2 * sizeof(uint32_t)));
+
+                if ((offset + size) > length) {
+                    TRACE_L1("Counters are cut, not enough memory to fit all modules (MetadataBufferSize too small)");
+                    break;
+                }
+
+                offset += size;
+                count++;
+            }
+
+            writer.Number<uint16_t>(count);
+
+            for (auto it = counters.cbegin(); count > 0; ++it, --count) {
+                writer.NullTerminatedText(it->first);
+                writer.Number<uint32_t>(it->second.Overwritten);
+                writer.Number<uint32_t>(it->second.Dropped);
+            }
+
+            return (writer.Offset());
+        }
+
         void MessageUnit::Update(const Core::Messaging::Metadata& control, const bool enable)
         {
             class Handler : public Core::Messaging::IControl::IHandler {
@@ -240,7 +280,7 @@ ENUM_CONVERSION_END(Thunder::Core::Messaging::OutputMode)
             if ((_metaDataBuffer != nullptr) && (_metaDataBuffer->IsOpen() == true)) {
 
                 if (_settings.DataSize() != 0) {
-                    _dataBuffer.reset(new MessageDataBuffer(identifier, 0, _settings.BasePath().c_str(), _settings.DataSize(), _settings.SocketPort(), true));
+                    _dataBuffer.reset(new MessageDataBuffer(identifier, 0, _settings.BasePath().c_str(), _settings.DataSize(), _settings.SocketPort(), true, _settings.DataRings(), _settings.HasHugePages()));
                     ASSERT(_dataBuffer != nullptr);
                 }
 
@@ -252,11 +292,12 @@ ENUM_CONVERSION_END(Thunder::Core::Messaging::OutputMode)
                 // let all announced controls know, whether they should push messages
                 Update();
 
-                TRACE_L1("Messaging transport initialized: controls(metadata)=%s [buffer=%u], messages(data)=%s [buffer=%u], directOutput=%s",
+                TRACE_L1("Messaging transport initialized: controls(metadata)=%s [buffer=%u], messages(data)=%s [buffer=%u, rings=%u], directOutput=%s",
                     (_settings.MetadataBufferSize() == 0 ? _T("disabled") : _T("enabled")),
                     static_cast<unsigned>(_settings.MetadataBufferSize()),
                     (_settings.DataSize() == 0 ? _T("disabled") : _T("enabled")),
                     static_cast<unsigned>(_settings.DataSize()),
+                    static_cast<unsigned>(_settings.DataRings()),
                     (_settings.IsDirect() ? _T("true") : _T("false")));
 
                 // Redirect the standard out and standard error if requested
@@ -301,7 +342,7 @@ ENUM_CONVERSION_END(Thunder::Core::Messaging::OutputMode)
                 if ((_metaDataBuffer != nullptr) && (_metaDataBuffer->IsOpen() == true)) {
 
                     if (_settings.DataSize() != 0) {
-                        _dataBuffer.reset(new MessageDataBuffer(_settings.Identifier(), instanceId, _settings.BasePath(), _settings.DataSize(), _settings.SocketPort(), true));
+                        _dataBuffer.reset(new MessageDataBuffer(_settings.Identifier(), instanceId, _settings.BasePath(), _settings.DataSize(), _settings.SocketPort(), true, _settings.DataRings(), _settings.HasHugePages()));
                         ASSERT(_dataBuffer != nullptr);
                     }
 
@@ -394,7 +435,7 @@ ENUM_CONVERSION_END(Thunder::Core::Messaging::OutputMode)
                     if (length != 0) {
                         length += message->Serialize(serializationBuffer + length, messageSize - length);
 
-                        if (_dataBuffer->PushData(length, serializationBuffer) != Core::ERROR_NONE) {
+                        if (_dataBuffer->PushData(messageInfo.Module(), length, serializationBuffer) != Core::ERROR_NONE) {
                             TRACE_L1("Unable to push message data!");
                         }
                     }
@@ -409,5 +450,94 @@ ENUM_CONVERSION_END(Thunder::Core::Messaging::OutputMode)
                 }
             }
         }
+
+        MessageUnit::CallSite::CallSite(const Core::Messaging::Metadata& metadata, const string& fileName, const uint16_t lineNumber, const string& className)
+            : _information(Core::Messaging::MessageInfo(metadata, 0), fileName, lineNumber, className)
+            , _serialized(sizeof(Core::Messaging::Metadata::type) + (metadata.Category().size() + 1) + (metadata.Module().size() + 1) + sizeof(uint64_t)
+                          + (className.size() + 1) + (fileName.size() + 1) + sizeof(lineNumber))
+            , _timeStampOffset(0)
+        {
+            ASSERT(metadata.Type() == Core::Messaging::Metadata::type::TRACING);
+
+            if (_serialized.size() <= static_cast<uint16_t>(~0)) {
+                // The time stamp directly follows the metadata.
+                _timeStampOffset = _information.Core::Messaging::Metadata::Serialize(_serialized.data(), Length());
+
+                if (_information.Serialize(_serialized.data(), Length()) != Length()) {
+                    _serialized.clear();
+                }
+            }
+            else {
+                _serialized.clear();
+            }
+        }
+
+        const MessageUnit::CallSite& MessageUnit::CallSites::Create(const std::type_info& type)
+        {
+            _adminLock.Lock();
+
+            Sites::iterator index(_sites.find(std::type_index(type)));
+
+            if (index == _sites.end()) {
+                index = _sites.emplace(std::type_index(type), std::unique_ptr<CallSite>(new CallSite(_metadata, _fileName, _lineNumber, Core::ClassNameOnly(type.name()).Text()))).first;
+
+                if (_first.load(std::memory_order_relaxed) == nullptr) {
+                    // The type goes first, readers only look at it once they see the site.
+                    _firstType = &type;
+                    _first.store(index->second.get(), std::memory_order_release);
+                }
+            }
+
+            const CallSite& result(*(index->second));
+
+            _adminLock.Unlock();
+
+            return (result);
+        }
+
+        /**
+        * @brief Push a trace of a call site: the prepared information, completed with the time stamp and the text.
+        */
+        void MessageUnit::Push(const CallSite& site, const uint64_t timeStamp, const char text[], Core::Messaging::OutputMode outputMode)
+        {
+            const bool sendDirect    = (outputMode == Core::Messaging::OutputMode::DIRECT) || (outputMode == Core::Messaging::OutputMode::ALL);
+            const bool sendToHandler = (outputMode == Core::Messaging::OutputMode::HANDLER) || (outputMode == Core::Messaging::OutputMode::ALL);
+
+            if ((sendDirect == true) || ((sendToHandler == true) && (_dataBuffer == nullptr))) {
+                // Printed right here, so the information is completed the regular way.
+                Core::Messaging::IStore::Tracing information(site.Information());
+                information.TimeStamp(timeStamp);
+
+                const Core::Messaging::TextMessage message(text);
+                _direct.Output(information, &message);
+            }
+
+            if ((sendToHandler == true) && (_dataBuffer != nullptr)) {
+                const uint16_t messageSize = _settings.MessageSize();
+                ASSERT(messageSize != 0);
+
+                if ((site.Length() != 0) && (site.Length() < messageSize)) {
+                    uint8_t* serializationBuffer = static_cast<uint8_t*>(ALLOCA(messageSize));
+
+                    ::memcpy(serializationBuffer, site.Data(), site.Length());
+
+                    Core::FrameType<0> frame(&(serializationBuffer[site.TimeStampOffset()]), sizeof(timeStamp), sizeof(timeStamp));
+                    Core::FrameType<0>::Writer frameWriter(frame, 0);
+                    frameWriter.Number(timeStamp);
+
+                    // Laid out as a TextMessage, cut to what is left of the message.
+                    const uint16_t textLength = static_cast<uint16_t>(std::min(::strlen(text), static_cast<size_t>(messageSize - site.Length() - 1)));
+                    ::memcpy(&(serializationBuffer[site.Length()]), text, textLength);
+                    serializationBuffer[site.Length() + textLength] = '\0';
+
+                    if (_dataBuffer->PushData(site.Information().Module(), static_cast<uint16_t>(site.Length() + textLength + 1), serializationBuffer) != Core::ERROR_NONE) {
+                        TRACE_L1("Unable to push message data!");
+                    }
+                }
+                else {
+                    TRACE_L1("Unable to push data, buffer is too small!");
+                }
+            }
+        }
     } // namespace Messaging
 }
@@ -23,6 +23,7 @@
 #include "MessageDispatcher.h"
 #include "TraceFactory.h"
 #include "DirectOutput.h"
+#include <typeindex>
 
 namespace Thunder {
 
@@ -44,23 +45,25 @@ namespace Thunder {
         public:
             static constexpr uint16_t MaxMetadataBufferSize = 16 * 1024;
             static constexpr uint16_t MaxMetadataSize = 256;
-            static constexpr uint16_t MaxDataBufferSize = 63 * 1024;
+            static constexpr uint32_t MaxDataBufferSize = 16 * 1024 * 1024;
             static constexpr uint16_t MaxMessageSize = 32 * 1024;
+            static constexpr uint8_t MaxDataRings = 16;
 
             static constexpr uint16_t DefaultMetadataBufferSize = (MaxMetadataBufferSize / 4);
             static constexpr uint16_t DefaultMetadataSize = (MaxMetadataSize / 4);
-            static constexpr uint16_t DefaultDataBufferSize = (MaxDataBufferSize / 4);
+            static constexpr uint32_t DefaultDataBufferSize = ((63 * 1024) / 4);
             static constexpr uint16_t DefaultMessageSize = (MaxMessageSize / 4);
 
             static constexpr uint16_t MinMetadataBufferSize = (DefaultMetadataBufferSize / 4);
             static constexpr uint16_t MinMetadataSize = (DefaultMetadataSize / 4);
-            static constexpr uint16_t MinDataBufferSize = (DefaultDataBufferSize / 4);
+            static constexpr uint32_t MinDataBufferSize = (DefaultDataBufferSize / 4);
             static constexpr uint16_t MinMessageSize = (DefaultMessageSize / 4);
 
             enum metadataFrameProtocol : uint8_t {
                 UPDATE      = 0,
                 CONTROLS    = 1,
-                MODULES     = 2
+                MODULES     = 2,
+                COUNTERS    = 3
             };
 
             enum flush : uint8_t {
@@ -71,6 +74,90 @@ namespace Thunder {
 
             using OutputMode = Core::Messaging::OutputMode;
 
+            // The trace information of a single TRACE statement, serialized once when the statement
+            // is first hit. Per message only the time stamp and the text are added.
+            class EXTERNAL CallSite {
+            public:
+                CallSite() = delete;
+                CallSite(CallSite&&) = delete;
+                CallSite(const CallSite&) = delete;
+                CallSite& operator=(CallSite&&) = delete;
+                CallSite& operator=(const CallSite&) = delete;
+
+                CallSite(const Core::Messaging::Metadata& metadata, const string& fileName, const uint16_t lineNumber, const string& className);
+                ~CallSite() = default;
+
+            public:
+                const Core::Messaging::IStore::Tracing& Information() const {
+                    return (_information);
+                }
+                const uint8_t* Data() const {
+                    return (_serialized.data());
+                }
+                uint16_t Length() const {
+                    return (static_cast<uint16_t>(_serialized.size()));
+                }
+                uint16_t TimeStampOffset() const {
+                    return (_timeStampOffset);
+                }
+
+            private:
+                const Core::Messaging::IStore::Tracing _information;
+                std::vector<uint8_t> _serialized;
+                uint16_t _timeStampOffset;
+            };
+
+            // The call sites of a TRACE statement in a member function, one for every class (dynamic type)
+            // it ran for, so the class name is demangled once per class. The first class seen is looked up
+            // without taking a lock, that is the only one most statements ever see.
+            class EXTERNAL CallSites {
+            private:
+                using Sites = std::unordered_map<std::type_index, std::unique_ptr<CallSite>>;
+
+            public:
+                CallSites() = delete;
+                CallSites(CallSites&&) = delete;
+                CallSites(const CallSites&) = delete;
+                CallSites& operator=(CallSites&&) = delete;
+                CallSites& operator=(const CallSites&) = delete;
+
+                CallSites(const Core::Messaging::Metadata& metadata, const string& fileName, const uint16_t lineNumber)
+                    : _adminLock()
+                    , _metadata(metadata)
+                    , _fileName(fileName)
+                    , _lineNumber(lineNumber)
+                    , _firstType(nullptr)
+                    , _first(nullptr)
+                    , _sites()
+                {
+                }
+                ~CallSites() = default;
+
+            public:
+                const CallSite& Site(const std::type_info& type)
+                {
+                    const CallSite* site = _first.load(std::memory_order_acquire);
+
+                    if ((site == nullptr) || (*_firstType != type)) {
+                        site = &Create(type);
+                    }
+
+                    return (*site);
+                }
+
+            private:
+                const CallSite& Create(const std::type_info& type);
+
+            private:
+                Core::CriticalSection _adminLock;
+                const Core::Messaging::Metadata _metadata;
+                const string _fileName;
+                const uint16_t _lineNumber;
+                const std::type_info* _firstType;
+                std::atomic<const CallSite*> _first;
+                Sites _sites;
+            };
+
             class EXTERNAL Buffer : public Core::IPC::BufferType<static_cast<uint16_t>(~0)> {
             public:
                 Buffer()
@@ -296,7 +383,8 @@ namespace Thunder {
                     DIRECT         = 0x02,
                     ABBREVIATED    = 0x04,
                     REDIRECT_OUT   = 0x08,
-                    REDIRECT_ERROR = 0x10
+                    REDIRECT_ERROR = 0x10,
+                    HUGE_PAGES     = 0x20
                 };
 
             public:
@@ -422,6 +510,8 @@ namespace Thunder {
                         , Out(true)
                         , Error(true)
                         , DataSize(MessageUnit::DefaultDataBufferSize)
+                        , DataRings(1)
+                        , HugePages(false)
                         , MetadataBufferSize(MessageUnit::DefaultMetadataBufferSize)
                         , MetadataSize(MessageUnit::DefaultMetadataSize)
                         , MessageSize(MessageUnit::DefaultMessageSize)
@@ -437,6 +527,8 @@ namespace Thunder {
                         Add(_T("stdout"), &Out);
                         Add(_T("stderr"), &Error);
                         Add(_T("datasize"), &DataSize);
+                        Add(_T("datarings"), &DataRings);
+                        Add(_T("hugepages"), &HugePages);
                         Add(_T("metadatabuffersize"), &MetadataBufferSize);
                         Add(_T("metadatasize"), &MetadataSize);
                         Add(_T("messagesize"), &MessageSize);
@@ -456,7 +548,9 @@ namespace Thunder {
                     Core::JSON::Boolean Flush;
                     Core::JSON::Boolean Out;
                     Core::JSON::Boolean Error;
-                    Core::JSON::DecUInt16 DataSize;
+                    Core::JSON::DecUInt32 DataSize;
+                    Core::JSON::DecUInt8 DataRings;
+                    Core::JSON::Boolean HugePages;
                     Core::JSON::DecUInt16 MetadataBufferSize;
                     Core::JSON::DecUInt16 MetadataSize;
                     Core::JSON::DecUInt16 MessageSize;
@@ -475,6 +569,7 @@ namespace Thunder {
                     , _permission(0)
                     , _mode(static_cast<mode>(0))
                     , _dataSize()
+                    , _dataRings(1)
                     , _metadataBufferSize()
                     , _metadataSize()
                     , _messageSize()
@@ -495,10 +590,18 @@ namespace Thunder {
                     return (_socketPort);
                 }
 
-                uint16_t DataSize() const {
+                uint32_t DataSize() const {
                     return (_dataSize);
                 }
 
+                uint8_t DataRings() const {
+                    return (_dataRings);
+                }
+
+                bool HasHugePages() const {
+                    return ((_mode & mode::HUGE_PAGES) != 0);
+                }
+
                 uint16_t Permission() const {
                     return (_permission);
                 }
@@ -557,6 +660,7 @@ namespace Thunder {
                             (((flushMode != flush::OFF) || (jsonParsed.Flush.Value())) ? mode::DIRECT : 0) | 
                             (flushMode == flush::FLUSH_ABBREVIATED ? mode::ABBREVIATED : 0) |
                             (jsonParsed.Error.Value() ? mode::REDIRECT_ERROR : 0) |
+                            (jsonParsed.HugePages.Value() ? mode::HUGE_PAGES : 0) |
                             (jsonParsed.Out.IsSet() ? (jsonParsed.Out.Value() ? mode::REDIRECT_OUT : 0) : (background ? mode::REDIRECT_OUT : 0));
 
                     _metadataBufferSize = jsonParsed.MetadataBufferSize.Value();
@@ -615,6 +719,20 @@ namespace Thunder {
                             _dataSize = MessageUnit::MinDataBufferSize;
                             ASSERT(false);
                         }
+
+                        _dataRings = jsonParsed.DataRings.Value();
+                        if (_dataRings > MessageUnit::MaxDataRings) {
+                            TRACE_L1("DataRings (%u) exceeds maximum (%u)! Using maximum instead.", _dataRings, MessageUnit::MaxDataRings);
+                            _dataRings = MessageUnit::MaxDataRings;
+                        }
+                        else if (_dataRings == 0) {
+                            _dataRings = 1;
+                        }
+
+                        // Every ring should at least be able to hold a minimal data buffer.
+                        while ((_dataRings > 1) && ((_dataSize / _dataRings) < MessageUnit::MinDataBufferSize)) {
+                            _dataRings--;
+                        }
                     }
                 }
 
@@ -768,8 +886,8 @@ namespace Thunder {
                     string settings = _path + DELIMITER +
                                _identifier + DELIMITER +
                                Core::NumberType<uint16_t>(_socketPort).Text() + DELIMITER +
-                               Core::NumberType<uint8_t>(_mode & (mode::BACKGROUND|mode::DIRECT|mode::ABBREVIATED)).Text() + DELIMITER +
-                               Core::NumberType<uint16_t>(_dataSize).Text() + DELIMITER +
+                               Core::NumberType<uint8_t>(_mode & (mode::BACKGROUND|mode::DIRECT|mode::ABBREVIATED|mode::HUGE_PAGES)).Text() + DELIMITER +
+                               Core::NumberType<uint32_t>(_dataSize).Text() + DELIMITER +
                                Core::NumberType<uint16_t>(_metadataBufferSize).Text() + DELIMITER +
                                Core::NumberType<uint16_t>(_metadataSize).Text() + DELIMITER +
                                Core::NumberType<uint16_t>(_messageSize).Text();
@@ -785,6 +903,10 @@ namespace Thunder {
                                     DELIMITER + Core::NumberType<uint8_t>(static_cast<uint8_t>(entry.Routing().Value())).Text();
                     }
 
+                    // Fields added later are appended behind the controls, a reader that does not
+                    // know them sees an incomplete control and skips it.
+                    settings += DELIMITER + Core::NumberType<uint8_t>(_dataRings).Text();
+
                     Core::SystemInfo::SetEnvironment(MESSAGE_DISPATCHER_CONFIG_ENV, settings, true);
                 }
 
@@ -799,6 +921,7 @@ namespace Thunder {
                     _socketPort = 0;
                     _mode = 0;
                     _dataSize = 0;
+                    _dataRings = 1;
                     _metadataBufferSize = 0;
                     _metadataSize = 0;
                     _messageSize = 0;
@@ -813,7 +936,7 @@ namespace Thunder {
                                 if (iterator.Next() == true) {
                                     _mode = Core::NumberType<uint8_t>(iterator.Current()).Value();
                                     if (iterator.Next() == true) {
-                                        _dataSize = Core::NumberType<uint16_t>(iterator.Current()).Value();
+                                        _dataSize = Core::NumberType<uint32_t>(iterator.Current()).Value();
                                         if (iterator.Next() == true) {
                                             _metadataBufferSize = Core::NumberType<uint16_t>(iterator.Current()).Value();
                                             if (iterator.Next() == true) {
@@ -862,6 +985,10 @@ namespace Thunder {
                                 }
                             }
                         }
+                        else {
+                            // Not a control, but the trailing fields: dataRings
+                            _dataRings = std::max(type, static_cast<uint8_t>(1));
+                        }
                     }
                 }
 
@@ -964,7 +1091,8 @@ namespace Thunder {
                 uint16_t _socketPort;
                 uint16_t _permission;
                 uint8_t _mode;
-                uint16_t _dataSize;
+                uint32_t _dataSize;
+                uint8_t _dataRings;
                 uint16_t _metadataBufferSize;
                 uint16_t _metadataSize;
                 uint16_t _messageSize;
@@ -985,9 +1113,9 @@ namespace Thunder {
                 {
                     ASSERT(MessageUnit::Instance()._settings.MetadataBufferSize() != 0);
 
-                    const uint16_t dataSize = MessageUnit::Instance()._settings.DataSize();
-                    if (dataSize != 0) {
-                        _dataBuffer.reset(new MessageDataBuffer(identifier, instanceId, baseDirectory, dataSize, socketPort, false));
+                    const Settings& settings = MessageUnit::Instance()._settings;
+                    if (settings.DataSize() != 0) {
+                        _dataBuffer.reset(new MessageDataBuffer(identifier, instanceId, baseDirectory, settings.DataSize(), socketPort, false, settings.DataRings(), settings.HasHugePages()));
                     }
 
                     _channel.Open(Core::infinite);
@@ -1159,6 +1287,42 @@ namespace Thunder {
                     }
                 }
 
+                void Counters(MessageDataBuffer::Counters& counters) const
+                {
+                    if (_channel.IsOpen() == true) {
+                        Core::ProxyType<MetadataFrame> metaDataFrame(Core::ProxyType<MetadataFrame>::Create());
+
+                        uint8_t buffer[1];
+                        Core::FrameType<0> frame(buffer, sizeof(buffer), sizeof(buffer));
+                        Core::FrameType<0>::Writer writer(frame, 0);
+
+                        writer.Number<metadataFrameProtocol>(metadataFrameProtocol::COUNTERS);
+
+                        metaDataFrame->Parameters().Set(writer.Offset(), buffer);
+
+                        uint32_t result = _channel.Invoke(metaDataFrame, Core::infinite);
+
+                        if (result == Core::ERROR_NONE) {
+                            uint16_t bufferSize = metaDataFrame->Response().Length();
+                            const uint8_t* buffer = metaDataFrame->Response().Value();
+
+                            Core::FrameType<0> frame(const_cast<uint8_t*>(buffer), bufferSize, bufferSize);
+                            Core::FrameType<0>::Reader reader(frame, 0);
+
+                            uint16_t iterator = (reader.HasData() == true ? reader.Number<uint16_t>() : 0);
+
+                            while (iterator > 0) {
+                                const string module = reader.NullTerminatedText();
+                                MessageDataBuffer::Counter& counter(counters.emplace(std::piecewise_construct, std::forward_as_tuple(module), std::forward_as_tuple(MessageDataBuffer::Counter{ 0, 0 })).first->second);
+
+                                counter.Overwritten += reader.Number<uint32_t>();
+                                counter.Dropped += reader.Number<uint32_t>();
+                                --iterator;
+                            }
+                        }
+                    }
+                }
+
             private:
                 MessageFilenames _filenames;
                 std::unique_ptr<MessageDataBuffer> _dataBuffer;
@@ -1215,6 +1379,10 @@ namespace Thunder {
                             uint16_t length = _parent.Serialize(outBuffer, metadataBufferSize);
                             message->Response().Set(length, outBuffer);
                         }
+                        else if (protocol == metadataFrameProtocol::COUNTERS) {
+                            uint16_t length = _parent.SerializeCounters(outBuffer, metadataBufferSize);
+                            message->Response().Set(length, outBuffer);
+                        }
                         else {
                             ASSERT(false);
                         }
@@ -1286,7 +1454,7 @@ namespace Thunder {
                 return (_settings.SocketPort());
             }
 
-            uint16_t DataSize() const {
+            uint32_t DataSize() const {
                 return (_settings.DataSize());
             }
 
@@ -1301,10 +1469,15 @@ namespace Thunder {
             bool Default(const Core::Messaging::Metadata& control) const override;
             Core::Messaging::OutputMode DefaultOutput(const Core::Messaging::Metadata& metadata) const override;
             void Push(const Core::Messaging::MessageInfo& messageInfo, const Core::Messaging::IEvent* message, Core::Messaging::OutputMode outputMode) override;
+            void Push(const CallSite& site, const uint64_t timeStamp, const char text[], Core::Messaging::OutputMode outputMode);
+            void Push(const CallSite& site, const uint64_t timeStamp, const string& text, Core::Messaging::OutputMode outputMode) {
+                Push(site, timeStamp, text.c_str(), outputMode);
+            }
 
         private:
             uint16_t Serialize(uint8_t* buffer, const uint16_t length, const string& module);
             uint16_t Serialize(uint8_t* buffer, const uint16_t length);
+            uint16_t SerializeCounters(uint8_t* buffer, const uint16_t length) const;
             void Update(const Core::Messaging::Metadata& control, const bool enable);
             void Update();
 
@@ -20,9 +20,12 @@
 #pragma once
 
 #include "Module.h"
+#include "Control.h"
+#include "MessageUnit.h"
 
 #ifdef _THUNDER_PRODUCTION
 
+#define TRACE_CATEGORY_BUILD(CATEGORY, ENABLED)
 #define TRACE_CONTROL(CATEGORY)
 #define TRACE_ENABLED(CATEGORY)
 #define TRACE(CATEGORY, PARAMETERS)
@@ -32,27 +35,91 @@
 
 #elif defined(__CORE_MESSAGING__)
 
-#define TRACE_CONTROL(CATEGORY) Thunder::Messaging::LocalLifetimeType<CATEGORY, &Thunder::Core::System::MODULE_NAME, Thunder::Core::Messaging::Metadata::type::TRACING>
+namespace Thunder {
+
+namespace Messaging {
+
+    // Trace categories that are built in. By default these are all categories, with THUNDER_TRACE_ALLOWLIST
+    // only the ones marked with TRACE_CATEGORY_BUILD(CATEGORY, true). Traces of categories that are not
+    // built in compile to nothing, and do not show up as a control either.
+    template <typename CATEGORY>
+    struct TraceBuild {
+#ifdef THUNDER_TRACE_ALLOWLIST
+        static constexpr bool Enabled = false;
+#else
+        static constexpr bool Enabled = true;
+#endif
+    };
+
+    // Stands in for the control of a category that is not built in.
+    class DisabledLifetimeType {
+    public:
+        DisabledLifetimeType() = delete;
+        DisabledLifetimeType(const DisabledLifetimeType&) = delete;
+        DisabledLifetimeType& operator=(const DisabledLifetimeType&) = delete;
+
+    public:
+        static void Announce() {
+        }
+
+        static constexpr bool IsEnabled() {
+            return (false);
+        }
+
+        static void Enable(const bool) {
+        }
+
+        static Core::Messaging::OutputMode Routing() {
+            return (Core::Messaging::OutputMode::HANDLER);
+        }
+
+        static const Core::Messaging::Metadata& Metadata() {
+            static const Core::Messaging::Metadata metadata;
+            return (metadata);
+        }
+    };
+
+    template <typename CATEGORY, const char** MODULENAME>
+    using TraceControlType = typename std::conditional<TraceBuild<CATEGORY>::Enabled,
+        LocalLifetimeType<CATEGORY, MODULENAME, Core::Messaging::Metadata::type::TRACING>,
+        DisabledLifetimeType>::type;
+
+} // namespace Messaging
+}
+
+// To be used in the global namespace.
+#define TRACE_CATEGORY_BUILD(CATEGORY, ENABLED)                                         \
+    namespace Thunder {                                                                 \
+    namespace Messaging {                                                               \
+        template <>                                                                     \
+        struct TraceBuild<CATEGORY> {                                                   \
+            static constexpr bool Enabled = ENABLED;                                    \
+        };                                                                              \
+    }                                                                                   \
+    }
+
+#define TRACE_CONTROL(CATEGORY) Thunder::Messaging::TraceControlType<CATEGORY, &Thunder::Core::System::MODULE_NAME>
 
 #define TRACE_ENABLED(CATEGORY) TRACE_CONTROL(CATEGORY)::IsEnabled()
 
+// The trace information of a call site is prepared once per class it runs for (the dynamic type of this),
+// per message only the text and time stamp are added.
 #define TRACE(CATEGORY, PARAMETERS)                                                     \
     do {                                                                                \
         using __control__ = TRACE_CONTROL(CATEGORY);                                    \
         if (__control__::IsEnabled() == true) {                                         \
-            CATEGORY __data__ PARAMETERS;                                               \
-            Thunder::Core::Messaging::MessageInfo __info__(                             \
+            static Thunder::Messaging::MessageUnit::CallSites __sites__(                 \
                 __control__::Metadata(),                                                \
-                Thunder::Core::Time::Now().Ticks()                                      \
-            );                                                                          \
-            Thunder::Core::Messaging::IStore::Tracing __trace__(                        \
-                __info__,                                                               \
                 __FILE__,                                                               \
-                __LINE__,                                                               \
-                Thunder::Core::ClassNameOnly(typeid(*this).name()).Text()               \
+                __LINE__                                                                \
+            );                                                                          \
+            CATEGORY __data__ PARAMETERS;                                               \
+            Thunder::Messaging::MessageUnit::Instance().Push(                           \
+                __sites__.Site(typeid(*this)),                                          \
+                Thunder::Core::Time::Now().Ticks(),                                     \
+                __data__.Data(),                                                        \
+                __control__::Routing()                                                  \
             );                                                                          \
-            Thunder::Core::Messaging::TextMessage __message__(__data__.Data());         \
-            Thunder::Messaging::MessageUnit::Instance().Push(__trace__, &__message__, __control__::Routing());  \
         }                                                                               \
     } while(false)
 
@@ -60,19 +127,19 @@
     do {                                                                                \
         using __control__ = TRACE_CONTROL(CATEGORY);                                    \
         if (__control__::IsEnabled() == true) {                                         \
-            CATEGORY __data__ PARAMETERS;                                               \
-            Thunder::Core::Messaging::MessageInfo __info__(                             \
+            static const Thunder::Messaging::MessageUnit::CallSite __site__(            \
                 __control__::Metadata(),                                                \
-                Thunder::Core::Time::Now().Ticks()                                      \
-            );                                                                          \
-            Thunder::Core::Messaging::IStore::Tracing __trace__(                        \
-                __info__,                                                               \
                 __FILE__,                                                               \
                 __LINE__,                                                               \
                 __FUNCTION__                                                            \
             );                                                                          \
-            Thunder::Core::Messaging::TextMessage __message__(__data__.Data());         \
-            Thunder::Messaging::MessageUnit::Instance().Push(__trace__, &__message__, __control__::Routing());  \
+            CATEGORY __data__ PARAMETERS;                                               \
+            Thunder::Messaging::MessageUnit::Instance().Push(                           \
+                __site__,                                                               \
+                Thunder::Core::Time::Now().Ticks(),                                     \
+                __data__.Data(),                                                        \
+                __control__::Routing()                                                  \
+            );                                                                          \
         }                                                                               \
     } while(false)
 
@@ -92,6 +159,8 @@
 
 #else
 
+#define TRACE_CATEGORY_BUILD(CATEGORY, ENABLED)
+
 #define TRACE_CONTROL(CATEGORY)
 
 #define TRACE_ENABLED(CATEGORY) true
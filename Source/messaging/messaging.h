@@ -31,6 +31,7 @@
 
 #ifdef __CORE_MESSAGING__
 #include "MessageClient.h"
+#include "MessageSpool.h"
 #include "DirectOutput.h"
 #include "TraceFactory.h"
 #include "ConsoleStreamRedirect.h"
@@ -242,7 +242,7 @@ namespace Controller {
         };
     };
 
-    // @json 1.0.0 @text:legacy_lowercase
+    // @json 1.1.0 @text:legacy_lowercase
     struct EXTERNAL IMetadata : virtual public Core::IUnknown {
         enum { ID = RPC::ID_CONTROLLER_METADATA };
 
@@ -328,6 +328,14 @@ namespace Controller {
                 Core::OptionalType<string> Name /* @brief Name of the connection */;
             };
 
+            struct Queue {
+                uint32_t Id /* @brief A unique number identifying the connection */;
+                uint32_t Queued /* @brief Number of requests waiting for a free slot on this connection */;
+                uint32_t Shed /* @brief Number of requests dropped or rejected because the queue of this connection was full */;
+                uint32_t WaitMedian /* @brief Median time (in us) requests waited in the queue */;
+                uint32_t WaitTail /* @brief 99th percentile of the time (in us) requests waited in the queue */;
+            };
+
             struct Service {
                 enum state : uint16_t {
                     UNAVAILABLE = PluginHost::IShell::UNAVAILABLE,
@@ -375,6 +383,7 @@ namespace Controller {
             using ILinksIterator = RPC::IIteratorType<Data::Link, RPC::ID_CONTROLLER_METADATA_LINKS_ITERATOR>;
             using IProxiesIterator = RPC::IIteratorType<Data::Proxy, RPC::ID_CONTROLLER_METADATA_PROXIES_ITERATOR>;
             using IServicesIterator = RPC::IIteratorType<Data::Service, RPC::ID_CONTROLLER_METADATA_SERVICES_ITERATOR>;
+            using IQueuesIterator = RPC::IIteratorType<Data::Queue, RPC::ID_CONTROLLER_METADATA_QUEUES_ITERATOR>;
         };
 
         // @property @alt:deprecated status
@@ -410,6 +419,11 @@ namespace Controller {
         // @property
         // @brief Build information
         virtual Core::hresult BuildInfo(Data::BuildInfo& buildInfo /* @out */) const = 0;
+
+        // @property
+        // @brief Request queues of the connections that are throttled
+        // @details Only connections with requests waiting or executing, or that had requests shed, are listed.
+        virtual Core::hresult Queues(Data::IQueuesIterator*& queues /* @out */) const = 0;
     };
 
 } // namespace Controller
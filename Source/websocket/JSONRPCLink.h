@@ -87,6 +87,7 @@ namespace Thunder {
 
                     FactoryImpl()
                         : _jsonRPCFactory(2)
+                        , _batchFactory(1)
                         , _watchDog(Core::Thread::DefaultStackSize(), _T("JSONRPCCleaner"))
                     {
                     }
@@ -109,6 +110,23 @@ namespace Thunder {
                     {
                         return (_jsonRPCFactory.Element());
                     }
+                    Core::ProxyType<INTERFACE> Element(const uint8_t stream[], const uint16_t length)
+                    {
+                        Core::ProxyType<INTERFACE> result;
+
+                        bool batch = (std::is_same<INTERFACE, Core::JSON::IMessagePack>::value == true
+                            ? Core::JSONRPC::Batch::IsPackedBatch(stream, length)
+                            : Core::JSONRPC::Batch::IsBatch(stream, length));
+
+                        if (batch == true) {
+                            result = Core::ProxyType<INTERFACE>(_batchFactory.Element());
+                        }
+                        else {
+                            result = Core::ProxyType<INTERFACE>(_jsonRPCFactory.Element());
+                        }
+
+                        return (result);
+                    }
                     void Trigger(const uint64_t& time, LinkType<INTERFACE>* client)
                     {
                         _watchDog.Trigger(time, client);
@@ -120,6 +138,7 @@ namespace Thunder {
 
                 private:
                     Core::ProxyPoolType<Core::JSONRPC::Message> _jsonRPCFactory;
+                    Core::ProxyPoolType<Core::JSONRPC::Batch> _batchFactory;
                     Core::TimerType<WatchDog> _watchDog;
                 };
 
@@ -143,11 +162,25 @@ namespace Thunder {
                     {
                         Core::ProxyType<Core::JSONRPC::Message> inbound(jsonObject);
 
-                        ASSERT(inbound.IsValid() == true);
-
                         if (inbound.IsValid() == true) {
                             _parent.Inbound(inbound);
                         }
+                        else {
+                            // The responses to a batch come in as one array, hand them out one by one.
+                            Core::ProxyType<Core::JSONRPC::Batch> batch(jsonObject);
+
+                            ASSERT(batch.IsValid() == true);
+
+                            if (batch.IsValid() == true) {
+                                Core::JSONRPC::Batch::Iterator index(batch->Elements());
+
+                                while (index.Next() == true) {
+                                    Core::ProxyType<Core::JSONRPC::Message> member(CommunicationChannel::Message());
+                                    member->Assign(index.Current());
+                                    _parent.Inbound(member);
+                                }
+                            }
+                        }
                     }
                     virtual void Send(Core::ProxyType<INTERFACE>& jsonObject VARIABLE_IS_NOT_USED) override
                     {
@@ -169,24 +202,18 @@ namespace Thunder {
                 private:
                     void ToMessage(const Core::ProxyType<Core::JSON::IElement>& jsonObject, string& message) const
                     {
-                        Core::ProxyType<Core::JSONRPC::Message> inbound(jsonObject);
+                        ASSERT(jsonObject.IsValid() == true);
 
-                        ASSERT(inbound.IsValid() == true);
-                        if (inbound.IsValid() == true) {
-                            inbound->ToString(message);
-                        }
+                        jsonObject->ToString(message);
                     }
                     void ToMessage(const Core::ProxyType<Core::JSON::IMessagePack>& jsonObject, string& message) const
                     {
-                        Core::ProxyType<Core::JSONRPC::Message> inbound(jsonObject);
+                        ASSERT(jsonObject.IsValid() == true);
 
-                        ASSERT(inbound.IsValid() == true);
-                        if (inbound.IsValid() == true) {
-                            std::vector<uint8_t> values;
-                            inbound->ToBuffer(values);
-                            if (values.empty() != true) {
-                                Core::ToString(values.data(), static_cast<uint16_t>(values.size()), false, message);
-                            }
+                        std::vector<uint8_t> values;
+                        jsonObject->ToBuffer(values);
+                        if (values.empty() != true) {
+                            Core::ToString(values.data(), static_cast<uint16_t>(values.size()), false, message);
                         }
                     }
 
@@ -515,6 +542,191 @@ namespace Thunder {
                     HandlerMap _invokeMap;
             };
 
+            class Outcome {
+            public:
+                Outcome(Outcome&&) = delete;
+                Outcome(const Outcome&) = delete;
+                Outcome& operator=(Outcome&&) = delete;
+                Outcome& operator=(const Outcome&) = delete;
+
+                Outcome()
+                    : _signal(false, true)
+                    , _response()
+                {
+                }
+                ~Outcome() = default;
+
+            public:
+                void Set(const Core::JSONRPC::Message& response)
+                {
+                    _response.Assign(response);
+                    _signal.SetEvent();
+                }
+                void Set(const uint32_t errorCode)
+                {
+                    _response.Error.Code = errorCode;
+                    _signal.SetEvent();
+                }
+                bool IsSet() const
+                {
+                    return (_signal.IsSet());
+                }
+                uint32_t Wait(const uint32_t waitTime)
+                {
+                    return (_signal.Lock(waitTime));
+                }
+                const Core::JSONRPC::Message& Response() const
+                {
+                    return (_response);
+                }
+
+            private:
+                Core::Event _signal;
+                Core::JSONRPC::Message _response;
+            };
+
+        public:
+            // Handle on the outcome of a call that was sent without waiting for the
+            // answer, so many calls can be in flight on the same connection. Copies
+            // share the outcome. An expired or aborted call completes with an error.
+            class Future {
+            public:
+                Future()
+                    : _outcome()
+                {
+                }
+                Future(const Core::ProxyType<Outcome>& outcome)
+                    : _outcome(outcome)
+                {
+                }
+                Future(Future&&) = default;
+                Future(const Future&) = default;
+                Future& operator=(Future&&) = default;
+                Future& operator=(const Future&) = default;
+                ~Future() = default;
+
+            public:
+                bool IsValid() const
+                {
+                    return (_outcome.IsValid());
+                }
+                bool IsReady() const
+                {
+                    return ((_outcome.IsValid() == true) && (_outcome->IsSet() == true));
+                }
+                uint32_t Wait(const uint32_t waitTime) const
+                {
+                    return (_outcome.IsValid() == false ? Core::ERROR_UNAVAILABLE : _outcome->Wait(waitTime));
+                }
+                const Core::JSONRPC::Message& Response() const
+                {
+                    ASSERT(IsReady() == true);
+
+                    return (_outcome->Response());
+                }
+                uint32_t Get() const
+                {
+                    uint32_t result = Wait(Core::infinite);
+
+                    if ((result == Core::ERROR_NONE) && (Response().Error.IsSet() == true)) {
+                        result = Response().Error.Code.Value();
+                    }
+
+                    return (result);
+                }
+                template <typename RESPONSE>
+                uint32_t Get(RESPONSE& response) const
+                {
+                    uint32_t result = Get();
+
+                    if ((result == Core::ERROR_NONE) && (Response().Result.IsSet() == true) && (Response().Result.Value().empty() == false)) {
+                        FromMessage((INTERFACE*)&response, Response());
+                    }
+
+                    return (result);
+                }
+
+            private:
+                Core::ProxyType<Outcome> _outcome;
+            };
+
+            // Collects calls that are sent out together as one JSON-RPC 2.0 batch, so a
+            // burst of requests costs a single frame each way. Every member completes on
+            // its own, through its Future or callback, also when Submit fails. After
+            // Submit the batch is empty and can be filled again.
+            class Batch {
+            public:
+                Batch() = delete;
+                Batch(Batch&&) = delete;
+                Batch(const Batch&) = delete;
+                Batch& operator=(Batch&&) = delete;
+                Batch& operator=(const Batch&) = delete;
+
+                explicit Batch(LinkType<INTERFACE>& link)
+                    : _link(link)
+                    , _message(Core::ProxyType<Core::JSONRPC::Batch>::Create())
+                    , _entries()
+                {
+                }
+                ~Batch() = default;
+
+            public:
+                uint16_t Length() const
+                {
+                    return (static_cast<uint16_t>(_entries.size()));
+                }
+                Future Add(const string& method)
+                {
+                    string emptyString(EMPTY_STRING);
+                    return (Add<string>(method, emptyString));
+                }
+                template <typename PARAMETERS>
+                Future Add(const string& method, const PARAMETERS& parameters)
+                {
+                    Core::ProxyType<Outcome> outcome(Core::ProxyType<Outcome>::Create());
+
+                    Add<PARAMETERS>(method, parameters, [outcome](const Core::JSONRPC::Message& response) {
+                        outcome->Set(response);
+                    });
+
+                    return (Future(outcome));
+                }
+                template <typename PARAMETERS>
+                void Add(const string& method, const PARAMETERS& parameters, const std::function<void(const Core::JSONRPC::Message&)>& completed)
+                {
+                    // Without a channel the id is irrelevant, Submit fails every entry.
+                    uint32_t id = (_link._channel.IsValid() == true ? _link._channel->Sequence() : 0);
+
+                    _link.ToMessage(parameters, _link.Prepare(_message->Add(), id, method));
+                    _entries.emplace_back(id, completed);
+                }
+                uint32_t Submit(const uint32_t waitTime)
+                {
+                    uint32_t result = _link.Send(waitTime, _message, _entries);
+
+                    if (result != Core::ERROR_NONE) {
+                        // Nothing went out, so nothing will ever answer, report the failure to every entry.
+                        for (const std::pair<uint32_t, CallbackFunction>& entry : _entries) {
+                            Core::JSONRPC::Message message;
+                            message.Id = entry.first;
+                            message.Error.Code = result;
+                            message.Error.Text = _T("Batch could not be sent");
+                            entry.second(message);
+                        }
+                    }
+
+                    _message = Core::ProxyType<Core::JSONRPC::Batch>::Create();
+                    _entries.clear();
+
+                    return (result);
+                }
+
+            private:
+                LinkType<INTERFACE>& _link;
+                Core::ProxyType<Core::JSONRPC::Batch> _message;
+                std::vector<std::pair<uint32_t, CallbackFunction>> _entries;
+            };
+
         protected:
             static constexpr uint32_t DefaultWaitTime = 10000;
 
@@ -757,6 +969,28 @@ namespace Thunder {
                     callback,
                     objectPtr));
             }
+            Future Request(const uint32_t waitTime, const string& method)
+            {
+                string emptyString(EMPTY_STRING);
+                return (Request<string>(waitTime, method, emptyString));
+            }
+            template <typename PARAMETERS>
+            Future Request(const uint32_t waitTime, const string& method, const PARAMETERS& parameters)
+            {
+                Core::ProxyType<Outcome> outcome(Core::ProxyType<Outcome>::Create());
+
+                CallbackFunction implementation = [outcome](const Core::JSONRPC::Message& response) -> void {
+                    outcome->Set(response);
+                };
+
+                uint32_t result = Send(waitTime, method, parameters, implementation);
+
+                if (result != Core::ERROR_NONE) {
+                    outcome->Set(result);
+                }
+
+                return (Future(outcome));
+            }
             template <typename PARAMETERS, typename... TYPES>
             uint32_t Set(const uint32_t waitTime, const string& method, const TYPES&&... args)
             {
@@ -1019,14 +1253,7 @@ namespace Thunder {
 
                     Core::ProxyType<Core::JSONRPC::Message> message(CommunicationChannel::Message());
                     uint32_t id = _channel->Sequence();
-                    message->Id = id;
-                    if (_callsign.empty() == false) {
-                        message->Designator = _callsign + _versionstring + '.' + method;
-                    }
-                    else {
-                        message->Designator = method;
-                    }
-                    ToMessage(parameters, message);
+                    ToMessage(parameters, Prepare(*message, id, method));
 
                     _adminLock.Lock();
 
@@ -1083,14 +1310,7 @@ namespace Thunder {
 
                     Core::ProxyType<Core::JSONRPC::Message> message(CommunicationChannel::Message());
                     uint32_t id = _channel->Sequence();
-                    message->Id = id;
-                    if (_callsign.empty() == false) {
-                        message->Designator = _callsign + _versionstring + '.' + method;
-                    }
-                    else {
-                        message->Designator = method;
-                    }
-                    ToMessage(parameters, message);
+                    ToMessage(parameters, Prepare(*message, id, method));
 
                     _adminLock.Lock();
 
@@ -1120,6 +1340,48 @@ namespace Thunder {
                 }
                 return (result);
             }
+            uint32_t Send(const uint32_t waitTime, const Core::ProxyType<Core::JSONRPC::Batch>& batch, const std::vector<std::pair<uint32_t, CallbackFunction>>& entries)
+            {
+                uint32_t result = Core::ERROR_UNAVAILABLE;
+
+                if ((_channel.IsValid() == true) && (_channel->IsSuspended() == true)) {
+                    result = Core::ERROR_ASYNC_FAILED;
+                }
+                else if (entries.empty() == true) {
+                    result = Core::ERROR_NONE;
+                }
+                else if (_channel.IsValid() == true) {
+                    uint64_t expiry = 0;
+
+                    _adminLock.Lock();
+
+                    for (const std::pair<uint32_t, CallbackFunction>& entry : entries) {
+                        typename std::pair<typename PendingMap::iterator, bool> newElement = _pendingQueue.emplace(std::piecewise_construct,
+                            std::forward_as_tuple(entry.first),
+                            std::forward_as_tuple(waitTime, entry.second));
+                        ASSERT(newElement.second == true);
+
+                        if (newElement.second == true) {
+                            expiry = newElement.first->second.Expiry();
+                        }
+                    }
+
+                    _adminLock.Unlock();
+
+                    _channel->Submit(Core::ProxyType<INTERFACE>(batch));
+
+                    result = Core::ERROR_NONE;
+
+                    _adminLock.Lock();
+                    if ((expiry != 0) && ((_scheduledTime == 0) || (_scheduledTime > expiry))) {
+                        _scheduledTime = expiry;
+                        CommunicationChannel::Trigger(_scheduledTime, this);
+                    }
+                    _adminLock.Unlock();
+                }
+
+                return (result);
+            }
             uint32_t Inbound(const Core::ProxyType<Core::JSONRPC::Message>& inbound)
             {
                 uint32_t result = Core::ERROR_INVALID_SIGNATURE;
@@ -1172,42 +1434,53 @@ namespace Thunder {
             }
 
         private:
-            void ToMessage(const string& parameters, Core::ProxyType<Core::JSONRPC::Message>& message) const
+            Core::JSONRPC::Message& Prepare(Core::JSONRPC::Message& message, const uint32_t id, const string& method) const
+            {
+                message.Id = id;
+                if (_callsign.empty() == false) {
+                    message.Designator = _callsign + _versionstring + '.' + method;
+                }
+                else {
+                    message.Designator = method;
+                }
+                return (message);
+            }
+            void ToMessage(const string& parameters, Core::JSONRPC::Message& message) const
             {
                 if (parameters.empty() != true) {
-                    message->Parameters = parameters;
+                    message.Parameters = parameters;
                 }
             }
             template <typename PARAMETERS>
-            void ToMessage(PARAMETERS& parameters, Core::ProxyType<Core::JSONRPC::Message>& message) const
+            void ToMessage(PARAMETERS& parameters, Core::JSONRPC::Message& message) const
             {
                 ToMessage((INTERFACE*)(&parameters), message);
                 return;
             }
-            void ToMessage(Core::JSON::IMessagePack* parameters, Core::ProxyType<Core::JSONRPC::Message>& message) const
+            void ToMessage(Core::JSON::IMessagePack* parameters, Core::JSONRPC::Message& message) const
             {
                 std::vector<uint8_t> values;
                 parameters->ToBuffer(values);
                 if (values.empty() != true) {
                     string strValues(values.begin(), values.end());
-                    message->Parameters = strValues;
+                    message.Parameters = strValues;
                 }
                 return;
             }
-            void ToMessage(Core::JSON::IElement* parameters, Core::ProxyType<Core::JSONRPC::Message>& message) const
+            void ToMessage(Core::JSON::IElement* parameters, Core::JSONRPC::Message& message) const
             {
                 string values;
                 parameters->ToString(values);
                 if (values.empty() != true) {
-                    message->Parameters = values;
+                    message.Parameters = values;
                 }
                 return;
             }
-            void FromMessage(Core::JSON::IElement* response, const Core::JSONRPC::Message& message)
+            static void FromMessage(Core::JSON::IElement* response, const Core::JSONRPC::Message& message)
             {
                 response->FromString(message.Result.Value());
             }
-            void FromMessage(Core::JSON::IMessagePack* response, const Core::JSONRPC::Message& message)
+            static void FromMessage(Core::JSON::IMessagePack* response, const Core::JSONRPC::Message& message)
             {
                 string value = message.Result.Value();
                 std::vector<uint8_t> result(value.begin(), value.end());
@@ -1542,6 +1815,15 @@ namespace Thunder {
             {
                 return (_connection.template Dispatch<PARAMETERS, HANDLER, REALOBJECT>(waitTime, method, callback, objectPtr));
             }
+            inline typename LinkType<INTERFACE>::Future Request(const uint32_t waitTime, const string& method)
+            {
+                return (_connection.Request(waitTime, method));
+            }
+            template <typename PARAMETERS>
+            inline typename LinkType<INTERFACE>::Future Request(const uint32_t waitTime, const string& method, const PARAMETERS& parameters)
+            {
+                return (_connection.template Request<PARAMETERS>(waitTime, method, parameters));
+            }
             // -------------------------------------------------------------------------------------------
             // SET Properties
             // -------------------------------------------------------------------------------------------
@@ -63,10 +63,146 @@ namespace Web
         Core::JSON::EnumType<JSONWebToken::mode> Algorithm;
     };
 
-    JSONWebToken::JSONWebToken(const mode type, const uint8_t length, const uint8_t key[])
+    // Only the registered claims relevant for caching a validated token.
+    class JSONWebClaims : public Core::JSON::Container {
+    public:
+        JSONWebClaims(const JSONWebClaims&) = delete;
+        JSONWebClaims& operator=(const JSONWebClaims&) = delete;
+
+        JSONWebClaims()
+            : Core::JSON::Container()
+            , Expiration()
+        {
+            Add(_T("exp"), &Expiration);
+        }
+        ~JSONWebClaims() override = default;
+
+    public:
+        Core::JSON::DecUInt64 Expiration;
+    };
+
+    // Returns the expiry in Core::Time ticks, 0 if the payload carries no "exp" claim.
+    static uint64_t Expiry(const uint8_t payload[], const uint16_t length)
+    {
+        uint64_t result = 0;
+
+        if ((length > 0) && (payload[0] == '{')) {
+            JSONWebClaims claims;
+            Core::OptionalType<Core::JSON::Error> error;
+
+            claims.FromString(string(reinterpret_cast<const char*>(payload), length), error);
+
+            if ((error.IsSet() == false) && (claims.Expiration.IsSet() == true)) {
+                result = claims.Expiration.Value() * Core::Time::MicroSecondsPerSecond;
+            }
+        }
+
+        return (result);
+    }
+
+    JSONWebToken::ValidationCache::ValidationCache(const uint16_t size)
+        : _slots((size + Stripes - 1) / Stripes)
+        , _stripes()
+    {
+        for (Stripe& stripe : _stripes) {
+            stripe.Entries.reserve(_slots);
+            stripe.Clock = 0;
+        }
+    }
+
+    /* static */ uint64_t JSONWebToken::ValidationCache::Hash(const string& token)
+    {
+        // FNV-1a, only used to select a stripe and to skip non matching entries quickly.
+        uint64_t result = 0xcbf29ce484222325ULL;
+
+        for (const char character : token) {
+            result ^= static_cast<uint8_t>(character);
+            result *= 0x100000001b3ULL;
+        }
+
+        return (result);
+    }
+
+    bool JSONWebToken::ValidationCache::Lookup(const string& token, const uint16_t maxLength, uint8_t payload[], uint16_t& length)
+    {
+        bool found = false;
+        const uint64_t hash = Hash(token);
+        Stripe& stripe = _stripes[hash % Stripes];
+
+        stripe.Lock.Lock();
+
+        std::vector<Entry>::iterator index = stripe.Entries.begin();
+
+        while ((index != stripe.Entries.end()) && ((index->Hash != hash) || (index->Token != token))) {
+            index++;
+        }
+
+        if (index != stripe.Entries.end()) {
+            if ((index->Expiry != 0) && (index->Expiry <= Core::Time::Now().Ticks())) {
+                stripe.Entries.erase(index);
+            } else if (index->Payload.length() <= maxLength) {
+                index->Used = ++stripe.Clock;
+                length = static_cast<uint16_t>(index->Payload.length());
+                ::memcpy(payload, index->Payload.c_str(), length);
+                found = true;
+            }
+        }
+
+        stripe.Lock.Unlock();
+
+        return (found);
+    }
+
+    void JSONWebToken::ValidationCache::Insert(const string& token, const uint8_t payload[], const uint16_t length, const uint64_t expiry)
+    {
+        const uint64_t hash = Hash(token);
+        Stripe& stripe = _stripes[hash % Stripes];
+
+        stripe.Lock.Lock();
+
+        Entry* entry = nullptr;
+
+        if (stripe.Entries.size() < _slots) {
+            stripe.Entries.emplace_back();
+            entry = &(stripe.Entries.back());
+        } else {
+            // Replace the least recently used entry.
+            entry = &(stripe.Entries.front());
+
+            for (Entry& candidate : stripe.Entries) {
+                if (candidate.Used < entry->Used) {
+                    entry = &candidate;
+                }
+            }
+        }
+
+        entry->Hash = hash;
+        entry->Expiry = expiry;
+        entry->Used = ++stripe.Clock;
+        entry->Token = token;
+        entry->Payload.assign(reinterpret_cast<const char*>(payload), length);
+
+        stripe.Lock.Unlock();
+    }
+
+    void JSONWebToken::ValidationCache::Clear()
+    {
+        for (Stripe& stripe : _stripes) {
+            stripe.Lock.Lock();
+            stripe.Entries.clear();
+            stripe.Lock.Unlock();
+        }
+    }
+
+    JSONWebToken::JSONWebToken(const mode type, const uint8_t length, const uint8_t key[], const uint16_t cacheSize)
         : _mode(type)
-        , _key(string(reinterpret_cast<const char*>(key), length))
+        , _header()
+        , _schedule()
+        , _cache(cacheSize)
     {
+        Crypto::SHA256HMAC hmac(string(reinterpret_cast<const char*>(key), length));
+        _schedule = hmac.KeySchedule();
+
         Core::EnumerateType<mode> modeData(type);
         string sourceBuffer(_T("{\"alg\":\"") + string(modeData.Data()) + _T("\",\"typ\":\"JWT\"}"));
         uint16_t sourceLength = static_cast<uint16_t>(sourceBuffer.length());
@@ -98,7 +234,7 @@ namespace Web
 
         if (_mode == JSONWebToken::SHA256) {
             TCHAR signature[((Crypto::SHA256HMAC::Length * 8) / 6) + 4];
-            Crypto::SHA256HMAC hash(_key);
+            Crypto::SHA256HMAC hash(_schedule);
             hash.Input(reinterpret_cast<const uint8_t*>(token.c_str()), static_cast<uint16_t>(token.length()));
             const uint8_t* inputSignature = hash.Result(); // 32 length
            
@@ -119,6 +255,8 @@ namespace Web
 
         if (pos == string::npos) {
             length = ~0;
+        } else if ((_cache.IsEnabled() == true) && (_cache.Lookup(token, maxLength, payload, length) == true)) {
+            // Validated before, the payload is served from the cache.
         } else {
 
             // Extract the header
@@ -146,6 +284,21 @@ namespace Web
                     length = static_cast<uint16_t>(sig_pos - pos);
                     // Oke, this is a valid frame, let extract the payload..
                     length = Core::URL::Base64Decode(token.substr(pos + 1).c_str(), length - 1, payload, maxLength, nullptr);
+
+                    size_t encoded = (sig_pos - pos - 1);
+
+                    while ((encoded > 0) && (token[pos + encoded] == '=')) {
+                        encoded--;
+                    }
+
+                    // Only remember complete payloads that did not expire yet.
+                    if ((_cache.IsEnabled() == true) && (length == ((encoded * 6) / 8))) {
+                        const uint64_t expiry = Expiry(payload, length);
+
+                        if ((expiry == 0) || (expiry > Core::Time::Now().Ticks())) {
+                            _cache.Insert(token, payload, length, expiry);
+                        }
+                    }
                 }
             }
         }
@@ -164,14 +317,14 @@ namespace Web
 
             if (type == JSONWebToken::mode::SHA256) {
                 // Now calculate what we think it should be..
-                Crypto::SHA256HMAC hash(_key);
+                Crypto::SHA256HMAC hash(_schedule);
 
                 // Extract the signature and convert it to a binary string.
                 uint8_t signature[Crypto::SHA256HMAC::Length];
                 if ((token.length() - pos - 1) == ((((8 * sizeof(signature)) + 5)/6))) {
                     if (Core::URL::Base64Decode(token.substr(pos + 1).c_str(), static_cast<uint16_t>(token.length() - pos - 1), signature, sizeof(signature), nullptr) == sizeof(signature)) {
 
-                        hash.Input(reinterpret_cast<const uint8_t*>(token.substr(0, pos).c_str()), static_cast<uint16_t>(pos * sizeof(TCHAR)));
+                        hash.Input(reinterpret_cast<const uint8_t*>(token.c_str()), static_cast<uint16_t>(pos * sizeof(TCHAR)));
                         result = (::memcmp(hash.Result(), signature, sizeof(signature)) == 0);
                     }
                 }
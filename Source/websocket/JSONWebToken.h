@@ -26,6 +26,54 @@ namespace Thunder {
 namespace Web {
 
     class EXTERNAL JSONWebToken {
+    private:
+        // Tokens that passed validation, so a token that is presented over and over again is only
+        // validated once. Entries are spread over independently locked stripes to keep concurrent
+        // validations from contending and are dropped once the "exp" claim of the token has passed.
+        class EXTERNAL ValidationCache {
+        private:
+            static constexpr uint8_t Stripes = 8;
+
+            struct Entry {
+                uint64_t Hash;
+                uint64_t Expiry;
+                uint64_t Used;
+                string Token;
+                string Payload;
+            };
+            struct Stripe {
+                Core::CriticalSection Lock;
+                std::vector<Entry> Entries;
+                uint64_t Clock;
+            };
+
+        public:
+            ValidationCache() = delete;
+            ValidationCache(ValidationCache&&) = delete;
+            ValidationCache(const ValidationCache&) = delete;
+            ValidationCache& operator=(ValidationCache&&) = delete;
+            ValidationCache& operator=(const ValidationCache&) = delete;
+
+            explicit ValidationCache(const uint16_t size);
+            ~ValidationCache() = default;
+
+        public:
+            inline bool IsEnabled() const
+            {
+                return (_slots > 0);
+            }
+            bool Lookup(const string& token, const uint16_t maxLength, uint8_t payload[], uint16_t& length);
+            void Insert(const string& token, const uint8_t payload[], const uint16_t length, const uint64_t expiry);
+            void Clear();
+
+        private:
+            static uint64_t Hash(const string& token);
+
+        private:
+            const uint16_t _slots;
+            Stripe _stripes[Stripes];
+        };
+
     private:
         JSONWebToken() = delete;
         JSONWebToken(JSONWebToken&&) = delete;
@@ -38,7 +86,10 @@ namespace Web {
             SHA256
         };
 
-        JSONWebToken(const mode type, const uint8_t length, const uint8_t key[]);
+        static constexpr uint16_t CacheSize = 64;
+
+        // The cacheSize is the number of validated tokens remembered, 0 disables the cache.
+        JSONWebToken(const mode type, const uint8_t length, const uint8_t key[], const uint16_t cacheSize = CacheSize);
         ~JSONWebToken();
 
     public:
@@ -46,13 +97,19 @@ namespace Web {
         uint16_t Decode(const string& token, const uint16_t maxLength, uint8_t payload[]) const;
         uint16_t PayloadLength(const string& token) const;
 
+        void Flush()
+        {
+            _cache.Clear();
+        }
+
     private:
         bool ValidSignature(const mode type, const string& token) const;
 
     private:
         mode _mode;
         string _header; 
-        string _key;
+        Crypto::SHA256HMAC::Schedule _schedule;
+        mutable ValidationCache _cache;
     };
 
 } } // namespace Thunder::Web
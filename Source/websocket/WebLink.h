@@ -28,6 +28,118 @@
 
 namespace Thunder {
 namespace Web {
+    // In pipelined mode, responses can be submitted in any order (e.g. from concurrently
+    // dispatched jobs) but HTTP/1.1 requires them to be sent in the order the requests
+    // were received. This keeps the received elements, in order, until their answer
+    // is available and releases them, front to back, to the serializer.
+    template <typename INBOUND, typename OUTBOUND>
+    class AnswerOrderType {
+    private:
+        struct Entry {
+            Entry(const Core::ProxyType<INBOUND>& element)
+                : Element(element)
+                , Answer()
+                , Answered(false)
+            {
+            }
+
+            Core::ProxyType<INBOUND> Element;
+            Core::ProxyType<OUTBOUND> Answer;
+            bool Answered;
+        };
+
+    public:
+        AnswerOrderType(AnswerOrderType<INBOUND, OUTBOUND>&&) = delete;
+        AnswerOrderType(const AnswerOrderType<INBOUND, OUTBOUND>&) = delete;
+        AnswerOrderType<INBOUND, OUTBOUND>& operator=(AnswerOrderType<INBOUND, OUTBOUND>&&) = delete;
+        AnswerOrderType<INBOUND, OUTBOUND>& operator=(const AnswerOrderType<INBOUND, OUTBOUND>&) = delete;
+
+        AnswerOrderType()
+            : _lock()
+            , _pending()
+            , _enabled(false)
+        {
+        }
+        ~AnswerOrderType() = default;
+
+    public:
+        inline bool IsEnabled() const
+        {
+            return (_enabled);
+        }
+        inline void Enable(const bool enabled)
+        {
+            _lock.Lock();
+            _enabled = enabled;
+            if (enabled == false) {
+                _pending.clear();
+            }
+            _lock.Unlock();
+        }
+        inline uint32_t Pending() const
+        {
+            _lock.Lock();
+            uint32_t result = static_cast<uint32_t>(_pending.size());
+            _lock.Unlock();
+
+            return (result);
+        }
+        void Expect(const Core::ProxyType<INBOUND>& element)
+        {
+            _lock.Lock();
+            if (_enabled == true) {
+                _pending.emplace_back(element);
+            }
+            _lock.Unlock();
+        }
+        // An invalid answer releases the slot of the element without sending anything, e.g. for
+        // requests that are answered asynchronously. The action is called, under the lock, for
+        // every answer that is now in order. Returns false if the element was not expected.
+        template <typename ACTION>
+        bool Answer(const Core::ProxyType<INBOUND>& element, const Core::ProxyType<OUTBOUND>& answer, ACTION&& action)
+        {
+            bool found = false;
+
+            _lock.Lock();
+
+            typename std::list<Entry>::iterator index(_pending.begin());
+
+            while ((index != _pending.end()) && (index->Element != element)) {
+                index++;
+            }
+
+            if (index != _pending.end()) {
+                ASSERT(index->Answered == false);
+
+                found = true;
+                index->Answer = answer;
+                index->Answered = true;
+
+                while ((_pending.empty() == false) && (_pending.front().Answered == true)) {
+                    if (_pending.front().Answer.IsValid() == true) {
+                        action(_pending.front().Answer);
+                    }
+                    _pending.pop_front();
+                }
+            }
+
+            _lock.Unlock();
+
+            return (found);
+        }
+        void Clear()
+        {
+            _lock.Lock();
+            _pending.clear();
+            _lock.Unlock();
+        }
+
+    private:
+        mutable Core::CriticalSection _lock;
+        std::list<Entry> _pending;
+        std::atomic<bool> _enabled;
+    };
+
     template <typename LINK, typename INBOUND, typename OUTBOUND, typename ALLOCATOR, typename TRANSFORM = NoTransform>
     class WebLinkType {
     private:
@@ -126,6 +238,8 @@ namespace Web {
                 ASSERT(&element == static_cast<typename INBOUND::BaseElement*>(&(*(_current))));
                 DEBUG_VARIABLE(element);
 
+                _parent.Expect(_current);
+
                 _parent.Received(_current);
 
                 _current.Release();
@@ -206,6 +320,9 @@ namespace Web {
             // Signal a state change, Opened, Closed or Accepted
             void StateChange() override
             {
+                if (ACTUALLINK::IsOpen() == false) {
+                    _parent.Abandon();
+                }
                 _parent.StateChange();
             }
 
@@ -262,6 +379,37 @@ POP_WARNING()
 
             return (true);
         }
+        // Submit an OUTBOUND object as the answer to a received INBOUND object. If the
+        // link is pipelined, answers are put on the channel in the order in which the
+        // INBOUND objects were received, regardless of the order they are submitted in.
+        // An invalid answer only releases the slot of the INBOUND object.
+        inline bool Submit(const Core::ProxyType<INBOUND>& element, const Core::ProxyType<OUTBOUND>& answer)
+        {
+            if (_channel.IsOpen() == true) {
+                if ((_order.IsEnabled() == false) || (_order.Answer(element, answer, [this](const Core::ProxyType<OUTBOUND>& entry) { _serializerImpl.Submit(entry); }) == false)) {
+                    if (answer.IsValid() == true) {
+                        _serializerImpl.Submit(answer);
+                    }
+                }
+            }
+
+            return (true);
+        }
+        // In pipelined mode every received INBOUND object must be answered through the
+        // Submit(element, answer) method, allowing concurrent handling of the received
+        // INBOUND objects on a single (keep-alive) connection.
+        inline void Pipelined(const bool enabled)
+        {
+            _order.Enable(enabled);
+        }
+        inline bool IsPipelined() const
+        {
+            return (_order.IsEnabled());
+        }
+        inline uint32_t Outstanding() const
+        {
+            return (_order.Pending());
+        }
         inline uint32_t Open(const uint32_t waitTime)
         {
             return (_channel.Open(waitTime));
@@ -272,6 +420,7 @@ POP_WARNING()
         }
         inline void Flush()
         {
+            _order.Clear();
             _serializerImpl.Flush();
             _deserialiserImpl.Flush();
         }
@@ -318,6 +467,15 @@ POP_WARNING()
         {
             _channel.Trigger();
         }
+        inline void Expect(const Core::ProxyType<INBOUND>& element)
+        {
+            _order.Expect(element);
+        }
+        inline void Abandon()
+        {
+            // Answers for a closed channel can never be delivered anymore..
+            _order.Clear();
+        }
         // -------------------------------------------------------------
         // Check for Transform methods Inbound/Outbound on _transformer
         // -------------------------------------------------------------
@@ -348,12 +506,26 @@ POP_WARNING()
         inline typename Core::TypeTraits::enable_if<!hasTransform<CLASSNAME, uint16_t, BaseSerializer&, uint8_t*, const uint16_t>::value, uint16_t>::type
         SendData(uint8_t* dataFrame, const uint16_t receivedSize)
         {
-            return (_serializerImpl.Serialize(dataFrame, receivedSize));
+            uint16_t result = _serializerImpl.Serialize(dataFrame, receivedSize);
+
+            if (std::is_base_of<Core::SocketDatagram, LINK>::value == false) {
+                // On a stream, coalesce the adjacent queued OUTBOUND objects into this
+                // frame, so pipelined answers leave in a single write.
+                uint16_t loaded = result;
+
+                while ((loaded != 0) && (result < receivedSize)) {
+                    loaded = _serializerImpl.Serialize(&(dataFrame[result]), receivedSize - result);
+                    result += loaded;
+                }
+            }
+
+            return (result);
         }
 
     private:
         SerializerImpl _serializerImpl;
         DeserializerImpl _deserialiserImpl;
+        AnswerOrderType<INBOUND, OUTBOUND> _order;
         HandlerType<ThisClass, LINK> _channel;
         TRANSFORM _transformer;
     };
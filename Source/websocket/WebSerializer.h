@@ -142,6 +142,12 @@ namespace Web {
     };
 
     class EXTERNAL FileBody : public Core::File, public IBody {
+    private:
+        // Files of at least this size are memory mapped when sent, instead of read chunk by chunk.
+        // Uploads switch to a mapping once they pass it, the file then grows a window at a time.
+        static constexpr uint32_t MappingThreshold = (256 * 1024);
+        static constexpr uint32_t MappingWindow = (1024 * 1024);
+
     public:
         FileBody(const FileBody&) = delete;
         FileBody& operator=(const FileBody&) = delete;
@@ -150,15 +156,24 @@ namespace Web {
             : Core::File()
             , _opened(false)
             , _startPosition(0)
+            , _mapped(nullptr)
+            , _offset(0)
+            , _received(0)
         {
         }
         FileBody(const string& path)
             : Core::File(path)
             , _opened(false)
             , _startPosition(0)
+            , _mapped(nullptr)
+            , _offset(0)
+            , _received(0)
+        {
+        }
+        ~FileBody() override
         {
+            Unmap();
         }
-        ~FileBody() override = default;
 
     public:
         inline FileBody& operator=(const string& location)
@@ -186,20 +201,87 @@ namespace Web {
                 const_cast<FileBody*>(this)->LoadFileInfo();
                 const_cast<FileBody*>(this)->Position(false, _startPosition);
             }
-            return (((_opened == false) || (Core::File::Open() == true)) ? static_cast<uint32_t>(Core::File::Size() - _startPosition) : 0);
+
+            uint32_t result = (((_opened == false) || (Core::File::Open() == true)) ? static_cast<uint32_t>(Core::File::Size() - _startPosition) : 0);
+
+            Unmap();
+            _received = ~0;
+
+            if ((result >= MappingThreshold) && (Core::File::Size() <= Core::NumberType<uint32_t>::Max())) {
+                _mapped = new Core::DataElementFile(const_cast<FileBody&>(*this), Core::File::USER_READ);
+
+                if ((_mapped->IsValid() == false) || (_mapped->Size() != Core::File::Size())) {
+                    // Could not map it, fall back to reading.
+                    Unmap();
+                } else {
+                    _offset = static_cast<uint64_t>(Core::File::Position());
+                }
+            }
+
+            return (result);
         }
         uint32_t Deserialize() override
         {
+            Unmap();
+            _received = 0;
+
             _opened = (Core::File::IsOpen() == false);
             return (((_opened == false) || (Core::File::Create() == true)) ? static_cast<uint32_t>(~0) : 0);
         }
         uint16_t Serialize(uint8_t stream[], const uint16_t maxLength) const override
         {
-            return Core::File::Read(stream, maxLength);
+            uint16_t result;
+
+            if (_mapped == nullptr) {
+                result = static_cast<uint16_t>(Core::File::Read(stream, maxLength));
+            } else {
+                result = static_cast<uint16_t>(std::min(static_cast<uint64_t>(maxLength), _mapped->Size() - _offset));
+                ::memcpy(stream, &(_mapped->Buffer()[_offset]), result);
+                _offset += result;
+            }
+
+            return (result);
         }
         uint16_t Deserialize(const uint8_t stream[], const uint16_t maxLength) override
         {
-            uint16_t write = Core::File::Write(stream, maxLength);
+            uint16_t write = 0;
+
+            if ((_mapped == nullptr) && ((_received + maxLength) >= MappingThreshold)) {
+                _offset = static_cast<uint64_t>(Core::File::Position());
+                _mapped = new Core::DataElementFile(*this, Core::File::USER_READ | Core::File::USER_WRITE | Core::File::SHAREABLE);
+
+                if (_mapped->IsValid() == false) {
+                    // Could not map it, keep on writing.
+                    Unmap();
+                    _received = ~0;
+                }
+            }
+
+            if ((_mapped != nullptr) && ((_offset + maxLength) > _mapped->Size())) {
+                // Grows the file and the mapping.
+                _mapped->Size(_offset + maxLength + MappingWindow);
+
+                if ((_mapped->IsValid() == false) || ((_offset + maxLength) > _mapped->Size())) {
+                    // Whatever got in is in the file, continue with writing after it.
+                    Unmap();
+                    Core::File::SetSize(_offset);
+                    Core::File::Position(false, static_cast<int64_t>(_offset));
+                    _received = ~0;
+                }
+            }
+
+            if (_mapped == nullptr) {
+                write = Core::File::Write(stream, maxLength);
+
+                if (_received != static_cast<uint64_t>(~0)) {
+                    _received += write;
+                }
+            } else {
+                ::memcpy(&(_mapped->Buffer()[_offset]), stream, maxLength);
+                _offset += maxLength;
+                write = maxLength;
+            }
+
             if (!write) {
                 _startPosition = Core::NumberType<int32_t>::Max();
             }
@@ -208,6 +290,15 @@ namespace Web {
         }
         void End() const override
         {
+            if ((_mapped != nullptr) && (_received != static_cast<uint64_t>(~0))) {
+                // The mapping grows in windows, cut the file back to what was received.
+                Unmap();
+                const_cast<FileBody*>(this)->SetSize(_offset);
+                const_cast<FileBody*>(this)->Position(false, static_cast<int64_t>(_offset));
+            }
+
+            Unmap();
+
             if (Core::File::IsOpen() == true) {
                 if (_opened == true) {
                     Core::File::Close();
@@ -221,9 +312,22 @@ namespace Web {
             }
         }
 
+    private:
+        void Unmap() const
+        {
+            if (_mapped != nullptr) {
+                delete _mapped;
+                _mapped = nullptr;
+            }
+        }
+
     private:
         mutable bool _opened;
         mutable int32_t _startPosition;
+        mutable Core::DataElementFile* _mapped;
+        mutable uint64_t _offset;
+        // Bytes written while uploading, ~0 if the body is sent or can not be mapped.
+        mutable uint64_t _received;
     };
 
     template <typename HASHALGORITHM>
@@ -275,7 +379,7 @@ namespace Web {
         }
         uint16_t Serialize(uint8_t stream[], const uint16_t maxLength) const override
         {
-            return Core::File::Read(stream, maxLength);
+            return (FileBody::Serialize(stream, maxLength));
         }
 
     protected:
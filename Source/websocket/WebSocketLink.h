@@ -390,6 +390,7 @@ PUSH_WARNING(DISABLE_WARNING_THIS_IN_MEMBER_INITIALIZER_LIST)
                 , _origin()
                 , _webSocketMessage(Core::ProxyType<typename OUTBOUND::BaseElement>::Create())
                 , _pingFireTime(0)
+                , _order()
             {
             }
             template <typename... Args>
@@ -407,6 +408,7 @@ PUSH_WARNING(DISABLE_WARNING_THIS_IN_MEMBER_INITIALIZER_LIST)
                 , _origin()
                 , _webSocketMessage(Core::ProxyType<typename OUTBOUND::BaseElement>::Create())
                 , _pingFireTime(0)
+                , _order()
             {
             }
 POP_WARNING()
@@ -539,6 +541,26 @@ POP_WARNING()
                     _adminLock.Unlock();
                 }
             }
+            void Submit(const Core::ProxyType<INBOUND>& element, const Core::ProxyType<OUTBOUND>& answer)
+            {
+                if ((_order.IsEnabled() == false) || (_order.Answer(element, answer, [this](const Core::ProxyType<OUTBOUND>& entry) { Submit(entry); }) == false)) {
+                    if (answer.IsValid() == true) {
+                        Submit(answer);
+                    }
+                }
+            }
+            void Pipelined(const bool enabled)
+            {
+                _order.Enable(enabled);
+            }
+            bool IsPipelined() const
+            {
+                return (_order.IsEnabled());
+            }
+            uint32_t Outstanding() const
+            {
+                return (_order.Pending());
+            }
             uint32_t Close(const uint32_t waitTime)
             {
                 uint32_t result = 0;
@@ -703,6 +725,11 @@ POP_WARNING()
             // Signal a state change, Opened, Closed, Accepted or Error
             void StateChange() override
             {
+                if (IsClosed() == true) {
+                    // Answers for a closed channel can never be delivered anymore..
+                    _order.Clear();
+                }
+
                 _adminLock.Lock();
 
                 // If the connection is closed by peer 'during' socket write, cleanup response message
@@ -864,6 +891,7 @@ POP_WARNING()
 
                     ACTUALLINK::Trigger();
                 } else {
+                    _order.Expect(element);
                     _parent.Received(element);
                 }
             }
@@ -972,6 +1000,7 @@ POP_WARNING()
             string _commandData;
             Core::ProxyType<typename OUTBOUND::BaseElement> _webSocketMessage;
             uint64_t _pingFireTime;
+            AnswerOrderType<INBOUND, OUTBOUND> _order;
         };
 
     public:
@@ -1157,6 +1186,24 @@ POP_WARNING()
         {
             _channel.Submit(element);
         }
+        // Answer a received INBOUND object. If the link is pipelined, answers are sent in the
+        // order in which the INBOUND objects were received, see AnswerOrderType.
+        void Submit(const Core::ProxyType<INBOUND>& element, const Core::ProxyType<OUTBOUND>& answer)
+        {
+            _channel.Submit(element, answer);
+        }
+        void Pipelined(const bool enabled)
+        {
+            _channel.Pipelined(enabled);
+        }
+        bool IsPipelined() const
+        {
+            return (_channel.IsPipelined());
+        }
+        uint32_t Outstanding() const
+        {
+            return (_channel.Outstanding());
+        }
 
         virtual void LinkBody(Core::ProxyType<INBOUND>& element) = 0;
         virtual void Received(Core::ProxyType<INBOUND>& element) = 0;
@@ -0,0 +1,248 @@
+/*
+ * If not stated otherwise in this file or this component's LICENSE file the
+ * following copyright and licenses apply:
+ *
+ * Copyright 2021 Metrological
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+// Cost of resolving an interface that is handed over on a COM-RPC channel to its proxy, as is done
+// for every interface passed as a parameter, for a growing number of live proxies per channel. Every
+// thread works on a channel of its own, the channels are not connected, so nothing goes out.
+//
+//   cmake -DBENCHMARKS=ON ...
+//   AdministratorBenchmark [milliseconds per measurement]
+
+#include "Benchmark.h"
+
+#include <com/com.h>
+
+#include <atomic>
+#include <thread>
+
+namespace Thunder {
+namespace Benchmark {
+
+    constexpr uint32_t MaxThreads = 8;
+
+    struct IBench : virtual public Core::IUnknown {
+        enum { ID = 0x00FFBE01 };
+
+        ~IBench() override = default;
+
+        virtual uint32_t Value() const = 0;
+    };
+
+    class BenchProxy : public ProxyStub::UnknownProxyType<IBench> {
+    public:
+        BenchProxy(const Core::ProxyType<Core::IPCChannel>& channel, const Core::instance_id& implementation, const bool outbound)
+            : BaseClass(channel, implementation, outbound)
+        {
+        }
+        ~BenchProxy() override = default;
+
+    public:
+        uint32_t Value() const override
+        {
+            return (0);
+        }
+    };
+
+    static ProxyStub::MethodHandler BenchStubMethods[] = {
+        nullptr
+    };
+
+    using BenchStub = ProxyStub::UnknownStubType<IBench, BenchStubMethods>;
+
+    // A channel that is never opened, it only gives the proxies an identity.
+    class Channel : public Core::IPCChannel {
+    public:
+        Channel() = delete;
+        Channel(Channel&&) = delete;
+        Channel(const Channel&) = delete;
+        Channel& operator=(Channel&&) = delete;
+        Channel& operator=(const Channel&) = delete;
+
+        explicit Channel(const uint32_t id)
+            : Core::IPCChannel()
+            , _id(id)
+        {
+        }
+        ~Channel() override = default;
+
+    public:
+        uint32_t Id() const override
+        {
+            return (_id);
+        }
+        string Origin() const override
+        {
+            return (_T("benchmark"));
+        }
+        uint32_t ReportResponse(Core::ProxyType<Core::IIPC>&) override
+        {
+            return (Core::ERROR_NONE);
+        }
+        bool IsOpen() const override
+        {
+            return (true);
+        }
+        bool IsClosed() const override
+        {
+            return (false);
+        }
+
+    private:
+        uint32_t Execute(const Core::ProxyType<Core::IIPC>&, Core::IDispatchType<Core::IIPC>*) override
+        {
+            return (Core::ERROR_UNAVAILABLE);
+        }
+        uint32_t Execute(const Core::ProxyType<Core::IIPC>&, const uint32_t) override
+        {
+            return (Core::ERROR_UNAVAILABLE);
+        }
+
+    private:
+        const uint32_t _id;
+    };
+
+    // A channel with <count> live proxies, each for a different remote implementation.
+    class Session {
+    public:
+        Session() = delete;
+        Session(Session&&) = delete;
+        Session(const Session&) = delete;
+        Session& operator=(Session&&) = delete;
+        Session& operator=(const Session&) = delete;
+
+        Session(const uint32_t id, const uint32_t count)
+            : _channel(Core::ProxyType<Channel>::Create(id))
+            , _interfaces()
+        {
+            for (uint32_t index = 0; index < count; index++) {
+                IBench* bench = nullptr;
+
+                RPC::Administrator::Instance().ProxyInstance(_channel, Implementation(index), false, bench);
+                ASSERT(bench != nullptr);
+
+                _interfaces.push_back(bench);
+            }
+        }
+        ~Session()
+        {
+            for (IBench* bench : _interfaces) {
+                bench->Release();
+            }
+        }
+
+    public:
+        uint32_t Count() const
+        {
+            return (static_cast<uint32_t>(_interfaces.size()));
+        }
+        bool Lookup(const uint32_t index) const
+        {
+            IBench* bench = nullptr;
+
+            RPC::Administrator::Instance().ProxyInstance(_channel, Implementation(index), false, bench);
+
+            if (bench != nullptr) {
+                bench->Release();
+            }
+
+            return (bench != nullptr);
+        }
+
+    private:
+        static Core::instance_id Implementation(const uint32_t index)
+        {
+            return (static_cast<Core::instance_id>(0x10000 + (index * 64)));
+        }
+
+    private:
+        Core::ProxyType<Core::IPCChannel> _channel;
+        std::vector<IBench*> _interfaces;
+    };
+
+    // Runs <threads> threads, each resolving the proxies of its own channel for <duration> ms,
+    // returns the ns per resolved proxy.
+    static double Measure(const std::vector<std::unique_ptr<Session>>& sessions, const uint32_t threads, const uint32_t duration)
+    {
+        std::atomic<bool> running(true);
+        std::atomic<uint64_t> resolved(0);
+        std::vector<std::thread> workers;
+
+        const auto start = std::chrono::steady_clock::now();
+
+        for (uint32_t thread = 0; thread < threads; thread++) {
+            workers.emplace_back([&, thread]() {
+                const Session& session(*sessions[thread]);
+                uint64_t count = 0;
+                uint32_t index = thread * 7;
+
+                while (running.load(std::memory_order_relaxed) == true) {
+                    if (session.Lookup(index % session.Count()) == true) {
+                        count++;
+                    }
+                    index++;
+                }
+
+                resolved += count;
+            });
+        }
+
+        std::this_thread::sleep_for(std::chrono::milliseconds(duration));
+        running = false;
+
+        for (std::thread& worker : workers) {
+            worker.join();
+        }
+
+        const double elapsed = static_cast<double>(std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start).count());
+
+        return (resolved == 0 ? 0.0 : elapsed / static_cast<double>(resolved.load()));
+    }
+
+} // namespace Benchmark
+} // namespace Thunder
+
+int main(int argc, char* argv[])
+{
+    using namespace Thunder;
+
+    const uint32_t duration = (argc > 1 ? static_cast<uint32_t>(atoi(argv[1])) : 500);
+
+    RPC::Administrator::Instance().Announce<Benchmark::IBench, Benchmark::BenchProxy, Benchmark::BenchStub>();
+
+    printf("Proxy resolution, %u cores\n", std::thread::hardware_concurrency());
+    printf("%-10s %-10s %16s\n", "proxies", "threads", "ns/lookup");
+
+    for (uint32_t proxies = 10; proxies <= 10000; proxies *= 10) {
+        std::vector<std::unique_ptr<Benchmark::Session>> sessions;
+
+        for (uint32_t thread = 0; thread < Benchmark::MaxThreads; thread++) {
+            sessions.emplace_back(new Benchmark::Session(thread + 1, proxies));
+        }
+
+        for (uint32_t threads = 1; threads <= Benchmark::MaxThreads; threads <<= 1) {
+            printf("%-10u %-10u %16.1f\n", proxies, threads, Benchmark::Measure(sessions, threads, duration));
+        }
+    }
+
+    RPC::Administrator::Instance().Recall<Benchmark::IBench>();
+
+    Core::Singleton::Dispose();
+
+    return (0);
+}
@@ -0,0 +1,104 @@
+/*
+ * If not stated otherwise in this file or this component's LICENSE file the
+ * following copyright and licenses apply:
+ *
+ * Copyright 2021 Metrological
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include "Module.h"
+
+#include <chrono>
+#include <cstdio>
+
+namespace Thunder {
+namespace Benchmark {
+
+    // Runs an operation repeatedly until at least <duration> milliseconds have passed and
+    // reports the time per operation and, if a size per operation is given, the throughput.
+    class Measure {
+    public:
+        Measure() = delete;
+        Measure(const Measure&) = delete;
+        Measure& operator=(const Measure&) = delete;
+
+        explicit Measure(const uint32_t duration = 500)
+            : _duration(duration)
+            , _iterations(0)
+            , _elapsed(0)
+        {
+        }
+        ~Measure() = default;
+
+    public:
+        template <typename OPERATION>
+        Measure& Run(OPERATION&& operation)
+        {
+            using Clock = std::chrono::steady_clock;
+
+            const Clock::time_point start = Clock::now();
+            const Clock::time_point end = start + std::chrono::milliseconds(_duration);
+            Clock::time_point now = start;
+            uint64_t batch = 1;
+
+            _iterations = 0;
+
+            // Check the clock in growing batches so reading it does not dominate short operations.
+            while (now < end) {
+                for (uint64_t index = 0; index < batch; index++) {
+                    operation();
+                }
+                _iterations += batch;
+                now = Clock::now();
+
+                if (batch < 0x10000) {
+                    batch <<= 1;
+                }
+            }
+
+            _elapsed = std::chrono::duration_cast<std::chrono::nanoseconds>(now - start).count();
+
+            return (*this);
+        }
+        uint64_t Iterations() const
+        {
+            return (_iterations);
+        }
+        double NanosecondsPerOperation() const
+        {
+            return (_iterations == 0 ? 0.0 : static_cast<double>(_elapsed) / static_cast<double>(_iterations));
+        }
+        double MegabytesPerSecond(const uint64_t bytesPerOperation) const
+        {
+            return (_elapsed == 0 ? 0.0 : (static_cast<double>(bytesPerOperation) * static_cast<double>(_iterations) * 1000.0) / (static_cast<double>(_elapsed) * 1.048576));
+        }
+        void Report(const char label[]) const
+        {
+            printf("%-48s %12.1f ns/op\n", label, NanosecondsPerOperation());
+        }
+        void Report(const char label[], const uint64_t bytesPerOperation) const
+        {
+            printf("%-48s %12.1f ns/op %10.1f MB/s\n", label, NanosecondsPerOperation(), MegabytesPerSecond(bytesPerOperation));
+        }
+
+    private:
+        const uint32_t _duration;
+        uint64_t _iterations;
+        uint64_t _elapsed;
+    };
+
+} // namespace Benchmark
+} // namespace Thunder
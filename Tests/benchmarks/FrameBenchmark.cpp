@@ -0,0 +1,154 @@
+/*
+ * If not stated otherwise in this file or this component's LICENSE file the
+ * following copyright and licenses apply:
+ *
+ * Copyright 2021 Metrological
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+// Serialization cost of Core::FrameType as used by COM-RPC (512 byte blocks, big endian,
+// 32 bit sizes): a typical small method call, large parameter blocks written into a fresh
+// frame (growth) and arrays of scalars written one by one versus in bulk.
+//
+//   cmake -DBENCHMARKS=ON ...
+//   FrameBenchmark [milliseconds per measurement]
+
+#include "Benchmark.h"
+
+#include <vector>
+
+namespace Thunder {
+namespace Benchmark {
+
+    using Frame = Core::FrameType<512, true, uint32_t>;
+
+    static constexpr uint32_t Sizes[] = { 4 * 1024, 64 * 1024, 1024 * 1024 };
+
+    static void Call(const uint32_t duration)
+    {
+        const string text(_T("org.rdk.SomePlugin.1.someMethod"));
+        Frame frame;
+
+        Measure measure(duration);
+        measure.Run([&]() {
+            frame.Clear();
+
+            Frame::Writer writer(frame, 0);
+            writer.Number<Core::instance_id>(0x7F001234);
+            writer.Number<uint32_t>(0x42);
+            writer.Number<uint8_t>(3);
+            writer.Number<uint32_t>(1000);
+            writer.Boolean(true);
+            writer.Text(text);
+
+            Frame::Reader reader(frame, 0);
+            (void) reader.Number<Core::instance_id>();
+            (void) reader.Number<uint32_t>();
+            (void) reader.Number<uint8_t>();
+            (void) reader.Number<uint32_t>();
+            (void) reader.Boolean();
+            (void) reader.Text();
+        });
+
+        measure.Report("call (write + read)");
+    }
+
+    static void Blocks(const uint32_t duration, const std::vector<uint8_t>& data)
+    {
+        for (const uint32_t size : Sizes) {
+            char label[64];
+
+            // Received piece by piece, as the IPC channel does it.
+            Measure measure(duration);
+            measure.Run([&]() {
+                Frame frame;
+                for (uint32_t offset = 0; offset < size; offset += 1024) {
+                    frame.Copy(offset, std::min(size - offset, 1024u), &data[offset]);
+                }
+            });
+            snprintf(label, sizeof(label), "fresh frame, %u bytes", size);
+            measure.Report(label, size);
+
+            Measure hinted(duration);
+            hinted.Run([&]() {
+                Frame frame;
+                frame.Reserve(size);
+                for (uint32_t offset = 0; offset < size; offset += 1024) {
+                    frame.Copy(offset, std::min(size - offset, 1024u), &data[offset]);
+                }
+            });
+            snprintf(label, sizeof(label), "reserved frame, %u bytes", size);
+            hinted.Report(label, size);
+        }
+    }
+
+    static void Arrays(const uint32_t duration, const std::vector<uint32_t>& values)
+    {
+        std::vector<uint32_t> result(values.size());
+        const uint32_t bytes = static_cast<uint32_t>(values.size() * sizeof(uint32_t));
+        Frame frame;
+        char label[64];
+
+        Measure single(duration);
+        single.Run([&]() {
+            Frame::Writer writer(frame, 0);
+            for (const uint32_t value : values) {
+                writer.Number<uint32_t>(value);
+            }
+            Frame::Reader reader(frame, 0);
+            for (uint32_t& value : result) {
+                value = reader.Number<uint32_t>();
+            }
+        });
+        snprintf(label, sizeof(label), "uint32_t[%u] one by one", static_cast<uint32_t>(values.size()));
+        single.Report(label, bytes);
+
+        Measure bulk(duration);
+        bulk.Run([&]() {
+            Frame::Writer writer(frame, 0);
+            writer.Numbers<uint32_t>(values.data(), static_cast<uint32_t>(values.size()));
+            Frame::Reader reader(frame, 0);
+            reader.Numbers<uint32_t>(result.data(), static_cast<uint32_t>(result.size()));
+        });
+        snprintf(label, sizeof(label), "uint32_t[%u] bulk", static_cast<uint32_t>(values.size()));
+        bulk.Report(label, bytes);
+    }
+
+} // namespace Benchmark
+} // namespace Thunder
+
+int main(int argc, char* argv[])
+{
+    using namespace Thunder;
+
+    const uint32_t duration = (argc > 1 ? static_cast<uint32_t>(atoi(argv[1])) : 500);
+
+    std::vector<uint8_t> data(Benchmark::Sizes[(sizeof(Benchmark::Sizes) / sizeof(Benchmark::Sizes[0])) - 1]);
+    std::vector<uint32_t> values(4096);
+
+    for (uint32_t index = 0; index < data.size(); index++) {
+        data[index] = static_cast<uint8_t>(index * 131);
+    }
+    for (uint32_t index = 0; index < values.size(); index++) {
+        values[index] = index * 2654435761u;
+    }
+
+    Benchmark::Call(duration);
+    Benchmark::Blocks(duration, data);
+    Benchmark::Arrays(duration, values);
+
+    Core::Singleton::Dispose();
+
+    return (0);
+}
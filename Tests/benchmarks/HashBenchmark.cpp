@@ -0,0 +1,124 @@
+/*
+ * If not stated otherwise in this file or this component's LICENSE file the
+ * following copyright and licenses apply:
+ *
+ * Copyright 2021 Metrological
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+// Throughput of the cryptalgo hashes and AES modes, once through the portable
+// implementation and once through the CPU crypto extensions (if present).
+//
+//   cmake -DBENCHMARKS=ON ...
+//   HashBenchmark [milliseconds per measurement]
+
+#include "Benchmark.h"
+
+#include <cryptalgo/cryptalgo.h>
+
+#include <vector>
+
+namespace Thunder {
+namespace Benchmark {
+
+    static constexpr uint32_t Sizes[] = { 64, 1024, 64 * 1024, 1024 * 1024, 64 * 1024 * 1024 };
+
+    template <typename HASHTYPE>
+    static void Hash(const uint32_t duration, const char name[], const std::vector<uint8_t>& data)
+    {
+        for (const uint32_t size : Sizes) {
+            char label[64];
+            HASHTYPE hash;
+
+            Measure measure(duration);
+            measure.Run([&]() {
+                hash.Reset();
+                for (uint32_t offset = 0; offset < size; offset += 32768) {
+                    hash.Input(&data[offset], static_cast<uint16_t>(std::min(size - offset, 32768u)));
+                }
+                (void) hash.Result();
+            });
+
+            snprintf(label, sizeof(label), "%s %u bytes", name, size);
+            measure.Report(label, size);
+        }
+    }
+
+    static void AES(const uint32_t duration, const Crypto::aesType type, const char name[], std::vector<uint8_t>& data, std::vector<uint8_t>& output)
+    {
+        const uint8_t key[16] = { 0x2b, 0x7e, 0x15, 0x16, 0x28, 0xae, 0xd2, 0xa6, 0xab, 0xf7, 0x15, 0x88, 0x09, 0xcf, 0x4f, 0x3c };
+        const uint8_t iv[16] = {};
+
+        for (const uint32_t size : Sizes) {
+            char label[64];
+            Crypto::AESEncryption encryption(type);
+            encryption.Key(sizeof(key), key);
+
+            Measure measure(duration);
+            measure.Run([&]() {
+                encryption.InitialVector(iv);
+                encryption.Encrypt(size, data.data(), output.data());
+            });
+
+            snprintf(label, sizeof(label), "%s %u bytes", name, size);
+            measure.Report(label, size);
+        }
+    }
+
+    static void Run(const uint32_t duration, std::vector<uint8_t>& data, std::vector<uint8_t>& output)
+    {
+        Hash<Crypto::SHA1>(duration, "SHA1", data);
+        Hash<Crypto::SHA256>(duration, "SHA256", data);
+        Hash<Crypto::SHA512>(duration, "SHA512", data);
+        Hash<Crypto::MD5>(duration, "MD5", data);
+        AES(duration, Crypto::aesType::AES_ECB, "AES-128-ECB", data, output);
+        AES(duration, Crypto::aesType::AES_CBC, "AES-128-CBC", data, output);
+    }
+
+} // namespace Benchmark
+} // namespace Thunder
+
+int main(int argc, char* argv[])
+{
+    using namespace Thunder;
+
+    const uint32_t duration = (argc > 1 ? static_cast<uint32_t>(atoi(argv[1])) : 500);
+    const uint8_t available = Crypto::Acceleration();
+
+    std::vector<uint8_t> data(Benchmark::Sizes[(sizeof(Benchmark::Sizes) / sizeof(Benchmark::Sizes[0])) - 1]);
+    std::vector<uint8_t> output(data.size());
+
+    for (uint32_t index = 0; index < data.size(); index++) {
+        data[index] = static_cast<uint8_t>(index * 131);
+    }
+
+    printf("Crypto extensions available: SHA1 [%s] SHA256 [%s] AES [%s]\n",
+        (available & Crypto::ACCELERATION_SHA1) != 0 ? "yes" : "no",
+        (available & Crypto::ACCELERATION_SHA256) != 0 ? "yes" : "no",
+        (available & Crypto::ACCELERATION_AES) != 0 ? "yes" : "no");
+
+    printf("\n--- Portable ---\n");
+    Crypto::Accelerate(Crypto::ACCELERATION_NONE);
+    Benchmark::Run(duration, data, output);
+
+    if (available != Crypto::ACCELERATION_NONE) {
+        printf("\n--- Accelerated ---\n");
+        Crypto::Accelerate(available);
+        Benchmark::Run(duration, data, output);
+    }
+
+    Core::Singleton::Dispose();
+
+    return (0);
+}
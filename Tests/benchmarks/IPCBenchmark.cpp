@@ -0,0 +1,260 @@
+/*
+ * If not stated otherwise in this file or this component's LICENSE file the
+ * following copyright and licenses apply:
+ *
+ * Copyright 2021 Metrological
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+// Invocations on a single IPC channel from a growing number of threads, with and without a
+// slow invocation in flight on the same channel. The fast invocations should not queue up
+// behind the slow one. Then the same channel is moved over to shared memory rings, to compare
+// the round trip with the one over the socket.
+//
+//   cmake -DBENCHMARKS=ON ...
+//   IPCBenchmark [milliseconds per measurement]
+
+#include "Benchmark.h"
+
+#include <atomic>
+#include <list>
+#include <thread>
+#include <vector>
+
+namespace Thunder {
+namespace Benchmark {
+
+    struct Value {
+        uint32_t Number;
+    };
+
+    using Echo = Core::IPCMessageType<1, Value, Value>;
+    using Slow = Core::IPCMessageType<2, Value, Value>;
+
+    static constexpr uint32_t SlowDelay = 10; // ms
+
+    class EchoHandler : public Core::IIPCServer {
+    public:
+        EchoHandler(const EchoHandler&) = delete;
+        EchoHandler& operator=(const EchoHandler&) = delete;
+
+        EchoHandler() = default;
+        ~EchoHandler() override = default;
+
+    public:
+        void Procedure(Core::IPCChannel& source, Core::ProxyType<Core::IIPC>& data) override
+        {
+            Core::ProxyType<Echo> message(data);
+            message->Response().Number = message->Parameters().Number + 1;
+            source.ReportResponse(data);
+        }
+    };
+
+    // Answers from a thread of its own, SlowDelay ms after the request came in.
+    class SlowHandler : public Core::IIPCServer {
+    private:
+        struct Request {
+            uint64_t Due;
+            Core::IPCChannel* Channel;
+            Core::ProxyType<Core::IIPC> Message;
+        };
+
+    public:
+        SlowHandler(const SlowHandler&) = delete;
+        SlowHandler& operator=(const SlowHandler&) = delete;
+
+        SlowHandler()
+            : _lock()
+            , _requests()
+            , _running(true)
+            , _responder([this]() { Respond(); })
+        {
+        }
+        ~SlowHandler() override
+        {
+            _running = false;
+            _responder.join();
+        }
+
+    public:
+        void Procedure(Core::IPCChannel& source, Core::ProxyType<Core::IIPC>& data) override
+        {
+            _lock.Lock();
+            _requests.push_back({ Core::Time::Now().Add(SlowDelay).Ticks(), &source, data });
+            _lock.Unlock();
+        }
+
+    private:
+        void Respond()
+        {
+            while (_running == true) {
+                Request ready { 0, nullptr, Core::ProxyType<Core::IIPC>() };
+
+                _lock.Lock();
+                if ((_requests.empty() == false) && (_requests.front().Due <= Core::Time::Now().Ticks())) {
+                    ready = _requests.front();
+                    _requests.pop_front();
+                }
+                _lock.Unlock();
+
+                if (ready.Channel != nullptr) {
+                    Core::ProxyType<Slow> message(ready.Message);
+                    message->Response().Number = message->Parameters().Number;
+                    ready.Channel->ReportResponse(ready.Message);
+                } else {
+                    SleepMs(1);
+                }
+            }
+        }
+
+    private:
+        Core::CriticalSection _lock;
+        std::list<Request> _requests;
+        std::atomic<bool> _running;
+        std::thread _responder;
+    };
+
+    using Factory = Core::FactoryType<Core::IIPC, uint32_t>;
+    using Server = Core::IPCChannelClientType<Core::Void, true, false>;
+    using Client = Core::IPCChannelClientType<Core::Void, false, false>;
+
+    static void Contention(const uint32_t duration, Client& client, const uint8_t threads, const bool slow)
+    {
+        std::atomic<bool> running(true);
+        std::atomic<uint64_t> calls(0);
+        std::atomic<uint64_t> slowCalls(0);
+        std::atomic<uint64_t> failures(0);
+        std::vector<std::thread> callers;
+
+        if (slow == true) {
+            callers.emplace_back([&]() {
+                Core::ProxyType<Slow> message(Core::ProxyType<Slow>::Create());
+
+                while (running == true) {
+                    if (client.Invoke(message, 1000) == Core::ERROR_NONE) {
+                        slowCalls++;
+                    }
+                }
+            });
+        }
+
+        const std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+
+        for (uint8_t index = 0; index < threads; index++) {
+            callers.emplace_back([&, index]() {
+                Core::ProxyType<Echo> message(Core::ProxyType<Echo>::Create());
+                message->Parameters().Number = index;
+
+                while (running == true) {
+                    if ((client.Invoke(message, 1000) == Core::ERROR_NONE) && (message->Response().Number == static_cast<uint32_t>(index + 1))) {
+                        calls++;
+                    } else {
+                        failures++;
+                    }
+                }
+            });
+        }
+
+        SleepMs(duration);
+        running = false;
+
+        const double elapsed = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start).count();
+
+        for (auto& caller : callers) {
+            caller.join();
+        }
+
+        char label[64];
+        snprintf(label, sizeof(label), "%u thread(s)%s", threads, (slow == true ? " + slow caller" : ""));
+
+        const double perCall = (calls == 0 ? 0.0 : (elapsed * threads) / static_cast<double>(calls));
+        printf("%-48s %12.1f ns/call %10.0f calls/s", label, perCall, (calls * 1000000000.0) / elapsed);
+        if (slow == true) {
+            printf(" %6" PRIu64 " slow", slowCalls.load());
+        }
+        if (failures != 0) {
+            printf(" %6" PRIu64 " FAILED", failures.load());
+        }
+        printf("\n");
+    }
+
+} // namespace Benchmark
+} // namespace Thunder
+
+int main(int argc, char* argv[])
+{
+    using namespace Thunder;
+
+    const uint32_t duration = (argc > 1 ? static_cast<uint32_t>(atoi(argv[1])) : 500);
+    const Core::NodeId node(_T("/tmp/ipcbenchmark"));
+
+    Core::ProxyType<Benchmark::Factory> serverFactory(Core::ProxyType<Benchmark::Factory>::Create());
+    Core::ProxyType<Benchmark::Factory> clientFactory(Core::ProxyType<Benchmark::Factory>::Create());
+
+    serverFactory->CreateFactory<Benchmark::Echo>(8);
+    serverFactory->CreateFactory<Benchmark::Slow>(2);
+    clientFactory->CreateFactory<Benchmark::Echo>(8);
+    clientFactory->CreateFactory<Benchmark::Slow>(2);
+
+    {
+        Benchmark::Server server(node, 1024, serverFactory);
+        Benchmark::Client client(node, 1024, clientFactory);
+
+        Core::ProxyType<Core::IIPCServer> echo(Core::ProxyType<Benchmark::EchoHandler>::Create());
+        Core::ProxyType<Core::IIPCServer> slow(Core::ProxyType<Benchmark::SlowHandler>::Create());
+
+        server.Register(Benchmark::Echo::Id(), echo);
+        server.Register(Benchmark::Slow::Id(), slow);
+        server.Shareable(true);
+
+        if ((server.Source().Open(1000) != Core::ERROR_NONE) || (client.Source().Open(1000) != Core::ERROR_NONE)) {
+            printf("Could not set up the channel on %s\n", node.HostName().c_str());
+        } else {
+            printf("Invocations on one channel, slow ones take %u ms\n", Benchmark::SlowDelay);
+
+            for (const uint8_t threads : { 1, 2, 4, 8 }) {
+                Benchmark::Contention(duration, client, threads, false);
+            }
+            for (const uint8_t threads : { 1, 2, 4, 8 }) {
+                Benchmark::Contention(duration, client, threads, true);
+            }
+
+            if (client.Upgrade(64 * 1024, 1000) != Core::ERROR_NONE) {
+                printf("Could not move the channel over to shared memory\n");
+            } else {
+                printf("The same channel, over shared memory rings\n");
+
+                for (const uint8_t threads : { 1, 2, 4, 8 }) {
+                    Benchmark::Contention(duration, client, threads, false);
+                }
+                Benchmark::Contention(duration, client, 1, true);
+            }
+        }
+
+        client.Source().Close(1000);
+        server.Source().Close(1000);
+
+        server.Unregister(Benchmark::Echo::Id());
+        server.Unregister(Benchmark::Slow::Id());
+    }
+
+    serverFactory->DestroyFactory<Benchmark::Echo>();
+    serverFactory->DestroyFactory<Benchmark::Slow>();
+    clientFactory->DestroyFactory<Benchmark::Echo>();
+    clientFactory->DestroyFactory<Benchmark::Slow>();
+
+    Core::Singleton::Dispose();
+
+    return (0);
+}
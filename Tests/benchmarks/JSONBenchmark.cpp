@@ -0,0 +1,272 @@
+/*
+ * If not stated otherwise in this file or this component's LICENSE file the
+ * following copyright and licenses apply:
+ *
+ * Copyright 2021 Metrological
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+// Cost of the Core::JSON containers: the same plugin configuration like object once
+// registering its members at runtime (Add) and once through a compile time field table,
+// building, parsing and serializing large (numeric) arrays and escaping and unescaping long strings.
+//
+//   cmake -DBENCHMARKS=ON ...
+//   JSONBenchmark [milliseconds per measurement]
+
+#include "Benchmark.h"
+
+namespace Thunder {
+namespace Benchmark {
+
+    static const string Document = _T("{\"callsign\":\"WebKitBrowser\",\"locator\":\"libWebKitBrowser.so\",\"classname\":\"WebKitBrowser\",")
+                                   _T("\"startmode\":\"Activated\",\"resumed\":true,\"webui\":\"UI\",\"precondition\":[\"Graphics\",\"Internet\"],")
+                                   _T("\"version\":\"1.0.0\",\"priority\":10,\"persistentpathpostfix\":\"browser\"}");
+
+    class RuntimeConfig : public Core::JSON::Container {
+    public:
+        RuntimeConfig(const RuntimeConfig&) = delete;
+        RuntimeConfig& operator=(const RuntimeConfig&) = delete;
+
+        RuntimeConfig()
+            : Core::JSON::Container()
+        {
+            Add(_T("callsign"), &Callsign);
+            Add(_T("locator"), &Locator);
+            Add(_T("classname"), &ClassName);
+            Add(_T("startmode"), &StartMode);
+            Add(_T("resumed"), &Resumed);
+            Add(_T("webui"), &WebUI);
+            Add(_T("precondition"), &Precondition);
+            Add(_T("version"), &Version);
+            Add(_T("priority"), &Priority);
+            Add(_T("persistentpathpostfix"), &PersistentPathPostfix);
+        }
+        ~RuntimeConfig() override = default;
+
+    public:
+        Core::JSON::String Callsign;
+        Core::JSON::String Locator;
+        Core::JSON::String ClassName;
+        Core::JSON::String StartMode;
+        Core::JSON::Boolean Resumed;
+        Core::JSON::String WebUI;
+        Core::JSON::ArrayType<Core::JSON::String> Precondition;
+        Core::JSON::String Version;
+        Core::JSON::DecUInt8 Priority;
+        Core::JSON::String PersistentPathPostfix;
+    };
+
+    class StaticConfig : public Core::JSON::Container {
+    public:
+        StaticConfig(const StaticConfig&) = delete;
+        StaticConfig& operator=(const StaticConfig&) = delete;
+
+        StaticConfig()
+            : Core::JSON::Container(Fields())
+        {
+        }
+        ~StaticConfig() override = default;
+
+    public:
+        Core::JSON::String Callsign;
+        Core::JSON::String Locator;
+        Core::JSON::String ClassName;
+        Core::JSON::String StartMode;
+        Core::JSON::Boolean Resumed;
+        Core::JSON::String WebUI;
+        Core::JSON::ArrayType<Core::JSON::String> Precondition;
+        Core::JSON::String Version;
+        Core::JSON::DecUInt8 Priority;
+        Core::JSON::String PersistentPathPostfix;
+
+    private:
+        static const Core::JSON::Container::FieldTable& Fields()
+        {
+            static constexpr Core::JSON::Container::Field fields[] = {
+                JSON_FIELD(StaticConfig, _T("callsign"), Callsign),
+                JSON_FIELD(StaticConfig, _T("locator"), Locator),
+                JSON_FIELD(StaticConfig, _T("classname"), ClassName),
+                JSON_FIELD(StaticConfig, _T("startmode"), StartMode),
+                JSON_FIELD(StaticConfig, _T("resumed"), Resumed),
+                JSON_FIELD(StaticConfig, _T("webui"), WebUI),
+                JSON_FIELD(StaticConfig, _T("precondition"), Precondition),
+                JSON_FIELD(StaticConfig, _T("version"), Version),
+                JSON_FIELD(StaticConfig, _T("priority"), Priority),
+                JSON_FIELD(StaticConfig, _T("persistentpathpostfix"), PersistentPathPostfix)
+            };
+            static constexpr Core::JSON::Container::FieldTable table(fields);
+            return (table);
+        }
+    };
+
+    template <typename CONTAINER>
+    static void Containers(const uint32_t duration, const char name[])
+    {
+        char label[64];
+
+        Measure construct(duration);
+        construct.Run([&]() {
+            CONTAINER config;
+            (void) config.IsSet();
+        });
+        snprintf(label, sizeof(label), "%s construct", name);
+        construct.Report(label);
+
+        Measure parse(duration);
+        parse.Run([&]() {
+            CONTAINER config;
+            config.FromString(Document);
+        });
+        snprintf(label, sizeof(label), "%s construct + parse", name);
+        parse.Report(label, Document.length());
+
+        CONTAINER config;
+        string json;
+        config.FromString(Document);
+
+        Measure serialize(duration);
+        serialize.Run([&]() {
+            json.clear();
+            config.ToString(json);
+        });
+        snprintf(label, sizeof(label), "%s serialize", name);
+        serialize.Report(label, json.length());
+    }
+
+    template <typename ELEMENT, typename FILL>
+    static void Arrays(const uint32_t duration, const char name[], const uint16_t count, FILL&& fill)
+    {
+        char label[64];
+        string json;
+
+        Measure build(duration);
+        build.Run([&]() {
+            Core::JSON::ArrayType<ELEMENT> array;
+            for (uint16_t index = 0; index < count; index++) {
+                fill(array.Add(), index);
+            }
+        });
+        snprintf(label, sizeof(label), "%s[%u] build", name, count);
+        build.Report(label);
+
+        Core::JSON::ArrayType<ELEMENT> source;
+        for (uint16_t index = 0; index < count; index++) {
+            fill(source.Add(), index);
+        }
+        source.ToString(json);
+
+        Measure serialize(duration);
+        serialize.Run([&]() {
+            string output;
+            source.ToString(output);
+        });
+        snprintf(label, sizeof(label), "%s[%u] serialize", name, count);
+        serialize.Report(label, json.length());
+
+        Measure parse(duration);
+        parse.Run([&]() {
+            Core::JSON::ArrayType<ELEMENT> array;
+            array.FromString(json);
+        });
+        snprintf(label, sizeof(label), "%s[%u] parse", name, count);
+        parse.Report(label, json.length());
+
+        Measure index(duration);
+        index.Run([&]() {
+            uint32_t sum = 0;
+            for (uint16_t position = 0; position < count; position += 97) {
+                sum += static_cast<uint32_t>(source[position].IsSet());
+            }
+            (void) sum;
+        });
+        snprintf(label, sizeof(label), "%s[%u] index", name, count);
+        index.Report(label);
+    }
+
+    static void Strings(const uint32_t duration, const char name[], const string& text)
+    {
+        char label[64];
+        string json;
+
+        Core::JSON::String source;
+        source = text;
+        source.ToString(json);
+
+        Measure serialize(duration);
+        serialize.Run([&]() {
+            string output;
+            source.ToString(output);
+        });
+        snprintf(label, sizeof(label), "%s[%u] serialize", name, static_cast<uint32_t>(text.length()));
+        serialize.Report(label, json.length());
+
+        Measure parse(duration);
+        parse.Run([&]() {
+            Core::JSON::String element;
+            element.FromString(json);
+        });
+        snprintf(label, sizeof(label), "%s[%u] parse", name, static_cast<uint32_t>(text.length()));
+        parse.Report(label, json.length());
+    }
+
+} // namespace Benchmark
+} // namespace Thunder
+
+int main(int argc, char* argv[])
+{
+    using namespace Thunder;
+
+    const uint32_t duration = (argc > 1 ? static_cast<uint32_t>(atoi(argv[1])) : 500);
+
+    Benchmark::Containers<Benchmark::RuntimeConfig>(duration, "runtime fields");
+    Benchmark::Containers<Benchmark::StaticConfig>(duration, "compile time fields");
+
+    Benchmark::Arrays<Core::JSON::DecUInt32>(duration, "DecUInt32", 10000, [](Core::JSON::DecUInt32& element, const uint16_t index) {
+        element = index * 7919;
+    });
+    Benchmark::Arrays<Core::JSON::DecSInt64>(duration, "DecSInt64", 10000, [](Core::JSON::DecSInt64& element, const uint16_t index) {
+        element = (static_cast<int64_t>(index) - 5000) * 1000000007LL;
+    });
+    Benchmark::Arrays<Core::JSON::HexUInt32>(duration, "HexUInt32", 10000, [](Core::JSON::HexUInt32& element, const uint16_t index) {
+        element = index * 2654435761u;
+    });
+    Benchmark::Arrays<Core::JSON::Double>(duration, "Double", 10000, [](Core::JSON::Double& element, const uint16_t index) {
+        element = (index * 0.37) - 1234.5;
+    });
+    Benchmark::Arrays<Core::JSON::Float>(duration, "Float", 10000, [](Core::JSON::Float& element, const uint16_t index) {
+        element = static_cast<float>(index) / 7.0f;
+    });
+    Benchmark::Arrays<Core::JSON::String>(duration, "String", 10000, [](Core::JSON::String& element, const uint16_t index) {
+        element = _T("element_") + Core::NumberType<uint16_t>(index).Text();
+    });
+    Benchmark::Arrays<Benchmark::StaticConfig>(duration, "Config", 10000, [](Benchmark::StaticConfig& element, const uint16_t index) {
+        element.Callsign = _T("Plugin") + Core::NumberType<uint16_t>(index).Text();
+        element.Priority = static_cast<uint8_t>(index);
+        element.Resumed = true;
+    });
+
+
+    string plain;
+    string escaped;
+    for (uint32_t index = 0; index < 64 * 1024; index++) {
+        plain += static_cast<char>('a' + (index % 26));
+        escaped += ((index % 64) == 63 ? '\n' : static_cast<char>('a' + (index % 26)));
+    }
+    Benchmark::Strings(duration, "plain text", plain);
+    Benchmark::Strings(duration, "text with newlines", escaped);
+
+    Core::Singleton::Dispose();
+
+    return (0);
+}
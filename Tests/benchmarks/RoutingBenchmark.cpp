@@ -0,0 +1,210 @@
+/*
+ * If not stated otherwise in this file or this component's LICENSE file the
+ * following copyright and licenses apply:
+ *
+ * Copyright 2021 Metrological
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+// Request routing: every request path is resolved to the plugin serving it, as the ServiceMap
+// does for each HTTP, WebSocket and JSON-RPC request. Compares the lookup in a map behind a
+// lock, with the callsign copied out of the path, against the lock free read-mostly index,
+// for a growing number of channels routing concurrently.
+//
+//   cmake -DBENCHMARKS=ON ...
+//   RoutingBenchmark [milliseconds per measurement]
+
+#include "Benchmark.h"
+
+#include <atomic>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+namespace Thunder {
+namespace Benchmark {
+
+    static constexpr uint32_t Plugins = 200;
+    static constexpr uint32_t MaxChannels = 32;
+
+    class Plugin {
+    public:
+        Plugin() = delete;
+        Plugin(Plugin&&) = delete;
+        Plugin(const Plugin&) = delete;
+        Plugin& operator=(Plugin&&) = delete;
+        Plugin& operator=(const Plugin&) = delete;
+
+        explicit Plugin(const string& callsign)
+            : _callsign(callsign)
+        {
+        }
+        ~Plugin() = default;
+
+    public:
+        const string& Callsign() const
+        {
+            return (_callsign);
+        }
+
+    private:
+        const string _callsign;
+    };
+
+    using Services = std::unordered_map<string, Core::ProxyType<Plugin>>;
+
+    static constexpr TCHAR Prefix[] = _T("/Service");
+
+    static uint32_t Offset()
+    {
+        return (static_cast<uint32_t>(sizeof(Prefix) / sizeof(TCHAR)));
+    }
+
+    // The way the lookup was done: callsign copied out of the path, map searched under the lock.
+    class Locked {
+    public:
+        Locked(const Locked&) = delete;
+        Locked& operator=(const Locked&) = delete;
+
+        explicit Locked(const Services& services)
+            : _lock()
+            , _services(services)
+        {
+        }
+        ~Locked() = default;
+
+    public:
+        bool Route(const string& path, Core::ProxyType<Plugin>& plugin) const
+        {
+            bool result = false;
+            const size_t end = path.find_first_of('/', Offset());
+            const string callsign(path.substr(Offset(), (end == string::npos ? string::npos : end - Offset())));
+
+            _lock.Lock();
+
+            Services::const_iterator index(_services.find(callsign));
+            if (index != _services.cend()) {
+                plugin = index->second;
+                result = true;
+            }
+
+            _lock.Unlock();
+
+            return (result);
+        }
+
+    private:
+        mutable Core::CriticalSection _lock;
+        Services _services;
+    };
+
+    class Indexed {
+    public:
+        Indexed(const Indexed&) = delete;
+        Indexed& operator=(const Indexed&) = delete;
+
+        explicit Indexed(const Services& services)
+            : _index()
+        {
+            _index.Publish(services.cbegin(), services.cend());
+        }
+        ~Indexed() = default;
+
+    public:
+        bool Route(const string& path, Core::ProxyType<Plugin>& plugin) const
+        {
+            const size_t end = path.find_first_of('/', Offset());
+            return (_index.Find(&(path[Offset()]), static_cast<uint32_t>((end == string::npos ? path.length() : end) - Offset()), plugin));
+        }
+
+    private:
+        Core::ReadMostlyMapType<Core::ProxyType<Plugin>> _index;
+    };
+
+    // Runs <channels> threads routing requests for <duration> ms, returns the ns per routed request.
+    template <typename ROUTER>
+    static double Measure(const ROUTER& router, const std::vector<string>& paths, const uint32_t channels, const uint32_t duration)
+    {
+        std::atomic<bool> running(true);
+        std::atomic<uint64_t> routed(0);
+        std::vector<std::thread> threads;
+
+        const auto start = std::chrono::steady_clock::now();
+
+        for (uint32_t channel = 0; channel < channels; channel++) {
+            threads.emplace_back([&, channel]() {
+                Core::ProxyType<Plugin> plugin;
+                uint64_t count = 0;
+                uint32_t index = channel * 7;
+
+                while (running.load(std::memory_order_relaxed) == true) {
+                    if (router.Route(paths[index % paths.size()], plugin) == true) {
+                        count++;
+                    }
+                    index++;
+                }
+
+                routed += count;
+            });
+        }
+
+        std::this_thread::sleep_for(std::chrono::milliseconds(duration));
+        running = false;
+
+        for (std::thread& thread : threads) {
+            thread.join();
+        }
+
+        const double elapsed = static_cast<double>(std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start).count());
+
+        return (routed == 0 ? 0.0 : elapsed / static_cast<double>(routed.load()));
+    }
+
+} // namespace Benchmark
+} // namespace Thunder
+
+int main(int argc, char* argv[])
+{
+    using namespace Thunder;
+
+    const uint32_t duration = (argc > 1 ? static_cast<uint32_t>(atoi(argv[1])) : 500);
+
+    {
+        Benchmark::Services services;
+        std::vector<string> paths;
+
+        for (uint32_t index = 0; index < Benchmark::Plugins; index++) {
+            const string callsign(_T("Plugin") + std::to_string(index));
+            services.emplace(callsign, Core::ProxyType<Benchmark::Plugin>::Create(callsign));
+            paths.emplace_back(string(Benchmark::Prefix) + '/' + callsign + _T("/method"));
+        }
+
+        const Benchmark::Locked locked(services);
+        const Benchmark::Indexed indexed(services);
+
+        printf("Routing over %u plugins, %u cores\n", Benchmark::Plugins, std::thread::hardware_concurrency());
+        printf("%-10s %16s %16s\n", "channels", "locked ns/req", "indexed ns/req");
+
+        for (uint32_t channels = 1; channels <= Benchmark::MaxChannels; channels <<= 1) {
+            const double before = Benchmark::Measure(locked, paths, channels, duration);
+            const double after = Benchmark::Measure(indexed, paths, channels, duration);
+
+            printf("%-10u %16.1f %16.1f\n", channels, before, after);
+        }
+    }
+
+    Core::Singleton::Dispose();
+
+    return (0);
+}
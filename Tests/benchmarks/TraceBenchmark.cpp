@@ -0,0 +1,154 @@
+/*
+ * If not stated otherwise in this file or this component's LICENSE file the
+ * following copyright and licenses apply:
+ *
+ * Copyright 2021 Metrological
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+// Cost of a TRACE statement in a tight loop: for a category left out of the build, for a category
+// that is disabled at runtime and for an enabled category pushed to the message buffer. For the
+// latter the trace information is built per message, as was done before, and prepared once per
+// call site. Heap allocations per trace are counted as well.
+//
+//   cmake -DBENCHMARKS=ON -DMESSAGING=ON ...
+//   TraceBenchmark [milliseconds per measurement]
+
+#include "Benchmark.h"
+
+#include <messaging/messaging.h>
+
+#include <atomic>
+#include <new>
+
+static std::atomic<uint64_t> Allocations(0);
+
+void* operator new(size_t size)
+{
+    Allocations++;
+
+    void* result = ::malloc(size == 0 ? 1 : size);
+
+    if (result == nullptr) {
+        throw std::bad_alloc();
+    }
+
+    return (result);
+}
+
+void operator delete(void* pointer) noexcept
+{
+    ::free(pointer);
+}
+
+void operator delete(void* pointer, size_t) noexcept
+{
+    ::free(pointer);
+}
+
+namespace Thunder {
+namespace Benchmark {
+
+    DEFINE_MESSAGING_CATEGORY(Core::Messaging::BaseCategoryType<Core::Messaging::Metadata::type::TRACING>, Enabled)
+    DEFINE_MESSAGING_CATEGORY(Core::Messaging::BaseCategoryType<Core::Messaging::Metadata::type::TRACING>, Disabled)
+    DEFINE_MESSAGING_CATEGORY(Core::Messaging::BaseCategoryType<Core::Messaging::Metadata::type::TRACING>, Excluded)
+
+}
+}
+
+TRACE_CATEGORY_BUILD(Thunder::Benchmark::Excluded, false)
+
+namespace Thunder {
+namespace Benchmark {
+
+    class Tracer {
+    public:
+        Tracer(const Tracer&) = delete;
+        Tracer& operator=(const Tracer&) = delete;
+
+        Tracer()
+            : _value(0)
+        {
+        }
+        ~Tracer() = default;
+
+    public:
+        void Excluded()
+        {
+            TRACE(Benchmark::Excluded, (_T("value %u"), _value++));
+        }
+        void Disabled()
+        {
+            TRACE(Benchmark::Disabled, (_T("value %u"), _value++));
+        }
+        void Enabled()
+        {
+            TRACE(Benchmark::Enabled, (_T("value %u"), _value++));
+        }
+        void PerMessage()
+        {
+            // What a TRACE statement used to do for every message.
+            using Control = TRACE_CONTROL(Benchmark::Enabled);
+
+            if (Control::IsEnabled() == true) {
+                Benchmark::Enabled data(_T("value %u"), _value++);
+                Core::Messaging::MessageInfo info(Control::Metadata(), Core::Time::Now().Ticks());
+                Core::Messaging::IStore::Tracing trace(info, __FILE__, __LINE__, Core::ClassNameOnly(typeid(*this).name()).Text());
+                Core::Messaging::TextMessage message(data.Data());
+                Messaging::MessageUnit::Instance().Push(trace, &message, Control::Routing());
+            }
+        }
+
+    private:
+        uint32_t _value;
+    };
+
+    template <typename OPERATION>
+    static void Report(const uint32_t duration, const char label[], OPERATION&& operation)
+    {
+        Measure measure(duration);
+
+        const uint64_t before = Allocations;
+        measure.Run(operation);
+        const uint64_t allocations = Allocations - before;
+
+        printf("%-48s %12.1f ns/op %8.2f allocations/op\n", label, measure.NanosecondsPerOperation(),
+            (measure.Iterations() == 0 ? 0.0 : static_cast<double>(allocations) / static_cast<double>(measure.Iterations())));
+    }
+
+} // namespace Benchmark
+} // namespace Thunder
+
+int main(int argc, char* argv[])
+{
+    using namespace Thunder;
+
+    const uint32_t duration = (argc > 1 ? static_cast<uint32_t>(atoi(argv[1])) : 500);
+
+    Messaging::MessageUnit::Settings::Config configuration;
+    configuration.FromString(_T("{\"tracing\":{\"settings\":[{\"category\":\"Enabled\",\"enabled\":true}]}}"));
+    Messaging::MessageUnit::Instance().Open(_T("/tmp/"), configuration, false, Messaging::MessageUnit::OFF);
+
+    Benchmark::Tracer tracer;
+
+    Benchmark::Report(duration, "TRACE, category left out of the build", [&tracer]() { tracer.Excluded(); });
+    Benchmark::Report(duration, "TRACE, category disabled", [&tracer]() { tracer.Disabled(); });
+    Benchmark::Report(duration, "TRACE, enabled, information per message", [&tracer]() { tracer.PerMessage(); });
+    Benchmark::Report(duration, "TRACE, enabled, information per call site", [&tracer]() { tracer.Enabled(); });
+
+    Messaging::MessageUnit::Instance().Close();
+    Core::Singleton::Dispose();
+
+    return (0);
+}
@@ -18,7 +18,8 @@ private:
 public:
     static constexpr uint8_t SIZE_OFFSET = 0;
     static constexpr uint8_t MESSAGE_ID_OFFSET = (SIZE_OFFSET + sizeof(uint8_t)); // 1
-    static constexpr uint8_t IMPLEMENTATION_OFFSET = (MESSAGE_ID_OFFSET + sizeof(uint8_t)); // 2
+    static constexpr uint8_t SEQUENCE_OFFSET = (MESSAGE_ID_OFFSET + sizeof(uint8_t)); // 2
+    static constexpr uint8_t IMPLEMENTATION_OFFSET = (SEQUENCE_OFFSET + sizeof(uint8_t)); // 3
 
     Message() = delete;
 
@@ -33,6 +34,7 @@ public:
     {
         Clear();
         SetNumber(MESSAGE_ID_OFFSET, SetMessageType(operator[](MESSAGE_ID_OFFSET), type));
+        SetNumber<uint8_t>(SEQUENCE_OFFSET, 1);
     }
     ~Message() = default;
 
@@ -594,7 +596,7 @@ int main(int argc, char** argv)
 
                     printf("Ingest junk data %d.\n", MessageSize);
 
-                    for (uint32_t i = 2; i < MessageSize; i++) {
+                    for (uint32_t i = Message::IMPLEMENTATION_OFFSET; i < MessageSize; i++) {
                         junkData.SetNumber<uint8_t>(i, randomByte(rng));
                     }
 
@@ -690,4 +692,4 @@ int main(int argc, char** argv)
     }
 
     return (result);
-}
\ No newline at end of file
+}
@@ -0,0 +1,243 @@
+/*
+ * If not stated otherwise in this file or this component's LICENSE file the
+ * following copyright and licenses apply:
+ *
+ * Copyright 2020 Metrological
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+//
+// Hibernate round trip
+// ====================
+// Forks a synthetic process holding a known memory image, hibernates and wakes
+// it a number of times and lets it verify its memory after every wakeup. Between
+// cycles a small part of the image is changed, so with an incremental engine the
+// later hibernations only write those pages.
+//
+// How to build (from your Thunder build directory):
+//   cmake -DHIBERNATESUPPORT=ON -DHIBERNATE_PAGESTORE=ON -DHIBERNATE_TEST=ON ...
+//   make HibernateTest
+//
+// Usage: HibernateTest [megabytes] [cycles] [volatile dir]
+//
+
+#include <hibernate/hibernate.h>
+
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <thread>
+
+#include <signal.h>
+#include <sys/mman.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+namespace {
+
+    constexpr uint32_t Timeout = 10000;
+    constexpr uint32_t Stride = 16;
+
+    uint64_t Pattern(const uint64_t page, const uint32_t round)
+    {
+        return ((page * 0x9E3779B97F4A7C15ULL) ^ round);
+    }
+
+    // The synthetic process: a page aligned image it keeps stamping and checking on request,
+    // next to a thread that keeps spinning and one that keeps sleeping.
+    void Child(const int commands, const int replies, const size_t size)
+    {
+        std::atomic<bool> running(true);
+        std::atomic<uint64_t> spins(0);
+        std::thread spinner([&]() { while (running == true) { spins++; } });
+        std::thread sleeper([&]() { while (running == true) { usleep(1000); } });
+
+        const size_t pageSize = sysconf(_SC_PAGESIZE);
+        const size_t pages = size / pageSize;
+        uint8_t* image = static_cast<uint8_t*>(mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0));
+        uint32_t* rounds = static_cast<uint32_t*>(calloc(pages, sizeof(uint32_t)));
+        char command = 0;
+        char reply = (((image != MAP_FAILED) && (rounds != nullptr)) ? 'r' : 'x');
+
+        for (size_t page = 0; (reply == 'r') && (page < pages); page++) {
+            uint64_t* words = reinterpret_cast<uint64_t*>(&image[page * pageSize]);
+            // Leave every 8th page zero, those are stored without content.
+            if ((page % 8) != 7) {
+                for (size_t word = 0; word < (pageSize / sizeof(uint64_t)); word++) {
+                    words[word] = Pattern(page, 0) + word;
+                }
+            }
+        }
+
+        if (write(replies, &reply, 1) == 1) {
+            uint32_t round = 0;
+
+            while ((reply != 'x') && (read(commands, &command, 1) == 1)) {
+                if (command == 'v') {
+                    reply = 'y';
+                    for (size_t page = 0; (reply == 'y') && (page < pages); page++) {
+                        const uint64_t* words = reinterpret_cast<const uint64_t*>(&image[page * pageSize]);
+                        const bool zero = (((page % 8) == 7) && (rounds[page] == 0));
+                        for (size_t word = 0; (reply == 'y') && (word < (pageSize / sizeof(uint64_t))); word++) {
+                            if (words[word] != (zero == true ? 0 : Pattern(page, rounds[page]) + word)) {
+                                reply = 'n';
+                            }
+                        }
+                    }
+                } else if (command == 'm') {
+                    round++;
+                    for (size_t page = (round % Stride); page < pages; page += Stride) {
+                        uint64_t* words = reinterpret_cast<uint64_t*>(&image[page * pageSize]);
+                        rounds[page] = round;
+                        for (size_t word = 0; word < (pageSize / sizeof(uint64_t)); word++) {
+                            words[word] = Pattern(page, round) + word;
+                        }
+                    }
+                    reply = 'y';
+                } else {
+                    reply = 'x';
+                }
+                if (write(replies, &reply, 1) != 1) {
+                    reply = 'x';
+                }
+            }
+        }
+
+        running = false;
+        spinner.join();
+        sleeper.join();
+
+        _exit(0);
+    }
+
+    size_t Resident(const pid_t pid)
+    {
+        size_t result = 0;
+        char path[64];
+        char line[256];
+
+        snprintf(path, sizeof(path), "/proc/%d/status", pid);
+
+        FILE* status = fopen(path, "r");
+        if (status != nullptr) {
+            while (fgets(line, sizeof(line), status) != nullptr) {
+                if (strncmp(line, "VmRSS:", 6) == 0) {
+                    result = strtoul(&line[6], nullptr, 10);
+                }
+            }
+            fclose(status);
+        }
+
+        return (result);
+    }
+
+    bool Request(const int commands, const int replies, const char command)
+    {
+        char reply = 0;
+        return ((write(commands, &command, 1) == 1) && (read(replies, &reply, 1) == 1) && (reply == 'y'));
+    }
+
+    double Since(const std::chrono::steady_clock::time_point& start)
+    {
+        return (std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count());
+    }
+}
+
+int main(int argc, char* argv[])
+{
+    const size_t megabytes = (argc > 1 ? strtoul(argv[1], nullptr, 10) : 64);
+    const uint32_t cycles = (argc > 2 ? strtoul(argv[2], nullptr, 10) : 4);
+    const std::string directory = (argc > 3 ? argv[3] : "/tmp/HibernateTest/");
+    int commands[2];
+    int replies[2];
+    void* storage = nullptr;
+    int result = 1;
+    char ready = 0;
+
+    if ((pipe(commands) != 0) || (pipe(replies) != 0)) {
+        perror("pipe");
+        return (1);
+    }
+
+    const pid_t child = fork();
+
+    if (child == 0) {
+        close(commands[1]);
+        close(replies[0]);
+        Child(commands[0], replies[1], megabytes * 1024 * 1024);
+    }
+
+    close(commands[0]);
+    close(replies[1]);
+
+    if ((child > 0) && (read(replies[0], &ready, 1) == 1) && (ready == 'r')) {
+        uint32_t cycle = 0;
+
+        result = 0;
+
+        for (; (cycle < cycles) && (result == 0); cycle++) {
+            const size_t before = Resident(child);
+
+            auto start = std::chrono::steady_clock::now();
+            uint32_t error = HibernateProcess(Timeout, child, "", directory.c_str(), &storage);
+            const double hibernate = Since(start);
+            const size_t during = Resident(child);
+
+            if (error != HIBERNATE_ERROR_NONE) {
+                printf("Cycle %u: hibernate failed [%u]\n", cycle, error);
+                result = 1;
+            } else {
+                start = std::chrono::steady_clock::now();
+                error = WakeupProcess(Timeout, child, "", directory.c_str(), &storage);
+                const double wakeup = Since(start);
+
+                if (error != HIBERNATE_ERROR_NONE) {
+                    printf("Cycle %u: wakeup failed [%u]\n", cycle, error);
+                    result = 1;
+                } else if (Request(commands[1], replies[0], 'v') == false) {
+                    printf("Cycle %u: memory image corrupted after wakeup\n", cycle);
+                    result = 1;
+                } else {
+                    printf("Cycle %u: RSS %zu kB -> %zu kB, hibernate %.1f ms, wakeup %.1f ms\n", cycle, before, during, hibernate, wakeup);
+
+                    if (during >= (before / 2)) {
+                        printf("Cycle %u: memory was not released\n", cycle);
+                        result = 1;
+                    } else if (Request(commands[1], replies[0], 'm') == false) {
+                        printf("Cycle %u: process did not respond\n", cycle);
+                        result = 1;
+                    }
+                }
+            }
+        }
+
+        printf("%s after %u cycles\n", (result == 0 ? "PASS" : "FAIL"), cycle);
+    } else {
+        printf("FAIL: synthetic process did not start\n");
+    }
+
+    if (child > 0) {
+        kill(child, SIGCONT);
+        close(commands[1]);
+        waitpid(child, nullptr, 0);
+
+        // The process is gone, this releases its page store.
+        WakeupProcess(Timeout, child, "", directory.c_str(), &storage);
+    }
+
+    return (result);
+}
@@ -228,7 +228,8 @@ namespace TestCore {
 
     string ThunderTestRuntime::BuildConfigJSON(const std::vector<PluginConfig>& plugins,
         const string& systemPath,
-        const string& proxyStubPath) const
+        const string& proxyStubPath,
+        const JsonObject& settings) const
     {
         const string communicatorPath = _tempDir + "communicator|0777";
 
@@ -262,6 +263,11 @@ namespace TestCore {
 
         config["plugins"] = pluginList;
 
+        JsonObject::Iterator index(settings.Variants());
+        while (index.Next() == true) {
+            config[index.Label()] = index.Current();
+        }
+
         string json;
         config.ToString(json);
 
@@ -270,7 +276,8 @@ namespace TestCore {
 
     uint32_t ThunderTestRuntime::Initialize(const std::vector<PluginConfig>& plugins,
         const string& systemPath,
-        const string& proxyStubPath)
+        const string& proxyStubPath,
+        const JsonObject& settings)
     {
         if (_server != nullptr) {
             return Core::ERROR_ALREADY_CONNECTED;
@@ -294,7 +301,7 @@ namespace TestCore {
             ? Core::Directory::Normalize(DEFAULT_PROXYSTUB_PATH)
             : Core::Directory::Normalize(proxyStubPath);
 
-        const string configJSON = BuildConfigJSON(plugins, sysPath, _proxyStubPath);
+        const string configJSON = BuildConfigJSON(plugins, sysPath, _proxyStubPath, settings);
         if (configJSON.empty()) {
             CleanupDirectories();
             _tempDir.clear();
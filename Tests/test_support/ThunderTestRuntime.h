@@ -80,9 +80,11 @@ namespace TestCore {
         ThunderTestRuntime(const ThunderTestRuntime&) = delete;
         ThunderTestRuntime& operator=(const ThunderTestRuntime&) = delete;
 
+        // Entries in settings override (or add to) the top level of the generated Thunder configuration.
         uint32_t Initialize(const std::vector<PluginConfig>& plugins,
             const string& systemPath = "",
-            const string& proxyStubPath = "");
+            const string& proxyStubPath = "",
+            const JsonObject& settings = JsonObject());
 
         Core::ProxyType<JSONRPCLink> CreateJSONRPCLink(const string& callsign);
         uint32_t Invoke(const string& method, const string& params, string& response);
@@ -110,7 +112,8 @@ namespace TestCore {
     private:
         string BuildConfigJSON(const std::vector<PluginConfig>& plugins,
             const string& systemPath,
-            const string& proxyStubPath) const;
+            const string& proxyStubPath,
+            const JsonObject& settings) const;
         bool CreateDirectories() const;
         void CleanupDirectories() const;
 
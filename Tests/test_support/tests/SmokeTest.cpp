@@ -4,19 +4,57 @@
 #include <gtest/gtest.h>
 #include <string>
 
+#include <websocket/websocket.h>
+
+#include <netinet/in.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
 namespace Thunder {
 namespace TestCore {
 namespace Tests {
 
+    // Asks the kernel for a port that is free right now, so the listener can be reached on a known port.
+    static uint16_t FreePort()
+    {
+        uint16_t port = 0;
+        int fd = ::socket(AF_INET, SOCK_STREAM, 0);
+
+        if (fd >= 0) {
+            struct sockaddr_in address {};
+            socklen_t length = sizeof(address);
+
+            address.sin_family = AF_INET;
+            address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+
+            if ((::bind(fd, reinterpret_cast<struct sockaddr*>(&address), sizeof(address)) == 0) &&
+                (::getsockname(fd, reinterpret_cast<struct sockaddr*>(&address), &length) == 0)) {
+                port = ntohs(address.sin_port);
+            }
+
+            ::close(fd);
+        }
+
+        return (port);
+    }
+
     class SmokeTest : public ::testing::Test {
     protected:
         static ThunderTestRuntime _runtime;
+        static uint16_t _port;
 
         static void SetUpTestSuite()
         {
             std::vector<ThunderTestRuntime::PluginConfig> plugins;
+            JsonObject settings;
+
+            _port = FreePort();
 
-            const uint32_t result = _runtime.Initialize(plugins);
+            // A single slot per channel, so everything beyond one request waits in the channel queue.
+            settings["port"] = _port;
+            settings["channel_throttle"] = 1;
+
+            const uint32_t result = _runtime.Initialize(plugins, "", "", settings);
             ASSERT_EQ(result, Core::ERROR_NONE) << "Failed to initialize Thunder runtime";
         }
 
@@ -27,6 +65,7 @@ namespace Tests {
     };
 
     ThunderTestRuntime SmokeTest::_runtime;
+    uint16_t SmokeTest::_port = 0;
 
     TEST_F(SmokeTest, ControllerStatusViaFullDesignator)
     {
@@ -143,6 +182,45 @@ namespace Tests {
         EXPECT_EQ(result, Core::ERROR_UNKNOWN_METHOD);
     }
 
+    // --- JSON-RPC batch over the websocket listener ---
+
+    TEST_F(SmokeTest, BatchMembersGoThroughTheChannelQueue)
+    {
+        constexpr uint32_t waitTime = 5000;
+
+        using Link = JSONRPC::LinkType<Core::JSON::IElement>;
+
+        ASSERT_NE(_port, 0);
+
+        Core::SystemInfo::SetEnvironment(_T("THUNDER_ACCESS"), _T("127.0.0.1:") + Core::NumberType<uint16_t>(_port).Text());
+
+        Link link(_T("Controller"));
+        Link::Batch batch(link);
+        std::vector<Link::Future> pending;
+
+        // Far more members than the channel has slots, each one has to hand its slot back.
+        for (uint32_t i = 0; i < 16; i++) {
+            pending.push_back(batch.Add(_T("subsystems")));
+        }
+        Link::Future failing(batch.Add(_T("thisMethodDoesNotExist")));
+
+        EXPECT_EQ(batch.Submit(waitTime), Core::ERROR_NONE);
+
+        for (const Link::Future& future : pending) {
+            ASSERT_EQ(future.Wait(waitTime), Core::ERROR_NONE);
+            EXPECT_EQ(future.Get(), Core::ERROR_NONE);
+        }
+
+        ASSERT_EQ(failing.Wait(waitTime), Core::ERROR_NONE);
+        EXPECT_EQ(failing.Get(), Core::ERROR_UNKNOWN_METHOD);
+
+        // The batch left no slot behind, a plain request on the same connection still gets through.
+        Link::Future single(link.Request(waitTime, _T("subsystems")));
+
+        ASSERT_EQ(single.Wait(waitTime), Core::ERROR_NONE);
+        EXPECT_EQ(single.Get(), Core::ERROR_NONE);
+    }
+
 } // namespace Tests
 } // namespace TestCore
 } // namespace Thunder
\ No newline at end of file
@@ -0,0 +1,308 @@
+/*
+ * If not stated otherwise in this file or this component's LICENSE file the
+ * following copyright and licenses apply:
+ *
+ * Copyright 2020 Metrological
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <gtest/gtest.h>
+
+#ifndef MODULE_NAME
+#include "../Module.h"
+#endif
+
+#include <core/core.h>
+#include <com/com.h>
+
+#include <algorithm>
+#include <map>
+#include <memory>
+#include <random>
+
+namespace Thunder {
+namespace Tests {
+namespace Core {
+
+    namespace {
+
+        using Administrator = ::Thunder::RPC::Administrator;
+
+        constexpr uint32_t Channel = 1;
+
+        // The object the proxies stand in for, never called.
+        class Subject : public ::Thunder::Core::IUnknown {
+        public:
+            Subject(Subject&&) = delete;
+            Subject(const Subject&) = delete;
+            Subject& operator=(Subject&&) = delete;
+            Subject& operator=(const Subject&) = delete;
+
+            Subject() = default;
+            ~Subject() override = default;
+
+        public:
+            uint32_t AddRef() const override
+            {
+                return (::Thunder::Core::ERROR_NONE);
+            }
+            uint32_t Release() const override
+            {
+                return (::Thunder::Core::ERROR_NONE);
+            }
+            void* QueryInterface(const uint32_t, const bool) override
+            {
+                return (nullptr);
+            }
+        };
+
+        class Proxy : public ::Thunder::ProxyStub::UnknownProxy {
+        public:
+            Proxy() = delete;
+            Proxy(Proxy&&) = delete;
+            Proxy(const Proxy&) = delete;
+            Proxy& operator=(Proxy&&) = delete;
+            Proxy& operator=(const Proxy&) = delete;
+
+            Proxy(Subject& subject, const ::Thunder::Core::instance_id implementation, const uint32_t id)
+                : ::Thunder::ProxyStub::UnknownProxy(::Thunder::Core::ProxyType<::Thunder::Core::IPCChannel>(), implementation, id, false, subject, "Proxy")
+            {
+            }
+            ~Proxy() override = default;
+        };
+
+        // Implementations of interface <id> on the test channel, that start probing from <slot>.
+        std::vector<::Thunder::Core::instance_id> ProxiesAt(const uint32_t slot, const uint32_t capacity, const uint32_t id, const uint32_t count)
+        {
+            std::vector<::Thunder::Core::instance_id> result;
+
+            for (::Thunder::Core::instance_id implementation = 0x1000; result.size() < count; implementation += 8) {
+                if ((Administrator::ProxyIndex::Hash(Channel, implementation, id) & (capacity - 1)) == slot) {
+                    result.push_back(implementation);
+                }
+            }
+
+            return (result);
+        }
+
+        // Interface ids that start probing from <slot>.
+        std::vector<uint32_t> InterfacesAt(const uint32_t slot, const uint32_t capacity, const uint32_t count)
+        {
+            std::vector<uint32_t> result;
+
+            for (uint32_t id = 0x100; result.size() < count; id++) {
+                if ((Administrator::InterfaceTable::Hash(id) & (capacity - 1)) == slot) {
+                    result.push_back(id);
+                }
+            }
+
+            return (result);
+        }
+
+    }
+
+    TEST(Core_Administrator, InterfaceTableCollisionsWrapAround)
+    {
+        Administrator::InterfaceTable table(64);
+
+        // Three colliding on the last slot, they wrap around to the first ones.
+        const std::vector<uint32_t> last(InterfacesAt(63, 64, 4));
+        const std::vector<uint32_t> first(InterfacesAt(0, 64, 1));
+
+        std::vector<std::unique_ptr<Administrator::Interface>> entries;
+
+        for (uint32_t index = 0; index < 3; index++) {
+            entries.emplace_back(new Administrator::Interface(last[index], nullptr, nullptr));
+            table.Insert(entries.back().get());
+        }
+
+        // Its own slot is taken by the wrapped chain.
+        entries.emplace_back(new Administrator::Interface(first[0], nullptr, nullptr));
+        table.Insert(entries.back().get());
+
+        for (const std::unique_ptr<Administrator::Interface>& entry : entries) {
+            EXPECT_EQ(table.Find(entry->Id()), entry.get());
+        }
+
+        // Not there, the probe runs past the whole chain.
+        EXPECT_EQ(table.Find(last[3]), nullptr);
+
+        // A larger copy, as Announce makes when the table fills up, still finds all of them.
+        Administrator::InterfaceTable larger(table.Capacity() * 2);
+
+        table.Visit([&larger](Administrator::Interface& entry) { larger.Insert(&entry); });
+
+        EXPECT_EQ(larger.Capacity(), 128u);
+
+        for (const std::unique_ptr<Administrator::Interface>& entry : entries) {
+            EXPECT_EQ(larger.Find(entry->Id()), entry.get());
+        }
+
+        EXPECT_EQ(larger.Find(last[3]), nullptr);
+    }
+
+    TEST(Core_Administrator, InterfaceTableFillsUpToHalf)
+    {
+        Administrator::InterfaceTable table(8);
+
+        std::vector<std::unique_ptr<Administrator::Interface>> entries;
+
+        for (uint32_t id = 1; table.IsFull() == false; id++) {
+            entries.emplace_back(new Administrator::Interface(id, nullptr, nullptr));
+            table.Insert(entries.back().get());
+        }
+
+        EXPECT_EQ(entries.size(), 4u);
+
+        for (const std::unique_ptr<Administrator::Interface>& entry : entries) {
+            EXPECT_EQ(table.Find(entry->Id()), entry.get());
+        }
+    }
+
+    TEST(Core_Administrator, ProxyIndexRemoveInTheMiddleOfAChain)
+    {
+        Subject subject;
+        Administrator::ProxyIndex index;
+
+        const uint32_t capacity = index.Capacity();
+
+        // A chain starting on the last slot and wrapping around, with one more in the slot it wrapped into.
+        const std::vector<::Thunder::Core::instance_id> last(ProxiesAt(capacity - 1, capacity, 0x42, 3));
+        const std::vector<::Thunder::Core::instance_id> first(ProxiesAt(0, capacity, 0x42, 1));
+
+        Proxy a(subject, last[0], 0x42);
+        Proxy b(subject, last[1], 0x42);
+        Proxy c(subject, last[2], 0x42);
+        Proxy d(subject, first[0], 0x42);
+
+        index.Insert(Channel, &a);
+        index.Insert(Channel, &b);
+        index.Insert(Channel, &c);
+        index.Insert(Channel, &d);
+
+        EXPECT_EQ(index.Count(), 4u);
+
+        // Out of the middle, what follows must be shifted back to stay reachable.
+        index.Remove(Channel, &b);
+
+        EXPECT_EQ(index.Count(), 3u);
+        EXPECT_EQ(index.Find(Channel, last[1], 0x42), nullptr);
+        EXPECT_EQ(index.Find(Channel, last[0], 0x42), &a);
+        EXPECT_EQ(index.Find(Channel, last[2], 0x42), &c);
+        EXPECT_EQ(index.Find(Channel, first[0], 0x42), &d);
+
+        // The head of the chain.
+        index.Remove(Channel, &a);
+
+        EXPECT_EQ(index.Count(), 2u);
+        EXPECT_EQ(index.Find(Channel, last[0], 0x42), nullptr);
+        EXPECT_EQ(index.Find(Channel, last[2], 0x42), &c);
+        EXPECT_EQ(index.Find(Channel, first[0], 0x42), &d);
+
+        // Back in, at the end of the chain.
+        index.Insert(Channel, &b);
+
+        EXPECT_EQ(index.Count(), 3u);
+        EXPECT_EQ(index.Find(Channel, last[1], 0x42), &b);
+        EXPECT_EQ(index.Find(Channel, last[2], 0x42), &c);
+        EXPECT_EQ(index.Find(Channel, first[0], 0x42), &d);
+
+        index.Remove(Channel, &d);
+        index.Remove(Channel, &c);
+        index.Remove(Channel, &b);
+
+        EXPECT_EQ(index.Count(), 0u);
+        EXPECT_EQ(index.Find(Channel, last[1], 0x42), nullptr);
+    }
+
+    TEST(Core_Administrator, ProxyIndexKeys)
+    {
+        Subject subject;
+        Administrator::ProxyIndex index;
+
+        Proxy proxy(subject, 0x1000, 0x42);
+        Proxy other(subject, 0x1000, 0x43);
+        Proxy successor(subject, 0x1000, 0x42);
+
+        index.Insert(Channel, &proxy);
+        index.Insert(Channel, &other);
+
+        // Channel, implementation and interface all make up the key.
+        EXPECT_EQ(index.Find(Channel, 0x1000, 0x42), &proxy);
+        EXPECT_EQ(index.Find(Channel, 0x1000, 0x43), &other);
+        EXPECT_EQ(index.Find(Channel + 1, 0x1000, 0x42), nullptr);
+        EXPECT_EQ(index.Find(Channel, 0x1008, 0x42), nullptr);
+
+        // The latest proxy for a key wins, the one it replaced is not removed with its key.
+        index.Insert(Channel, &successor);
+
+        EXPECT_EQ(index.Count(), 2u);
+        EXPECT_EQ(index.Find(Channel, 0x1000, 0x42), &successor);
+
+        index.Remove(Channel, &proxy);
+
+        EXPECT_EQ(index.Count(), 2u);
+        EXPECT_EQ(index.Find(Channel, 0x1000, 0x42), &successor);
+
+        index.Remove(Channel, &successor);
+        index.Remove(Channel, &other);
+
+        EXPECT_EQ(index.Count(), 0u);
+    }
+
+    TEST(Core_Administrator, ProxyIndexGrowAndRemove)
+    {
+        Subject subject;
+        Administrator::ProxyIndex index;
+
+        const uint32_t capacity = index.Capacity();
+
+        std::vector<std::unique_ptr<Proxy>> proxies;
+        std::map<::Thunder::Core::instance_id, Proxy*> present;
+
+        // Enough to grow twice.
+        for (uint32_t count = 0; count < (capacity * 2); count++) {
+            const ::Thunder::Core::instance_id implementation = 0x1000 + (count * 64);
+
+            proxies.emplace_back(new Proxy(subject, implementation, 0x42));
+            index.Insert(Channel, proxies.back().get());
+            present[implementation] = proxies.back().get();
+        }
+
+        EXPECT_EQ(index.Capacity(), capacity * 4);
+        EXPECT_EQ(index.Count(), capacity * 2);
+
+        // Take them out in a random order, whatever is left must be found after every removal.
+        std::vector<Proxy*> order;
+        for (const std::unique_ptr<Proxy>& proxy : proxies) {
+            order.push_back(proxy.get());
+        }
+        std::shuffle(order.begin(), order.end(), std::mt19937(0x42));
+
+        for (Proxy* proxy : order) {
+            index.Remove(Channel, proxy);
+            present.erase(proxy->Implementation());
+
+            EXPECT_EQ(index.Count(), present.size());
+            EXPECT_EQ(index.Find(Channel, proxy->Implementation(), 0x42), nullptr);
+
+            for (const std::pair<const ::Thunder::Core::instance_id, Proxy*>& entry : present) {
+                ASSERT_EQ(index.Find(Channel, entry.first, 0x42), entry.second);
+            }
+        }
+    }
+
+} // Core
+} // Tests
+} // Thunder
@@ -230,6 +230,31 @@ namespace Tests {
         EXPECT_NE(hex1, hex2);
     }
 
+    TEST(Cryptalgo_HMAC, KeySchedule_MatchesKey)
+    {
+        const string key = "Jefe";
+        const string data = "what do ya want for nothing?";
+
+        Crypto::SHA256HMAC reference(key);
+        reference.Input(reinterpret_cast<const uint8_t*>(data.c_str()), static_cast<uint16_t>(data.length()));
+        const string expected = ToHex(reference.Result(), Crypto::SHA256HMAC::Length);
+
+        Crypto::SHA256HMAC scheduled(reference.KeySchedule());
+        scheduled.Input(reinterpret_cast<const uint8_t*>(data.c_str()), static_cast<uint16_t>(data.length()));
+        EXPECT_EQ(ToHex(scheduled.Result(), Crypto::SHA256HMAC::Length), expected);
+
+        // Reuse after a result, starting again from the precomputed state.
+        scheduled.Reset();
+        scheduled.Input(reinterpret_cast<const uint8_t*>(data.c_str()), static_cast<uint16_t>(data.length()));
+        EXPECT_EQ(ToHex(scheduled.Result(), Crypto::SHA256HMAC::Length), expected);
+
+        Crypto::SHA1HMAC sha1(key);
+        Crypto::SHA1HMAC sha1Scheduled(sha1.KeySchedule());
+        sha1.Input(reinterpret_cast<const uint8_t*>(data.c_str()), static_cast<uint16_t>(data.length()));
+        sha1Scheduled.Input(reinterpret_cast<const uint8_t*>(data.c_str()), static_cast<uint16_t>(data.length()));
+        EXPECT_EQ(ToHex(sha1Scheduled.Result(), Crypto::SHA1HMAC::Length), ToHex(sha1.Result(), Crypto::SHA1HMAC::Length));
+    }
+
     TEST(Cryptalgo_HMAC, DigestLengths)
     {
         EXPECT_EQ(+Crypto::MD5HMAC::Length, 16u);
@@ -699,5 +724,283 @@ namespace Tests {
         EXPECT_EQ(static_cast<Crypto::EnumHashType>(Crypto::SHA512::Type), Crypto::HASH_SHA512);
     }
 
+    // =====================================================================
+    // Test Suite: Cryptalgo_Acceleration
+    // Covers: SHA-1/SHA-224/SHA-256/AES through the CPU crypto extensions
+    // Every result must be identical to the portable implementation. On a
+    // CPU without extensions both paths are portable and trivially equal.
+    // =====================================================================
+
+    template <typename HASHTYPE>
+    static string HashWith(const uint8_t features, const uint8_t data[], const uint32_t length, const uint32_t chunk)
+    {
+        const uint8_t original = Crypto::Accelerated();
+        Crypto::Accelerate(features);
+
+        HASHTYPE hash;
+        uint32_t offset = 0;
+        while (offset < length) {
+            const uint16_t size = static_cast<uint16_t>(std::min(chunk, length - offset));
+            hash.Input(&data[offset], size);
+            offset += size;
+        }
+        string result = ToHex(hash.Result(), HASHTYPE::Length);
+
+        Crypto::Accelerate(original);
+        return (result);
+    }
+
+    template <typename HASHTYPE>
+    static void CompareHash()
+    {
+        uint8_t data[4096];
+        for (uint32_t index = 0; index < sizeof(data); index++) {
+            data[index] = static_cast<uint8_t>((index * 131) ^ (index >> 3));
+        }
+
+        const uint32_t lengths[] = { 0, 1, 55, 56, 63, 64, 65, 119, 127, 128, 129, 1000, 4095, 4096 };
+        const uint32_t chunks[] = { 1, 7, 64, 100, 4096 };
+
+        for (const uint32_t length : lengths) {
+            for (const uint32_t chunk : chunks) {
+                EXPECT_EQ(HashWith<HASHTYPE>(Crypto::ACCELERATION_NONE, data, length, chunk),
+                          HashWith<HASHTYPE>(Crypto::Acceleration(), data, length, chunk))
+                    << "length " << length << " chunk " << chunk;
+            }
+        }
+    }
+
+    TEST(Cryptalgo_Acceleration, Accelerate_RestrictsToAvailable)
+    {
+        const uint8_t original = Crypto::Accelerated();
+
+        EXPECT_EQ(Crypto::Accelerated() & ~Crypto::Acceleration(), 0);
+
+        Crypto::Accelerate(Crypto::ACCELERATION_NONE);
+        EXPECT_EQ(Crypto::Accelerated(), Crypto::ACCELERATION_NONE);
+
+        Crypto::Accelerate(0xFF);
+        EXPECT_EQ(Crypto::Accelerated(), Crypto::Acceleration());
+
+        Crypto::Accelerate(original);
+    }
+
+    TEST(Cryptalgo_Acceleration, SHA1_MatchesPortable)
+    {
+        CompareHash<Crypto::SHA1>();
+    }
+
+    TEST(Cryptalgo_Acceleration, SHA224_MatchesPortable)
+    {
+        CompareHash<Crypto::SHA224>();
+    }
+
+    TEST(Cryptalgo_Acceleration, SHA256_MatchesPortable)
+    {
+        CompareHash<Crypto::SHA256>();
+    }
+
+    TEST(Cryptalgo_Acceleration, SHA256_KnownVector_MultiBlock)
+    {
+        // SHA-256("abcdbcdecdefdefgefghfghighijhijkijkljklmklmnlmnomnopnopq"), NIST two block vector
+        const char data[] = "abcdbcdecdefdefgefghfghighijhijkijkljklmklmnlmnomnopnopq";
+        Crypto::SHA256 hash(reinterpret_cast<const uint8_t*>(data), sizeof(data) - 1);
+
+        EXPECT_EQ(ToHex(hash.Result(), Crypto::SHA256::Length), "248d6a61d20638b8e5c026930c3e6039a33ce45964ff2167f6ecedd419db06c1");
+    }
+
+    TEST(Cryptalgo_Acceleration, AES_MatchesPortable)
+    {
+        const uint8_t key[32] = {
+            0x60, 0x3d, 0xeb, 0x10, 0x15, 0xca, 0x71, 0xbe, 0x2b, 0x73, 0xae, 0xf0, 0x85, 0x7d, 0x77, 0x81,
+            0x1f, 0x35, 0x2c, 0x07, 0x3b, 0x61, 0x08, 0xd7, 0x2d, 0x98, 0x10, 0xa3, 0x09, 0x14, 0xdf, 0xf4
+        };
+        const uint8_t iv[16] = {
+            0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08, 0x09, 0x0a, 0x0b, 0x0c, 0x0d, 0x0e, 0x0f
+        };
+        const Crypto::aesType types[] = { Crypto::aesType::AES_ECB, Crypto::aesType::AES_CBC, Crypto::aesType::AES_OFB };
+        const uint8_t keyLengths[] = { 16, 24, 32 };
+
+        uint8_t plaintext[256];
+        for (uint16_t index = 0; index < sizeof(plaintext); index++) {
+            plaintext[index] = static_cast<uint8_t>(index * 7);
+        }
+
+        const uint8_t original = Crypto::Accelerated();
+
+        for (const Crypto::aesType type : types) {
+            for (const uint8_t keyLength : keyLengths) {
+                uint8_t ciphertext[2][sizeof(plaintext)];
+                uint8_t decrypted[2][sizeof(plaintext)];
+
+                for (uint8_t pass = 0; pass < 2; pass++) {
+                    Crypto::Accelerate(pass == 0 ? Crypto::ACCELERATION_NONE : original);
+
+                    Crypto::AESEncryption enc(type);
+                    enc.Key(keyLength, key);
+                    enc.InitialVector(iv);
+                    EXPECT_EQ(enc.Encrypt(sizeof(plaintext), plaintext, ciphertext[pass]), 0u);
+
+                    Crypto::AESDecryption dec(type);
+                    dec.Key(keyLength, key);
+                    dec.InitialVector(iv);
+                    EXPECT_EQ(dec.Decrypt(sizeof(plaintext), ciphertext[pass], decrypted[pass]), 0u);
+
+                    EXPECT_EQ(memcmp(plaintext, decrypted[pass], sizeof(plaintext)), 0);
+                }
+
+                EXPECT_EQ(memcmp(ciphertext[0], ciphertext[1], sizeof(plaintext)), 0);
+            }
+        }
+
+        Crypto::Accelerate(original);
+    }
+
+    TEST(Cryptalgo_Acceleration, AES256_ECB_KnownVector)
+    {
+        // FIPS-197 C.3
+        const uint8_t key[32] = {
+            0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08, 0x09, 0x0a, 0x0b, 0x0c, 0x0d, 0x0e, 0x0f,
+            0x10, 0x11, 0x12, 0x13, 0x14, 0x15, 0x16, 0x17, 0x18, 0x19, 0x1a, 0x1b, 0x1c, 0x1d, 0x1e, 0x1f
+        };
+        const uint8_t plaintext[16] = {
+            0x00, 0x11, 0x22, 0x33, 0x44, 0x55, 0x66, 0x77, 0x88, 0x99, 0xaa, 0xbb, 0xcc, 0xdd, 0xee, 0xff
+        };
+        uint8_t ciphertext[16] = {};
+
+        Crypto::AESEncryption enc(Crypto::aesType::AES_ECB);
+        enc.Key(32, key);
+        EXPECT_EQ(enc.Encrypt(16, plaintext, ciphertext), 0u);
+
+        EXPECT_EQ(ToHex(ciphertext, 16), "8ea2b7ca516745bfeafc49904b496089");
+    }
+
+    // =====================================================================
+    // Test Suite: Cryptalgo_FileHash
+    // Covers: FileHashType<> standard digests (single and multiple files)
+    // and the parallel tree digest over memory mapped files
+    // =====================================================================
+
+    static string CreateHashFile(const string& fileName, const uint32_t size, const uint8_t seed)
+    {
+        Core::File file(fileName);
+        EXPECT_TRUE(file.Create(true));
+
+        uint8_t buffer[4096];
+        uint32_t written = 0;
+        while (written < size) {
+            const uint32_t length = std::min(static_cast<uint32_t>(sizeof(buffer)), size - written);
+            for (uint32_t index = 0; index < length; index++) {
+                buffer[index] = static_cast<uint8_t>(((written + index) * 31) ^ seed);
+            }
+            EXPECT_EQ(file.Write(buffer, length), length);
+            written += length;
+        }
+        file.Close();
+
+        return (fileName);
+    }
+
+    template <typename HASHTYPE>
+    static string HashOfFile(const string& fileName)
+    {
+        Core::File file(fileName);
+        EXPECT_TRUE(file.Open(true));
+
+        HASHTYPE hash;
+        uint8_t buffer[1000];
+        uint32_t length;
+        while ((length = file.Read(buffer, sizeof(buffer))) > 0) {
+            hash.Input(buffer, static_cast<uint16_t>(length));
+        }
+
+        return (ToHex(hash.Result(), HASHTYPE::Length));
+    }
+
+    TEST(Cryptalgo_FileHash, Digest_MatchesStreamedHash)
+    {
+        const uint32_t sizes[] = { 0, 1, 64, 100000, (3 * Crypto::FileHashType<Crypto::SHA256>::LeafSize) + 17 };
+
+        for (const uint32_t size : sizes) {
+            const string fileName = CreateHashFile("/tmp/cryptalgo_filehash.bin", size, 0x5A);
+            uint8_t digest[Crypto::SHA256::Length];
+
+            EXPECT_TRUE(Crypto::FileHashType<Crypto::SHA256>::Digest(fileName, digest));
+            EXPECT_EQ(ToHex(digest, Crypto::SHA256::Length), HashOfFile<Crypto::SHA256>(fileName)) << "size " << size;
+
+            Core::File(fileName).Destroy();
+        }
+    }
+
+    TEST(Cryptalgo_FileHash, Digest_NonExistingFile)
+    {
+        uint8_t digest[Crypto::SHA1::Length];
+
+        EXPECT_FALSE(Crypto::FileHashType<Crypto::SHA1>::Digest("/tmp/cryptalgo_filehash_does_not_exist.bin", digest));
+    }
+
+    TEST(Cryptalgo_FileHash, Digest_MultipleFiles)
+    {
+        std::vector<Crypto::FileHashType<Crypto::SHA1>::Entry> entries;
+
+        for (uint8_t index = 0; index < 6; index++) {
+            entries.emplace_back(CreateHashFile("/tmp/cryptalgo_filehash_" + Core::NumberType<uint8_t>(index).Text() + ".bin", 50000 * (index + 1), index));
+        }
+        entries.emplace_back("/tmp/cryptalgo_filehash_does_not_exist.bin");
+
+        EXPECT_EQ(Crypto::FileHashType<Crypto::SHA1>::Digest(entries, 3), 6u);
+
+        for (const auto& entry : entries) {
+            if (entry.Valid == true) {
+                EXPECT_EQ(ToHex(entry.Digest, Crypto::SHA1::Length), HashOfFile<Crypto::SHA1>(entry.FileName));
+                Core::File(entry.FileName).Destroy();
+            }
+        }
+
+        EXPECT_FALSE(entries.back().Valid);
+    }
+
+    TEST(Cryptalgo_FileHash, TreeDigest_IndependentOfWorkers)
+    {
+        const string fileName = CreateHashFile("/tmp/cryptalgo_filehash_tree.bin", (5 * Crypto::FileHashType<Crypto::SHA256>::LeafSize) + 1000, 0x33);
+
+        uint8_t single[Crypto::SHA256::Length];
+        uint8_t parallel[Crypto::SHA256::Length];
+        uint8_t standard[Crypto::SHA256::Length];
+
+        EXPECT_TRUE(Crypto::FileHashType<Crypto::SHA256>::TreeDigest(fileName, single, 1));
+        EXPECT_TRUE(Crypto::FileHashType<Crypto::SHA256>::TreeDigest(fileName, parallel, 4));
+        EXPECT_TRUE(Crypto::FileHashType<Crypto::SHA256>::Digest(fileName, standard));
+
+        EXPECT_EQ(memcmp(single, parallel, sizeof(single)), 0);
+
+        // The tree digest is a different construction than the plain digest.
+        EXPECT_NE(memcmp(single, standard, sizeof(single)), 0);
+
+        // Root over a single leaf: H(0x01 | H(0x00 | data))
+        Core::File(fileName).Destroy();
+        CreateHashFile(fileName, 1000, 0x33);
+
+        uint8_t buffer[1000];
+        Core::File file(fileName);
+        EXPECT_TRUE(file.Open(true));
+        EXPECT_EQ(file.Read(buffer, sizeof(buffer)), sizeof(buffer));
+        file.Close();
+
+        const uint8_t leafMarker = 0x00;
+        const uint8_t rootMarker = 0x01;
+        Crypto::SHA256 leaf;
+        leaf.Input(&leafMarker, 1);
+        leaf.Input(buffer, sizeof(buffer));
+        Crypto::SHA256 root;
+        root.Input(&rootMarker, 1);
+        root.Input(leaf.Result(), Crypto::SHA256::Length);
+
+        EXPECT_TRUE(Crypto::FileHashType<Crypto::SHA256>::TreeDigest(fileName, parallel));
+        EXPECT_EQ(ToHex(parallel, Crypto::SHA256::Length), ToHex(root.Result(), Crypto::SHA256::Length));
+
+        Core::File(fileName).Destroy();
+    }
+
 } // namespace Tests
 } // namespace Thunder
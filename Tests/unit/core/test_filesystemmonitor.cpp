@@ -0,0 +1,109 @@
+/*
+ * If not stated otherwise in this file or this component's LICENSE file the
+ * following copyright and licenses apply:
+ *
+ * Copyright 2020 Metrological
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <gtest/gtest.h>
+
+#ifndef MODULE_NAME
+#include "../Module.h"
+#endif
+
+#include <core/core.h>
+
+namespace Thunder {
+namespace Tests {
+namespace Core {
+
+    class FileSystemCollector : public ::Thunder::Core::FileSystemMonitor::ICallback {
+    public:
+        FileSystemCollector(const FileSystemCollector&) = delete;
+        FileSystemCollector& operator=(const FileSystemCollector&) = delete;
+
+        FileSystemCollector()
+            : _adminLock()
+            , _signal(false, true)
+            , _batches()
+        {
+        }
+        ~FileSystemCollector() override = default;
+
+    public:
+        bool Wait(const uint32_t waitTime)
+        {
+            return (_signal.Lock(waitTime) == ::Thunder::Core::ERROR_NONE);
+        }
+        std::vector<std::vector<string>> Batches() const
+        {
+            ::Thunder::Core::SafeSyncType<::Thunder::Core::CriticalSection> scopedLock(_adminLock);
+            return (_batches);
+        }
+        void Changed(const std::vector<string>& files) override
+        {
+            _adminLock.Lock();
+            _batches.push_back(files);
+            _adminLock.Unlock();
+
+            _signal.SetEvent();
+        }
+
+    private:
+        mutable ::Thunder::Core::CriticalSection _adminLock;
+        ::Thunder::Core::Event _signal;
+        std::vector<std::vector<string>> _batches;
+    };
+
+    TEST(test_filesystemmonitor, changes_coalesced_in_one_batch)
+    {
+        constexpr uint8_t Files = 20;
+
+        const string path(::Thunder::Core::Directory::Normalize(_T("/tmp/test_filesystemmonitor")));
+        ::Thunder::Core::Directory directory(path.c_str());
+        ASSERT_TRUE(directory.CreatePath());
+
+        ::Thunder::Core::FileSystemMonitor& monitor(::Thunder::Core::FileSystemMonitor::Instance());
+        FileSystemCollector collector;
+
+        monitor.Debounce(200);
+        ASSERT_TRUE(monitor.Register(&collector, path));
+
+        for (uint8_t index = 0; index < Files; index++) {
+            ::Thunder::Core::File file(path + _T("config") + ::Thunder::Core::NumberType<uint8_t>(index).Text() + _T(".json"));
+            EXPECT_TRUE(file.Create());
+            file.Close();
+        }
+
+        EXPECT_TRUE(collector.Wait(2000));
+
+        // Give a, wrongly, second window the chance to close as well.
+        SleepMs(500);
+
+        const std::vector<std::vector<string>> batches(collector.Batches());
+        ASSERT_EQ(batches.size(), 1u);
+        EXPECT_EQ(batches[0].size(), static_cast<size_t>(Files));
+        EXPECT_NE(std::find(batches[0].begin(), batches[0].end(), path + _T("config7.json")), batches[0].end());
+
+        monitor.Unregister(&collector, path);
+        monitor.Debounce(0);
+
+        directory.Destroy();
+        ::rmdir(path.c_str());
+    }
+
+} // Core
+} // Tests
+} // Thunder
@@ -67,6 +67,93 @@ namespace Core {
         obj1.Clear();
     }
 
+    TEST(test_frame, numbers_bulk)
+    {
+        const uint32_t values[] = { 0x01020304, 0xA0B0C0D0, 0, 0xFFFFFFFF, 42 };
+        const uint16_t shorts[] = { 0x0102, 0xFFFE, 7 };
+        uint32_t readValues[5] = {};
+        uint16_t readShorts[3] = {};
+
+        ::Thunder::Core::FrameType<64> frame;
+        ::Thunder::Core::FrameType<64>::Writer writer(frame, 0);
+        writer.Number<uint8_t>(3);
+        writer.Numbers<uint32_t>(values, 5);
+        writer.Numbers<uint16_t>(shorts, 3);
+
+        EXPECT_EQ(frame.Size(), 1u + sizeof(values) + sizeof(shorts));
+
+        // Same wire format as writing them one by one (big endian).
+        EXPECT_EQ(frame[1], 0x01);
+        EXPECT_EQ(frame[4], 0x04);
+        EXPECT_EQ(frame[5], 0xA0);
+
+        ::Thunder::Core::FrameType<64>::Reader reader(frame, 0);
+        EXPECT_EQ(reader.Number<uint8_t>(), 3);
+        EXPECT_EQ(reader.Number<uint32_t>(), values[0]);
+        reader.Numbers<uint32_t>(readValues, 4);
+        reader.Numbers<uint16_t>(readShorts, 3);
+        EXPECT_FALSE(reader.HasData());
+
+        EXPECT_EQ(::memcmp(readValues, &values[1], 4 * sizeof(uint32_t)), 0);
+        EXPECT_EQ(::memcmp(readShorts, shorts, sizeof(shorts)), 0);
+
+        ::Thunder::Core::FrameType<64, false> little;
+        ::Thunder::Core::FrameType<64, false>::Writer littleWriter(little, 0);
+        littleWriter.Numbers<uint32_t>(values, 5);
+        EXPECT_EQ(little[0], 0x04);
+        EXPECT_EQ(little[3], 0x01);
+
+        ::Thunder::Core::FrameType<64, false>::Reader littleReader(little, 0);
+        EXPECT_EQ(littleReader.Number<uint32_t>(), values[0]);
+        EXPECT_EQ(littleReader.Number<uint32_t>(), values[1]);
+    }
+
+    TEST(test_frame, growth_and_reserve)
+    {
+        uint8_t block[100];
+        ::memset(block, 0x5A, sizeof(block));
+
+        ::Thunder::Core::FrameType<64, true, uint32_t> frame;
+        ::Thunder::Core::FrameType<64, true, uint32_t>::Writer writer(frame, 0);
+
+        uint32_t reallocations = 0;
+        uint32_t capacity = frame.Capacity();
+
+        for (uint32_t index = 0; index < 1000; index++) {
+            writer.Copy(sizeof(block), block);
+            if (frame.Capacity() != capacity) {
+                capacity = frame.Capacity();
+                reallocations++;
+            }
+        }
+
+        EXPECT_EQ(frame.Size(), 100000u);
+        EXPECT_EQ(frame.Capacity() % 64, 0u);
+        EXPECT_LE(reallocations, 12u);
+        EXPECT_EQ(frame[99999], 0x5A);
+
+        ::Thunder::Core::FrameType<64, true, uint32_t> hinted;
+        hinted.Reserve(10000);
+        EXPECT_EQ(hinted.Size(), 0u);
+        EXPECT_GE(hinted.Capacity(), 10000u);
+
+        capacity = hinted.Capacity();
+        ::Thunder::Core::FrameType<64, true, uint32_t>::Writer hintedWriter(hinted, 0);
+        hintedWriter.Reserve(96 * sizeof(block));
+        for (uint32_t index = 0; index < 96; index++) {
+            hintedWriter.Copy(sizeof(block), block);
+        }
+        EXPECT_EQ(hinted.Capacity(), capacity);
+
+        // A small size type never grows beyond what it can address.
+        ::Thunder::Core::FrameType<512> small;
+        small.Size(40000);
+        EXPECT_GE(small.Capacity(), 40000u);
+        small.Size(65000);
+        EXPECT_GE(small.Capacity(), 65000u);
+        EXPECT_EQ(small.Size(), 65000u);
+    }
+
 } // Core
 } // Tests
 } // Thunder
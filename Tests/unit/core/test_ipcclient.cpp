@@ -27,10 +27,162 @@
 
 #include "../IPTestAdministrator.h"
 
+#include <thread>
+
 namespace Thunder {
 namespace Tests {
 namespace Core {
 
+    namespace {
+
+        class Triplet {
+        public:
+            Triplet()
+                : _display(0)
+                , _surface(1)
+                , _context(2)
+            {
+            }
+            Triplet(const uint16_t display, const uint32_t surface, const uint64_t context)
+                : _display(display)
+                , _surface(surface)
+                , _context(context)
+            {
+            }
+            Triplet(const Triplet&) = default;
+            Triplet& operator=(const Triplet&) = default;
+            ~Triplet() = default;
+
+        public:
+            uint32_t Sum() const
+            {
+                return (_display + _surface + static_cast<uint32_t>(_context));
+            }
+
+        private:
+            uint16_t _display;
+            uint32_t _surface;
+            uint64_t _context;
+        };
+
+        class Response {
+        public:
+            Response()
+                : _result(0)
+            {
+            }
+            Response(const uint32_t result)
+                : _result(result)
+            {
+            }
+            Response(const Response&) = default;
+            Response& operator=(const Response&) = default;
+            ~Response() = default;
+
+        public:
+            uint32_t Result() const
+            {
+                return (_result);
+            }
+
+        private:
+            uint32_t _result;
+        };
+
+        typedef ::Thunder::Core::IPCMessageType<1, Triplet, Response> TripletResponse;
+        typedef ::Thunder::Core::IPCMessageType<3, ::Thunder::Core::IPC::Text<2048>, ::Thunder::Core::IPC::Text<2048>> TextText;
+        typedef ::Thunder::Core::IPCMessageType<4, Triplet, Response> SlowTripletResponse;
+
+        class HandleTripletResponse : public ::Thunder::Core::IIPCServer {
+        public:
+            HandleTripletResponse(const HandleTripletResponse&) = delete;
+            HandleTripletResponse& operator=(const HandleTripletResponse&) = delete;
+
+            HandleTripletResponse() = default;
+            ~HandleTripletResponse() override = default;
+
+        public:
+            void Procedure(::Thunder::Core::IPCChannel& source, ::Thunder::Core::ProxyType<::Thunder::Core::IIPC>& data) override
+            {
+                ::Thunder::Core::ProxyType<TripletResponse> message(data);
+
+                message->Response() = Response(message->Parameters().Sum());
+                source.ReportResponse(data);
+            }
+        };
+
+        class HandleTextText : public ::Thunder::Core::IIPCServer {
+        public:
+            HandleTextText(const HandleTextText&) = delete;
+            HandleTextText& operator=(const HandleTextText&) = delete;
+
+            HandleTextText() = default;
+            ~HandleTextText() override = default;
+
+        public:
+            void Procedure(::Thunder::Core::IPCChannel& source, ::Thunder::Core::ProxyType<::Thunder::Core::IIPC>& data) override
+            {
+                ::Thunder::Core::ProxyType<TextText> message(data);
+                string text = message->Parameters().Value();
+
+                message->Response() = ::Thunder::Core::IPC::Text<2048>(text);
+                source.ReportResponse(data);
+            }
+        };
+
+        // Answers from a thread of its own after a delay, so the channel stays available for others.
+        class HandleSlowTripletResponse : public ::Thunder::Core::IIPCServer {
+        public:
+            HandleSlowTripletResponse(const HandleSlowTripletResponse&) = delete;
+            HandleSlowTripletResponse& operator=(const HandleSlowTripletResponse&) = delete;
+
+            HandleSlowTripletResponse()
+                : _lock()
+                , _workers()
+            {
+            }
+            ~HandleSlowTripletResponse() override
+            {
+                Join();
+            }
+
+        public:
+            static constexpr uint32_t Delay = 1000;
+
+            void Join()
+            {
+                _lock.Lock();
+                std::vector<std::thread> workers(std::move(_workers));
+                _lock.Unlock();
+
+                for (auto& worker : workers) {
+                    worker.join();
+                }
+            }
+
+            void Procedure(::Thunder::Core::IPCChannel& source, ::Thunder::Core::ProxyType<::Thunder::Core::IIPC>& data) override
+            {
+                ::Thunder::Core::ProxyType<::Thunder::Core::IIPC> message(data);
+                ::Thunder::Core::IPCChannel* channel = &source;
+
+                _lock.Lock();
+                _workers.emplace_back([channel, message]() mutable {
+                    SleepMs(Delay);
+
+                    ::Thunder::Core::ProxyType<SlowTripletResponse> request(message);
+                    request->Response() = Response(request->Parameters().Sum());
+                    channel->ReportResponse(message);
+                });
+                _lock.Unlock();
+            }
+
+        private:
+            ::Thunder::Core::CriticalSection _lock;
+            std::vector<std::thread> _workers;
+        };
+
+    }
+
     TEST(Core_IPC, IPCClientConnection)
     {
         constexpr uint32_t initHandshakeValue = 0, maxWaitTime = 4, maxWaitTimeMs = 4000, maxInitTime = 2000;
@@ -87,6 +239,280 @@ namespace Core {
         ::Thunder::Core::Singleton::Dispose();
     }
 
+    TEST(Core_IPC, ConcurrentInvokes)
+    {
+        constexpr uint32_t initHandshakeValue = 0, maxWaitTime = 8, maxWaitTimeMs = 4000, maxInitTime = 2000;
+
+        const std::string connector = _T("/tmp/testserver_concurrent");
+
+        IPTestAdministrator::Callback callback_child = [&](IPTestAdministrator& testAdmin) {
+            ::Thunder::Core::NodeId continousNode(connector.c_str());
+
+            ::Thunder::Core::ProxyType<::Thunder::Core::FactoryType<::Thunder::Core::IIPC, uint32_t> > factory(::Thunder::Core::ProxyType<::Thunder::Core::FactoryType<::Thunder::Core::IIPC, uint32_t> >::Create());
+
+            factory->CreateFactory<TripletResponse>(2);
+            factory->CreateFactory<SlowTripletResponse>(2);
+
+            ::Thunder::Core::IPCChannelClientType<::Thunder::Core::Void, true, false> continousChannel(continousNode, 32, factory);
+
+            ::Thunder::Core::ProxyType<HandleSlowTripletResponse> slowHandler(::Thunder::Core::ProxyType<HandleSlowTripletResponse>::Create());
+            ::Thunder::Core::ProxyType<::Thunder::Core::IIPCServer> handler1(::Thunder::Core::ProxyType<HandleTripletResponse>::Create());
+            ::Thunder::Core::ProxyType<::Thunder::Core::IIPCServer> handler2(slowHandler);
+
+            continousChannel.Register(TripletResponse::Id(), handler1);
+            continousChannel.Register(SlowTripletResponse::Id(), handler2);
+
+            ASSERT_EQ(continousChannel.Source().Open(maxWaitTimeMs), ::Thunder::Core::ERROR_NONE);
+
+            ASSERT_EQ(testAdmin.Wait(initHandshakeValue), ::Thunder::Core::ERROR_NONE);
+
+            slowHandler->Join();
+
+            continousChannel.Unregister(TripletResponse::Id());
+            continousChannel.Unregister(SlowTripletResponse::Id());
+
+            handler1.Release();
+            handler2.Release();
+            slowHandler.Release();
+
+            factory->DestroyFactory<TripletResponse>();
+            factory->DestroyFactory<SlowTripletResponse>();
+
+            EXPECT_EQ(continousChannel.Source().Close(maxWaitTimeMs), ::Thunder::Core::ERROR_NONE);
+        };
+
+        IPTestAdministrator::Callback callback_parent = [&](IPTestAdministrator& testAdmin) {
+            // A small delay so the child can be set up
+            SleepMs(maxInitTime);
+
+            ::Thunder::Core::NodeId continousNode(connector.c_str());
+
+            ::Thunder::Core::ProxyType<::Thunder::Core::FactoryType<::Thunder::Core::IIPC, uint32_t> > factory(::Thunder::Core::ProxyType<::Thunder::Core::FactoryType<::Thunder::Core::IIPC, uint32_t> >::Create());
+
+            factory->CreateFactory<TripletResponse>(2);
+            factory->CreateFactory<SlowTripletResponse>(2);
+
+            ::Thunder::Core::IPCChannelClientType<::Thunder::Core::Void, false, false> continousChannel(continousNode, 32, factory);
+
+            ASSERT_EQ(continousChannel.Source().Open(maxWaitTimeMs), ::Thunder::Core::ERROR_NONE);
+
+            ::Thunder::Core::ProxyType<SlowTripletResponse> slowData(::Thunder::Core::ProxyType<SlowTripletResponse>::Create(Triplet(1, 2, 3)));
+            ::Thunder::Core::ProxyType<TripletResponse> fastData(::Thunder::Core::ProxyType<TripletResponse>::Create(Triplet(4, 5, 6)));
+
+            uint32_t slowResult = ::Thunder::Core::ERROR_UNAVAILABLE;
+
+            std::thread slowCaller([&]() {
+                slowResult = continousChannel.Invoke(slowData, maxWaitTimeMs);
+            });
+
+            // Make sure the slow one is on its way before the fast one goes out.
+            SleepMs(100);
+            EXPECT_TRUE(continousChannel.InProgress());
+
+            const uint64_t start = ::Thunder::Core::Time::Now().Ticks();
+
+            EXPECT_EQ(continousChannel.Invoke(fastData, maxWaitTimeMs), ::Thunder::Core::ERROR_NONE);
+            EXPECT_EQ(fastData->Response().Result(), 15u);
+
+            // It did not have to wait for the slow one in front of it.
+            EXPECT_LT(::Thunder::Core::Time::Now().Ticks() - start, (HandleSlowTripletResponse::Delay / 2) * ::Thunder::Core::Time::MicroSecondsPerMilliSecond);
+            EXPECT_TRUE(continousChannel.InProgress());
+
+            slowCaller.join();
+
+            EXPECT_EQ(slowResult, ::Thunder::Core::ERROR_NONE);
+            EXPECT_EQ(slowData->Response().Result(), 6u);
+            EXPECT_FALSE(continousChannel.InProgress());
+
+            // A call that times out does not affect the ones after it, its late response is dropped.
+            slowData->Clear();
+            EXPECT_EQ(continousChannel.Invoke(slowData, HandleSlowTripletResponse::Delay / 4), ::Thunder::Core::ERROR_TIMEDOUT);
+            EXPECT_FALSE(continousChannel.InProgress());
+
+            EXPECT_EQ(continousChannel.Invoke(fastData, maxWaitTimeMs), ::Thunder::Core::ERROR_NONE);
+            EXPECT_EQ(fastData->Response().Result(), 15u);
+
+            // Let the late response come in, before tearing down.
+            SleepMs(HandleSlowTripletResponse::Delay);
+
+            EXPECT_EQ(continousChannel.Invoke(fastData, maxWaitTimeMs), ::Thunder::Core::ERROR_NONE);
+
+            ASSERT_EQ(testAdmin.Signal(initHandshakeValue), ::Thunder::Core::ERROR_NONE);
+
+            factory->DestroyFactory<TripletResponse>();
+            factory->DestroyFactory<SlowTripletResponse>();
+
+            ASSERT_EQ(continousChannel.Source().Close(maxWaitTimeMs), ::Thunder::Core::ERROR_NONE);
+        };
+
+        IPTestAdministrator testAdmin(callback_parent, callback_child, initHandshakeValue, maxWaitTime);
+
+        // Code after this line is executed by both parent and child
+
+        ::Thunder::Core::Singleton::Dispose();
+    }
+
+    TEST(Core_IPC, SharedRingChannel)
+    {
+        constexpr uint32_t initHandshakeValue = 0, maxWaitTime = 8, maxWaitTimeMs = 4000, maxInitTime = 2000;
+
+        const std::string connector = _T("/tmp/testserver_sharedring");
+
+        IPTestAdministrator::Callback callback_child = [&](IPTestAdministrator& testAdmin) {
+            ::Thunder::Core::NodeId continousNode(connector.c_str());
+
+            ::Thunder::Core::ProxyType<::Thunder::Core::FactoryType<::Thunder::Core::IIPC, uint32_t> > factory(::Thunder::Core::ProxyType<::Thunder::Core::FactoryType<::Thunder::Core::IIPC, uint32_t> >::Create());
+
+            factory->CreateFactory<TripletResponse>(2);
+            factory->CreateFactory<TextText>(2);
+            factory->CreateFactory<SlowTripletResponse>(2);
+
+            ::Thunder::Core::IPCChannelClientType<::Thunder::Core::Void, true, false> continousChannel(continousNode, 32, factory);
+
+            ::Thunder::Core::ProxyType<HandleSlowTripletResponse> slowHandler(::Thunder::Core::ProxyType<HandleSlowTripletResponse>::Create());
+            ::Thunder::Core::ProxyType<::Thunder::Core::IIPCServer> handler1(::Thunder::Core::ProxyType<HandleTripletResponse>::Create());
+            ::Thunder::Core::ProxyType<::Thunder::Core::IIPCServer> handler2(::Thunder::Core::ProxyType<HandleTextText>::Create());
+            ::Thunder::Core::ProxyType<::Thunder::Core::IIPCServer> handler3(slowHandler);
+
+            continousChannel.Register(TripletResponse::Id(), handler1);
+            continousChannel.Register(TextText::Id(), handler2);
+            continousChannel.Register(SlowTripletResponse::Id(), handler3);
+            continousChannel.Shareable(true);
+
+            ASSERT_EQ(continousChannel.Source().Open(maxWaitTimeMs), ::Thunder::Core::ERROR_NONE);
+
+            ASSERT_EQ(testAdmin.Wait(initHandshakeValue), ::Thunder::Core::ERROR_NONE);
+
+            slowHandler->Join();
+
+            continousChannel.Unregister(TripletResponse::Id());
+            continousChannel.Unregister(TextText::Id());
+            continousChannel.Unregister(SlowTripletResponse::Id());
+
+            handler1.Release();
+            handler2.Release();
+            handler3.Release();
+            slowHandler.Release();
+
+            factory->DestroyFactory<TripletResponse>();
+            factory->DestroyFactory<TextText>();
+            factory->DestroyFactory<SlowTripletResponse>();
+
+            EXPECT_EQ(continousChannel.Source().Close(maxWaitTimeMs), ::Thunder::Core::ERROR_NONE);
+        };
+
+        IPTestAdministrator::Callback callback_parent = [&](IPTestAdministrator& testAdmin) {
+            // A small delay so the child can be set up
+            SleepMs(maxInitTime);
+
+            ::Thunder::Core::NodeId continousNode(connector.c_str());
+
+            ::Thunder::Core::ProxyType<::Thunder::Core::FactoryType<::Thunder::Core::IIPC, uint32_t> > factory(::Thunder::Core::ProxyType<::Thunder::Core::FactoryType<::Thunder::Core::IIPC, uint32_t> >::Create());
+
+            factory->CreateFactory<TripletResponse>(2);
+            factory->CreateFactory<TextText>(2);
+            factory->CreateFactory<SlowTripletResponse>(2);
+
+            ::Thunder::Core::IPCChannelClientType<::Thunder::Core::Void, false, false> continousChannel(continousNode, 32, factory);
+
+            ASSERT_EQ(continousChannel.Source().Open(maxWaitTimeMs), ::Thunder::Core::ERROR_NONE);
+
+            EXPECT_FALSE(continousChannel.IsShared());
+            ASSERT_EQ(continousChannel.Upgrade(::Thunder::Core::SharedRing::MinimumSize, maxWaitTimeMs), ::Thunder::Core::ERROR_NONE);
+            EXPECT_TRUE(continousChannel.IsShared());
+
+            ::Thunder::Core::ProxyType<TripletResponse> tripletResponseData(::Thunder::Core::ProxyType<TripletResponse>::Create(Triplet(1, 2, 3)));
+
+            for (uint32_t index = 0; index < 1000; index++) {
+                tripletResponseData->Clear();
+                EXPECT_EQ(continousChannel.Invoke(tripletResponseData, maxWaitTimeMs), ::Thunder::Core::ERROR_NONE);
+                EXPECT_EQ(tripletResponseData->Response().Result(), 6u);
+            }
+
+            // Larger than what fits in one go, and responses running in parallel on the rings.
+            const string text(2000, 'x');
+            ::Thunder::Core::ProxyType<TextText> textTextData(::Thunder::Core::ProxyType<TextText>::Create(::Thunder::Core::IPC::Text<2048>(text)));
+            ::Thunder::Core::ProxyType<SlowTripletResponse> slowData(::Thunder::Core::ProxyType<SlowTripletResponse>::Create(Triplet(4, 5, 6)));
+
+            uint32_t slowResult = ::Thunder::Core::ERROR_UNAVAILABLE;
+
+            std::thread slowCaller([&]() {
+                slowResult = continousChannel.Invoke(slowData, maxWaitTimeMs);
+            });
+
+            for (uint32_t index = 0; index < 10; index++) {
+                EXPECT_EQ(continousChannel.Invoke(textTextData, maxWaitTimeMs), ::Thunder::Core::ERROR_NONE);
+                EXPECT_STREQ(string(textTextData->Response()).c_str(), text.c_str());
+            }
+
+            slowCaller.join();
+
+            EXPECT_EQ(slowResult, ::Thunder::Core::ERROR_NONE);
+            EXPECT_EQ(slowData->Response().Result(), 15u);
+
+            ASSERT_EQ(testAdmin.Signal(initHandshakeValue), ::Thunder::Core::ERROR_NONE);
+
+            factory->DestroyFactory<TripletResponse>();
+            factory->DestroyFactory<TextText>();
+            factory->DestroyFactory<SlowTripletResponse>();
+
+            ASSERT_EQ(continousChannel.Source().Close(maxWaitTimeMs), ::Thunder::Core::ERROR_NONE);
+
+            EXPECT_FALSE(continousChannel.IsShared());
+        };
+
+        IPTestAdministrator testAdmin(callback_parent, callback_child, initHandshakeValue, maxWaitTime);
+
+        // Code after this line is executed by both parent and child
+
+        ::Thunder::Core::Singleton::Dispose();
+    }
+
+    TEST(Core_IPC, SharedRingRefused)
+    {
+        constexpr uint32_t maxWaitTimeMs = 4000;
+
+        const ::Thunder::Core::NodeId node(_T("/tmp/testserver_sharedrefused"));
+
+        ::Thunder::Core::ProxyType<::Thunder::Core::FactoryType<::Thunder::Core::IIPC, uint32_t> > serverFactory(::Thunder::Core::ProxyType<::Thunder::Core::FactoryType<::Thunder::Core::IIPC, uint32_t> >::Create());
+        ::Thunder::Core::ProxyType<::Thunder::Core::FactoryType<::Thunder::Core::IIPC, uint32_t> > clientFactory(::Thunder::Core::ProxyType<::Thunder::Core::FactoryType<::Thunder::Core::IIPC, uint32_t> >::Create());
+
+        serverFactory->CreateFactory<TripletResponse>(2);
+        clientFactory->CreateFactory<TripletResponse>(2);
+
+        {
+            // The server did not opt in, the client is told so and stays on the socket.
+            ::Thunder::Core::IPCChannelClientType<::Thunder::Core::Void, true, false> server(node, 32, serverFactory);
+            ::Thunder::Core::IPCChannelClientType<::Thunder::Core::Void, false, false> client(node, 32, clientFactory);
+
+            ::Thunder::Core::ProxyType<::Thunder::Core::IIPCServer> handler(::Thunder::Core::ProxyType<HandleTripletResponse>::Create());
+
+            server.Register(TripletResponse::Id(), handler);
+
+            ASSERT_EQ(server.Source().Open(maxWaitTimeMs), ::Thunder::Core::ERROR_NONE);
+            ASSERT_EQ(client.Source().Open(maxWaitTimeMs), ::Thunder::Core::ERROR_NONE);
+
+            EXPECT_EQ(client.Upgrade(::Thunder::Core::SharedRing::MinimumSize, maxWaitTimeMs), ::Thunder::Core::ERROR_UNAVAILABLE);
+            EXPECT_FALSE(client.IsShared());
+
+            ::Thunder::Core::ProxyType<TripletResponse> tripletResponseData(::Thunder::Core::ProxyType<TripletResponse>::Create(Triplet(1, 2, 3)));
+
+            EXPECT_EQ(client.Invoke(tripletResponseData, maxWaitTimeMs), ::Thunder::Core::ERROR_NONE);
+            EXPECT_EQ(tripletResponseData->Response().Result(), 6u);
+
+            EXPECT_EQ(client.Source().Close(maxWaitTimeMs), ::Thunder::Core::ERROR_NONE);
+            EXPECT_EQ(server.Source().Close(maxWaitTimeMs), ::Thunder::Core::ERROR_NONE);
+
+            server.Unregister(TripletResponse::Id());
+            handler.Release();
+        }
+
+        serverFactory->DestroyFactory<TripletResponse>();
+        clientFactory->DestroyFactory<TripletResponse>();
+
+        ::Thunder::Core::Singleton::Dispose();
+    }
+
 } // Core
 } // Tests
 } // Thunder
@@ -370,6 +370,58 @@ namespace Core {
         EXPECT_EQ(R"(["second","first","third"])", serialized);
     }
 
+    TEST(JSONARRAY, ReferencesStayValid)
+    {
+        ::Thunder::Core::JSON::ArrayType<::Thunder::Core::JSON::DecUInt32> array;
+
+        ::Thunder::Core::JSON::DecUInt32& first = array.Add();
+        first = 1;
+
+        for (uint32_t index = 2; index <= 10000; index++) {
+            array.Add() = index;
+        }
+
+        ::Thunder::Core::JSON::DecUInt32& last = array[9999];
+
+        array.Insert(0) = 0;
+        array.Remove(5000);
+
+        EXPECT_EQ(10000u, array.Length());
+        EXPECT_EQ(1u, first.Value());
+        EXPECT_EQ(10000u, last.Value());
+        EXPECT_EQ(0u, array[0].Value());
+        EXPECT_EQ(5001u, array[5000].Value());
+        EXPECT_EQ(&first, &array[1]);
+    }
+
+    TEST(JSONARRAY, ReserveCopyAndClear)
+    {
+        ::Thunder::Core::JSON::ArrayType<::Thunder::Core::JSON::DecUInt32> array;
+        std::string serialized;
+
+        array.Reserve(100);
+        for (uint32_t index = 0; index < 100; index++) {
+            array.Add() = index;
+        }
+
+        ::Thunder::Core::JSON::ArrayType<::Thunder::Core::JSON::DecUInt32> copy(array);
+        ::Thunder::Core::JSON::ArrayType<::Thunder::Core::JSON::DecUInt32> moved(std::move(copy));
+
+        EXPECT_EQ(100u, moved.Length());
+        EXPECT_TRUE(moved == array);
+
+        array.Clear();
+        EXPECT_EQ(0u, array.Length());
+        array.Add() = 7;
+        array.Add() = 8;
+        array.ToString(serialized);
+        EXPECT_EQ("[7,8]", serialized);
+
+        moved = array;
+        EXPECT_EQ(2u, moved.Length());
+        EXPECT_EQ(8u, moved[1].Value());
+    }
+
 } // Core
 } // Tests
 } // Thunder
\ No newline at end of file
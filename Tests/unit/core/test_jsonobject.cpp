@@ -362,6 +362,89 @@ namespace Core {
         ASSERT_TRUE(variant.FromString("true"));
         EXPECT_EQ(variant.Content(), ::Thunder::Core::JSON::Variant::type::BOOLEAN);
     }
+
+    namespace {
+
+        class StaticPoint : public ::Thunder::Core::JSON::Container {
+        public:
+            StaticPoint(const StaticPoint&) = delete;
+            StaticPoint& operator=(const StaticPoint&) = delete;
+
+            StaticPoint()
+                : ::Thunder::Core::JSON::Container(Fields())
+                , X(0)
+                , Y(0)
+                , Name()
+                , Tags()
+            {
+            }
+            ~StaticPoint() override = default;
+
+        public:
+            ::Thunder::Core::JSON::DecSInt32 X;
+            ::Thunder::Core::JSON::DecSInt32 Y;
+            ::Thunder::Core::JSON::String Name;
+            ::Thunder::Core::JSON::ArrayType<::Thunder::Core::JSON::String> Tags;
+
+        private:
+            static const ::Thunder::Core::JSON::Container::FieldTable& Fields()
+            {
+                static constexpr ::Thunder::Core::JSON::Container::Field fields[] = {
+                    JSON_FIELD(StaticPoint, _T("x"), X),
+                    JSON_FIELD(StaticPoint, _T("y"), Y),
+                    JSON_FIELD(StaticPoint, _T("name"), Name),
+                    JSON_FIELD(StaticPoint, _T("tags"), Tags)
+                };
+                static constexpr ::Thunder::Core::JSON::Container::FieldTable table(fields);
+                return (table);
+            }
+        };
+
+        class MixedPoint : public StaticPoint {
+        public:
+            MixedPoint()
+                : StaticPoint()
+                , Z(0)
+            {
+                Add(_T("z"), &Z);
+            }
+            ~MixedPoint() override = default;
+
+        public:
+            ::Thunder::Core::JSON::DecSInt32 Z;
+        };
+    }
+
+    TEST(JSONOBJECT, StaticFieldTable)
+    {
+        static_assert(::Thunder::Core::JSON::Container::LabelLength(_T("name")) == 4, "label length is calculated at compile time");
+
+        StaticPoint point;
+
+        EXPECT_TRUE(point.FromString(R"({"y":-3,"unknown":{"a":1},"name":"origin","x":7,"tags":["a","b"]})"));
+        EXPECT_EQ(point.X.Value(), 7);
+        EXPECT_EQ(point.Y.Value(), -3);
+        EXPECT_EQ(point.Name.Value(), "origin");
+        EXPECT_EQ(point.Tags.Length(), 2u);
+        EXPECT_TRUE(point.HasLabel("tags"));
+        EXPECT_FALSE(point.HasLabel("z"));
+
+        string json;
+        point.ToString(json);
+        EXPECT_EQ(json, R"({"x":7,"y":-3,"name":"origin","tags":["a","b"]})");
+
+        point.Clear();
+        point.Name = _T("only");
+        point.ToString(json);
+        EXPECT_EQ(json, R"({"name":"only"})");
+
+        MixedPoint mixed;
+        EXPECT_TRUE(mixed.FromString(R"({"z":5,"x":1})"));
+        EXPECT_EQ(mixed.Z.Value(), 5);
+        EXPECT_EQ(mixed.X.Value(), 1);
+        mixed.ToString(json);
+        EXPECT_EQ(json, R"({"x":1,"z":5})");
+    }
 } // Core
 } // Tests
 } // Thunder
@@ -1053,6 +1053,84 @@ namespace Core {
         });
     }
 
+    TEST(JSONParser, NumbersInOneGoOrInPieces)
+    {
+        // Numbers that fit the buffer are converted in one go, others resume per character, both ways should agree.
+        auto serialize = [](const ::Thunder::Core::JSON::IElement& element, const uint16_t chunk) {
+            char buffer[64];
+            uint32_t offset = 0;
+            std::string result;
+            do {
+                const uint16_t loaded = element.Serialize(buffer, chunk, offset);
+                result.append(buffer, loaded);
+            } while (offset != 0);
+            return (result);
+        };
+
+        const ::Thunder::Core::JSON::DecSInt64 decimal(std::numeric_limits<int64_t>::min(), true);
+        EXPECT_EQ(serialize(decimal, 64), "-9223372036854775808");
+        EXPECT_EQ(serialize(decimal, 1), "-9223372036854775808");
+
+        const ::Thunder::Core::JSON::HexSInt16 hexadecimal(-300, true);
+        EXPECT_EQ(serialize(hexadecimal, 64), "\"-0x12C\"");
+        EXPECT_EQ(serialize(hexadecimal, 1), "\"-0x12C\"");
+
+        const ::Thunder::Core::JSON::OctUInt8 octal(8, true);
+        EXPECT_EQ(serialize(octal, 64), "\"010\"");
+        EXPECT_EQ(serialize(octal, 1), "\"010\"");
+
+        const ::Thunder::Core::JSON::Double real(-65.22, true);
+        EXPECT_EQ(serialize(real, 64), "-65.22");
+        EXPECT_EQ(serialize(real, 1), "-65.22");
+
+        ::Thunder::Core::JSON::ArrayType<::Thunder::Core::JSON::DecSInt32> integers;
+        EXPECT_TRUE(integers.FromString(_T("[0,-17,2147483647,-2147483647]")));
+        ASSERT_EQ(integers.Length(), 4);
+        EXPECT_EQ(integers[1].Value(), -17);
+        EXPECT_EQ(integers[2].Value(), 2147483647);
+        EXPECT_EQ(integers[3].Value(), -2147483647);
+
+        ::Thunder::Core::OptionalType<::Thunder::Core::JSON::Error> error;
+        EXPECT_FALSE(integers.FromString(_T("[2147483648]"), error));
+        EXPECT_TRUE(error.IsSet());
+    }
+
+    TEST(JSONParser, FloatingPointShortestRoundTrip)
+    {
+        for (const double value : { 0.1, 0.3, 2.11, 1.0 / 3.0, 123456789.125, 1e21, 1e-7, 5e-324, 1.7976931348623157e308 }) {
+            ::Thunder::Core::JSON::Double element(value, true);
+            std::string text;
+            element.ToString(text);
+
+            ::Thunder::Core::JSON::Double parsed;
+            EXPECT_TRUE(parsed.FromString(text));
+            EXPECT_EQ(parsed.Value(), value) << text;
+        }
+
+        for (const float value : { 1.1f, 3.2f, 1.0f / 3.0f, 16777216.0f, 1e-45f }) {
+            ::Thunder::Core::JSON::Float element(value, true);
+            std::string text;
+            element.ToString(text);
+
+            ::Thunder::Core::JSON::Float parsed;
+            EXPECT_TRUE(parsed.FromString(text));
+            EXPECT_EQ(parsed.Value(), value) << text;
+        }
+
+        std::string text;
+        ::Thunder::Core::JSON::Double(0.1, true).ToString(text);
+        EXPECT_EQ(text, "0.1");
+        text.clear();
+        ::Thunder::Core::JSON::Double(100, true).ToString(text);
+        EXPECT_EQ(text, "100");
+        text.clear();
+        ::Thunder::Core::JSON::Double(3.14159265358979, true).ToString(text);
+        EXPECT_EQ(text, "3.14159265358979");
+        text.clear();
+        ::Thunder::Core::JSON::Float(1.1f, true).ToString(text);
+        EXPECT_EQ(text, "1.1");
+    }
+
     TEST(JSONParser, StringWithEscapeSequence)
     {
         TestData data;
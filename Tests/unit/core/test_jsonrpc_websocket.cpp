@@ -55,6 +55,10 @@ namespace Core {
     //   - Client: JSONRPCWebSocketClient connects to the server, submits
     //     JSONRPC::Message objects, and collects responses via a thread-
     //     safe queue (mutex + condition_variable).
+    //   - Batches: frames that open with an array are deserialized into a
+    //     JSONRPC::Batch and answered with one array of responses. The
+    //     last test drives the server through JSONRPC::LinkType futures
+    //     and batches instead of the raw client.
     //
     // Registered server methods:
     //   "add"           - Adds two integers {"a":<int>,"b":<int>} -> sum
@@ -92,6 +96,21 @@ namespace Core {
             return ::Thunder::Core::ProxyType<::Thunder::Core::JSON::IElement>(
                 ::Thunder::Core::ProxyPoolType<::Thunder::Core::JSONRPC::Message>::Element());
         }
+        // Frames opening with an array are JSON-RPC batches.
+        ::Thunder::Core::ProxyType<::Thunder::Core::JSON::IElement> Element(const uint8_t stream[], const uint16_t length)
+        {
+            ::Thunder::Core::ProxyType<::Thunder::Core::JSON::IElement> result;
+
+            if (::Thunder::Core::JSONRPC::Batch::IsBatch(stream, length) == true) {
+                result = ::Thunder::Core::ProxyType<::Thunder::Core::JSON::IElement>(
+                    ::Thunder::Core::ProxyType<::Thunder::Core::JSONRPC::Batch>::Create());
+            }
+            else {
+                result = Element(string());
+            }
+
+            return (result);
+        }
     };
 
     // =========================================================================
@@ -225,39 +244,69 @@ namespace Core {
             ::Thunder::Core::ProxyType<::Thunder::Core::JSONRPC::Message> inbound(jsonObject);
 
             if (inbound.IsValid() && inbound->Designator.IsSet()) {
-                // Build a new response message and copy the request Id
-                // for JSON-RPC request/response correlation.
-                ::Thunder::Core::ProxyType<::Thunder::Core::JSONRPC::Message> response =
-                    ::Thunder::Core::ProxyType<::Thunder::Core::JSONRPC::Message>::Create();
-
-                response->JSONRPC = _T("2.0");
-                if (inbound->Id.IsSet()) {
-                    response->Id = inbound->Id.Value();
+                ::Thunder::Core::ProxyType<::Thunder::Core::JSONRPC::Message> response(Handle(*inbound));
+
+                this->Submit(::Thunder::Core::ProxyType<::Thunder::Core::JSON::IElement>(response));
+            }
+            else {
+                // A batch is answered with one array holding the responses to all
+                // members that carry an id (notifications get no response).
+                ::Thunder::Core::ProxyType<::Thunder::Core::JSONRPC::Batch> batch(jsonObject);
+
+                if (batch.IsValid() == true) {
+                    ::Thunder::Core::ProxyType<::Thunder::Core::JSONRPC::Batch> responses(
+                        ::Thunder::Core::ProxyType<::Thunder::Core::JSONRPC::Batch>::Create());
+                    ::Thunder::Core::JSONRPC::Batch::Iterator index(batch->Elements());
+
+                    while (index.Next() == true) {
+                        if (index.Current().Id.IsSet() == true) {
+                            responses->Add().Assign(*Handle(index.Current()));
+                        }
+                    }
+
+                    if (responses->Length() > 0) {
+                        this->Submit(::Thunder::Core::ProxyType<::Thunder::Core::JSON::IElement>(responses));
+                    }
                 }
+            }
+        }
 
-                // Dispatch to the registered handler method and populate
-                // either the Result field (success) or Error field (failure)
-                // on the response message.
-                string output;
-                string method = ::Thunder::Core::JSONRPC::Message::Method(inbound->Designator.Value());
-                ::Thunder::Core::JSONRPC::Context context(0, inbound->Id.Value(), _T(""));
+    private:
+        ::Thunder::Core::ProxyType<::Thunder::Core::JSONRPC::Message> Handle(const ::Thunder::Core::JSONRPC::Message& inbound)
+        {
+            // Build a new response message and copy the request Id
+            // for JSON-RPC request/response correlation.
+            ::Thunder::Core::ProxyType<::Thunder::Core::JSONRPC::Message> response =
+                ::Thunder::Core::ProxyType<::Thunder::Core::JSONRPC::Message>::Create();
+
+            response->JSONRPC = _T("2.0");
+            if (inbound.Id.IsSet()) {
+                response->Id = inbound.Id.Value();
+            }
 
-                uint32_t result = _handler.Invoke(context, method, inbound->Parameters.Value(), output);
+            // Dispatch to the registered handler method and populate
+            // either the Result field (success) or Error field (failure)
+            // on the response message.
+            string output;
+            string method = ::Thunder::Core::JSONRPC::Message::Method(inbound.Designator.Value());
+            ::Thunder::Core::JSONRPC::Context context(0, inbound.Id.Value(), _T(""));
 
-                if (result == ::Thunder::Core::ERROR_NONE) {
-                    if (output.empty()) {
-                        response->Result.Null(true);
-                    } else {
-                        response->Result = output;
-                    }
+            uint32_t result = _handler.Invoke(context, method, inbound.Parameters.Value(), output);
+
+            if (result == ::Thunder::Core::ERROR_NONE) {
+                if (output.empty()) {
+                    response->Result.Null(true);
                 } else {
-                    response->Error.SetError(result);
+                    response->Result = output;
                 }
-
-                this->Submit(::Thunder::Core::ProxyType<::Thunder::Core::JSON::IElement>(response));
+            } else {
+                response->Error.SetError(result);
             }
+
+            return (response);
         }
 
+    public:
         virtual void Send(VARIABLE_IS_NOT_USED ::Thunder::Core::ProxyType<::Thunder::Core::JSON::IElement>& jsonObject)
         {
         }
@@ -351,6 +400,20 @@ namespace Core {
                 _responseQueue.push(textElement);
                 _responseCV.notify_one();
             }
+            else {
+                // Members of a batch response are queued one by one.
+                ::Thunder::Core::ProxyType<::Thunder::Core::JSONRPC::Batch> batch(jsonObject);
+                if (batch.IsValid()) {
+                    ::Thunder::Core::JSONRPC::Batch::Iterator index(batch->Elements());
+                    std::lock_guard<std::mutex> lock(_responseMutex);
+                    while (index.Next() == true) {
+                        string textElement;
+                        EXPECT_TRUE(index.Current().ToString(textElement));
+                        _responseQueue.push(textElement);
+                    }
+                    _responseCV.notify_one();
+                }
+            }
         }
 
         virtual void Send(VARIABLE_IS_NOT_USED ::Thunder::Core::ProxyType<::Thunder::Core::JSON::IElement>& jsonObject)
@@ -599,6 +662,47 @@ namespace Core {
         });
     }
 
+    TEST(WebSocketJSONRPC, BatchRequest)
+    {
+        RunWithServer("/tmp/wpe_jsonrpc_ws_test4",
+            [](JSONRPCWebSocketClient<::Thunder::Core::JSON::IElement>& client) {
+            ::Thunder::Core::ProxyType<::Thunder::Core::JSONRPC::Batch> batch(
+                ::Thunder::Core::ProxyType<::Thunder::Core::JSONRPC::Batch>::Create());
+
+            for (uint32_t i = 1; i <= 8; i++) {
+                ::Thunder::Core::JSONRPC::Message& msg(batch->Add());
+                msg.JSONRPC = _T("2.0");
+                msg.Id = i;
+                msg.Designator = _T("add");
+                msg.Parameters = _T("{\"a\":") + std::to_string(i) + _T(",\"b\":") + std::to_string(i) + _T("}");
+            }
+
+            // A notification in the batch does not show up in the response array.
+            ::Thunder::Core::JSONRPC::Message& notification(batch->Add());
+            notification.JSONRPC = _T("2.0");
+            notification.Designator = _T("echo");
+            notification.Parameters = _T("{}");
+
+            client.Submit(::Thunder::Core::ProxyType<::Thunder::Core::JSON::IElement>(batch));
+
+            uint32_t sum = 0;
+
+            for (uint32_t i = 1; i <= 8; i++) {
+                ASSERT_TRUE(client.WaitForResponse());
+
+                ::Thunder::Core::JSONRPC::Message response;
+                client.RetrieveMessage(response);
+
+                ASSERT_TRUE(response.Result.IsSet());
+                EXPECT_STREQ(response.Result.Value().c_str(), std::to_string(response.Id.Value() * 2).c_str());
+                sum += response.Id.Value();
+            }
+
+            EXPECT_EQ(sum, 36u);
+            EXPECT_FALSE(client.WaitForResponse(200));
+        });
+    }
+
     TEST(WebSocketJSONRPC, UnknownMethodReturnsError)
     {
         RunWithServer("/tmp/wpe_jsonrpc_ws_test3",
@@ -622,6 +726,147 @@ namespace Core {
         });
     }
 
+    TEST(WebSocketJSONRPC, LinkTypePipelinedAndBatch)
+    {
+        constexpr uint32_t maxWaitTimeMs = 4000;
+
+        using Link = ::Thunder::JSONRPC::LinkType<::Thunder::Core::JSON::IElement>;
+
+        class Operands : public ::Thunder::Core::JSON::Container {
+        public:
+            Operands(const int32_t value)
+            {
+                Add(_T("a"), &A);
+                Add(_T("b"), &B);
+                A = value;
+                B = value;
+            }
+
+            ::Thunder::Core::JSON::DecSInt32 A;
+            ::Thunder::Core::JSON::DecSInt32 B;
+        };
+
+        const std::string connector("/tmp/wpe_jsonrpc_ws_test5");
+        ::unlink(connector.c_str());
+
+        JSONRPCWebSocketServer<::Thunder::Core::JSON::IElement>::Reset();
+
+        ::Thunder::Core::SocketServerType<JSONRPCWebSocketServer<::Thunder::Core::JSON::IElement>> server(
+            ::Thunder::Core::NodeId(connector.c_str()));
+
+        ASSERT_EQ(server.Open(maxWaitTimeMs), ::Thunder::Core::ERROR_NONE);
+
+        ::Thunder::Core::SystemInfo::SetEnvironment(_T("THUNDER_ACCESS"), connector);
+
+        {
+            Link link(_T(""));
+
+            {
+                std::unique_lock<std::mutex> lk(JSONRPCWebSocketServer<::Thunder::Core::JSON::IElement>::_mutex);
+                ASSERT_TRUE(JSONRPCWebSocketServer<::Thunder::Core::JSON::IElement>::_cv.wait_for(
+                    lk, std::chrono::seconds(5),
+                    []{ return JSONRPCWebSocketServer<::Thunder::Core::JSON::IElement>::GetState(); }));
+            }
+
+            // Keep a few hundred calls in flight before looking at any answer.
+            std::vector<Link::Future> pending;
+
+            for (int32_t i = 0; i < 300; i++) {
+                pending.push_back(link.Request<Operands>(maxWaitTimeMs, _T("add"), Operands(i)));
+            }
+            for (int32_t i = 0; i < 300; i++) {
+                ::Thunder::Core::JSON::DecSInt32 sum;
+                EXPECT_EQ(pending[i].Get(sum), ::Thunder::Core::ERROR_NONE);
+                EXPECT_EQ(sum.Value(), 2 * i);
+            }
+
+            // The same, as one batch frame, with a failing member in it.
+            Link::Batch batch(link);
+            pending.clear();
+
+            for (int32_t i = 0; i < 50; i++) {
+                pending.push_back(batch.Add<Operands>(_T("add"), Operands(i)));
+            }
+            Link::Future failing(batch.Add(_T("error")));
+
+            EXPECT_EQ(batch.Length(), 51);
+            EXPECT_EQ(batch.Submit(maxWaitTimeMs), ::Thunder::Core::ERROR_NONE);
+            EXPECT_EQ(batch.Length(), 0);
+
+            for (int32_t i = 0; i < 50; i++) {
+                ::Thunder::Core::JSON::DecSInt32 sum;
+                EXPECT_EQ(pending[i].Get(sum), ::Thunder::Core::ERROR_NONE);
+                EXPECT_EQ(sum.Value(), 2 * i);
+            }
+            EXPECT_EQ(failing.Wait(maxWaitTimeMs), ::Thunder::Core::ERROR_NONE);
+            EXPECT_NE(failing.Get(), ::Thunder::Core::ERROR_NONE);
+        }
+
+        server.Close(maxWaitTimeMs);
+
+        ::Thunder::Core::Singleton::Dispose();
+    }
+
+    TEST(WebSocketJSONRPC, LinkTypeBatchSubmitFailure)
+    {
+        constexpr uint32_t maxWaitTimeMs = 4000;
+
+        using Link = ::Thunder::JSONRPC::LinkType<::Thunder::Core::JSON::IElement>;
+
+        const std::string connector("/tmp/wpe_jsonrpc_ws_test6");
+        ::unlink(connector.c_str());
+
+        JSONRPCWebSocketServer<::Thunder::Core::JSON::IElement>::Reset();
+
+        ::Thunder::Core::SocketServerType<JSONRPCWebSocketServer<::Thunder::Core::JSON::IElement>> server(
+            ::Thunder::Core::NodeId(connector.c_str()));
+
+        ASSERT_EQ(server.Open(maxWaitTimeMs), ::Thunder::Core::ERROR_NONE);
+
+        ::Thunder::Core::SystemInfo::SetEnvironment(_T("THUNDER_ACCESS"), connector);
+
+        {
+            Link link(_T(""));
+
+            {
+                std::unique_lock<std::mutex> lk(JSONRPCWebSocketServer<::Thunder::Core::JSON::IElement>::_mutex);
+                ASSERT_TRUE(JSONRPCWebSocketServer<::Thunder::Core::JSON::IElement>::_cv.wait_for(
+                    lk, std::chrono::seconds(5),
+                    []{ return JSONRPCWebSocketServer<::Thunder::Core::JSON::IElement>::GetState(); }));
+            }
+
+            // Take the server away. A batch that could not be sent must complete its members right away.
+            server.Close(maxWaitTimeMs);
+
+            for (uint32_t attempt = 0; attempt < 10; attempt++) {
+                Link::Batch batch(link);
+                std::vector<Link::Future> pending;
+
+                for (uint32_t i = 0; i < 3; i++) {
+                    pending.push_back(batch.Add(_T("echo")));
+                }
+
+                uint32_t result = batch.Submit(100);
+
+                for (const Link::Future& future : pending) {
+                    if (result != ::Thunder::Core::ERROR_NONE) {
+                        // Nothing went out, so the members are completed right away with the failure.
+                        EXPECT_TRUE(future.IsReady());
+                        EXPECT_EQ(future.Get(), result);
+                    }
+                    else if (future.Wait(200) == ::Thunder::Core::ERROR_NONE) {
+                        // Went out on a dead connection, it can only be aborted or expire.
+                        EXPECT_NE(future.Get(), ::Thunder::Core::ERROR_NONE);
+                    }
+                }
+
+                SleepMs(10);
+            }
+        }
+
+        ::Thunder::Core::Singleton::Dispose();
+    }
+
 } // Core
 } // Tests
 } // Thunder
\ No newline at end of file
@@ -85,6 +85,51 @@ TEST(JSONString, Failure)
     EXPECT_STREQ(textOut.c_str(), R"("{\"payload\":\"This is test\\\" message\"}")");
 }
 
+TEST(JSONString, LongRunsInSmallChunks)
+{
+    // Long verbatim runs, interrupted by characters that need escaping, fed in chunks of any size.
+    std::string text;
+    for (uint32_t index = 0; index < 1000; index++) {
+        text += static_cast<char>('a' + (index % 26));
+        if ((index % 97) == 0) {
+            text += "\"\\/\n\t\x01";
+        }
+    }
+
+    Thunder::Core::JSON::String source;
+    source = text;
+
+    std::string expected;
+    source.ToString(expected);
+
+    for (const uint16_t chunk : { 1, 2, 15, 16, 17, 63 }) {
+        char buffer[64];
+        uint32_t offset = 0;
+        std::string serialized;
+
+        do {
+            const uint16_t loaded = source.Serialize(buffer, chunk, offset);
+            serialized.append(buffer, loaded);
+        } while (offset != 0);
+
+        EXPECT_EQ(serialized, expected);
+
+        Thunder::Core::JSON::String target;
+        Thunder::Core::OptionalType<Thunder::Core::JSON::Error> error;
+        uint32_t position = 0;
+        offset = 0;
+
+        do {
+            const uint16_t size = static_cast<uint16_t>(std::min(static_cast<size_t>(chunk), serialized.length() - position));
+            position += target.Deserialize(&(serialized[position]), size, offset, error);
+        } while ((offset != 0) && (error.IsSet() == false));
+
+        EXPECT_FALSE(error.IsSet());
+        EXPECT_EQ(position, serialized.length());
+        EXPECT_EQ(target.Value(), text);
+    }
+}
+
 TEST(METROL_1201, PR1976)
 {
     std::string json_single_begin  = R"({"model":"\"This is the single"})";
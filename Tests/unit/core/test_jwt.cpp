@@ -429,5 +429,101 @@ namespace Tests {
         EXPECT_EQ(string(reinterpret_cast<const char*>(decoded), decodedLen), payload);
     }
 
+    // =====================================================================
+    // Test Suite: JWT_Cache
+    // Covers: validated token cache, expiry handling and Flush
+    // =====================================================================
+
+    static string DecodeToString(const Web::JSONWebToken& jwt, const string& token, const uint16_t maxLength = 512)
+    {
+        uint8_t decoded[512] = {};
+        uint16_t decodedLen = jwt.Decode(token, std::min(maxLength, static_cast<uint16_t>(sizeof(decoded))), decoded);
+
+        return (decodedLen == static_cast<uint16_t>(~0) ? string(_T("<invalid>")) : string(reinterpret_cast<const char*>(decoded), decodedLen));
+    }
+
+    TEST(JWT_Cache, RepeatedDecode_SamePayload)
+    {
+        Web::JSONWebToken jwt(Web::JSONWebToken::SHA256, sizeof(TestKey), TestKey);
+        Web::JSONWebToken uncached(Web::JSONWebToken::SHA256, sizeof(TestKey), TestKey, 0);
+
+        const string payload = "{\"sub\":\"1234\",\"name\":\"Test\"}";
+        string token;
+        jwt.Encode(token, static_cast<uint16_t>(payload.length()), reinterpret_cast<const uint8_t*>(payload.c_str()));
+
+        for (uint8_t index = 0; index < 10; index++) {
+            EXPECT_EQ(DecodeToString(jwt, token), payload);
+            EXPECT_EQ(DecodeToString(uncached, token), payload);
+        }
+
+        jwt.Flush();
+        EXPECT_EQ(DecodeToString(jwt, token), payload);
+    }
+
+    TEST(JWT_Cache, TamperedAfterValid_StillFails)
+    {
+        Web::JSONWebToken jwt(Web::JSONWebToken::SHA256, sizeof(TestKey), TestKey);
+
+        const string payload = "{\"sub\":\"1234\"}";
+        string token;
+        jwt.Encode(token, static_cast<uint16_t>(payload.length()), reinterpret_cast<const uint8_t*>(payload.c_str()));
+
+        EXPECT_EQ(DecodeToString(jwt, token), payload);
+
+        string tampered(token);
+        tampered[tampered.length() - 2] = (tampered[tampered.length() - 2] == 'A' ? 'B' : 'A');
+
+        EXPECT_EQ(DecodeToString(jwt, tampered), _T("<invalid>"));
+        EXPECT_EQ(DecodeToString(jwt, token), payload);
+    }
+
+    TEST(JWT_Cache, SmallBuffer_NotServedTruncated)
+    {
+        Web::JSONWebToken jwt(Web::JSONWebToken::SHA256, sizeof(TestKey), TestKey);
+
+        const string payload(100, 'Y');
+        string token;
+        jwt.Encode(token, static_cast<uint16_t>(payload.length()), reinterpret_cast<const uint8_t*>(payload.c_str()));
+
+        // First validation with a buffer that is too small, must not poison the cache.
+        DecodeToString(jwt, token, 10);
+
+        EXPECT_EQ(DecodeToString(jwt, token), payload);
+        EXPECT_EQ(DecodeToString(jwt, token), payload);
+    }
+
+    TEST(JWT_Cache, Expired_StillValidated)
+    {
+        Web::JSONWebToken jwt(Web::JSONWebToken::SHA256, sizeof(TestKey), TestKey);
+
+        // The token validation itself does not judge the claims, an expired token is just not cached.
+        const string payload = "{\"sub\":\"1234\",\"exp\":1000}";
+        string token;
+        jwt.Encode(token, static_cast<uint16_t>(payload.length()), reinterpret_cast<const uint8_t*>(payload.c_str()));
+
+        EXPECT_EQ(DecodeToString(jwt, token), payload);
+        EXPECT_EQ(DecodeToString(jwt, token), payload);
+    }
+
+    TEST(JWT_Cache, MoreTokensThanSlots)
+    {
+        Web::JSONWebToken jwt(Web::JSONWebToken::SHA256, sizeof(TestKey), TestKey, 8);
+
+        std::vector<std::pair<string, string>> tokens;
+
+        for (uint8_t index = 0; index < 40; index++) {
+            const string payload = "{\"sub\":\"" + Core::NumberType<uint8_t>(index).Text() + "\",\"exp\":4102444800}";
+            string token;
+            jwt.Encode(token, static_cast<uint16_t>(payload.length()), reinterpret_cast<const uint8_t*>(payload.c_str()));
+            tokens.emplace_back(token, payload);
+        }
+
+        for (uint8_t round = 0; round < 3; round++) {
+            for (const auto& entry : tokens) {
+                EXPECT_EQ(DecodeToString(jwt, entry.first), entry.second);
+            }
+        }
+    }
+
 } // namespace Tests
 } // namespace Thunder
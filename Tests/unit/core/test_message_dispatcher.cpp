@@ -322,6 +322,196 @@ namespace Core {
         EXPECT_EQ(readData[3], testData2[3]);
     }
 
+    TEST_F(Core_MessageDispatcher, DataBufferCanExceedSixtyFourKilobytes)
+    {
+        constexpr uint32_t largeDataSize = 256 * 1024;
+        constexpr uint16_t messages = 4096;
+
+        ::Thunder::Messaging::MessageDataBuffer dispatcher(_T("test_large"), 0, this->_basePath, largeDataSize, 0, true);
+
+        uint8_t testData[32] = {};
+        uint8_t readData[sizeof(testData)];
+
+        for (uint16_t index = 0; index < messages; index++) {
+            testData[0] = static_cast<uint8_t>(index);
+            testData[1] = static_cast<uint8_t>(index >> 8);
+            ASSERT_EQ(dispatcher.PushData(_T("module"), sizeof(testData), testData), ::Thunder::Core::ERROR_NONE);
+        }
+
+        // (32 + 2) * 4096 bytes would never have fitted a 63KB buffer, none of it may be lost.
+        for (uint16_t index = 0; index < messages; index++) {
+            uint16_t readLength = sizeof(readData);
+            ASSERT_EQ(dispatcher.PopData(readLength, readData), ::Thunder::Core::ERROR_NONE);
+            ASSERT_EQ(readLength, sizeof(testData));
+            EXPECT_EQ(readData[0] | (readData[1] << 8), index);
+        }
+
+        ::Thunder::Messaging::MessageDataBuffer::Counters counters;
+        dispatcher.Statistics(counters);
+        EXPECT_TRUE(counters.empty());
+    }
+
+    TEST_F(Core_MessageDispatcher, NoisyModuleOnlyOverwritesItsOwnRing)
+    {
+        constexpr uint8_t rings = 2;
+
+        ::Thunder::Messaging::MessageDataBuffer dispatcher(_T("test_rings"), 0, this->_basePath, rings * DATA_SIZE, 0, true, rings);
+        EXPECT_EQ(dispatcher.Rings(), rings);
+
+        // Pick two modules that land in different rings.
+        const string quiet(_T("Quiet"));
+        string noisy;
+        for (uint8_t index = 0; noisy.empty() == true; index++) {
+            const string candidate(_T("Noisy") + ::Thunder::Core::NumberType<uint8_t>(index).Text());
+            if ((std::hash<string>()(candidate) % rings) != (std::hash<string>()(quiet) % rings)) {
+                noisy = candidate;
+            }
+        }
+
+        uint8_t quietData[] = { 13, 37 };
+        uint8_t noisyData[512] = {};
+        uint8_t tooLarge[DATA_SIZE + 1] = {};
+
+        ASSERT_EQ(dispatcher.PushData(quiet, sizeof(quietData), quietData), ::Thunder::Core::ERROR_NONE);
+
+        for (uint8_t index = 0; index < 64; index++) {
+            ASSERT_EQ(dispatcher.PushData(noisy, sizeof(noisyData), noisyData), ::Thunder::Core::ERROR_NONE);
+        }
+        EXPECT_EQ(dispatcher.PushData(noisy, sizeof(tooLarge), tooLarge), ::Thunder::Core::ERROR_WRITE_ERROR);
+
+        // The quiet module its message survived the storm.
+        bool found = false;
+        uint32_t popped = 0;
+        uint8_t readData[sizeof(noisyData)];
+        uint16_t readLength = sizeof(readData);
+
+        while (dispatcher.PopData(readLength, readData) == ::Thunder::Core::ERROR_NONE) {
+            if ((readLength == sizeof(quietData)) && (readData[0] == 13) && (readData[1] == 37)) {
+                found = true;
+            }
+            popped++;
+            readLength = sizeof(readData);
+        }
+
+        EXPECT_TRUE(found);
+        EXPECT_LT(popped, 64u);
+
+        ::Thunder::Messaging::MessageDataBuffer::Counters counters;
+        dispatcher.Statistics(counters);
+
+        ASSERT_EQ(counters.size(), 1u);
+        ASSERT_EQ(counters.count(noisy), 1u);
+        EXPECT_EQ(counters[noisy].Overwritten + popped, 64u + 1u);
+        EXPECT_EQ(counters[noisy].Dropped, 1u);
+    }
+
+    TEST_F(Core_MessageDispatcher, HugePagesRoundTheBufferNotEveryRing)
+    {
+        constexpr uint32_t hugePage = 2 * 1024 * 1024;
+        constexpr uint32_t dataSize = 3 * 1024 * 1024;
+
+        // 3MB rounds up to two huge pages, so there is room for two rings only.
+        ::Thunder::Messaging::MessageDataBuffer dispatcher(_T("test_huge"), 0, this->_basePath, dataSize, 0, true, 16, true);
+        EXPECT_EQ(dispatcher.Rings(), 2);
+
+        ::Thunder::Core::File ring(dispatcher.Name());
+        ASSERT_TRUE(ring.Exists());
+        EXPECT_EQ(ring.Size(), hugePage);
+
+        uint8_t testData[] = { 42 };
+        uint8_t readData[sizeof(testData)];
+        uint16_t readLength = sizeof(readData);
+
+        ASSERT_EQ(dispatcher.PushData(_T("module"), sizeof(testData), testData), ::Thunder::Core::ERROR_NONE);
+        ASSERT_EQ(dispatcher.PopData(readLength, readData), ::Thunder::Core::ERROR_NONE);
+        EXPECT_EQ(readData[0], testData[0]);
+    }
+
+    TEST(Core_Messaging_CallSite, PopMessageShouldReturnMessagePushedForCallSite)
+    {
+        ::Thunder::Messaging::MessageUnit::Settings::Config configuration;
+        ::Thunder::Messaging::MessageUnit::Instance().Open(_T("/tmp/"), configuration, false, ::Thunder::Messaging::MessageUnit::OFF);
+
+        ::Thunder::Messaging::MessageClient client(::Thunder::Messaging::MessageUnit::Instance().Identifier(), ::Thunder::Messaging::MessageUnit::Instance().BasePath());
+
+        client.AddInstance(0); //we are in framework
+
+        ::Thunder::Messaging::TraceFactoryType<::Thunder::Core::Messaging::IStore::Tracing, ::Thunder::Core::Messaging::TextMessage> factory;
+        client.AddFactory(::Thunder::Core::Messaging::Metadata::type::TRACING, &factory);
+
+        ::Thunder::Core::Messaging::Metadata metadata(::Thunder::Core::Messaging::Metadata::type::TRACING, _T("some_category"), EXPAND_AND_QUOTE(MODULE_NAME));
+
+        client.Enable(metadata, true);
+
+        const ::Thunder::Messaging::MessageUnit::CallSite site(metadata, _T("some_file"), 1337, _T("SomeClass"));
+        const uint64_t timeStamp = ::Thunder::Core::Time::Now().Ticks();
+
+        ::Thunder::Messaging::MessageUnit::Instance().Push(site, timeStamp, "some trace", ::Thunder::Core::Messaging::OutputMode::HANDLER);
+
+        client.SkipWaiting();
+
+        bool present = false;
+
+        client.PopMessagesAndCall(
+            [&](const ::Thunder::Core::ProxyType<::Thunder::Core::Messaging::MessageInfo>& metadata, const ::Thunder::Core::ProxyType<::Thunder::Core::Messaging::IEvent>& message) {
+                if ((*metadata).Type() == ::Thunder::Core::Messaging::Metadata::type::TRACING) {
+                    const ::Thunder::Core::Messaging::IStore::Tracing& trace = static_cast<::Thunder::Core::Messaging::IStore::Tracing&>(*metadata);
+
+                    if ((*message).Data() == _T("some trace")) {
+                        EXPECT_EQ(trace.Category(), _T("some_category"));
+                        EXPECT_EQ(trace.TimeStamp(), timeStamp);
+                        EXPECT_EQ(trace.FileName(), _T("some_file"));
+                        EXPECT_EQ(trace.LineNumber(), 1337);
+                        EXPECT_EQ(trace.ClassName(), _T("SomeClass"));
+                        present = true;
+                    }
+                }
+            }
+        );
+
+        EXPECT_TRUE(present);
+
+        client.RemoveInstance(0);
+
+        ::Thunder::Messaging::MessageUnit::Instance().Close();
+    }
+
+    namespace {
+
+        class TracingBase {
+        public:
+            virtual ~TracingBase() = default;
+        };
+
+        class TracingDerived : public TracingBase {
+        public:
+            ~TracingDerived() override = default;
+        };
+
+    }
+
+    TEST(Core_Messaging_CallSite, CallSitesReportTheDynamicClass)
+    {
+        ::Thunder::Core::Messaging::Metadata metadata(::Thunder::Core::Messaging::Metadata::type::TRACING, _T("some_category"), EXPAND_AND_QUOTE(MODULE_NAME));
+        ::Thunder::Messaging::MessageUnit::CallSites sites(metadata, _T("some_file"), 1337);
+
+        TracingBase base;
+        TracingDerived derived;
+        const TracingBase* objects[] = { &base, &derived };
+
+        const ::Thunder::Messaging::MessageUnit::CallSite& first = sites.Site(typeid(*objects[0]));
+        const ::Thunder::Messaging::MessageUnit::CallSite& second = sites.Site(typeid(*objects[1]));
+
+        EXPECT_NE(&first, &second);
+        EXPECT_EQ(first.Information().ClassName(), _T("TracingBase"));
+        EXPECT_EQ(second.Information().ClassName(), _T("TracingDerived"));
+        EXPECT_EQ(first.Information().LineNumber(), 1337);
+
+        // Prepared once per class.
+        EXPECT_EQ(&sites.Site(typeid(*objects[0])), &first);
+        EXPECT_EQ(&sites.Site(typeid(*objects[1])), &second);
+    }
+
 } // Core
 } // Tests
 } // Thunder
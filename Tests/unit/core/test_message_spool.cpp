@@ -0,0 +1,156 @@
+/*
+ * If not stated otherwise in this file or this component's LICENSE file the
+ * following copyright and licenses apply:
+ *
+ * Copyright 2020 Metrological
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <gtest/gtest.h>
+
+#ifndef MODULE_NAME
+#include "../Module.h"
+#endif
+
+#include <core/core.h>
+#include <messaging/messaging.h>
+
+namespace Thunder {
+
+namespace Tests {
+namespace Core {
+
+    class Core_MessageSpool : public testing::Test {
+    protected:
+        Core_MessageSpool()
+            : _basePath(_T("/tmp/TestMessageSpool/"))
+        {
+            if (::Thunder::Core::File(_basePath).IsDirectory()) {
+                ::Thunder::Core::Directory(_basePath.c_str()).Destroy();
+            }
+            ::Thunder::Core::Directory(_basePath.c_str()).CreatePath();
+        }
+        ~Core_MessageSpool() override
+        {
+            if (::Thunder::Core::File(_basePath).IsDirectory()) {
+                ::Thunder::Core::Directory(_basePath.c_str()).Destroy();
+            }
+        }
+
+        static ::Thunder::Core::Messaging::MessageInfo Info(const string& module, const string& category, const uint64_t timeStamp)
+        {
+            return (::Thunder::Core::Messaging::MessageInfo(::Thunder::Core::Messaging::Metadata(::Thunder::Core::Messaging::Metadata::type::TRACING, category, module), timeStamp));
+        }
+
+        const string _basePath;
+    };
+
+    TEST_F(Core_MessageSpool, RecordsAreReadBackByTimeModuleAndCategory)
+    {
+        const string path(_basePath + _T("trace"));
+
+        ::Thunder::Messaging::MessageSpool spool(path);
+        ASSERT_EQ(spool.Open(), ::Thunder::Core::ERROR_NONE);
+
+        for (uint32_t index = 0; index < 1000; index++) {
+            const ::Thunder::Messaging::TextMessage message(_T("Message number ") + ::Thunder::Core::NumberType<uint32_t>(index).Text());
+            EXPECT_EQ(spool.Append(Info((index % 2) == 0 ? _T("Even") : _T("Odd"), (index % 10) == 0 ? _T("Tenth") : _T("Information"), 1000 + index), message), ::Thunder::Core::ERROR_NONE);
+        }
+        EXPECT_EQ(spool.Flush(), ::Thunder::Core::ERROR_NONE);
+
+        ::Thunder::Messaging::MessageSpool::Reader reader(path);
+
+        uint64_t previous = 0;
+        uint32_t count = reader.Read(0, ~0, _T(""), _T(""), [&](const ::Thunder::Core::Messaging::MessageInfo& info, const uint8_t record[], const uint16_t length) {
+            EXPECT_GT(info.TimeStamp(), previous);
+            previous = info.TimeStamp();
+
+            ::Thunder::Core::Messaging::MessageInfo full;
+            const uint16_t offset = full.Deserialize(record, length);
+            ::Thunder::Messaging::TextMessage message;
+            message.Deserialize(&(record[offset]), length - offset);
+            EXPECT_EQ(message.Data(), _T("Message number ") + ::Thunder::Core::NumberType<uint32_t>(static_cast<uint32_t>(info.TimeStamp() - 1000)).Text());
+        });
+        EXPECT_EQ(count, 1000u);
+
+        count = reader.Read(1100, 1199, _T("Odd"), _T(""), [](const ::Thunder::Core::Messaging::MessageInfo& info, const uint8_t[], const uint16_t) {
+            EXPECT_EQ(info.Module(), _T("Odd"));
+        });
+        EXPECT_EQ(count, 50u);
+
+        count = reader.Read(0, ~0, _T("Even"), _T("Tenth"), [](const ::Thunder::Core::Messaging::MessageInfo& info, const uint8_t[], const uint16_t) {
+            EXPECT_EQ(info.Category(), _T("Tenth"));
+        });
+        EXPECT_EQ(count, 100u);
+
+        spool.Close();
+    }
+
+    TEST_F(Core_MessageSpool, OldestSegmentIsReusedWithinBudget)
+    {
+        constexpr uint16_t segments = 3;
+        constexpr uint32_t segmentSize = 16 * 1024;
+        const string path(_basePath + _T("budget"));
+
+        ::Thunder::Messaging::MessageSpool spool(path, segments, segmentSize, 1024);
+        ASSERT_EQ(spool.Open(), ::Thunder::Core::ERROR_NONE);
+
+        // Hardly compressible payload, so the segments really fill up.
+        string text;
+        uint32_t seed = 1;
+        for (uint32_t index = 0; index < 200; index++) {
+            seed = (seed * 1103515245u) + 12345u;
+            text += static_cast<char>('!' + ((seed >> 16) % 90));
+        }
+
+        const ::Thunder::Messaging::TextMessage message(text);
+        for (uint32_t index = 0; index < 2000; index++) {
+            EXPECT_EQ(spool.Append(Info(_T("Module"), _T("Category"), index), message), ::Thunder::Core::ERROR_NONE);
+        }
+        spool.Close();
+
+        EXPECT_FALSE(::Thunder::Core::File(path + _T(".3.spool")).Exists());
+
+        ::Thunder::Messaging::MessageSpool::Reader reader(path);
+        uint64_t first = ~0;
+        uint64_t previous = 0;
+        const uint32_t count = reader.Read(0, ~0, _T(""), _T(""), [&](const ::Thunder::Core::Messaging::MessageInfo& info, const uint8_t[], const uint16_t) {
+            if (first == static_cast<uint64_t>(~0)) {
+                first = info.TimeStamp();
+            }
+            else {
+                EXPECT_EQ(info.TimeStamp(), previous + 1);
+            }
+            previous = info.TimeStamp();
+        });
+
+        // Only the most recent messages survived, without gaps.
+        EXPECT_GT(count, 0u);
+        EXPECT_LT(count, 2000u);
+        EXPECT_GT(first, 0u);
+        EXPECT_EQ(previous, 1999u);
+
+        // A new writer continues after the most recent segment.
+        ::Thunder::Messaging::MessageSpool next(path, segments, segmentSize, 1024);
+        ASSERT_EQ(next.Open(), ::Thunder::Core::ERROR_NONE);
+        EXPECT_EQ(next.Append(Info(_T("Module"), _T("Category"), 5000), message), ::Thunder::Core::ERROR_NONE);
+        next.Close();
+
+        EXPECT_EQ(reader.Read(5000, 5000, _T(""), _T(""), [](const ::Thunder::Core::Messaging::MessageInfo&, const uint8_t[], const uint16_t) {}), 1u);
+        EXPECT_EQ(reader.Read(1999, 1999, _T(""), _T(""), [](const ::Thunder::Core::Messaging::MessageInfo&, const uint8_t[], const uint16_t) {}), 1u);
+    }
+
+} // Core
+} // Tests
+} // Thunder
@@ -25,6 +25,11 @@
 
 #include <core/core.h>
 
+#if !defined(__WINDOWS__) && !defined(__APPLE__)
+#include <linux/rtnetlink.h>
+#include <net/if.h>
+#endif
+
 namespace Thunder {
 namespace Tests {
 namespace Core {
@@ -118,6 +123,322 @@ namespace Core {
         ::Thunder::Core::Singleton::Dispose();
     }
 
+    TEST(test_adapteriterator, loopback_adapteriterator)
+    {
+        ::Thunder::Core::AdapterIterator adapter("lo");
+
+        ASSERT_TRUE(adapter.IsValid());
+        EXPECT_STREQ(adapter.Name().c_str(), "lo");
+        EXPECT_TRUE(adapter.IsUp());
+
+        ::Thunder::Core::AdapterIterator copy(adapter);
+        ASSERT_TRUE(copy.IsValid());
+        EXPECT_EQ(copy.Index(), adapter.Index());
+
+        ::Thunder::Core::AdapterIterator unknown("thunder-test0");
+        EXPECT_FALSE(unknown.IsValid());
+
+
+        ::Thunder::Core::Singleton::Dispose();
+    }
+
+#if !defined(__WINDOWS__) && !defined(__APPLE__)
+    // Netlink notifications as the kernel sends them, about a link index and a
+    // network (TEST-NET-2) no real adapter uses.
+    class NetlinkMessage {
+    public:
+        static constexpr uint16_t Index = 0xFFF1;
+
+    public:
+        NetlinkMessage() = delete;
+        NetlinkMessage(const NetlinkMessage&) = delete;
+        NetlinkMessage& operator=(const NetlinkMessage&) = delete;
+
+        NetlinkMessage(const uint16_t type, const uint16_t flags)
+            : _buffer(NLMSG_HDRLEN, 0)
+        {
+            struct nlmsghdr* header = reinterpret_cast<struct nlmsghdr*>(_buffer.data());
+            header->nlmsg_type = type;
+            header->nlmsg_flags = flags;
+            header->nlmsg_len = NLMSG_HDRLEN;
+        }
+        ~NetlinkMessage() = default;
+
+        static NetlinkMessage Link(const uint16_t type, const uint32_t flags, const string& name)
+        {
+            NetlinkMessage message(type, 0);
+
+            struct ifinfomsg info;
+            ::memset(&info, 0, sizeof(info));
+            info.ifi_family = AF_UNSPEC;
+            info.ifi_index = Index;
+            info.ifi_flags = flags;
+
+            message.Append(&info, sizeof(info));
+            message.Attribute(IFLA_IFNAME, name.c_str(), static_cast<uint16_t>(name.length() + 1));
+
+            return (message);
+        }
+        static NetlinkMessage Route(const uint16_t type, const uint16_t flags, const uint8_t table, const uint8_t gateway)
+        {
+            NetlinkMessage message(type, flags);
+
+            struct rtmsg info;
+            ::memset(&info, 0, sizeof(info));
+            info.rtm_family = AF_INET;
+            info.rtm_dst_len = 24;
+            info.rtm_table = table;
+            info.rtm_protocol = RTPROT_STATIC;
+            info.rtm_scope = RT_SCOPE_UNIVERSE;
+            info.rtm_type = RTN_UNICAST;
+
+            const uint8_t destination[4] = { 198, 51, 100, 0 };
+            const uint8_t router[4] = { 198, 51, 100, gateway };
+            const int interface = static_cast<int>(Index);
+
+            message.Append(&info, sizeof(info));
+            message.Attribute(RTA_DST, destination, sizeof(destination));
+            message.Attribute(RTA_GATEWAY, router, sizeof(router));
+            message.Attribute(RTA_OIF, &interface, sizeof(interface));
+
+            return (message);
+        }
+
+        NetlinkMessage(NetlinkMessage&&) = default;
+
+    public:
+        const uint8_t* Data() const
+        {
+            return (_buffer.data());
+        }
+        uint16_t Length() const
+        {
+            return (static_cast<uint16_t>(_buffer.size()));
+        }
+        // The payload as handed to the route parser, without the netlink header.
+        ::Thunder::Core::RoutingTable::Route Parsed() const
+        {
+            return (::Thunder::Core::RoutingTable::Route(&(_buffer[NLMSG_HDRLEN]), static_cast<uint16_t>(_buffer.size() - NLMSG_HDRLEN)));
+        }
+        uint16_t Inject() const
+        {
+            return (::Thunder::Core::AdapterObserver::Inject(Data(), Length()));
+        }
+
+    private:
+        void Append(const void* data, const uint16_t length)
+        {
+            const size_t offset = NLMSG_ALIGN(_buffer.size());
+            _buffer.resize(offset + NLMSG_ALIGN(length), 0);
+            ::memcpy(&(_buffer[offset]), data, length);
+            reinterpret_cast<struct nlmsghdr*>(_buffer.data())->nlmsg_len = static_cast<uint32_t>(_buffer.size());
+        }
+        void Attribute(const uint16_t type, const void* data, const uint16_t length)
+        {
+            const size_t offset = _buffer.size();
+            _buffer.resize(offset + RTA_SPACE(length), 0);
+            struct rtattr* attribute = reinterpret_cast<struct rtattr*>(&(_buffer[offset]));
+            attribute->rta_type = type;
+            attribute->rta_len = RTA_LENGTH(length);
+            ::memcpy(RTA_DATA(attribute), data, length);
+            reinterpret_cast<struct nlmsghdr*>(_buffer.data())->nlmsg_len = static_cast<uint32_t>(_buffer.size());
+        }
+
+    private:
+        std::vector<uint8_t> _buffer;
+    };
+
+    // Keeps the notifications about the test link and network, the kernel may report real ones meanwhile.
+    class Recorder : public ::Thunder::Core::AdapterObserver::INotification {
+    public:
+        using Links = std::vector<std::pair<string, uint8_t>>;
+        using Routes = std::vector<std::pair<::Thunder::Core::RoutingTable::Route, bool>>;
+
+    public:
+        Recorder(const Recorder&) = delete;
+        Recorder& operator=(const Recorder&) = delete;
+
+        Recorder()
+            : _lock()
+            , _links()
+            , _routes()
+        {
+        }
+        ~Recorder() override = default;
+
+    public:
+        void Event(const string&) override
+        {
+        }
+        void Link(const string& name, const uint8_t changes) override
+        {
+            if (name.compare(0, 7, _T("thdtest")) == 0) {
+                _lock.Lock();
+                _links.emplace_back(name, changes);
+                _lock.Unlock();
+            }
+        }
+        void Route(const ::Thunder::Core::RoutingTable::Route& route, const bool added) override
+        {
+            if (route.Destination().HostAddress() == _T("198.51.100.0")) {
+                _lock.Lock();
+                _routes.emplace_back(route, added);
+                _lock.Unlock();
+            }
+        }
+
+        Links TakeLinks()
+        {
+            _lock.Lock();
+            Links result(std::move(_links));
+            _links.clear();
+            _lock.Unlock();
+            return (result);
+        }
+        Routes TakeRoutes()
+        {
+            _lock.Lock();
+            Routes result(std::move(_routes));
+            _routes.clear();
+            _lock.Unlock();
+            return (result);
+        }
+
+    private:
+        ::Thunder::Core::CriticalSection _lock;
+        Links _links;
+        Routes _routes;
+    };
+
+    TEST(test_adapterobserver, link_notifications)
+    {
+        Recorder recorder;
+        ::Thunder::Core::AdapterObserver observer(&recorder);
+        observer.Open();
+
+        NetlinkMessage created(NetlinkMessage::Link(RTM_NEWLINK, 0, _T("thdtest0")));
+        EXPECT_EQ(created.Inject(), created.Length());
+
+        Recorder::Links links(recorder.TakeLinks());
+        ASSERT_EQ(links.size(), 1u);
+        EXPECT_EQ(links[0].first, _T("thdtest0"));
+        EXPECT_EQ(links[0].second, ::Thunder::Core::AdapterObserver::CREATED);
+
+        ::Thunder::Core::AdapterIterator adapter(_T("thdtest0"));
+        ASSERT_TRUE(adapter.IsValid());
+        EXPECT_EQ(adapter.Index(), NetlinkMessage::Index);
+
+        // The kernel repeats the full state, an unchanged link is not reported.
+        EXPECT_EQ(created.Inject(), created.Length());
+        EXPECT_TRUE(recorder.TakeLinks().empty());
+
+        NetlinkMessage up(NetlinkMessage::Link(RTM_NEWLINK, IFF_UP | IFF_RUNNING, _T("thdtest0")));
+        EXPECT_EQ(up.Inject(), up.Length());
+
+        links = recorder.TakeLinks();
+        ASSERT_EQ(links.size(), 1u);
+        EXPECT_EQ(links[0].first, _T("thdtest0"));
+        EXPECT_EQ(links[0].second, ::Thunder::Core::AdapterObserver::STATE);
+
+        NetlinkMessage renamed(NetlinkMessage::Link(RTM_NEWLINK, IFF_UP | IFF_RUNNING, _T("thdtest1")));
+        EXPECT_EQ(renamed.Inject(), renamed.Length());
+
+        links = recorder.TakeLinks();
+        ASSERT_EQ(links.size(), 1u);
+        EXPECT_EQ(links[0].first, _T("thdtest1"));
+        EXPECT_EQ(links[0].second, ::Thunder::Core::AdapterObserver::RENAMED);
+
+        EXPECT_FALSE(::Thunder::Core::AdapterIterator(_T("thdtest0")).IsValid());
+        EXPECT_TRUE(::Thunder::Core::AdapterIterator(_T("thdtest1")).IsValid());
+
+        NetlinkMessage both(NetlinkMessage::Link(RTM_NEWLINK, 0, _T("thdtest2")));
+        EXPECT_EQ(both.Inject(), both.Length());
+
+        links = recorder.TakeLinks();
+        ASSERT_EQ(links.size(), 1u);
+        EXPECT_EQ(links[0].first, _T("thdtest2"));
+        EXPECT_EQ(links[0].second, (::Thunder::Core::AdapterObserver::RENAMED | ::Thunder::Core::AdapterObserver::STATE));
+
+        NetlinkMessage destroyed(NetlinkMessage::Link(RTM_DELLINK, 0, _T("thdtest2")));
+        EXPECT_EQ(destroyed.Inject(), destroyed.Length());
+
+        links = recorder.TakeLinks();
+        ASSERT_EQ(links.size(), 1u);
+        EXPECT_EQ(links[0].first, _T("thdtest2"));
+        EXPECT_EQ(links[0].second, ::Thunder::Core::AdapterObserver::DESTROYED);
+
+        EXPECT_FALSE(::Thunder::Core::AdapterIterator(_T("thdtest2")).IsValid());
+
+        // Gone, so nothing to report anymore.
+        EXPECT_EQ(destroyed.Inject(), destroyed.Length());
+        EXPECT_TRUE(recorder.TakeLinks().empty());
+
+        observer.Close();
+
+        ::Thunder::Core::Singleton::Dispose();
+    }
+
+    TEST(test_adapterobserver, route_notifications)
+    {
+        Recorder recorder;
+        ::Thunder::Core::AdapterObserver observer(&recorder);
+        observer.Open();
+
+        NetlinkMessage added(NetlinkMessage::Route(RTM_NEWROUTE, NLM_F_CREATE, RT_TABLE_MAIN, 1));
+        EXPECT_EQ(added.Inject(), added.Length());
+
+        Recorder::Routes routes(recorder.TakeRoutes());
+        ASSERT_EQ(routes.size(), 1u);
+        EXPECT_TRUE(routes[0].first == added.Parsed());
+        EXPECT_EQ(routes[0].first.Gateway().HostAddress(), _T("198.51.100.1"));
+        EXPECT_TRUE(routes[0].second);
+
+        // The same route again, nothing changed that is reported.
+        EXPECT_EQ(added.Inject(), added.Length());
+        EXPECT_TRUE(recorder.TakeRoutes().empty());
+
+        // Only the main table is followed.
+        NetlinkMessage local(NetlinkMessage::Route(RTM_NEWROUTE, NLM_F_CREATE, RT_TABLE_LOCAL, 2));
+        EXPECT_EQ(local.Inject(), local.Length());
+        EXPECT_TRUE(recorder.TakeRoutes().empty());
+
+        // A replacement takes the place of the route it replaces.
+        NetlinkMessage replaced(NetlinkMessage::Route(RTM_NEWROUTE, NLM_F_REPLACE, RT_TABLE_MAIN, 2));
+        EXPECT_EQ(replaced.Inject(), replaced.Length());
+
+        routes = recorder.TakeRoutes();
+        ASSERT_EQ(routes.size(), 2u);
+        EXPECT_TRUE(routes[0].first == added.Parsed());
+        EXPECT_FALSE(routes[0].second);
+        EXPECT_TRUE(routes[1].first == replaced.Parsed());
+        EXPECT_EQ(routes[1].first.Gateway().HostAddress(), _T("198.51.100.2"));
+        EXPECT_TRUE(routes[1].second);
+
+        std::list<::Thunder::Core::RoutingTable::Route> table(::Thunder::Core::RoutingTable(true).Routes());
+        EXPECT_EQ(std::count(table.begin(), table.end(), added.Parsed()), 0);
+
+        // Removing a route that is not there is not reported.
+        NetlinkMessage unknown(NetlinkMessage::Route(RTM_DELROUTE, 0, RT_TABLE_MAIN, 1));
+        EXPECT_EQ(unknown.Inject(), unknown.Length());
+        EXPECT_TRUE(recorder.TakeRoutes().empty());
+
+        NetlinkMessage deleted(NetlinkMessage::Route(RTM_DELROUTE, 0, RT_TABLE_MAIN, 2));
+        EXPECT_EQ(deleted.Inject(), deleted.Length());
+
+        routes = recorder.TakeRoutes();
+        ASSERT_EQ(routes.size(), 1u);
+        EXPECT_TRUE(routes[0].first == replaced.Parsed());
+        EXPECT_FALSE(routes[0].second);
+
+        table = ::Thunder::Core::RoutingTable(true).Routes();
+        EXPECT_EQ(std::count(table.begin(), table.end(), replaced.Parsed()), 0);
+
+        observer.Close();
+
+        ::Thunder::Core::Singleton::Dispose();
+    }
+#endif
+
     TEST(DISABLED_test_adapterobserver, simple_adapterobserver)
     {
         ::Thunder::Core::AdapterObserver::INotification* callback{ nullptr };
@@ -25,6 +25,8 @@
 
 #include <core/core.h>
 
+#include <sys/wait.h>
+
 namespace Thunder {
 namespace Tests {
 namespace Core {
@@ -66,6 +68,141 @@ namespace Core {
         }
     }
 
+    TEST(Core_ProcessInfo, TextScanner)
+    {
+        const char text[] = "1234 (my (odd) name) S 42 7\nMemTotal:  16 kB\nMemFree: -3 kB\n";
+        ::Thunder::Core::TextScanner scanner(text, sizeof(text) - 1);
+
+        EXPECT_EQ(scanner.Number(), 1234u);
+        EXPECT_TRUE(scanner.SkipPastLast(')'));
+        EXPECT_EQ(scanner.Character(), 'S');
+        EXPECT_EQ(scanner.Signed(), 42);
+        scanner.SkipField();
+        EXPECT_TRUE(scanner.Line("MemFree:"));
+        EXPECT_EQ(scanner.Signed(), -3);
+        EXPECT_TRUE(scanner.Line("MemTotal:"));
+        EXPECT_EQ(scanner.Number(), 16u);
+        EXPECT_FALSE(scanner.Line("SwapFree:"));
+        EXPECT_EQ(scanner.Number(), 0u);
+    }
+
+    TEST(Core_ProcessInfo, TextScannerMissingKey)
+    {
+        // A /proc/meminfo from before MemAvailable was introduced.
+        const char text[] = "MemTotal:  2048 kB\nMemFree:  1024 kB\nBuffers:  16 kB\nCached:  512 kB\nSwapCached:  0 kB\nSwapTotal:  256 kB\nSwapFree:  128 kB\n";
+        ::Thunder::Core::TextScanner scanner(text, sizeof(text) - 1);
+
+        EXPECT_TRUE(scanner.Line("MemTotal:"));
+        EXPECT_EQ(scanner.Number(), 2048u);
+        EXPECT_TRUE(scanner.Line("MemFree:"));
+        EXPECT_EQ(scanner.Number(), 1024u);
+        EXPECT_FALSE(scanner.Line("MemAvailable:"));
+        EXPECT_TRUE(scanner.Line("Cached:"));
+        EXPECT_EQ(scanner.Number(), 512u);
+        EXPECT_TRUE(scanner.Line("SwapTotal:"));
+        EXPECT_EQ(scanner.Number(), 256u);
+        EXPECT_TRUE(scanner.Line("SwapFree:"));
+        EXPECT_EQ(scanner.Number(), 128u);
+
+        // Out of order, wraps around to the start.
+        EXPECT_TRUE(scanner.Line("Buffers:"));
+        EXPECT_EQ(scanner.Number(), 16u);
+    }
+
+    TEST(Core_ProcessInfo, KernelFile)
+    {
+        ::Thunder::Core::KernelFileType<512> stat(_T("/proc/self/stat"));
+
+        ASSERT_TRUE(stat.IsOpen());
+        ASSERT_TRUE(stat.Load());
+        EXPECT_EQ(stat.Content().Number(), static_cast<uint64_t>(getpid()));
+
+        const uint16_t length = stat.Length();
+        ASSERT_TRUE(stat.Load());
+        EXPECT_GT(length, 0u);
+        EXPECT_GT(stat.Length(), 0u);
+
+        ::Thunder::Core::KernelFileType<16> missing(_T("/proc/this/does/not/exist"));
+        EXPECT_FALSE(missing.IsOpen());
+        EXPECT_FALSE(missing.Load());
+    }
+
+    TEST(Core_ProcessSampler, Process)
+    {
+        ::Thunder::Core::ProcessSampler sampler(0);
+        ::Thunder::Core::ProcessSampler::Process info;
+
+        EXPECT_FALSE(sampler.Get(getpid(), info));
+
+        sampler.Add(getpid());
+        EXPECT_EQ(sampler.Count(), 1u);
+
+        ASSERT_TRUE(sampler.Get(getpid(), info));
+        EXPECT_EQ(info.Id, getpid());
+        EXPECT_EQ(info.Parent, getppid());
+        EXPECT_GE(info.Threads, 1u);
+        EXPECT_GT(info.Resident, 0u);
+        EXPECT_GE(info.Allocated, info.Resident);
+
+        const uint64_t before = info.UserTime + info.SystemTime;
+
+        // Burn some CPU, well over a clock tick.
+        volatile uint64_t work = 0;
+        const uint64_t end = ::Thunder::Core::Time::Now().Ticks() + (50 * ::Thunder::Core::Time::MicroSecondsPerMilliSecond);
+        while (::Thunder::Core::Time::Now().Ticks() < end) {
+            work = work + 1;
+        }
+
+        ASSERT_TRUE(sampler.Get(getpid(), info));
+        EXPECT_GT(info.UserTime + info.SystemTime, before);
+
+        sampler.Remove(getpid());
+        EXPECT_EQ(sampler.Count(), 0u);
+        EXPECT_FALSE(sampler.Get(getpid(), info));
+    }
+
+    TEST(Core_ProcessSampler, ExitedProcess)
+    {
+        ::Thunder::Core::ProcessSampler sampler(0, false);
+        ::Thunder::Core::ProcessSampler::Process info;
+
+        pid_t child = fork();
+
+        if (child == 0) {
+            _exit(0);
+        }
+        ASSERT_GT(child, 0);
+
+        sampler.Add(child);
+        ASSERT_TRUE(sampler.Get(child, info));
+
+        int status;
+        EXPECT_EQ(waitpid(child, &status, 0), child);
+
+        EXPECT_FALSE(sampler.Get(child, info));
+    }
+
+    TEST(Core_ProcessSampler, System)
+    {
+        ::Thunder::Core::ProcessSampler sampler(60000);
+        ::Thunder::Core::ProcessSampler::System first;
+        ::Thunder::Core::ProcessSampler::System second;
+
+        sampler.Get(first);
+        EXPECT_GT(first.Total, 0u);
+        EXPECT_GE(first.Total, first.Free);
+        EXPECT_GT(first.CpuTotal, 0u);
+        EXPECT_GE(first.CpuTotal, first.CpuBusy);
+
+        // Within the interval the cached sample is served.
+        sampler.Get(second);
+        EXPECT_EQ(first.CpuTotal, second.CpuTotal);
+        EXPECT_EQ(first.Free, second.Free);
+
+        ::Thunder::Core::SystemInfo::MemorySnapshot snapshot = ::Thunder::Core::SystemInfo::Instance().TakeMemorySnapshot();
+        EXPECT_EQ(snapshot.Total() * 1024, first.Total);
+    }
+
 } // Core
 } // Tests
 } // Thunder
@@ -0,0 +1,193 @@
+/*
+ * If not stated otherwise in this file or this component's LICENSE file the
+ * following copyright and licenses apply:
+ *
+ * Copyright 2020 Metrological
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <gtest/gtest.h>
+
+#ifndef MODULE_NAME
+#include "../Module.h"
+#endif
+
+#include <core/core.h>
+
+#include <atomic>
+#include <thread>
+
+namespace Thunder {
+namespace Tests {
+namespace Core {
+
+    namespace {
+
+        class Callsign {
+        public:
+            Callsign() = delete;
+            Callsign(Callsign&&) = delete;
+            Callsign(const Callsign&) = delete;
+            Callsign& operator=(Callsign&&) = delete;
+            Callsign& operator=(const Callsign&) = delete;
+
+            explicit Callsign(const string& name)
+                : _name(name)
+            {
+            }
+            ~Callsign()
+            {
+                // Whatever a reader still holds must be alive, make a use after free stand out.
+                _name.assign(_name.length(), '#');
+            }
+
+        public:
+            const string& Name() const
+            {
+                return (_name);
+            }
+
+        private:
+            string _name;
+        };
+
+        using Map = ::Thunder::Core::ReadMostlyMapType<::Thunder::Core::ProxyType<Callsign>>;
+        using Plugins = std::unordered_map<string, ::Thunder::Core::ProxyType<Callsign>>;
+
+        void Add(Plugins& plugins, const string& name)
+        {
+            plugins.emplace(name, ::Thunder::Core::ProxyType<Callsign>::Create(name));
+        }
+
+    }
+
+    TEST(Core_ReadMostlyMap, FindAfterPublish)
+    {
+        Map map;
+        Plugins plugins;
+        ::Thunder::Core::ProxyType<Callsign> found;
+
+        EXPECT_EQ(map.Count(), 0u);
+        EXPECT_FALSE(map.Find(_T("Controller"), found));
+
+        for (uint32_t index = 0; index < 200; index++) {
+            Add(plugins, _T("Plugin") + std::to_string(index));
+        }
+        Add(plugins, _T("Controller"));
+
+        map.Publish(plugins.cbegin(), plugins.cend());
+
+        EXPECT_EQ(map.Count(), 201u);
+
+        for (const auto& entry : plugins) {
+            ASSERT_TRUE(map.Find(entry.first, found));
+            EXPECT_EQ(found->Name(), entry.first);
+        }
+
+        // Lookups by a slice of a larger string, as done when routing a path.
+        const string path(_T("/Service/Plugin42/method"));
+        ASSERT_TRUE(map.Find(&path[9], 8, found));
+        EXPECT_EQ(found->Name(), _T("Plugin42"));
+
+        const string controller(_T("/Service/Controller/Plugins"));
+        ASSERT_TRUE(map.Find(&controller[9], 10, found));
+        EXPECT_EQ(found->Name(), _T("Controller"));
+        EXPECT_FALSE(map.Find(&controller[9], 9, found));
+        EXPECT_FALSE(map.Find(_T("Plugin200"), found));
+        EXPECT_FALSE(map.Find(_T(""), found));
+
+        // The map holds its own reference until it is replaced.
+        ::Thunder::Core::ProxyType<Callsign> held(plugins[_T("Controller")]);
+        plugins.clear();
+        ASSERT_TRUE(map.Find(_T("Controller"), found));
+        EXPECT_EQ(found->Name(), _T("Controller"));
+
+        map.Clear();
+        EXPECT_EQ(map.Count(), 0u);
+        EXPECT_FALSE(map.Find(_T("Controller"), found));
+
+        found.Release();
+        EXPECT_EQ(held.Release(), ::Thunder::Core::ERROR_DESTRUCTION_SUCCEEDED);
+    }
+
+    TEST(Core_ReadMostlyMap, ConcurrentReadersAndWriter)
+    {
+        constexpr uint32_t Readers = 8;
+        constexpr uint32_t Publications = 200;
+
+        Map map;
+        Plugins plugins;
+        std::atomic<bool> running(true);
+        std::atomic<uint32_t> mismatches(0);
+        std::atomic<uint64_t> lookups(0);
+
+        Add(plugins, _T("Controller"));
+        map.Publish(plugins.cbegin(), plugins.cend());
+
+        std::vector<std::thread> readers;
+        for (uint32_t reader = 0; reader < Readers; reader++) {
+            readers.emplace_back([&, reader]() {
+                ::Thunder::Core::ProxyType<Callsign> found;
+                uint32_t round = 0;
+
+                while (running == true) {
+                    const string name(_T("Plugin") + std::to_string((round++ + reader) % 16));
+
+                    if (map.Find(name, found) == true) {
+                        if (found->Name() != name) {
+                            mismatches++;
+                        }
+                        found.Release();
+                    }
+                    if ((map.Find(_T("Controller"), found) == false) || (found->Name() != _T("Controller"))) {
+                        mismatches++;
+                    }
+                    found.Release();
+                    lookups++;
+                }
+            });
+        }
+
+        // Plugins come and go while the readers keep routing.
+        for (uint32_t round = 0; round < Publications; round++) {
+            const string name(_T("Plugin") + std::to_string(round % 16));
+            const uint64_t seen = lookups.load();
+
+            // Let the readers get some lookups in on every snapshot.
+            while (lookups.load() == seen) {
+                std::this_thread::yield();
+            }
+
+            if (plugins.find(name) == plugins.end()) {
+                Add(plugins, name);
+            } else {
+                plugins.erase(name);
+            }
+            map.Publish(plugins.cbegin(), plugins.cend());
+        }
+
+        running = false;
+
+        for (std::thread& reader : readers) {
+            reader.join();
+        }
+
+        EXPECT_EQ(mismatches.load(), 0u);
+        EXPECT_GT(lookups.load(), 0u);
+        EXPECT_EQ(map.Count(), static_cast<uint32_t>(plugins.size()));
+    }
+
+} // Core
+} // Tests
+} // Thunder
@@ -223,9 +223,10 @@ namespace Exchange {
             ExternalAccess(const ExternalAccess &) = delete;
             ExternalAccess& operator=(const ExternalAccess &) = delete;
 
-            ExternalAccess(const ::Thunder::Core::NodeId & source)
+            ExternalAccess(const ::Thunder::Core::NodeId & source, const bool sharedMemory = false)
                 : ::Thunder::RPC::Communicator(source, _T(""), _T("@test"))
             {
+                SharedMemory(sharedMemory);
                 Open(::Thunder::Core::infinite);
             }
 
@@ -309,6 +310,77 @@ namespace Exchange {
         ::Thunder::Core::Singleton::Dispose();
     }
 
+    TEST(Core_RPC, adderSharedMemory)
+    {
+        constexpr uint32_t initHandshakeValue = 0, maxWaitTime = 4, maxWaitTimeMs = 4000, maxInitTime = 2000;
+        constexpr uint8_t maxRetries = 1;
+
+        const std::string connector{"/tmp/wperpc02"};
+
+        IPTestAdministrator::Callback callback_child = [&](IPTestAdministrator& testAdmin) {
+            ::Thunder::Core::NodeId remoteNode(connector.c_str());
+
+            // Opted in, the hosts it starts are handed a "shared:" connector.
+            ExternalAccess communicator(remoteNode, true);
+
+            EXPECT_STREQ(communicator.HostConnector().c_str(), (_T("shared:") + connector).c_str());
+
+            ASSERT_EQ(testAdmin.Wait(initHandshakeValue), ::Thunder::Core::ERROR_NONE);
+            ASSERT_EQ(testAdmin.Wait(initHandshakeValue), ::Thunder::Core::ERROR_NONE);
+
+            EXPECT_EQ(communicator.Close(maxWaitTimeMs), ::Thunder::Core::ERROR_NONE);
+        };
+
+        IPTestAdministrator::Callback callback_parent = [&](IPTestAdministrator& testAdmin) {
+            // A small delay so the child can be set up
+            SleepMs(maxInitTime);
+
+            string socket;
+            const uint32_t ringSize = ::Thunder::RPC::CommunicatorClient::Transport(_T("shared:") + connector, socket);
+
+            EXPECT_EQ(ringSize, static_cast<uint32_t>(::Thunder::RPC::SharedRingSize));
+            EXPECT_STREQ(socket.c_str(), connector.c_str());
+
+            ::Thunder::Core::NodeId remoteNode(socket.c_str());
+
+            ::Thunder::Core::ProxyType<::Thunder::RPC::InvokeServerType<4, 0, 1, 1, 1>> engine = ::Thunder::Core::ProxyType<::Thunder::RPC::InvokeServerType<4, 0, 1, 1, 1>>::Create();
+            ASSERT_TRUE(engine.IsValid());
+
+            ::Thunder::Core::ProxyType<::Thunder::RPC::CommunicatorClient> client = ::Thunder::Core::ProxyType<::Thunder::RPC::CommunicatorClient>::Create(remoteNode, ::Thunder::Core::ProxyType<::Thunder::Core::IIPCServer>(engine));
+            ASSERT_TRUE(client.IsValid());
+
+            client->SharedMemory(ringSize);
+
+            ASSERT_EQ(testAdmin.Signal(initHandshakeValue, maxRetries), ::Thunder::Core::ERROR_NONE);
+
+            Thunder::Tests::Core::Exchange::IAdder* adder = client->Open<Thunder::Tests::Core::Exchange::IAdder>(_T("Adder"));
+            ASSERT_TRUE(adder != nullptr);
+
+            // The announce only follows once the channel moved over, all calls go over the rings.
+            EXPECT_TRUE(client->IsShared());
+
+            EXPECT_EQ(adder->GetValue(), static_cast<uint32_t>(0));
+            adder->Add(20);
+            EXPECT_EQ(adder->GetValue(), static_cast<uint32_t>(20));
+            adder->Add(22);
+            EXPECT_EQ(adder->GetValue(), static_cast<uint32_t>(42));
+
+            EXPECT_NE(adder->GetPid(), static_cast<uint32_t>(getpid()));
+
+            EXPECT_EQ(adder->Release(), ::Thunder::Core::ERROR_DESTRUCTION_SUCCEEDED);
+
+            ASSERT_EQ(client->Close(maxWaitTimeMs), ::Thunder::Core::ERROR_NONE);
+
+            ASSERT_EQ(testAdmin.Signal(initHandshakeValue, maxRetries), ::Thunder::Core::ERROR_NONE);
+        };
+
+        IPTestAdministrator testAdmin(callback_parent, callback_child, initHandshakeValue, maxWaitTime);
+
+        // Code after this line is executed by both parent and child
+
+        ::Thunder::Core::Singleton::Dispose();
+    }
+
 } // Core
 } // Tests
 } // Thunder
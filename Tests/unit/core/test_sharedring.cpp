@@ -0,0 +1,203 @@
+/*
+ * If not stated otherwise in this file or this component's LICENSE file the
+ * following copyright and licenses apply:
+ *
+ * Copyright 2020 Metrological
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <gtest/gtest.h>
+
+#ifndef MODULE_NAME
+#include "../Module.h"
+#endif
+
+#include <core/core.h>
+
+namespace Thunder {
+namespace Tests {
+namespace Core {
+
+    TEST(Core_SharedRing, CreateAndOpen)
+    {
+        const string name(::Thunder::Core::SharedRing::TemporaryName());
+
+        {
+            ::Thunder::Core::SharedRing producer(name, 0, 5000);
+
+            ASSERT_TRUE(producer.IsValid());
+            EXPECT_EQ(producer.Capacity(), 8192u);
+            EXPECT_FALSE(producer.IsClosed());
+
+            ::Thunder::Core::SharedRing consumer(name);
+
+            ASSERT_TRUE(consumer.IsValid());
+            EXPECT_EQ(consumer.Capacity(), producer.Capacity());
+
+            // Nothing in there, so waiting for data times out.
+            EXPECT_FALSE(consumer.WaitForData(10));
+
+            uint8_t* writeBuffer;
+            ASSERT_EQ(producer.Reserve(writeBuffer), producer.Capacity());
+            ::memcpy(writeBuffer, "Thunder", 7);
+            producer.Produced(7);
+
+            EXPECT_TRUE(consumer.WaitForData(0));
+            EXPECT_EQ(consumer.Used(), 7u);
+
+            const uint8_t* readBuffer;
+            ASSERT_EQ(consumer.Peek(readBuffer), 7u);
+            EXPECT_EQ(::memcmp(readBuffer, "Thunder", 7), 0);
+            consumer.Consumed(7);
+
+            EXPECT_EQ(producer.Used(), 0u);
+
+            // Closing on one side is seen on the other.
+            consumer.Close();
+            EXPECT_TRUE(producer.IsClosed());
+        }
+
+        ::Thunder::Core::File(name).Destroy();
+
+        // Whatever is not a ring, is not accepted as one.
+        ::Thunder::Core::SharedRing missing(name);
+        EXPECT_FALSE(missing.IsValid());
+    }
+
+    TEST(Core_SharedRing, ExclusiveCreate)
+    {
+        const string name(::Thunder::Core::SharedRing::TemporaryName());
+        const string target(::Thunder::Core::SharedRing::TemporaryName());
+
+        EXPECT_STRNE(name.c_str(), target.c_str());
+
+        {
+            ::Thunder::Core::SharedRing producer(name, 0, ::Thunder::Core::SharedRing::MinimumSize);
+
+            ASSERT_TRUE(producer.IsValid());
+
+            struct stat info;
+            ASSERT_EQ(::stat(name.c_str(), &info), 0);
+            EXPECT_EQ((info.st_mode & 0777), static_cast<mode_t>(0600));
+
+            // Someone else was there first, no matter who.
+            ::Thunder::Core::SharedRing second(name, 0, ::Thunder::Core::SharedRing::MinimumSize);
+            EXPECT_FALSE(second.IsValid());
+        }
+
+        ::Thunder::Core::File(name).Destroy();
+
+        // A planted link is not followed.
+        ASSERT_EQ(::symlink(target.c_str(), name.c_str()), 0);
+
+        {
+            ::Thunder::Core::SharedRing planted(name, 0, ::Thunder::Core::SharedRing::MinimumSize);
+            EXPECT_FALSE(planted.IsValid());
+        }
+
+        EXPECT_FALSE(::Thunder::Core::File(target).Exists());
+
+        ::unlink(name.c_str());
+    }
+
+    TEST(Core_SharedRing, Stream)
+    {
+        constexpr uint32_t total = 4 * 1024 * 1024;
+
+        const string name(::Thunder::Core::SharedRing::TemporaryName());
+
+        ::Thunder::Core::SharedRing producer(name, 0, ::Thunder::Core::SharedRing::MinimumSize);
+        ::Thunder::Core::SharedRing consumer(name);
+
+        ASSERT_TRUE(producer.IsValid());
+        ASSERT_TRUE(consumer.IsValid());
+
+        ::Thunder::Core::File(name).Destroy();
+
+        std::thread writer([&]() {
+            uint32_t written = 0;
+            uint32_t chunk = 1;
+
+            while (written < total) {
+                uint8_t* buffer;
+                uint32_t space = producer.Reserve(buffer);
+
+                if (space == 0) {
+                    EXPECT_TRUE(producer.WaitForSpace(1000));
+                } else {
+                    // Odd sized chunks, so the wrap around lands everywhere.
+                    space = std::min(std::min(space, chunk), total - written);
+
+                    for (uint32_t index = 0; index < space; index++) {
+                        buffer[index] = static_cast<uint8_t>((written + index) % 251);
+                    }
+
+                    producer.Produced(space);
+                    written += space;
+                    chunk = (chunk % 1500) + 7;
+                }
+            }
+        });
+
+        uint32_t read = 0;
+        bool intact = true;
+
+        while ((read < total) && (intact == true)) {
+            if (consumer.WaitForData(1000) == true) {
+                const uint8_t* buffer;
+                const uint32_t length = consumer.Peek(buffer);
+
+                for (uint32_t index = 0; index < length; index++) {
+                    intact = intact && (buffer[index] == static_cast<uint8_t>((read + index) % 251));
+                }
+
+                consumer.Consumed(length);
+                read += length;
+            } else {
+                intact = false;
+            }
+        }
+
+        writer.join();
+
+        EXPECT_TRUE(intact);
+        EXPECT_EQ(read, total);
+    }
+
+    TEST(Core_SharedRing, CloseWakesWaiter)
+    {
+        const string name(::Thunder::Core::SharedRing::TemporaryName());
+
+        ::Thunder::Core::SharedRing producer(name, 0, ::Thunder::Core::SharedRing::MinimumSize);
+        ::Thunder::Core::SharedRing consumer(name);
+
+        ::Thunder::Core::File(name).Destroy();
+
+        std::thread closer([&]() {
+            SleepMs(100);
+            producer.Close();
+        });
+
+        const uint64_t start = ::Thunder::Core::Time::Now().Ticks();
+
+        EXPECT_FALSE(consumer.WaitForData(::Thunder::Core::infinite));
+        EXPECT_TRUE(consumer.IsClosed());
+        EXPECT_LT(::Thunder::Core::Time::Now().Ticks() - start, 2000u * ::Thunder::Core::Time::MicroSecondsPerMilliSecond);
+
+        closer.join();
+    }
+
+} // Core
+} // Tests
+} // Thunder
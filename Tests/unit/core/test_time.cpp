@@ -2025,6 +2025,26 @@ namespace Core {
         (currentZone == nullptr) ? unsetenv("TZ") : setenv("TZ", currentZone, 1);
         tzset();
     }
+
+    TEST(Core_Time, MonotonicClock)
+    {
+        const uint64_t first = ::Thunder::Core::MonotonicTime::Now();
+        const uint64_t second = ::Thunder::Core::MonotonicTime::Now();
+        EXPECT_GE(second, first);
+
+        // The coarse clock lags by at most a few ticks of the kernel.
+        const uint64_t coarse = ::Thunder::Core::MonotonicTime::Coarse();
+        const uint64_t now = ::Thunder::Core::MonotonicTime::Now();
+        EXPECT_LE(coarse, now);
+        EXPECT_LT(now - coarse, 50 * ::Thunder::Core::Time::TicksPerMillisecond);
+
+        // Wall clock moments map onto the monotonic clock.
+        const uint64_t deadline = ::Thunder::Core::MonotonicTime::FromTime(::Thunder::Core::Time::Now().Add(1000).Ticks());
+        const uint64_t expected = ::Thunder::Core::MonotonicTime::Now() + (1000 * ::Thunder::Core::Time::TicksPerMillisecond);
+        EXPECT_LT((deadline > expected ? deadline - expected : expected - deadline), 50 * ::Thunder::Core::Time::TicksPerMillisecond);
+
+        EXPECT_EQ(::Thunder::Core::MonotonicTime::FromTime(0), 0u);
+    }
 #if 0
     TEST(Core_Time, TimeHandle)
     {
@@ -176,6 +176,44 @@ namespace Core {
         timer.Flush();
     }
 
+    // As if the wall clock got set back: every reschedule is before the run it follows.
+    class BackwardHandler {
+    public:
+        uint64_t Timed(const uint64_t scheduledTime)
+        {
+            return (++_runs < 3 ? scheduledTime - ::Thunder::Core::Time::MicroSecondsPerSecond : 0);
+        }
+
+        bool operator==(const BackwardHandler&) const
+        {
+            return (true);
+        }
+        bool operator!=(const BackwardHandler&) const
+        {
+            return (false);
+        }
+
+        static std::atomic<uint32_t> _runs;
+    };
+
+    std::atomic<uint32_t> BackwardHandler::_runs(0);
+
+    TEST(Core_Timer, RescheduleBeforeThePreviousRun)
+    {
+        ::Thunder::Core::TimerType<BackwardHandler> timer(::Thunder::Core::Thread::DefaultStackSize(), _T("BackwardTimer"));
+
+        timer.Schedule(::Thunder::Core::Time::Now().Ticks(), BackwardHandler());
+
+        for (uint8_t retries = 0; (BackwardHandler::_runs < 3) && (retries < 100); retries++) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(10));
+        }
+
+        EXPECT_EQ(BackwardHandler::_runs, 3u);
+        EXPECT_EQ(timer.Pending(), 0u);
+
+        timer.Flush();
+    }
+
     TEST(Core_Timer, WatchDogType)
     {
         WatchDogHandler timer;
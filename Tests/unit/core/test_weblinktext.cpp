@@ -91,6 +91,108 @@ namespace Core {
 
     ::Thunder::Core::ProxyPoolType<Web::TextBody> WebServer::_textBodyFactory(5);
 
+    // Counts the writes on the socket, to see if answers are coalesced.
+    class CountingStream : public ::Thunder::Core::SocketStream {
+    public:
+        CountingStream() = delete;
+        CountingStream(CountingStream&&) = delete;
+        CountingStream(const CountingStream&) = delete;
+        CountingStream& operator=(CountingStream&&) = delete;
+        CountingStream& operator=(const CountingStream&) = delete;
+
+        template <typename... Args>
+        CountingStream(Args&&... args)
+            : ::Thunder::Core::SocketStream(std::forward<Args>(args)...)
+        {
+        }
+        ~CountingStream() override = default;
+
+    protected:
+        int32_t Write(const uint8_t buffer[], const uint16_t length) override
+        {
+            if (length > 0) {
+                Writes++;
+            }
+
+            return (::Thunder::Core::SocketStream::Write(buffer, length));
+        }
+
+    public:
+        static std::atomic<uint32_t> Writes;
+    };
+
+    std::atomic<uint32_t> CountingStream::Writes(0);
+
+    class PipelinedWebServer : public Web::WebLinkType<CountingStream, Web::Request, Web::Response, ::Thunder::Core::ProxyPoolType<Web::Request> > {
+    private:
+        typedef Web::WebLinkType<CountingStream, Web::Request, Web::Response, ::Thunder::Core::ProxyPoolType<Web::Request> > BaseClass;
+
+        constexpr static uint32_t maxWaitTimeMs = 4000;
+
+    public:
+        static constexpr uint8_t Requests = 3;
+
+        PipelinedWebServer() = delete;
+        PipelinedWebServer(const PipelinedWebServer& copy) = delete;
+        PipelinedWebServer& operator=(const PipelinedWebServer&) = delete;
+
+        PipelinedWebServer(const SOCKET& connector, const ::Thunder::Core::NodeId& remoteId, ::Thunder::Core::SocketServerType<PipelinedWebServer>*)
+            : BaseClass(5, false, connector, remoteId, 2048, 2048)
+            , _requests()
+        {
+            Pipelined(true);
+        }
+
+        virtual ~PipelinedWebServer()
+        {
+            EXPECT_EQ(Close(maxWaitTimeMs), ::Thunder::Core::ERROR_NONE);
+        }
+
+    public:
+        // Notification of a Partial Request received, time to attach a body..
+        virtual void LinkBody(::Thunder::Core::ProxyType<::Thunder::Web::Request>& element)
+        {
+            // Time to attach a String Body
+            element->Body(_textBodyFactory.Element());
+        }
+
+        virtual void Received(::Thunder::Core::ProxyType<::Thunder::Web::Request>& request)
+        {
+            _requests.push_back(request);
+
+            if (_requests.size() == Requests) {
+                // Answer in reverse order, the link should restore the request order
+                while (_requests.empty() == false) {
+                    ::Thunder::Core::ProxyType<Web::Response> response(::Thunder::Core::ProxyType<Web::Response>::Create());
+                    response->ErrorCode = 200;
+                    response->Body<Web::TextBody>(_requests.back()->Body<Web::TextBody>());
+
+                    EXPECT_TRUE(Submit(_requests.back(), response));
+
+                    _requests.pop_back();
+                }
+
+                EXPECT_EQ(Outstanding(), 0u);
+            }
+        }
+
+        virtual void Send(const ::Thunder::Core::ProxyType<::Thunder::Web::Response>& response)
+        {
+            EXPECT_EQ(response->ErrorCode, 200);
+            EXPECT_TRUE(response->HasBody());
+        }
+
+        virtual void StateChange()
+        {
+        }
+
+    private:
+        std::vector<::Thunder::Core::ProxyType<Web::Request>> _requests;
+        static ::Thunder::Core::ProxyPoolType<Web::TextBody> _textBodyFactory;
+    };
+
+    ::Thunder::Core::ProxyPoolType<Web::TextBody> PipelinedWebServer::_textBodyFactory(5);
+
     class WebClient : public Web::WebLinkType<::Thunder::Core::SocketStream, Web::Response, Web::Request, ::Thunder::Core::ProxyPoolType<Web::Response>&> {
     private:
         typedef Web::WebLinkType<::Thunder::Core::SocketStream, Web::Response, Web::Request, ::Thunder::Core::ProxyPoolType<Web::Response>&> BaseClass;
@@ -105,6 +207,7 @@ namespace Core {
         WebClient(const ::Thunder::Core::NodeId& remoteNode)
             : BaseClass(5,_responseFactory, false, remoteNode.AnyInterface(), remoteNode, 2048, 208)
             , _dataPending(false, false)
+            , _expected(1)
         {
         }
 
@@ -130,9 +233,11 @@ namespace Core {
             EXPECT_TRUE(response->HasBody());
             EXPECT_EQ(response->ContentLength.Value(), 19u);
 
-            _dataReceived = *(response->Body<Web::TextBody>());
+            _dataReceived += *(response->Body<Web::TextBody>());
 
-            EXPECT_EQ(_dataPending.Unlock(), ::Thunder::Core::ERROR_NONE);
+            if (--_expected == 0) {
+                EXPECT_EQ(_dataPending.Unlock(), ::Thunder::Core::ERROR_NONE);
+            }
         }
 
         virtual void Send(const ::Thunder::Core::ProxyType<::Thunder::Web::Request>& request)
@@ -145,6 +250,11 @@ namespace Core {
         {
         }
 
+        void Expect(const uint8_t count)
+        {
+            _expected = count;
+        }
+
         uint32_t Wait() const
         {
             return _dataPending.Lock();
@@ -159,6 +269,7 @@ namespace Core {
     private:
         mutable ::Thunder::Core::Event _dataPending;
         string _dataReceived;
+        std::atomic<uint8_t> _expected;
         static ::Thunder::Core::ProxyPoolType<Web::Response> _responseFactory;
         static ::Thunder::Core::ProxyPoolType<Web::TextBody> _textBodyFactory;
     };
@@ -228,6 +339,60 @@ namespace Core {
         ::Thunder::Core::Singleton::Dispose();
     }
 
+    TEST(WebLink, PipelinedText)
+    {
+        constexpr uint32_t maxWaitTimeMs = 4000;
+
+        const std::string connector {"127.0.0.1"};
+
+        // Server and client share this process, the requests are sent back-to-back on a single connection
+        ::Thunder::Core::SocketServerType<PipelinedWebServer> webServer(::Thunder::Core::NodeId(connector.c_str(), 12344));
+
+        ASSERT_EQ(webServer.Open(maxWaitTimeMs), ::Thunder::Core::ERROR_NONE);
+
+        {
+            WebClient webConnector(::Thunder::Core::NodeId(connector.c_str(), 12344));
+
+            ASSERT_EQ(webConnector.Open(maxWaitTimeMs), ::Thunder::Core::ERROR_NONE);
+
+            ASSERT_TRUE(webConnector.IsOpen());
+
+            webConnector.Expect(PipelinedWebServer::Requests);
+
+            CountingStream::Writes = 0;
+
+            string sent;
+
+            for (uint8_t index = 0; index < PipelinedWebServer::Requests; index++) {
+                ::Thunder::Core::ProxyType<Web::Request> webRequest(::Thunder::Core::ProxyType<Web::Request>::Create());
+                ::Thunder::Core::ProxyType<Web::TextBody> webRequestBody(::Thunder::Core::ProxyType<Web::TextBody>::Create());
+
+                webRequest->Body<Web::TextBody>(webRequestBody);
+                webRequest->Verb = Web::Request::HTTP_GET;
+
+                *webRequestBody = string("Pipelined body #") + static_cast<char>('0' + index) + string("..");
+                sent += *webRequestBody;
+
+                EXPECT_TRUE(webConnector.Submit(webRequest));
+            }
+
+            ASSERT_EQ(webConnector.Wait(), ::Thunder::Core::ERROR_NONE);
+
+            string received;
+
+            webConnector.Retrieve(received);
+
+            EXPECT_STREQ(received.c_str(), sent.c_str());
+
+            // The answers are released at once, they should have left in a single write.
+            EXPECT_EQ(CountingStream::Writes.load(), 1u);
+        }
+
+        EXPECT_EQ(webServer.Close(maxWaitTimeMs), ::Thunder::Core::ERROR_NONE);
+
+        ::Thunder::Core::Singleton::Dispose();
+    }
+
 } // Core
 } // Tests
 } // Thunder
@@ -0,0 +1,223 @@
+/*
+ * If not stated otherwise in this file or this component's LICENSE file the
+ * following copyright and licenses apply:
+ *
+ * Copyright 2020 Metrological
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <gtest/gtest.h>
+
+#ifndef MODULE_NAME
+#include "../Module.h"
+#endif
+
+#include <websocket/websocket.h>
+
+namespace Thunder {
+namespace Tests {
+namespace Core {
+
+    class ResponseSerializer : public Web::Response::Serializer {
+    public:
+        ResponseSerializer(const ResponseSerializer&) = delete;
+        ResponseSerializer& operator=(const ResponseSerializer&) = delete;
+
+        ResponseSerializer()
+            : Web::Response::Serializer()
+            , _serialized(0)
+        {
+        }
+        ~ResponseSerializer() override = default;
+
+    public:
+        void Serialized(const Web::Response&) override
+        {
+            _serialized++;
+        }
+        uint32_t Count() const
+        {
+            return (_serialized);
+        }
+
+    private:
+        uint32_t _serialized;
+    };
+
+    class RequestDeserializer : public Web::Request::Deserializer {
+    public:
+        RequestDeserializer(const RequestDeserializer&) = delete;
+        RequestDeserializer& operator=(const RequestDeserializer&) = delete;
+
+        RequestDeserializer(const string& fileName)
+            : Web::Request::Deserializer()
+            , _request()
+            , _body(::Thunder::Core::ProxyType<Web::FileBody>::Create(fileName))
+            , _deserialized(0)
+        {
+        }
+        ~RequestDeserializer() override = default;
+
+    public:
+        void Deserialized(Web::Request&) override
+        {
+            _deserialized++;
+        }
+        Web::Request* Element() override
+        {
+            return (&_request);
+        }
+        bool LinkBody(Web::Request& request) override
+        {
+            request.Body(_body);
+            return (true);
+        }
+        uint32_t Count() const
+        {
+            return (_deserialized);
+        }
+        void Release()
+        {
+            _request.Clear();
+            _body.Release();
+        }
+
+    private:
+        Web::Request _request;
+        ::Thunder::Core::ProxyType<Web::FileBody> _body;
+        uint32_t _deserialized;
+    };
+
+    static std::vector<uint8_t> CreateBodyFile(const string& fileName, const uint32_t size)
+    {
+        std::vector<uint8_t> content(size);
+
+        for (uint32_t index = 0; index < size; index++) {
+            content[index] = static_cast<uint8_t>((index * 7) ^ (index >> 8));
+        }
+
+        ::Thunder::Core::File file(fileName);
+        EXPECT_TRUE(file.Create(true));
+        EXPECT_EQ(file.Write(content.data(), size), size);
+        file.Close();
+
+        return (content);
+    }
+
+    static void SerializeFileBody(const uint32_t size)
+    {
+        const string fileName = "/tmp/webserializer_filebody.bin";
+        const std::vector<uint8_t> content = CreateBodyFile(fileName, size);
+
+        ::Thunder::Core::ProxyType<Web::FileBody> body = ::Thunder::Core::ProxyType<Web::FileBody>::Create(fileName);
+
+        Web::Response response;
+        response.ErrorCode = Web::STATUS_OK;
+        response.Body(body);
+
+        ResponseSerializer serializer;
+        serializer.Submit(response);
+
+        std::vector<uint8_t> output;
+        uint8_t buffer[1500];
+        uint16_t length;
+
+        while ((length = serializer.Serialize(buffer, sizeof(buffer))) > 0) {
+            output.insert(output.end(), buffer, buffer + length);
+        }
+
+        EXPECT_EQ(serializer.Count(), 1u);
+
+        ASSERT_GE(output.size(), content.size());
+        EXPECT_TRUE(std::equal(content.begin(), content.end(), output.end() - content.size()));
+
+        const string header(reinterpret_cast<const char*>(output.data()), output.size() - content.size());
+        EXPECT_NE(header.find("Content-Length: " + ::Thunder::Core::NumberType<uint32_t>(size).Text()), string::npos);
+
+        body.Release();
+
+        EXPECT_TRUE(::Thunder::Core::File(fileName).Destroy());
+    }
+
+    static void DeserializeFileBody(const uint32_t size)
+    {
+        const string fileName = "/tmp/webserializer_upload.bin";
+
+        std::vector<uint8_t> content(size);
+
+        for (uint32_t index = 0; index < size; index++) {
+            content[index] = static_cast<uint8_t>((index * 13) ^ (index >> 8));
+        }
+
+        const string header = "PUT /upload HTTP/1.1\r\nHost: localhost\r\nContent-Length: " + ::Thunder::Core::NumberType<uint32_t>(size).Text() + "\r\n\r\n";
+
+        std::vector<uint8_t> input(header.begin(), header.end());
+        input.insert(input.end(), content.begin(), content.end());
+
+        {
+            RequestDeserializer deserializer(fileName);
+            uint32_t offset = 0;
+
+            while (offset < input.size()) {
+                const uint16_t length = static_cast<uint16_t>(std::min(static_cast<size_t>(1500), input.size() - offset));
+                const uint16_t used = deserializer.Deserialize(&(input[offset]), length);
+
+                ASSERT_NE(used, 0u);
+                offset += used;
+            }
+
+            EXPECT_EQ(deserializer.Count(), 1u);
+
+            deserializer.Release();
+        }
+
+        ::Thunder::Core::File file(fileName);
+
+        ASSERT_TRUE(file.Open(true));
+        EXPECT_EQ(file.Size(), size);
+
+        std::vector<uint8_t> stored(size);
+        EXPECT_EQ(file.Read(stored.data(), size), size);
+        EXPECT_TRUE(stored == content);
+
+        file.Close();
+
+        EXPECT_TRUE(file.Destroy());
+    }
+
+    TEST(Web_FileBody, Serialize_Read)
+    {
+        SerializeFileBody(10000);
+    }
+
+    TEST(Web_FileBody, Serialize_Mapped)
+    {
+        // Beyond the mapping threshold, the body is served from a memory mapped file.
+        SerializeFileBody(1024 * 1024 + 333);
+    }
+
+    TEST(Web_FileBody, Deserialize_Write)
+    {
+        DeserializeFileBody(10000);
+    }
+
+    TEST(Web_FileBody, Deserialize_Mapped)
+    {
+        // Beyond the mapping threshold, the upload is copied into a growing memory mapped file.
+        DeserializeFileBody(3 * 1024 * 1024 + 333);
+    }
+
+} // Core
+} // Tests
+} // Thunder